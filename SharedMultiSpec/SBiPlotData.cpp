@@ -2927,7 +2927,8 @@ Boolean LoadBiPlotClassStats (
 												gInverseMatrixMemory.ipvotPtr,
 												&determinant, 
 												&logDeterminant,
-												kReturnMatrixInverse);
+												kReturnMatrixInverse,
+												kCheckEvents);
 									
 			if (gOperationCanceledFlag)
 				{
@@ -286,6 +286,45 @@ void classify (
 extern void	ListString (
 				const char*							textBuffer);
 
+		// Structures used to classify groups of lines in a block of lines on
+		// worker threads. Each slot has its own copy of the classifier variables
+		// with its own work vectors, class counts and sums so that nothing that
+		// is changed is shared by the slots. The counts and sums are added to 
+		// those for the area after all lines in the area have been classified.
+
+typedef struct ClassifyLinesSlot
+	{
+	AreaDescription			areaDescription;
+	ClassifierVar				classifierVar;
+	
+	double						discriminantSum;
+	
+	HSInt64Ptr					countVectorPtr;
+	
+	} ClassifyLinesSlot, *ClassifyLinesSlotPtr;
+
+typedef struct ClassifyLines
+	{
+	ClassifyLinesSlotPtr		slotPtr;
+	FileInfoPtr					fileInfoPtr;
+	HUCharPtr					blockBufferPtr;
+	HUCharPtr					probabilityBufferPtr;
+	HUCharPtr					slotBufferPtr;
+	UInt32*						numberSamplesPtr;
+	
+	SInt32						columnStart;
+	SInt32						line;
+	SInt32						lineInterval;
+	
+	UInt32						blockLineIndex;
+	UInt32						lineBytes;
+	UInt32						maxNumberLines;
+	UInt32						numberLines;
+	UInt32						numberSlots;
+	UInt32						probabilityLineBytes;
+	
+	} ClassifyLines, *ClassifyLinesPtr;
+
 
 
 			// Prototypes for routines in this file that are only called by		
@@ -315,6 +354,19 @@ SInt16 ClassifyArea (
 				ClassifierVarPtr					clsfyVariablePtr, 
 				HSInt64Ptr							countVectorPtr);
 
+SInt16 ClassifyLine (
+				AreaDescriptionPtr				areaDescriptionPtr,
+				FileInfoPtr							fileInfoPtr,
+				ClassifierVarPtr					clsfyVariablePtr, 
+				HUCharPtr							outputBufferPtr, 
+				HUCharPtr							probabilityBufferPtr, 
+				HSInt64Ptr							countVectorPtr, 
+				Point									point);
+
+void ClassifyLinesTask (
+				void*									taskInfoPtr,
+				UInt32								task);
+
 SInt16 ClassifyPerPointArea (
 				SInt16								classPointer,
 				AreaDescriptionPtr				areaDescriptionPtr, 
@@ -330,6 +382,11 @@ SInt16 ClassifyTrainTestFields (
 				ClassifierVarPtr					clsfyVariablePtr, 
 				SInt16								fieldType);
 
+void CloseClassifyLines (
+				ClassifyLinesPtr					classifyLinesPtr,
+				ClassifierVarPtr					clsfyVariablePtr, 
+				HSInt64Ptr							countVectorPtr);
+
 Boolean CreateCorrelationThresholdTable (
 				double*								thresholdTablePtr);
 									
@@ -492,6 +549,17 @@ SInt16 ParallelPipedClassifier (
 
 void ParallelPipedClsfierControl (
 				FileInfoPtr							fileInfoPtr);
+
+Boolean SetUpClassifyLines (
+				ClassifyLinesPtr					classifyLinesPtr,
+				AreaDescriptionPtr				areaDescriptionPtr,
+				FileInfoPtr							fileInfoPtr,
+				ClassifierVarPtr					clsfyVariablePtr,
+				HUCharPtr							blockBufferPtr,
+				UInt32*								numberSamplesPtr,
+				UInt32								numberBlockLines,
+				UInt32								lineBytes,
+				UInt32								numberSamples);
 													
 Boolean SetupClsfierMemory (
 				HDoublePtr*							channelMeanPtr,
@@ -941,7 +1009,8 @@ void CEMClsfierControl (
 																	gInverseMatrixMemory.ipvotPtr, 
 																	&determinant,
 																	&logDeterminant,
-																	kReturnMatrixInverse); 
+																	kReturnMatrixInverse,
+																	kCheckEvents); 
 			
 		if (determinantOKFlag)
 			{			
@@ -1234,7 +1303,7 @@ SInt16 CEMClassifier (
 					
 				probabilityBufferPtr++;
 				
-				gTempDoubleVariable1 += closestValue;
+				*clsfyVariablePtr->discriminantSumPtr += closestValue;
 		   	
 		   	}	// end "if (createCEMValuesFlag)"
 		   
@@ -1263,7 +1332,7 @@ SInt16 CEMClassifier (
 			
 				// Exit routine if user selects "cancel" or "command period".		
 		
-		if (TickCount () >= gNextTime)
+		if (!clsfyVariablePtr->workerTaskFlag && TickCount () >= gNextTime)
 			{
 			if (!CheckSomeEvents (osMask+keyDownMask+updateMask+mDownMask+mUpMask))
 																								return (3);
@@ -2867,6 +2936,211 @@ void ClassifyControl (void)
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 ClassifyLine
+//
+//	Software purpose:	The purpose of this routine is to classify one line of data
+//							with the classifier for the current classification mode.
+//
+//	Parameters in:		Pointer to the area description structure
+//							Pointer to image file information structure
+//							Pointer to classification variable structure
+//							Pointer to the buffer with the data for the line
+//							Pointer to the buffer for the probability values
+//							Pointer to vector to be used to store the count of the number
+//								of pixels classified into each class.
+//							Line and column of the first sample in the line
+//
+//	Parameters out:	None
+//
+// Value Returned:	=0, no error
+//							=3, user quit
+// 
+// Called By:			ClassifyLinesTask
+//							ClassifyPerPointArea
+
+SInt16 ClassifyLine (
+				AreaDescriptionPtr				areaDescriptionPtr,
+				FileInfoPtr							fileInfoPtr,
+				ClassifierVarPtr					clsfyVariablePtr, 
+				HUCharPtr							outputBufferPtr, 
+				HUCharPtr							probabilityBufferPtr, 
+				HSInt64Ptr							countVectorPtr, 
+				Point									point)
+	
+{
+	SInt16								returnCode = 0;
+	
+	
+	switch (gClassifySpecsPtr->mode)
+		{
+		case kMaxLikeMode:
+		case kMahalanobisMode:
+			returnCode = MaximumLikelihoodClassifier (areaDescriptionPtr,
+																	fileInfoPtr,
+																	clsfyVariablePtr,
+																	outputBufferPtr,
+																	probabilityBufferPtr, 
+																	countVectorPtr,  
+																	point);
+			break;
+
+		case kFisherMode:
+			returnCode = FisherClassifier (areaDescriptionPtr,
+														fileInfoPtr,
+														clsfyVariablePtr,
+														outputBufferPtr,
+														probabilityBufferPtr, 
+														countVectorPtr,  
+														point);
+			break;
+		
+		case kSupportVectorMachineMode:
+			returnCode = SupportVectorMachineClassifier (areaDescriptionPtr,
+																		fileInfoPtr,
+																		clsfyVariablePtr,
+																		outputBufferPtr,
+																		probabilityBufferPtr,
+																		countVectorPtr,
+																		point);
+			break;
+			
+		case kKNearestNeighborMode:
+			returnCode = KNNClassifier (areaDescriptionPtr,
+													fileInfoPtr,
+													clsfyVariablePtr,
+													outputBufferPtr,
+													probabilityBufferPtr,
+													countVectorPtr,
+													point);
+			break;
+			
+		case kEuclideanMode:
+			returnCode = EuclideanClassifier (areaDescriptionPtr,
+															fileInfoPtr,
+															clsfyVariablePtr,
+															outputBufferPtr,
+															probabilityBufferPtr,
+															countVectorPtr,  
+															point);
+			break;
+			
+		case kCorrelationMode:
+			returnCode = CorrelationClassifier (areaDescriptionPtr,
+															fileInfoPtr,
+															clsfyVariablePtr,
+															outputBufferPtr,
+															probabilityBufferPtr,
+															countVectorPtr,  
+															point);
+			break;
+			
+		case kCEMMode:
+			returnCode = CEMClassifier (areaDescriptionPtr,
+													fileInfoPtr,
+													clsfyVariablePtr,
+													outputBufferPtr,
+													probabilityBufferPtr,
+													countVectorPtr,  
+													point);
+			break;
+			
+		case kParallelPipedMode:
+			returnCode = ParallelPipedClassifier (areaDescriptionPtr,
+																fileInfoPtr,
+																clsfyVariablePtr,
+																outputBufferPtr,
+																probabilityBufferPtr,
+																countVectorPtr,  
+																point);
+			break;
+			
+		}	// end "switch (gClassifySpecsPtr->mode)"
+	
+	return (returnCode);
+			
+}	// end "ClassifyLine"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void ClassifyLinesTask
+//
+//	Software purpose:	The purpose of this routine is to classify the lines in the
+//							current group of lines in the block of lines that belong to
+//							the input slot. A slot classifies every numberSlots line
+//							starting with the line for the slot index. The classes are 
+//							stored over the data for the line in the block buffer. It may
+//							run in a worker thread so no user events are checked and no 
+//							results are written.
+//
+//	Parameters in:		Pointer to the classify lines structure.
+//							Index of the slot.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+// 
+// Called By:			RunTasksInParallel in SThreads.cpp
+
+void ClassifyLinesTask (
+				void*									taskInfoPtr,
+				UInt32								task)
+	
+{
+	Point									point;
+	
+	ClassifyLinesPtr					classifyLinesPtr;
+	ClassifyLinesSlotPtr				slotPtr;
+	
+	SInt32								line;
+	
+	UInt32								blockLineIndex,
+											index,
+											numberSamples;
+	
+	
+	classifyLinesPtr = (ClassifyLinesPtr)taskInfoPtr;
+	slotPtr = &classifyLinesPtr->slotPtr[task];
+	
+	for (index=task; 
+			index<classifyLinesPtr->numberLines; 
+				index+=classifyLinesPtr->numberSlots)
+		{
+		blockLineIndex = classifyLinesPtr->blockLineIndex + index;
+		numberSamples = classifyLinesPtr->numberSamplesPtr[blockLineIndex];
+		
+		if (numberSamples > 0)
+			{
+			line = classifyLinesPtr->line + index * classifyLinesPtr->lineInterval;
+			
+			slotPtr->areaDescription.line = line;
+			slotPtr->areaDescription.numSamplesPerChan = numberSamples;
+			point.v = (SInt16)line;
+			point.h = (SInt16)classifyLinesPtr->columnStart;
+			
+			ClassifyLine (&slotPtr->areaDescription,
+								classifyLinesPtr->fileInfoPtr,
+								&slotPtr->classifierVar,
+								&classifyLinesPtr->blockBufferPtr[
+														blockLineIndex*classifyLinesPtr->lineBytes],
+								&classifyLinesPtr->probabilityBufferPtr[
+														index*classifyLinesPtr->probabilityLineBytes],
+								slotPtr->countVectorPtr,
+								point);
+			
+			}	// end "if (numberSamples > 0)"
+		
+		}	// end "for (index=task; index<classifyLinesPtr->numberLines; ..."
+			
+}	// end "ClassifyLinesTask"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -2910,12 +3184,20 @@ SInt16 ClassifyPerPointArea (
 								
 	Point									point;		
 	
+	ClassifyLines						classifyLines;
+	
 	CMFileStream						*clProbabilityFileStreamPtr,
 											*resultsFileStreamPtr;
-											
+	
+	ClassifyLinesPtr					classifyLinesPtr;
 	FileInfoPtr							fileInfoPtr;
 	                   
-	HUCharPtr	 						inputBufferPtr,
+	OutputWriterPtr					probabilityWriterPtr,
+											resultsWriterPtr;
+	                   
+	HUCharPtr	 						blockBufferPtr,
+											dataBufferPtr,
+											inputBufferPtr,
 											outputBufferPtr,
 											probabilityBufferPtr;
 											
@@ -2925,6 +3207,7 @@ SInt16 ClassifyPerPointArea (
 	Ptr									stringPtr;
 	SInt16								*classPtr;
 	UInt16								*channelsPtr;
+	UInt32								*numberOutputSamplesPtr;
 	WindowInfoPtr 						imageWindowInfoPtr;
 	WindowPtr							windowPtr;
 	
@@ -2939,7 +3222,14 @@ SInt16 ClassifyPerPointArea (
 											lineEnd,
 											lineInterval;
 	
-	UInt32								linesLeft,
+	UInt32								blockClassifiedLineCount,
+											blockLineCount,
+											blockLineIndex,
+											lineBytes,
+											linesLeft,
+											numberBlockLines,
+											numberSamples,
+											singleLineNumberSamples,
 											skipCount,
 											startTick;
 	
@@ -2994,6 +3284,10 @@ SInt16 ClassifyPerPointArea (
 													channelsPtr,
 													kDetermineSpecialBILFlag);
 													
+			// Only read the columns within the mask or polygon for each line.
+			
+	SetUpAreaColumnRuns (fileIOInstructionsPtr, areaDescriptionPtr);
+													
 			// Get the input and output buffers to be used.
 	
 	inputBufferPtr = fileIOInstructionsPtr->inputBufferPtrs[
@@ -3006,6 +3300,70 @@ SInt16 ClassifyPerPointArea (
 	probabilityBufferPtr = 
 							&outputBufferPtr[gClassifySpecsPtr->probabilityBufferOffset];
 	
+			// Get a buffer to read a block of lines into at one time. Each line is
+			// copied to the output buffer before it is classified since the 
+			// classifiers use the rest of the output buffer for the results. If 
+			// threaded IO is being used or memory is not available for the block, 
+			// read one line at a time directly into the output buffer.
+	
+	numberSamples = (areaDescriptionPtr->columnEnd - areaDescriptionPtr->columnStart + 
+				areaDescriptionPtr->columnInterval)/areaDescriptionPtr->columnInterval;
+	lineBytes = numberSamples * gClassifySpecsPtr->numberChannels * sizeof (double);
+	
+	blockBufferPtr = NULL;
+	if (!GetThreadedIOFlag (fileIOInstructionsPtr))
+		blockBufferPtr = GetLinesOfDataBuffer (lineBytes,
+															areaDescriptionPtr->numberLines,
+															&numberBlockLines,
+															&numberOutputSamplesPtr);
+	
+	if (blockBufferPtr == NULL)
+		{
+		numberBlockLines = 1;
+		numberOutputSamplesPtr = &singleLineNumberSamples;
+		
+		}	// end "if (blockBufferPtr == NULL)"
+		
+	blockClassifiedLineCount = 0;
+	blockLineCount = 0;
+	blockLineIndex = 0;
+	
+			// Set up to classify groups of lines in the block on worker threads if
+			// more than one thread can be used. The results are still written and
+			// drawn in line order by this thread. This is not done for the special
+			// test case or for polygon areas.
+	
+	classifyLinesPtr = NULL;
+	if (blockBufferPtr != NULL && 
+				!gTestFlag && 
+						!areaDescriptionPtr->polygonFieldFlag &&
+								SetUpClassifyLines (&classifyLines,
+															areaDescriptionPtr,
+															fileInfoPtr,
+															clsfyVariablePtr,
+															blockBufferPtr,
+															numberOutputSamplesPtr,
+															numberBlockLines,
+															lineBytes,
+															numberSamples))
+		classifyLinesPtr = &classifyLines;
+	
+			// Get the output writers for the classification and probability files
+			// so that the lines are written to the files in large blocks on a
+			// separate thread while the next lines are being classified. The lines
+			// are written directly to the files if the writers are not available.
+			// The classification file stream is also used for ascii output so the
+			// writer is not used when ascii output to a disk file is requested.
+	
+	resultsWriterPtr = NULL;
+	if ((gOutputCode & kClassifyFileCode) && !(gOutputCode & kAsciiFormatCode) &&
+														fileIOInstructionsPtr->maskBufferPtr == NULL)
+		resultsWriterPtr = CreateOutputWriter (resultsFileStreamPtr);
+	
+	probabilityWriterPtr = NULL;
+	if ((gOutputCode & kProbFormatCode) && fileIOInstructionsPtr->maskBufferPtr == NULL)
+		probabilityWriterPtr = CreateOutputWriter (clProbabilityFileStreamPtr);
+	
 			// This is for Quiog's special case.
 	
 	if (gTestFlag)		
@@ -3106,118 +3464,110 @@ SInt16 ClassifyPerPointArea (
 				
 			}	// end "if (TickCount () >= lineLoopNextTime)" 
 		
-				// Get all requested channels for line of image data.  Return 		
+				// Get all requested channels for the next block of lines of image 
+				// data if all lines in the current block have been used.  Return 		
 				// if there is a file IO error.												
-				 
-		errCode = GetLineOfData (fileIOInstructionsPtr,
-											line, 
-											(UInt32)areaDescriptionPtr->columnStart,
-											(UInt32)areaDescriptionPtr->columnEnd,
-											(UInt32)areaDescriptionPtr->columnInterval,
-											inputBufferPtr,
-											outputBufferPtr);
+		
+		if (blockLineIndex >= blockLineCount)
+			{
+			dataBufferPtr = blockBufferPtr;
+			if (dataBufferPtr == NULL)
+				dataBufferPtr = outputBufferPtr;
+				
+			blockLineCount = (lineEnd - line)/lineInterval + 1;
+			blockLineCount = MIN (blockLineCount, numberBlockLines);
 			
-		if (errCode < noErr)
+			errCode = GetLinesOfData (fileIOInstructionsPtr,
+												line, 
+												blockLineCount,
+												lineInterval,
+												(UInt32)areaDescriptionPtr->columnStart,
+												(UInt32)areaDescriptionPtr->columnEnd,
+												(UInt32)areaDescriptionPtr->columnInterval,
+												inputBufferPtr,
+												dataBufferPtr,
+												lineBytes,
+												numberOutputSamplesPtr);
+			
+			if (errCode < noErr)
+				{
+				returnCode = 2;
+				break;
+				
+				}	// end "if (errCode < noErr)"
+				
+			blockLineIndex = 0;
+			blockClassifiedLineCount = 0;
+			
+			}	// end "if (blockLineIndex >= blockLineCount)"
+			
+				// Classify the next group of lines in the block on the worker 
+				// threads if all lines classified so far have been used.
+		
+		if (classifyLinesPtr != NULL && blockLineIndex >= blockClassifiedLineCount)
 			{
-			returnCode = 2;
-			break;
+			classifyLinesPtr->line = line;
+			classifyLinesPtr->blockLineIndex = blockLineIndex;
+			classifyLinesPtr->numberLines = MIN (classifyLinesPtr->maxNumberLines,
+																blockLineCount - blockLineIndex);
+			
+			RunTasksInParallel (classifyLinesPtr->numberSlots, 
+										ClassifyLinesTask, 
+										classifyLinesPtr);
+			
+			blockClassifiedLineCount = blockLineIndex + classifyLinesPtr->numberLines;
 			
-			}	// end "if (errCode < noErr)"
+			}	// end "if (classifyLinesPtr != NULL && ..."
 			
-		if (errCode != kSkipLine)
+				// A line with 0 samples was skipped because there are no requested
+				// mask values in it.
+			
+		numberSamples = numberOutputSamplesPtr[blockLineIndex];
+		
+		if (classifyLinesPtr != NULL && numberSamples > 0)
+			{
+					// The line has already been classified. Copy the classes with the
+					// end of line characters and the probability values to the output
+					// buffer.
+			
+			BlockMoveData (&blockBufferPtr[blockLineIndex*lineBytes],
+								outputBufferPtr,
+								numberSamples + 3);
+			
+			if (classifyLinesPtr->probabilityLineBytes > 0)
+				BlockMoveData (&classifyLinesPtr->probabilityBufferPtr[
+											(blockLineIndex - classifyLinesPtr->blockLineIndex) *
+																	classifyLinesPtr->probabilityLineBytes],
+									probabilityBufferPtr,
+									numberSamples);
+			
+			}	// end "if (classifyLinesPtr != NULL && numberSamples > 0)"
+		
+		else if (blockBufferPtr != NULL && numberSamples > 0)
+			BlockMoveData (&blockBufferPtr[blockLineIndex*lineBytes],
+								outputBufferPtr,
+								numberSamples * gClassifySpecsPtr->numberChannels * 
+																						sizeof (double));
+								
+		blockLineIndex++;
+			
+		if (numberSamples > 0)
 			{ 		
 					// Classify the line of data with specified classifier.				
 			
 			areaDescriptionPtr->line = line;
-			areaDescriptionPtr->numSamplesPerChan = 
-												fileIOInstructionsPtr->numberOutputBufferSamples;
+			areaDescriptionPtr->numSamplesPerChan = numberSamples;
 			point.v = (SInt16)line;
-			point.h = (SInt16)areaDescriptionPtr->columnStart;									
-			switch (gClassifySpecsPtr->mode)
-				{
-				case kMaxLikeMode:
-				case kMahalanobisMode:
-					returnCode = MaximumLikelihoodClassifier (areaDescriptionPtr,
-																			fileInfoPtr,
-																			clsfyVariablePtr,
-																			outputBufferPtr,
-																			probabilityBufferPtr, 
-																			countVectorPtr,  
-																			point);
-					break;
-
-				case kFisherMode:
-					returnCode = FisherClassifier (areaDescriptionPtr,
-																fileInfoPtr,
-																clsfyVariablePtr,
-																outputBufferPtr,
-																probabilityBufferPtr, 
-																countVectorPtr,  
-																point);
-					break;
-            
-				case kSupportVectorMachineMode:
-					returnCode = SupportVectorMachineClassifier (areaDescriptionPtr,
-																				 fileInfoPtr,
-																				 clsfyVariablePtr,
-																				 outputBufferPtr,
-																				 probabilityBufferPtr,
-																				 countVectorPtr,
-																				 point);
-               break;
-					
-				case kKNearestNeighborMode:
-					returnCode = KNNClassifier (areaDescriptionPtr,
-                                              fileInfoPtr,
-                                              clsfyVariablePtr,
-                                              outputBufferPtr,
-                                              probabilityBufferPtr,
-                                              countVectorPtr,
-                                              point);
-					break;
-
-					
-				case kEuclideanMode:
-					returnCode = EuclideanClassifier (areaDescriptionPtr,
-																	fileInfoPtr,
-																	clsfyVariablePtr,
-																	outputBufferPtr,
-																	probabilityBufferPtr,
-																	countVectorPtr,  
-																	point);
-					break;
-					
-				case kCorrelationMode:
-					returnCode = CorrelationClassifier (areaDescriptionPtr,
-																	fileInfoPtr,
-																	clsfyVariablePtr,
-																	outputBufferPtr,
-																	probabilityBufferPtr,
-																	countVectorPtr,  
-																	point);
-					break;
-					
-				case kCEMMode:
-					returnCode = CEMClassifier (areaDescriptionPtr,
-															fileInfoPtr,
-															clsfyVariablePtr,
-															outputBufferPtr,
-															probabilityBufferPtr,
-															countVectorPtr,  
-															point);
-					break;
-					
-				case kParallelPipedMode:
-					returnCode = ParallelPipedClassifier (areaDescriptionPtr,
-																		fileInfoPtr,
-																		clsfyVariablePtr,
-																		outputBufferPtr,
-																		probabilityBufferPtr,
-																		countVectorPtr,  
-																		point);
-					break;
-					
-				}	// end "switch (gClassifySpecsPtr->mode)" 
+			point.h = (SInt16)areaDescriptionPtr->columnStart;
+			
+			if (classifyLinesPtr == NULL)
+				returnCode = ClassifyLine (areaDescriptionPtr,
+													fileInfoPtr,
+													clsfyVariablePtr,
+													outputBufferPtr,
+													probabilityBufferPtr, 
+													countVectorPtr,  
+													point);
 				
 			if (returnCode == 3)
 				break;
@@ -3227,6 +3577,8 @@ SInt16 ClassifyPerPointArea (
 																		areaDescriptionPtr, 
 																		resultsFileStreamPtr, 
 																		clProbabilityFileStreamPtr, 
+																		resultsWriterPtr,
+																		probabilityWriterPtr,
 																		countVectorPtr, 
 																		lineCount);
 			if (returnCode == 1)
@@ -3251,7 +3603,7 @@ SInt16 ClassifyPerPointArea (
 													
 				}	// end "if (gOutputCode & kCreateImageOverlayCode)"
 				
-			}	// end "if (errCode != kSkipLine)"
+			}	// end "if (numberSamples > 0)"
 		
 				// If this in an image area, update dialog status information.		
 		
@@ -3296,6 +3648,28 @@ SInt16 ClassifyPerPointArea (
 												fileIOInstructionsPtr->numberMaskColumnsPerLine;
 										
 		}	// end "for (line=areaDescriptionPtr->lineStart; line..." 
+	
+	if (classifyLinesPtr != NULL)
+		CloseClassifyLines (classifyLinesPtr, clsfyVariablePtr, countVectorPtr);
+		
+	CheckAndDisposePtr ((Ptr)blockBufferPtr);
+	
+			// Write the rest of the lines in the output writers and release them.
+			// A write error is handled the same way as it is in 
+			// WriteClassificationResults.
+	
+	errCode = CloseOutputWriter (resultsWriterPtr);
+	if (CloseOutputWriter (probabilityWriterPtr) != noErr)
+		errCode = 1;
+		
+	if (errCode != noErr)
+		{
+		gOutputCode = (gOutputCode & 0xfff3);
+		gOutputForce1Code = gOutputCode;
+		if (!gOutputCode && returnCode == noErr)
+			returnCode = 1;
+			
+		}	// end "if (errCode != noErr)"
 		
 	LoadDItemValue (gStatusDialogPtr, IDC_Status18, (SInt32)lineCount);
 	  	
@@ -3658,6 +4032,63 @@ SInt16 ClassifyTrainTestFields (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void CloseClassifyLines
+//
+//	Software purpose:	The purpose of this routine is to add the class counts, same
+//							distance counts and discriminant sums for each of the slots 
+//							used to classify lines on worker threads to those for the 
+//							area and then release the memory for the slots.
+//
+//	Parameters in:		Pointer to the classify lines structure.
+//							Pointer to classification variable structure for the area.
+//							Pointer to the class count vector for the area.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+// 
+// Called By:			ClassifyPerPointArea
+
+void CloseClassifyLines (
+				ClassifyLinesPtr					classifyLinesPtr,
+				ClassifierVarPtr					clsfyVariablePtr, 
+				HSInt64Ptr							countVectorPtr)
+	
+{
+	ClassifyLinesSlotPtr				slotPtr;
+	
+	UInt32								index,
+											numberCounts,
+											slot;
+	
+	
+	numberCounts = gProjectInfoPtr->numberStatisticsClasses + 1;
+	
+	for (slot=0; slot<classifyLinesPtr->numberSlots; slot++)
+		{
+		slotPtr = &classifyLinesPtr->slotPtr[slot];
+		
+		for (index=0; index<numberCounts; index++)
+			countVectorPtr[index] += slotPtr->countVectorPtr[index];
+			
+		clsfyVariablePtr->totalSameDistanceSamples += 
+											slotPtr->classifierVar.totalSameDistanceSamples;
+		*clsfyVariablePtr->discriminantSumPtr += slotPtr->discriminantSum;
+		
+		}	// end "for (slot=0; slot<classifyLinesPtr->numberSlots; slot++)"
+	
+	classifyLinesPtr->slotBufferPtr = 
+							(HUCharPtr)CheckAndDisposePtr ((Ptr)classifyLinesPtr->slotBufferPtr);
+	classifyLinesPtr->slotPtr = 
+				(ClassifyLinesSlotPtr)CheckAndDisposePtr ((Ptr)classifyLinesPtr->slotPtr);
+			
+}	// end "CloseClassifyLines"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -3893,7 +4324,7 @@ SInt16 CorrelationClassifier (
 				*thresholdBufferPtr = (UInt8)classIndex;
 				thresholdBufferPtr++;
 				
-				gTempDoubleVariable1 += discriminantMax;
+				*clsfyVariablePtr->discriminantSumPtr += discriminantMax;
 		   	
 		   	}	// end "if (createCorrelationValuesFlag)"	
 		   
@@ -3922,7 +4353,7 @@ SInt16 CorrelationClassifier (
 			
 				// Exit routine if user selects "cancel" or "command period".		
 		
-		if (TickCount () >= gNextTime)
+		if (!clsfyVariablePtr->workerTaskFlag && TickCount () >= gNextTime)
 			{
 			if (!CheckSomeEvents (osMask+keyDownMask+updateMask+mDownMask+mUpMask))
 																								return (3);
@@ -4660,6 +5091,7 @@ Boolean CreateSupportVectorMachineModel (
 	struct svm_problem 				prob;
 	
 	double*								inputDataVectorPtr;
+	float*								floatDataVectorPtr;
 	
 	double								totalProbability;
 	
@@ -4830,6 +5262,12 @@ Boolean CreateSupportVectorMachineModel (
 		baseIndex = 0;
 		pixelCount = 0;
 		inputDataVectorPtr = gProjectInfoPtr->knnDataValuesPtr;
+		floatDataVectorPtr = NULL;
+		if (gProjectInfoPtr->trainingStoreValueBytes == 8)
+			inputDataVectorPtr = (double*)gProjectInfoPtr->trainingStoreValuesPtr;
+		else if (gProjectInfoPtr->trainingStoreValueBytes == 4)
+			floatDataVectorPtr = (float*)gProjectInfoPtr->trainingStoreValuesPtr;
+		
 		for (int i=0; i<numberPixels; i++)
 			{
 			if (classVectorPtr[gProjectInfoPtr->knnLabelsPtr[i]])
@@ -4842,7 +5280,10 @@ Boolean CreateSupportVectorMachineModel (
 					
 					index = baseIndex + channelsPtr[j];
 					x_space[jj].index = j + 1;
-					x_space[jj].value = inputDataVectorPtr[index];
+					if (floatDataVectorPtr != NULL)
+						x_space[jj].value = floatDataVectorPtr[index];
+					else	// floatDataVectorPtr == NULL
+						x_space[jj].value = inputDataVectorPtr[index];
 					++jj;
 					//inputDataVectorPtr++;
 					
@@ -5307,7 +5748,7 @@ SInt16 EuclideanClassifier (
 			
 				// Exit routine if user selects "cancel" or "command period".		
 		
-		if (TickCount () >= gNextTime)
+		if (!clsfyVariablePtr->workerTaskFlag && TickCount () >= gNextTime)
 			{
 			if (!CheckSomeEvents (osMask+keyDownMask+updateMask+mDownMask+mUpMask))
 																								return (3);
@@ -5637,7 +6078,7 @@ SInt16 FisherClassifier (
 				*probabilityBufferPtr = (UInt8)classIndex;
 				probabilityBufferPtr++;
 				
-				gTempDoubleVariable1 += thresholdProbabilityPtr[classIndex];
+				*clsfyVariablePtr->discriminantSumPtr += thresholdProbabilityPtr[classIndex];
 				
 				}	// end "if (createProbabilities)"  
 				
@@ -5669,7 +6110,7 @@ SInt16 FisherClassifier (
 			
 				// Exit routine if user selects "cancel" or "command period".		
 		
-		if (TickCount () >= gNextTime)
+		if (!clsfyVariablePtr->workerTaskFlag && TickCount () >= gNextTime)
 			{
 			if (!CheckSomeEvents (osMask+keyDownMask+updateMask+mDownMask+mUpMask))
 																								return (3);
@@ -6522,7 +6963,8 @@ Boolean GetTtInvTransformedCommonCovarianceT (
 																	gInverseMatrixMemory.ipvotPtr,
 																	&determinant, 
 																	logDeterminantPtr,
-																	kReturnMatrixInverse);
+																	kReturnMatrixInverse,
+																	kCheckEvents);
 	
 	if (gOperationCanceledFlag)
 		continueFlag = FALSE;
@@ -6629,7 +7071,8 @@ Boolean GetTtInvTransformedCovarianceT (
 																	gInverseMatrixMemory.ipvotPtr, 
 																	&determinant,
 																	logDeterminantPtr,
-																	kReturnMatrixInverse);
+																	kReturnMatrixInverse,
+																	kCheckEvents);
 	
 	if (gOperationCanceledFlag)
 		continueFlag = FALSE;
@@ -6708,6 +7151,7 @@ void InitializeClassifierVarStructure (
 		classifierVarPtr->variable2 = 0;
 		classifierVarPtr->variable3 = 0;
 		classifierVarPtr->chanMeanPtr = NULL;
+		classifierVarPtr->discriminantSumPtr = &gTempDoubleVariable1;
 		classifierVarPtr->classConstantPtr = NULL;
 		classifierVarPtr->classConstant2Ptr = NULL;
 		classifierVarPtr->classConstantLOO1Ptr = NULL;
@@ -6720,6 +7164,8 @@ void InitializeClassifierVarStructure (
 		classifierVarPtr->workVector2Ptr = NULL;
 		classifierVarPtr->countVectorPtr = NULL;
 		classifierVarPtr->countClassIndexPtr = NULL;
+		classifierVarPtr->knnDistancesPtr = NULL;
+		classifierVarPtr->svm_x = NULL;
 		classifierVarPtr->totalCorrectSamples = 0;
 		classifierVarPtr->totalNumberSamples = 0;
 		classifierVarPtr->totalSameDistanceSamples = -1;
@@ -6732,6 +7178,7 @@ void InitializeClassifierVarStructure (
 		classifierVarPtr->summaryCode = 0;
 		classifierVarPtr->tableType = 0;
 		classifierVarPtr->thresholdFlag = FALSE;
+		classifierVarPtr->workerTaskFlag = FALSE;
 		
 		}	// end "if (classifierVarPtr != NULL)" 
 			
@@ -6785,21 +7232,26 @@ SInt16 KNNClassifier (
    HDoublePtr                    ioBufferReal8Ptr,
    										savedBufferReal8Ptr;
 	
+	double*								doubleValuesPtr;
+	float*								floatValuesPtr;
+	knnType*								knnDistancesPtr;
+	
    SInt16                        *channelsPtr,
    										*classVectorPtr;
 	
 	double								dDistance,
 											dValue;
+	
+	SInt64								baseIndex,
+											index;
 
 	int									topK[257],
 											topKTemp[257];
 	
 	SInt16								kValue;
 	
-   UInt32                        baseIndex,
-   										equalClassCount,
+   UInt32                        equalClassCount,
    										feat,
-											index,
 											maxClass,
 											numberChannels,
 											numberProjectChannels,
@@ -6830,6 +7282,22 @@ SInt16 KNNClassifier (
 	int knnPixelSize = gProjectInfoPtr->knnCounter;
 	//int knnPixelSize = gProjectInfoPtr->knnCounter;
 	
+			// The training pixel values may be in the training pixel store
+			// instead of memory. The store may contain float values.
+	
+	doubleValuesPtr = gProjectInfoPtr->knnDataValuesPtr;
+	floatValuesPtr = NULL;
+	if (gProjectInfoPtr->trainingStoreValueBytes == 8)
+		doubleValuesPtr = (double*)gProjectInfoPtr->trainingStoreValuesPtr;
+	else if (gProjectInfoPtr->trainingStoreValueBytes == 4)
+		floatValuesPtr = (float*)gProjectInfoPtr->trainingStoreValuesPtr;
+	
+			// A worker task has its own vector for the distances.
+	
+	knnDistancesPtr = clsfyVariablePtr->knnDistancesPtr;
+	if (knnDistancesPtr == NULL)
+		knnDistancesPtr = gProjectInfoPtr->knnDistancesPtr;
+	
    		// Loop through the number of samples in the line of data
 	
    for (sample=0; sample<numberSamplesPerChan; sample++)
@@ -6858,7 +7326,10 @@ SInt16 KNNClassifier (
 					for (feat=0; feat<numberChannels; feat++)
 						{
 						index = baseIndex + channelsPtr[feat];
-						dValue = gProjectInfoPtr->knnDataValuesPtr[index] - *ioBufferReal8Ptr;
+						if (floatValuesPtr != NULL)
+							dValue = floatValuesPtr[index] - *ioBufferReal8Ptr;
+						else	// floatValuesPtr == NULL
+							dValue = doubleValuesPtr[index] - *ioBufferReal8Ptr;
 						dDistance += dValue * dValue;
 						
 						//index++;
@@ -6866,8 +7337,8 @@ SInt16 KNNClassifier (
 						
 						}	// end "for (feat=0; feat<numberChannels; feat++)"
 					
-					gProjectInfoPtr->knnDistancesPtr[i].distance = dDistance;
-					gProjectInfoPtr->knnDistancesPtr[i].index = i;
+					knnDistancesPtr[i].distance = dDistance;
+					knnDistancesPtr[i].index = i;
 					
 					}	// end "if (classVectorPtr[gProjectInfoPtr->knnLabelsPtr[i]])"
 				
@@ -6895,7 +7366,7 @@ SInt16 KNNClassifier (
 					{
          		if (classVectorPtr[gProjectInfoPtr->knnLabelsPtr[pixelIndex]])
          			{
-						it = gProjectInfoPtr->knnDistancesPtr[pixelIndex];
+						it = knnDistancesPtr[pixelIndex];
 						if (it.distance < minTempDistance)
 							{
 							minTempDistance = it.distance;
@@ -6909,7 +7380,7 @@ SInt16 KNNClassifier (
 					}	// end "for (it=gProjectInfoPtr->knn_labels.begin (); ..."
 				
 				topKTemp[i] = minTempLabel;
-				gProjectInfoPtr->knnDistancesPtr[minTempIndex].distance = DBL_MAX;
+				knnDistancesPtr[minTempIndex].distance = DBL_MAX;
 				
          	}	// end "for (int i=0; i<kValue; i++)"
 
@@ -6957,7 +7428,7 @@ SInt16 KNNClassifier (
 						// This is used to determine the average number of k nearest
 						// neighbor values
 				
-				gTempDoubleVariable1 += max;
+				*clsfyVariablePtr->discriminantSumPtr += max;
 				
 		   	}	// end "if (createThresholdFlag)"
 		
@@ -6975,7 +7446,7 @@ SInt16 KNNClassifier (
 	
       		// Exit routine if user selects "cancel" or "command period".
 	
-      if (TickCount () >= gNextTime)
+      if (!clsfyVariablePtr->workerTaskFlag && TickCount () >= gNextTime)
       	{
          if (!CheckSomeEvents (osMask+keyDownMask+updateMask+mDownMask+mUpMask))
             return (3);
@@ -8669,7 +9140,7 @@ SInt16 MaximumLikelihoodClassifier (
 				*probabilityBufferPtr = (UInt8)classIndex;
 				probabilityBufferPtr++;
 				
-				gTempDoubleVariable1 += thresholdProbabilityPtr[classIndex];
+				*clsfyVariablePtr->discriminantSumPtr += thresholdProbabilityPtr[classIndex];
 				
 				}	// end "if (createProbabilities)" 
 		   
@@ -8697,7 +9168,7 @@ SInt16 MaximumLikelihoodClassifier (
 			
 				// Exit routine if user selects "cancel" or "command period".		
 		
-		if (TickCount () >= gNextTime)
+		if (!clsfyVariablePtr->workerTaskFlag && TickCount () >= gNextTime)
 			{
 			if (!CheckSomeEvents (osMask+keyDownMask+updateMask+mDownMask+mUpMask))
 																						return (3);
@@ -9224,7 +9695,7 @@ SInt16 ParallelPipedClassifier (
 			
 				// Exit routine if user selects "cancel" or "command period".		
 		
-		if (TickCount () >= gNextTime)
+		if (!clsfyVariablePtr->workerTaskFlag && TickCount () >= gNextTime)
 			{
 			if (!CheckSomeEvents (osMask+keyDownMask+updateMask+mDownMask+mUpMask))
 																								return (3);
@@ -9435,6 +9906,176 @@ void ParallelPipedClsfierControl (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean SetUpClassifyLines
+//
+//	Software purpose:	The purpose of this routine is to set up the structure used
+//							to classify groups of lines in the block of lines on worker 
+//							threads. Each slot gets a copy of the classifier variables
+//							with its own work vectors, class count vector, k nearest 
+//							neighbor distance vector and support vector machine data 
+//							vector. Nothing is set up if only one thread can be used or
+//							memory is not available.
+//
+//	Parameters in:		Pointer to the classify lines structure.
+//							Pointer to the area description structure.
+//							Pointer to image file information structure.
+//							Pointer to classification variable structure for the area.
+//							Pointer to the block buffer.
+//							Pointer to the vector of the number of samples in each line
+//								of the block buffer.
+//							Number of lines in the block buffer.
+//							Number of bytes for each line in the block buffer.
+//							Maximum number of samples in a line.
+//
+//	Parameters out:	None
+//
+// Value Returned:	TRUE if lines can be classified on worker threads.
+//							FALSE if not.
+// 
+// Called By:			ClassifyPerPointArea
+
+Boolean SetUpClassifyLines (
+				ClassifyLinesPtr					classifyLinesPtr,
+				AreaDescriptionPtr				areaDescriptionPtr,
+				FileInfoPtr							fileInfoPtr,
+				ClassifierVarPtr					clsfyVariablePtr,
+				HUCharPtr							blockBufferPtr,
+				UInt32*								numberSamplesPtr,
+				UInt32								numberBlockLines,
+				UInt32								lineBytes,
+				UInt32								numberSamples)
+	
+{
+	ClassifierVarPtr					slotClassifierVarPtr;
+	ClassifyLinesSlotPtr				slotPtr;
+	HUCharPtr							bufferPtr;
+	
+	SInt64								knnBytes,
+											numberSlotBytes;
+	
+	UInt32								countBytes,
+											index,
+											numberChannels,
+											numberCounts,
+											numberSlots,
+											slot,
+											svmBytes,
+											workBytes;
+	
+	
+	numberSlots = GetNumberWorkerThreads (numberBlockLines);
+	if (numberSlots <= 1)
+																						return (FALSE);
+	
+	numberChannels = gClassifySpecsPtr->numberChannels;
+	numberCounts = gProjectInfoPtr->numberStatisticsClasses + 1;
+	
+			// Get the number of bytes needed for each slot. Each of the vectors
+			// will start on an 8-byte boundary.
+	
+	countBytes = numberCounts * sizeof (SInt64);
+	workBytes = 2 * numberChannels * sizeof (double);
+	
+	knnBytes = 0;
+	if (gClassifySpecsPtr->mode == kKNearestNeighborMode)
+		knnBytes = (SInt64)gProjectInfoPtr->knnCounter * sizeof (knnType);
+	
+	svmBytes = 0;
+	if (gClassifySpecsPtr->mode == kSupportVectorMachineMode)
+		svmBytes = (numberChannels + 1) * sizeof (struct svm_node);
+	
+	numberSlotBytes = countBytes + workBytes + knnBytes + svmBytes;
+	numberSlotBytes = (numberSlotBytes + 7) & ~((SInt64)7);
+	
+	classifyLinesPtr->maxNumberLines = numberSlots * kClassifyLinesPerThread;
+	
+	classifyLinesPtr->probabilityLineBytes = 0;
+	if (gClassifySpecsPtr->createThresholdTableFlag)
+		classifyLinesPtr->probabilityLineBytes = numberSamples;
+	
+	classifyLinesPtr->slotPtr = (ClassifyLinesSlotPtr)MNewPointer (
+													numberSlots * sizeof (ClassifyLinesSlot));
+	
+	classifyLinesPtr->slotBufferPtr = NULL;
+	if (classifyLinesPtr->slotPtr != NULL)
+		classifyLinesPtr->slotBufferPtr = (HUCharPtr)MNewPointer (
+					numberSlots * numberSlotBytes + 
+						(SInt64)classifyLinesPtr->maxNumberLines * 
+													classifyLinesPtr->probabilityLineBytes);
+	
+	if (classifyLinesPtr->slotBufferPtr == NULL)
+		{
+		classifyLinesPtr->slotPtr = 
+				(ClassifyLinesSlotPtr)CheckAndDisposePtr ((Ptr)classifyLinesPtr->slotPtr);
+																						return (FALSE);
+		
+		}	// end "if (classifyLinesPtr->slotBufferPtr == NULL)"
+	
+	classifyLinesPtr->fileInfoPtr = fileInfoPtr;
+	classifyLinesPtr->blockBufferPtr = blockBufferPtr;
+	classifyLinesPtr->numberSamplesPtr = numberSamplesPtr;
+	classifyLinesPtr->columnStart = areaDescriptionPtr->columnStart;
+	classifyLinesPtr->line = areaDescriptionPtr->lineStart;
+	classifyLinesPtr->lineInterval = areaDescriptionPtr->lineInterval;
+	classifyLinesPtr->blockLineIndex = 0;
+	classifyLinesPtr->lineBytes = lineBytes;
+	classifyLinesPtr->numberLines = 0;
+	classifyLinesPtr->numberSlots = numberSlots;
+	
+			// The probability values for the lines in a group follow the slots.
+	
+	classifyLinesPtr->probabilityBufferPtr = 
+							&classifyLinesPtr->slotBufferPtr[numberSlots * numberSlotBytes];
+	
+	bufferPtr = classifyLinesPtr->slotBufferPtr;
+	for (slot=0; slot<numberSlots; slot++)
+		{
+		slotPtr = &classifyLinesPtr->slotPtr[slot];
+		slotClassifierVarPtr = &slotPtr->classifierVar;
+		
+		slotPtr->areaDescription = *areaDescriptionPtr;
+		*slotClassifierVarPtr = *clsfyVariablePtr;
+		
+		slotPtr->discriminantSum = 0;
+		slotClassifierVarPtr->discriminantSumPtr = &slotPtr->discriminantSum;
+		slotClassifierVarPtr->totalSameDistanceSamples = 0;
+		slotClassifierVarPtr->workerTaskFlag = TRUE;
+		
+		slotPtr->countVectorPtr = (HSInt64Ptr)bufferPtr;
+		for (index=0; index<numberCounts; index++)
+			slotPtr->countVectorPtr[index] = 0;
+		
+		slotClassifierVarPtr->workVectorPtr = (HDoublePtr)&bufferPtr[countBytes];
+		slotClassifierVarPtr->workVector2Ptr = 
+											&slotClassifierVarPtr->workVectorPtr[numberChannels];
+		
+		if (knnBytes > 0)
+			slotClassifierVarPtr->knnDistancesPtr = 
+											(knnType*)&bufferPtr[countBytes + workBytes];
+		
+		if (svmBytes > 0)
+			{
+					// The channel indices are already loaded in the project vector.
+					
+			slotClassifierVarPtr->svm_x = 
+						(struct svm_node*)&bufferPtr[countBytes + workBytes + knnBytes];
+			BlockMoveData (gProjectInfoPtr->svm_x, slotClassifierVarPtr->svm_x, svmBytes);
+			
+			}	// end "if (svmBytes > 0)"
+		
+		bufferPtr += numberSlotBytes;
+		
+		}	// end "for (slot=0; slot<numberSlots; slot++)"
+	
+	return (TRUE);
+			
+}	// end "SetUpClassifyLines"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -9678,6 +10319,8 @@ SInt16 SupportVectorMachineClassifier (
    HDoublePtr                    ioBufferReal8Ptr,
 											savedBufferReal8Ptr;
 	
+	struct svm_node*					svm_x;
+	
    int									maxClass;
 	
    SInt16                        *classPtr;
@@ -9703,6 +10346,12 @@ SInt16 SupportVectorMachineClassifier (
    classPtr = 					gClassifySpecsPtr->classPtr;
    savedBufferReal8Ptr = (HDoublePtr)outputBuffer1Ptr;
 	
+			// A worker task has its own vector for the data values.
+	
+	svm_x = clsfyVariablePtr->svm_x;
+	if (svm_x == NULL)
+		svm_x = gProjectInfoPtr->svm_x;
+	
    		// Loop through the number of samples in the line of data
 	
    maxClass = 0;
@@ -9718,7 +10367,7 @@ SInt16 SupportVectorMachineClassifier (
 		
          for (feat=0; feat<numberChannels; feat++)
          	{
-            gProjectInfoPtr->svm_x[feat].value = *ioBufferReal8Ptr;
+            svm_x[feat].value = *ioBufferReal8Ptr;
             ioBufferReal8Ptr++;
 				
          	}	// end "for (feat=0; feat<numberChannels; feat++)"
@@ -9729,7 +10378,7 @@ SInt16 SupportVectorMachineClassifier (
 			
          		// SVM classifies data
 			
-         maxClass = (int)(svm_predict (gProjectInfoPtr->svmModel, gProjectInfoPtr->svm_x));
+         maxClass = (int)(svm_predict (gProjectInfoPtr->svmModel, svm_x));
          if (maxClass > 0 && maxClass <= numberProjectClasses)
          	{
          	countVectorPtr[maxClass]++;
@@ -9754,7 +10403,7 @@ SInt16 SupportVectorMachineClassifier (
 	
       		// Exit routine if user selects "cancel" or "command period".
 	
-      if (TickCount () >= gNextTime)
+      if (!clsfyVariablePtr->workerTaskFlag && TickCount () >= gNextTime)
       	{
          if (!CheckSomeEvents (osMask+keyDownMask+updateMask+mDownMask+mUpMask))
             return (3);
@@ -9862,7 +10511,9 @@ void SupportVectorMachineClassifierControl (
 //	Software purpose:	The purpose of this routine is to write the classification
 //							results to the request files and windows.
 //
-//	Parameters in:			
+//	Parameters in:		Output writers for the classification and probability files. 
+//							If an output writer is NULL, the line is written directly to
+//							the file.
 //
 //	Parameters out:	None
 //
@@ -9878,6 +10529,8 @@ SInt16 WriteClassificationResults (
 				AreaDescriptionPtr				areaDescriptionPtr, 
 				CMFileStream*						resultsFileStreamPtr, 
 				CMFileStream*						clProbabilityFileStreamPtr, 
+				OutputWriterPtr					resultsWriterPtr,
+				OutputWriterPtr					probabilityWriterPtr,
 				HSInt64Ptr							countVectorPtr, 
 				SInt32								lineNumber)
 
@@ -9948,10 +10601,14 @@ SInt16 WriteClassificationResults (
 			
 			}	// end "if (gOutputFormatCode == kGAIAType)" 
 		
-		errCode = MWriteData (resultsFileStreamPtr, 
-										&count, 
-										ioBuffer1Ptr,
-										kErrorMessages);	
+		if (resultsWriterPtr != NULL)
+			errCode = WriteToOutputWriter (resultsWriterPtr, ioBuffer1Ptr, count);
+			
+		else	// resultsWriterPtr == NULL
+			errCode = MWriteData (resultsFileStreamPtr, 
+											&count, 
+											ioBuffer1Ptr,
+											kErrorMessages);	
 		if (errCode != noErr)
 			{
 			gOutputCode = (gOutputCode & 0xfff3);
@@ -9968,10 +10625,16 @@ SInt16 WriteClassificationResults (
 			
 	if (gOutputCode & kProbFormatCode)
 		{
-		errCode = MWriteData (clProbabilityFileStreamPtr, 
-										&count, 
-										probabilityBufferPtr,
-										kErrorMessages);	
+		if (probabilityWriterPtr != NULL)
+			errCode = WriteToOutputWriter (probabilityWriterPtr, 
+														probabilityBufferPtr, 
+														count);
+			
+		else	// probabilityWriterPtr == NULL
+			errCode = MWriteData (clProbabilityFileStreamPtr, 
+											&count, 
+											probabilityBufferPtr,
+											kErrorMessages);	
 		if (errCode != noErr)
 			{
 			gOutputCode = (gOutputCode & 0xfff3);
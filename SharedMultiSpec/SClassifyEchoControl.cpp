@@ -662,6 +662,8 @@ SInt16 PostEchoClassifier (
 															  areaDescriptionPtr, 
 															  resultsFilePtr, 
 															  clProbabilityFilePtr, 
+															  NULL,
+															  NULL,
 															  countVectorPtr, 
 															  lineCount);
 		if (returnCode == 1)
@@ -960,7 +962,8 @@ Boolean SetupClsfierStats (void)
 											ipivotPtr,
 											&determinant,
 											&class_stat->Log_determinant,
-											kReturnMatrixInverse);
+											kReturnMatrixInverse,
+											kCheckEvents);
 				
 			}	// end "if (continueFlag && ..."
 												
@@ -1037,7 +1040,8 @@ Boolean SetupClsfierStats (void)
 																			ipivotPtr,
 																			&determinant,
 																			Log_determinant,
-																			kReturnMatrixInverse);
+																			kReturnMatrixInverse,
+																			kCheckEvents);
 										
 				if (gOperationCanceledFlag)
 					{
@@ -245,6 +245,25 @@
 
 //------------------------------------------------------------------------------------
 
+		// Structure used to find the closest cluster for the samples in the lines
+		// of a block of lines on worker threads. The cluster means do not change
+		// during a pass so each line can be done independently. The cluster 
+		// statistics are still updated in sample order by the calling thread.
+
+typedef struct ISODATAClusterLines
+	{
+	ClusterType*				clusterHead;
+	ClusterType**				closestClusterPtr;
+	HUCharPtr					blockBufferPtr;
+	UInt32*						numberSamplesPtr;
+	
+	UInt32						lineBytes;
+	UInt32						numberColumns;
+	
+	SInt16						numberChannels;
+	
+	} ISODATAClusterLines, *ISODATAClusterLinesPtr;
+
 			
 
 			// Prototypes for file routines that are only called from other 		
@@ -276,6 +295,10 @@ Boolean InitializeClusterCenters (
 SInt16 ISODATACluster (
 				FileIOInstructionsPtr			fileIOInstructionsPtr);
 
+void ISODATAClusterLineTask (
+				void*									taskInfoPtr,
+				UInt32								task);
+
 SInt16 ISODATAClusterPass (
 				FileIOInstructionsPtr			fileIOInstructionsPtr,
 				LCToWindowUnitsVariables* 		lcToWindowUnitsVariablesPtr,
@@ -2892,6 +2915,86 @@ void ISODATAClusterDialogOnTrainingAreas (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void ISODATAClusterLineTask
+//
+//	Software purpose:	The purpose of this routine is to find the closest cluster
+//							for each sample in the input line of the block of lines. The
+//							same search as in ISODATAClusterPass is used so that the 
+//							same cluster is found. It may run in a worker thread; only
+//							the closest cluster vector for the line is changed.
+//
+//	Parameters in:		Pointer to the ISODATA cluster lines structure.
+//							Index of the line in the block of lines.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+// 
+// Called By:			RunTasksInParallel in SThreads.cpp
+
+void ISODATAClusterLineTask (
+				void*									taskInfoPtr,
+				UInt32								task)
+
+{
+	double								closestDistance,
+											currentDistance;
+	
+   ClusterType 						*closestCluster,
+											**closestClusterPtr,
+  											*currentCluster;
+	
+	HCTypePtr     						currentPixel;
+	
+	ISODATAClusterLinesPtr			clusterLinesPtr;
+	
+	UInt32								numberSamples,
+											sample;
+	
+   SInt16								numberChannels;
+	
+	
+	clusterLinesPtr = (ISODATAClusterLinesPtr)taskInfoPtr;
+	numberChannels = clusterLinesPtr->numberChannels;
+	numberSamples = clusterLinesPtr->numberSamplesPtr[task];
+	currentPixel = 
+			(HCTypePtr)&clusterLinesPtr->blockBufferPtr[task*clusterLinesPtr->lineBytes];
+	closestClusterPtr = 
+				&clusterLinesPtr->closestClusterPtr[task*clusterLinesPtr->numberColumns];
+	
+	for (sample=0; sample<numberSamples; sample++)
+		{
+		closestCluster = clusterLinesPtr->clusterHead;
+		currentCluster = closestCluster->next;
+		Distance (closestCluster, currentPixel, closestDistance);
+		
+		while (currentCluster != NULL)
+			{
+			Distance (currentCluster, currentPixel, currentDistance);
+	
+			if (currentDistance < closestDistance)
+				{
+				closestCluster = currentCluster;
+				closestDistance = currentDistance;
+				
+				}	// end "if (currentDistance < closestDistance)" 
+	
+			currentCluster = currentCluster->next;
+			
+			}	// end " while (currentCluster != NULL)"
+		
+		closestClusterPtr[sample] = closestCluster;
+		currentPixel += numberChannels;
+		
+		}	// end "for (sample=0; sample<numberSamples; sample++)"
+	
+}	// end "ISODATAClusterLineTask"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -2933,7 +3036,10 @@ SInt16 ISODATAClusterPass (
    ClusterType 						*closestCluster,	// cluster closest to current 	
    																// pixel.
 											*clusterHead, 								
-  											*currentCluster;	// Cluster currently working on.
+  											*currentCluster,	// Cluster currently working on.
+  											**lineClosestClusterPtr;
+	
+	ISODATAClusterLines				clusterLines;
 	
 	LongRect								sourceRect;
   											
@@ -2944,6 +3050,9 @@ SInt16 ISODATAClusterPass (
 																	//	pixel.
    			  							outputBufferPtr;	// ptr to all pixels.
    			  					
+	HUCharPtr							blockBufferPtr,
+											dataBufferPtr;
+											
 	HUInt16Ptr							dataClassPtr,
 											savedDataClassPtr;
 											
@@ -2952,6 +3061,7 @@ SInt16 ISODATAClusterPass (
 	ImageOverlayInfoPtr				imageOverlayInfoPtr;
 	Ptr									stringPtr;
 	UInt16*								channelsPtr;
+	UInt32*								numberOutputSamplesPtr;
 	WindowInfoPtr 						imageWindowInfoPtr;
 	WindowPtr							windowPtr;
 	
@@ -2972,14 +3082,20 @@ SInt16 ISODATAClusterPass (
 											numberColumns,
 											startTick;
 	
-	UInt32								column,				// Counting variable for columns 
+	UInt32								blockLineCount,
+											blockLineIndex,
+											column,				// Counting variable for columns 
  											columnEnd,
  											columnInterval,
 							 				columnStart,
 							 				columnWidth,
 											firstColumn,
+											lineBytes,
+											numberBlockLines,
+											numberLines,
 											numberSamples,
 											sample,
+											singleLineNumberSamples,
 											skipCount;
 	
    SInt16								areaNumber,
@@ -3123,12 +3239,69 @@ SInt16 ISODATAClusterPass (
 														channelsPtr,
 														kDetermineSpecialBILFlag);	
 														
+				// Only read the columns within the mask or polygon for each line.
+				
+		SetUpAreaColumnRuns (fileIOInstructionsPtr, &gAreaDescription);
+														
 				// If lineEnd is 0, then this implies that there are no requested mask
 				// values in the area being used. Force looping through the lines to be
 				// skipped.
 				
 		if (lineEnd == 0)
 			lineStart = 1;
+			
+				// Get a buffer to read a block of lines into at one time. This can 
+				// only be done when the first column does not change from line to 
+				// line. Otherwise or if memory is not available for this, just read
+				// one line at a time into the output buffer.
+		
+		numberLines = 1;
+		if (lineEnd >= lineStart)
+			numberLines = (lineEnd - lineStart + lineInterval)/lineInterval;
+			
+		lineBytes = numberColumns * numberChannels * sizeof (CType);
+		
+		blockBufferPtr = NULL;
+		if (columnInterval == 1 || pointType == kMaskType)
+			blockBufferPtr = GetLinesOfDataBuffer (lineBytes,
+																numberLines,
+																&numberBlockLines,
+																&numberOutputSamplesPtr);
+			
+		dataBufferPtr = blockBufferPtr;
+		if (blockBufferPtr == NULL)
+			{
+			dataBufferPtr = (HUCharPtr)outputBufferPtr;
+			numberBlockLines = 1;
+			numberOutputSamplesPtr = &singleLineNumberSamples;
+			
+			}	// end "if (blockBufferPtr == NULL)"
+			
+				// If more than one thread can be used, the closest clusters for the 
+				// lines in each block are found on worker threads. This is not done 
+				// for polygon areas.
+				
+		clusterLines.closestClusterPtr = NULL;
+		if (blockBufferPtr != NULL && 
+					!polygonFieldFlag && 
+							GetNumberWorkerThreads (numberBlockLines) > 1)
+			{
+			clusterLines.closestClusterPtr = (ClusterType**)MNewPointer (
+							(SInt64)numberBlockLines * numberColumns * sizeof (ClusterType*));
+			
+			clusterLines.clusterHead = clusterHead;
+			clusterLines.blockBufferPtr = blockBufferPtr;
+			clusterLines.numberSamplesPtr = numberOutputSamplesPtr;
+			clusterLines.lineBytes = lineBytes;
+			clusterLines.numberColumns = numberColumns;
+			clusterLines.numberChannels = numberChannels;
+			
+			}	// end "if (blockBufferPtr != NULL && ..."
+		
+		lineClosestClusterPtr = NULL;
+			
+		blockLineCount = 0;
+		blockLineIndex = 0;
 		
 		nextStatusAtLeastLine = nextStatusAtLeastLineIncrement;
 		
@@ -3195,34 +3368,55 @@ SInt16 ISODATAClusterPass (
 	  			
 	  		point.v = (SInt16)line; 
 																					
-					// Get all requested channels for first line of image data.  	
+					// Get all requested channels for the next block of lines of image
+					// data if all lines in the current block have been used.  	
 					// Return if there is a file IO error.									
-					 
-			errCode = GetLineOfData (fileIOInstructionsPtr,
-												line, 
-												firstColumn,
-												columnEnd,
-												columnInterval,
-												gInputBufferPtr,
-												(HUCharPtr)outputBufferPtr);
-										
-			if (errCode < noErr)
-				{
-				returnCode = -1;
-				break;	
-																								
-				}	// end "if (errCode < noErr)"
 			
-			if (errCode != kSkipLine)
+			if (blockLineIndex >= blockLineCount)
 				{
-		     	currentPixel = outputBufferPtr;
-		     	
-				if (pointType == kMaskType)
-					numberSamples = fileIOInstructionsPtr->numberOutputBufferSamples;
+				blockLineCount = (lineEnd - line)/lineInterval + 1;
+				blockLineCount = MIN (blockLineCount, numberBlockLines);
+				
+				errCode = GetLinesOfData (fileIOInstructionsPtr,
+													line, 
+													blockLineCount,
+													lineInterval,
+													firstColumn,
+													columnEnd,
+													columnInterval,
+													gInputBufferPtr,
+													dataBufferPtr,
+													lineBytes,
+													numberOutputSamplesPtr);
+											
+				if (errCode < noErr)
+					{
+					returnCode = -1;
+					break;	
+																									
+					}	// end "if (errCode < noErr)"
 					
-				else	// pointType != kMaskType
-					numberSamples =
-								(columnEnd - firstColumn + columnInterval)/columnInterval;
+				blockLineIndex = 0;
+				
+				if (clusterLines.closestClusterPtr != NULL)
+					RunTasksInParallel (blockLineCount, 
+												ISODATAClusterLineTask, 
+												&clusterLines);
+				
+				}	// end "if (blockLineIndex >= blockLineCount)"
+				
+					// A line with 0 samples was skipped because there are no 
+					// requested mask values in it.
+			
+			numberSamples = numberOutputSamplesPtr[blockLineIndex];
+			currentPixel = (HCTypePtr)&dataBufferPtr[blockLineIndex*lineBytes];
+			if (clusterLines.closestClusterPtr != NULL)
+				lineClosestClusterPtr = 
+								&clusterLines.closestClusterPtr[blockLineIndex*numberColumns];
+			blockLineIndex++;
+			
+			if (numberSamples > 0)
+				{
 		   		
 		   	for (sample=1; sample<=numberSamples; sample++)
 					{									
@@ -3233,27 +3427,37 @@ SInt16 ISODATAClusterPass (
 				   
 					if (!polygonFieldFlag || PtInRgn (point, rgnHandle))
 		   			{
-		      		closestCluster = clusterHead;
-		      		currentCluster = clusterHead->next;
-		      		Distance (closestCluster, currentPixel, closestDistance);
-		
-		      				// Find closest cluster in absolute sense (Euclidean 		
-		      				// distance). 															
-		      		
-				      while (currentCluster != NULL)
-				      	{
-				         Distance (currentCluster, currentPixel, currentDistance);
-				
-				         if (currentDistance < closestDistance)
-				         	{
-				            closestCluster = currentCluster;
-				            closestDistance = currentDistance;
-				            
-				         	}	// end "if (currentDistance < closestDistance)" 
-				
-				         currentCluster = currentCluster->next;
-				         
-				     		}	// end " while (currentCluster != NULL)" 
+		   					// Use the closest cluster found by the worker threads if
+		   					// available.
+		   					
+		   			if (lineClosestClusterPtr != NULL)
+		   				closestCluster = lineClosestClusterPtr[sample-1];
+		   				
+		   			else	// lineClosestClusterPtr == NULL
+		   				{
+			      		closestCluster = clusterHead;
+			      		currentCluster = clusterHead->next;
+			      		Distance (closestCluster, currentPixel, closestDistance);
+			
+			      				// Find closest cluster in absolute sense (Euclidean 		
+			      				// distance). 															
+			      		
+					      while (currentCluster != NULL)
+					      	{
+					         Distance (currentCluster, currentPixel, currentDistance);
+					
+					         if (currentDistance < closestDistance)
+					         	{
+					            closestCluster = currentCluster;
+					            closestDistance = currentDistance;
+					            
+					         	}	// end "if (currentDistance < closestDistance)" 
+					
+					         currentCluster = currentCluster->next;
+					         
+					     		}	// end " while (currentCluster != NULL)" 
+					     		
+					     	}	// end "else lineClosestClusterPtr == NULL"
 				     		
 				     			// Update the cluster class statistics if needed.			
 				     		
@@ -3325,7 +3529,7 @@ SInt16 ISODATAClusterPass (
 						
 					}	// end "if (pointType != kMaskType)"
 		  			
-		  		}	// end "if (errCode != kSkipLine)"
+		  		}	// end "if (numberSamples > 0)"
 			
 			linesLeft--;
 			if (TickCount () >= gNextMinutesLeftTime)
@@ -3346,6 +3550,9 @@ SInt16 ISODATAClusterPass (
 												fileIOInstructionsPtr->numberMaskColumnsPerLine;
 	  			
 	  		}	// end "for (line=lineStart; line<=lineEnd; line+=lineInterval)"
+	  		
+		CheckAndDisposePtr ((Ptr)clusterLines.closestClusterPtr);
+		CheckAndDisposePtr ((Ptr)blockBufferPtr);
 	  	
 	  			// Force overlay to be drawn if it has not been already.
 	  				
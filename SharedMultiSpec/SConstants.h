@@ -1389,6 +1389,10 @@
 #define	kGetDeterminantOnly	 		0
 #define	kReturnMatrixInverse 		1 
 
+		// Matrix inverse event check constants.
+#define	kDoNotCheckEvents	 			0
+#define	kCheckEvents			 		1
+
 		// Statistics window control codes.													
 #define  kAddToListControl				13
 #define	kEditNameControl				22
@@ -1708,6 +1712,115 @@
 		// Threaded IO constants
 #define	kDoNotAllowForThreadedIO			0
 #define	kAllowForThreadedIO					1
+#define	kDefaultPrefetchDepth				4
+#define	kMaxPrefetchDepth						32
+
+		// Maximum number of threads to be used to carry out independent tasks
+		// such as decompressing the blocks in a block row of a TIFF file.
+#define	kMaxNumberThreads						64
+
+		// Tile cache constants for blocked image files
+#define	kDefaultTileCacheBytes				67108864
+#define	kMaxTileCacheEntries					4096
+#define	kTileCacheHashSize					8192		// must be a power of 2
+
+		// Maximum number of bytes to be read at one time for a block of lines
+		// by GetLinesOfData and to be used for the output buffer for the block.
+#define	kMaxLinesOfDataBytes					8388608
+
+		// Minimum average number of samples in the runs of columns that are read
+		// separately for each line of a mask or polygonal area.
+#define	kMinimumAreaRunSamples				32
+
+		// Number of lines in a block of lines that are classified by each worker
+		// thread before the results are written and user events are checked.
+#define	kClassifyLinesPerThread				4
+
+		// Number of channel combinations in a block of channel combinations that
+		// are done by each worker thread when computing the separability.
+#define	kSeparabilityCombinationsPerThread	8
+
+		// Number of bytes in each of the two buffers used by the output writer
+		// to write lines of results to a file in large blocks.
+#define	kOutputWriterBufferBytes			4194304
+
+		// Maximum number of bytes in one uncompressed strip and for the strips of
+		// all channels being loaded at one time when compressed TIFF files are
+		// written.
+#define	kTIFFCompressedStripBytes			262144
+#define	kTIFFStripBufferBytes				16777216
+
+		// Maximum number of reduced resolution images (overviews) in a TIFF file
+		// and the number of columns or lines below which no further overview is
+		// created when compressed TIFF files are written.
+#define	kMaxNumberTIFFOverviews				16
+#define	kTIFFOverviewMinimumSize			256
+
+		// Identifier, version and sizes of the file header and of the header for
+		// each channel in MultiSpec binary image statistics (.sta) files.
+#define	kBinarySTAIdentifier					"MSPECSTA"
+#define	kBinarySTAVersion						1
+#define	kBinarySTAHeaderBytes				64
+#define	kBinarySTAChannelHeaderBytes		96
+
+		// Identifier, version and sizes of the header and of the trailer for the
+		// binary block of field statistics at the end of project files.
+#define	kBinaryProjectStatsIdentifier		"MSPECPST"
+#define	kBinaryProjectStatsVersion			1
+#define	kBinaryProjectStatsHeaderBytes	32
+#define	kBinaryProjectStatsTrailerBytes	16
+
+		// Identifier, version and sizes of the header and of each data set entry
+		// in the data set index (.hdx) files that are written beside hdf and
+		// netCDF files with many subdata sets. Also the minimum number of
+		// subdata sets for which an index file is used.
+#define	kHdfDataSetIndexIdentifier			"MSPECHDX"
+#define	kHdfDataSetIndexVersion				1
+#define	kHdfDataSetIndexHeaderBytes		40
+#define	kHdfDataSetIndexEntryBytes			96
+#define	kHdfDataSetIndexMinimumDataSets	8
+
+		// Identifier, version and header size of the training pixel store (.knn)
+		// files written beside project files for the nearest neighbor and svm
+		// classifiers. Also the minimum number of bytes of training pixel values
+		// for which a store file is used, the number of samples in the buffer
+		// used to write the values to the file and the number of bytes at the
+		// start and end of each image file included in the store check sums.
+#define	kTrainingStoreIdentifier			"MSPECKNN"
+#define	kTrainingStoreVersion				3
+#define	kTrainingStoreHeaderBytes			64
+#define	kTrainingStoreFieldEntryBytes		24
+#define	kTrainingStoreMinimumBytes			67108864
+#define	kTrainingStoreBufferSamples		8192
+#define	kTrainingStoreImageCheckBytes		4096
+
+		// Maximum number of bytes for the chunk row buffer used to read compressed
+		// hdf5 data sets, for the hdf5 chunk cache for a data set and the
+		// maximum number of data sets that can be open for chunk row reads.
+#define	kMaxHDF5ChunkRowBytes				67108864
+#define	kMaxHDF5ChunkCacheBytes				67108864
+#define	kMaxHDF5ChunkedDataSets				16
+
+		// Levels of SIMD instructions used to pack and convert lines of data and
+		// the number of samples handled in one pass of the SIMD loops.
+#define	kSIMDNone								0
+#define	kSIMDSSE41								1
+#define	kSIMDAVX2								2
+#define	kSIMDPackSamples						8
+
+		// Number of samples in one tile when a line of data is transposed to
+		// BIS format. The output for a tile is kept in the cache while each
+		// channel is added to it.
+#define	kPackTileSamples						64
+
+		// Operations done on each line of data after it is read.
+#define	kPostReadSwap2Bytes					0x0002
+#define	kPostReadSwap4Bytes					0x0004
+#define	kPostReadSwap8Bytes					0x0008
+#define	kPostReadAdjustSigned1Byte			0x0010
+#define	kPostReadAdjustSigned2Bytes			0x0020
+#define	kPostReadUnpack4Bits					0x0040
+#define	kPostReadSwapOrAdjust					0x003E
 
 		// Class Info Structure constants
 #define	kAssignMemory					1
@@ -1739,6 +1852,7 @@
 		// Option codes for GetClassDataValues & GetFieldDataValues
 #define	kNoTrainingSamples					1
 #define	kComputeColumnInterval				2
+#define	kUseTrainingStore						4
 
 		// List Statistics option constants
 #define	kListCorrelation						1
@@ -379,6 +379,33 @@ Boolean							gUseGWorldFlag = FALSE;
 		// Flag indicating whether the thread manager is present.
 Boolean							gUseThreadedIOFlag = FALSE;
 
+		// Flag indicating whether image files that are read directly are to be
+		// memory mapped. Only used in the wx versions.
+Boolean							gUseMemoryMappedIOFlag = TRUE;
+
+		// Flag indicating whether image statistics (.sta) files are to be written
+		// in the MultiSpec binary format with the full histograms instead of the
+		// ERDAS 74 format. The binary files are always read when found, but they
+		// are not written by default since other software expects the .sta file
+		// to be in the ERDAS 74 format.
+Boolean							gWriteBinarySTAFileFlag = FALSE;
+
+		// Flag indicating whether the training field statistics are to be written
+		// to a binary block at the end of project files instead of as text records.
+Boolean							gWriteBinaryProjectStatsFlag = TRUE;
+
+		// Flag indicating whether the subdata set descriptions for hdf and netCDF
+		// files are to be read from and saved to a data set index (.hdx) file so
+		// that each subdata set does not need to be opened when the file is opened.
+Boolean							gUseHdfDataSetIndexFileFlag = TRUE;
+
+		// Flag indicating whether large sets of training pixel values for the
+		// nearest neighbor and svm classifiers are to be kept in a training pixel
+		// store (.knn) file beside the project file instead of in memory and
+		// whether the values in the file are to be stored as 4-byte floats.
+Boolean							gUseTrainingStoreFlag = TRUE;
+Boolean							gTrainingStoreFloatFlag = FALSE;
+
 		// Pointer to temporary buffer to be used for computation of a 			
 		// class channel statistics vector.													
 HChannelStatisticsPtr		gTempChannelStatsPtr = NULL;
@@ -1097,6 +1124,14 @@ double							gDoubleCoordinateColumnValue = 0.0;
 		// Last coordinate line value.														
 double							gDoubleCoordinateLineValue = 0.0;
 
+		// CPU seconds used to read the compressed chunks of hdf5 data sets, to
+		// decompress them and to do both in one hdf5 library read when the
+		// filters are not handled by MultiSpec. They are listed with the CPU
+		// time for the operation and then reset.
+double							gHDF5ChunkDecompressSeconds = 0.;
+double							gHDF5ChunkReadSeconds = 0.;
+double							gHDF5LibraryReadSeconds = 0.;
+
 		// Maximum natural log value for double values;
 double							gMaximumNaturalLogValue = 
 											floor(DBL_MAX_10_EXP * (double)log((double)10));
@@ -1292,6 +1327,15 @@ UInt32							gNextMinutesLeftTime = 0;
 	time_t							gNextTime = 333;
 #endif	// defined multispec_wx
 
+		// Maximum number of threads to be used to carry out independent tasks
+		// such as decompressing the blocks in a block row of a TIFF file. A value
+		// of 0 indicates that the number of processors is to be used.
+UInt32							gMaximumNumberThreads = 0;
+
+		// Number of hdf5 data set chunks read since the last listing of the
+		// hdf5 read times.
+UInt32							gNumberHDF5ChunksRead = 0;
+
 		// Count of the number of shape files that have been loaded in.
 UInt32							gNumberImageOverlayFiles = 0;
 
@@ -1316,6 +1360,19 @@ UInt32							gSpareWarnSize = 25000;
 		// is to be used for the title.														
 UInt32							gStatusIDNumber = 0;
 
+		// Number of image lines to be read ahead of the line being processed
+		// when threaded IO is used. A value of 0 turns off threaded IO.
+UInt32							gThreadedIOPrefetchDepth = kDefaultPrefetchDepth;
+
+		// Number of blocks found and not found in the tile cache when reading
+		// blocked image files.
+UInt32							gTileCacheHits = 0;
+UInt32							gTileCacheMisses = 0;
+
+		// Maximum number of bytes to be used for the tile cache for blocked
+		// image files. A value of 0 turns off the tile cache.
+UInt32							gTileCacheMaximumBytes = kDefaultTileCacheBytes;
+
 		// Flag indicating the last memory condition for DataPak's word			
 		// solution engine.																		
 UInt32							gTextMemoryMinimum= 12000;
@@ -1687,6 +1744,11 @@ SInt16							gSelectImageOverlaySelection = 0;
 		// function bhattacharyya.																
 SInt16							gSeparabilityDistance = 0;
 
+		// Level of SIMD instructions to be used to pack and convert lines of
+		// data. =-1 not determined yet, =0 (kSIMDNone) use scalar code only,
+		// =1 (kSIMDSSE41) SSE4.1, =2 (kSIMDAVX2) AVX2.
+SInt16							gSIMDLevel = -1;
+
 		// Index used with spinning cursor
 SInt16							gSpinCursorIndex = kSpin;
 
@@ -1718,6 +1780,18 @@ SInt16							gTextMemoryShortCode = 0;
 		// it a rectangle selection.															
 SInt16							gThresholdSize = 2;
 
+		// Compression to be used for new TIFF and GeoTIFF files created by 
+		// ChangeImageFileFormat. kNoCompression, kLZWCompression and 
+		// kDeflateCompression are allowed. It is set in the change image file
+		// format dialog box.
+UInt16							gTIFFOutputCompressionCode = kNoCompression;
+
+		// Flag indicating whether reduced resolution images (overviews) are to be
+		// stored in compressed TIFF and GeoTIFF files created by
+		// ChangeImageFileFormat. It is set in the change image file format
+		// dialog box.
+Boolean							gTIFFOutputOverviewsFlag = TRUE;
+
 			// Used in 'DragScrollList' routine for scrolling lists.
 SInt16							gVerticalCellOffset = 0;
 SInt16							gSelectedCell = 0;
@@ -138,6 +138,7 @@ typedef struct DoubleRect DoubleRect, *DoubleRectPtr;
 typedef struct FeatureExtractionSpecs FeatureExtractionSpecs, *FeatureExtractionSpecsPtr;
 typedef struct MFileInfo MFileInfo, *FileInfoPtr, **FileInfoHandle;
 typedef struct FileIOBuffer FileIOBuffer;
+typedef struct FileIOPrefetch FileIOPrefetch, *FileIOPrefetchPtr;
 typedef struct GeodeticModelInfo GeodeticModelInfo, *GeodeticModelInfoPtr; 
 typedef struct GridCoordinateSystemInfo GridCoordinateSystemInfo, *GridCoordinateSystemInfoPtr;
 typedef struct HierarchalFileFormat HierarchalFileFormat, *HierarchalFileFormatPtr;
@@ -145,6 +146,8 @@ typedef struct HistogramSpecs HistogramSpecs, *HistogramSpecsPtr;
 typedef struct HistogramSummary HistogramSummary, *HistogramSummaryPtr;
 typedef struct LayerInfo LayerInfo, *LayerInfoPtr; 
 typedef struct MaskInfo MaskInfo, *MaskInfoPtr; 
+typedef struct MaskRun MaskRun, *MaskRunPtr;
+typedef struct OutputWriter OutputWriter, *OutputWriterPtr;
 typedef struct	PlanarCoordinateSystemInfo	PlanarCoordinateSystemInfo, *PlanarCoordinateSystemInfoPtr;  
 typedef struct ProjectClassNames ProjectClassNames, *PClassNamesPtr;
 typedef struct ProjectFieldIdentifiers ProjectFieldIdentifiers, *PFieldIdentifiersPtr;
@@ -152,6 +155,8 @@ typedef struct ProjectFieldPoints ProjectFieldPoints, *PFieldPointsPtr;
 typedef struct ProjectInfo ProjectInfo, *ProjectInfoPtr; 
 typedef struct ProjectionPursuitSpecs ProjectionPursuitSpecs, *ProjectionPursuitSpecsPtr;
 typedef struct RecodeThematicImage RecodeThematicImage, *RecodeThematicImagePtr;
+typedef struct TIFFOverview TIFFOverview, *TIFFOverviewPtr;
+typedef struct TIFFStripWriter TIFFStripWriter, *TIFFStripWriterPtr;
 typedef struct TransformationSpecs TransformationSpecs, *TransformationSpecsPtr;
 typedef struct TransMapMatrix TransMapMatrix, *TransMapMatrixPtr;
 typedef struct TypicalitySummary TypicalitySummary, *TypicalitySummaryPtr;
@@ -1069,6 +1074,8 @@ typedef double				CMeanType2;
 	
 	typedef __int64	 		SInt64;  
 	
+	typedef unsigned __int64 UInt64;
+	
 	typedef char*				Ptr; 
 	
 	typedef double				SDouble; 
@@ -1425,6 +1432,11 @@ typedef struct AreaDescription
 			
 			// Storage for a rgnHandle which is used for polygonal type areas.								
 	RgnHandle				rgnHandle;
+	
+			// Pointer to the points for a polygonal project field. They are used
+			// to get the columns within the polygon for each line. NULL if the
+			// points are not available.
+	HPFieldPointsPtr		polygonPointsPtr;
 	 
 	SInt32					line;  
 	 
@@ -1468,6 +1480,9 @@ typedef struct AreaDescription
 	SInt16					classNumber;
 	SInt16					fieldNumber;
 	
+			// Number of points in the polygon point list.
+	SInt16					numberPolygonPoints;
+	
 			// "Temporary" storage for the type of disk file format.
 	SInt16					diskFileFormat;
 	
@@ -1734,6 +1749,7 @@ typedef struct ClassifierVar
 	double				variable2;
 	double				variable3;
 	HDoublePtr			chanMeanPtr;
+	double*				discriminantSumPtr;
 	double*				classConstantPtr;
 	double*				classConstant2Ptr;
 	double*				classConstantLOO1Ptr;
@@ -1748,6 +1764,8 @@ typedef struct ClassifierVar
 	HSInt64Ptr			countVectorPtr;
 	HSInt32Ptr			countClassIndexPtr;
 	HUInt32Ptr 			columnWidthVectorPtr;
+	struct knnPoint*	knnDistancesPtr;
+	struct svm_node*	svm_x;
 	SInt64				totalCorrectSamples;
 	SInt64				totalNumberSamples;
 	SInt64				totalSameDistanceSamples;
@@ -1767,6 +1785,7 @@ typedef struct ClassifierVar
 	SInt16				summaryUnitsCode;
 	Boolean				thresholdFlag;
 	Boolean				useLeaveOneOutMethodFlag;
+	Boolean				workerTaskFlag;
 	
 	} ClassifierVar, *ClassifierVarPtr;
 	
@@ -2762,6 +2781,10 @@ typedef struct MFileInfo
 	
 			// Handle to map projection information.
 	Handle							mapProjectionHandle;
+	
+			// Handle to the vector of TIFFOverview structures for the reduced
+			// resolution images stored in compressed TIFF files.
+	Handle							tiffOverviewHandle;
 		
 			// Used to store the hdf file_id when using the hdf routines to read
 			// lines of the image file.
@@ -2789,6 +2812,7 @@ typedef struct MFileInfo
 	UInt32							numberPostChannelBytes;
 	UInt32							numberPostLineBytes;
 	UInt32							numberTrailerBytes;
+	
 	UInt32							startColumn;
 	UInt32							startLine;
 	
@@ -2846,6 +2870,9 @@ typedef struct MFileInfo
 			//		= 3, Skipping Huffman compression
 			//		= 4, GZIP compression
 			//		= 5, Szip compression
+			//		= 9, LZW compression
+			//		= 10, PackBits compression
+			//		= 17, Deflate compression
 	UInt16							dataCompressionCode;
 	
 			// Code indicating whether the data values are integer or float
@@ -2884,6 +2911,17 @@ typedef struct MFileInfo
 			// Number of groups in thematic type images.
 	UInt16							numberGroups;
 	
+			// Predictor used with LZW and Deflate compressed TIFF files.
+			//		= 1, no predictor
+			//		= 2, horizontal differencing
+			//		= 3, floating point horizontal differencing
+	UInt16							predictorCode;
+	
+			// Number of reduced resolution images in the TIFF file and the one
+			// that this structure represents; 0 is for the full resolution image.
+	UInt16							numberTIFFOverviews;
+	UInt16							tiffOverviewIndex;
+	
 	Boolean							asciiSymbols;
 	Boolean							blockedFlag;
 	Boolean							callGetHDFLineFlag;
@@ -2919,6 +2957,22 @@ typedef struct FileIOBuffer
 	} FileIOBuffer, *FileIOBufferPtr;
 	
 
+		// Range of bytes in an image file that has been read into the lines
+		// buffer by GetLinesOfData.
+
+typedef struct LinesBufferRange
+	{
+	CMFileStream*						fileStreamPtr;
+	SInt64								filePosition;
+	UInt32								bufferOffset;
+	UInt32								numberBytes;
+	
+			// Error code for the range when the ranges are read concurrently.
+	SInt16								errCode;
+	
+	} LinesBufferRange, *LinesBufferRangePtr;
+	
+
 typedef struct FileIOInstructions
 	{
 	ThreadID								asyncIOThread;
@@ -2944,6 +2998,45 @@ typedef struct FileIOInstructions
 	SInt32								numberColumns;
 	SInt32								numberLinesAtOnce;
 	
+			// Read-ahead pipeline used for threaded IO in the wx versions. It is
+			// created in SetupFileIOThread and released in EndFileIOThread.
+	FileIOPrefetchPtr					prefetchPtr;
+	
+			// Buffer and list of file byte ranges for a block of lines read with
+			// one read per contiguous range by GetLinesOfData. GetLine copies the
+			// data for a line from this buffer when it is available. These are
+			// released in CloseUpFileIOInstructions.
+	HUCharPtr							linesBufferPtr;
+	LinesBufferRangePtr				linesBufferRangePtr;
+	UInt32								linesBufferBytes;
+	UInt32								linesBufferMaxRanges;
+	UInt32								linesBufferNumberRanges;
+	UInt32								linesBufferRangeIndex;
+	
+			// Buffer for the block row of lines read with one GDALDatasetRasterIO
+			// call for all requested channels by GetGDALLineOfData. The lines are
+			// stored band interleaved by line. The data set, channel and column
+			// range identify what is in the buffer. It is released in
+			// CloseUpFileIOInstructions.
+	HUCharPtr							gdalBlockBufferPtr;
+	void*									gdalBlockDataSetH;
+	UInt32								gdalBlockBufferBytes;
+	UInt32								gdalBlockColumnEnd;
+	UInt32								gdalBlockColumnStart;
+	UInt32								gdalBlockFirstChannel;
+	UInt32								gdalBlockFirstLine;
+	UInt32								gdalBlockLastLine;
+	UInt32								gdalBlockNumberChannels;
+	
+			// Copy of the file information for the reduced resolution TIFF image
+			// being read in place of the full resolution image and its reduction
+			// factor. The full resolution file information is saved so that it
+			// can be restored in CloseUpFileIOInstructions. The overview is only
+			// used if the caller sets the allowed flag.
+	FileInfoPtr							tiffOverviewFileInfoPtr;
+	FileInfoPtr							tiffOverviewSavedFileInfoPtr;
+	UInt32								tiffOverviewFactor;
+	
 	UInt32								bilSpecialNumberChannels;
 	UInt32								bufferOffset;
 	UInt32								channelEnd;
@@ -2978,13 +3071,41 @@ typedef struct FileIOInstructions
 	Boolean								callPackLineOfDataFlag;
 	Boolean								differentBuffersFlag;
 	
+			// Flag indicating that lines can be packed directly from the memory
+			// mapping of the image file (wx versions only).
+	Boolean								mappedIOFlag;
+	
+			// Flag indicating that the bytes for a line from each of the files in
+			// a linked image are to be read concurrently into the lines buffer 
+			// (wx versions only).
+	Boolean								linkedFilesConcurrentIOFlag;
+	
+			// Flag indicating that a reduced resolution TIFF image may be read
+			// when the line and column intervals allow it.
+	Boolean								tiffOverviewAllowedFlag;
+	
 			// Mask Information.
 			
+	MaskInfoPtr							maskInfoPtr;
 	HUInt16Ptr							maskBufferPtr;
 	UInt32								maskColumnStart;
 	UInt32								maskValueRequest;
 	UInt32								numberMaskColumnsPerLine;
 	
+			// Runs of columns to be read for each line of the area. If the flag
+			// is set, GetLineOfData only reads and converts the columns in the 
+			// runs for the line. The runs come from the run index for the mask
+			// or, for a polygonal area, from the handles below which have 
+			// numberLines+1 index entries the same as the mask run index. They 
+			// are set up by SetUpAreaColumnRuns and released in 
+			// CloseUpFileIOInstructions.
+	Handle								areaLineRunIndexHandle;
+	Handle								areaRunsHandle;
+	UInt32								areaRunsLineInterval;
+	UInt32								areaRunsLineStart;
+	UInt32								areaRunsNumberLines;
+	Boolean								areaRunsFlag;
+	
 	} FileIOInstructions, *FileIOInstructionsPtr;
 	
 	
@@ -3510,6 +3631,10 @@ typedef struct InverseMatrixMemory
 	SInt16					*indexRowPtr;
 	SInt16					*ipvotPtr;
 	
+			// Flag indicating that the memory is used on a worker thread. User
+			// events are not checked during matrix inversions using this memory.
+	Boolean					workerThreadFlag;
+	
 	} InverseMatrixMemory, *InverseMatrixMemoryPtr;
 	
 		
@@ -3789,6 +3914,20 @@ typedef struct MapToWindowUnitsVariables
 	} MapToWindowUnitsVariables, *MapToWindowUnitsVariablesPtr;
 	
 	
+		// Run of columns in one line of a mask with the same non-zero mask value.
+		// The columns are relative to the mask buffer; the first column is 1.
+		// The structure is also used for the column runs of a polygonal area; 
+		// the columns are then image columns and the mask value is 1.
+		
+typedef struct MaskRun
+	{
+	UInt32							columnStart;
+	UInt32							columnEnd;
+	UInt32							maskValue;
+	
+	} MaskRun, *MaskRunPtr;
+	
+	
 typedef struct MaskInfo
 	{
 	CMFileStream*					fileStreamPtr;
@@ -3799,11 +3938,19 @@ typedef struct MaskInfo
 	Handle							maskHandle;
 	Handle							maskValueToFieldHandle;
 	
+			// Run length encoded version of the mask. The line run index has
+			// numberLines+1 entries; the runs for mask line 'n' (1-based) are
+			// entries lineRunIndex[n-1] to lineRunIndex[n]-1 in the mask runs
+			// vector. The handles are NULL if the run index is not available.
+	Handle							maskLineRunIndexHandle;
+	Handle							maskRunsHandle;
+	
 	UInt32							fileLayer;
 	UInt32							maxMaskValue;
 	UInt32							numberColumns;
 	UInt32							numberLines;
 	UInt32							numberLayers;
+	UInt32							numberMaskRuns;
 	UInt32							startColumn;
 	UInt32							startLine;
 	
@@ -3995,6 +4142,15 @@ typedef struct knnPoint
 	} knnType;
 
 
+typedef struct TrainingStoreField
+	{
+	SInt64				firstSample;
+	SInt64				numberSamples;
+	UInt32				key;
+	
+	} TrainingStoreField, *TrainingStoreFieldPtr;
+
+
 //#if PRAGMA_ALIGN_SUPPORTED
 #if defined PRAGMA_STRUCT_ALIGN
 	#pragma options align=mac68k
@@ -4026,6 +4182,42 @@ typedef struct ProjectInfo
 	double*							knnDataValuesPtr;
 	int 								knnCounter;
 
+				// Training pixel store (.knn) file beside the project file. It is
+				// used instead of knnDataValuesPtr for the training pixel values
+				// when they are too large to keep in memory. trainingStoreValuesPtr
+				// points to the values in the memory mapped file or in a copy read
+				// from the file if the file cannot be mapped. trainingStoreBufferPtr
+				// is the buffer for the values as the file is being written or the
+				// copy of the values. trainingStoreValueBytes is 4 (float) or
+				// 8 (double); 0 if the training pixel store is not being used.
+
+	CMFileStream*					trainingStoreFileStreamPtr;
+	HUCharPtr						trainingStoreBufferPtr;
+	HUCharPtr						trainingStoreValuesPtr;
+	UInt32							trainingStoreBufferSamples;
+	SInt16							trainingStoreErrCode;
+	SInt16							trainingStoreValueBytes;
+
+				// Index of the samples for each training field in the training pixel
+				// store being written; indexed by field storage number. The previous
+				// store items describe the store file which existed before the values
+				// were reloaded. The samples for fields which have not changed are
+				// copied from it instead of being read from the image file.
+
+	TrainingStoreFieldPtr		trainingStoreFieldsPtr;
+	TrainingStoreFieldPtr		previousStoreFieldsPtr;
+	CMFileStream*					previousStoreFileStreamPtr;
+	HUCharPtr						previousStoreBufferPtr;
+	HUCharPtr						previousStoreValuesPtr;
+	UInt32							numberPreviousStoreFields;
+
+				// File offsets of the field statistics in the binary block of the
+				// project file which have not been loaded yet; 0 if there is
+				// nothing to be loaded for the field statistics storage index.
+
+	SInt64*							fieldStatsBinaryOffsetsPtr;
+	SInt32							numberFieldStatsBinaryOffsets;
+
 	UInt8								imageFileName[256];
 	
 			// Parameters for train and/or test mask files.
@@ -4372,6 +4564,11 @@ typedef struct ReformatOptions
 	HUCharPtr						ioOutAdjustBufferPtr;
 	HUCharPtr						ioOutBufferPtr;
 	RectifyImageOptionsPtr		rectifyImageOptionsPtr;
+	
+			// Writer for the strips of a compressed TIFF output file. NULL if the
+			// output file is not compressed.
+	TIFFStripWriterPtr			tiffStripWriterPtr;
+	
 	double*	 						coefficientsPtr;
 	SInt32*							fileInfoListPtr;
 	SInt16*	 						channelPtr;
@@ -4910,6 +5107,23 @@ typedef struct TIFFImageFileDirectory
 	} TIFFImageFileDirectory, *TIFF_IFD_Ptr; 
 	
 	
+typedef struct TIFFOverview
+	{
+			// Handle to the hierarchal format structure for the compressed strips
+			// or tiles of the reduced resolution image.
+	Handle							hfaHandle;
+	
+	UInt32							blockFormatIndex;
+	
+			// Reduction factor relative to the full resolution image.
+	UInt32							factor;
+	
+	UInt32							numberColumns;
+	UInt32							numberLines;
+	
+	} TIFFOverview, *TIFFOverviewPtr;
+	
+	
 typedef struct TransformationSpecs
 	{
 	UInt8								imageFileName[256];
@@ -610,6 +610,11 @@ void DisplayImagesSideBySide (
 					// Set some of the File IO Instructions parameters.
 
 			fileIOInstructionsPtr->packDataFlag = packDataFlag;
+			
+					// Allow a reduced resolution TIFF image to be read when the
+					// display intervals are a multiple of its reduction factor.
+					
+			fileIOInstructionsPtr->tiffOverviewAllowedFlag = TRUE;
 
 			errCode = SetUpFileIOInstructions (
 						  fileIOInstructionsPtr,
@@ -1278,6 +1283,11 @@ void Display4_8ByteImagesSideBySide (
 					// Set some of the File IO Instructions parameters.
 
 			fileIOInstructionsPtr->packDataFlag = packDataFlag;
+			
+					// Allow a reduced resolution TIFF image to be read when the
+					// display intervals are a multiple of its reduction factor.
+					
+			fileIOInstructionsPtr->tiffOverviewAllowedFlag = TRUE;
 
 			errCode = SetUpFileIOInstructions (
 						  fileIOInstructionsPtr,
@@ -2182,6 +2192,11 @@ void DisplayCImage (
 		offScreenLinePtr = 
 						(HUCharPtr)(offScreenBufferPtr + (numberLines - 1) * pixRowBytes);
 	#endif	// defined multispec_win
+	
+			// Allow a reduced resolution TIFF image to be read when the display
+			// intervals are a multiple of its reduction factor.
+			
+	fileIOInstructionsPtr->tiffOverviewAllowedFlag = TRUE;
 
 	errCode = SetUpFileIOInstructions (fileIOInstructionsPtr,
 													NULL,
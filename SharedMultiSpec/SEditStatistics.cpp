@@ -650,6 +650,8 @@ void ClearPixelDataMemory (
 		gProjectInfoPtr->knnDataValuesPtr =
 										CheckAndDisposePtr (gProjectInfoPtr->knnDataValuesPtr);
 		
+		CloseTrainingStore (gProjectInfoPtr);
+		
 		}	// end "if (disposePointersFlag)"
 	
 	gProjectInfoPtr->knnCounter = 0;
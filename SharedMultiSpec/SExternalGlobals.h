@@ -300,6 +300,31 @@ extern Boolean							gUseGWorldFlag;
 		// Flag indicating whether the thread manager is present.
 extern Boolean							gUseThreadedIOFlag;
 
+		// Flag indicating whether image files that are read directly are to be
+		// memory mapped. Only used in the wx versions.
+extern Boolean							gUseMemoryMappedIOFlag;
+
+		// Flag indicating whether image statistics (.sta) files are to be written
+		// in the MultiSpec binary format with the full histograms instead of the
+		// ERDAS 74 format.
+extern Boolean							gWriteBinarySTAFileFlag;
+
+		// Flag indicating whether the training field statistics are to be written
+		// to a binary block at the end of project files instead of as text records.
+extern Boolean							gWriteBinaryProjectStatsFlag;
+
+		// Flag indicating whether the subdata set descriptions for hdf and netCDF
+		// files are to be read from and saved to a data set index (.hdx) file so
+		// that each subdata set does not need to be opened when the file is opened.
+extern Boolean							gUseHdfDataSetIndexFileFlag;
+
+		// Flag indicating whether large sets of training pixel values for the
+		// nearest neighbor and svm classifiers are to be kept in a training pixel
+		// store (.knn) file beside the project file instead of in memory and
+		// whether the values in the file are to be stored as 4-byte floats.
+extern Boolean							gUseTrainingStoreFlag;
+extern Boolean							gTrainingStoreFloatFlag;
+
 		// Pointer to temporary buffer to be used for computation of a 			
 		// class channel statistics vector.													
 extern HChannelStatisticsPtr		gTempChannelStatsPtr;
@@ -987,6 +1012,14 @@ extern double							gDoubleCoordinateColumnValue;
 		// Last coordinate line value.														
 extern double							gDoubleCoordinateLineValue;
 
+		// CPU seconds used to read the compressed chunks of hdf5 data sets, to
+		// decompress them and to do both in one hdf5 library read when the
+		// filters are not handled by MultiSpec. They are listed with the CPU
+		// time for the operation and then reset.
+extern double							gHDF5ChunkDecompressSeconds;
+extern double							gHDF5ChunkReadSeconds;
+extern double							gHDF5LibraryReadSeconds;
+
 		// Maximum natural log value for double values;
 extern double							gMaximumNaturalLogValue;
 
@@ -1141,6 +1174,15 @@ extern UInt32							gNextStatusTimeOffset;
 	extern time_t							gNextTime;
 #endif	// defined multispec_wx
 
+		// Maximum number of threads to be used to carry out independent tasks
+		// such as decompressing the blocks in a block row of a TIFF file. A value
+		// of 0 indicates that the number of processors is to be used.
+extern UInt32							gMaximumNumberThreads;
+
+		// Number of hdf5 data set chunks read since the last listing of the
+		// hdf5 read times.
+extern UInt32							gNumberHDF5ChunksRead;
+
 		// Count of the number of shape files that have been loaded in.
 extern UInt32							gNumberImageOverlayFiles;
 
@@ -1165,6 +1207,19 @@ extern UInt32							gSpareWarnSize;
 		// is to be used for the title.														
 extern UInt32							gStatusIDNumber;
 
+		// Number of image lines to be read ahead of the line being processed
+		// when threaded IO is used. A value of 0 turns off threaded IO.
+extern UInt32							gThreadedIOPrefetchDepth;
+
+		// Number of blocks found and not found in the tile cache when reading
+		// blocked image files.
+extern UInt32							gTileCacheHits;
+extern UInt32							gTileCacheMisses;
+
+		// Maximum number of bytes to be used for the tile cache for blocked
+		// image files. A value of 0 turns off the tile cache.
+extern UInt32							gTileCacheMaximumBytes;
+
 		// Flag indicating the last memory condition for DataPak's word			
 		// solution engine.																		
 extern UInt32							gTextMemoryMinimum;
@@ -1482,6 +1537,11 @@ extern SInt16							gSelectImageOverlaySelection;
 		// function bhattacharyya.																
 extern SInt16							gSeparabilityDistance;
 
+		// Level of SIMD instructions to be used to pack and convert lines of
+		// data. =-1 not determined yet, =0 (kSIMDNone) use scalar code only,
+		// =1 (kSIMDSSE41) SSE4.1, =2 (kSIMDAVX2) AVX2.
+extern SInt16							gSIMDLevel;
+
 			// Index used with spinning cursor
 extern SInt16							gSpinCursorIndex;
 
@@ -1513,6 +1573,16 @@ extern SInt16							gTextMemoryShortCode;
 		// it a rectangle selection.															
 extern SInt16							gThresholdSize;
 
+		// Compression to be used for new TIFF and GeoTIFF files created by 
+		// ChangeImageFileFormat. kNoCompression, kLZWCompression and 
+		// kDeflateCompression are allowed.
+extern UInt16							gTIFFOutputCompressionCode;
+
+		// Flag indicating whether reduced resolution images (overviews) are to be
+		// stored in compressed TIFF and GeoTIFF files created by
+		// ChangeImageFileFormat.
+extern Boolean							gTIFFOutputOverviewsFlag;
+
 			// Used in 'DragScrollList' routine for scrolling lists.
 extern SInt16							gVerticalCellOffset;
 extern SInt16							gSelectedCell;
@@ -577,6 +577,12 @@ Boolean FeatureExtraction (void)
 					// Load the class covariance matrix and mean vector.
 					
 			InitializeAreaDescription (&gAreaDescription);
+			
+					// The class data values can be taken from the training pixel store
+					// file beside the project file if it is current.
+			
+			if (doubleDataValueCode > 0 && !gProjectInfoPtr->pixelDataLoadedFlag)
+				OpenTrainingStore ();
 
 			ShowStatusDialogItemSet (kStatusClassA);
 			LoadDItemValue (gStatusDialogPtr, IDC_Status5, (SInt32)numberClasses);
@@ -644,7 +650,7 @@ Boolean FeatureExtraction (void)
 												preProcessTransformVectorPtr,
 												&preProcessTransformValuePtr[numberFEFeatures],
 												(UInt16)numberFEFeatures,
-												kComputeColumnInterval);
+												kComputeColumnInterval+kUseTrainingStore);
 							
 					continueFlag = (classInfoPtr[index].no_samples >= 0);
 							
@@ -618,7 +618,8 @@ void FS_decision_boundary (
 																		gInverseMatrixMemory.ipvotPtr, 
 																		&det,
 																		&(class_info+i)->log_det,
-																		kReturnMatrixInverse);
+																		kReturnMatrixInverse,
+																		kCheckEvents);
 			
 			if (gOperationCanceledFlag)
 				{
@@ -1729,7 +1730,8 @@ UInt32 FS_optimize_2_class (
 																	gInverseMatrixMemory.ipvotPtr,
 																	&det, 
 																	&logDet[i],
-																	kReturnMatrixInverse);
+																	kReturnMatrixInverse,
+																	kCheckEvents);
 					
 				if (gOperationCanceledFlag)
 					{
@@ -3646,7 +3648,8 @@ SInt32 NWFE (
 																		gInverseMatrixMemory.ipvotPtr, 
 																		&det,
 																		&log_det,
-																		kReturnMatrixInverse);
+																		kReturnMatrixInverse,
+																		kCheckEvents);
 				
 			if (gOperationCanceledFlag)
 				returnCode = 591;
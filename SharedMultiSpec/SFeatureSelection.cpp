@@ -114,6 +114,51 @@ typedef struct SepDistancesSummary
 	
 	} SepDistancesSummary, *SepDistancesSummaryPtr;
 
+		// Structure for the class statistics used to compute the separability 
+		// for all class combinations of a channel combination and the memory
+		// used for the matrix inversions.
+		
+typedef struct SepStatistics
+	{
+	HDoublePtr						covPtr;
+	HDoublePtr						invPtr;
+	HDoublePtr						logDetPtr;
+	HDoublePtr						meanPtr;
+	InverseMatrixMemoryPtr		inverseMatrixMemoryPtr;
+	
+	} SepStatistics, *SepStatisticsPtr;
+
+		// Structure for one channel combination in a block of channel 
+		// combinations for which the separability is computed on worker threads.
+		// The statistics are loaded by the calling thread. The results are moved
+		// to the separability lists by the calling thread in combination order.
+		
+typedef struct SepCombination
+	{
+	SepDistancesSummary			distancesSummary;
+	SepStatistics					sepStatistics;
+	HFloatPtr						distancesPtr;
+	SInt16*							channelSetPtr;
+	SInt16							loadReturnCode;
+	SInt16							returnCode;
+	
+	} SepCombination, *SepCombinationPtr;
+
+		// Structure for the block of channel combinations. There is one set of
+		// matrix inversion memory for each slot (worker thread).
+		
+typedef struct SepCombinations
+	{
+	SepCombinationPtr				combinationPtr;
+	InverseMatrixMemoryPtr		inverseMatrixMemoryPtr;
+	UInt32							maxNumberCombinations;
+	UInt32							numberClassCombinations;
+	UInt32							numberCombinations;
+	UInt32							numberSlots;
+	SInt16							numberSeparabilityChannels;
+	
+	} SepCombinations, *SepCombinationsPtr;
+
 
  
 		// Function prototypes for routines that are only called by other			
@@ -129,6 +174,10 @@ Boolean ChannelCombinationsDialog (
 				UInt32								contiguousChannelsPerGroup,
 				Boolean								featureTransformationFlag);
 
+void ComputeSeparabilityCombinationsTask (
+				void*									taskInfoPtr,
+				UInt32								task);
+
 SInt16 ComputeSeparabilityForAllChannelCombinations (
 				UInt32								numberChannelGroupCombinations,
 				UInt32								numberClassCombinations, 
@@ -138,7 +187,15 @@ SInt16 ComputeSeparabilityForAllClassCombinations (
 				SepDistancesSummaryPtr			distancesSummaryPtr,
 				UInt32								numberClassCombinations, 
 				UInt32								numberClasses, 
-				SInt16								numberSeparabilityChannels);
+				SInt16								numberSeparabilityChannels,
+				SepStatisticsPtr					sepStatisticsPtr,
+				HFloatPtr							distancesPtr);
+
+SInt16 ComputeSeparabilityForCombinationBlocks (
+				SepCombinationsPtr				sepCombinationsPtr,
+				SInt16*								currentChannelSetsPtr,
+				UInt32								numberChannelGroupCombinations,
+				SInt16*								quitCodePtr);
 
 SInt16 ComputeSeparabilityForStepChannelCombinations (
 				UInt32								numberChannelGroupCombinations,
@@ -150,6 +207,7 @@ double CovarianceBhattacharyya (
 				HDoublePtr							cov2Ptr,				
 				double								logDeterminant1,
 				double								logDeterminant2,
+				InverseMatrixMemoryPtr			inverseMatrixMemoryPtr,
 				SInt16								numberFeatures);
 
 double Divergence (
@@ -174,6 +232,7 @@ double EFBhattacharyya (
 				double								logDeterminant1,
 				double								logDeterminant2,
 				HDoublePtr							meanDifPtr,
+				InverseMatrixMemoryPtr			inverseMatrixMemoryPtr,
 				SInt16								numberFeatures);
 
 SInt32 GetCombinationLimit (
@@ -247,6 +306,7 @@ double MeanBhattacharyya (
 				HDoublePtr							cov1Ptr, 
 				HDoublePtr							cov2Ptr,
 				HDoublePtr							meanDifPtr,	
+				InverseMatrixMemoryPtr			inverseMatrixMemoryPtr,
 				SInt16								numberFeatures);
 
 double NonCovarianceBhattacharyya (
@@ -255,8 +315,12 @@ double NonCovarianceBhattacharyya (
 				HDoublePtr							cov1Ptr,
 				HDoublePtr							cov2Ptr,
 				HDoublePtr							meanDifPtr,
+				InverseMatrixMemoryPtr			inverseMatrixMemoryPtr,
 				UInt32								numberFeatures);
 
+void ReleaseSeparabilityCombinationsMemory (
+				SepCombinationsPtr				sepCombinationsPtr);
+
 Boolean SeparabilityDialog (
 				FileInfoPtr							fileInfoPtr);
 
@@ -273,6 +337,12 @@ Boolean SetupSeparabilityDistanceMemory (
 				UInt32								numberClassCombinations, 
 				UInt32								numberChannelGroupCombinations);
 
+Boolean SetupSeparabilityCombinationsMemory (
+				SepCombinationsPtr				sepCombinationsPtr,
+				UInt32								numberSlots,
+				UInt32								numberClassCombinations, 
+				SInt16								numberSeparabilityChannels);
+
 Boolean SetupSeparabilityStatMemory (
 				HDoublePtr* 						meanPtr,
 				HDoublePtr* 						covariancePtr, 
@@ -333,6 +403,8 @@ double EFBhattacharyya (
 																	//	class 2 covariance matrix	
 				HDoublePtr							meanDifPtr, 	// vector storage of class 1 and 	
 																// class 2 mean difference. 			
+				InverseMatrixMemoryPtr			inverseMatrixMemoryPtr, // work memory for
+																// the matrix inversion.
 				SInt16							numberFeatures)	// number of features (channels) 
 																// represented in the mean vector and 	
 																// covariance and inverse covariance 	
@@ -352,6 +424,7 @@ double EFBhattacharyya (
 									logDeterminant1,
 									logDeterminant2,
 									meanDifPtr,
+									inverseMatrixMemoryPtr,
 									numberFeatures);
 									
 			// This is the error function bhattacharyya.  							
@@ -1010,6 +1083,67 @@ Boolean ChannelCombinationsDialogLoadList (
 
 
                                                                                 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void ComputeSeparabilityCombinationsTask
+//
+//	Software purpose:	The purpose of this routine is to compute the separability
+//							for all class combinations for the channel combinations in
+//							the current block that belong to the input slot. It may run
+//							in a worker thread; only the results for those channel 
+//							combinations and the matrix inversion memory for the slot
+//							are changed.
+//
+//	Parameters in:		Pointer to the separability combinations structure.
+//							Slot index.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+// 
+// Called By:			RunTasksInParallel in SThreads.cpp
+
+void ComputeSeparabilityCombinationsTask (
+				void*									taskInfoPtr,
+				UInt32								task)
+
+{
+	SepCombinationPtr					combinationPtr;
+	SepCombinationsPtr				sepCombinationsPtr;
+	
+	UInt32								index;
+	
+	
+	sepCombinationsPtr = (SepCombinationsPtr)taskInfoPtr;
+	
+	for (index=task; 
+			index<sepCombinationsPtr->numberCombinations; 
+			index+=sepCombinationsPtr->numberSlots)
+		{
+		combinationPtr = &sepCombinationsPtr->combinationPtr[index];
+		
+		if (combinationPtr->returnCode > 0)
+			{
+			combinationPtr->sepStatistics.inverseMatrixMemoryPtr = 
+											&sepCombinationsPtr->inverseMatrixMemoryPtr[task];
+											
+			combinationPtr->returnCode = ComputeSeparabilityForAllClassCombinations (
+										&combinationPtr->distancesSummary,
+										sepCombinationsPtr->numberClassCombinations, 
+										gSeparabilitySpecsPtr->numberClasses,
+										sepCombinationsPtr->numberSeparabilityChannels,
+										&combinationPtr->sepStatistics,
+										combinationPtr->distancesPtr);
+			
+			}	// end "if (combinationPtr->returnCode > 0)"
+		
+		}	// end "for (index=task; index<..."
+	
+}	// end "ComputeSeparabilityCombinationsTask"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -1037,6 +1171,8 @@ SInt16 ComputeSeparabilityForAllChannelCombinations (
 				SInt16								numberSeparabilityChannels)
 
 {
+	SepCombinations					sepCombinations;
+	
 	SepDistancesSummaryPtr			distancesSummaryPtr;
 	
 	SInt16								*channelSetsPtr,
@@ -1048,7 +1184,8 @@ SInt16 ComputeSeparabilityForAllChannelCombinations (
 	UInt32								channelCombination,
 											channelSetsIndex,
 											combinationIndex,
-											combinationSlots;
+											combinationSlots,
+											numberSlots;
 										
 	Boolean								firstTimeFlag,
 											stopFlag;
@@ -1123,107 +1260,138 @@ SInt16 ComputeSeparabilityForAllChannelCombinations (
 	gNextStatusTime = TickCount ();
 	stopFlag = FALSE;
 	
-	for (channelCombination=0;
-			channelCombination<numberChannelGroupCombinations;
-			channelCombination++)
-		{																		
-				// Load the statistics for the given channel combination.			
+			// Compute the separability for blocks of channel combinations on 
+			// worker threads if more than one thread is available and memory is
+			// available for the statistics of each channel combination in a block.
+			
+	sepCombinations.combinationPtr = NULL;
+	numberSlots = GetNumberWorkerThreads (numberChannelGroupCombinations);
+	if (numberSlots > 1)
+		SetupSeparabilityCombinationsMemory (&sepCombinations,
+															numberSlots,
+															numberClassCombinations,
+															numberSeparabilityChannels);
+	
+	if (sepCombinations.combinationPtr != NULL)
+		{
+		returnCode = ComputeSeparabilityForCombinationBlocks (
+															&sepCombinations,
+															currentChannelSetsPtr,
+															numberChannelGroupCombinations,
+															&quitCode);
+															
+		ReleaseSeparabilityCombinationsMemory (&sepCombinations);
 		
-		if (TickCount () >= gNextStatusTime)
-			{
-			LoadDItemRealValue (gStatusDialogPtr, 
-										IDC_Status8, 
-										(double)channelCombination+1,
-										0);
+		}	// end "if (sepCombinations.combinationPtr != NULL)"
+		
+	else	// sepCombinations.combinationPtr == NULL
+		{
+		for (channelCombination=0;
+				channelCombination<numberChannelGroupCombinations;
+				channelCombination++)
+			{																		
+					// Load the statistics for the given channel combination.			
+		
+			if (TickCount () >= gNextStatusTime)
+				{
+				LoadDItemRealValue (gStatusDialogPtr, 
+											IDC_Status8, 
+											(double)channelCombination+1,
+											0);
 									
-			gNextStatusTime = TickCount () + gNextStatusTimeOffset;
+				gNextStatusTime = TickCount () + gNextStatusTimeOffset;
 			
-			}	// end "if (TickCount () >= gNextStatusTime)"
+				}	// end "if (TickCount () >= gNextStatusTime)"
 	
-				// Get the next free index in 'distancesSummaryPtr'.					
+					// Get the next free index in 'distancesSummaryPtr'.					
 		
-		if (channelCombination < combinationSlots)
-			combinationIndex = channelCombination;
+			if (channelCombination < combinationSlots)
+				combinationIndex = channelCombination;
 			
-		else	// channelCombination >= combinationSlots 
-			{
-			combinationIndex = freeIndex;
-			freeIndex = distancesSummaryPtr[combinationIndex].nextMean;
+			else	// channelCombination >= combinationSlots 
+				{
+				combinationIndex = freeIndex;
+				freeIndex = distancesSummaryPtr[combinationIndex].nextMean;
 			
-			}	// else channelCombination >= combinationSlots 
+				}	// else channelCombination >= combinationSlots 
 			
-				// Break out of loop if combinationIndex is out of range.			
+					// Break out of loop if combinationIndex is out of range.			
 				
-		if (combinationIndex >= combinationSlots)
-			break;
+			if (combinationIndex >= combinationSlots)
+				break;
 				
-				// Convert channel combination numbers to channel numbers			
-				// that point to the respective statistics for that channel.		
-				// This needs to be done in case the user is only using a 			
-				// subset of the channels that are available in the statistics.			
+					// Convert channel combination numbers to channel numbers			
+					// that point to the respective statistics for that channel.		
+					// This needs to be done in case the user is only using a 			
+					// subset of the channels that are available in the statistics.			
 		
-		channelSetsIndex = distancesSummaryPtr[combinationIndex].channelSetIndex;
-		channelSetsPtr = &gSeparabilitySpecsPtr->channelSetsPtr[channelSetsIndex];
+			channelSetsIndex = distancesSummaryPtr[combinationIndex].channelSetIndex;
+			channelSetsPtr = &gSeparabilitySpecsPtr->channelSetsPtr[channelSetsIndex];
 		
-		for (i=0; i<numberSeparabilityChannels; i++)
-			channelSetsPtr[i] = featurePtr[currentChannelSetsPtr[i]];
+			for (i=0; i<numberSeparabilityChannels; i++)
+				channelSetsPtr[i] = featurePtr[currentChannelSetsPtr[i]];
 								
-		returnCode = LoadSeparabilityStatistics (
-					channelSetsPtr, 
-					numberSeparabilityChannels);
+			returnCode = LoadSeparabilityStatistics (
+						channelSetsPtr, 
+						numberSeparabilityChannels);
 		
-				// Compute the separability measures.										
+					// Compute the separability measures.										
 		
-		if (returnCode > 0)
-			returnCode = ComputeSeparabilityForAllClassCombinations (
-						&distancesSummaryPtr[combinationIndex],
-						numberClassCombinations, 
-						gSeparabilitySpecsPtr->numberClasses,
-						numberSeparabilityChannels);
+			if (returnCode > 0)
+				returnCode = ComputeSeparabilityForAllClassCombinations (
+							&distancesSummaryPtr[combinationIndex],
+							numberClassCombinations, 
+							gSeparabilitySpecsPtr->numberClasses,
+							numberSeparabilityChannels,
+							NULL,
+							&gSeparabilitySpecsPtr->distancesPtr[
+								distancesSummaryPtr[combinationIndex].classPairDistancesIndex]);
 						
-		else	// returnCode < 0 
-			distancesSummaryPtr[combinationIndex].classPairDistancesIndex = -1;
+			else	// returnCode < 0 
+				distancesSummaryPtr[combinationIndex].classPairDistancesIndex = -1;
 				
-		if (returnCode > 0)
-			{
-					// Update the list pointers.												
+			if (returnCode > 0)
+				{
+						// Update the list pointers.												
 					
-			returnCode = UpdateSeparabilityLists (distancesSummaryPtr, 
-																	combinationIndex, 
-																	channelCombination,
-																	&freeIndex,
-																	firstTimeFlag);
+				returnCode = UpdateSeparabilityLists (distancesSummaryPtr, 
+																		combinationIndex, 
+																		channelCombination,
+																		&freeIndex,
+																		firstTimeFlag);
 							
-			firstTimeFlag = FALSE;
+				firstTimeFlag = FALSE;
 			
-			}	// end "if (returnCode > 0)" 
+				}	// end "if (returnCode > 0)" 
 		
-				// Exit loop if user has "command period" down or return code 		
-				// indicates that a problem exists.											
+					// Exit loop if user has "command period" down or return code 		
+					// indicates that a problem exists.											
 			
-		if (TickCount () >= gNextTime)
-			{
-			if (!CheckSomeEvents (osMask+keyDownMask+updateMask+mDownMask+mUpMask))
-				returnCode = -1;
+			if (TickCount () >= gNextTime)
+				{
+				if (!CheckSomeEvents (osMask+keyDownMask+updateMask+mDownMask+mUpMask))
+					returnCode = -1;
 					
-			}	// end "if (TickCount () >= nextTime)" 
+				}	// end "if (TickCount () >= nextTime)" 
 			
-		if (gAlertReturnCode == 1 || returnCode <= 0)
-			{
-			channelCombination = numberChannelGroupCombinations;
-			quitCode = -1;
+			if (gAlertReturnCode == 1 || returnCode <= 0)
+				{
+				channelCombination = numberChannelGroupCombinations;
+				quitCode = -1;
 			
-			}	// end "if (stopFlag || returnCode <= 0)" 
+				}	// end "if (stopFlag || returnCode <= 0)" 
 			
-				// Get the next channel combination.										
+					// Get the next channel combination.										
 				
-		if (!GetNextCombination (currentChannelSetsPtr, 
-									numberSeparabilityGroups, 
-									numberFeatures,
-									gSeparabilitySpecsPtr->numberContiguousPerGroup))
-			break;
+			if (!GetNextCombination (currentChannelSetsPtr, 
+										numberSeparabilityGroups, 
+										numberFeatures,
+										gSeparabilitySpecsPtr->numberContiguousPerGroup))
+				break;
 	
-		}	// end "for (channelCombination=0; ..." 
+			}	// end "for (channelCombination=0; ..." 
+			
+		}	// end "else sepCombinations.combinationPtr == NULL"
 		
 			// Finish updating the list pointers.											
 			
@@ -1454,7 +1622,10 @@ SInt16 ComputeSeparabilityForStepChannelCombinations (
 							&distancesSummaryPtr[combinationIndex],
 							numberClassCombinations, 
 							gSeparabilitySpecsPtr->numberClasses,
-							numberFeatures);
+							numberFeatures,
+							NULL,
+							&gSeparabilitySpecsPtr->distancesPtr[
+								distancesSummaryPtr[combinationIndex].classPairDistancesIndex]);
 							
 			else	// returnCode < 0 
 				distancesSummaryPtr[combinationIndex].classPairDistancesIndex = -1;
@@ -1603,7 +1774,9 @@ SInt16 ComputeSeparabilityForStepChannelCombinations (
 //
 //	Software purpose:	The purpose of this routine is to calculate
 //							the separability for all class combinations for
-//							the given channel set.
+//							the given channel set. The class statistics and matrix
+//							inversion memory in the global variables are used if
+//							sepStatisticsPtr is NULL.
 //
 //	Parameters in:		None
 //
@@ -1613,6 +1786,7 @@ SInt16 ComputeSeparabilityForStepChannelCombinations (
 // 
 // Called By:			ComputeSeparabilityForAllChannelCombinations in SFeatureSelection.cpp
 //							ComputeSeparabilityForStepChannelCombinations in SFEatSel.cpp
+//							ComputeSeparabilityCombinationsTask in SFeatureSelection.cpp
 //
 //	Coded By:			Larry L. Biehl			Date: 11/06/1989
 //	Revised By:			Larry L. Biehl			Date: 03/06/1998	
@@ -1621,15 +1795,22 @@ SInt16 ComputeSeparabilityForAllClassCombinations (
 				SepDistancesSummaryPtr			distancesSummaryPtr, 
 				UInt32								numberClassCombinations, 
 				UInt32								numberClasses, 
-				SInt16								numberSeparabilityChannels)
+				SInt16								numberSeparabilityChannels,
+				SepStatisticsPtr					sepStatisticsPtr,
+				HFloatPtr							distancesPtr)
 
 {
 	double								classPairMinimum,
 											classPairMean,
 											distance;
 											
-	HDoublePtr							meanDifPtr;
-	HFloatPtr							distancesPtr;
+	HDoublePtr							covPtr,
+											invPtr,
+											logDetPtr,
+											meanDifPtr,
+											meanPtr;
+	
+	InverseMatrixMemoryPtr			inverseMatrixMemoryPtr;
 	HSInt16Ptr							weightsPtr;
 	
 	UInt32								classSet,
@@ -1639,8 +1820,6 @@ SInt16 ComputeSeparabilityForAllClassCombinations (
 											mean2Index,
 											numberCovEntries;
 											
-	SInt32								classPairDistancesIndex;
-	
 	SInt16								classPtr[2],
 											previousClass1;
 	
@@ -1666,12 +1845,30 @@ SInt16 ComputeSeparabilityForAllClassCombinations (
 	classPairMinimum = DBL_MAX;
 	classPairMean = 0;
 	
-	classPairDistancesIndex = distancesSummaryPtr->classPairDistancesIndex;
-	distancesPtr = &gSeparabilitySpecsPtr->distancesPtr[classPairDistancesIndex];
 	weightsPtr = (SInt16*)GetHandlePointer (
 										gProjectInfoPtr->classPairWeightsHandle);
 	
-	meanDifPtr = gInverseMatrixMemory.pivotPtr;
+	if (sepStatisticsPtr != NULL)
+		{
+		covPtr = sepStatisticsPtr->covPtr;
+		invPtr = sepStatisticsPtr->invPtr;
+		logDetPtr = sepStatisticsPtr->logDetPtr;
+		meanPtr = sepStatisticsPtr->meanPtr;
+		inverseMatrixMemoryPtr = sepStatisticsPtr->inverseMatrixMemoryPtr;
+		
+		}	// end "if (sepStatisticsPtr != NULL)"
+		
+	else	// sepStatisticsPtr == NULL
+		{
+		covPtr = gSepCovPtr;
+		invPtr = gSepInvPtr;
+		logDetPtr = gSepLogDetPtr;
+		meanPtr = gSepMeanPtr;
+		inverseMatrixMemoryPtr = &gInverseMatrixMemory;
+		
+		}	// end "else sepStatisticsPtr == NULL"
+	
+	meanDifPtr = inverseMatrixMemoryPtr->pivotPtr;
 
 	classPtr[0] = 0;
 	classPtr[1] = 1;
@@ -1689,77 +1886,82 @@ SInt16 ComputeSeparabilityForAllClassCombinations (
 				{
 				case kBhattacharyya:
 					distance = Bhattacharyya (
-										&gSepMeanPtr[mean1Index], 
-										&gSepMeanPtr[mean2Index], 
-										&gSepCovPtr[cov1Index], 
-										&gSepCovPtr[cov2Index],
-										gSepLogDetPtr[*classPtr], 
-										gSepLogDetPtr[classPtr[1]],
+										&meanPtr[mean1Index], 
+										&meanPtr[mean2Index], 
+										&covPtr[cov1Index], 
+										&covPtr[cov2Index],
+										logDetPtr[*classPtr], 
+										logDetPtr[classPtr[1]],
 										meanDifPtr, 
+										inverseMatrixMemoryPtr,
 										numberSeparabilityChannels);
 					break;
 					
 				case kEFBhattacharyya:
 					distance = EFBhattacharyya (
-										&gSepMeanPtr[mean1Index], 
-										&gSepMeanPtr[mean2Index], 
-										&gSepCovPtr[cov1Index], 
-										&gSepCovPtr[cov2Index],
-										gSepLogDetPtr[*classPtr], 
-										gSepLogDetPtr[classPtr[1]],
+										&meanPtr[mean1Index], 
+										&meanPtr[mean2Index], 
+										&covPtr[cov1Index], 
+										&covPtr[cov2Index],
+										logDetPtr[*classPtr], 
+										logDetPtr[classPtr[1]],
 										meanDifPtr, 
+										inverseMatrixMemoryPtr,
 										numberSeparabilityChannels);
 					break;
 					
 				case kMeanBhattacharyya:
 					distance = MeanBhattacharyya (
-										&gSepMeanPtr[mean1Index], 
-										&gSepMeanPtr[mean2Index], 
-										&gSepCovPtr[cov1Index], 
-										&gSepCovPtr[cov2Index],
+										&meanPtr[mean1Index], 
+										&meanPtr[mean2Index], 
+										&covPtr[cov1Index], 
+										&covPtr[cov2Index],
 										meanDifPtr, 
+										inverseMatrixMemoryPtr,
 										numberSeparabilityChannels);
 					break;
 					
 				case kCovarianceBhattacharyya:
 					distance = CovarianceBhattacharyya (
-										&gSepCovPtr[cov1Index], 
-										&gSepCovPtr[cov2Index],
-										gSepLogDetPtr[*classPtr], 
-										gSepLogDetPtr[classPtr[1]],
+										&covPtr[cov1Index], 
+										&covPtr[cov2Index],
+										logDetPtr[*classPtr], 
+										logDetPtr[classPtr[1]],
+										inverseMatrixMemoryPtr,
 										numberSeparabilityChannels);
 					break;
 						
 				case kNonCovarianceBhattacharyya:
 					distance = NonCovarianceBhattacharyya (
-										&gSepMeanPtr[mean1Index], 
-										&gSepMeanPtr[mean2Index], 
-										&gSepCovPtr[cov1Index], 
-										&gSepCovPtr[cov2Index],
+										&meanPtr[mean1Index], 
+										&meanPtr[mean2Index], 
+										&covPtr[cov1Index], 
+										&covPtr[cov2Index],
 										meanDifPtr, 
+										inverseMatrixMemoryPtr,
 										(UInt32)numberSeparabilityChannels);
 					break;
 					
 				case kTransformedDivergence:
 					distance = TransformedDivergence (
-										&gSepMeanPtr[mean1Index], 
-										&gSepMeanPtr[mean2Index], 
-										&gSepCovPtr[cov1Index], 
-										&gSepCovPtr[cov2Index],
-										&gSepInvPtr[cov1Index], 
-										&gSepInvPtr[cov2Index],
+										&meanPtr[mean1Index], 
+										&meanPtr[mean2Index], 
+										&covPtr[cov1Index], 
+										&covPtr[cov2Index],
+										&invPtr[cov1Index], 
+										&invPtr[cov2Index],
 										meanDifPtr, 
 										numberSeparabilityChannels);
 					break;
 						
 				case kDivergence:
 					distance = Divergence (
-										&gSepMeanPtr[mean1Index], 
-										&gSepMeanPtr[mean2Index], 
-										&gSepCovPtr[cov1Index], 
-										&gSepCovPtr[cov2Index],
-										&gSepInvPtr[cov1Index], 
-										&gSepInvPtr[cov2Index],
+										&meanPtr[mean1Index], 
+										&meanPtr[mean2Index], 
+										&covPtr[cov1Index], 
+										&covPtr[cov2Index],
+										&invPtr[cov1Index], 
+										&invPtr[cov2Index],
 										meanDifPtr, 
 										numberSeparabilityChannels);
 					break;
@@ -1806,6 +2008,283 @@ SInt16 ComputeSeparabilityForAllClassCombinations (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 ComputeSeparabilityForCombinationBlocks
+//
+//	Software purpose:	The purpose of this routine is to calculate the separability
+//							for all channel combinations and all class combinations
+//							using worker threads. The statistics for a block of channel
+//							combinations are loaded by the calling thread since messages
+//							may be listed and the feature transformation memory is
+//							shared. The separabilities for the block are then computed
+//							on the worker threads. The results are added to the 
+//							separability lists by the calling thread in channel 
+//							combination order so that the lists are the same as those
+//							from the serial loop.
+//
+//	Parameters in:		Pointer to the separability combinations structure.
+//							Vector of the first channel combination.
+//							Number of channel combinations.
+//
+//	Parameters out:	Quit code; -1 if the user canceled or a problem occurred.
+//
+// Value Returned:	1 if everything okay; <= 0 if not.
+// 
+// Called By:			ComputeSeparabilityForAllChannelCombinations in SFeatureSelection.cpp
+
+SInt16 ComputeSeparabilityForCombinationBlocks (
+				SepCombinationsPtr				sepCombinationsPtr,
+				SInt16*								currentChannelSetsPtr,
+				UInt32								numberChannelGroupCombinations,
+				SInt16*								quitCodePtr)
+
+{
+	SepCombinationPtr					combinationPtr;
+	SepDistancesSummaryPtr			distancesSummaryPtr;
+	
+	HDoublePtr							savedSepCovPtr,
+											savedSepInvPtr,
+											savedSepLogDetPtr,
+											savedSepMeanPtr;
+	
+	HFloatPtr							distancesPtr;
+	HSInt16Ptr							weightsPtr;
+	
+	SInt16								*channelSetsPtr,
+											*featurePtr;
+	
+	SInt32								freeIndex;
+										
+	UInt32								blockIndex,
+											channelCombination,
+											channelSetsIndex,
+											classSet,
+											combinationIndex,
+											combinationSlots,
+											maxNumberCombinations,
+											numberBlockCombinations;
+										
+	Boolean								continueFlag,
+											firstTimeFlag,
+											nextCombinationFlag;
+													
+	SInt16								i,
+											numberFeatures,
+											numberSeparabilityChannels,
+											numberSeparabilityGroups,
+											returnCode;
+	
+	
+			// Initialize local variables.
+			
+	distancesSummaryPtr = 
+				(SepDistancesSummaryPtr)gSeparabilitySpecsPtr->distancesSummaryPtr;
+	numberFeatures = gSeparabilitySpecsPtr->numberFeatures;
+	combinationSlots = gSeparabilitySpecsPtr->combinationSlots;
+	featurePtr = (SInt16*)GetHandlePointer (gSeparabilitySpecsPtr->featureHandle);
+	weightsPtr = (SInt16*)GetHandlePointer (
+										gProjectInfoPtr->classPairWeightsHandle);
+	numberSeparabilityChannels = sepCombinationsPtr->numberSeparabilityChannels;
+	numberSeparabilityGroups =  numberSeparabilityChannels/
+										gSeparabilitySpecsPtr->numberContiguousPerGroup;
+	maxNumberCombinations = sepCombinationsPtr->maxNumberCombinations;
+	
+			// The global statistics pointers are set to the statistics memory for
+			// each channel combination while it is being loaded. Save them so that
+			// they can be restored at the end.
+			
+	savedSepCovPtr = gSepCovPtr;
+	savedSepInvPtr = gSepInvPtr;
+	savedSepLogDetPtr = gSepLogDetPtr;
+	savedSepMeanPtr = gSepMeanPtr;
+	
+	channelCombination = 0;
+	firstTimeFlag = TRUE;
+	freeIndex = -1;
+	returnCode = 1;
+	
+	continueFlag = TRUE;
+	nextCombinationFlag = TRUE;
+	
+	while (continueFlag)
+		{
+				// Load the statistics for the next block of channel combinations.
+				// Stop at the first channel combination for which the statistics
+				// could not be loaded.
+		
+		numberBlockCombinations = 0;
+		while (numberBlockCombinations < maxNumberCombinations &&
+					channelCombination+numberBlockCombinations < 
+																	numberChannelGroupCombinations)
+			{
+			combinationPtr = &sepCombinationsPtr->combinationPtr[numberBlockCombinations];
+			
+			for (i=0; i<numberSeparabilityChannels; i++)
+				combinationPtr->channelSetPtr[i] = featurePtr[currentChannelSetsPtr[i]];
+				
+			gSepCovPtr = combinationPtr->sepStatistics.covPtr;
+			gSepInvPtr = combinationPtr->sepStatistics.invPtr;
+			gSepLogDetPtr = combinationPtr->sepStatistics.logDetPtr;
+			gSepMeanPtr = combinationPtr->sepStatistics.meanPtr;
+								
+			combinationPtr->loadReturnCode = LoadSeparabilityStatistics (
+																combinationPtr->channelSetPtr, 
+																numberSeparabilityChannels);
+			combinationPtr->returnCode = combinationPtr->loadReturnCode;
+			
+			numberBlockCombinations++;
+			
+			if (combinationPtr->loadReturnCode <= 0)
+				break;
+			
+					// Get the next channel combination.
+			
+			nextCombinationFlag = GetNextCombination (
+									currentChannelSetsPtr, 
+									numberSeparabilityGroups, 
+									numberFeatures,
+									gSeparabilitySpecsPtr->numberContiguousPerGroup);
+			
+			if (!nextCombinationFlag)
+				break;
+			
+			}	// end "while (numberBlockCombinations < maxNumberCombinations && ..."
+		
+				// Compute the separability measures for the channel combinations in
+				// the block.
+		
+		sepCombinationsPtr->numberCombinations = numberBlockCombinations;
+		
+		RunTasksInParallel (sepCombinationsPtr->numberSlots, 
+									ComputeSeparabilityCombinationsTask, 
+									sepCombinationsPtr);
+		
+				// Add the results to the separability lists in channel combination
+				// order.
+			
+		for (blockIndex=0; blockIndex<numberBlockCombinations; blockIndex++)
+			{
+			combinationPtr = &sepCombinationsPtr->combinationPtr[blockIndex];
+			
+			if (TickCount () >= gNextStatusTime)
+				{
+				LoadDItemRealValue (gStatusDialogPtr, 
+											IDC_Status8, 
+											(double)channelCombination+1,
+											0);
+										
+				gNextStatusTime = TickCount () + gNextStatusTimeOffset;
+				
+				}	// end "if (TickCount () >= gNextStatusTime)"
+		
+					// Get the next free index in 'distancesSummaryPtr'.
+			
+			if (channelCombination < combinationSlots)
+				combinationIndex = channelCombination;
+				
+			else	// channelCombination >= combinationSlots 
+				{
+				combinationIndex = freeIndex;
+				freeIndex = distancesSummaryPtr[combinationIndex].nextMean;
+				
+				}	// else channelCombination >= combinationSlots 
+				
+					// Break out of loop if combinationIndex is out of range.
+					
+			if (combinationIndex >= combinationSlots)
+				{
+				continueFlag = FALSE;
+				break;
+				
+				}	// end "if (combinationIndex >= combinationSlots)"
+			
+			channelSetsIndex = distancesSummaryPtr[combinationIndex].channelSetIndex;
+			channelSetsPtr = &gSeparabilitySpecsPtr->channelSetsPtr[channelSetsIndex];
+			
+			for (i=0; i<numberSeparabilityChannels; i++)
+				channelSetsPtr[i] = combinationPtr->channelSetPtr[i];
+				
+			returnCode = combinationPtr->returnCode;
+			
+			if (returnCode > 0)
+				{
+				distancesSummaryPtr[combinationIndex].classPairMean = 
+											combinationPtr->distancesSummary.classPairMean;
+				distancesSummaryPtr[combinationIndex].classPairMinimum = 
+											combinationPtr->distancesSummary.classPairMinimum;
+				
+				if (gSeparabilitySpecsPtr->listClassPairDistances)
+					{
+					distancesPtr = &gSeparabilitySpecsPtr->distancesPtr[
+								distancesSummaryPtr[combinationIndex].classPairDistancesIndex];
+								
+					for (classSet=0; 
+							classSet<sepCombinationsPtr->numberClassCombinations; 
+							classSet++)
+						{
+						if (weightsPtr[classSet] > 0)
+							distancesPtr[classSet] = combinationPtr->distancesPtr[classSet];
+							
+						}	// end "for (classSet=0; classSet<..."
+					
+					}	// end "if (...->listClassPairDistances)"
+				
+						// Update the list pointers.
+						
+				returnCode = UpdateSeparabilityLists (distancesSummaryPtr, 
+																	combinationIndex, 
+																	channelCombination,
+																	&freeIndex,
+																	firstTimeFlag);
+								
+				firstTimeFlag = FALSE;
+				
+				}	// end "if (returnCode > 0)"
+				
+			else if (combinationPtr->loadReturnCode <= 0)
+				distancesSummaryPtr[combinationIndex].classPairDistancesIndex = -1;
+			
+					// Exit loop if user has "command period" down or return code
+					// indicates that a problem exists.
+				
+			if (TickCount () >= gNextTime)
+				{
+				if (!CheckSomeEvents (osMask+keyDownMask+updateMask+mDownMask+mUpMask))
+					returnCode = -1;
+						
+				}	// end "if (TickCount () >= gNextTime)"
+				
+			channelCombination++;
+				
+			if (gAlertReturnCode == 1 || returnCode <= 0)
+				{
+				*quitCodePtr = -1;
+				continueFlag = FALSE;
+				break;
+				
+				}	// end "if (gAlertReturnCode == 1 || returnCode <= 0)"
+			
+			}	// end "for (blockIndex=0; blockIndex<numberBlockCombinations; ..."
+			
+		if (!nextCombinationFlag || 
+								channelCombination >= numberChannelGroupCombinations)
+			continueFlag = FALSE;
+	
+		}	// end "while (continueFlag)"
+		
+	gSepCovPtr = savedSepCovPtr;
+	gSepInvPtr = savedSepInvPtr;
+	gSepLogDetPtr = savedSepLogDetPtr;
+	gSepMeanPtr = savedSepMeanPtr;
+		
+	return (returnCode);
+
+}	// end "ComputeSeparabilityForCombinationBlocks"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -1834,6 +2313,8 @@ double CovarianceBhattacharyya (
 																				//	class 1 covariance matrix	
 				double								logDeterminant2,	// log of determinant of 
 																				//	class 2 covariance matrix		
+				InverseMatrixMemoryPtr			inverseMatrixMemoryPtr, // work memory
+																				// for the matrix inversion.
 				SInt16								numberFeatures)	// number of features (channels) 
 																				// represented in the mean vector  	
 																				// and covariance and inverse  	
@@ -1858,7 +2339,7 @@ double CovarianceBhattacharyya (
 			// The 1/2 will be taken care of by subtracting the
 			// constant 'numberFeature * ln (2)'.						
 	
-	tInversePtr = gInverseMatrixMemory.inversePtr;
+	tInversePtr = inverseMatrixMemoryPtr->inversePtr;
 	temp1Ptr = cov1Ptr;
 	temp2Ptr = cov2Ptr;
 	
@@ -1889,13 +2370,14 @@ double CovarianceBhattacharyya (
 		
 	InvertSymmetricMatrix (tInversePtr, 
 									numberFeatures, 
-									gInverseMatrixMemory.pivotPtr, 
-									gInverseMatrixMemory.indexRowPtr, 
-									gInverseMatrixMemory.indexColPtr, 
-									gInverseMatrixMemory.ipvotPtr,
+									inverseMatrixMemoryPtr->pivotPtr, 
+									inverseMatrixMemoryPtr->indexRowPtr, 
+									inverseMatrixMemoryPtr->indexColPtr, 
+									inverseMatrixMemoryPtr->ipvotPtr,
 									NULL,
 									&logDeterminant,
-									kReturnMatrixInverse);
+									kReturnMatrixInverse,
+									!inverseMatrixMemoryPtr->workerThreadFlag);
 									
 	if (gOperationCanceledFlag)
 																						return (0);
@@ -3821,6 +4303,8 @@ double MeanBhattacharyya (
 				HDoublePtr							cov2Ptr,				// covariance matrix of class 2
 				HDoublePtr							meanDifPtr, 		// vector storage of class 1 and 	
 																				// class 2 mean difference. 			
+				InverseMatrixMemoryPtr			inverseMatrixMemoryPtr, // work memory
+																				// for the matrix inversion.
 				SInt16								numberFeatures)	// number of features (channels) 
 																				// represented in the mean vector  	
 																				// and covariance and inverse  	
@@ -3847,7 +4331,7 @@ double MeanBhattacharyya (
 			// The 1/2 will be taken care of in the mean part by only dividing
 			// by 4 instead of 8.						
 	
-	tInversePtr = gInverseMatrixMemory.inversePtr;
+	tInversePtr = inverseMatrixMemoryPtr->inversePtr;
 	temp1Ptr = cov1Ptr;
 	temp2Ptr = cov2Ptr;
 	
@@ -3879,13 +4363,14 @@ double MeanBhattacharyya (
 	InvertSymmetricMatrix (
 									tInversePtr, 
 									numberFeatures, 
-									gInverseMatrixMemory.pivotPtr, 
-									gInverseMatrixMemory.indexRowPtr, 
-									gInverseMatrixMemory.indexColPtr, 
-									gInverseMatrixMemory.ipvotPtr,
+									inverseMatrixMemoryPtr->pivotPtr, 
+									inverseMatrixMemoryPtr->indexRowPtr, 
+									inverseMatrixMemoryPtr->indexColPtr, 
+									inverseMatrixMemoryPtr->ipvotPtr,
 									NULL,
 									&logDeterminant,
-									kReturnMatrixInverse);
+									kReturnMatrixInverse,
+									!inverseMatrixMemoryPtr->workerThreadFlag);
 									
 	if (gOperationCanceledFlag)
 																						return (0);
@@ -3929,7 +4414,7 @@ double MeanBhattacharyya (
 			// This is taken care of by dividing by 2 instead of 4 at the end of the
 			// computation.																	
 	
-	tInversePtr = &gInverseMatrixMemory.inversePtr[numberFeatures];
+	tInversePtr = &inverseMatrixMemoryPtr->inversePtr[numberFeatures];
 	temp1Ptr = meanDifPtr + 1;			
 	bhattacharyya2 = 0;
 	tmpIndex2 = numberFeatures - 1;
@@ -3988,6 +4473,8 @@ double NonCovarianceBhattacharyya (
 				HDoublePtr							cov2Ptr,			// covariance matrix of class 2
 				HDoublePtr							meanDifPtr, 	// vector storage of class 1 and 		
 																			// class 2 mean difference. 				
+				InverseMatrixMemoryPtr			inverseMatrixMemoryPtr, // work memory
+																			// for the variances.
 				UInt32								numberFeatures)	// number of features (channels)  		
 																		// represented in the mean vector and 	
 																		// covariance and inverse covariance 	
@@ -4008,7 +4495,7 @@ double NonCovarianceBhattacharyya (
 			// The 1/2 will be taken care of in the mean part by only dividing
 			// by 4 instead of 8.										
 	
-	tInversePtr = gInverseMatrixMemory.inversePtr;
+	tInversePtr = inverseMatrixMemoryPtr->inversePtr;
 	temp1Ptr = cov1Ptr;
 	temp2Ptr = cov2Ptr;
 	
@@ -4053,7 +4540,7 @@ double NonCovarianceBhattacharyya (
 			// Get the i=j component items of the mean part of the 					
 			// Bhattacharyya distance.															
 							
-	tInversePtr = gInverseMatrixMemory.inversePtr;
+	tInversePtr = inverseMatrixMemoryPtr->inversePtr;
 	temp1Ptr = meanDifPtr;			
 	bhattacharyya1 = 0;
 	for (channel1=0; channel1<numberFeatures; channel1++)
@@ -4073,6 +4560,89 @@ double NonCovarianceBhattacharyya (
 													
 
                                                                                 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void ReleaseSeparabilityCombinationsMemory
+//
+//	Software purpose:	The purpose of this routine is to release the memory that 
+//							was allocated for a block of channel combinations by
+//							SetupSeparabilityCombinationsMemory.
+//
+//	Parameters in:		Pointer to the separability combinations structure.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+// 
+// Called By:			ComputeSeparabilityForAllChannelCombinations in SFeatureSelection.cpp
+//							SetupSeparabilityCombinationsMemory in SFeatureSelection.cpp
+
+void ReleaseSeparabilityCombinationsMemory (
+				SepCombinationsPtr				sepCombinationsPtr)
+
+{
+	SepCombinationPtr					combinationPtr;
+	InverseMatrixMemoryPtr			inverseMatrixMemoryPtr;
+	
+	UInt32								index;
+	
+	
+	if (sepCombinationsPtr->combinationPtr != NULL)
+		{
+		for (index=0; index<sepCombinationsPtr->maxNumberCombinations; index++)
+			{
+			combinationPtr = &sepCombinationsPtr->combinationPtr[index];
+			
+			combinationPtr->sepStatistics.covPtr = 
+							CheckAndDisposePtr (combinationPtr->sepStatistics.covPtr);
+			combinationPtr->sepStatistics.invPtr = 
+							CheckAndDisposePtr (combinationPtr->sepStatistics.invPtr);
+			combinationPtr->sepStatistics.logDetPtr = 
+							CheckAndDisposePtr (combinationPtr->sepStatistics.logDetPtr);
+			combinationPtr->sepStatistics.meanPtr = 
+							CheckAndDisposePtr (combinationPtr->sepStatistics.meanPtr);
+			combinationPtr->distancesPtr = 
+							CheckAndDisposePtr (combinationPtr->distancesPtr);
+			combinationPtr->channelSetPtr = 
+							CheckAndDisposePtr (combinationPtr->channelSetPtr);
+			
+			}	// end "for (index=0; index<...->maxNumberCombinations; index++)"
+			
+		sepCombinationsPtr->combinationPtr = (SepCombinationPtr)CheckAndDisposePtr (
+											(Ptr)sepCombinationsPtr->combinationPtr);
+		
+		}	// end "if (sepCombinationsPtr->combinationPtr != NULL)"
+		
+	if (sepCombinationsPtr->inverseMatrixMemoryPtr != NULL)
+		{
+		for (index=0; index<sepCombinationsPtr->numberSlots; index++)
+			{
+			inverseMatrixMemoryPtr = &sepCombinationsPtr->inverseMatrixMemoryPtr[index];
+			
+			inverseMatrixMemoryPtr->inversePtr = 
+							CheckAndDisposePtr (inverseMatrixMemoryPtr->inversePtr);
+			inverseMatrixMemoryPtr->pivotPtr = 
+							CheckAndDisposePtr (inverseMatrixMemoryPtr->pivotPtr);
+			inverseMatrixMemoryPtr->indexColPtr = 
+							CheckAndDisposePtr (inverseMatrixMemoryPtr->indexColPtr);
+			inverseMatrixMemoryPtr->indexRowPtr = 
+							CheckAndDisposePtr (inverseMatrixMemoryPtr->indexRowPtr);
+			inverseMatrixMemoryPtr->ipvotPtr = 
+							CheckAndDisposePtr (inverseMatrixMemoryPtr->ipvotPtr);
+			
+			}	// end "for (index=0; index<sepCombinationsPtr->numberSlots; index++)"
+			
+		sepCombinationsPtr->inverseMatrixMemoryPtr = 
+							(InverseMatrixMemoryPtr)CheckAndDisposePtr (
+											(Ptr)sepCombinationsPtr->inverseMatrixMemoryPtr);
+		
+		}	// end "if (sepCombinationsPtr->inverseMatrixMemoryPtr != NULL)"
+	
+}	// end "ReleaseSeparabilityCombinationsMemory"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -6492,6 +7062,158 @@ void SeparabilityListDialogOK (
 
 
                                                                                 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean SetupSeparabilityCombinationsMemory
+//
+//	Software purpose:	The purpose of this routine is to get the memory needed to
+//							compute the separability for a block of channel combinations
+//							on worker threads. Each channel combination in the block
+//							gets its own memory for the class statistics, class pair
+//							distances and channel set. Each slot gets its own memory
+//							for the matrix inversions. The size of the statistics
+//							memory is the same as that from SetupSeparabilityStatMemory.
+//
+//	Parameters in:		Number of slots (threads) to be used.
+//							Number of class combinations.
+//							Number of channels in each channel combination.
+//
+//	Parameters out:	Separability combinations structure. The combination pointer
+//							is NULL if the memory is not available.
+//
+// Value Returned:	TRUE if the memory is available; FALSE if not.
+// 
+// Called By:			ComputeSeparabilityForAllChannelCombinations in SFeatureSelection.cpp
+
+Boolean SetupSeparabilityCombinationsMemory (
+				SepCombinationsPtr				sepCombinationsPtr,
+				UInt32								numberSlots,
+				UInt32								numberClassCombinations, 
+				SInt16								numberSeparabilityChannels)
+
+{
+	SepCombinationPtr					combinationPtr;
+	InverseMatrixMemoryPtr			inverseMatrixMemoryPtr;
+	
+	UInt32								covBytesNeeded,
+											index,
+											invBytesNeeded,
+											numberChannels,
+											numberClasses;
+	
+	Boolean								continueFlag,
+											covarianceFlag;
+	
+	
+			// Initialize parameters.
+	
+	covarianceFlag = 
+			(gSeparabilitySpecsPtr->distanceMeasure != kNonCovarianceBhattacharyya);
+	numberChannels = gSeparabilitySpecsPtr->numberChannels;
+	numberClasses = gSeparabilitySpecsPtr->numberClasses;
+	
+	sepCombinationsPtr->numberClassCombinations = numberClassCombinations;
+	sepCombinationsPtr->numberCombinations = 0;
+	sepCombinationsPtr->numberSlots = numberSlots;
+	sepCombinationsPtr->maxNumberCombinations = 
+											numberSlots * kSeparabilityCombinationsPerThread;
+	sepCombinationsPtr->numberSeparabilityChannels = numberSeparabilityChannels;
+	
+	sepCombinationsPtr->inverseMatrixMemoryPtr = 
+							(InverseMatrixMemoryPtr)MNewPointerClear (
+												numberSlots * sizeof (InverseMatrixMemory));
+	sepCombinationsPtr->combinationPtr = (SepCombinationPtr)MNewPointerClear (
+						sepCombinationsPtr->maxNumberCombinations * sizeof (SepCombination));
+	
+	continueFlag = (sepCombinationsPtr->inverseMatrixMemoryPtr != NULL &&
+													sepCombinationsPtr->combinationPtr != NULL);
+	
+			// Get the number of bytes needed for the class covariance matrices. 
+			// Allow memory for one square matrix to be used as temporary memory 
+			// when loading the class covariance memory for transformations.
+			
+	invBytesNeeded = numberClasses * numberSeparabilityChannels * sizeof (double);
+	covBytesNeeded = invBytesNeeded;
+	if (covarianceFlag)
+		{
+		invBytesNeeded *= (numberSeparabilityChannels + 1);
+		invBytesNeeded /= 2;
+		
+		covBytesNeeded = invBytesNeeded + (numberChannels*numberChannels-
+			numberSeparabilityChannels*(numberSeparabilityChannels+1)/2) * sizeof (double);
+		
+		}	// end "if (covarianceFlag)"
+		
+	for (index=0; 
+			index<sepCombinationsPtr->maxNumberCombinations && continueFlag; 
+			index++)
+		{
+		combinationPtr = &sepCombinationsPtr->combinationPtr[index];
+		
+		combinationPtr->sepStatistics.meanPtr = (HDoublePtr)MNewPointer (
+						numberClasses * numberSeparabilityChannels * sizeof (double));
+		combinationPtr->sepStatistics.covPtr = 
+												(HDoublePtr)MNewPointer (covBytesNeeded);
+		combinationPtr->sepStatistics.logDetPtr = (HDoublePtr)MNewPointer (
+																numberClasses * sizeof (double));
+		combinationPtr->channelSetPtr = (SInt16*)MNewPointer (
+													numberSeparabilityChannels * sizeof (SInt16));
+		
+		continueFlag = (combinationPtr->sepStatistics.meanPtr != NULL &&
+								combinationPtr->sepStatistics.covPtr != NULL &&
+									combinationPtr->sepStatistics.logDetPtr != NULL &&
+										combinationPtr->channelSetPtr != NULL);
+		
+				// Inverse covariance matrices are only needed for divergence and
+				// transformed divergence.
+			
+		if (continueFlag && gSepInvPtr != NULL)
+			{
+			combinationPtr->sepStatistics.invPtr = 
+												(HDoublePtr)MNewPointer (invBytesNeeded);
+			continueFlag = (combinationPtr->sepStatistics.invPtr != NULL);
+			
+			}	// end "if (continueFlag && gSepInvPtr != NULL)"
+		
+		if (continueFlag && gSeparabilitySpecsPtr->listClassPairDistances)
+			{
+			combinationPtr->distancesPtr = (HFloatPtr)MNewPointer (
+											numberClassCombinations * sizeof (float));
+			continueFlag = (combinationPtr->distancesPtr != NULL);
+			
+			}	// end "if (continueFlag && ...->listClassPairDistances)"
+		
+		}	// end "for (index=0; index<...->maxNumberCombinations && ..."
+		
+	for (index=0; index<numberSlots && continueFlag; index++)
+		{
+		inverseMatrixMemoryPtr = &sepCombinationsPtr->inverseMatrixMemoryPtr[index];
+		
+		continueFlag = SetupMatrixInversionMemory (
+													numberSeparabilityChannels,
+													covarianceFlag,
+													&inverseMatrixMemoryPtr->inversePtr, 
+													&inverseMatrixMemoryPtr->pivotPtr, 
+													&inverseMatrixMemoryPtr->indexRowPtr, 
+													&inverseMatrixMemoryPtr->indexColPtr, 
+													&inverseMatrixMemoryPtr->ipvotPtr);
+		
+				// User events are not checked on the worker threads.
+				
+		inverseMatrixMemoryPtr->workerThreadFlag = TRUE;
+		
+		}	// end "for (index=0; index<numberSlots && continueFlag; index++)"
+		
+	if (!continueFlag)
+		ReleaseSeparabilityCombinationsMemory (sepCombinationsPtr);
+		
+	return (continueFlag);
+		
+}	// end "SetupSeparabilityCombinationsMemory"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
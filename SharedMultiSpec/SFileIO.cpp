@@ -122,14 +122,121 @@
 	#endif
 #endif	// include_gdal_capability
 
+#if include_simd_capability
+	#include <immintrin.h>
+	#if defined _MSC_VER
+		#include <intrin.h>
+		#define SIMD_TARGET_SSE41
+		#define SIMD_TARGET_AVX2
+	#else	// !defined _MSC_VER
+				// Allow the SSE4.1 and AVX2 routines to be compiled without
+				// requiring these instructions for the rest of the application.
+		#define SIMD_TARGET_SSE41	__attribute__ ((target ("sse4.1")))
+		#define SIMD_TARGET_AVX2	__attribute__ ((target ("avx2")))
+	#endif	// defined _MSC_VER, else
+#endif	// include_simd_capability
+
 extern Handle 			gCustomNavOpenList;
 extern Handle 			gCustomNavPut;	
 
+		// Structures used to decompress the blocks in a block row of a compressed
+		// TIFF file. One decompression task is done for each block that is not
+		// in the tile cache.
+
+typedef struct CompressedBlock
+	{
+	HUCharPtr					compressedDataPtr;
+	HUCharPtr					outputDataPtr;
+	HUCharPtr					rowBufferPtr;
+	
+	UInt32						block;
+	UInt32						fileOffset;
+	UInt32						numberCompressedBytes;
+	
+	SInt16						errCode;
+	Boolean						readFlag;
+	
+	} CompressedBlock, *CompressedBlockPtr;
+
+typedef struct CompressedBlocks
+	{
+	FileInfoPtr					fileInfoPtr;
+	CompressedBlockPtr		compressedBlockPtr;
+	
+	UInt32						numberOutputBytes;
+	UInt32						numberRowBytes;
+	
+	} CompressedBlocks, *CompressedBlocksPtr;
+
+		// Structure for one block (tile) of data in the tile cache for blocked
+		// image files. A block is identified by the identity of the file it was
+		// read from (see GetTileCacheFileIdentity), the index of the hfa
+		// structure for the channel (0 for band interleave by block and BIS) and
+		// the block row and column within the image. The hashNext index links
+		// the entries in the same hash bucket (or the free entries) and the
+		// lruNext and lruPrevious indices link the entries in the order of use.
+		// An index of -1 marks the end of a list.
+
+typedef struct TileCacheEntry
+	{
+	UInt64						fileIdentity;
+	HUCharPtr					dataPtr;
+	
+	UInt32						hfaIndex;
+	UInt32						blockRow;
+	UInt32						blockColumn;
+	UInt32						numberBytes;
+	
+	SInt32						hashNext;
+	SInt32						lruNext;
+	SInt32						lruPrevious;
+	
+	} TileCacheEntry, *TileCacheEntryPtr;
+
+		// Tile cache for blocked image files. The cache is shared by all file
+		// io instructions for a file and is limited to gTileCacheMaximumBytes.
+		// The entries are found through a hash table of kTileCacheHashSize
+		// buckets. The least recently used blocks (the tail of the use list) are
+		// released first.
+		
+TileCacheEntryPtr					gTileCacheEntryPtr = NULL;
+SInt32*								gTileCacheHashPtr = NULL;
+SInt32								gTileCacheFreeIndex = -1;
+SInt32								gTileCacheLeastRecentIndex = -1;
+SInt32								gTileCacheMostRecentIndex = -1;
+UInt32								gTileCacheNumberBytes = 0;
+UInt32								gTileCacheNumberEntries = 0;
+
 							
 
 		// Prototype descriptions for routines in this file that are only		
 		// called by routines in this file.
 
+void		AddTileCacheEntry (
+				UInt64								fileIdentity,
+				UInt32								hfaIndex,
+				UInt32								blockRow,
+				UInt32								blockColumn,
+				HUCharPtr							blockBufferPtr,
+				UInt32								numberBytes);
+
+void		AdjustReadData (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							fileIOBufferPtr,
+				UInt32								numberSamples,
+				UInt32								count,
+				Boolean								endHalfByte);
+
+#if include_simd_capability
+	SIMD_TARGET_SSE41
+	void		AdjustReadDataSSE41 (
+					UInt32								postReadCode,
+					UInt16								signedBitMask,
+					UInt16								signedValueMask,
+					HUCharPtr							fileIOBufferPtr,
+					UInt32								numberBytes);
+#endif	// include_simd_capability
+
 void		AdjustSignedData (
 				FileInfoPtr							fileInfoPtr,
 				HUCharPtr							fileIOBufferPtr,
@@ -146,6 +253,31 @@ void 		CloseUpHeirarchalFileIOParameters (
 				FileInfoPtr							fileInfoPtr, 
 				UInt16*								channelListPtr,
 				UInt16								numberChannels);
+
+void		CloseUpTIFFOverviewFileIO (
+				FileIOInstructionsPtr			fileIOInstructionsPtr);
+
+Boolean	ConvertDataSamples (
+				UInt32								dataConversionCode,
+				HUCharPtr							inputPtr,
+				HUCharPtr							outputPtr,
+				UInt32								numberSamples);
+
+#if include_simd_capability
+	SIMD_TARGET_AVX2
+	void		ConvertDataSamplesAVX2 (
+					UInt32								dataConversionCode,
+					HUCharPtr							inputPtr,
+					HUCharPtr							outputPtr,
+					UInt32								numberSamples);
+
+	SIMD_TARGET_SSE41
+	void		ConvertDataSamplesSSE41 (
+					UInt32								dataConversionCode,
+					HUCharPtr							inputPtr,
+					HUCharPtr							outputPtr,
+					UInt32								numberSamples);
+#endif	// include_simd_capability
 									
 Boolean	CreateTRLSupportFile (
 				CMFileStream*						trailerStreamPtr, 
@@ -154,8 +286,68 @@ Boolean	CreateTRLSupportFile (
 				char*									classNameTablePtr,
 				SInt16								trailerCode,
 				Boolean								writeClassNamesFlag);
+
+void		DecodeCompressedBlock (
+				void*									taskInfoPtr,
+				UInt32								task);
+
+TileCacheEntryPtr FindTileCacheEntry (
+				UInt64								fileIdentity,
+				UInt32								hfaIndex,
+				UInt32								blockRow,
+				UInt32								blockColumn);
 							
+#if include_gdal_capability
+			// Routine in SGDALInterface.cpp. The prototype is included here because
+			// the GDALDatasetH type is not defined for SPrototypes.h.
+			
+	extern GDALDatasetH GetGDALFileReference (
+					Handle								hdfHandle,
+					UInt16								numberHdfDataSets,
+					SInt16								format,
+					GDALDatasetH						gdalDataSetH,
+					HdfDataSets*						hdfDataSetsPtr,
+					UInt32								dataSet);
+					
+	HUCharPtr GetGDALBlockRowLinePointer (
+					FileIOInstructionsPtr			fileIOInstructionsPtr,
+					FileInfoPtr							fileInfoPtr,
+					GDALDatasetH						hDS,
+					UInt32								lineNumber,
+					UInt32								gdalColumnStart,
+					UInt32								gdalColumnEnd,
+					UInt32								numberChannels,
+					int*									gdalChannelListPtr,
+					int*									rasterIOChannelListPtr,
+					SInt16*								errCodePtr);
+#endif	// include_gdal_capability
+
+#if include_gdal_capability && include_hdf5_capability
+			// Routine in SHDF5.cpp. The prototype is included here because the
+			// GDALDatasetH type is not defined for SPrototypes.h.
+			
+	extern Boolean ReadHDF5ChunkedLine (
+					GDALDatasetH						hDS,
+					FileInfoPtr							fileInfoPtr,
+					UInt32								lineNumber,
+					UInt32								columnStart,
+					UInt32								columnEnd,
+					UInt32								numberChannels,
+					int*									channelListPtr,
+					HUCharPtr							outputBufferPtr);
+#endif	// include_gdal_capability && include_hdf5_capability
+
+SInt16	GetAreaRunsLineOfData (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				UInt32								lineNumber, 
+				UInt32								columnStart, 
+				UInt32								columnEnd, 
+				UInt32								columnInterval,
+				HUCharPtr							fileIOBufferPtr, 
+				HUCharPtr							dataBufferPtr);
+
 SInt16	GetGDALLineOfData (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
 				FileInfoPtr							fileInfoPtr,	
 				HUCharPtr							ioBufferPtr,
 				UInt32								lineNumber,
@@ -168,15 +360,65 @@ SInt16	GetGDALLineOfData (
 								
 Boolean	GetFileDlgDetermineLinkVisibility ();
 
+HUCharPtr GetLinesBufferPointer (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				CMFileStream*						fileStreamPtr,
+				SInt64								posOff,
+				UInt32								count);
+
+#if defined multispec_wx
+	HUCharPtr GetMappedLine (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				FileInfoPtr							fileInfoPtr,
+				UInt32								lineNumber, 
+				SInt16								channelNumber,  
+				UInt32								columnStart, 
+				UInt32								columnEnd,
+				UInt32*								numberSamplesPtr);
+#endif	// defined multispec_wx
+
 SInt16	GetFileTypeAndCreator (
 				CMFileStream*						fileStreamPtr);
+
+Boolean	GetSIMDConversionBytes (
+				UInt32								dataConversionCode,
+				UInt32*								inputBytesPtr,
+				UInt32*								outputBytesPtr);
+
+SInt16	GetSIMDLevel (void);
+
+UInt32	GetPostReadCode (
+				FileInfoPtr							fileInfoPtr);
 							
 SInt16 	GetThematicSupportFileToCreate (
 				FileInfoPtr							gisFileInfoPtr,
 				CMFileStream*						trailerStreamPtr,
 				UInt32								supportFileType,
 				Boolean								promptFlag);
+
+UInt64	GetTileCacheFileIdentity (
+				CMFileStream*						fileStreamPtr);
+
+UInt32	GetTileCacheHashIndex (
+				UInt64								fileIdentity,
+				UInt32								hfaIndex,
+				UInt32								blockRow,
+				UInt32								blockColumn);
                        
+#if include_simd_capability
+	SIMD_TARGET_AVX2
+	inline __m256i LoadInt32ValuesAVX2 (
+					UInt32								inputCode,
+					HUCharPtr							inputPtr);
+
+	SIMD_TARGET_SSE41
+	inline void	LoadInt32ValuesSSE41 (
+					UInt32								inputCode,
+					HUCharPtr							inputPtr,
+					__m128i*								lowValuesPtr,
+					__m128i*								highValuesPtr);
+#endif	// include_simd_capability
+
 void 		LoadErdasTRLClassColorBuffer (
 				FileInfoPtr							gisFileInfoPtr,
 				ColorSpec*							colorSpecPtr,
@@ -206,6 +448,21 @@ SInt16	LoadGroupInformationBuffers (
 				UInt16								numberClassSymbols,
 				Boolean								asciiSymbolsFlag);
 
+UInt32	LoadLinesBuffer (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				UInt32								lineStart,
+				UInt32								numberLines,
+				UInt32								lineInterval,
+				UInt32								columnStart,
+				UInt32								columnEnd);
+
+SInt64	LoadLinesBufferRanges (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				UInt32								lineStart,
+				UInt32								lineEnd,
+				UInt32								columnStart,
+				UInt32								columnEnd);
+
 Boolean	LoadProbabilityGroupInformation (
 				FileInfoPtr							fileInfoPtr,  
 				RGBCharColorPtr					classColorTablePtr,
@@ -262,6 +519,7 @@ void 		PackBISData (
 				UInt16*								channelListPtr);
 							
 UInt32 	PackMaskData (
+				MaskInfoPtr							maskInfoPtr,
 				HUInt16Ptr							maskBufferPtr,
 				UInt32								maskColumnStart,
 				UInt32								numberChannels,
@@ -284,6 +542,18 @@ void		PackNonBISData (
 				HUCharPtr							dataCharBufferPtr, 
 				Boolean								toBISFormat); 
 
+Boolean	PackNonBISDataUsingSIMD (
+				UInt32								columnOffset,
+				UInt32								numberColumnsPerChannel,  
+				UInt32								numberBufferChannels,
+				UInt32								numberChannels,
+				HUInt16Ptr							channelListPtr, 
+				UInt32								numberSamples,
+				UInt32								dataConversionCode, 
+				HUCharPtr							ioCharBufferPtr, 
+				HUCharPtr							dataCharBufferPtr, 
+				Boolean								toBISFormat);
+
 void		PackGAIAData (
 				SInt32								columnStart, 
 				SInt32								columnEnd, 
@@ -298,6 +568,30 @@ void 		PackBlockedData (
 				HierarchalFileFormatPtr			hfaPtr,
 				HUCharPtr							outputBufferPtr);
 
+SInt16	ReadBlocksUsingTileCache (
+				CMFileStream*						fileStreamPtr,
+				FileInfoPtr							fileInfoPtr,
+				HierarchalFileFormatPtr			hfaPtr,
+				UInt32								lineNumber,
+				SInt64								posOff,
+				HUCharPtr							readBufferPtr);
+
+SInt16	ReadCompressedBlocks (
+				CMFileStream*						fileStreamPtr,
+				FileInfoPtr							fileInfoPtr,
+				HierarchalFileFormatPtr			hfaPtr,
+				UInt32								lineNumber,
+				HUCharPtr							readBufferPtr);
+
+#if defined multispec_wx
+	void		ReadLinesBufferRange (
+					void*									taskInfoPtr,
+					UInt32								task);
+#endif	// defined multispec_wx
+
+void		ReleaseTileCacheEntry (
+				SInt32								index);
+
 SInt16 	SetUpDataConversionCode (
 				LayerInfoPtr						layerInfoPtr,
 				FileInfoPtr							fileInfoPtr,
@@ -312,6 +606,37 @@ void 		SetUpHeirarchalFileIOParameters (
 				UInt16*								channelListPtr,
 				UInt32								columnStart, 
 				UInt32								columnEnd);
+
+#if defined multispec_wx
+	Boolean	SetUpMappedFileIO (
+				FileIOInstructionsPtr			fileIOInstructionsPtr);
+#endif	// defined multispec_wx
+
+void		SetUpTIFFOverviewFileIO (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				UInt16								numberListChannels,
+				HUInt16Ptr							channelListPtr,
+				UInt32*								lineStartPtr,
+				UInt32*								lineEndPtr,
+				UInt32*								lineIntervalPtr,
+				UInt32*								columnStartPtr,
+				UInt32*								columnEndPtr,
+				UInt32*								columnIntervalPtr);
+
+void		Unpack4BitData (
+				HUCharPtr							fileIOBufferPtr,
+				UInt32								numberSamples,
+				UInt32								count,
+				Boolean								endHalfByte);
+
+#if include_simd_capability
+	SIMD_TARGET_SSE41
+	UInt32	Unpack4BitDataSSE41 (
+					HUCharPtr							byte1Ptr,
+					HUCharPtr							byte2Ptr,
+					UInt32								samplesLeft,
+					HUCharPtr							fileIOBufferPtr);
+#endif	// include_simd_capability
 	
 	
 													
@@ -324,6 +649,372 @@ void 		SetUpHeirarchalFileIOParameters (
 #endif
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void AddTileCacheEntry
+//
+//	Software purpose:	The purpose of this routine is to add a copy of the input
+//							block of data to the tile cache for blocked image files. The
+//							least recently used blocks are released if needed to keep the
+//							cache within the maximum number of bytes allowed. If the block
+//							is already in the cache with the same size, it is only marked
+//							as the most recently used one.
+//		
+//	Parameters in:		Identity of the file the block was read from.
+//							Index of hfa structure for the channel.
+//							Block row and column (0-based) of the block.
+//							Pointer to the data for the block.
+//							Number of bytes in the block.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			ReadBlocksUsingTileCache in SFileIO.cpp
+//							ReadCompressedBlocks in SFileIO.cpp
+
+void AddTileCacheEntry (
+				UInt64								fileIdentity,
+				UInt32								hfaIndex,
+				UInt32								blockRow,
+				UInt32								blockColumn,
+				HUCharPtr							blockBufferPtr,
+				UInt32								numberBytes)
+
+{
+	HUCharPtr							dataPtr;
+	TileCacheEntryPtr					tileCacheEntryPtr;
+	
+	SInt32								index;
+	UInt32								hashIndex;
+	
+	
+	if (numberBytes == 0 || numberBytes > gTileCacheMaximumBytes)
+																							return;
+																					
+	if (gTileCacheEntryPtr == NULL)
+		{
+		gTileCacheEntryPtr = (TileCacheEntryPtr)MNewPointer (
+										(SInt64)kMaxTileCacheEntries * sizeof (TileCacheEntry));
+		
+		gTileCacheHashPtr = (SInt32*)MNewPointer (
+										(SInt64)kTileCacheHashSize * sizeof (SInt32));
+		
+		if (gTileCacheEntryPtr == NULL || gTileCacheHashPtr == NULL)
+			{
+			gTileCacheEntryPtr = (TileCacheEntryPtr)CheckAndDisposePtr (
+																			(Ptr)gTileCacheEntryPtr);
+			gTileCacheHashPtr = (SInt32*)CheckAndDisposePtr ((Ptr)gTileCacheHashPtr);
+																							return;
+			
+			}	// end "if (gTileCacheEntryPtr == NULL || ..."
+			
+		for (index=0; index<kTileCacheHashSize; index++)
+			gTileCacheHashPtr[index] = -1;
+		
+				// All entries start out in the free list.
+		
+		for (index=0; index<kMaxTileCacheEntries; index++)
+			{
+			gTileCacheEntryPtr[index].dataPtr = NULL;
+			gTileCacheEntryPtr[index].hashNext = index + 1;
+			
+			}	// end "for (index=0; index<kMaxTileCacheEntries; index++)"
+			
+		gTileCacheEntryPtr[kMaxTileCacheEntries-1].hashNext = -1;
+		gTileCacheFreeIndex = 0;
+		gTileCacheLeastRecentIndex = -1;
+		gTileCacheMostRecentIndex = -1;
+		
+		}	// end "if (gTileCacheEntryPtr == NULL)"
+		
+			// A block that is already in the cache with the same size does not
+			// need to be copied again. One with a different size is replaced.
+		
+	tileCacheEntryPtr = FindTileCacheEntry (
+										fileIdentity, hfaIndex, blockRow, blockColumn);
+	
+	if (tileCacheEntryPtr != NULL)
+		{
+		if (tileCacheEntryPtr->numberBytes == numberBytes)
+																							return;
+		
+		ReleaseTileCacheEntry ((SInt32)(tileCacheEntryPtr - gTileCacheEntryPtr));
+		
+		}	// end "if (tileCacheEntryPtr != NULL)"
+		
+			// Release the least recently used blocks until there is room for the
+			// new block.
+	
+	while (gTileCacheLeastRecentIndex >= 0 &&
+				(gTileCacheFreeIndex < 0 ||
+						gTileCacheNumberBytes + numberBytes > gTileCacheMaximumBytes))
+		ReleaseTileCacheEntry (gTileCacheLeastRecentIndex);
+		
+	dataPtr = (HUCharPtr)MNewPointer (numberBytes);
+	if (dataPtr == NULL)
+																							return;
+																					
+	BlockMoveData (blockBufferPtr, dataPtr, numberBytes);
+	
+	index = gTileCacheFreeIndex;
+	tileCacheEntryPtr = &gTileCacheEntryPtr[index];
+	gTileCacheFreeIndex = tileCacheEntryPtr->hashNext;
+	
+	tileCacheEntryPtr->fileIdentity = fileIdentity;
+	tileCacheEntryPtr->dataPtr = dataPtr;
+	tileCacheEntryPtr->hfaIndex = hfaIndex;
+	tileCacheEntryPtr->blockRow = blockRow;
+	tileCacheEntryPtr->blockColumn = blockColumn;
+	tileCacheEntryPtr->numberBytes = numberBytes;
+	
+			// Add the entry to the front of its hash bucket and of the use list.
+	
+	hashIndex = GetTileCacheHashIndex (fileIdentity, hfaIndex, blockRow, blockColumn);
+	tileCacheEntryPtr->hashNext = gTileCacheHashPtr[hashIndex];
+	gTileCacheHashPtr[hashIndex] = index;
+	
+	tileCacheEntryPtr->lruPrevious = -1;
+	tileCacheEntryPtr->lruNext = gTileCacheMostRecentIndex;
+	if (gTileCacheMostRecentIndex >= 0)
+		gTileCacheEntryPtr[gTileCacheMostRecentIndex].lruPrevious = index;
+	else	// gTileCacheMostRecentIndex < 0
+		gTileCacheLeastRecentIndex = index;
+	gTileCacheMostRecentIndex = index;
+	
+	gTileCacheNumberEntries++;
+	gTileCacheNumberBytes += numberBytes;
+	
+}	// end "AddTileCacheEntry"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void AdjustReadData
+//
+//	Software purpose:	The purpose of this routine is to do the operations needed on
+//							a line of data after it has been read from the file: swap the 
+//							bytes, adjust signed data to an unsigned range and unpack 4-bit
+//							data to 8-bit data. The byte swap and signed data adjustment 
+//							are done in one pass through the data. The operations needed 
+//							are determined from the current settings for each call since
+//							the swap bytes and signed data flags may be changed between
+//							reads of the same file, such as when a header is being read.
+//		
+//	Parameters in:		File information pointer.
+//							Pointer to the line of data.
+//							Number of samples in the line.
+//							Number of bytes read (only used for 4-bit data).
+//							Flag indicating whether the last sample is in the lower half of
+//								the last byte (only used for 4-bit data).
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			GetLine in SFileIO.cpp
+
+void AdjustReadData (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							fileIOBufferPtr,
+				UInt32								numberSamples,
+				UInt32								count,
+				Boolean								endHalfByte)
+
+{
+	UInt32								postReadCode;
+	
+	
+	postReadCode = GetPostReadCode (fileInfoPtr);
+	
+	if (postReadCode & kPostReadSwapOrAdjust)
+		{
+		#if include_simd_capability
+			if (GetSIMDLevel () >= kSIMDSSE41)
+				{
+				AdjustReadDataSSE41 (postReadCode,
+												fileInfoPtr->signedBitMask,
+												fileInfoPtr->signedValueMask,
+												fileIOBufferPtr,
+												numberSamples * fileInfoPtr->numberBytes);
+				postReadCode &= ~kPostReadSwapOrAdjust;
+				
+				}	// end "if (GetSIMDLevel () >= kSIMDSSE41)"
+		#endif	// include_simd_capability
+		
+		if (postReadCode & (kPostReadSwap2Bytes | kPostReadAdjustSigned2Bytes))
+			{
+			HUInt16Ptr				twoBytePtr;
+			
+			UInt32					sampleCount;
+			UInt16					signedBitMask2,
+										signedValueMask2,
+										value;
+			
+			signedBitMask2 = 0;
+			signedValueMask2 = 0xffff;
+			if (postReadCode & kPostReadAdjustSigned2Bytes)
+				{
+				signedBitMask2 = fileInfoPtr->signedBitMask;
+				signedValueMask2 = fileInfoPtr->signedValueMask;
+				
+				}	// end "if (postReadCode & kPostReadAdjustSigned2Bytes)"
+				
+			twoBytePtr = (HUInt16Ptr)fileIOBufferPtr;
+			
+			if (postReadCode & kPostReadSwap2Bytes)
+				{
+				for (sampleCount=0; sampleCount<numberSamples; sampleCount++)
+					{
+					value = ((*twoBytePtr & 0xff00) >> 8) | ((*twoBytePtr & 0x00ff) << 8);
+					*twoBytePtr = (value ^ signedBitMask2) & signedValueMask2;
+					twoBytePtr++;
+					
+					}	// end "for (sampleCount=0; ..."
+				
+				}	// end "if (postReadCode & kPostReadSwap2Bytes)"
+				
+			else	// !(postReadCode & kPostReadSwap2Bytes)
+				{
+				for (sampleCount=0; sampleCount<numberSamples; sampleCount++)
+					{
+					*twoBytePtr = (*twoBytePtr ^ signedBitMask2) & signedValueMask2;
+					twoBytePtr++;
+					
+					}	// end "for (sampleCount=0; ..."
+				
+				}	// end "else !(postReadCode & kPostReadSwap2Bytes)"
+			
+			}	// end "if (postReadCode & (kPostReadSwap2Bytes | ..."
+			
+		else if (postReadCode & kPostReadSwap4Bytes)
+			Swap4Bytes ((HUInt32Ptr)fileIOBufferPtr, numberSamples);
+			
+		else if (postReadCode & kPostReadSwap8Bytes)
+			Swap8Bytes ((DoublePtr)fileIOBufferPtr, numberSamples);
+			
+		else if (postReadCode & kPostReadAdjustSigned1Byte)
+			AdjustSignedData (fileInfoPtr, fileIOBufferPtr, numberSamples);
+		
+		}	// end "if (postReadCode & kPostReadSwapOrAdjust)"
+		
+	if (postReadCode & kPostReadUnpack4Bits)
+		Unpack4BitData (fileIOBufferPtr, numberSamples, count, endHalfByte);
+	
+}	// end "AdjustReadData"
+
+
+
+#if include_simd_capability
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void AdjustReadDataSSE41
+//
+//	Software purpose:	The purpose of this routine is to swap the bytes and/or adjust
+//							the signed data in a line of data using SSE4.1 instructions. 
+//							The byte swap is done with a byte shuffle and the signed data 
+//							adjustment with an exclusive or and an and. Sixteen bytes are
+//							handled in each pass of the loop. The bytes left at the end are
+//							handled through a small temporary buffer. 
+//		
+//	Parameters in:		Post read code.
+//							Signed bit mask and signed value mask for the file.
+//							Pointer to the line of data.
+//							Number of bytes in the line.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			AdjustReadData in SFileIO.cpp
+
+SIMD_TARGET_SSE41
+void AdjustReadDataSSE41 (
+				UInt32								postReadCode,
+				UInt16								signedBitMask,
+				UInt16								signedValueMask,
+				HUCharPtr							fileIOBufferPtr,
+				UInt32								numberBytes)
+
+{
+	UInt8									tail[16];
+	
+	__m128i								bitMask,
+											shuffleControl,
+											valueMask,
+											values;
+	
+	UInt32								index,
+											numberTailBytes;
+	
+	
+	if (postReadCode & kPostReadSwap2Bytes)
+		shuffleControl = _mm_setr_epi8 (1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14);
+		
+	else if (postReadCode & kPostReadSwap4Bytes)
+		shuffleControl = _mm_setr_epi8 (3,2,1,0,7,6,5,4,11,10,9,8,15,14,13,12);
+		
+	else if (postReadCode & kPostReadSwap8Bytes)
+		shuffleControl = _mm_setr_epi8 (7,6,5,4,3,2,1,0,15,14,13,12,11,10,9,8);
+		
+	else	// no byte swap
+		shuffleControl = _mm_setr_epi8 (0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15);
+	
+	if (postReadCode & kPostReadAdjustSigned1Byte)
+		{
+		bitMask = _mm_set1_epi8 ((char)signedBitMask);
+		valueMask = _mm_set1_epi8 ((char)signedValueMask);
+		
+		}	// end "if (postReadCode & kPostReadAdjustSigned1Byte)"
+		
+	else if (postReadCode & kPostReadAdjustSigned2Bytes)
+		{
+		bitMask = _mm_set1_epi16 ((short)signedBitMask);
+		valueMask = _mm_set1_epi16 ((short)signedValueMask);
+		
+		}	// end "else if (postReadCode & kPostReadAdjustSigned2Bytes)"
+		
+	else	// no signed data adjustment
+		{
+		bitMask = _mm_setzero_si128 ();
+		valueMask = _mm_set1_epi32 (-1);
+		
+		}	// end "else no signed data adjustment"
+	
+	numberTailBytes = numberBytes % 16;
+	numberBytes -= numberTailBytes;
+		
+	for (index=0; index<numberBytes; index+=16)
+		{
+		values = _mm_loadu_si128 ((__m128i*)&fileIOBufferPtr[index]);
+		values = _mm_shuffle_epi8 (values, shuffleControl);
+		values = _mm_and_si128 (_mm_xor_si128 (values, bitMask), valueMask);
+		_mm_storeu_si128 ((__m128i*)&fileIOBufferPtr[index], values);
+		
+		}	// end "for (index=0; index<numberBytes; index+=16)"
+		
+	if (numberTailBytes > 0)
+		{
+		memcpy (tail, &fileIOBufferPtr[numberBytes], numberTailBytes);
+		
+		values = _mm_loadu_si128 ((__m128i*)tail);
+		values = _mm_shuffle_epi8 (values, shuffleControl);
+		values = _mm_and_si128 (_mm_xor_si128 (values, bitMask), valueMask);
+		_mm_storeu_si128 ((__m128i*)tail, values);
+		
+		memcpy (&fileIOBufferPtr[numberBytes], tail, numberTailBytes);
+		
+		}	// end "if (numberTailBytes > 0)"
+	
+}	// end "AdjustReadDataSSE41"
+#endif	// include_simd_capability
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -767,8 +1458,17 @@ void CloseFile (
 		#endif	// defined multispec_mac
 			
       #if defined multispec_win || defined multispec_wx
+					// Note that MCloseFile releases any blocks for this file in the
+					// tile cache.
+					
 			fileStreamPtr->MCloseFile ();
 		#endif	// defined multispec_win || defined multispec_wx
+		
+		#if defined multispec_mac
+					// Release any blocks for this file in the tile cache.
+					
+			ReleaseTileCacheEntries (fileStreamPtr);
+		#endif	// defined multispec_mac
 			
 		}	// end "if (fileStreamPtr != NULL)" 
 	
@@ -830,13 +1530,46 @@ void CloseUpFileIOInstructions (
 			{
 			CheckAndUnlockHandle (areaDescriptionPtr->maskInfoPtr->maskHandle);
 			fileIOInstructionsPtr->maskBufferPtr = NULL;
+			fileIOInstructionsPtr->maskInfoPtr = NULL;
 			
 			}	// end "if (fileIOInstructionsPtr->maskBufferPtr != NULL && ..."
 			
+				// Release the column runs for the area.
+				
+		fileIOInstructionsPtr->areaRunsFlag = FALSE;
+		fileIOInstructionsPtr->areaLineRunIndexHandle = 
+						UnlockAndDispose (fileIOInstructionsPtr->areaLineRunIndexHandle);
+		fileIOInstructionsPtr->areaRunsHandle = 
+						UnlockAndDispose (fileIOInstructionsPtr->areaRunsHandle);
+			
 				// Release memory allocated to fileInfoPtr->gdalChannelListPtr.
 				
 		fileIOInstructionsPtr->gdalChannelListPtr = 
 				(int*)CheckAndDisposePtr ((Ptr)fileIOInstructionsPtr->gdalChannelListPtr);
+				
+				// Release memory for the gdal block row buffer.
+				
+		fileIOInstructionsPtr->gdalBlockBufferPtr = (HUCharPtr)CheckAndDisposePtr (
+												(Ptr)fileIOInstructionsPtr->gdalBlockBufferPtr);
+		fileIOInstructionsPtr->gdalBlockBufferBytes = 0;
+		fileIOInstructionsPtr->gdalBlockFirstLine = 0;
+		fileIOInstructionsPtr->gdalBlockLastLine = 0;
+				
+				// Release memory for the buffer used to read blocks of lines.
+				
+		fileIOInstructionsPtr->linesBufferPtr = (HUCharPtr)CheckAndDisposePtr (
+														(Ptr)fileIOInstructionsPtr->linesBufferPtr);
+		fileIOInstructionsPtr->linesBufferRangePtr = 
+							(LinesBufferRangePtr)CheckAndDisposePtr (
+												(Ptr)fileIOInstructionsPtr->linesBufferRangePtr);
+		fileIOInstructionsPtr->linesBufferBytes = 0;
+		fileIOInstructionsPtr->linesBufferMaxRanges = 0;
+		fileIOInstructionsPtr->linesBufferNumberRanges = 0;
+		
+				// Restore the full resolution file information if a reduced
+				// resolution TIFF image was being read.
+				
+		CloseUpTIFFOverviewFileIO (fileIOInstructionsPtr);
 		
 				// Force flag for Threaded IO to be FALSE.
 				
@@ -875,6 +1608,8 @@ void CloseUpGeneralFileIOInstructions (
 {	
 	if (fileIOInstructionsPtr != NULL)
 		{
+		CloseUpTIFFOverviewFileIO (fileIOInstructionsPtr);
+		
 		CloseUpHeirarchalFileIOParameters (
 												fileIOInstructionsPtr->layerInfoPtr,
 												fileIOInstructionsPtr->fileInfoPtr, 
@@ -1023,27 +1758,81 @@ void CloseUpHeirarchalFileIOParameters (
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Function name:		void CloseWindowImageFiles
+//	Function name:		void CloseUpTIFFOverviewFileIO
 //
-//	Software purpose:	This routine closes the open image files associated
-//							with the input window information handle and disposes
-//							of the description handle and file information handle
-//							associated with each of the image files.
+//	Software purpose:	This routine releases the copy of the file information
+//							structure for the reduced resolution TIFF image being read and
+//							restores the full resolution file information structure in the
+//							file IO instruction structure.
 //
-//	Parameters in:		Handle to window information
+//	Parameters in:		File IO instructions structure
 //
 //	Parameters out:	None
 //
 // Value Returned:	None
 //
-// Called By:			DeactivateProject in SProject.cpp
-//							ChangeProjectBaseImage in SProject.cpp
-//
-//	Coded By:			Larry L. Biehl			Date: 06/21/1990
-//	Revised By:			Larry L. Biehl			Date: 06/04/1996
+// Called By:			CloseUpFileIOInstructions in SFileIO.cpp
+//							CloseUpGeneralFileIOInstructions in SFileIO.cpp
+//							SetUpTIFFOverviewFileIO in SFileIO.cpp
 
-void CloseWindowImageFiles (
-				Handle								windowInfoHandle)
+void CloseUpTIFFOverviewFileIO (
+				FileIOInstructionsPtr			fileIOInstructionsPtr)
+
+{
+	FileInfoPtr							overviewFileInfoPtr;
+	
+	
+	overviewFileInfoPtr = fileIOInstructionsPtr->tiffOverviewFileInfoPtr;
+	
+	if (overviewFileInfoPtr != NULL)
+		{
+		CloseUpHeirarchalFileIOParameters (
+												fileIOInstructionsPtr->layerInfoPtr,
+												overviewFileInfoPtr, 
+												fileIOInstructionsPtr->channelListPtr,
+												(UInt16)fileIOInstructionsPtr->numberChannels);
+		
+		UnlockHierarchalFileHandles (NULL, overviewFileInfoPtr);
+		
+		fileIOInstructionsPtr->fileInfoPtr = 
+											fileIOInstructionsPtr->tiffOverviewSavedFileInfoPtr;
+		
+		fileIOInstructionsPtr->tiffOverviewFileInfoPtr = 
+										(FileInfoPtr)CheckAndDisposePtr ((Ptr)overviewFileInfoPtr);
+		fileIOInstructionsPtr->tiffOverviewSavedFileInfoPtr = NULL;
+		
+		}	// end "if (overviewFileInfoPtr != NULL)"
+		
+	fileIOInstructionsPtr->tiffOverviewFactor = 1;
+	
+}	// end "CloseUpTIFFOverviewFileIO"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void CloseWindowImageFiles
+//
+//	Software purpose:	This routine closes the open image files associated
+//							with the input window information handle and disposes
+//							of the description handle and file information handle
+//							associated with each of the image files.
+//
+//	Parameters in:		Handle to window information
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			DeactivateProject in SProject.cpp
+//							ChangeProjectBaseImage in SProject.cpp
+//
+//	Coded By:			Larry L. Biehl			Date: 06/21/1990
+//	Revised By:			Larry L. Biehl			Date: 06/04/1996
+
+void CloseWindowImageFiles (
+				Handle								windowInfoHandle)
 
 {
 	Handle								fileInfoHandle;
@@ -1208,6 +1997,522 @@ double ConvertATRealtoReal (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean ConvertDataSamples
+//
+//	Software purpose:	The purpose of this routine is to convert a contiguous vector
+//							of samples from the input data type to the output data type
+//							described by the data conversion code using the SIMD 
+//							instructions available on the processor. The samples left over
+//							after the last full group of kSIMDPackSamples are converted 
+//							through a small temporary buffer so that the same SIMD code is
+//							used for them.
+//							The input and output vectors cannot overlap.
+//
+//	Parameters in:		Data conversion code.
+//							Pointer to the input samples.
+//							Pointer to the output samples.
+//							Number of samples to convert.
+//
+//	Parameters out:	None
+//
+// Value Returned:	TRUE if the samples were converted.
+//							FALSE if the SIMD instructions are not available or the data
+//								conversion code is not handled by the SIMD routines. The
+//								calling routine needs to use the scalar code.
+//
+// Called By:			PackBISData in SFileIO.cpp
+//							PackNonBISDataUsingSIMD in SFileIO.cpp
+
+Boolean ConvertDataSamples (
+				UInt32								dataConversionCode,
+				HUCharPtr							inputPtr,
+				HUCharPtr							outputPtr,
+				UInt32								numberSamples)
+
+{
+	#if include_simd_capability
+		double								inputTail[kSIMDPackSamples],
+												outputTail[kSIMDPackSamples];
+		
+		UInt32								inputBytes,
+												numberTailSamples,
+												numberVectorSamples,
+												outputBytes;
+		
+		SInt16								simdLevel;
+		
+		
+		simdLevel = GetSIMDLevel ();
+		if (simdLevel == kSIMDNone)
+																						return (FALSE);
+		
+		if (!GetSIMDConversionBytes (dataConversionCode, &inputBytes, &outputBytes))
+																						return (FALSE);
+																						
+				// Data that do not change are just copied.
+		
+		if ((dataConversionCode >> 16) == (dataConversionCode & 0x0000ffff))
+			{
+			BlockMoveData (inputPtr, outputPtr, numberSamples*inputBytes);
+																						return (TRUE);
+																						
+			}	// end "if ((dataConversionCode >> 16) == ..."
+		
+		numberTailSamples = numberSamples % kSIMDPackSamples;
+		numberVectorSamples = numberSamples - numberTailSamples;
+		
+		if (simdLevel == kSIMDAVX2)
+			ConvertDataSamplesAVX2 (
+								dataConversionCode, inputPtr, outputPtr, numberVectorSamples);
+			
+		else	// simdLevel == kSIMDSSE41
+			ConvertDataSamplesSSE41 (
+								dataConversionCode, inputPtr, outputPtr, numberVectorSamples);
+		
+		if (numberTailSamples > 0)
+			{
+			inputPtr = &inputPtr[numberVectorSamples*inputBytes];
+			outputPtr = &outputPtr[numberVectorSamples*outputBytes];
+			
+			memset (inputTail, 0, sizeof (inputTail));
+			BlockMoveData (inputPtr, inputTail, numberTailSamples*inputBytes);
+			
+			if (simdLevel == kSIMDAVX2)
+				ConvertDataSamplesAVX2 (dataConversionCode, 
+												(HUCharPtr)inputTail, 
+												(HUCharPtr)outputTail, 
+												kSIMDPackSamples);
+				
+			else	// simdLevel == kSIMDSSE41
+				ConvertDataSamplesSSE41 (dataConversionCode, 
+													(HUCharPtr)inputTail, 
+													(HUCharPtr)outputTail, 
+													kSIMDPackSamples);
+			
+			BlockMoveData (outputTail, outputPtr, numberTailSamples*outputBytes);
+			
+			}	// end "if (numberTailSamples > 0)"
+		
+		return (TRUE);
+	#else	// !include_simd_capability
+		return (FALSE);
+	#endif	// include_simd_capability, else
+	
+}	// end "ConvertDataSamples"
+
+
+
+#if include_simd_capability
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void ConvertDataSamplesAVX2
+//
+//	Software purpose:	The purpose of this routine is to convert a contiguous vector
+//							of samples from the input data type to the output data type
+//							using AVX2 instructions. kSIMDPackSamples samples are handled
+//							in each pass of the loop. The integer input values are first
+//							expanded to 32-bit integers.
+//							Unsigned 32-bit integers are converted to 32-bit reals in two
+//							16-bit halves so that the result is rounded the same as the
+//							scalar conversion.
+//
+//	Parameters in:		Data conversion code.
+//							Pointer to the input samples.
+//							Pointer to the output samples.
+//							Number of samples to convert; a multiple of kSIMDPackSamples.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			ConvertDataSamples in SFileIO.cpp
+
+SIMD_TARGET_AVX2
+void ConvertDataSamplesAVX2 (
+				UInt32								dataConversionCode,
+				HUCharPtr							inputPtr,
+				HUCharPtr							outputPtr,
+				UInt32								numberSamples)
+
+{
+	__m256i								int32Values;
+	
+	UInt32								inputBytes,
+											inputCode,
+											outputBytes,
+											sample;
+	
+	
+	GetSIMDConversionBytes (dataConversionCode, &inputBytes, &outputBytes);
+	inputCode = dataConversionCode >> 16;
+	
+	switch (dataConversionCode)
+		{
+		case k8BitIntSignedTo16BitIntSigned:
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples)
+				_mm_storeu_si128 (
+						(__m128i*)&outputPtr[sample*2],
+						_mm_cvtepi8_epi16 (_mm_loadl_epi64 ((__m128i*)&inputPtr[sample])));
+			break;
+			
+		case k8BitIntUnsignedTo16BitIntUnsigned:
+		case k8BitIntUnsignedTo16BitIntSigned:
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples)
+				_mm_storeu_si128 (
+						(__m128i*)&outputPtr[sample*2],
+						_mm_cvtepu8_epi16 (_mm_loadl_epi64 ((__m128i*)&inputPtr[sample])));
+			break;
+			
+		case k8BitIntSignedTo32BitIntSigned:
+		case k8BitIntUnsignedTo32BitIntUnsigned:
+		case k8BitIntUnsignedTo32BitIntSigned:
+		case k16BitIntSignedTo32BitIntSigned:
+		case k16BitIntUnsignedTo32BitIntUnsigned:
+		case k16BitIntUnsignedTo32BitIntSigned:
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples)
+				{
+				int32Values = LoadInt32ValuesAVX2 (inputCode, 
+																&inputPtr[sample*inputBytes]);
+				_mm256_storeu_si256 ((__m256i*)&outputPtr[sample*4], int32Values);
+				
+				}	// end "for (sample=0; sample<numberSamples; ..."
+			break;
+			
+		case k8BitIntSignedTo32BitReal:
+		case k8BitIntUnsignedTo32BitReal:
+		case k16BitIntSignedTo32BitReal:
+		case k16BitIntUnsignedTo32BitReal:
+		case k32BitIntSignedTo32BitReal:
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples)
+				{
+				int32Values = LoadInt32ValuesAVX2 (inputCode, 
+																&inputPtr[sample*inputBytes]);
+				_mm256_storeu_ps ((float*)&outputPtr[sample*4], 
+										_mm256_cvtepi32_ps (int32Values));
+				
+				}	// end "for (sample=0; sample<numberSamples; ..."
+			break;
+			
+		case k32BitIntUnsignedTo32BitReal:
+			{
+			__m256i			highValues,
+								lowMask;
+			__m256			highScale;
+			
+			lowMask = _mm256_set1_epi32 (0x0000ffff);
+			highScale = _mm256_set1_ps (65536.f);
+			
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples)
+				{
+				int32Values = _mm256_loadu_si256 ((__m256i*)&inputPtr[sample*4]);
+				highValues = _mm256_srli_epi32 (int32Values, 16);
+				int32Values = _mm256_and_si256 (int32Values, lowMask);
+				_mm256_storeu_ps (
+						(float*)&outputPtr[sample*4],
+						_mm256_add_ps (
+								_mm256_mul_ps (_mm256_cvtepi32_ps (highValues), highScale),
+								_mm256_cvtepi32_ps (int32Values)));
+				
+				}	// end "for (sample=0; sample<numberSamples; ..."
+				
+			}
+			break;
+			
+		case k8BitIntSignedTo64BitReal:
+		case k8BitIntUnsignedTo64BitReal:
+		case k16BitIntSignedTo64BitReal:
+		case k16BitIntUnsignedTo64BitReal:
+		case k32BitIntSignedTo64BitReal:
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples)
+				{
+				int32Values = LoadInt32ValuesAVX2 (inputCode, 
+																&inputPtr[sample*inputBytes]);
+				_mm256_storeu_pd (
+						(double*)&outputPtr[sample*8], 
+						_mm256_cvtepi32_pd (_mm256_castsi256_si128 (int32Values)));
+				_mm256_storeu_pd (
+						(double*)&outputPtr[sample*8+32], 
+						_mm256_cvtepi32_pd (_mm256_extracti128_si256 (int32Values, 1)));
+				
+				}	// end "for (sample=0; sample<numberSamples; ..."
+			break;
+			
+		case k32BitIntUnsignedTo64BitReal:
+			{
+			__m256d			doubleValues,
+								twoTo32,
+								zero;
+			
+					// The values are converted as signed integers. 2^32 is added back
+					// to those which come out negative.
+					
+			twoTo32 = _mm256_set1_pd (4294967296.);
+			zero = _mm256_setzero_pd ();
+			
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples)
+				{
+				int32Values = _mm256_loadu_si256 ((__m256i*)&inputPtr[sample*4]);
+				
+				doubleValues = 
+							_mm256_cvtepi32_pd (_mm256_castsi256_si128 (int32Values));
+				doubleValues = _mm256_add_pd (
+						doubleValues, 
+						_mm256_and_pd (_mm256_cmp_pd (doubleValues, zero, _CMP_LT_OQ), 
+											twoTo32));
+				_mm256_storeu_pd ((double*)&outputPtr[sample*8], doubleValues);
+				
+				doubleValues = 
+							_mm256_cvtepi32_pd (_mm256_extracti128_si256 (int32Values, 1));
+				doubleValues = _mm256_add_pd (
+						doubleValues, 
+						_mm256_and_pd (_mm256_cmp_pd (doubleValues, zero, _CMP_LT_OQ), 
+											twoTo32));
+				_mm256_storeu_pd ((double*)&outputPtr[sample*8+32], doubleValues);
+				
+				}	// end "for (sample=0; sample<numberSamples; ..."
+				
+			}
+			break;
+			
+		case k32BitRealTo64BitReal:
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples)
+				{
+				_mm256_storeu_pd (
+							(double*)&outputPtr[sample*8], 
+							_mm256_cvtps_pd (_mm_loadu_ps ((float*)&inputPtr[sample*4])));
+				_mm256_storeu_pd (
+							(double*)&outputPtr[sample*8+32], 
+							_mm256_cvtps_pd (_mm_loadu_ps ((float*)&inputPtr[sample*4+16])));
+				
+				}	// end "for (sample=0; sample<numberSamples; ..."
+			break;
+			
+		case k64BitRealTo32BitReal:
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples)
+				{
+				_mm_storeu_ps (
+							(float*)&outputPtr[sample*4], 
+							_mm256_cvtpd_ps (_mm256_loadu_pd ((double*)&inputPtr[sample*8])));
+				_mm_storeu_ps (
+							(float*)&outputPtr[sample*4+16], 
+							_mm256_cvtpd_ps (
+									_mm256_loadu_pd ((double*)&inputPtr[sample*8+32])));
+				
+				}	// end "for (sample=0; sample<numberSamples; ..."
+			break;
+			
+		}	// end "switch (dataConversionCode)"
+	
+}	// end "ConvertDataSamplesAVX2"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void ConvertDataSamplesSSE41
+//
+//	Software purpose:	The purpose of this routine is to convert a contiguous vector
+//							of samples from the input data type to the output data type
+//							using SSE4.1 instructions. It follows ConvertDataSamplesAVX2
+//							with each group of kSIMDPackSamples samples being handled as 
+//							two 128-bit halves.
+//
+//	Parameters in:		Data conversion code.
+//							Pointer to the input samples.
+//							Pointer to the output samples.
+//							Number of samples to convert; a multiple of kSIMDPackSamples.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			ConvertDataSamples in SFileIO.cpp
+
+SIMD_TARGET_SSE41
+void ConvertDataSamplesSSE41 (
+				UInt32								dataConversionCode,
+				HUCharPtr							inputPtr,
+				HUCharPtr							outputPtr,
+				UInt32								numberSamples)
+
+{
+	__m128i								highValues,
+											lowValues;
+	
+	UInt32								inputBytes,
+											inputCode,
+											outputBytes,
+											sample;
+	
+	
+	GetSIMDConversionBytes (dataConversionCode, &inputBytes, &outputBytes);
+	inputCode = dataConversionCode >> 16;
+	
+	switch (dataConversionCode)
+		{
+		case k8BitIntSignedTo16BitIntSigned:
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples)
+				_mm_storeu_si128 (
+						(__m128i*)&outputPtr[sample*2],
+						_mm_cvtepi8_epi16 (_mm_loadl_epi64 ((__m128i*)&inputPtr[sample])));
+			break;
+			
+		case k8BitIntUnsignedTo16BitIntUnsigned:
+		case k8BitIntUnsignedTo16BitIntSigned:
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples)
+				_mm_storeu_si128 (
+						(__m128i*)&outputPtr[sample*2],
+						_mm_cvtepu8_epi16 (_mm_loadl_epi64 ((__m128i*)&inputPtr[sample])));
+			break;
+			
+		case k8BitIntSignedTo32BitIntSigned:
+		case k8BitIntUnsignedTo32BitIntUnsigned:
+		case k8BitIntUnsignedTo32BitIntSigned:
+		case k16BitIntSignedTo32BitIntSigned:
+		case k16BitIntUnsignedTo32BitIntUnsigned:
+		case k16BitIntUnsignedTo32BitIntSigned:
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples)
+				{
+				LoadInt32ValuesSSE41 (inputCode, 
+												&inputPtr[sample*inputBytes],
+												&lowValues,
+												&highValues);
+				_mm_storeu_si128 ((__m128i*)&outputPtr[sample*4], lowValues);
+				_mm_storeu_si128 ((__m128i*)&outputPtr[sample*4+16], highValues);
+				
+				}	// end "for (sample=0; sample<numberSamples; ..."
+			break;
+			
+		case k8BitIntSignedTo32BitReal:
+		case k8BitIntUnsignedTo32BitReal:
+		case k16BitIntSignedTo32BitReal:
+		case k16BitIntUnsignedTo32BitReal:
+		case k32BitIntSignedTo32BitReal:
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples)
+				{
+				LoadInt32ValuesSSE41 (inputCode, 
+												&inputPtr[sample*inputBytes],
+												&lowValues,
+												&highValues);
+				_mm_storeu_ps ((float*)&outputPtr[sample*4], 
+									_mm_cvtepi32_ps (lowValues));
+				_mm_storeu_ps ((float*)&outputPtr[sample*4+16], 
+									_mm_cvtepi32_ps (highValues));
+				
+				}	// end "for (sample=0; sample<numberSamples; ..."
+			break;
+			
+		case k32BitIntUnsignedTo32BitReal:
+			{
+			__m128i			lowMask;
+			__m128			highScale;
+			
+			lowMask = _mm_set1_epi32 (0x0000ffff);
+			highScale = _mm_set1_ps (65536.f);
+			
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples/2)
+				{
+				lowValues = _mm_loadu_si128 ((__m128i*)&inputPtr[sample*4]);
+				highValues = _mm_srli_epi32 (lowValues, 16);
+				lowValues = _mm_and_si128 (lowValues, lowMask);
+				_mm_storeu_ps (
+						(float*)&outputPtr[sample*4],
+						_mm_add_ps (_mm_mul_ps (_mm_cvtepi32_ps (highValues), highScale),
+										_mm_cvtepi32_ps (lowValues)));
+				
+				}	// end "for (sample=0; sample<numberSamples; ..."
+				
+			}
+			break;
+			
+		case k8BitIntSignedTo64BitReal:
+		case k8BitIntUnsignedTo64BitReal:
+		case k16BitIntSignedTo64BitReal:
+		case k16BitIntUnsignedTo64BitReal:
+		case k32BitIntSignedTo64BitReal:
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples)
+				{
+				LoadInt32ValuesSSE41 (inputCode, 
+												&inputPtr[sample*inputBytes],
+												&lowValues,
+												&highValues);
+				_mm_storeu_pd ((double*)&outputPtr[sample*8], 
+									_mm_cvtepi32_pd (lowValues));
+				_mm_storeu_pd ((double*)&outputPtr[sample*8+16], 
+									_mm_cvtepi32_pd (_mm_srli_si128 (lowValues, 8)));
+				_mm_storeu_pd ((double*)&outputPtr[sample*8+32], 
+									_mm_cvtepi32_pd (highValues));
+				_mm_storeu_pd ((double*)&outputPtr[sample*8+48], 
+									_mm_cvtepi32_pd (_mm_srli_si128 (highValues, 8)));
+				
+				}	// end "for (sample=0; sample<numberSamples; ..."
+			break;
+			
+		case k32BitIntUnsignedTo64BitReal:
+			{
+			__m128d			doubleValues,
+								twoTo32,
+								zero;
+			
+					// The values are converted as signed integers. 2^32 is added back
+					// to those which come out negative.
+					
+			twoTo32 = _mm_set1_pd (4294967296.);
+			zero = _mm_setzero_pd ();
+			
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples/4)
+				{
+				lowValues = _mm_loadl_epi64 ((__m128i*)&inputPtr[sample*4]);
+				
+				doubleValues = _mm_cvtepi32_pd (lowValues);
+				doubleValues = _mm_add_pd (
+								doubleValues, 
+								_mm_and_pd (_mm_cmplt_pd (doubleValues, zero), twoTo32));
+				_mm_storeu_pd ((double*)&outputPtr[sample*8], doubleValues);
+				
+				}	// end "for (sample=0; sample<numberSamples; ..."
+				
+			}
+			break;
+			
+		case k32BitRealTo64BitReal:
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples/2)
+				{
+				lowValues = _mm_loadu_si128 ((__m128i*)&inputPtr[sample*4]);
+				_mm_storeu_pd ((double*)&outputPtr[sample*8], 
+									_mm_cvtps_pd (_mm_castsi128_ps (lowValues)));
+				_mm_storeu_pd (
+							(double*)&outputPtr[sample*8+16], 
+							_mm_cvtps_pd (_mm_castsi128_ps (_mm_srli_si128 (lowValues, 8))));
+				
+				}	// end "for (sample=0; sample<numberSamples; ..."
+			break;
+			
+		case k64BitRealTo32BitReal:
+			for (sample=0; sample<numberSamples; sample+=kSIMDPackSamples/2)
+				{
+				_mm_storeu_ps (
+						(float*)&outputPtr[sample*4], 
+						_mm_movelh_ps (
+								_mm_cvtpd_ps (_mm_loadu_pd ((double*)&inputPtr[sample*8])),
+								_mm_cvtpd_ps (
+										_mm_loadu_pd ((double*)&inputPtr[sample*8+16]))));
+				
+				}	// end "for (sample=0; sample<numberSamples; ..."
+			break;
+			
+		}	// end "switch (dataConversionCode)"
+	
+}	// end "ConvertDataSamplesSSE41"
+#endif	// include_simd_capability
+
+
+
 //-----------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -3006,7 +4311,50 @@ Boolean CreateTRLSupportFile (
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Function name:		DisposeCMFileStream
+//	Function name:		void DecodeCompressedBlock
+//
+//	Software purpose:	The purpose of this routine is to decompress one block of a
+//							compressed TIFF file. It is called as one of the tasks set
+//							up by ReadCompressedBlocks and may run in a worker thread.
+//		
+//	Parameters in:		Pointer to the CompressedBlocks structure.
+//							Index of the block to be decompressed.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			RunTasksInParallel in SThreads.cpp
+
+void DecodeCompressedBlock (
+				void*									taskInfoPtr,
+				UInt32								task)
+
+{
+	CompressedBlockPtr				compressedBlockPtr;
+	CompressedBlocksPtr				compressedBlocksPtr;
+	
+	
+	compressedBlocksPtr = (CompressedBlocksPtr)taskInfoPtr;
+	compressedBlockPtr = &compressedBlocksPtr->compressedBlockPtr[task];
+	
+	compressedBlockPtr->errCode = DecodeTIFFBlock (
+											compressedBlocksPtr->fileInfoPtr,
+											compressedBlockPtr->compressedDataPtr,
+											compressedBlockPtr->numberCompressedBytes,
+											compressedBlockPtr->outputDataPtr,
+											compressedBlocksPtr->numberOutputBytes,
+											compressedBlocksPtr->numberRowBytes,
+											compressedBlockPtr->rowBufferPtr);
+	
+}	// end "DecodeCompressedBlock"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		DisposeCMFileStream
 //
 //	Software purpose:	This routine disposes of the input CMFileStream pointer. This
 //							differs between the Mac and Windows OSes.
@@ -3203,6 +4551,285 @@ Boolean FileOpen (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		TileCacheEntryPtr FindTileCacheEntry
+//
+//	Software purpose:	The purpose of this routine is to find the requested block
+//							in the tile cache for blocked image files. The entry is marked
+//							as the most recently used one if found.
+//		
+//	Parameters in:		Identity of the file the block was read from.
+//							Index of hfa structure for the channel.
+//							Block row and column (0-based) of the block.
+//
+//	Parameters out:	None
+//
+// Value Returned:	Pointer to the tile cache entry or NULL if the block is not in 
+//							the cache.
+//
+// Called By:			AddTileCacheEntry in SFileIO.cpp
+//							ReadBlocksUsingTileCache in SFileIO.cpp
+//							ReadCompressedBlocks in SFileIO.cpp
+
+TileCacheEntryPtr FindTileCacheEntry (
+				UInt64								fileIdentity,
+				UInt32								hfaIndex,
+				UInt32								blockRow,
+				UInt32								blockColumn)
+
+{
+	TileCacheEntryPtr					tileCacheEntryPtr;
+	
+	SInt32								index;
+	
+	
+	if (gTileCacheNumberEntries == 0)
+																				return (NULL);
+	
+	index = gTileCacheHashPtr[
+				GetTileCacheHashIndex (fileIdentity, hfaIndex, blockRow, blockColumn)];
+	
+	while (index >= 0)
+		{
+		tileCacheEntryPtr = &gTileCacheEntryPtr[index];
+		
+		if (tileCacheEntryPtr->fileIdentity == fileIdentity &&
+				tileCacheEntryPtr->blockRow == blockRow &&
+					tileCacheEntryPtr->blockColumn == blockColumn &&
+						tileCacheEntryPtr->hfaIndex == hfaIndex)
+			{
+					// Move the entry to the front of the use list.
+					
+			if (index != gTileCacheMostRecentIndex)
+				{
+				gTileCacheEntryPtr[tileCacheEntryPtr->lruPrevious].lruNext =
+																		tileCacheEntryPtr->lruNext;
+				
+				if (tileCacheEntryPtr->lruNext >= 0)
+					gTileCacheEntryPtr[tileCacheEntryPtr->lruNext].lruPrevious =
+																	tileCacheEntryPtr->lruPrevious;
+				else	// index == gTileCacheLeastRecentIndex
+					gTileCacheLeastRecentIndex = tileCacheEntryPtr->lruPrevious;
+				
+				tileCacheEntryPtr->lruPrevious = -1;
+				tileCacheEntryPtr->lruNext = gTileCacheMostRecentIndex;
+				gTileCacheEntryPtr[gTileCacheMostRecentIndex].lruPrevious = index;
+				gTileCacheMostRecentIndex = index;
+				
+				}	// end "if (index != gTileCacheMostRecentIndex)"
+			
+																		return (tileCacheEntryPtr);
+			
+			}	// end "if (tileCacheEntryPtr->fileIdentity == fileIdentity && ..."
+		
+		index = tileCacheEntryPtr->hashNext;
+		
+		}	// end "while (index >= 0)"
+		
+	return (NULL);
+	
+}	// end "FindTileCacheEntry"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 GetAreaRunsLineOfData
+//
+//	Software purpose:	The purpose of this routine is to read just the columns in
+//							the area runs for the requested line. Each run is read with
+//							a separate call to GetLineOfData. For a mask area, the samples
+//							for the runs with the requested mask value are packed 
+//							together the same as PackMaskData does. For a polygonal area,
+//							the samples for each run are placed where they would be for
+//							the full line; the samples outside of the runs are not 
+//							loaded. This is only used for BIS formatted output data.
+//
+//	Parameters in:		The same as GetLineOfData.
+//
+//	Parameters out:	Number of mask samples included in the buffer.
+//
+//	Value Returned:	Error code for file operations. 
+//
+// Called By:			GetLineOfData in SFileIO.cpp
+
+SInt16 GetAreaRunsLineOfData (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				UInt32								lineNumber, 
+				UInt32								columnStart, 
+				UInt32								columnEnd, 
+				UInt32								columnInterval,
+				HUCharPtr							fileIOBufferPtr, 
+				HUCharPtr							dataBufferPtr)
+
+{
+	HUCharPtr							runDataBufferPtr;
+	HUInt16Ptr							savedMaskBufferPtr;
+	HUInt32Ptr							lineRunIndexPtr;
+	MaskRunPtr							maskRunPtr;
+	
+	SInt32								columnOffset;
+	
+	UInt32								firstColumn,
+											lastColumn,
+											lineIndex,
+											numberOutputSamples,
+											numberRuns,
+											numberRunSamples,
+											run,
+											sampleBytes;
+	
+	SInt16								errCode,
+											numberBytes;
+	
+	Boolean								packFlag;
+	
+	
+	savedMaskBufferPtr = fileIOInstructionsPtr->maskBufferPtr;
+	numberRuns = 0;
+	maskRunPtr = NULL;
+	columnOffset = 0;
+	packFlag = FALSE;
+	
+	if (savedMaskBufferPtr != NULL)
+		{
+				// The runs for a mask are relative to the mask buffer.
+				
+		numberRuns = GetMaskLineRuns (
+							fileIOInstructionsPtr->maskInfoPtr,
+							GetMaskLine (fileIOInstructionsPtr->maskInfoPtr, savedMaskBufferPtr),
+							&maskRunPtr);
+							
+		columnOffset = 
+					(SInt32)columnStart - (SInt32)fileIOInstructionsPtr->maskColumnStart;
+		packFlag = TRUE;
+		
+		}	// end "if (savedMaskBufferPtr != NULL)"
+		
+	else	// savedMaskBufferPtr == NULL
+		{
+				// The runs for a polygonal area are for the image columns. Read the
+				// full line if it is not one of the lines that the runs are for.
+				
+		lineIndex = 
+				(lineNumber - fileIOInstructionsPtr->areaRunsLineStart) /
+															fileIOInstructionsPtr->areaRunsLineInterval;
+		
+		if (lineNumber < fileIOInstructionsPtr->areaRunsLineStart ||
+				(lineNumber - fileIOInstructionsPtr->areaRunsLineStart) % 
+									fileIOInstructionsPtr->areaRunsLineInterval != 0 ||
+						lineIndex >= fileIOInstructionsPtr->areaRunsNumberLines)
+			{
+			fileIOInstructionsPtr->areaRunsFlag = FALSE;
+			errCode = GetLineOfData (fileIOInstructionsPtr,
+												lineNumber,
+												columnStart,
+												columnEnd,
+												columnInterval,
+												fileIOBufferPtr,
+												dataBufferPtr);
+			fileIOInstructionsPtr->areaRunsFlag = TRUE;
+																						return (errCode);
+			
+			}	// end "if (lineNumber < fileIOInstructionsPtr->areaRunsLineStart || ..."
+		
+		lineRunIndexPtr = (HUInt32Ptr)GetHandlePointer (
+												fileIOInstructionsPtr->areaLineRunIndexHandle);
+		maskRunPtr = (MaskRunPtr)GetHandlePointer (
+												fileIOInstructionsPtr->areaRunsHandle);
+												
+		maskRunPtr = &maskRunPtr[lineRunIndexPtr[lineIndex]];
+		numberRuns = lineRunIndexPtr[lineIndex+1] - lineRunIndexPtr[lineIndex];
+		
+		}	// end "else savedMaskBufferPtr == NULL"
+		
+			// Get the number of bytes for each sample in the output buffer.
+			
+	numberBytes = fileIOInstructionsPtr->windowInfoPtr->localMaxNumberBytes;
+	if (fileIOInstructionsPtr->forceByteCode == kForce2Bytes)
+		numberBytes = 2;
+		
+	else if (fileIOInstructionsPtr->forceByteCode == kForce4Bytes || 
+							fileIOInstructionsPtr->forceByteCode == kForceReal4Bytes)
+		numberBytes = 4;
+		
+	else if (fileIOInstructionsPtr->forceByteCode == kForceReal8Bytes)
+		numberBytes = 8;
+		
+	sampleBytes = numberBytes * fileIOInstructionsPtr->numberChannels;
+	
+			// Read the columns for each run. The mask and run flag are turned off
+			// while the runs are read so that GetLineOfData reads the columns that
+			// are requested.
+	
+	fileIOInstructionsPtr->maskBufferPtr = NULL;
+	fileIOInstructionsPtr->areaRunsFlag = FALSE;
+	
+	errCode = noErr;
+	numberOutputSamples = 0;
+	for (run=0; run<numberRuns; run++)
+		{
+		if (packFlag && 
+				fileIOInstructionsPtr->maskValueRequest != 0 &&
+					maskRunPtr[run].maskValue != fileIOInstructionsPtr->maskValueRequest)
+			continue;
+			
+		numberRunSamples = GetMaskRunColumns (&maskRunPtr[run],
+															columnStart - columnOffset,
+															columnEnd - columnOffset,
+															columnInterval,
+															&firstColumn,
+															&lastColumn);
+															
+		if (numberRunSamples == 0)
+			continue;
+			
+		firstColumn += columnOffset;
+		lastColumn += columnOffset;
+		
+		if (packFlag)
+			runDataBufferPtr = &dataBufferPtr[numberOutputSamples * sampleBytes];
+			
+		else	// !packFlag
+			runDataBufferPtr = &dataBufferPtr[
+								(firstColumn - columnStart) / columnInterval * sampleBytes];
+		
+		errCode = GetLineOfData (fileIOInstructionsPtr,
+											lineNumber,
+											firstColumn,
+											lastColumn,
+											columnInterval,
+											fileIOBufferPtr,
+											runDataBufferPtr);
+											
+		if (errCode != noErr)
+			break;
+			
+		numberOutputSamples += numberRunSamples;
+		
+		}	// end "for (run=0; run<numberRuns; run++)"
+		
+	fileIOInstructionsPtr->maskBufferPtr = savedMaskBufferPtr;
+	fileIOInstructionsPtr->areaRunsFlag = TRUE;
+	
+	if (errCode == noErr && packFlag)
+		{
+		fileIOInstructionsPtr->numberOutputBufferSamples = numberOutputSamples;
+		
+		if (numberOutputSamples == 0)
+			errCode = kSkipLine;
+		
+		}	// end "if (errCode == noErr && packFlag)"
+	
+	return (errCode);
+	
+}	// end "GetAreaRunsLineOfData"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -5782,10 +7409,11 @@ SInt16 GetLine (
 	
 	CMFileStream*						fileStreamPtr;
 	HierarchalFileFormatPtr			hfaPtr = NULL;
-	HUCharPtr							readBufferPtr; 
+	HUCharPtr							mappedDataPtr = NULL,
+											readBufferPtr; 
 	
 	UInt32								channelStartIndex,
-											count,
+											count = 0,
 											readLineNumber,
 											segmentedEndOffset,
 											segmentedStartOffset;
@@ -5796,7 +7424,7 @@ SInt16 GetLine (
 		SInt16								hdfErrCode;
 	#endif		// include_hdf_capability
 			
-	Boolean								endHalfByte,	
+	Boolean								endHalfByte = FALSE,	
 											readLineFlag = TRUE;
 	
 	  	
@@ -5879,7 +7507,8 @@ SInt16 GetLine (
 			if (fileInfoPtr->gdalDataSetH != NULL)
 				{
 				int channelNumber4 = channelNumber + 1;
-				errCode = GetGDALLineOfData (fileInfoPtr,	
+				errCode = GetGDALLineOfData (NULL,
+														fileInfoPtr,	
 														readBufferPtr,
 														readLineNumber,
 														columnStart,
@@ -5898,7 +7527,7 @@ SInt16 GetLine (
 			if (!fileInfoPtr->callGetHDFLineFlag)
 		#endif	// !include_gdal_capability
 			{
-			if (gUseThreadedIOFlag)
+			if (GetThreadedIOFlag (fileIOInstructionsPtr))
 				{
 				errCode = GetLineFileIOThread (fileIOInstructionsPtr,
 															fileInfoPtr, 
@@ -5911,9 +7540,9 @@ SInt16 GetLine (
 															 
 				count = fileIOInstructionsPtr->count;
 				
-				}	// end "if (gUseThreadedIOFlag)"
+				}	// end "if (GetThreadedIOFlag (fileIOInstructionsPtr))"
 				
-			else	// !gUseThreadedIOFlag
+			else	// !GetThreadedIOFlag (fileIOInstructionsPtr)
 				{
 						// Get the relative position to start reading with respect to			
 						// the start of the file.					
@@ -5927,15 +7556,67 @@ SInt16 GetLine (
 															numberSamplesPtr,
 															&count,
 															&endHalfByte);
-															
-				errCode = MSetMarker (
+				
+						// Copy the data from the memory mapping of the file if it
+						// exists; otherwise read it from the file.
+				
+				#if defined multispec_wx
+					if (fileInfoPtr->dataCompressionCode == kNoCompression)
+						mappedDataPtr = fileStreamPtr->GetMappedDataPointer (posOff, count);
+				#endif	// defined multispec_wx
+				
+						// The line may also have been read as part of a block of lines
+						// by GetLinesOfData.
+						
+				if (mappedDataPtr == NULL && 
+										fileIOInstructionsPtr->linesBufferNumberRanges > 0)
+					mappedDataPtr = GetLinesBufferPointer (fileIOInstructionsPtr,
+																		fileStreamPtr,
+																		posOff,
+																		count);
+				
+				if (mappedDataPtr != NULL)
+					BlockMoveData (mappedDataPtr, readBufferPtr, count);
+					
+						// For compressed blocked files, the blocks are decompressed
+						// into the tiled buffer.
+				
+				else if (fileInfoPtr->blockedFlag && 
+								fileInfoPtr->dataCompressionCode != kNoCompression)
+					errCode = ReadCompressedBlocks (fileStreamPtr,
+																fileInfoPtr,
+																hfaPtr,
+																readLineNumber,
+																readBufferPtr);
+					
+						// For blocked files with the blocks stored contiguously for
+						// each block row, use the tile cache so that blocks do not
+						// need to be read again when the lines are not being read 
+						// sequentially.
+				
+				else if (fileInfoPtr->blockedFlag &&
+								fileInfoPtr->bandInterleave != kBSQ &&
+									hfaPtr->blockOffset > 0 &&
+										hfaPtr->blockOffset <= gTileCacheMaximumBytes)
+					errCode = ReadBlocksUsingTileCache (fileStreamPtr,
+																	fileInfoPtr,
+																	hfaPtr,
+																	readLineNumber,
+																	posOff,
+																	readBufferPtr);
+				
+				else	// mappedDataPtr == NULL && ...
+					{
+					errCode = MSetMarker (
 										fileStreamPtr, fsFromStart, posOff, kNoErrorMessages);
 
-				if (errCode == noErr)
-					errCode = MReadData (fileStreamPtr, 
-														&count, 
-														readBufferPtr, 
-														kNoErrorMessages);
+					if (errCode == noErr)
+						errCode = MReadData (fileStreamPtr, 
+															&count, 
+															readBufferPtr, 
+															kNoErrorMessages);
+					
+					}	// end "else mappedDataPtr == NULL && ..."
 														
 				if (errCode == noErr && fileInfoPtr->blockedFlag)
 					{
@@ -5948,7 +7629,7 @@ SInt16 GetLine (
 					
 					}	// end "if (errCode == noErr && fileInfoPtr->blockedFlag)"
 					
-				}	// end "else !gUseThreadedIOFlag" 
+				}	// end "else !GetThreadedIOFlag (fileIOInstructionsPtr)" 
 				
 			}	// end "else if (!fileInfoPtr->callGetHDFLineFlag)"
 		
@@ -6015,67 +7696,14 @@ SInt16 GetLine (
 			
 			}	// end "if (fileInfoPtr->format == kGAIAType && ...)" 
 				
-				// Swap the bytes if needed. 
-				
-		if (fileInfoPtr->swapBytesFlag && fileInfoPtr->numberBytes >= 2)
-			SwapBytes (fileInfoPtr->numberBytes,
-							fileIOBufferPtr,
-							*numberSamplesPtr);
-							
-		if (gConvertSignedDataFlag && 
-					fileInfoPtr->signedDataFlag &&
-							fileInfoPtr->gdalDataSetH == NULL)
-			AdjustSignedData (fileInfoPtr, fileIOBufferPtr, *numberSamplesPtr);
-
-				// If 4 bit data, convert to 8 bit data.									
-				
-		if (fileInfoPtr->numberBits == 4)
-			{
-			HPtr						byte1Ptr;
-			HPtr						byte2Ptr;
-			
-			UInt32					samplesLeft;
-	
-					// If number of samples is odd, convert the odd one and then	
-					// loop through the samples two at a time.							
-					// Note the lower sample number is in the lower 4 bits.			
-			
-			samplesLeft = *numberSamplesPtr;
-			byte1Ptr = (HPtr)&fileIOBufferPtr[samplesLeft-1];
-			byte2Ptr = (HPtr)&fileIOBufferPtr[count-1];
-			if (endHalfByte)
-				{
-				*byte1Ptr = *byte2Ptr & 0x0f;
-						
-				samplesLeft--;
-				byte1Ptr--;
-				byte2Ptr--;
-						
-				}	// end "if (halfByteFlag)" 
-				
-			while (samplesLeft >= 2)
-				{
-						// Move high 4 bits.														
-						
-				*byte1Ptr = (*byte2Ptr & 0xf0)>>4;
-				
-				samplesLeft--;
-				byte1Ptr--;
-				
-						// Move low 4 bits.														
-				
-				*byte1Ptr = *byte2Ptr & 0x0f;
-				
-				samplesLeft--;
-				byte1Ptr--;
-				byte2Ptr--;
+				// Swap the bytes, adjust signed data and convert 4 bit data to
+				// 8 bit data if needed.
 				
-				}	// end "while (samplesLeft >= 0)" 
-				
-			if (samplesLeft)
-				*byte1Ptr = (*byte2Ptr & 0xf0)>>4;
-			
-			}	// end "if (fileInfoPtr->numberBits..." 
+		AdjustReadData (fileInfoPtr,
+								fileIOBufferPtr,
+								*numberSamplesPtr,
+								count,
+								endHalfByte);
 			
 		}	// end "if (errCode == noErr)" 
 		
@@ -6086,6 +7714,70 @@ SInt16 GetLine (
 
 
 
+#if defined multispec_wx
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		HUCharPtr GetMappedLine
+//
+//	Software purpose:	The purpose of this routine is to return a pointer to the
+//							requested line and channel of image data in the memory 
+//							mapping of the file. This is the same data that GetLine would
+//							read into the io buffer. It is only used when the data do not 
+//							need to be changed in place (byte swapping, etc.) before 
+//							being packed.
+//
+//	Parameters in:				
+//
+//	Parameters out:	Number of samples in the line
+//
+//	Value Returned:	Pointer to the data or NULL if the data are not in the mapping.
+//
+// Called By:			GetLineOfData in SFileIO.cpp
+
+HUCharPtr GetMappedLine (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				FileInfoPtr							fileInfoPtr,
+				UInt32								lineNumber, 
+				SInt16								channelNumber,  
+				UInt32								columnStart, 
+				UInt32								columnEnd,
+				UInt32*								numberSamplesPtr)
+
+{
+	SInt64								posOff;
+	
+	CMFileStream*						fileStreamPtr;
+	
+	UInt32								count;
+	
+	Boolean								endHalfByte;
+	
+	
+	if (columnEnd < columnStart || lineNumber == 0 || columnEnd == 0)		
+																							return (NULL);
+																							
+	fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
+	if (fileStreamPtr == NULL)
+																							return (NULL);
+																							
+	posOff = GetFilePositionOffset (fileIOInstructionsPtr, 
+												fileInfoPtr, 
+												lineNumber, 
+												channelNumber, 
+												columnStart, 
+												columnEnd,
+												numberSamplesPtr,
+												&count,
+												&endHalfByte);
+	
+	return (fileStreamPtr->GetMappedDataPointer (posOff, count));
+	
+}	// end "GetMappedLine"
+#endif	// defined multispec_wx
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -6121,7 +7813,8 @@ SInt16 GetLineOfData (
 	FileInfoPtr							fileInfoPtr,
 											localFileInfoPtr;
 	
-	HUCharPtr							ioBufferPtr;
+	HUCharPtr							ioBufferPtr,
+											mappedBufferPtr;
 											
 	LayerInfoPtr						layerInfoPtr;
 	
@@ -6131,6 +7824,7 @@ SInt16 GetLineOfData (
 	
 	UInt32								bytesChannelOffset,
 											columnOffset,
+											factor,
 											fileNumberChannels,
 											index,
 											numberChannels,
@@ -6156,6 +7850,35 @@ SInt16 GetLineOfData (
 	
 	if (lineNumber <= 0  || fileIOBufferPtr == NULL)
 																							return (-1);
+	
+			// Read just the columns in the area runs for the line if they have been
+			// set up.
+			
+	if (fileIOInstructionsPtr->areaRunsFlag && 
+				dataBufferPtr != NULL && 
+						dataBufferPtr != fileIOBufferPtr)
+		return (GetAreaRunsLineOfData (fileIOInstructionsPtr,
+													lineNumber,
+													columnStart,
+													columnEnd,
+													columnInterval,
+													fileIOBufferPtr,
+													dataBufferPtr));
+	
+			// Convert the line and columns to those for the reduced resolution TIFF
+			// image if one is being read.
+			
+	if (fileIOInstructionsPtr->tiffOverviewFileInfoPtr != NULL)
+		{
+		factor = fileIOInstructionsPtr->tiffOverviewFactor;
+		
+		columnEnd = (columnStart - 1)/factor + 1 + 
+							((columnEnd - columnStart)/columnInterval) * (columnInterval/factor);
+		columnStart = (columnStart - 1)/factor + 1;
+		columnInterval /= factor;
+		lineNumber = (lineNumber - 1)/factor + 1;
+		
+		}	// end "if (fileIOInstructionsPtr->tiffOverviewFileInfoPtr != NULL)"
 		
 			// Initialize some local variables.												
 		
@@ -6190,7 +7913,8 @@ SInt16 GetLineOfData (
 																						
 	if (fileIOInstructionsPtr->maskBufferPtr != NULL)
 		{
-		if (!DetermineIfMaskDataInLine (fileIOInstructionsPtr->maskBufferPtr,
+		if (!DetermineIfMaskDataInLine (fileIOInstructionsPtr->maskInfoPtr,
+													fileIOInstructionsPtr->maskBufferPtr,
 													fileIOInstructionsPtr->maskColumnStart,
 													numberSamples,
 													columnInterval,
@@ -6274,9 +7998,44 @@ SInt16 GetLineOfData (
 		
 		}	// end "if (fileInfoPtr->gdalDataSetH != NULL)"
 	
+			// If the file is memory mapped and the line only needs to be packed,
+			// pack the data directly from the mapping instead of reading the
+			// line into the io buffer first. The channel loop is then skipped.
+	
+	index = 0;
+	mappedBufferPtr = NULL;
+	
+	#if defined multispec_wx
+		if (fileIOInstructionsPtr->mappedIOFlag && callPackLineOfDataFlag)
+			{
+			if (channelListPtr != NULL)
+				channel = channelListPtr[0];
+			
+			channel++;
+			fileInfoIndex = layerInfoPtr[channel].fileInfoIndex;
+			localFileInfoPtr = &fileInfoPtr[fileInfoIndex];
+			
+			mappedBufferPtr = GetMappedLine (fileIOInstructionsPtr,
+														localFileInfoPtr,
+														lineNumber,
+														layerInfoPtr[channel].fileChannelNumber-1,
+														columnStart,
+														columnEnd,
+														&numberSamplesRead);
+			
+			if (mappedBufferPtr != NULL)
+				{
+				fileIOBufferPtr = mappedBufferPtr;
+				fileNumberChannels = index = numberChannels;
+				
+				}	// end "if (mappedBufferPtr != NULL)"
+			
+			}	// end "if (fileIOInstructionsPtr->mappedIOFlag && ..."
+	#endif	// defined multispec_wx
+	
 			// Loop through the channels to be read in.									
 			
-	for (index=0; index<numberChannels; index++)
+	for (; index<numberChannels; index++)
 		{														
 		if (channelListPtr != NULL)
 			channel = channelListPtr[index];
@@ -6330,7 +8089,8 @@ SInt16 GetLineOfData (
 		#if include_gdal_capability
 			if (localFileInfoPtr->gdalDataSetH != NULL && useMultipleChannelGDALFlag)
 				{
-				errCode = GetGDALLineOfData (localFileInfoPtr,	
+				errCode = GetGDALLineOfData (fileIOInstructionsPtr,
+														localFileInfoPtr,	
 														ioBufferPtr,
 														lineNumber,
 														columnStart,
@@ -6440,6 +8200,7 @@ SInt16 GetLineOfData (
 							
 	if (fileIOInstructionsPtr->maskBufferPtr != NULL)
 		fileIOInstructionsPtr->numberOutputBufferSamples = PackMaskData (
+														fileIOInstructionsPtr->maskInfoPtr,
 														fileIOInstructionsPtr->maskBufferPtr,
 														fileIOInstructionsPtr->maskColumnStart,
 														numberChannels,
@@ -6455,45 +8216,487 @@ SInt16 GetLineOfData (
 
 
 
-#if include_gdal_capability
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Function name:		SInt32 GetGDALLineOfData
+//	Function name:		HUCharPtr GetLinesBufferPointer
 //
-//	Software purpose:	The purpose of this is to get a line(s) of data using the GDAL
-//							interface routines. This will also handle data that are tiled. 
-//							If the data are tiled (i.e. groups of lines are read), the 
-//							requested line and channels of data will be moved to the output
-//							io buffer. 
+//	Software purpose:	The purpose of this routine is to get a pointer to the data
+//							for the requested range of bytes in the file if they have
+//							been read into the lines buffer by GetLinesOfData.
 //
-//	Parameters in:		None
+//	Parameters in:		File IO instructions structure
+//							File stream pointer
+//							Position in the file of the first byte
+//							Number of bytes
 //
 //	Parameters out:	None
 //
-//	Value Returned:	None	
-// 
-// Called By:		
+// Value Returned:	Pointer to the data in the lines buffer or NULL if the bytes 
+//							are not in the lines buffer.
 //
-//	Coded By:			Larry L. Biehl			Date: 12/16/2009
-//	Revised By:			Larry L. Biehl			Date: 11/30/2018
-
-SInt16 GetGDALLineOfData (
-				FileInfoPtr							fileInfoPtr,	
-				HUCharPtr							ioBufferPtr,
-				UInt32								lineNumber,
-				UInt32								columnStart,
-				UInt32								columnEnd,
-				UInt32								numberChannels,
-				int*									gdalChannelListPtr,
-				UInt32*								numberSamplesReadPtr,
-				Boolean								oneReadFlag)
+// Called By:			GetLine in SFileIO.cpp
+
+HUCharPtr GetLinesBufferPointer (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				CMFileStream*						fileStreamPtr,
+				SInt64								posOff,
+				UInt32								count)
+
+{
+	LinesBufferRangePtr				linesBufferRangePtr;
+	
+	UInt32								index,
+											numberRanges,
+											rangeIndex;
+	
+	
+	numberRanges = fileIOInstructionsPtr->linesBufferNumberRanges;
+	rangeIndex = fileIOInstructionsPtr->linesBufferRangeIndex;
+	
+			// Start the search with the range last used since the requests will
+			// usually be for the same or next range.
+	
+	for (index=0; index<numberRanges; index++)
+		{
+		if (rangeIndex >= numberRanges)
+			rangeIndex = 0;
+			
+		linesBufferRangePtr = &fileIOInstructionsPtr->linesBufferRangePtr[rangeIndex];
+		
+		if (linesBufferRangePtr->fileStreamPtr == fileStreamPtr &&
+				posOff >= linesBufferRangePtr->filePosition &&
+					posOff + count <= linesBufferRangePtr->filePosition + 
+															linesBufferRangePtr->numberBytes)
+			{
+			fileIOInstructionsPtr->linesBufferRangeIndex = rangeIndex;
+			
+			return (&fileIOInstructionsPtr->linesBufferPtr[
+												linesBufferRangePtr->bufferOffset + 
+													(posOff - linesBufferRangePtr->filePosition)]);
+			
+			}	// end "if (linesBufferRangePtr->fileStreamPtr == fileStreamPtr && ..."
+			
+		rangeIndex++;
+		
+		}	// end "for (index=0; index<numberRanges; index++)"
+	
+	return (NULL);
+	
+}	// end "GetLinesBufferPointer"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 GetLinesOfData
+//
+//	Software purpose:	The purpose of this routine is to read a block of lines for
+//							the requested channels of image data into a buffer that has
+//							been provided. When possible, the bytes for the block of lines
+//							are read with one read for each contiguous range of bytes in
+//							the image file(s) instead of one read for each line and 
+//							channel. Each line is then packed the same way as it is by
+//							GetLineOfData.
+//
+//							Line k of the block is stored starting at 
+//							k*dataBufferLineBytes in the data buffer. The number of 
+//							samples per channel in line k is returned in 
+//							numberOutputSamplesPtr[k]. It will be 0 if the line was 
+//							skipped because there are no mask values in the line.
+//
+//							The mask buffer pointer in the file IO instructions structure
+//							is the same on return as it was on entry; the calling routine
+//							still needs to update it for each line.
+//
+//							The data buffer may be the same as the file IO buffer only
+//							when one line is requested, as happens for 8-byte BIS data
+//							when the calling routine reads one line at a time into its
+//							output buffer. The line is then read as it is by
+//							GetLineOfData.
+//
+//	Parameters in:		File IO instructions structure.
+//							First line, number of lines and line interval.
+//							First column, last column and column interval.
+//							File IO buffer large enough for one line.
+//							Data buffer large enough for lineCount lines.
+//							Number of bytes between lines in the data buffer.
+//
+//	Parameters out:	Number of samples per channel for each line.
+//
+//	Value Returned:	Error code for file operations. 
+//
+// Called By:			GetAreaStats in SMatrixUtilities.cpp
+//							ClassifyArea in SClassify.cpp
+//							ISODATAClusterPass in SClusterIsodata.cpp
+
+SInt16 GetLinesOfData (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				UInt32								lineStart, 
+				UInt32								lineCount,
+				UInt32								lineInterval,
+				UInt32								columnStart, 
+				UInt32								columnEnd, 
+				UInt32								columnInterval,
+				HUCharPtr							fileIOBufferPtr, 
+				HUCharPtr							dataBufferPtr,
+				UInt32								dataBufferLineBytes,
+				UInt32*								numberOutputSamplesPtr)
+
+{
+	HUInt16Ptr							savedMaskBufferPtr;
+	
+	UInt32								blockLineCount,
+											index,
+											line,
+											lineIndex,
+											numberSamples;
+	
+	SInt16								errCode = noErr;
+	
+	
+	if (lineStart <= 0 || 
+			lineCount == 0 || 
+				lineInterval == 0 ||
+					dataBufferPtr == NULL || 
+						(dataBufferPtr == fileIOBufferPtr && lineCount > 1) ||
+							numberOutputSamplesPtr == NULL ||
+								!fileIOInstructionsPtr->packDataFlag)
+																							return (-1);
+	
+	numberSamples = (columnEnd - columnStart + columnInterval)/columnInterval;
+	savedMaskBufferPtr = fileIOInstructionsPtr->maskBufferPtr;
+	
+	line = lineStart;
+	lineIndex = 0;
+	while (lineIndex < lineCount)
+		{
+				// Read as many of the remaining lines at one time as possible.
+				
+				// The lines are not read as a block when only the columns in the
+				// area runs are to be read.
+				
+		if (fileIOInstructionsPtr->areaRunsFlag)
+			blockLineCount = lineCount - lineIndex;
+			
+		else	// !fileIOInstructionsPtr->areaRunsFlag
+			blockLineCount = LoadLinesBuffer (fileIOInstructionsPtr,
+															line,
+															lineCount - lineIndex,
+															lineInterval,
+															columnStart,
+															columnEnd);
+		
+		for (index=0; index<blockLineCount; index++)
+			{
+			errCode = GetLineOfData (fileIOInstructionsPtr,
+												line,
+												columnStart,
+												columnEnd,
+												columnInterval,
+												fileIOBufferPtr,
+												dataBufferPtr);
+												
+			if (errCode < noErr)
+				break;
+				
+			numberOutputSamplesPtr[lineIndex] = 0;
+			if (errCode != kSkipLine)
+				{
+				numberOutputSamplesPtr[lineIndex] = numberSamples;
+				if (fileIOInstructionsPtr->maskBufferPtr != NULL)
+					numberOutputSamplesPtr[lineIndex] = 
+											fileIOInstructionsPtr->numberOutputBufferSamples;
+				
+				}	// end "if (errCode != kSkipLine)"
+				
+			errCode = noErr;
+			
+			if (fileIOInstructionsPtr->maskBufferPtr != NULL)
+				fileIOInstructionsPtr->maskBufferPtr += 
+											fileIOInstructionsPtr->numberMaskColumnsPerLine;
+			
+			dataBufferPtr += dataBufferLineBytes;
+			line += lineInterval;
+			lineIndex++;
+			
+			}	// end "for (index=0; index<blockLineCount; index++)"
+			
+				// Indicate that the lines buffer no longer contains valid data.
+			
+		fileIOInstructionsPtr->linesBufferNumberRanges = 0;
+		
+		if (errCode < noErr)
+			break;
+		
+		}	// end "while (lineIndex < lineCount)"
+		
+	fileIOInstructionsPtr->maskBufferPtr = savedMaskBufferPtr;
+	
+	return (errCode);
+	
+}	// end "GetLinesOfData"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		HUCharPtr GetLinesOfDataBuffer
+//
+//	Software purpose:	The purpose of this routine is to get memory for a data 
+//							buffer to be used with GetLinesOfData. The number of lines in 
+//							the buffer is limited by kMaxLinesOfDataBytes. The vector for 
+//							the number of output samples per line is stored at the end of 
+//							the same block of memory. The calling routine is responsible 
+//							for releasing the memory.
+//
+//	Parameters in:		Number of bytes for one line of output data.
+//							Number of lines to be read.
+//
+//	Parameters out:	Number of lines allowed for in the buffer.
+//							Pointer to the vector for the number of output samples per line.
+//
+// Value Returned:	Pointer to the data buffer or NULL if memory is not available.
+//
+// Called By:			GetAreaStats in SMatrixUtilities.cpp
+//							ClassifyArea in SClassify.cpp
+//							ISODATAClusterPass in SClusterIsodata.cpp
+
+HUCharPtr GetLinesOfDataBuffer (
+				UInt32								dataBufferLineBytes,
+				UInt32								numberLines,
+				UInt32*								numberBufferLinesPtr,
+				UInt32**								numberOutputSamplesPtrPtr)
+
+{
+	HUCharPtr							dataBufferPtr = NULL;
+	
+	SInt64								dataBufferBytes;
+	
+	UInt32								numberBufferLines;
+	
+	
+	*numberBufferLinesPtr = 0;
+	*numberOutputSamplesPtrPtr = NULL;
+	
+	if (dataBufferLineBytes == 0 || numberLines == 0)
+																						return (NULL);
+	
+	numberBufferLines = kMaxLinesOfDataBytes/dataBufferLineBytes;
+	numberBufferLines = MIN (numberBufferLines, numberLines);
+	numberBufferLines = MAX (numberBufferLines, 1);
+	
+			// Keep the vector for the number of samples on an 8-byte boundary.
+	
+	dataBufferBytes = (SInt64)numberBufferLines * dataBufferLineBytes;
+	dataBufferBytes = (dataBufferBytes + 7) & ~((SInt64)7);
+	
+	dataBufferPtr = (HUCharPtr)MNewPointer (
+								dataBufferBytes + (SInt64)numberBufferLines * sizeof (UInt32));
+	
+	if (dataBufferPtr != NULL)
+		{
+		*numberBufferLinesPtr = numberBufferLines;
+		*numberOutputSamplesPtrPtr = (UInt32*)&dataBufferPtr[dataBufferBytes];
+		
+		}	// end "if (dataBufferPtr != NULL)"
+	
+	return (dataBufferPtr);
+	
+}	// end "GetLinesOfDataBuffer"
+
+
+
+#if include_gdal_capability
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		HUCharPtr GetGDALBlockRowLinePointer
+//
+//	Software purpose:	The purpose of this routine is to return a pointer to the
+//							requested line in the gdal block row buffer. If the line is
+//							not in the buffer, the lines from the requested line to the
+//							end of the block row are read for all requested channels with
+//							one GDALDatasetRasterIO call. This keeps gdal from decoding
+//							the same block for each line in the block. The lines are
+//							stored band interleaved by line so that the data for a line
+//							are in the same order as a read of that one line.
+//
+//	Parameters in:		File IO instructions structure pointer.
+//							File information structure pointer.
+//							Handle to the gdal data set to be read.
+//							Line number (1-based) to be read.
+//							First column (0-based) to be read.
+//							Last column (0-based) to be read.
+//							Number of channels to be read.
+//							List of channels (1-based) requested.
+//							List of channels (1-based) to pass to gdal.
+//
+//	Parameters out:	Error code from gdal.
+//
+//	Value Returned:	Pointer to the line in the block row buffer. NULL if the block
+//							row buffer cannot be used for the data set or memory is not
+//							available for it.
+// 
+// Called By:			GetGDALLineOfData in SFileIO.cpp
+
+HUCharPtr GetGDALBlockRowLinePointer (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				FileInfoPtr							fileInfoPtr,
+				GDALDatasetH						hDS,
+				UInt32								lineNumber,
+				UInt32								gdalColumnStart,
+				UInt32								gdalColumnEnd,
+				UInt32								numberChannels,
+				int*									gdalChannelListPtr,
+				int*									rasterIOChannelListPtr,
+				SInt16*								errCodePtr)
+
+{
+	SInt64								numberBytes;
+	
+	UInt32								firstChannel,
+											lastLine,
+											lineBytes,
+											numberLines,
+											numberSamples;
+	
+	
+	*errCodePtr = noErr;
+	
+			// Only use the block row buffer if the data set is stored in blocks of
+			// more than one line and more than one line in the block will be used.
+	
+	if (fileInfoPtr->blockHeight <= 1 ||
+				fileIOInstructionsPtr->lineInterval >= (SInt32)fileInfoPtr->blockHeight)
+																						return (NULL);
+	
+	firstChannel = 1;
+	if (gdalChannelListPtr != NULL)
+		firstChannel = gdalChannelListPtr[0];
+	
+	numberSamples = gdalColumnEnd - gdalColumnStart + 1;
+	lineBytes = numberSamples * numberChannels * fileInfoPtr->numberBytes;
+	
+			// Check if the line is already in the buffer.
+	
+	if (fileIOInstructionsPtr->gdalBlockBufferPtr != NULL &&
+			fileIOInstructionsPtr->gdalBlockDataSetH == hDS &&
+				fileIOInstructionsPtr->gdalBlockFirstChannel == firstChannel &&
+					fileIOInstructionsPtr->gdalBlockNumberChannels == numberChannels &&
+						fileIOInstructionsPtr->gdalBlockColumnStart == gdalColumnStart &&
+							fileIOInstructionsPtr->gdalBlockColumnEnd == gdalColumnEnd &&
+								lineNumber >= fileIOInstructionsPtr->gdalBlockFirstLine &&
+									lineNumber <= fileIOInstructionsPtr->gdalBlockLastLine)
+		return (&fileIOInstructionsPtr->gdalBlockBufferPtr[
+							(SInt64)(lineNumber - fileIOInstructionsPtr->gdalBlockFirstLine) *
+																							lineBytes]);
+	
+			// Read from the requested line to the end of the block row.
+	
+	lastLine = ((lineNumber-1)/fileInfoPtr->blockHeight + 1) * fileInfoPtr->blockHeight;
+	lastLine = MIN (lastLine, fileInfoPtr->numberLines);
+	numberLines = lastLine - lineNumber + 1;
+	
+	numberBytes = (SInt64)numberLines * lineBytes;
+	if (numberBytes > kMaxLinesOfDataBytes)
+																						return (NULL);
+	
+			// Get memory for the block row buffer if needed.
+	
+	if (fileIOInstructionsPtr->gdalBlockBufferBytes < (UInt32)numberBytes)
+		{
+		fileIOInstructionsPtr->gdalBlockBufferPtr = (HUCharPtr)CheckAndDisposePtr (
+												(Ptr)fileIOInstructionsPtr->gdalBlockBufferPtr);
+		fileIOInstructionsPtr->gdalBlockBufferBytes = 0;
+		
+		fileIOInstructionsPtr->gdalBlockBufferPtr = (HUCharPtr)MNewPointer (numberBytes);
+		
+		if (fileIOInstructionsPtr->gdalBlockBufferPtr == NULL)
+																						return (NULL);
+		
+		fileIOInstructionsPtr->gdalBlockBufferBytes = (UInt32)numberBytes;
+		
+		}	// end "if (fileIOInstructionsPtr->gdalBlockBufferBytes < numberBytes)"
+	
+	fileIOInstructionsPtr->gdalBlockFirstLine = 0;
+	fileIOInstructionsPtr->gdalBlockLastLine = 0;
+	
+	*errCodePtr = GDALDatasetRasterIO (hDS,
+													GF_Read,
+													gdalColumnStart, 
+													lineNumber - 1, 
+													numberSamples, 
+													numberLines,
+													fileIOInstructionsPtr->gdalBlockBufferPtr, 
+													numberSamples, 
+													numberLines,
+													(GDALDataType)fileInfoPtr->gdalDataTypeCode,		
+													numberChannels, 
+													rasterIOChannelListPtr,
+													fileInfoPtr->numberBytes, 
+													lineBytes, 
+													numberSamples * fileInfoPtr->numberBytes);
+	
+	if (*errCodePtr != noErr)
+																						return (NULL);
+	
+	fileIOInstructionsPtr->gdalBlockDataSetH = hDS;
+	fileIOInstructionsPtr->gdalBlockFirstChannel = firstChannel;
+	fileIOInstructionsPtr->gdalBlockNumberChannels = numberChannels;
+	fileIOInstructionsPtr->gdalBlockColumnStart = gdalColumnStart;
+	fileIOInstructionsPtr->gdalBlockColumnEnd = gdalColumnEnd;
+	fileIOInstructionsPtr->gdalBlockFirstLine = lineNumber;
+	fileIOInstructionsPtr->gdalBlockLastLine = lastLine;
+	
+	return (fileIOInstructionsPtr->gdalBlockBufferPtr);
+	      
+}	// end "GetGDALBlockRowLinePointer" 
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt32 GetGDALLineOfData
+//
+//	Software purpose:	The purpose of this is to get a line(s) of data using the GDAL
+//							interface routines. This will also handle data that are tiled. 
+//							If the data are tiled (i.e. groups of lines are read), the 
+//							requested line and channels of data will be moved to the output
+//							io buffer. 
+//
+//	Parameters in:		None
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None	
+// 
+// Called By:		
+//
+//	Coded By:			Larry L. Biehl			Date: 12/16/2009
+//	Revised By:			Larry L. Biehl			Date: 11/30/2018
+
+SInt16 GetGDALLineOfData (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				FileInfoPtr							fileInfoPtr,	
+				HUCharPtr							ioBufferPtr,
+				UInt32								lineNumber,
+				UInt32								columnStart,
+				UInt32								columnEnd,
+				UInt32								numberChannels,
+				int*									gdalChannelListPtr,
+				UInt32*								numberSamplesReadPtr,
+				Boolean								oneReadFlag)
 
 {
 	HdfDataSets*						hdfDataSetsPtr = NULL;
 	HierarchalFileFormatPtr			hfaPtr = NULL;
 	
-	HUCharPtr							ioBlockBufferPtr,
+	HUCharPtr							blockLinePtr,
+											ioBlockBufferPtr,
 											readBufferPtr;
 											
 	int*									rasterIOChannelListPtr;
@@ -6514,7 +8717,8 @@ SInt16 GetGDALLineOfData (
 											
 	SInt16								errCode;
 											
-	Boolean								readLineFlag;
+	Boolean								chunkedLineReadFlag,
+											readLineFlag;
 	
 	
 			// Initialize local variables.
@@ -6556,7 +8760,15 @@ SInt16 GetGDALLineOfData (
 				
 		dataSetsIndex = fileInfoPtr->channelToHdfDataSetPtr[channelNumber-1];
 		
-		hDS = (GDALDatasetH)hdfDataSetsPtr[dataSetsIndex].sdid;
+				// The data set may not have been opened yet if the data set
+				// descriptions were read from the data set index file.
+				
+		hDS = GetGDALFileReference (fileInfoPtr->hdfHandle,
+												fileInfoPtr->numberHdfDataSets,
+												fileInfoPtr->format,
+												fileInfoPtr->gdalDataSetH,
+												hdfDataSetsPtr,
+												dataSetsIndex);
 		
 				// If this is part of a grouped set of data sets then each data set
 				// has only 1 channel.
@@ -6627,22 +8839,68 @@ SInt16 GetGDALLineOfData (
 				}	// end "if (oneReadFlag)"
 					
 			numberSamplesRead = gdalColumnEnd - gdalColumnStart + 1;
-					
-			errCode = GDALDatasetRasterIO (hDS,
-														GF_Read,
-														gdalColumnStart, 
-														gdalLineStart, 
-														numberSamplesRead, 
-														gdalNumberLines,
-														readBufferPtr, 
-														numberSamplesRead, 
-														gdalNumberLines,
-														(GDALDataType)fileInfoPtr->gdalDataTypeCode,		
-														numberChannels, 
-														rasterIOChannelListPtr,
-														0, 
-														0, 
-														0);	
+			
+					// If all requested channels are being read for the line, get the
+					// line from the block row buffer so that gdal does not need to
+					// decode the same blocks for each line.
+			
+			blockLinePtr = NULL;
+			chunkedLineReadFlag = FALSE;
+			
+					// Compressed hdf5 data sets are read directly with the hdf5 
+					// library one chunk row at a time so that each chunk is only
+					// decompressed once.
+			
+			#if include_hdf5_capability
+				if (fileInfoPtr->format == kHDF5Type &&
+						hdfDataSetsPtr != NULL &&
+							fileInfoPtr->dataCompressionCode != kNoCompression &&
+								!fileInfoPtr->blockedFlag)
+					chunkedLineReadFlag = ReadHDF5ChunkedLine (hDS,
+																	fileInfoPtr,
+																	lineNumber,
+																	gdalColumnStart,
+																	gdalColumnEnd,
+																	numberChannels,
+																	rasterIOChannelListPtr,
+																	readBufferPtr);
+			#endif	// include_hdf5_capability
+			
+			if (!chunkedLineReadFlag && 
+						fileIOInstructionsPtr != NULL && 
+							!fileInfoPtr->blockedFlag)
+				blockLinePtr = GetGDALBlockRowLinePointer (fileIOInstructionsPtr,
+																			fileInfoPtr,
+																			hDS,
+																			lineNumber,
+																			gdalColumnStart,
+																			gdalColumnEnd,
+																			numberChannels,
+																			gdalChannelListPtr,
+																			rasterIOChannelListPtr,
+																			&errCode);
+			
+			if (blockLinePtr != NULL)
+				BlockMoveData (blockLinePtr, 
+									readBufferPtr, 
+									numberChannels * numberSamplesRead * fileInfoPtr->numberBytes);
+					
+			else if (!chunkedLineReadFlag && errCode == noErr)
+				errCode = GDALDatasetRasterIO (hDS,
+															GF_Read,
+															gdalColumnStart, 
+															gdalLineStart, 
+															numberSamplesRead, 
+															gdalNumberLines,
+															readBufferPtr, 
+															numberSamplesRead, 
+															gdalNumberLines,
+															(GDALDataType)fileInfoPtr->gdalDataTypeCode,		
+															numberChannels, 
+															rasterIOChannelListPtr,
+															0, 
+															0, 
+															0);	
 			
 			if (errCode == noErr && fileInfoPtr->blockedFlag)
 				{
@@ -6823,6 +9081,66 @@ SInt32 GetParID (
 }	// end "GetParID"
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		UInt32 GetPostReadCode
+//
+//	Software purpose:	The purpose of this routine is to get the code for the 
+//							operations to be done on each line of data for the file after 
+//							it is read. This is the same set of conditions that GetLine 
+//							used to check for each line.
+//
+//	Parameters in:		File information pointer.
+//
+//	Parameters out:	None
+//
+// Value Returned:	Post read code.
+//
+// Called By:			AdjustReadData in SFileIO.cpp
+
+UInt32 GetPostReadCode (
+				FileInfoPtr							fileInfoPtr)
+
+{
+	UInt32								postReadCode;
+	
+	
+	postReadCode = 0;
+	
+	if (fileInfoPtr->swapBytesFlag)
+		{
+		if (fileInfoPtr->numberBytes == 2)
+			postReadCode |= kPostReadSwap2Bytes;
+			
+		else if (fileInfoPtr->numberBytes == 4)
+			postReadCode |= kPostReadSwap4Bytes;
+			
+		else if (fileInfoPtr->numberBytes == 8)
+			postReadCode |= kPostReadSwap8Bytes;
+			
+		}	// end "if (fileInfoPtr->swapBytesFlag)"
+							
+	if (gConvertSignedDataFlag && 
+				fileInfoPtr->signedDataFlag &&
+						fileInfoPtr->gdalDataSetH == NULL)
+		{
+		if (fileInfoPtr->numberBytes == 1)
+			postReadCode |= kPostReadAdjustSigned1Byte;
+			
+		else if (fileInfoPtr->numberBytes == 2)
+			postReadCode |= kPostReadAdjustSigned2Bytes;
+			
+		}	// end "if (gConvertSignedDataFlag && ..."
+		
+	if (fileInfoPtr->numberBits == 4)
+		postReadCode |= kPostReadUnpack4Bits;
+	
+	return (postReadCode);
+	
+}	// end "GetPostReadCode"
+
+
 
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
@@ -6904,6 +9222,157 @@ SInt16 GetShortIntValue (
 }	// end "GetShortIntValue"
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean GetSIMDConversionBytes
+//
+//	Software purpose:	The purpose of this routine is to get the number of bytes for
+//							the input and output samples for a data conversion code and to
+//							indicate whether the conversion is handled by the SIMD routines.
+//							The byte codes in the data conversion code are 0x0080 for 
+//							1 byte, 0x0100 for 2 bytes, 0x0200 for 4 bytes and 0x0400 for
+//							8 bytes. The low bits hold the sign/real code.
+//
+//	Parameters in:		Data conversion code.
+//
+//	Parameters out:	Number of bytes for input samples.
+//							Number of bytes for output samples.
+//
+// Value Returned:	TRUE if the conversion is handled by the SIMD routines.
+//
+// Called By:			ConvertDataSamples in SFileIO.cpp
+//							ConvertDataSamplesAVX2 in SFileIO.cpp
+//							ConvertDataSamplesSSE41 in SFileIO.cpp
+//							PackNonBISDataUsingSIMD in SFileIO.cpp
+
+Boolean GetSIMDConversionBytes (
+				UInt32								dataConversionCode,
+				UInt32*								inputBytesPtr,
+				UInt32*								outputBytesPtr)
+
+{
+	*inputBytesPtr = ((dataConversionCode >> 16) & 0x00000780) >> 7;
+	*outputBytesPtr = (dataConversionCode & 0x00000780) >> 7;
+	
+	switch (dataConversionCode)
+		{
+		case k8BitTo8Bit:
+		case k8BitIntSignedTo16BitIntSigned:
+		case k8BitIntUnsignedTo16BitIntUnsigned:
+		case k8BitIntUnsignedTo16BitIntSigned:
+		case k8BitIntSignedTo32BitIntSigned:
+		case k8BitIntUnsignedTo32BitIntUnsigned:
+		case k8BitIntUnsignedTo32BitIntSigned:
+		case k8BitIntSignedTo32BitReal:
+		case k8BitIntUnsignedTo32BitReal:
+		case k8BitIntSignedTo64BitReal:
+		case k8BitIntUnsignedTo64BitReal:
+		case k16BitTo16Bit:
+		case k16BitIntSignedTo32BitIntSigned:
+		case k16BitIntUnsignedTo32BitIntUnsigned:
+		case k16BitIntUnsignedTo32BitIntSigned:
+		case k16BitIntSignedTo32BitReal:
+		case k16BitIntUnsignedTo32BitReal:
+		case k16BitIntSignedTo64BitReal:
+		case k16BitIntUnsignedTo64BitReal:
+		case k32BitTo32Bit:
+		case k32BitIntSignedTo32BitReal:
+		case k32BitIntUnsignedTo32BitReal:
+		case k32BitIntSignedTo64BitReal:
+		case k32BitIntUnsignedTo64BitReal:
+		case k32BitRealTo64BitReal:
+		case k64BitTo64Bit:
+		case k64BitRealTo32BitReal:
+			return (TRUE);
+			
+		}	// end "switch (dataConversionCode)"
+		
+	return (FALSE);
+	
+}	// end "GetSIMDConversionBytes"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 GetSIMDLevel
+//
+//	Software purpose:	The purpose of this routine is to get the level of SIMD 
+//							instructions to be used for packing and converting lines of
+//							data. The processor is checked the first time this routine is
+//							called. The level can be set to kSIMDNone ahead of time to 
+//							force the scalar code to be used.
+//
+//	Parameters in:		None
+//
+//	Parameters out:	None
+//
+// Value Returned:	kSIMDNone, kSIMDSSE41 or kSIMDAVX2
+//
+// Called By:			ConvertDataSamples in SFileIO.cpp
+//							PackNonBISDataUsingSIMD in SFileIO.cpp
+
+SInt16 GetSIMDLevel (void)
+
+{
+	#if include_simd_capability
+		SInt16								simdLevel;
+		
+		#if defined _MSC_VER
+			int									cpuInfo[4];
+			
+			int									maxFunctionId;
+		#endif	// defined _MSC_VER
+		
+		
+		if (gSIMDLevel < 0)
+			{
+			simdLevel = kSIMDNone;
+			
+			#if defined _MSC_VER
+				__cpuid (cpuInfo, 0);
+				maxFunctionId = cpuInfo[0];
+				
+				__cpuid (cpuInfo, 1);
+				if (cpuInfo[2] & 0x00080000)
+					simdLevel = kSIMDSSE41;
+					
+						// AVX2 also requires that the operating system saves the 256-bit
+						// registers (OSXSAVE and AVX bits and XCR0 bits 1 and 2).
+						
+				if (simdLevel == kSIMDSSE41 && 
+						maxFunctionId >= 7 &&
+							(cpuInfo[2] & 0x18000000) == 0x18000000 &&
+								(_xgetbv (0) & 0x00000006) == 0x00000006)
+					{
+					__cpuidex (cpuInfo, 7, 0);
+					if (cpuInfo[1] & 0x00000020)
+						simdLevel = kSIMDAVX2;
+					
+					}	// end "if (simdLevel == kSIMDSSE41 && ..."
+			#else	// !defined _MSC_VER
+				__builtin_cpu_init ();
+				if (__builtin_cpu_supports ("sse4.1"))
+					simdLevel = kSIMDSSE41;
+					
+				if (simdLevel == kSIMDSSE41 && __builtin_cpu_supports ("avx2"))
+					simdLevel = kSIMDAVX2;
+			#endif	// defined _MSC_VER, else
+			
+			gSIMDLevel = simdLevel;
+			
+			}	// end "if (gSIMDLevel < 0)"
+		
+		return (gSIMDLevel);
+	#else	// !include_simd_capability
+		return (kSIMDNone);
+	#endif	// include_simd_capability, else
+	
+}	// end "GetSIMDLevel"
+
+
 
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
@@ -7238,6 +9707,144 @@ SInt16 GetThematicSupportFileToCreate (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean GetThreadedIOFlag
+//
+//	Software purpose:	The purpose of this routine is to determine whether the lines
+//							for the specified file IO instructions are read on a separate
+//							thread. In the wx versions this is true only when the read-ahead
+//							pipeline was created for these instructions; gUseThreadedIOFlag
+//							may have been set for another set of instructions that is
+//							active at the same time.
+//
+//	Parameters in:		File IO instructions pointer.
+//
+//	Parameters out:	None
+//
+// Value Returned:	TRUE if the lines are read on a separate thread.
+//
+// Called By:			ClassifyPerPointArea in SClassify.cpp
+//							GetLine in SFileIO.cpp
+//							LoadLinesBuffer in SFileIO.cpp
+//							SetUpAreaColumnRuns in SFileIO.cpp
+
+Boolean GetThreadedIOFlag (
+				FileIOInstructionsPtr			fileIOInstructionsPtr)
+
+{
+	#if defined multispec_wx
+		return (fileIOInstructionsPtr->prefetchPtr != NULL);
+	#else	// !defined multispec_wx
+		return (gUseThreadedIOFlag);
+	#endif	// defined multispec_wx
+
+}	// end "GetThreadedIOFlag"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		UInt64 GetTileCacheFileIdentity
+//
+//	Software purpose:	The purpose of this routine is to get the value that
+//							identifies the file represented by the input file stream in
+//							the tile cache. It is a 64-bit FNV-1a hash of the full path
+//							name of the file (of the file system reference on the Mac) so
+//							that all file streams for the same file share the blocks in
+//							the cache.
+//		
+//	Parameters in:		File stream pointer.
+//
+//	Parameters out:	None
+//
+// Value Returned:	File identity.
+//
+// Called By:			ReadBlocksUsingTileCache in SFileIO.cpp
+//							ReadCompressedBlocks in SFileIO.cpp
+//							ReleaseTileCacheEntries in SFileIO.cpp
+
+UInt64 GetTileCacheFileIdentity (
+				CMFileStream*						fileStreamPtr)
+
+{
+	UInt64								fileIdentity;
+	
+	UCharPtr								identityPtr;
+	
+	UInt32								index,
+											numberBytes;
+	
+	
+	#if defined multispec_mac
+		identityPtr = (UCharPtr)&fileStreamPtr->fsRef;
+		numberBytes = sizeof (FSRef);
+	#endif	// defined multispec_mac
+	
+	#if defined multispec_win || defined multispec_wx
+		identityPtr = (UCharPtr)GetFilePathPPointerFromFileStream (fileStreamPtr,
+																					kReturnASCII);
+		numberBytes = GetFileStringLength (identityPtr);
+		identityPtr = &identityPtr[2];
+	#endif	// defined multispec_win || defined multispec_wx
+	
+	fileIdentity = 14695981039346656037ULL;
+	for (index=0; index<numberBytes; index++)
+		{
+		fileIdentity ^= identityPtr[index];
+		fileIdentity *= 1099511628211ULL;
+		
+		}	// end "for (index=0; index<numberBytes; index++)"
+	
+	return (fileIdentity);
+	
+}	// end "GetTileCacheFileIdentity"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		UInt32 GetTileCacheHashIndex
+//
+//	Software purpose:	The purpose of this routine is to get the index of the hash
+//							bucket in the tile cache for the input block.
+//		
+//	Parameters in:		Identity of the file the block was read from.
+//							Index of hfa structure for the channel.
+//							Block row and column (0-based) of the block.
+//
+//	Parameters out:	None
+//
+// Value Returned:	Index of the hash bucket.
+//
+// Called By:			AddTileCacheEntry in SFileIO.cpp
+//							FindTileCacheEntry in SFileIO.cpp
+//							ReleaseTileCacheEntry in SFileIO.cpp
+
+UInt32 GetTileCacheHashIndex (
+				UInt64								fileIdentity,
+				UInt32								hfaIndex,
+				UInt32								blockRow,
+				UInt32								blockColumn)
+
+{
+	UInt64								hashValue;
+	
+	
+	hashValue = fileIdentity;
+	hashValue = (hashValue ^ hfaIndex) * 1099511628211ULL;
+	hashValue = (hashValue ^ blockRow) * 1099511628211ULL;
+	hashValue = (hashValue ^ blockColumn) * 1099511628211ULL;
+	
+	return ((UInt32)(hashValue ^ (hashValue >> 32)) & (kTileCacheHashSize - 1));
+	
+}	// end "GetTileCacheHashIndex"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -7683,6 +10290,10 @@ CMFileStream* InitializeFileStream (
 		if (fileStreamPtr == NULL) 
 			fileStreamPtr = (CMFileStream*)MNewPointer (sizeof (CMFileStream));
 			
+		else	// fileStreamPtr != NULL
+					// Release any blocks for the previous file in the tile cache.
+			ReleaseTileCacheEntries (fileStreamPtr);
+			
 		if (fileStreamPtr != NULL)
 			{      
 					// Initialize the  structure.			
@@ -8683,76 +11294,538 @@ SInt16 LoadGroupInformationBuffers (
 		
 		}	// end "if (fileInfoPtr->numberGroups > 0 && displaySpecsH != NULL)"
 		
-	if (colorSpecPtr != NULL)
-		{
-		if (asciiSymbolsFlag)
-			numberClasses = numberClassSymbols;
+	if (colorSpecPtr != NULL)
+		{
+		if (asciiSymbolsFlag)
+			numberClasses = numberClassSymbols;
+		
+		//classSymbolIndex = 0;
+		for (classIndex=0; classIndex<numberClasses; classIndex++)
+			{
+			listAllGroupInfoPtr[classIndex] = FALSE;
+			
+			classNumber = classIndex;
+			if (asciiSymbolsFlag)
+				classNumber = classSymbolPtr[classIndex];
+			
+					// Note that if the thematic file is a MultiSpec classification file (has
+					// ascii symbols) then the class symbol vector contains those symbols and
+					// does not reflect whether the classNumber is being used or not. Assume 
+					// for this case that it is being used.
+			/*
+			if (classNumber == classSymbolPtr[classSymbolIndex] ||
+											fileInfoPtr->format == kMultiSpecClassificationType)
+			if (classSymbolPtr == NULL ||
+						asciiSymbolsFlag ||
+								classNumber == classSymbolPtr[classSymbolIndex])
+				{
+				groupNumber = classToGroupPtr[classSymbolIndex];
+			*/
+			groupNumber = classToGroupPtr[classIndex];
+				//if (groupToPalettePtr[groupNumber] == classSymbolIndex)
+			if (groupToPalettePtr[groupNumber] == classIndex)
+				{
+				listAllGroupInfoPtr[classIndex] = TRUE;
+				
+						// Order is green, red, blue to be consistant with that in the ERDAS
+						// trailer file.
+				
+				#ifndef multispec_wx
+					groupColorTablePtr[groupNumber].red =
+														(colorSpecPtr[classIndex].rgb.red >> 8);
+					groupColorTablePtr[groupNumber].green =
+														(colorSpecPtr[classIndex].rgb.green >> 8);
+					groupColorTablePtr[groupNumber].blue =
+														(colorSpecPtr[classIndex].rgb.blue >> 8);
+				#else
+					groupColorTablePtr[groupNumber].red =
+														colorSpecPtr[classIndex].rgb.red;
+					groupColorTablePtr[groupNumber].green =
+														colorSpecPtr[classIndex].rgb.green;
+					groupColorTablePtr[groupNumber].blue =
+														colorSpecPtr[classIndex].rgb.blue;
+				#endif
+					
+				}	// end "if (groupToPalettePtr[groupNumber] == classIndex)"
+				
+				//if (classSymbolIndex < numberClassSymbols-1)
+				//	classSymbolIndex++;
+					
+				//}	// end "if (classNumber == classSymbolPtr[classSymbolIndex] || ...)"
+			
+			}	// end "for (classIndex=0; classIndex<..."
+		
+		numberGroups = fileInfoPtr->numberGroups;
+		
+		CheckAndUnlockHandle ((Handle)groupCTableHandle);
+		
+		}	// end "if (colorSpecPtr != NULL)"
+	
+	return (numberGroups);
+
+}	// end "LoadGroupInformationBuffers"  
+
+
+#if include_simd_capability
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		__m256i LoadInt32ValuesAVX2
+//
+//	Software purpose:	The purpose of this routine is to load kSIMDPackSamples 8, 16
+//							or 32-bit integer samples and expand them to 32-bit integers
+//							in an AVX2 register.
+//
+//	Parameters in:		Input byte and sign code (upper half of data conversion code).
+//							Pointer to the input samples.
+//
+//	Parameters out:	None
+//
+// Value Returned:	The 32-bit integer values.
+//
+// Called By:			ConvertDataSamplesAVX2 in SFileIO.cpp
+
+SIMD_TARGET_AVX2
+inline __m256i LoadInt32ValuesAVX2 (
+				UInt32								inputCode,
+				HUCharPtr							inputPtr)
+
+{
+	switch (inputCode)
+		{
+		case 0x00000081:		// 8-bit signed
+			return (_mm256_cvtepi8_epi32 (_mm_loadl_epi64 ((__m128i*)inputPtr)));
+			
+		case 0x00000080:		// 8-bit unsigned
+			return (_mm256_cvtepu8_epi32 (_mm_loadl_epi64 ((__m128i*)inputPtr)));
+			
+		case 0x00000101:		// 16-bit signed
+			return (_mm256_cvtepi16_epi32 (_mm_loadu_si128 ((__m128i*)inputPtr)));
+			
+		case 0x00000100:		// 16-bit unsigned
+			return (_mm256_cvtepu16_epi32 (_mm_loadu_si128 ((__m128i*)inputPtr)));
+			
+		}	// end "switch (inputCode)"
+	
+			// 32-bit integer
+			
+	return (_mm256_loadu_si256 ((__m256i*)inputPtr));
+	
+}	// end "LoadInt32ValuesAVX2"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void LoadInt32ValuesSSE41
+//
+//	Software purpose:	The purpose of this routine is to load kSIMDPackSamples 8, 16
+//							or 32-bit integer samples and expand them to 32-bit integers
+//							in two SSE registers.
+//
+//	Parameters in:		Input byte and sign code (upper half of data conversion code).
+//							Pointer to the input samples.
+//
+//	Parameters out:	The 32-bit integer values for the first and second half of the
+//							samples.
+//
+// Value Returned:	None
+//
+// Called By:			ConvertDataSamplesSSE41 in SFileIO.cpp
+
+SIMD_TARGET_SSE41
+inline void LoadInt32ValuesSSE41 (
+				UInt32								inputCode,
+				HUCharPtr							inputPtr,
+				__m128i*								lowValuesPtr,
+				__m128i*								highValuesPtr)
+
+{
+	__m128i								values;
+	
+	
+	switch (inputCode)
+		{
+		case 0x00000081:		// 8-bit signed
+			values = _mm_loadl_epi64 ((__m128i*)inputPtr);
+			*lowValuesPtr = _mm_cvtepi8_epi32 (values);
+			*highValuesPtr = _mm_cvtepi8_epi32 (_mm_srli_si128 (values, 4));
+			break;
+			
+		case 0x00000080:		// 8-bit unsigned
+			values = _mm_loadl_epi64 ((__m128i*)inputPtr);
+			*lowValuesPtr = _mm_cvtepu8_epi32 (values);
+			*highValuesPtr = _mm_cvtepu8_epi32 (_mm_srli_si128 (values, 4));
+			break;
+			
+		case 0x00000101:		// 16-bit signed
+			values = _mm_loadu_si128 ((__m128i*)inputPtr);
+			*lowValuesPtr = _mm_cvtepi16_epi32 (values);
+			*highValuesPtr = _mm_cvtepi16_epi32 (_mm_srli_si128 (values, 8));
+			break;
+			
+		case 0x00000100:		// 16-bit unsigned
+			values = _mm_loadu_si128 ((__m128i*)inputPtr);
+			*lowValuesPtr = _mm_cvtepu16_epi32 (values);
+			*highValuesPtr = _mm_cvtepu16_epi32 (_mm_srli_si128 (values, 8));
+			break;
+			
+		default:					// 32-bit integer
+			*lowValuesPtr = _mm_loadu_si128 ((__m128i*)inputPtr);
+			*highValuesPtr = _mm_loadu_si128 ((__m128i*)&inputPtr[16]);
+			break;
+			
+		}	// end "switch (inputCode)"
+	
+}	// end "LoadInt32ValuesSSE41"
+#endif	// include_simd_capability
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		UInt32 LoadLinesBuffer
+//
+//	Software purpose:	The purpose of this routine is to read the bytes for a block
+//							of lines into the lines buffer with one read for each 
+//							contiguous range of bytes in the image file(s). The number of
+//							lines is reduced if needed to keep the number of bytes read
+//							within kMaxLinesOfDataBytes. Nothing is read if the lines 
+//							cannot be read as a block; GetLine will then read each line 
+//							as usual. For linked image files in the wx versions, the 
+//							ranges for the different files are read concurrently.
+//
+//	Parameters in:		File IO instructions structure
+//							First line, number of lines and line interval
+//							First and last column
+//
+//	Parameters out:	None
+//
+// Value Returned:	Number of lines to be processed before the lines buffer needs 
+//							to be loaded again.
+//
+// Called By:			GetLinesOfData in SFileIO.cpp
+
+UInt32 LoadLinesBuffer (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				UInt32								lineStart,
+				UInt32								numberLines,
+				UInt32								lineInterval,
+				UInt32								columnStart,
+				UInt32								columnEnd)
+
+{
+	LinesBufferRangePtr				linesBufferRangePtr;
+	
+	SInt64								numberBytes;
+	
+	UInt32								count,
+											index;
+	
+	SInt16								errCode = noErr;
+	
+	Boolean								concurrentReadFlag;
+	
+	
+	fileIOInstructionsPtr->linesBufferNumberRanges = 0;
+	
+			// Lines that are read on a separate thread or directly from a memory
+			// mapping of the file are not read as a block.
+	
+	if (numberLines <= 1 || 
+			GetThreadedIOFlag (fileIOInstructionsPtr) || 
+				fileIOInstructionsPtr->mappedIOFlag)
+																				return (numberLines);
+	
+			// Get the list of file byte ranges for the lines. Allow for one range
+			// per channel.
+	
+	if (fileIOInstructionsPtr->linesBufferMaxRanges < 
+															fileIOInstructionsPtr->numberChannels)
+		{
+		fileIOInstructionsPtr->linesBufferRangePtr = 
+							(LinesBufferRangePtr)CheckAndDisposePtr (
+												(Ptr)fileIOInstructionsPtr->linesBufferRangePtr);
+		fileIOInstructionsPtr->linesBufferMaxRanges = 0;
+												
+		fileIOInstructionsPtr->linesBufferRangePtr = (LinesBufferRangePtr)MNewPointer (
+				fileIOInstructionsPtr->numberChannels * sizeof (LinesBufferRange));
+				
+		if (fileIOInstructionsPtr->linesBufferRangePtr == NULL)
+																				return (numberLines);
+																				
+		fileIOInstructionsPtr->linesBufferMaxRanges = 
+															fileIOInstructionsPtr->numberChannels;
+		
+		}	// end "if (fileIOInstructionsPtr->linesBufferMaxRanges < ..."
+	
+	do
+		{
+		numberBytes = LoadLinesBufferRanges (fileIOInstructionsPtr,
+															lineStart,
+															lineStart + (numberLines-1)*lineInterval,
+															columnStart,
+															columnEnd);
+		
+		if (numberBytes < 0)
+																				return (numberLines);
+		
+		if (numberBytes <= kMaxLinesOfDataBytes)
+			break;
+			
+		numberLines /= 2;
+		
+		}	while (numberLines > 1);
+		
+	if (numberLines <= 1)
+		{
+		fileIOInstructionsPtr->linesBufferNumberRanges = 0;
+																				return (numberLines);
+																				
+		}	// end "if (numberLines <= 1)"
+		
+	concurrentReadFlag = FALSE;
+	#if defined multispec_wx
+		concurrentReadFlag = (fileIOInstructionsPtr->linkedFilesConcurrentIOFlag &&
+											fileIOInstructionsPtr->linesBufferNumberRanges > 1);
+	#endif	// defined multispec_wx
+		
+			// Get memory for the lines buffer if needed.
+		
+	if (fileIOInstructionsPtr->linesBufferBytes < (UInt32)numberBytes)
+		{
+		fileIOInstructionsPtr->linesBufferPtr = (HUCharPtr)CheckAndDisposePtr (
+														(Ptr)fileIOInstructionsPtr->linesBufferPtr);
+		fileIOInstructionsPtr->linesBufferBytes = 0;
+		
+		fileIOInstructionsPtr->linesBufferPtr = (HUCharPtr)MNewPointer (numberBytes);
+		
+		if (fileIOInstructionsPtr->linesBufferPtr == NULL)
+			{
+			fileIOInstructionsPtr->linesBufferNumberRanges = 0;
+																				return (numberLines);
+			
+			}	// end "if (fileIOInstructionsPtr->linesBufferPtr == NULL)"
+			
+		fileIOInstructionsPtr->linesBufferBytes = (UInt32)numberBytes;
+		
+		}	// end "if (fileIOInstructionsPtr->linesBufferBytes < numberBytes)"
+	
+			// Read each range with one read. The ranges for linked files are read
+			// concurrently so that the latency of the reads for the different files
+			// overlap.
+	
+	#if defined multispec_wx
+		if (concurrentReadFlag)
+			{
+			RunTasksInParallel (fileIOInstructionsPtr->linesBufferNumberRanges, 
+										ReadLinesBufferRange, 
+										fileIOInstructionsPtr);
+			
+			for (index=0; index<fileIOInstructionsPtr->linesBufferNumberRanges; index++)
+				{
+				errCode = fileIOInstructionsPtr->linesBufferRangePtr[index].errCode;
+				if (errCode != noErr)
+					break;
+				
+				}	// end "for (index=0; index<...->linesBufferNumberRanges; index++)"
+			
+			}	// end "if (concurrentReadFlag)"
+	#endif	// defined multispec_wx
+	
+	for (index=0; 
+			!concurrentReadFlag && index<fileIOInstructionsPtr->linesBufferNumberRanges; 
+				index++)
+		{
+		linesBufferRangePtr = &fileIOInstructionsPtr->linesBufferRangePtr[index];
+		
+		errCode = MSetMarker (linesBufferRangePtr->fileStreamPtr, 
+										fsFromStart, 
+										linesBufferRangePtr->filePosition, 
+										kNoErrorMessages);
+
+		count = linesBufferRangePtr->numberBytes;
+		if (errCode == noErr)
+			errCode = MReadData (
+						linesBufferRangePtr->fileStreamPtr, 
+						&count, 
+						&fileIOInstructionsPtr->linesBufferPtr[
+																linesBufferRangePtr->bufferOffset], 
+						kNoErrorMessages);
+						
+		if (errCode != noErr)
+			break;
+		
+		}	// end "for (index=0; index<...->linesBufferNumberRanges; index++)"
+		
+			// If an error occurred, let GetLine read the lines one at a time so 
+			// that the error is handled as it normally is.
+		
+	if (errCode != noErr)
+		fileIOInstructionsPtr->linesBufferNumberRanges = 0;
+		
+	fileIOInstructionsPtr->linesBufferRangeIndex = 0;
+	
+	return (numberLines);
+	
+}	// end "LoadLinesBuffer"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt64 LoadLinesBufferRanges
+//
+//	Software purpose:	The purpose of this routine is to load the list of contiguous
+//							ranges of bytes in the image file(s) that include the 
+//							requested lines and channels. Overlapping ranges for the same
+//							file, such as for BIL and BIS files, are merged.
+//
+//	Parameters in:		File IO instructions structure
+//							First and last line
+//							First and last column
+//
+//	Parameters out:	None
+//
+// Value Returned:	Total number of bytes in the ranges or -1 if the lines cannot 
+//							be read as a block.
+//
+// Called By:			LoadLinesBuffer in SFileIO.cpp
+
+SInt64 LoadLinesBufferRanges (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				UInt32								lineStart,
+				UInt32								lineEnd,
+				UInt32								columnStart,
+				UInt32								columnEnd)
+
+{
+	SInt64								firstPosition,
+											lastPosition,
+											numberBytes;
+	
+	CMFileStream*						fileStreamPtr;
+	FileInfoPtr							localFileInfoPtr;
+	LayerInfoPtr						layerInfoPtr;
+	LinesBufferRangePtr				linesBufferRangePtr;
+	
+	UInt32								channel,
+											count,
+											index,
+											numberRanges,
+											numberSamples;
+	
+	SInt16								fileChannelNumber;
+	
+	Boolean								endHalfByte;
+	
+	
+	layerInfoPtr = fileIOInstructionsPtr->layerInfoPtr;
+	numberRanges = 0;
+	numberBytes = 0;
+	linesBufferRangePtr = NULL;
+	
+	for (index=0; index<fileIOInstructionsPtr->numberChannels; index++)
+		{
+		channel = index;
+		if (fileIOInstructionsPtr->channelListPtr != NULL)
+			channel = fileIOInstructionsPtr->channelListPtr[index];
+		channel++;
+		
+		localFileInfoPtr = 
+					&fileIOInstructionsPtr->fileInfoPtr[layerInfoPtr[channel].fileInfoIndex];
+		fileChannelNumber = (SInt16)(layerInfoPtr[channel].fileChannelNumber - 1);
+		
+				// Only data that GetLine reads directly from the file can be read as
+				// a block.
+				
+		if (localFileInfoPtr->gdalDataSetH != NULL ||
+				localFileInfoPtr->callGetHDFLineFlag ||
+					localFileInfoPtr->blockedFlag ||
+						localFileInfoPtr->format == kGAIAType ||
+							localFileInfoPtr->nonContiguousStripsFlag ||
+								localFileInfoPtr->treatLinesAsBottomToTopFlag)
+																						return (-1);
+		
+		fileStreamPtr = GetFileStreamPointer (localFileInfoPtr);
+		if (fileStreamPtr == NULL)
+																						return (-1);
+		
+		#if defined multispec_wx
+			if (fileStreamPtr->GetMappedDataPointer (0, 1) != NULL)
+																						return (-1);
+		#endif	// defined multispec_wx
+		
+		firstPosition = GetFilePositionOffset (fileIOInstructionsPtr, 
+															localFileInfoPtr, 
+															lineStart, 
+															fileChannelNumber, 
+															columnStart, 
+															columnEnd,
+															&numberSamples,
+															&count,
+															&endHalfByte);
+		
+		lastPosition = GetFilePositionOffset (fileIOInstructionsPtr, 
+															localFileInfoPtr, 
+															lineEnd, 
+															fileChannelNumber, 
+															columnStart, 
+															columnEnd,
+															&numberSamples,
+															&count,
+															&endHalfByte);
+		lastPosition += count;
 		
-		//classSymbolIndex = 0;
-		for (classIndex=0; classIndex<numberClasses; classIndex++)
+		if (linesBufferRangePtr != NULL &&
+				linesBufferRangePtr->fileStreamPtr == fileStreamPtr &&
+					firstPosition >= linesBufferRangePtr->filePosition &&
+						firstPosition <= linesBufferRangePtr->filePosition + 
+															linesBufferRangePtr->numberBytes)
 			{
-			listAllGroupInfoPtr[classIndex] = FALSE;
+					// Merge with the previous range.
+					
+			lastPosition = MAX (lastPosition, 
+						linesBufferRangePtr->filePosition + linesBufferRangePtr->numberBytes);
+			numberBytes -= linesBufferRangePtr->numberBytes;
 			
-			classNumber = classIndex;
-			if (asciiSymbolsFlag)
-				classNumber = classSymbolPtr[classIndex];
+			}	// end "if (linesBufferRangePtr != NULL && ..."
 			
-					// Note that if the thematic file is a MultiSpec classification file (has
-					// ascii symbols) then the class symbol vector contains those symbols and
-					// does not reflect whether the classNumber is being used or not. Assume 
-					// for this case that it is being used.
-			/*
-			if (classNumber == classSymbolPtr[classSymbolIndex] ||
-											fileInfoPtr->format == kMultiSpecClassificationType)
-			if (classSymbolPtr == NULL ||
-						asciiSymbolsFlag ||
-								classNumber == classSymbolPtr[classSymbolIndex])
-				{
-				groupNumber = classToGroupPtr[classSymbolIndex];
-			*/
-			groupNumber = classToGroupPtr[classIndex];
-				//if (groupToPalettePtr[groupNumber] == classSymbolIndex)
-			if (groupToPalettePtr[groupNumber] == classIndex)
-				{
-				listAllGroupInfoPtr[classIndex] = TRUE;
-				
-						// Order is green, red, blue to be consistant with that in the ERDAS
-						// trailer file.
-				
-				#ifndef multispec_wx
-					groupColorTablePtr[groupNumber].red =
-														(colorSpecPtr[classIndex].rgb.red >> 8);
-					groupColorTablePtr[groupNumber].green =
-														(colorSpecPtr[classIndex].rgb.green >> 8);
-					groupColorTablePtr[groupNumber].blue =
-														(colorSpecPtr[classIndex].rgb.blue >> 8);
-				#else
-					groupColorTablePtr[groupNumber].red =
-														colorSpecPtr[classIndex].rgb.red;
-					groupColorTablePtr[groupNumber].green =
-														colorSpecPtr[classIndex].rgb.green;
-					groupColorTablePtr[groupNumber].blue =
-														colorSpecPtr[classIndex].rgb.blue;
-				#endif
-					
-				}	// end "if (groupToPalettePtr[groupNumber] == classIndex)"
-				
-				//if (classSymbolIndex < numberClassSymbols-1)
-				//	classSymbolIndex++;
-					
-				//}	// end "if (classNumber == classSymbolPtr[classSymbolIndex] || ...)"
+		else	// start a new range
+			{
+			linesBufferRangePtr = &fileIOInstructionsPtr->linesBufferRangePtr[numberRanges];
+			numberRanges++;
 			
-			}	// end "for (classIndex=0; classIndex<..."
+			linesBufferRangePtr->fileStreamPtr = fileStreamPtr;
+			linesBufferRangePtr->filePosition = firstPosition;
+			linesBufferRangePtr->bufferOffset = (UInt32)numberBytes;
+			
+			}	// end "else start a new range"
 		
-		numberGroups = fileInfoPtr->numberGroups;
+		if (lastPosition - linesBufferRangePtr->filePosition > kMaxLinesOfDataBytes)
+			numberBytes = (SInt64)kMaxLinesOfDataBytes + 1;
 		
-		CheckAndUnlockHandle ((Handle)groupCTableHandle);
+		else	// lastPosition - linesBufferRangePtr->filePosition <= ...
+			{
+			linesBufferRangePtr->numberBytes = 
+								(UInt32)(lastPosition - linesBufferRangePtr->filePosition);
+			numberBytes += linesBufferRangePtr->numberBytes;
+			
+			}	// end "else lastPosition - linesBufferRangePtr->filePosition <= ..."
+			
+		if (numberBytes > kMaxLinesOfDataBytes)
+			break;
 		
-		}	// end "if (colorSpecPtr != NULL)"
+		}	// end "for (index=0; index<...->numberChannels; index++)"
+		
+	fileIOInstructionsPtr->linesBufferNumberRanges = numberRanges;
 	
-	return (numberGroups);
-
-}	// end "LoadGroupInformationBuffers"  
+	return (numberBytes);
+	
+}	// end "LoadLinesBufferRanges"
 
 
 
@@ -9065,6 +12138,10 @@ SInt16 MSetSizeOfFile (
 {  
 	SInt16								errCode;
 	
+	
+			// Blocks of this file in the tile cache may no longer be valid.
+	
+	ReleaseTileCacheEntries (fileStreamPtr);
 	                  
 	#if defined multispec_mac
    	if (gHasHFSPlusAPIs) 
@@ -9116,6 +12193,10 @@ SInt16 MWriteData (
 {  
 	SInt16								errCode;
 	
+	
+			// Blocks of this file in the tile cache may no longer be valid.
+	
+	ReleaseTileCacheEntries (fileStreamPtr);
 	                  
 	#if defined multispec_mac
    	if (gHasHFSPlusAPIs) 
@@ -11760,10 +14841,72 @@ void PackBISData (
 	SInt32								skipSamples;
 	
 	UInt32								channel,
+											firstChannel,
 											index,
+											inputBytes,
+											outputBytes,
 											sample;
 			
 	
+			// Use the SIMD routines if possible when all columns in the line are
+			// being used and the requested channels are next to each other. If all
+			// channels are requested the line is one contiguous vector of samples.
+			
+	if (columnInterval == 1 && 
+				numberSamples > 0 &&
+						GetSIMDConversionBytes (
+										dataConversionCode, &inputBytes, &outputBytes))
+		{
+		firstChannel = 0;
+		if (channelListPtr != NULL)
+			{
+			firstChannel = channelListPtr[0];
+			for (index=1; index<numberChannels; index++)
+				{
+				if (channelListPtr[index] != firstChannel + index)
+					break;
+					
+				}	// end "for (index=1; index<numberChannels; index++)"
+				
+			}	// end "if (channelListPtr != NULL)"
+			
+		else	// channelListPtr == NULL
+			index = numberChannels;
+			
+		if (index == numberChannels &&
+				(&ioCharBufferPtr[numberSamples*numberBufferChannels*inputBytes] <=
+																			dataCharBufferPtr ||
+					&dataCharBufferPtr[numberSamples*numberChannels*outputBytes] <=
+																			ioCharBufferPtr))
+			{
+			if (numberChannels == numberBufferChannels)
+				{
+				if (ConvertDataSamples (dataConversionCode,
+													ioCharBufferPtr,
+													dataCharBufferPtr,
+													numberSamples*numberChannels))
+																						return;
+																						
+				}	// end "if (numberChannels == numberBufferChannels)"
+				
+			else if (numberChannels >= kSIMDPackSamples && 
+															GetSIMDLevel () != kSIMDNone)
+				{
+				for (sample=0; sample<numberSamples; sample++)
+					ConvertDataSamples (
+						dataConversionCode,
+						&ioCharBufferPtr[
+								(sample*numberBufferChannels + firstChannel)*inputBytes],
+						&dataCharBufferPtr[sample*numberChannels*outputBytes],
+						numberChannels);
+																						return;
+																						
+				}	// end "else if (numberChannels >= kSIMDPackSamples && ..."
+			
+			}	// end "if (index == numberChannels && ..."
+			
+		}	// end "if (columnInterval == 1 && ..."
+	
 	skipSamples = columnInterval * numberBufferChannels;
 	
 			// Note that the brackets for each of the cases was included to provide
@@ -12747,7 +15890,9 @@ void PackGAIAData (
 //	Function name:		UInt32 PackMaskData
 //
 //	Software purpose:	The purpose of this routine is to reduce the input line of data
-//							to just that requested by the mask information.
+//							to just that requested by the mask information. If the run
+//							index for the mask is available, the samples for each run are
+//							moved as a block rather than checking the mask for each sample.
 //
 //	Parameters in:				
 //
@@ -12761,6 +15906,7 @@ void PackGAIAData (
 //	Revised By:			Larry L. Biehl			Date: 12/14/2005
 
 UInt32 PackMaskData (
+				MaskInfoPtr							maskInfoPtr,
 				HUInt16Ptr							maskBufferPtr,
 				UInt32								maskColumnStart,
 				UInt32								numberChannels,
@@ -12773,22 +15919,72 @@ UInt32 PackMaskData (
 { 
 	HUCharPtr							inDataBufferPtr,
 											outDataBufferPtr;
+	
+	MaskRunPtr							maskRunPtr;
 											
-	UInt32								numberBytesToMove,
+	UInt32								firstColumn,
+											lastColumn,
+											numberBytesToMove,
 											numberOutputSamples,
+											numberRunSamples,
+											numberRuns,
+											run,
 											sample;
 	
 	
-			// Get the relative position to start reading in the mask buffer with 
-			// respect to the start of the file.					
-			
-	maskBufferPtr += maskColumnStart;
-	
 	inDataBufferPtr = dataBufferPtr;
 	outDataBufferPtr = dataBufferPtr;
 	numberBytesToMove = numberOutBytes * numberChannels;
 	numberOutputSamples = 0;
 	
+	if (maskInfoPtr != NULL && maskInfoPtr->maskRunsHandle != NULL)
+		{
+		numberRuns = GetMaskLineRuns (maskInfoPtr,
+												GetMaskLine (maskInfoPtr, maskBufferPtr),
+												&maskRunPtr);
+		
+		for (run=0; run<numberRuns; run++)
+			{
+			if (maskValueRequest == 0 || 
+									(SInt32)maskRunPtr[run].maskValue == maskValueRequest)
+				{
+				numberRunSamples = GetMaskRunColumns (
+												&maskRunPtr[run],
+												maskColumnStart,
+												maskColumnStart + numberInputSamples - 1,
+												columnInterval,
+												&firstColumn,
+												&lastColumn);
+				
+				if (numberRunSamples > 0)
+					{
+					inDataBufferPtr = dataBufferPtr + 
+								(firstColumn - maskColumnStart) / columnInterval * 
+																				numberBytesToMove;
+					
+					if (inDataBufferPtr != outDataBufferPtr)
+						BlockMoveData (inDataBufferPtr, 
+											outDataBufferPtr, 
+											numberRunSamples * numberBytesToMove);
+					
+					outDataBufferPtr += numberRunSamples * numberBytesToMove;
+					numberOutputSamples += numberRunSamples;
+					
+					}	// end "if (numberRunSamples > 0)"
+				
+				}	// end "if (maskValueRequest == 0 || ..."
+				
+			}	// end "for (run=0; run<numberRuns; run++)"
+			
+		return (numberOutputSamples);
+		
+		}	// end "if (maskInfoPtr != NULL && maskInfoPtr->maskRunsHandle != NULL)"
+	
+			// Get the relative position to start reading in the mask buffer with 
+			// respect to the start of the file.					
+			
+	maskBufferPtr += maskColumnStart;
+	
 	if (maskValueRequest == 0)
 		{										
 		for (sample=0; sample<numberInputSamples; sample+=columnInterval)
@@ -12887,6 +16083,21 @@ void PackNonBISData (
 	if (toBISFormat)
 		dataPtrIncrement = numberChannels;
 		
+			// Use the SIMD routines if possible when all columns in the line are
+			// being used.
+			
+	if (columnInterval == 1 && PackNonBISDataUsingSIMD (columnOffset,
+																			numberColumnsPerChannel,
+																			numberBufferChannels,
+																			numberChannels,
+																			channelListPtr,
+																			numberSamples,
+																			dataConversionCode,
+																			ioCharBufferPtr,
+																			dataCharBufferPtr,
+																			toBISFormat))
+																						return;
+		
 			// Set up parameters for skipping some input channels if needed.
 		
 	currentChannel = 0;	
@@ -13927,34 +17138,272 @@ void PackNonBISData (
 						ioDoublePtr = &ioDoublePtr[numberColumnsPerChannel];
 						currentChannel++;
 						
-						}	// end "while (channelListPtr[channel] != currentChannel)"
+						}	// end "while (channelListPtr[channel] != currentChannel)"
+						
+					}	// end "if (channelListPtr != NULL)"
+				
+				if (toBISFormat)
+					dataDoublePtr = (DoublePtr)&dataCharBufferPtr[channel*8];
+					
+				for (sample=0;  sample<numberSamples; sample+=columnInterval)
+					{
+					*dataDoublePtr = ioDoublePtr[sample];
+					dataDoublePtr += dataPtrIncrement;
+					
+					}	// end "for (sample=0;  sample<numberChan..." 
+					
+						// Update the input buffer pointer to point to beginning of		
+						// data for next channel.													
+				
+				ioDoublePtr = &ioDoublePtr[numberColumnsPerChannel];
+				currentChannel++;
+				
+				}	// end "for (channel=0; channel<numberBufferChannels; channel++)"
+					
+			} 
+			break;
+		
+		}	// end "switch (dataConversionCode)"
+
+}	// end "PackNonBISData"  
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean PackNonBISDataUsingSIMD
+//
+//	Software purpose:	The purpose of this routine is to pack and convert the line of
+//							data for nonBIS formatted files using the SIMD routines when the
+//							column interval is 1. If the data are to be converted to BIS 
+//							format, the line is handled in tiles of kPackTileSamples 
+//							samples. Each channel in the tile is converted into a small 
+//							buffer and then moved to its place in the BIS output so that 
+//							the output for the tile stays in the cache instead of the 
+//							entire output line being passed through once for each channel.
+//
+//	Parameters in:		See PackNonBISData.
+//
+//	Parameters out:	None
+//
+// Value Returned:	TRUE if the line was packed.
+//							FALSE if the scalar code in PackNonBISData needs to be used.
+//
+// Called By:			PackNonBISData in SFileIO.cpp
+
+Boolean PackNonBISDataUsingSIMD (
+				UInt32								columnOffset,
+				UInt32								numberColumnsPerChannel, 
+				UInt32								numberBufferChannels,
+				UInt32								numberChannels,
+				HUInt16Ptr							channelListPtr, 
+				UInt32								numberSamples,
+				UInt32								dataConversionCode,
+				HUCharPtr							ioCharBufferPtr, 
+				HUCharPtr							dataCharBufferPtr, 
+				Boolean								toBISFormat)
+
+{
+	double								tileBuffer[kPackTileSamples];
+	
+	HUCharPtr							dataCharPtr,
+											ioCharEndPtr,
+											ioCharPtr;
+	
+	UInt32								channel,
+											currentChannel,
+											dataBytesIncrement,
+											firstChannel,
+											inputBytes,
+											numberOutputBytes,
+											outputBytes,
+											sample,
+											sampleStart,
+											tileSamples;
+	
+	
+	if (numberSamples == 0 || numberBufferChannels == 0)
+																						return (FALSE);
+	
+	if (GetSIMDLevel () == kSIMDNone)
+																						return (FALSE);
+	
+	if (!GetSIMDConversionBytes (dataConversionCode, &inputBytes, &outputBytes))
+																						return (FALSE);
+	
+			// These conversions are not handled by the scalar code in PackNonBISData.
+			// Leave them out so that the results do not depend on the SIMD level.
+			
+	if (dataConversionCode == k8BitIntUnsignedTo16BitIntSigned ||
+			dataConversionCode == k8BitIntUnsignedTo32BitIntSigned ||
+				dataConversionCode == k16BitIntUnsignedTo32BitIntSigned ||
+					dataConversionCode == k64BitRealTo32BitReal)
+																						return (FALSE);
+	
+	firstChannel = 0;
+	if (channelListPtr != NULL)
+		firstChannel = channelListPtr[0];
+	
+			// The SIMD routines require that the input and output buffers do not
+			// overlap.
+	
+	ioCharEndPtr = &ioCharBufferPtr[(columnOffset + numberSamples) * inputBytes];
+	if (channelListPtr != NULL)
+		ioCharEndPtr = &ioCharEndPtr[
+						(channelListPtr[numberBufferChannels-1] - firstChannel) *
+													numberColumnsPerChannel * inputBytes];
+	
+	else	// channelListPtr == NULL
+		ioCharEndPtr = &ioCharEndPtr[
+						(numberBufferChannels - 1) * numberColumnsPerChannel * inputBytes];
+	
+	if (toBISFormat)
+		numberOutputBytes = 
+			((numberSamples - 1) * numberChannels + numberBufferChannels) * outputBytes;
+		
+	else	// !toBISFormat
+		numberOutputBytes = numberSamples * numberBufferChannels * outputBytes;
+	
+	if (dataCharBufferPtr < ioCharEndPtr && 
+						ioCharBufferPtr < &dataCharBufferPtr[numberOutputBytes])
+																						return (FALSE);
+	
+	if (!toBISFormat)
+		{
+		dataCharPtr = dataCharBufferPtr;
+		ioCharPtr = &ioCharBufferPtr[columnOffset * inputBytes];
+		currentChannel = firstChannel;
+		
+		for (channel=0; channel<numberBufferChannels; channel++)
+			{
+			if (channelListPtr != NULL)
+				{
+				while (channelListPtr[channel] != currentChannel)
+					{
+					ioCharPtr = &ioCharPtr[numberColumnsPerChannel * inputBytes];
+					currentChannel++;
+					
+					}	// end "while (channelListPtr[channel] != currentChannel)"
+					
+				}	// end "if (channelListPtr != NULL)"
+				
+			ConvertDataSamples (dataConversionCode, 
+										ioCharPtr, 
+										dataCharPtr, 
+										numberSamples);
+										
+			dataCharPtr = &dataCharPtr[numberSamples * outputBytes];
+			ioCharPtr = &ioCharPtr[numberColumnsPerChannel * inputBytes];
+			currentChannel++;
+			
+			}	// end "for (channel=0; channel<numberBufferChannels; channel++)"
+			
+		}	// end "if (!toBISFormat)"
+		
+	else	// toBISFormat
+		{
+		dataBytesIncrement = numberChannels * outputBytes;
+		
+		for (sampleStart=0; sampleStart<numberSamples; sampleStart+=kPackTileSamples)
+			{
+			tileSamples = MIN (kPackTileSamples, numberSamples - sampleStart);
+			
+			ioCharPtr = &ioCharBufferPtr[(columnOffset + sampleStart) * inputBytes];
+			currentChannel = firstChannel;
+			
+			for (channel=0; channel<numberBufferChannels; channel++)
+				{
+				if (channelListPtr != NULL)
+					{
+					while (channelListPtr[channel] != currentChannel)
+						{
+						ioCharPtr = &ioCharPtr[numberColumnsPerChannel * inputBytes];
+						currentChannel++;
+						
+						}	// end "while (channelListPtr[channel] != currentChannel)"
+						
+					}	// end "if (channelListPtr != NULL)"
+					
+				ConvertDataSamples (dataConversionCode, 
+											ioCharPtr, 
+											(HUCharPtr)tileBuffer, 
+											tileSamples);
+				
+				dataCharPtr = &dataCharBufferPtr[
+							(sampleStart * numberChannels + channel) * outputBytes];
+				
+				switch (outputBytes)
+					{
+					case 1:
+						{
+						HUCharPtr		tileCharPtr = (HUCharPtr)tileBuffer;
+						
+						for (sample=0; sample<tileSamples; sample++)
+							{
+							*dataCharPtr = tileCharPtr[sample];
+							dataCharPtr += dataBytesIncrement;
+							
+							}	// end "for (sample=0; sample<tileSamples; sample++)"
+						
+						}
+						break;
+						
+					case 2:
+						{
+						HUInt16Ptr		tileIntPtr = (HUInt16Ptr)tileBuffer;
+						
+						for (sample=0; sample<tileSamples; sample++)
+							{
+							*(HUInt16Ptr)dataCharPtr = tileIntPtr[sample];
+							dataCharPtr += dataBytesIncrement;
+							
+							}	// end "for (sample=0; sample<tileSamples; sample++)"
+						
+						}
+						break;
+						
+					case 4:
+						{
+						HUInt32Ptr		tileIntPtr = (HUInt32Ptr)tileBuffer;
+						
+						for (sample=0; sample<tileSamples; sample++)
+							{
+							*(HUInt32Ptr)dataCharPtr = tileIntPtr[sample];
+							dataCharPtr += dataBytesIncrement;
+							
+							}	// end "for (sample=0; sample<tileSamples; sample++)"
+						
+						}
+						break;
+						
+					case 8:
+						{
+						HSInt64Ptr		tileIntPtr = (HSInt64Ptr)tileBuffer;
+						
+						for (sample=0; sample<tileSamples; sample++)
+							{
+							*(HSInt64Ptr)dataCharPtr = tileIntPtr[sample];
+							dataCharPtr += dataBytesIncrement;
+							
+							}	// end "for (sample=0; sample<tileSamples; sample++)"
 						
-					}	// end "if (channelListPtr != NULL)"
-				
-				if (toBISFormat)
-					dataDoublePtr = (DoublePtr)&dataCharBufferPtr[channel*8];
-					
-				for (sample=0;  sample<numberSamples; sample+=columnInterval)
-					{
-					*dataDoublePtr = ioDoublePtr[sample];
-					dataDoublePtr += dataPtrIncrement;
-					
-					}	// end "for (sample=0;  sample<numberChan..." 
-					
-						// Update the input buffer pointer to point to beginning of		
-						// data for next channel.													
+						}
+						break;
+						
+					}	// end "switch (outputBytes)"
 				
-				ioDoublePtr = &ioDoublePtr[numberColumnsPerChannel];
+				ioCharPtr = &ioCharPtr[numberColumnsPerChannel * inputBytes];
 				currentChannel++;
 				
 				}	// end "for (channel=0; channel<numberBufferChannels; channel++)"
-					
-			} 
-			break;
+				
+			}	// end "for (sampleStart=0; sampleStart<numberSamples; ..."
+			
+		}	// end "else toBISFormat"
 		
-		}	// end "switch (dataConversionCode)"
-
-}	// end "PackNonBISData"  
+	return (TRUE);
+	
+}	// end "PackNonBISDataUsingSIMD"
  
 
 
@@ -14374,6 +17823,566 @@ SInt16 PutFile (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 ReadBlocksUsingTileCache
+//
+//	Software purpose:	The purpose of this routine is to load the blocks for the
+//							block row that includes the requested line into the tiled
+//							buffer for a blocked image file. Blocks that are in the tile
+//							cache are copied from the cache; the rest are read from the
+//							file and added to the cache. Only the blocks from the first
+//							to the last one not in the cache are read from the file.
+//		
+//	Parameters in:		File stream pointer.
+//							File information structure pointer.
+//							Hierarchal file format structure pointer for the channel.
+//							Line number (1-based) to be read.
+//							Position in the file of the first block to be read.
+//							Buffer to load the blocks into.
+//
+//	Parameters out:	None
+//
+// Value Returned:	Error code for file operations.
+//
+// Called By:			GetLine in SFileIO.cpp
+
+SInt16 ReadBlocksUsingTileCache (
+				CMFileStream*						fileStreamPtr,
+				FileInfoPtr							fileInfoPtr,
+				HierarchalFileFormatPtr			hfaPtr,
+				UInt32								lineNumber,
+				SInt64								posOff,
+				HUCharPtr							readBufferPtr)
+
+{
+	TileCacheEntryPtr					tileCacheEntryPtr;
+	
+	UInt64								fileIdentity;
+	
+	UInt32								block,
+											blockColumnStart,
+											blockOffset,
+											blockRow,
+											count,
+											firstBlockToRead,
+											hfaIndex,
+											lastBlockToRead,
+											numberBlocks;
+	
+	SInt16								errCode = noErr;
+	
+	
+	blockOffset = hfaPtr->blockOffset;
+	numberBlocks = hfaPtr->numberBlocksRead;
+	blockRow = (lineNumber-1)/hfaPtr->blockHeight;
+	blockColumnStart = (hfaPtr->firstColumnRead-1)/hfaPtr->blockWidth;
+	hfaIndex = (UInt32)(hfaPtr - fileInfoPtr->hfaPtr);
+	fileIdentity = GetTileCacheFileIdentity (fileStreamPtr);
+	
+			// Copy the blocks that are in the cache and find the range of blocks
+			// that need to be read from the file.
+	
+	firstBlockToRead = numberBlocks;
+	lastBlockToRead = 0;
+	for (block=0; block<numberBlocks; block++)
+		{
+		tileCacheEntryPtr = FindTileCacheEntry (fileIdentity,
+																hfaIndex,
+																blockRow,
+																blockColumnStart+block);
+		
+		if (tileCacheEntryPtr != NULL && tileCacheEntryPtr->numberBytes == blockOffset)
+			{
+			BlockMoveData (tileCacheEntryPtr->dataPtr,
+								&readBufferPtr[(SInt64)block*blockOffset],
+								blockOffset);
+			gTileCacheHits++;
+			
+			}	// end "if (tileCacheEntryPtr != NULL && ..."
+			
+		else	// tileCacheEntryPtr == NULL || ...
+			{
+			if (firstBlockToRead == numberBlocks)
+				firstBlockToRead = block;
+			lastBlockToRead = block;
+			gTileCacheMisses++;
+			
+			}	// end "else tileCacheEntryPtr == NULL || ..."
+		
+		}	// end "for (block=0; block<numberBlocks; block++)"
+		
+	if (firstBlockToRead < numberBlocks)
+		{
+		count = (lastBlockToRead - firstBlockToRead + 1) * blockOffset;
+		
+		errCode = MSetMarker (fileStreamPtr, 
+										fsFromStart, 
+										posOff + (SInt64)firstBlockToRead*blockOffset, 
+										kNoErrorMessages);
+
+		if (errCode == noErr)
+			errCode = MReadData (fileStreamPtr, 
+										&count, 
+										&readBufferPtr[(SInt64)firstBlockToRead*blockOffset], 
+										kNoErrorMessages);
+		
+		if (errCode == noErr)
+			{
+			for (block=firstBlockToRead; block<=lastBlockToRead; block++)
+				AddTileCacheEntry (fileIdentity,
+											hfaIndex,
+											blockRow,
+											blockColumnStart+block,
+											&readBufferPtr[(SInt64)block*blockOffset],
+											blockOffset);
+			
+			}	// end "if (errCode == noErr)"
+		
+		}	// end "if (firstBlockToRead < numberBlocks)"
+	
+	return (errCode);
+	
+}	// end "ReadBlocksUsingTileCache"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 ReadCompressedBlocks
+//
+//	Software purpose:	The purpose of this routine is to load the decompressed
+//							blocks for the block row that includes the requested line
+//							into the tiled buffer for a compressed TIFF file. Blocks that
+//							are in the tile cache are copied from the cache. The rest
+//							are read from the file, decompressed and added to the cache.
+//							The blocks are decompressed in parallel when possible.
+//		
+//	Parameters in:		File stream pointer.
+//							File information structure pointer.
+//							Hierarchal file format structure pointer for the channel.
+//							Line number (1-based) to be read.
+//							Buffer to load the blocks into.
+//
+//	Parameters out:	None
+//
+// Value Returned:	Error code for file operations.
+//
+// Called By:			GetLine in SFileIO.cpp
+
+SInt16 ReadCompressedBlocks (
+				CMFileStream*						fileStreamPtr,
+				FileInfoPtr							fileInfoPtr,
+				HierarchalFileFormatPtr			hfaPtr,
+				UInt32								lineNumber,
+				HUCharPtr							readBufferPtr)
+
+{
+	CompressedBlocks					compressedBlocks;
+	
+	BlockFormatPtr						blockFormatPtr;
+	CompressedBlockPtr				compressedBlockPtr;
+	HUCharPtr							bufferPtr,
+											compressedDataPtr,
+											rowBufferPtr;
+	TileCacheEntryPtr					tileCacheEntryPtr;
+	
+	SInt64								numberCompressedBytes;
+	
+	UInt64								fileIdentity;
+	
+	UInt32								block,
+											blockColumnStart,
+											blockOffset,
+											blockRow,
+											count,
+											hfaIndex,
+											index,
+											lastIndex,
+											numberBlocks,
+											numberBlocksToDecode,
+											numberRowBufferBytes,
+											tileCacheIndex;
+	
+	SInt16								errCode = noErr;
+	
+	Boolean								useTileCacheFlag;
+	
+	
+	blockOffset = hfaPtr->blockOffset;
+	numberBlocks = hfaPtr->numberBlocksRead;
+	blockRow = (lineNumber-1)/hfaPtr->blockHeight;
+	blockColumnStart = (hfaPtr->firstColumnRead-1)/hfaPtr->blockWidth;
+	hfaIndex = (UInt32)(hfaPtr - fileInfoPtr->hfaPtr);
+	
+	blockFormatPtr = &fileInfoPtr->blockFormatPtr[
+											hfaIndex * hfaPtr->blocksPerChannel +
+													blockRow * hfaPtr->numberBlockWidths +
+																					blockColumnStart];
+	
+	useTileCacheFlag = (blockOffset <= gTileCacheMaximumBytes);
+	
+	fileIdentity = 0;
+	if (useTileCacheFlag)
+		fileIdentity = GetTileCacheFileIdentity (fileStreamPtr);
+	
+			// The blocks of the reduced resolution TIFF images are kept in the tile
+			// cache separately from those of the full resolution image.
+			
+	tileCacheIndex = hfaIndex + 
+							fileInfoPtr->tiffOverviewIndex * fileInfoPtr->numberChannels;
+	
+			// Get memory for the block descriptions, the compressed data and the
+			// row buffers needed to undo the floating point predictor. Enough is
+			// requested to decode all blocks in the block row.
+	
+	numberRowBufferBytes = 0;
+	if (fileInfoPtr->predictorCode == 3)
+		numberRowBufferBytes = blockOffset/hfaPtr->blockHeight;
+	
+	numberCompressedBytes = 0;
+	for (block=0; block<numberBlocks; block++)
+		numberCompressedBytes += blockFormatPtr[block].blockSize;
+	
+	bufferPtr = (HUCharPtr)MNewPointer (
+				(SInt64)numberBlocks * (sizeof (CompressedBlock) + numberRowBufferBytes) +
+																			numberCompressedBytes);
+	
+	if (bufferPtr == NULL)
+																						return (-1);
+	
+	compressedBlockPtr = (CompressedBlockPtr)bufferPtr;
+	rowBufferPtr = &bufferPtr[(SInt64)numberBlocks * sizeof (CompressedBlock)];
+	compressedDataPtr = &rowBufferPtr[(SInt64)numberBlocks * numberRowBufferBytes];
+	
+			// Copy the blocks that are in the cache and set up the descriptions for
+			// the blocks that need to be decompressed. The compressed data is used
+			// directly from the memory mapping of the file if it exists.
+	
+	numberBlocksToDecode = 0;
+	for (block=0; block<numberBlocks; block++)
+		{
+		tileCacheEntryPtr = NULL;
+		if (useTileCacheFlag)
+			tileCacheEntryPtr = FindTileCacheEntry (fileIdentity,
+																	tileCacheIndex,
+																	blockRow,
+																	blockColumnStart+block);
+		
+		if (tileCacheEntryPtr != NULL && tileCacheEntryPtr->numberBytes == blockOffset)
+			{
+			BlockMoveData (tileCacheEntryPtr->dataPtr,
+								&readBufferPtr[(SInt64)block*blockOffset],
+								blockOffset);
+			gTileCacheHits++;
+			
+			}	// end "if (tileCacheEntryPtr != NULL && ..."
+			
+		else	// tileCacheEntryPtr == NULL || ...
+			{
+			if (useTileCacheFlag)
+				gTileCacheMisses++;
+			
+			index = numberBlocksToDecode;
+			compressedBlockPtr[index].block = block;
+			compressedBlockPtr[index].fileOffset = blockFormatPtr[block].blockOffsetBytes;
+			compressedBlockPtr[index].numberCompressedBytes = 
+																	blockFormatPtr[block].blockSize;
+			compressedBlockPtr[index].outputDataPtr = 
+												&readBufferPtr[(SInt64)block*blockOffset];
+			compressedBlockPtr[index].rowBufferPtr = 
+										&rowBufferPtr[(SInt64)index*numberRowBufferBytes];
+			compressedBlockPtr[index].errCode = noErr;
+			compressedBlockPtr[index].compressedDataPtr = NULL;
+			
+			#if defined multispec_wx
+				compressedBlockPtr[index].compressedDataPtr = 
+									fileStreamPtr->GetMappedDataPointer (
+													compressedBlockPtr[index].fileOffset,
+													compressedBlockPtr[index].numberCompressedBytes);
+			#endif	// defined multispec_wx
+			
+			compressedBlockPtr[index].readFlag = 
+									(compressedBlockPtr[index].compressedDataPtr == NULL);
+			
+			if (compressedBlockPtr[index].readFlag)
+				{
+				compressedBlockPtr[index].compressedDataPtr = compressedDataPtr;
+				compressedDataPtr += compressedBlockPtr[index].numberCompressedBytes;
+				
+				}	// end "if (compressedBlockPtr[index].readFlag)"
+			
+			numberBlocksToDecode++;
+			
+			}	// end "else tileCacheEntryPtr == NULL || ..."
+		
+		}	// end "for (block=0; block<numberBlocks; block++)"
+	
+			// Read the compressed data that is not in a memory mapping. Blocks that
+			// are stored one after the other in the file are read together.
+	
+	index = 0;
+	while (index < numberBlocksToDecode && errCode == noErr)
+		{
+		if (compressedBlockPtr[index].readFlag)
+			{
+			count = compressedBlockPtr[index].numberCompressedBytes;
+			lastIndex = index;
+			while (lastIndex+1 < numberBlocksToDecode &&
+						compressedBlockPtr[lastIndex+1].readFlag &&
+							compressedBlockPtr[lastIndex+1].fileOffset == 
+											compressedBlockPtr[lastIndex].fileOffset +
+													compressedBlockPtr[lastIndex].numberCompressedBytes)
+				{
+				lastIndex++;
+				count += compressedBlockPtr[lastIndex].numberCompressedBytes;
+				
+				}	// end "while (lastIndex+1 < numberBlocksToDecode && ..."
+			
+			errCode = MSetMarker (fileStreamPtr, 
+											fsFromStart, 
+											compressedBlockPtr[index].fileOffset, 
+											kNoErrorMessages);
+	
+			if (errCode == noErr)
+				errCode = MReadData (fileStreamPtr, 
+											&count, 
+											compressedBlockPtr[index].compressedDataPtr, 
+											kNoErrorMessages);
+			
+			index = lastIndex;
+			
+			}	// end "if (compressedBlockPtr[index].readFlag)"
+		
+		index++;
+		
+		}	// end "while (index < numberBlocksToDecode && errCode == noErr)"
+	
+			// Decompress the blocks and add them to the tile cache.
+	
+	if (errCode == noErr && numberBlocksToDecode > 0)
+		{
+		compressedBlocks.fileInfoPtr = fileInfoPtr;
+		compressedBlocks.compressedBlockPtr = compressedBlockPtr;
+		compressedBlocks.numberOutputBytes = blockOffset;
+		compressedBlocks.numberRowBytes = blockOffset/hfaPtr->blockHeight;
+		
+		RunTasksInParallel (numberBlocksToDecode, 
+									DecodeCompressedBlock, 
+									&compressedBlocks);
+		
+		for (index=0; index<numberBlocksToDecode; index++)
+			{
+			if (compressedBlockPtr[index].errCode != noErr)
+				errCode = -1;
+			
+			else if (useTileCacheFlag)
+				{
+				block = compressedBlockPtr[index].block;
+				AddTileCacheEntry (fileIdentity,
+											tileCacheIndex,
+											blockRow,
+											blockColumnStart+block,
+											compressedBlockPtr[index].outputDataPtr,
+											blockOffset);
+				
+				}	// end "else if (useTileCacheFlag)"
+			
+			}	// end "for (index=0; index<numberBlocksToDecode; index++)"
+		
+		}	// end "if (errCode == noErr && numberBlocksToDecode > 0)"
+	
+	CheckAndDisposePtr ((Ptr)bufferPtr);
+	
+	return (errCode);
+	
+}	// end "ReadCompressedBlocks"
+
+
+
+#if defined multispec_wx
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void ReadLinesBufferRange
+//
+//	Software purpose:	The purpose of this routine is to read one of the ranges of
+//							file bytes into the lines buffer. It is called as one of the
+//							tasks set up by LoadLinesBuffer for linked image files and 
+//							may run in a worker thread. The read does not use the file 
+//							marker so the handle that is already open for the file is 
+//							shared by all of the threads.
+//		
+//	Parameters in:		Pointer to the file IO instructions structure.
+//							Index of the range to be read.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			RunTasksInParallel in SThreads.cpp
+
+void ReadLinesBufferRange (
+				void*									taskInfoPtr,
+				UInt32								task)
+
+{
+	FileIOInstructionsPtr			fileIOInstructionsPtr;
+	LinesBufferRangePtr				linesBufferRangePtr;
+	
+	UInt32								count;
+	
+	
+	fileIOInstructionsPtr = (FileIOInstructionsPtr)taskInfoPtr;
+	linesBufferRangePtr = &fileIOInstructionsPtr->linesBufferRangePtr[task];
+	
+	count = linesBufferRangePtr->numberBytes;
+	linesBufferRangePtr->errCode = 
+				linesBufferRangePtr->fileStreamPtr->MReadDataAtPosition (
+									linesBufferRangePtr->filePosition,
+									&fileIOInstructionsPtr->linesBufferPtr[
+															linesBufferRangePtr->bufferOffset],
+									&count);
+	
+}	// end "ReadLinesBufferRange"
+#endif	// defined multispec_wx
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void ReleaseTileCacheEntries
+//
+//	Software purpose:	The purpose of this routine is to release the blocks in the
+//							tile cache that were read from the file represented by the
+//							input file stream. All blocks are released if the file stream
+//							pointer is NULL.
+//		
+//	Parameters in:		File stream pointer.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			CloseFile in SFileIO.cpp
+//							InitializeFileStream in SFileIO.cpp
+//							MSetSizeOfFile in SFileIO.cpp
+//							MWriteData in SFileIO.cpp
+//							CMFileStream::MCloseFile in SFileStream_class.cpp
+
+void ReleaseTileCacheEntries (
+				CMFileStream*						fileStreamPtr)
+
+{
+	UInt64								fileIdentity;
+	
+	SInt32								index,
+											nextIndex;
+	
+	
+	if (gTileCacheNumberEntries == 0)
+																							return;
+	
+	fileIdentity = 0;
+	if (fileStreamPtr != NULL)
+		fileIdentity = GetTileCacheFileIdentity (fileStreamPtr);
+	
+	index = gTileCacheLeastRecentIndex;
+	while (index >= 0)
+		{
+		nextIndex = gTileCacheEntryPtr[index].lruPrevious;
+		
+		if (fileStreamPtr == NULL || 
+								gTileCacheEntryPtr[index].fileIdentity == fileIdentity)
+			ReleaseTileCacheEntry (index);
+		
+		index = nextIndex;
+		
+		}	// end "while (index >= 0)"
+	
+	if (gTileCacheNumberEntries == 0)
+		{
+		gTileCacheEntryPtr = (TileCacheEntryPtr)CheckAndDisposePtr (
+																			(Ptr)gTileCacheEntryPtr);
+		gTileCacheHashPtr = (SInt32*)CheckAndDisposePtr ((Ptr)gTileCacheHashPtr);
+		
+		}	// end "if (gTileCacheNumberEntries == 0)"
+	
+}	// end "ReleaseTileCacheEntries"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void ReleaseTileCacheEntry
+//
+//	Software purpose:	The purpose of this routine is to release the memory for the
+//							requested entry in the tile cache. The entry is removed from
+//							its hash bucket and from the use list and is added to the
+//							list of free entries.
+//		
+//	Parameters in:		Index of the entry to be released.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			AddTileCacheEntry in SFileIO.cpp
+//							ReleaseTileCacheEntries in SFileIO.cpp
+
+void ReleaseTileCacheEntry (
+				SInt32								index)
+
+{
+	TileCacheEntryPtr					tileCacheEntryPtr;
+	
+	SInt32*								linkPtr;
+	
+	
+	tileCacheEntryPtr = &gTileCacheEntryPtr[index];
+	
+			// Remove the entry from its hash bucket.
+	
+	linkPtr = &gTileCacheHashPtr[GetTileCacheHashIndex (
+															tileCacheEntryPtr->fileIdentity,
+															tileCacheEntryPtr->hfaIndex,
+															tileCacheEntryPtr->blockRow,
+															tileCacheEntryPtr->blockColumn)];
+	while (*linkPtr != index)
+		linkPtr = &gTileCacheEntryPtr[*linkPtr].hashNext;
+	*linkPtr = tileCacheEntryPtr->hashNext;
+	
+			// Remove the entry from the use list.
+	
+	if (tileCacheEntryPtr->lruPrevious >= 0)
+		gTileCacheEntryPtr[tileCacheEntryPtr->lruPrevious].lruNext =
+																		tileCacheEntryPtr->lruNext;
+	else	// index == gTileCacheMostRecentIndex
+		gTileCacheMostRecentIndex = tileCacheEntryPtr->lruNext;
+	
+	if (tileCacheEntryPtr->lruNext >= 0)
+		gTileCacheEntryPtr[tileCacheEntryPtr->lruNext].lruPrevious =
+																	tileCacheEntryPtr->lruPrevious;
+	else	// index == gTileCacheLeastRecentIndex
+		gTileCacheLeastRecentIndex = tileCacheEntryPtr->lruPrevious;
+	
+	gTileCacheNumberBytes -= tileCacheEntryPtr->numberBytes;
+	tileCacheEntryPtr->dataPtr = (HUCharPtr)CheckAndDisposePtr (
+																	(Ptr)tileCacheEntryPtr->dataPtr);
+	
+	tileCacheEntryPtr->hashNext = gTileCacheFreeIndex;
+	gTileCacheFreeIndex = index;
+	
+	gTileCacheNumberEntries--;
+	
+}	// end "ReleaseTileCacheEntry"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -14998,6 +19007,272 @@ void SetType (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void SetUpAreaColumnRuns
+//
+//	Software purpose:	This routine sets up the runs of columns to be read for each
+//							line of the area so that GetLineOfData only reads and 
+//							converts the columns that will be used. The runs come from 
+//							the run index for a mask area or are determined from the
+//							polygon points for a polygonal project field. The runs are 
+//							not used if they include more than half of the samples in 
+//							the area since reading the full lines is then as fast, if
+//							the runs are so short on average that the separate read for
+//							each run costs more than it saves, or if the file is read in
+//							a way that does not allow just part of a line to be read
+//							efficiently.
+//							The calling routine still needs to check whether each sample
+//							of a polygonal area is within the polygon.
+//
+//	Parameters in:		File IO instructions structure set up by 
+//								SetUpFileIOInstructions.
+//							Area description structure.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			ClassifyPerPointArea in SClassify.cpp
+//							ISODATAClusterPass in SClusterIsodata.cpp
+//							GetAreaStats in SMatrixUtilities.cpp
+
+void SetUpAreaColumnRuns (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				AreaDescriptionPtr				areaDescriptionPtr)
+
+{
+	double*								workPtr;
+	
+	FileInfoPtr							localFileInfoPtr;
+	HUInt32Ptr							lineRunIndexPtr;
+	MaskRunPtr							maskRunPtr;
+	
+	Handle								lineRunIndexHandle,
+											runsHandle;
+	
+	SInt64								numberAreaRuns,
+											numberRunSamples;
+	
+	SInt32								line;
+	
+	UInt32								channel,
+											columnInterval,
+											firstColumn,
+											index,
+											lastColumn,
+											lineIndex,
+											maskColumnEnd,
+											numberLines,
+											numberRuns,
+											numberSamples,
+											pass,
+											run,
+											runSamples;
+	
+	
+	fileIOInstructionsPtr->areaRunsFlag = FALSE;
+	fileIOInstructionsPtr->areaLineRunIndexHandle = 
+						UnlockAndDispose (fileIOInstructionsPtr->areaLineRunIndexHandle);
+	fileIOInstructionsPtr->areaRunsHandle = 
+						UnlockAndDispose (fileIOInstructionsPtr->areaRunsHandle);
+	
+	if (areaDescriptionPtr == NULL || 
+			!fileIOInstructionsPtr->packDataFlag ||
+				!fileIOInstructionsPtr->forceBISFormatFlag ||
+					fileIOInstructionsPtr->oneReadFlag ||
+						fileIOInstructionsPtr->tiffOverviewFileInfoPtr != NULL ||
+							GetThreadedIOFlag (fileIOInstructionsPtr))
+																									return;
+	
+			// Files read with gdal or stored in blocks are read for the full width
+			// of the area.
+	
+	for (index=0; index<fileIOInstructionsPtr->numberChannels; index++)
+		{
+		channel = index;
+		if (fileIOInstructionsPtr->channelListPtr != NULL)
+			channel = fileIOInstructionsPtr->channelListPtr[index];
+		channel++;
+		
+		localFileInfoPtr = &fileIOInstructionsPtr->fileInfoPtr[
+							fileIOInstructionsPtr->layerInfoPtr[channel].fileInfoIndex];
+		
+		if (localFileInfoPtr->gdalDataSetH != NULL || localFileInfoPtr->blockedFlag)
+																									return;
+		
+		}	// end "for (index=0; index<...->numberChannels; index++)"
+	
+	columnInterval = areaDescriptionPtr->columnInterval;
+	numberSamples = (areaDescriptionPtr->columnEnd - areaDescriptionPtr->columnStart + 
+													columnInterval) / columnInterval;
+	numberLines = (areaDescriptionPtr->lineEnd - areaDescriptionPtr->lineStart + 
+						areaDescriptionPtr->lineInterval) / areaDescriptionPtr->lineInterval;
+	numberAreaRuns = 0;
+	numberRunSamples = 0;
+	
+	if (fileIOInstructionsPtr->maskBufferPtr != NULL)
+		{
+		if (fileIOInstructionsPtr->maskInfoPtr->maskRunsHandle == NULL)
+																									return;
+																									
+		maskColumnEnd = areaDescriptionPtr->maskColumnStart + 
+							areaDescriptionPtr->columnEnd - areaDescriptionPtr->columnStart;
+		
+		for (lineIndex=0; lineIndex<numberLines; lineIndex++)
+			{
+			numberRuns = GetMaskLineRuns (
+								fileIOInstructionsPtr->maskInfoPtr,
+								areaDescriptionPtr->maskLineStart + 
+												lineIndex * areaDescriptionPtr->lineInterval,
+								&maskRunPtr);
+			
+			for (run=0; run<numberRuns; run++)
+				{
+				if (areaDescriptionPtr->maskValueRequest == 0 ||
+						maskRunPtr[run].maskValue == areaDescriptionPtr->maskValueRequest)
+					{
+					runSamples = GetMaskRunColumns (&maskRunPtr[run],
+																areaDescriptionPtr->maskColumnStart,
+																maskColumnEnd,
+																columnInterval,
+																&firstColumn,
+																&lastColumn);
+					if (runSamples > 0)
+						{
+						numberAreaRuns++;
+						numberRunSamples += runSamples;
+						
+						}	// end "if (runSamples > 0)"
+					
+					}	// end "if (areaDescriptionPtr->maskValueRequest == 0 || ..."
+				
+				}	// end "for (run=0; run<numberRuns; run++)"
+			
+			}	// end "for (lineIndex=0; lineIndex<numberLines; lineIndex++)"
+		
+		}	// end "if (fileIOInstructionsPtr->maskBufferPtr != NULL)"
+		
+	else if (areaDescriptionPtr->polygonFieldFlag && 
+					areaDescriptionPtr->rgnHandle != NULL &&
+						areaDescriptionPtr->polygonPointsPtr != NULL &&
+							areaDescriptionPtr->numberPolygonPoints >= 3)
+		{
+		workPtr = (double*)MNewPointer (
+				(SInt64)6 * areaDescriptionPtr->numberPolygonPoints * sizeof (double));
+		if (workPtr == NULL)
+																									return;
+		
+		lineRunIndexHandle = NULL;
+		runsHandle = NULL;
+		lineRunIndexPtr = NULL;
+		maskRunPtr = NULL;
+		numberRuns = 0;
+		
+				// The runs are counted in the first pass and loaded in the second 
+				// pass.
+		
+		for (pass=1; pass<=2; pass++)
+			{
+			if (pass == 2)
+				{
+				lineRunIndexHandle = MNewHandle ((SInt64)(numberLines+1) * sizeof (UInt32));
+				runsHandle = MNewHandle ((SInt64)MAX (numberRuns, 1) * sizeof (MaskRun));
+				
+				lineRunIndexPtr = (HUInt32Ptr)GetHandlePointer (lineRunIndexHandle, kLock);
+				maskRunPtr = (MaskRunPtr)GetHandlePointer (runsHandle, kLock);
+				
+				if (lineRunIndexPtr == NULL || maskRunPtr == NULL)
+					{
+					UnlockAndDispose (lineRunIndexHandle);
+					UnlockAndDispose (runsHandle);
+					CheckAndDisposePtr ((Ptr)workPtr);
+																									return;
+																						
+					}	// end "if (lineRunIndexPtr == NULL || maskRunPtr == NULL)"
+					
+				numberRuns = 0;
+				
+				}	// end "if (pass == 2)"
+			
+			line = areaDescriptionPtr->lineStart;
+			for (lineIndex=0; lineIndex<numberLines; lineIndex++)
+				{
+				if (pass == 2)
+					lineRunIndexPtr[lineIndex] = numberRuns;
+					
+				numberRuns += GetPolygonColumnRuns (
+									areaDescriptionPtr->polygonPointsPtr,
+									areaDescriptionPtr->numberPolygonPoints,
+									areaDescriptionPtr->columnOffset,
+									areaDescriptionPtr->lineOffset,
+									line,
+									areaDescriptionPtr->columnStart,
+									areaDescriptionPtr->columnEnd,
+									workPtr,
+									(pass == 2) ? &maskRunPtr[numberRuns] : NULL);
+				
+				line += areaDescriptionPtr->lineInterval;
+				
+				}	// end "for (lineIndex=0; lineIndex<numberLines; lineIndex++)"
+			
+			}	// end "for (pass=1; pass<=2; pass++)"
+			
+		lineRunIndexPtr[numberLines] = numberRuns;
+		CheckAndDisposePtr ((Ptr)workPtr);
+		
+		for (run=0; run<numberRuns; run++)
+			{
+			runSamples = GetMaskRunColumns (&maskRunPtr[run],
+														areaDescriptionPtr->columnStart,
+														areaDescriptionPtr->columnEnd,
+														columnInterval,
+														&firstColumn,
+														&lastColumn);
+			if (runSamples > 0)
+				{
+				numberAreaRuns++;
+				numberRunSamples += runSamples;
+				
+				}	// end "if (runSamples > 0)"
+			
+			}	// end "for (run=0; run<numberRuns; run++)"
+		
+		fileIOInstructionsPtr->areaLineRunIndexHandle = lineRunIndexHandle;
+		fileIOInstructionsPtr->areaRunsHandle = runsHandle;
+		fileIOInstructionsPtr->areaRunsLineStart = areaDescriptionPtr->lineStart;
+		fileIOInstructionsPtr->areaRunsLineInterval = areaDescriptionPtr->lineInterval;
+		fileIOInstructionsPtr->areaRunsNumberLines = numberLines;
+		
+		}	// end "else if (areaDescriptionPtr->polygonFieldFlag && ..."
+		
+	else	// not a mask or polygonal area
+																									return;
+	
+			// Only use the runs when they include no more than half of the samples
+			// in the area. GetAreaRunsLineOfData reads each run separately, so the
+			// runs also need to be long enough on average to make up for the extra
+			// reads; many short runs, such as for a speckled mask, are read faster
+			// as full lines.
+	
+	if (numberRunSamples * 2 <= (SInt64)numberLines * numberSamples &&
+						numberRunSamples >= numberAreaRuns * kMinimumAreaRunSamples)
+		fileIOInstructionsPtr->areaRunsFlag = TRUE;
+	
+	else	// numberRunSamples * 2 > (SInt64)numberLines * numberSamples || ...
+		{
+		fileIOInstructionsPtr->areaLineRunIndexHandle = 
+						UnlockAndDispose (fileIOInstructionsPtr->areaLineRunIndexHandle);
+		fileIOInstructionsPtr->areaRunsHandle = 
+						UnlockAndDispose (fileIOInstructionsPtr->areaRunsHandle);
+		
+		}	// end "else numberRunSamples * 2 > ... || ..."
+	
+}	// end "SetUpAreaColumnRuns"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -15106,6 +19381,19 @@ SInt16 SetUpFileIOInstructions (
 	
 	if (fileIOInstructionsPtr == NULL)
 																						return (noErr);
+	
+			// Determine if a reduced resolution TIFF image can be read for the
+			// requested line and column intervals.
+			
+	SetUpTIFFOverviewFileIO (fileIOInstructionsPtr,
+										numberListChannels,
+										channelListPtr,
+										&lineStart,
+										&lineEnd,
+										&lineInterval,
+										&columnStart,
+										&columnEnd,
+										&columnInterval);
 																					
 	fileInfoPtr = fileIOInstructionsPtr->fileInfoPtr;
 																								
@@ -15291,6 +19579,7 @@ SInt16 SetUpFileIOInstructions (
 	
 	if (areaDescriptionPtr != NULL && areaDescriptionPtr->maskInfoPtr != NULL)
 		{
+		fileIOInstructionsPtr->maskInfoPtr = areaDescriptionPtr->maskInfoPtr;
 		fileIOInstructionsPtr->maskBufferPtr = 
 								(HUInt16Ptr)GetHandlePointer (
 													areaDescriptionPtr->maskInfoPtr->maskHandle,
@@ -15315,6 +19604,11 @@ SInt16 SetUpFileIOInstructions (
 		
 		}	// end "if (areaDescriptionPtr != NULL && ..."
 		
+			// Indicate that no lines are in the gdal block row buffer.
+	
+	fileIOInstructionsPtr->gdalBlockFirstLine = 0;
+	fileIOInstructionsPtr->gdalBlockLastLine = 0;
+		
 			// Set up heirarchal tile parameters, if needed.
 		
 	SetUpHeirarchalFileIOParameters (fileIOInstructionsPtr->layerInfoPtr,
@@ -15326,7 +19620,41 @@ SInt16 SetUpFileIOInstructions (
 		
 			// Set flag indicating whether Threaded IO can be used.
 			
-	gUseThreadedIOFlag = gHasThreadManager && fileIOInstructionsPtr->oneReadFlag;
+	#if defined multispec_wx
+		fileIOInstructionsPtr->mappedIOFlag = SetUpMappedFileIO (fileIOInstructionsPtr);
+		
+				// For the wx versions the lines are read ahead on a separate thread.
+				// This is only used when all channels for a line come from one read
+				// of a single uncompressed, non-blocked file.
+				
+		gUseThreadedIOFlag = (gThreadedIOPrefetchDepth > 0 &&
+										fileIOInstructionsPtr->oneReadFlag &&
+											fileInfoPtr->numberBits != 4 &&
+												fileInfoPtr->format != kGAIAType &&
+													!fileInfoPtr->blockedFlag &&
+														!fileInfoPtr->callGetHDFLineFlag &&
+															!fileInfoPtr->treatLinesAsBottomToTopFlag &&
+																fileInfoPtr->gdalDataSetH == NULL &&
+																	!fileIOInstructionsPtr->mappedIOFlag);
+		
+				// For linked image files the bytes for a block of lines from the
+				// different files are read concurrently by worker threads when
+				// GetLinesOfData loads the lines buffer. Single lines are read
+				// serially since starting the threads for each line costs more than
+				// the reads. The reads use the handles already open for the files so
+				// no more files are opened.
+				
+		fileIOInstructionsPtr->linkedFilesConcurrentIOFlag = 
+								(windowInfoPtr != NULL &&
+									windowInfoPtr->numberImageFiles > 1 &&
+										!gUseThreadedIOFlag &&
+											!fileIOInstructionsPtr->mappedIOFlag &&
+												GetNumberWorkerThreads (
+													windowInfoPtr->numberImageFiles) > 1);
+	#else	// !defined multispec_wx
+		fileIOInstructionsPtr->mappedIOFlag = FALSE;
+		gUseThreadedIOFlag = gHasThreadManager && fileIOInstructionsPtr->oneReadFlag;
+	#endif	// defined multispec_wx
 
 	if (errCode == noErr)
 		errCode = SetupFileIOThread (fileIOInstructionsPtr);
@@ -15404,6 +19732,48 @@ void SetUpGeneralFileIOInstructions (
 	
 	fileIOInstructionsPtr->callPackLineOfDataFlag = FALSE;
 	fileIOInstructionsPtr->differentBuffersFlag = FALSE;
+	fileIOInstructionsPtr->mappedIOFlag = FALSE;
+	fileIOInstructionsPtr->linkedFilesConcurrentIOFlag = FALSE;
+	fileIOInstructionsPtr->tiffOverviewAllowedFlag = FALSE;
+	
+			// Initialize the read-ahead, lines buffer, gdal block row buffer, TIFF
+			// overview and area column run parameters. The structure may be on the
+			// stack so none of these can be assumed to be zero. They are released
+			// in CloseUpFileIOInstructions and EndFileIOThread.
+	
+	fileIOInstructionsPtr->prefetchPtr = NULL;
+	
+	fileIOInstructionsPtr->linesBufferPtr = NULL;
+	fileIOInstructionsPtr->linesBufferRangePtr = NULL;
+	fileIOInstructionsPtr->linesBufferBytes = 0;
+	fileIOInstructionsPtr->linesBufferMaxRanges = 0;
+	fileIOInstructionsPtr->linesBufferNumberRanges = 0;
+	fileIOInstructionsPtr->linesBufferRangeIndex = 0;
+	
+	fileIOInstructionsPtr->gdalChannelListPtr = NULL;
+	fileIOInstructionsPtr->gdalBlockBufferPtr = NULL;
+	fileIOInstructionsPtr->gdalBlockDataSetH = NULL;
+	fileIOInstructionsPtr->gdalBlockBufferBytes = 0;
+	fileIOInstructionsPtr->gdalBlockColumnEnd = 0;
+	fileIOInstructionsPtr->gdalBlockColumnStart = 0;
+	fileIOInstructionsPtr->gdalBlockFirstChannel = 0;
+	fileIOInstructionsPtr->gdalBlockFirstLine = 0;
+	fileIOInstructionsPtr->gdalBlockLastLine = 0;
+	fileIOInstructionsPtr->gdalBlockNumberChannels = 0;
+	
+	fileIOInstructionsPtr->tiffOverviewFileInfoPtr = NULL;
+	fileIOInstructionsPtr->tiffOverviewSavedFileInfoPtr = NULL;
+	fileIOInstructionsPtr->tiffOverviewFactor = 1;
+	
+	fileIOInstructionsPtr->maskInfoPtr = NULL;
+	fileIOInstructionsPtr->maskBufferPtr = NULL;
+	
+	fileIOInstructionsPtr->areaLineRunIndexHandle = NULL;
+	fileIOInstructionsPtr->areaRunsHandle = NULL;
+	fileIOInstructionsPtr->areaRunsLineInterval = 1;
+	fileIOInstructionsPtr->areaRunsLineStart = 0;
+	fileIOInstructionsPtr->areaRunsNumberLines = 0;
+	fileIOInstructionsPtr->areaRunsFlag = FALSE;
 	
 	returnCode = SetUpDataConversionCode (layerInfoPtr,
 														fileInfoPtr,
@@ -15645,6 +20015,243 @@ void SetUpHeirarchalFileIOParameters (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void SetUpTIFFOverviewFileIO
+//
+//	Software purpose:	This routine determines whether one of the reduced resolution
+//							images in a compressed TIFF file can be read in place of the
+//							full resolution image for the requested line and column
+//							intervals. The overview with the largest reduction factor that
+//							both intervals are a multiple of is used. A copy of the file
+//							information structure for the overview is then placed in the
+//							file IO instruction structure and the area is converted to
+//							the lines and columns of the overview.
+//
+//	Parameters in:		File IO instructions structure
+//							Number of channels and the channel list
+//							Area to be read in full resolution lines and columns
+//
+//	Parameters out:	Area to be read in the lines and columns of the overview
+//
+// Value Returned:	None
+//
+// Called By:			SetUpFileIOInstructions in SFileIO.cpp
+
+void SetUpTIFFOverviewFileIO (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				UInt16								numberListChannels,
+				HUInt16Ptr							channelListPtr,
+				UInt32*								lineStartPtr,
+				UInt32*								lineEndPtr,
+				UInt32*								lineIntervalPtr,
+				UInt32*								columnStartPtr,
+				UInt32*								columnEndPtr,
+				UInt32*								columnIntervalPtr)
+
+{
+	FileInfoPtr							fileInfoPtr,
+											overviewFileInfoPtr;
+	
+	TIFFOverviewPtr					tiffOverviewPtr;
+	
+	UInt32								factor,
+											index,
+											overviewIndex;
+	
+	
+	CloseUpTIFFOverviewFileIO (fileIOInstructionsPtr);
+	
+	fileInfoPtr = fileIOInstructionsPtr->fileInfoPtr;
+	
+	if (!fileIOInstructionsPtr->tiffOverviewAllowedFlag ||
+			fileInfoPtr == NULL ||
+				fileInfoPtr->numberTIFFOverviews == 0 ||
+					fileInfoPtr->gdalDataSetH != NULL ||
+						fileIOInstructionsPtr->tiledBufferPtrs[0] == NULL)
+																							return;
+																							
+	if (fileIOInstructionsPtr->windowInfoPtr != NULL &&
+							fileIOInstructionsPtr->windowInfoPtr->numberImageFiles > 1)
+																							return;
+	
+	tiffOverviewPtr = (TIFFOverviewPtr)GetHandlePointer (
+																	fileInfoPtr->tiffOverviewHandle);
+	
+	if (tiffOverviewPtr == NULL)
+																							return;
+	
+	factor = 1;
+	overviewIndex = 0;
+	for (index=0; index<fileInfoPtr->numberTIFFOverviews; index++)
+		{
+		if (tiffOverviewPtr[index].factor > factor &&
+				*lineIntervalPtr % tiffOverviewPtr[index].factor == 0 &&
+					*columnIntervalPtr % tiffOverviewPtr[index].factor == 0)
+			{
+			factor = tiffOverviewPtr[index].factor;
+			overviewIndex = index;
+			
+			}	// end "if (tiffOverviewPtr[index].factor > factor && ..."
+		
+		}	// end "for (index=0; index<fileInfoPtr->numberTIFFOverviews; index++)"
+		
+	if (factor == 1)
+																							return;
+		
+	overviewFileInfoPtr = (FileInfoPtr)MNewPointer (sizeof (MFileInfo));
+	
+	if (overviewFileInfoPtr == NULL)
+																							return;
+	
+	*overviewFileInfoPtr = *fileInfoPtr;
+	overviewFileInfoPtr->numberColumns = tiffOverviewPtr[overviewIndex].numberColumns;
+	overviewFileInfoPtr->numberLines = tiffOverviewPtr[overviewIndex].numberLines;
+	overviewFileInfoPtr->hfaHandle = tiffOverviewPtr[overviewIndex].hfaHandle;
+	overviewFileInfoPtr->blockFormatIndex = 
+												tiffOverviewPtr[overviewIndex].blockFormatIndex;
+	overviewFileInfoPtr->tiffOverviewIndex = (UInt16)(overviewIndex + 1);
+	
+			// The tiled io buffer was allocated for the blocks of the full resolution
+			// image. The overview can only be used if its blocks fit in that buffer.
+	
+	if (GetSetTiledIOBufferBytes (fileIOInstructionsPtr->layerInfoPtr,
+											overviewFileInfoPtr,
+											(UInt16*)channelListPtr,
+											numberListChannels,
+											NULL) > 
+					GetSetTiledIOBufferBytes (fileIOInstructionsPtr->layerInfoPtr,
+														fileInfoPtr,
+														(UInt16*)channelListPtr,
+														numberListChannels,
+														NULL))
+		{
+		CheckAndDisposePtr ((Ptr)overviewFileInfoPtr);
+																							return;
+		
+		}	// end "if (GetSetTiledIOBufferBytes (..."
+	
+	GetHierarchalFilePointers (NULL, overviewFileInfoPtr);
+	
+	GetSetTiledIOBufferBytes (fileIOInstructionsPtr->layerInfoPtr,
+										overviewFileInfoPtr,
+										(UInt16*)channelListPtr,
+										numberListChannels,
+										fileIOInstructionsPtr->tiledBufferPtrs[0]);
+	
+	fileIOInstructionsPtr->tiffOverviewSavedFileInfoPtr = fileInfoPtr;
+	fileIOInstructionsPtr->tiffOverviewFileInfoPtr = overviewFileInfoPtr;
+	fileIOInstructionsPtr->tiffOverviewFactor = factor;
+	fileIOInstructionsPtr->fileInfoPtr = overviewFileInfoPtr;
+	
+			// Convert the area to the lines and columns of the overview. The
+			// number of lines and columns to be read does not change.
+			
+	*lineEndPtr = (*lineStartPtr - 1)/factor + 1 + 
+					((*lineEndPtr - *lineStartPtr)/ *lineIntervalPtr) * 
+																	(*lineIntervalPtr/factor);
+	*lineStartPtr = (*lineStartPtr - 1)/factor + 1;
+	*lineIntervalPtr /= factor;
+	
+	*columnEndPtr = (*columnStartPtr - 1)/factor + 1 + 
+					((*columnEndPtr - *columnStartPtr)/ *columnIntervalPtr) * 
+																	(*columnIntervalPtr/factor);
+	*columnStartPtr = (*columnStartPtr - 1)/factor + 1;
+	*columnIntervalPtr /= factor;
+	
+}	// end "SetUpTIFFOverviewFileIO"
+
+
+
+#if defined multispec_wx
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean SetUpMappedFileIO
+//
+//	Software purpose:	This routine memory maps the image files that are read
+//							directly (not through gdal or hdf routines) and are not byte
+//							swapped. GetLine will then copy lines from the mapping 
+//							instead of making seek and read calls. It also determines
+//							whether GetLineOfData can pack lines directly from the 
+//							mapping without the copy.
+//
+//	Parameters in:		File IO instructions structure
+//
+//	Parameters out:	None
+//
+// Value Returned:	TRUE if lines can be packed directly from the mapping.
+//
+// Called By:			SetUpFileIOInstructions in SFileIO.cpp
+
+Boolean SetUpMappedFileIO (
+				FileIOInstructionsPtr			fileIOInstructionsPtr)
+							
+{  
+	CMFileStream*						fileStreamPtr;
+	FileInfoPtr							fileInfoPtr,
+											localFileInfoPtr;
+	WindowInfoPtr						windowInfoPtr;
+	
+	UInt32								fileIndex,
+											numberImageFiles;
+	
+	
+	if (!gUseMemoryMappedIOFlag)
+																						return (FALSE);
+	
+	fileInfoPtr = fileIOInstructionsPtr->fileInfoPtr;
+	windowInfoPtr = fileIOInstructionsPtr->windowInfoPtr;
+	
+	numberImageFiles = 1;
+	if (windowInfoPtr != NULL)
+		numberImageFiles = windowInfoPtr->numberImageFiles;
+		
+	for (fileIndex=0; fileIndex<numberImageFiles; fileIndex++)
+		{
+		localFileInfoPtr = &fileInfoPtr[fileIndex];
+		
+		if (localFileInfoPtr->gdalDataSetH == NULL &&
+				!localFileInfoPtr->callGetHDFLineFlag &&
+					localFileInfoPtr->format != kGAIAType &&
+						!(localFileInfoPtr->swapBytesFlag && 
+													localFileInfoPtr->numberBytes >= 2))
+			{
+			fileStreamPtr = GetFileStreamPointer (localFileInfoPtr);
+			if (fileStreamPtr != NULL)
+				fileStreamPtr->MMapFile ();
+			
+			}	// end "if (localFileInfoPtr->gdalDataSetH == NULL && ..."
+		
+		}	// end "for (fileIndex=0; fileIndex<numberImageFiles; fileIndex++)"
+		
+			// Lines can be packed directly from the mapping when all requested 
+			// channels come from one read of one file and the data do not need
+			// to be changed in place after being read.
+	
+	if (numberImageFiles != 1)
+																						return (FALSE);
+																						
+	if (!fileIOInstructionsPtr->oneReadFlag && fileInfoPtr->bandInterleave != kBIS)
+																						return (FALSE);
+	
+	if (fileInfoPtr->blockedFlag ||
+			fileInfoPtr->nonContiguousStripsFlag ||
+				fileInfoPtr->numberBits == 4 ||
+					fileInfoPtr->treatLinesAsBottomToTopFlag ||
+						(gConvertSignedDataFlag && fileInfoPtr->signedDataFlag))
+																						return (FALSE);
+																						
+	fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
+	
+	return (fileStreamPtr != NULL && fileStreamPtr->GetMappedDataPointer (0, 1) != NULL);
+	
+}	// end "SetUpMappedFileIO"
+#endif	// defined multispec_wx
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -15911,6 +20518,169 @@ void Swap8Bytes (
 }	// end "Swap8Bytes"    
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void Unpack4BitData
+//
+//	Software purpose:	The purpose of this routine is to convert a line of 4-bit data
+//							to 8-bit data in place. The line is handled from the end back
+//							to the beginning. Note the lower sample number is in the lower 
+//							4 bits.
+//
+//	Parameters in:		Pointer to the line of data.
+//							Number of samples in the line.
+//							Number of bytes read for the line.
+//							Flag indicating whether the last sample is in the lower half of
+//								the last byte.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			AdjustReadData in SFileIO.cpp
+
+void Unpack4BitData (
+				HUCharPtr							fileIOBufferPtr,
+				UInt32								numberSamples,
+				UInt32								count,
+				Boolean								endHalfByte)
+
+{
+	HPtr									byte1Ptr;
+	HPtr									byte2Ptr;
+	
+	UInt32								samplesLeft;
+	
+	#if include_simd_capability
+		UInt32								numberSamplesDone;
+	#endif	// include_simd_capability
+	
+	
+			// If number of samples is odd, convert the odd one and then	
+			// loop through the samples two at a time.							
+	
+	samplesLeft = numberSamples;
+	byte1Ptr = (HPtr)&fileIOBufferPtr[samplesLeft-1];
+	byte2Ptr = (HPtr)&fileIOBufferPtr[count-1];
+	if (endHalfByte)
+		{
+		*byte1Ptr = *byte2Ptr & 0x0f;
+				
+		samplesLeft--;
+		byte1Ptr--;
+		byte2Ptr--;
+				
+		}	// end "if (halfByteFlag)" 
+		
+	#if include_simd_capability
+		if (GetSIMDLevel () >= kSIMDSSE41)
+			{
+			numberSamplesDone = Unpack4BitDataSSE41 ((HUCharPtr)byte1Ptr,
+																	(HUCharPtr)byte2Ptr,
+																	samplesLeft,
+																	fileIOBufferPtr);
+																	
+			samplesLeft -= numberSamplesDone;
+			byte1Ptr -= numberSamplesDone;
+			byte2Ptr -= numberSamplesDone/2;
+			
+			}	// end "if (GetSIMDLevel () >= kSIMDSSE41)"
+	#endif	// include_simd_capability
+		
+	while (samplesLeft >= 2)
+		{
+				// Move high 4 bits.														
+				
+		*byte1Ptr = (*byte2Ptr & 0xf0)>>4;
+		
+		samplesLeft--;
+		byte1Ptr--;
+		
+				// Move low 4 bits.														
+		
+		*byte1Ptr = *byte2Ptr & 0x0f;
+		
+		samplesLeft--;
+		byte1Ptr--;
+		byte2Ptr--;
+		
+		}	// end "while (samplesLeft >= 0)" 
+		
+	if (samplesLeft)
+		*byte1Ptr = (*byte2Ptr & 0xf0)>>4;
+	
+}	// end "Unpack4BitData"
+
+
+
+#if include_simd_capability
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		UInt32 Unpack4BitDataSSE41
+//
+//	Software purpose:	The purpose of this routine is to convert 4-bit data to 8-bit
+//							data in place using SSE4.1 instructions, 16 input bytes at a 
+//							time, working from the end of the line back. It stops when the
+//							output for the next 16 bytes would overwrite input bytes that
+//							have not been loaded yet. The rest of the line is done by the
+//							scalar code in Unpack4BitData.
+//
+//	Parameters in:		Pointer to the last output byte.
+//							Pointer to the last input byte.
+//							Number of samples left to unpack.
+//							Pointer to the start of the line.
+//
+//	Parameters out:	None
+//
+// Value Returned:	Number of samples unpacked; a multiple of 32.
+//
+// Called By:			Unpack4BitData in SFileIO.cpp
+
+SIMD_TARGET_SSE41
+UInt32 Unpack4BitDataSSE41 (
+				HUCharPtr							byte1Ptr,
+				HUCharPtr							byte2Ptr,
+				UInt32								samplesLeft,
+				HUCharPtr							fileIOBufferPtr)
+
+{
+	__m128i								highValues,
+											lowMask,
+											lowValues,
+											values;
+	
+	UInt32								numberSamplesDone = 0;
+	
+	
+	lowMask = _mm_set1_epi8 (0x0f);
+	
+	while (samplesLeft - numberSamplesDone >= 32 && 
+				byte2Ptr - fileIOBufferPtr >= 15 &&
+					byte1Ptr - byte2Ptr >= 16)
+		{
+		values = _mm_loadu_si128 ((__m128i*)(byte2Ptr - 15));
+		lowValues = _mm_and_si128 (values, lowMask);
+		highValues = _mm_and_si128 (_mm_srli_epi16 (values, 4), lowMask);
+		
+		_mm_storeu_si128 ((__m128i*)(byte1Ptr - 15), 
+								_mm_unpackhi_epi8 (lowValues, highValues));
+		_mm_storeu_si128 ((__m128i*)(byte1Ptr - 31), 
+								_mm_unpacklo_epi8 (lowValues, highValues));
+		
+		byte1Ptr -= 32;
+		byte2Ptr -= 16;
+		numberSamplesDone += 32;
+		
+		}	// end "while (samplesLeft - numberSamplesDone >= 32 && ..."
+	
+	return (numberSamplesDone);
+	
+}	// end "Unpack4BitDataSSE41"
+#endif	// include_simd_capability
+
+
 
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
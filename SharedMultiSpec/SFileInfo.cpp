@@ -225,6 +225,10 @@ void CloseImageFile (
 		
 		fileInfoPtr->mapProjectionHandle = 
 									DisposeMapProjectionHandle (fileInfoPtr->mapProjectionHandle);
+		
+		fileInfoPtr->tiffOverviewHandle = 
+									DisposeTIFFOverviewHandle (fileInfoPtr->tiffOverviewHandle);
+		fileInfoPtr->numberTIFFOverviews = 0;
 												
 		fileInfoPtr->hfaPtr = NULL;
 		fileInfoPtr->blockFormatPtr = NULL;
@@ -1307,6 +1311,7 @@ Handle InitializeFileInfoStructure (
 		fileInfoPtr->hdfHandle = NULL;
 		fileInfoPtr->hfaHandle = NULL;
 		fileInfoPtr->mapProjectionHandle = NULL;
+		fileInfoPtr->tiffOverviewHandle = NULL;
 		
 		fileInfoPtr->hdf4FileID = 0;
 		fileInfoPtr->hdf5FileID = 0;
@@ -1361,6 +1366,9 @@ Handle InitializeFileInfoStructure (
 		fileInfoPtr->numberBytes = 1;
 		fileInfoPtr->numberChannels = 1;
 		fileInfoPtr->numberGroups = 0;
+		fileInfoPtr->predictorCode = 1;
+		fileInfoPtr->numberTIFFOverviews = 0;
+		fileInfoPtr->tiffOverviewIndex = 0;
 
 		fileInfoPtr->asciiSymbols = FALSE;
 		fileInfoPtr->blockedFlag = FALSE;
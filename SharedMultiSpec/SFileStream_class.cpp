@@ -45,6 +45,10 @@
 #include "SImageWindow_class.h"
 							  
 #if defined multispec_wx
+	#include <errno.h>
+	#include <sys/mman.h>
+	#include <unistd.h>
+
 	#define dupFNErr				-48
 #endif	// defined multispec_wx
 
@@ -276,6 +280,9 @@ CMFileStream::CMFileStream (
 CMFileStream::~CMFileStream ()
 
 {               
+	#if defined multispec_wx
+		MUnmapFile ();
+	#endif	// defined multispec_wx
 
 }	// end "~CMFileStream" 
 
@@ -976,6 +983,41 @@ UInt16 CMFileStream::GetFileUTF8PathLength ()
 
 
 
+#if defined multispec_wx
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		HUCharPtr GetMappedDataPointer
+//
+//	Software purpose:	The purpose of this routine is to return a pointer to the 
+//							requested bytes in the memory mapping of the file.
+//		
+//	Parameters in:		Offset from the start of the file.
+//							Number of bytes that will be accessed.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	Pointer to the data in the mapping or NULL if the file is not
+//							mapped or the bytes are not all within the mapping.
+//
+// Called By:			GetLine in SFileIO.cpp
+//							GetMappedLine in SFileIO.cpp
+
+HUCharPtr CMFileStream::GetMappedDataPointer (
+				SInt64								offset,
+				UInt32								numberBytes)
+                      
+{
+	if (mMappedDataPtr == NULL || offset < 0 || offset + numberBytes > mMappedLength)
+																						return (NULL);
+	
+	return (&mMappedDataPtr[offset]);
+	
+}	// end "GetMappedDataPointer"
+#endif	// defined multispec_wx
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -1061,6 +1103,11 @@ void CMFileStream::InitializeMembers ()
 
 	mCreator = -1;
 	mFileType = -1;
+	
+	#if defined multispec_wx
+		mMappedDataPtr = NULL;
+		mMappedLength = 0;
+	#endif	// defined multispec_wx
 			
 }	// end "GetPathFileLength"
 
@@ -1125,6 +1172,10 @@ void CMFileStream:: IOCheck (
 void CMFileStream::MCloseFile (void)
                       
 {			
+			// Release any blocks for this file in the tile cache.
+			
+	ReleaseTileCacheEntries (this);
+	
 	#if defined multispec_win 
 		TRY
 			{ 
@@ -1142,6 +1193,8 @@ void CMFileStream::MCloseFile (void)
 	#endif	// defined multispec_win
    
 	#if defined multispec_wx
+		MUnmapFile ();
+		
 		if (IsOpened ())
 			Close ();
 	#endif
@@ -1468,6 +1521,59 @@ SInt16 CMFileStream::MGetSizeOfFile (
 
 
 
+#if defined multispec_wx
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 MMapFile
+//
+//	Software purpose:	The purpose of this routine is to map the entire file into
+//							memory read only so that lines of data can be accessed 
+//							directly from the page cache instead of being copied by
+//							read calls. The mapping is shared so that other processes 
+//							reading the same file share the pages.
+//		
+//	Parameters in:		None
+//
+//	Parameters out:	None
+//
+//	Value Returned:	Error code. The file is just read normally if the mapping
+//							could not be made.
+//
+// Called By:			SetUpMappedFileIO in SFileIO.cpp
+
+SInt16 CMFileStream::MMapFile (void)
+                      
+{
+	void*									mappedPtr;
+	
+	wxFileOffset						fileLength;
+	
+	
+	if (mMappedDataPtr != NULL)
+																					return (noErr);
+																					
+	if (!IsOpened ())
+																					return (-1);
+	
+	fileLength = Length ();
+	if (fileLength <= 0 || (UInt64)fileLength > (UInt64)SIZE_MAX)
+																					return (-1);
+	
+	mappedPtr = mmap (NULL, (size_t)fileLength, PROT_READ, MAP_SHARED, fd (), 0);
+	if (mappedPtr == MAP_FAILED)
+																					return (-1);
+	
+	mMappedDataPtr = (HUCharPtr)mappedPtr;
+	mMappedLength = fileLength;
+	
+	return (noErr);
+		
+}	// end "MMapFile"
+#endif	// defined multispec_wx
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -1784,6 +1890,77 @@ SInt16 CMFileStream::MReadData (
 
 
 
+#if defined multispec_wx
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 MReadDataAtPosition
+//
+//	Software purpose:	The purpose of this routine is to read the requested number
+//							of bytes starting at the given position in the file. The file
+//							marker is not used or changed so several threads can read
+//							from the same open file at the same time without opening
+//							another handle for the file.
+//
+//	Parameters in:		Position in the file of the first byte to read
+//							Pointer to the buffer to copy the data to
+//							Number of bytes to read.
+//
+//	Parameters out:	Number of bytes actually read
+//
+//	Value Returned:	Error code
+// 
+// Called By:			ReadLinesBufferRange in SFileIO.cpp
+                      
+SInt16 CMFileStream::MReadDataAtPosition (
+				SInt64								inOffset,
+				void									*outBufferPtr,
+				UInt32								*numberBytesPtr)
+                    
+{
+	ssize_t								linuxBytesRead;
+	
+	UInt32								bytesRead = 0;
+	SInt16								errCode = noErr;
+	
+	
+	if (IsOpened ())
+		{
+		while (bytesRead < *numberBytesPtr)
+			{
+			linuxBytesRead = pread (fd (), 
+											&((HUCharPtr)outBufferPtr)[bytesRead],
+											(size_t)(*numberBytesPtr - bytesRead),
+											(off_t)(inOffset + bytesRead));
+			
+			if (linuxBytesRead < 0 && errno == EINTR)
+				continue;
+			
+			if (linuxBytesRead <= 0)
+				{
+				errCode = eofErr;
+				break;
+				
+				}	// end "if (linuxBytesRead <= 0)"
+				
+			bytesRead += (UInt32)linuxBytesRead;
+			
+			}	// end "while (bytesRead < *numberBytesPtr)"
+		
+		}	// end "if (IsOpened ())"
+		
+	else	// !IsOpened ()
+		errCode = -1;
+	
+	*numberBytesPtr = bytesRead;
+					
+	return (errCode);
+  
+}	// end "MReadDataAtPosition"
+#endif	// defined multispec_wx
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -1891,6 +2068,10 @@ SInt16 CMFileStream::MSetSizeOfFile (
 	
 	
 	#if defined multispec_wx
+				// Any memory mapping would no longer match the file size.
+				
+		MUnmapFile ();
+		
 		errCode = ftruncate (fd (), countBytes); 
 	#endif	// defined multispec_wx
 
@@ -1918,6 +2099,42 @@ SInt16 CMFileStream::MSetSizeOfFile (
 
 
 
+#if defined multispec_wx
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void MUnmapFile
+//
+//	Software purpose:	The purpose of this routine is to release the memory mapping
+//							of the file if one exists.
+//		
+//	Parameters in:		None
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None
+//
+// Called By:			~CMFileStream
+//							MCloseFile
+//							MSetSizeOfFile
+
+void CMFileStream::MUnmapFile (void)
+                      
+{
+	if (mMappedDataPtr != NULL)
+		{
+		munmap (mMappedDataPtr, (size_t)mMappedLength);
+		
+		mMappedDataPtr = NULL;
+		mMappedLength = 0;
+		
+		}	// end "if (mMappedDataPtr != NULL)"
+		
+}	// end "MUnmapFile"
+#endif	// defined multispec_wx
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
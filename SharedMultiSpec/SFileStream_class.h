@@ -102,6 +102,12 @@
 			
 			UInt16 GetFileUTF8PathLength (void);
 			
+			#if defined multispec_wx
+				HUCharPtr GetMappedDataPointer (
+					SInt64								offset,
+					UInt32								numberBytes);
+			#endif	// defined multispec_wx
+			
 			int GetPathFileLength (
 				SInt16								returnCode);
 			
@@ -124,6 +130,10 @@
 			
 			SInt16 MGetSizeOfFile (
 				SInt64								*countPtr);
+			
+			#if defined multispec_wx
+				SInt16 MMapFile (void);
+			#endif	// defined multispec_wx
 										
 			SInt16 MOpenFile (
 				UInt16								readWriteCode,
@@ -137,6 +147,13 @@
 				void									*outBuffer,
 				UInt32								*numberBytesPtr,
 				SInt16								messageCode);
+			
+			#if defined multispec_wx
+				SInt16 MReadDataAtPosition (
+					SInt64								inOffset,
+					void									*outBufferPtr,
+					UInt32								*numberBytesPtr);
+			#endif	// defined multispec_wx
 				 
 			SInt16 MSetMarker(
 				SInt64								inOffset,
@@ -145,6 +162,10 @@
 										
 			SInt16 MSetSizeOfFile (
 				SInt64								countBytes);
+			
+			#if defined multispec_wx
+				void MUnmapFile (void);
+			#endif	// defined multispec_wx
 										            
 			SInt16 MWriteData (
 				void									*inBufferPtr,
@@ -209,6 +230,11 @@
 				UInt8						mUTF8FilePathName[_MAX_PATH];
 				long						m_spaceFiller2;
 				UInt8						mUTF8FileName[_MAX_FILE];
+				
+					// Read only memory mapping of the entire file. mMappedDataPtr is
+					// NULL if the file has not been mapped.
+				HUCharPtr				mMappedDataPtr;
+				SInt64					mMappedLength;
 			#endif	// defined multispec_wx
 									
 		protected:
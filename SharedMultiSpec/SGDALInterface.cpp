@@ -1170,10 +1170,15 @@ GDALDatasetH GetGDALFileReference (
 		{
 		hDS = (GDALDatasetH)hdfDataSetsPtr[dataSet].sdid;
 		
-		if (hDS == 0 && (format == kHDF5Type || format == kNITFType))
+		if (hDS == 0 && (format == kHDF5Type ||
+									format == kNETCDF2Type ||
+										format == kHDF4Type2 ||
+											format == kNITFType))
 			{
 					// Get a reference to the data set. It may not have been set in the
-					// beginning. This is to handle case with slow irods fuse mount.
+					// beginning. This is to handle case with slow irods fuse mount and
+					// the case when the data set descriptions were read from the
+					// data set index file.
 					
 			//metadata = ((GDALDataset*)fileHDS)->GetMetadata ("SUBDATASETS");
 			metadata = GDALGetMetadata (fileHDS, "SUBDATASETS");
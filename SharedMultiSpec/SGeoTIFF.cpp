@@ -42,15 +42,37 @@
 
 #include 	"errno.h"
 
+#if include_zlib_capability
+	#include <zlib.h>
+#endif	// include_zlib_capability
+
 	// MultiSpec tiff code will be used for large file sizes. GDAL is very slow when
 	// reading large files particular when the files are not striped.
 #define use_multispec_tiffcode	1	
+
+	// Codes used for decompressing LZW compressed TIFF data.
+#define	kLZWClearCode						256
+#define	kLZWEndOfInformationCode		257
+#define	kLZWFirstCode						258
+#define	kLZWNoCode							0xFFFF
+#define	kLZWTableSize						4096
+
+	// Size of the hash table used to find the codes for strings when compressing
+	// data with the LZW method.
+#define	kLZWHashTableSize					9001
 							
 							
 
 			// Prototypes for routines in this file that are only called by		
 			// other routines in this file.		
 
+void	ApplyTIFFPredictor (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							bufferPtr,
+				UInt32								numberRows,
+				UInt32								numberRowBytes,
+				HUCharPtr							rowBufferPtr);
+
 SInt16	CheckRowsPerStrip (
 				FileInfoPtr							fileInfoPtr,
 				CMFileStream* 						fileStreamPtr,
@@ -62,6 +84,45 @@ SInt16	CheckRowsPerStrip (
 				UInt32								stripByteCountType,
 				UInt32								stripByteCountVector);
 
+#if include_zlib_capability
+	SInt16	DecodeTIFFDeflateData (
+					HUCharPtr							inputBufferPtr,
+					UInt32								numberInputBytes,
+					HUCharPtr							outputBufferPtr,
+					UInt32								numberOutputBytes,
+					UInt32*								numberBytesDecodedPtr);
+#endif	// include_zlib_capability
+
+SInt16	DecodeTIFFLZWData (
+				HUCharPtr							inputBufferPtr,
+				UInt32								numberInputBytes,
+				HUCharPtr							outputBufferPtr,
+				UInt32								numberOutputBytes,
+				UInt32*								numberBytesDecodedPtr);
+
+SInt16	DecodeTIFFPackBitsData (
+				HUCharPtr							inputBufferPtr,
+				UInt32								numberInputBytes,
+				HUCharPtr							outputBufferPtr,
+				UInt32								numberOutputBytes,
+				UInt32*								numberBytesDecodedPtr);
+
+#if include_zlib_capability
+	SInt16	EncodeTIFFDeflateData (
+					HUCharPtr							inputBufferPtr,
+					UInt32								numberInputBytes,
+					HUCharPtr							outputBufferPtr,
+					UInt32								numberOutputBytes,
+					UInt32*								numberBytesEncodedPtr);
+#endif	// include_zlib_capability
+
+SInt16	EncodeTIFFLZWData (
+				HUCharPtr							inputBufferPtr,
+				UInt32								numberInputBytes,
+				HUCharPtr							outputBufferPtr,
+				UInt32								numberOutputBytes,
+				UInt32*								numberBytesEncodedPtr);
+
 SInt16	GetBlockSizesVector (
 				CMFileStream*						fileStreamPtr,
 				UInt32**								blockSizesPtrPtr,
@@ -113,6 +174,18 @@ Boolean	ListGeoTiffTextDescriptionParameters (
 				TIFF_IFD_Ptr						geoAsciiStringPtr,
 				Boolean*								addBlankLineFlagPtr);
 
+SInt16	LoadCompressedTIFFStructure (
+				FileInfoPtr 						fileInfoPtr,
+				CMFileStream* 						fileStreamPtr,
+				UInt32								blockWidth,
+				UInt32								blockHeight,
+				UInt32								numberBlockOffsets,
+				UInt32								blockOffsetType,
+				UInt32								blockOffsetVector,
+				UInt32								numberBlockByteCounts,
+				UInt32								blockByteCountType,
+				UInt32								blockByteCountVector);
+
 SInt16	LoadHierarchalFileStructure (
 				FileInfoPtr 						fileInfoPtr,
 				UInt32								numberBlocks,
@@ -123,10 +196,24 @@ SInt16	LoadHierarchalFileStructure (
 				UInt32								lastBytesPerStrip,
 				UInt32								bytesPerStripForAllChannels);
 
+void	LoadTIFFOverviewStructures (
+				FileInfoPtr 						fileInfoPtr,
+				CMFileStream* 						fileStreamPtr,
+				char*									headerRecordPtr,
+				UInt32								ifdOffset);
+
 SInt16 	SetGeoProjectionFromGeoTIFF (
 				FileInfoPtr							fileInfoPtr,
 				TIFF_IFD_Ptr						imageFileDirectoryPtr);
 
+void	PutTIFFLZWCode (
+				UInt32								code,
+				UInt32								codeWidth,
+				UInt32*								bitBufferPtr,
+				UInt32*								numberBitsInBufferPtr,
+				HUCharPtr							outputBufferPtr,
+				UInt32*								outputIndexPtr);
+
 void	SetGeoTiePointsForRasterPixelType (
 				FileInfoPtr							fileInfoPtr,
 				UInt16								rasterTypeGeoKey);
@@ -143,9 +230,205 @@ SInt16	SetModelTransformationParametersFromGeoTIFF (
 SInt16	SetPixelScaleParametersFromGeoTIFF (
 				FileInfoPtr							fileInfoPtr,
 				TIFF_IFD_Ptr						imageFileDirectoryPtr);
+
+void	UndoTIFFPredictor (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							bufferPtr,
+				UInt32								numberRows,
+				UInt32								numberRowBytes,
+				HUCharPtr							rowBufferPtr);
 							
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void ApplyTIFFPredictor
+//
+//	Software purpose:	The purpose of this routine is to apply the horizontal 
+//							differencing (predictor 2) or floating point horizontal
+//							differencing (predictor 3) to the rows of a TIFF block before
+//							it is compressed. This is the reverse of UndoTIFFPredictor.
+//							The data are in the byte order of the file.
+//
+//	Parameters in:		File information structure pointer.
+//							Pointer to the block to be compressed.
+//							Number of rows in the block.
+//							Number of bytes in one row.
+//							Pointer to buffer for one row of data. Only used for the
+//								floating point predictor.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None
+// 
+// Called By:			EncodeTIFFBlock in SGeoTIFF.cpp
+
+void ApplyTIFFPredictor (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							bufferPtr,
+				UInt32								numberRows,
+				UInt32								numberRowBytes,
+				HUCharPtr							rowBufferPtr)
+
+{
+	HUCharPtr							rowPtr;
+	
+	UInt32								byte,
+											index,
+											numberBytes,
+											numberRowSamples,
+											row,
+											sample,
+											samplesPerPixel;
+	
+	Boolean								bigEndianFileFlag;
+	
+	
+	numberBytes = fileInfoPtr->numberBytes;
+	numberRowSamples = numberRowBytes / numberBytes;
+	
+	samplesPerPixel = 1;
+	if (fileInfoPtr->bandInterleave == kBIS)
+		samplesPerPixel = fileInfoPtr->numberChannels;
+		
+	bigEndianFileFlag = (fileInfoPtr->swapBytesFlag != gBigEndianFlag);
+	
+	for (row=0; row<numberRows; row++)
+		{
+		rowPtr = &bufferPtr[(SInt64)row*numberRowBytes];
+		
+		if (fileInfoPtr->predictorCode == 2)
+			{
+					// The differences are done in the byte order of this computer 
+					// starting at the end of the row.
+					
+			if (fileInfoPtr->swapBytesFlag && numberBytes > 1)
+				SwapBytes ((SInt16)numberBytes, (HUInt8Ptr)rowPtr, numberRowSamples);
+			
+			switch (numberBytes)
+				{
+				case 1:
+					for (index=numberRowSamples-1; index>=samplesPerPixel; index--)
+						rowPtr[index] -= rowPtr[index-samplesPerPixel];
+					break;
+					
+				case 2:
+					{
+					HUInt16Ptr twoBytePtr = (HUInt16Ptr)rowPtr;
+					for (index=numberRowSamples-1; index>=samplesPerPixel; index--)
+						twoBytePtr[index] -= twoBytePtr[index-samplesPerPixel];
+					break;
+					
+					}	// end "case 2"
+					
+				case 4:
+					{
+					HUInt32Ptr fourBytePtr = (HUInt32Ptr)rowPtr;
+					for (index=numberRowSamples-1; index>=samplesPerPixel; index--)
+						fourBytePtr[index] -= fourBytePtr[index-samplesPerPixel];
+					break;
+					
+					}	// end "case 4"
+					
+				case 8:
+					{
+					unsigned long long* eightBytePtr = (unsigned long long*)rowPtr;
+					for (index=numberRowSamples-1; index>=samplesPerPixel; index--)
+						eightBytePtr[index] -= eightBytePtr[index-samplesPerPixel];
+					break;
+					
+					}	// end "case 8"
+					
+				}	// end "switch (numberBytes)"
+			
+			if (fileInfoPtr->swapBytesFlag && numberBytes > 1)
+				SwapBytes ((SInt16)numberBytes, (HUInt8Ptr)rowPtr, numberRowSamples);
+			
+			}	// end "if (fileInfoPtr->predictorCode == 2)"
+			
+		else	// fileInfoPtr->predictorCode == 3
+			{
+					// The bytes for the row are stored with the most significant bytes
+					// for all samples first, followed by the next most significant 
+					// bytes and so on. Then the bytes are differenced.
+					
+			for (sample=0; sample<numberRowSamples; sample++)
+				{
+				for (byte=0; byte<numberBytes; byte++)
+					{
+					if (bigEndianFileFlag)
+						rowBufferPtr[byte*numberRowSamples + sample] =
+													rowPtr[sample*numberBytes + byte];
+						
+					else	// !bigEndianFileFlag
+						rowBufferPtr[byte*numberRowSamples + sample] =
+													rowPtr[sample*numberBytes + numberBytes - 1 - byte];
+					
+					}	// end "for (byte=0; byte<numberBytes; byte++)"
+					
+				}	// end "for (sample=0; sample<numberRowSamples; sample++)"
+				
+			BlockMoveData (rowBufferPtr, rowPtr, numberRowBytes);
+			
+			for (index=numberRowBytes-1; index>=samplesPerPixel; index--)
+				rowPtr[index] -= rowPtr[index-samplesPerPixel];
+			
+			}	// end "else fileInfoPtr->predictorCode == 3"
+			
+		}	// end "for (row=0; row<numberRows; row++)"
+	
+}	// end "ApplyTIFFPredictor"
+
+
+
 #if use_multispec_tiffcode
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean CheckIfTIFFCompressionCanBeRead
+//
+//	Software purpose:	The purpose of this routine is to determine whether the 
+//							MultiSpec TIFF routines can decompress data with the input
+//							compression code.
+//
+//	Parameters in:		Data compression code (kLZWCompression, etc.)
+//
+//	Parameters out:	None
+//
+//	Value Returned:	TRUE if the data can be decompressed.
+//							FALSE if not.
+// 
+// Called By:			ReadTIFFHeader in SGeoTIFF.cpp
+//							LoadImageFileInformation in SOpenImage.cpp
+
+Boolean CheckIfTIFFCompressionCanBeRead (
+				UInt16								dataCompressionCode)
+
+{
+	Boolean								canBeReadFlag = FALSE;
+	
+	
+	switch (dataCompressionCode)
+		{
+		case kLZWCompression:
+		case kPackBitsCompression:
+			canBeReadFlag = TRUE;
+			break;
+			
+		#if include_zlib_capability
+			case kDeflateCompression:
+				canBeReadFlag = TRUE;
+				break;
+		#endif	// include_zlib_capability
+			
+		}	// end "switch (dataCompressionCode)"
+		
+	return (canBeReadFlag);
+	
+}	// end "CheckIfTIFFCompressionCanBeRead"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -436,555 +719,1361 @@ SInt16 CheckRowsPerStrip (
 	return (returnCode);
 	
 }	// end "CheckRowsPerStrip" 
-  
+
 
 
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Function name:		SInt16 GetBlockSizesVector
-//
-//	Software purpose:	The purpose of this routine is to read the block sizes vector.
-//
-//	Parameters in:		None
+//	Function name:		SInt16 DecodeTIFFBlock
+//
+//	Software purpose:	The purpose of this routine is to decompress one strip or tile
+//							of a compressed TIFF file and undo the predictor if one was
+//							used. The decompressed data are left in the byte order of the
+//							file. Any part of the block not in the compressed data, as for
+//							the last strip in the image, is set to 0. 
+//							This routine may be called from more than one thread at a time
+//							so no memory is allocated and no messages are displayed here.
+//
+//	Parameters in:		File information structure pointer.
+//							Pointer to the compressed data.
+//							Number of bytes of compressed data.
+//							Pointer to the buffer for the decompressed data.
+//							Number of bytes in a decompressed block.
+//							Number of bytes in one row of the block.
+//							Pointer to buffer for one row of data. Only used for the
+//								floating point predictor.
 //
 //	Parameters out:	None
 //
-//	Value Returned:	None				
+//	Value Returned:	noErr if the block was decompressed.
+//							-1 if the compressed data could not be decompressed.
 // 
-// Called By:			
-//
-//	Coded By:			Larry L. Biehl			Date: 02/07/2007
-//	Revised By:			Larry L. Biehl			Date: 06/01/2011
-
-SInt16 GetBlockSizesVector (
-				CMFileStream*						fileStreamPtr,
-				UInt32**								blockSizesPtrPtr,
-				UInt32								numberStripByteCounts,
-				UInt32								stripByteCountType,
-				UInt32								stripByteCountVector)
+// Called By:			DecodeCompressedBlock in SFileIO.cpp
 
-{	
-	UInt32*								localBlockSizesPtr;
-	
-	SInt32								stripByteCount;
-	
-	UInt32								bytesToRead,
-											count,
-											index;
-	
-	SInt16								errCode,
-											returnCode;
-	
-	
-	errCode = noErr;
-	returnCode = 0;
+SInt16 DecodeTIFFBlock (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							inputBufferPtr,
+				UInt32								numberInputBytes,
+				HUCharPtr							outputBufferPtr,
+				UInt32								numberOutputBytes,
+				UInt32								numberRowBytes,
+				HUCharPtr							rowBufferPtr)
 
-			// Get memory to store the block (strip) size values in.  If no
-			// memory is available then we cannot continue with this.
-			
-	*blockSizesPtrPtr =
-				(UInt32*)MNewPointer ((SInt64)numberStripByteCounts * sizeof (UInt32));
-	if (*blockSizesPtrPtr == NULL)
-		errCode = -1;
+{
+	UInt32								numberBytesDecoded = 0;
 	
-	if (errCode == noErr)
-		errCode = MSetMarker (fileStreamPtr, 
-										fsFromStart, 
-										stripByteCountVector,
-										kErrorMessages);
-								
-	bytesToRead = 2;
-	if (stripByteCountType == kTIFFLong)	
-		bytesToRead = 4;
+	SInt16								returnCode = -1;
 	
-	localBlockSizesPtr = *blockSizesPtrPtr;
 	
-	for (index=0; index<numberStripByteCounts; index++)
+	switch (fileInfoPtr->dataCompressionCode)
 		{
-		count = (UInt32)bytesToRead;
-		stripByteCount = 0;
-		
-		if (errCode == noErr)
-			errCode = MReadData (fileStreamPtr, 
-											&count, 
-											&stripByteCount,
-											kErrorMessages);
+		case kLZWCompression:
+			returnCode = DecodeTIFFLZWData (inputBufferPtr,
+														numberInputBytes,
+														outputBufferPtr,
+														numberOutputBytes,
+														&numberBytesDecoded);
+			break;
 			
-		if (errCode != noErr)
+		case kPackBitsCompression:
+			returnCode = DecodeTIFFPackBitsData (inputBufferPtr,
+																numberInputBytes,
+																outputBufferPtr,
+																numberOutputBytes,
+																&numberBytesDecoded);
 			break;
 			
-		localBlockSizesPtr[index] = (UInt32)GetLongIntValue ((char*)&stripByteCount);
+		#if include_zlib_capability
+			case kDeflateCompression:
+				returnCode = DecodeTIFFDeflateData (inputBufferPtr,
+																numberInputBytes,
+																outputBufferPtr,
+																numberOutputBytes,
+																&numberBytesDecoded);
+				break;
+		#endif	// include_zlib_capability
+			
+		}	// end "switch (fileInfoPtr->dataCompressionCode)"
 		
-		}	// end "for (index=0; index<numberStripByteCounts; index++)"
+	if (returnCode == noErr)
+		{
+		if (numberBytesDecoded < numberOutputBytes)
+			memset (&outputBufferPtr[numberBytesDecoded], 
+						0, 
+						numberOutputBytes - numberBytesDecoded);
 		
-	if (errCode != noErr)
-		returnCode = -8;
+		if (fileInfoPtr->predictorCode > 1 && numberRowBytes > 0)
+			UndoTIFFPredictor (fileInfoPtr,
+										outputBufferPtr,
+										numberBytesDecoded/numberRowBytes,
+										numberRowBytes,
+										rowBufferPtr);
+		
+		}	// end "if (returnCode == noErr)"
 		
 	return (returnCode);
 	
-}	// end "GetBlockSizesVector" 	
-#endif	// use_multispec_tiffcode
-  
+}	// end "DecodeTIFFBlock"
 
 
+
+#if include_zlib_capability
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Function name:		SInt16 GetGeoASCIIStringFromGeoTIFF
+//	Function name:		SInt16 DecodeTIFFDeflateData
 //
-//	Software purpose:	The purpose of this routine is to get the text information in
-//							the GEOTIFF tag.
+//	Software purpose:	The purpose of this routine is to decompress a block of TIFF
+//							data that was compressed with the Deflate (zlib) method.
 //
-//	Parameters in:		None
+//	Parameters in:		Pointer to the compressed data.
+//							Number of bytes of compressed data.
+//							Pointer to the buffer for the decompressed data.
+//							Size of the buffer for the decompressed data.
 //
-//	Parameters out:	None
+//	Parameters out:	Number of bytes that were decompressed.
 //
-//	Value Returned:	error code
+//	Value Returned:	noErr if the data were decompressed; -1 if not.
 // 
-// Called By:			
-//
-//	Coded By:			Larry L. Biehl			Date: 02/18/2012
-//	Revised By:			Larry L. Biehl			Date: 02/18/2012
+// Called By:			DecodeTIFFBlock in SGeoTIFF.cpp
 
-SInt16 GetGeoASCIIStringFromGeoTIFF (
-				FileInfoPtr							fileInfoPtr,
-				char*									geoASCIIStringPtr,
-				UInt32								stringLengthLimit)
+SInt16 DecodeTIFFDeflateData (
+				HUCharPtr							inputBufferPtr,
+				UInt32								numberInputBytes,
+				HUCharPtr							outputBufferPtr,
+				UInt32								numberOutputBytes,
+				UInt32*								numberBytesDecodedPtr)
 
 {
-	TIFFImageFileDirectory			tiffFileDirectory;
+	z_stream								zStream;
 	
-								
-	if (GetSpecifiedTIFFKeyDirectory (fileInfoPtr,
-													34737,
-													&tiffFileDirectory))
-		GetGeoASCIIStringFromGeoTIFF (fileInfoPtr,
-													&tiffFileDirectory,
-													geoASCIIStringPtr,
-													stringLengthLimit);
+	int									zlibReturnCode;
+	
+	
+	*numberBytesDecodedPtr = 0;
+	
+	memset (&zStream, 0, sizeof (z_stream));
+	zStream.next_in = (Bytef*)inputBufferPtr;
+	zStream.avail_in = numberInputBytes;
+	zStream.next_out = (Bytef*)outputBufferPtr;
+	zStream.avail_out = numberOutputBytes;
+	
+	if (inflateInit (&zStream) != Z_OK)
+																							return (-1);
+	
+	zlibReturnCode = inflate (&zStream, Z_FINISH);
+	
+	*numberBytesDecodedPtr = numberOutputBytes - zStream.avail_out;
+	
+	inflateEnd (&zStream);
+	
+			// Z_BUF_ERROR is returned when the output buffer is filled before the
+			// end of the compressed stream is reached. This is not an error for
+			// the purposes here.
+			
+	if (zlibReturnCode == Z_STREAM_END || 
+								(zlibReturnCode == Z_BUF_ERROR && zStream.avail_out == 0))
+																							return (noErr);
 		
-	return (noErr);
+	return (-1);
 	
-}	// end "GetGeoASCIIStringFromGeoTIFF"
-  
+}	// end "DecodeTIFFDeflateData"
+#endif	// include_zlib_capability
+
 
 
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Function name:		SInt16 GetGeoASCIIStringFromGeoTIFF
+//	Function name:		SInt16 DecodeTIFFLZWData
 //
-//	Software purpose:	The purpose of this routine is to get the textinformation in 
-//							the GEOTIFF tag.
+//	Software purpose:	The purpose of this routine is to decompress a block of TIFF
+//							data that was compressed with the LZW method as described in
+//							the TIFF 6.0 specification. The codes are stored most 
+//							significant bit first and the code width increases one code
+//							early. The old style (bit reversed) LZW compression used by 
+//							some files written before TIFF 5.0 is not handled.
 //
-//	Parameters in:		None
+//	Parameters in:		Pointer to the compressed data.
+//							Number of bytes of compressed data.
+//							Pointer to the buffer for the decompressed data.
+//							Size of the buffer for the decompressed data.
 //
-//	Parameters out:	None
+//	Parameters out:	Number of bytes that were decompressed.
 //
-//	Value Returned:	None				
+//	Value Returned:	noErr if the data were decompressed; -1 if not.
 // 
-// Called By:			
-//
-//	Coded By:			Larry L. Biehl			Date: 07/27/2007
-//	Revised By:			Larry L. Biehl			Date: 07/27/2007
+// Called By:			DecodeTIFFBlock in SGeoTIFF.cpp
 
-SInt16 GetGeoASCIIStringFromGeoTIFF (
-				FileInfoPtr							fileInfoPtr,
-				TIFF_IFD_Ptr						geoASCIIStringTagPtr,
-				char*									geoASCIIStringPtr,
-				UInt32								stringLengthLimit)
+SInt16 DecodeTIFFLZWData (
+				HUCharPtr							inputBufferPtr,
+				UInt32								numberInputBytes,
+				HUCharPtr							outputBufferPtr,
+				UInt32								numberOutputBytes,
+				UInt32*								numberBytesDecodedPtr)
 
 {
-	CMFileStream*						fileStreamPtr;
+			// The string for each code is stored as the code for the string 
+			// without the last character (prefix), the last character and the
+			// string length. The first character is saved so that it does not
+			// have to be found from the prefix codes.
+			
+	UInt16								prefixCode[kLZWTableSize],
+											stringLength[kLZWTableSize];
 	
-	UInt32								count;
+	UInt8									firstCharacter[kLZWTableSize],
+											lastCharacter[kLZWTableSize];
 	
-	SInt16								errCode = noErr;
+	HUCharPtr							stringPtr;
 	
-
-	if (geoASCIIStringTagPtr->tag == 34737 && 
-				geoASCIIStringTagPtr->count > 0 && 
-						geoASCIIStringTagPtr->type == kTIFFASCII)
+	UInt32								bitBuffer,
+											code,
+											codeWidth,
+											index,
+											inputIndex,
+											length,
+											nextCode,
+											numberBitsInBuffer,
+											oldCode,
+											outputIndex,
+											stringCode;
+	
+	
+	*numberBytesDecodedPtr = 0;
+	
+	if (numberInputBytes >= 2 && 
+						inputBufferPtr[0] == 0 && (inputBufferPtr[1] & 0x01))
+																							return (-1);
+	
+	for (code=0; code<256; code++)
 		{
-				// Will read a string up to stringLengthLimit.
+		prefixCode[code] = kLZWNoCode;
+		stringLength[code] = 1;
+		firstCharacter[code] = (UInt8)code;
+		lastCharacter[code] = (UInt8)code;
 		
-		fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
-		
-		count = MIN (geoASCIIStringTagPtr->count, stringLengthLimit);
-										
-		errCode = GetTIFFASCIIParameters (fileStreamPtr,
-														geoASCIIStringTagPtr, 
-														geoASCIIStringPtr, 
-														(SInt32)count);
-		
-		if (errCode != noErr)
-			geoASCIIStringTagPtr->tag = 0;
-			
-		}	// end "if (geoDoubleParamsTagPtr->tag == 34736 && ..."
-		
-	return (noErr);
+		}	// end "for (code=0; code<256; code++)"
 	
-}	// end "GetGeoASCIIStringFromGeoTIFF"
-
-
-
-//------------------------------------------------------------------------------------
-//                   Copyright 1988-2020 Purdue Research Foundation
-//
-//	Function name:		SInt16 GetGTModelTypeGeoKey
-//
-//	Software purpose:	The purpose of this routine is to get the value of the 
-//							GTModelTypeGeoKey. Would be nice to get if from GDAL but have
-//							not figured a way to get it yet.
-//
-//	Parameters in:					
-//
-//	Parameters out:				
-//
-//	Value Returned:	
-//
-// Called By:			ListDescriptionInformation in SOther.cpp
-//
-//	Coded By:			Larry L. Biehl			Date: 02/18/2012
-//	Revised By:			Larry L. Biehl			Date: 02/18/2012
-
-SInt16 GetGTModelTypeGeoKey (
-				FileInfoPtr 						fileInfoPtr)
-
-{
-	TIFFImageFileDirectory			tiffFileDirectory;
+	bitBuffer = 0;
+	numberBitsInBuffer = 0;
+	inputIndex = 0;
+	outputIndex = 0;
 	
-	SInt16								gtModelTypeGeoKey = 0;
+	codeWidth = 9;
+	nextCode = kLZWFirstCode;
+	oldCode = kLZWNoCode;
 	
-								
-	if (GetSpecifiedTIFFKeyDirectory (fileInfoPtr, 34735, &tiffFileDirectory))
-		gtModelTypeGeoKey = GetGTModelTypeGeoKeyFromGeoDirectory (
-																			fileInfoPtr,
-																			&tiffFileDirectory);
+	while (outputIndex < numberOutputBytes)
+		{
+		while (numberBitsInBuffer < codeWidth && inputIndex < numberInputBytes)
+			{
+			bitBuffer = (bitBuffer << 8) | inputBufferPtr[inputIndex];
+			inputIndex++;
+			numberBitsInBuffer += 8;
+			
+			}	// end "while (numberBitsInBuffer < codeWidth && ..."
+			
+				// Allow for the end of information code to be missing.
+				
+		if (numberBitsInBuffer < codeWidth)
+			break;
+			
+		numberBitsInBuffer -= codeWidth;
+		code = (bitBuffer >> numberBitsInBuffer) & ((1 << codeWidth) - 1);
 		
-	return (gtModelTypeGeoKey);
+		if (code == kLZWEndOfInformationCode)
+			break;
+			
+		if (code == kLZWClearCode)
+			{
+			codeWidth = 9;
+			nextCode = kLZWFirstCode;
+			oldCode = kLZWNoCode;
+			continue;
+			
+			}	// end "if (code == kLZWClearCode)"
+			
+		if (oldCode == kLZWNoCode)
+			{
+					// This is the first code after a clear code.
+					
+			if (code > 255)
+																							return (-1);
+			
+			outputBufferPtr[outputIndex] = (UInt8)code;
+			outputIndex++;
+			oldCode = code;
+			continue;
+			
+			}	// end "if (oldCode == kLZWNoCode)"
+			
+		if (code > nextCode)
+																							return (-1);
+			
+				// Add the string for the old code plus the first character of the 
+				// string for this code to the table. If this code is the one being
+				// added, its first character is the first character of the old code.
+				
+		if (nextCode < kLZWTableSize)
+			{
+			prefixCode[nextCode] = (UInt16)oldCode;
+			if (code < nextCode)
+				lastCharacter[nextCode] = firstCharacter[code];
+			else	// code == nextCode
+				lastCharacter[nextCode] = firstCharacter[oldCode];
+			firstCharacter[nextCode] = firstCharacter[oldCode];
+			stringLength[nextCode] = stringLength[oldCode] + 1;
+			
+			nextCode++;
+			if (nextCode >= (UInt32)((1 << codeWidth) - 1) && codeWidth < 12)
+				codeWidth++;
+			
+			}	// end "if (nextCode < kLZWTableSize)"
+			
+		else if (code == nextCode)
+																							return (-1);
+			
+				// Copy the string for the code to the output buffer starting with
+				// the last character. Characters that would go beyond the end of the
+				// output buffer are skipped.
+				
+		length = stringLength[code];
+		stringCode = code;
+		
+		if (outputIndex + length > numberOutputBytes)
+			{
+			for (index=numberOutputBytes; index<outputIndex+length; index++)
+				stringCode = prefixCode[stringCode];
+			length = numberOutputBytes - outputIndex;
+			
+			}	// end "if (outputIndex + length > numberOutputBytes)"
+		
+		stringPtr = &outputBufferPtr[outputIndex + length - 1];
+		for (index=0; index<length; index++)
+			{
+			*stringPtr = lastCharacter[stringCode];
+			stringPtr--;
+			stringCode = prefixCode[stringCode];
+			
+			}	// end "for (index=0; index<length; index++)"
+			
+		outputIndex += length;
+		oldCode = code;
+		
+		}	// end "while (outputIndex < numberOutputBytes)"
+		
+	*numberBytesDecodedPtr = outputIndex;
 	
-}	// end "GetGTModelTypeGeoKey"
+	return (noErr);
+	
+}	// end "DecodeTIFFLZWData"
 
 
 
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Function name:		SInt16 GetGTModelTypeGeoKeyFromGeoDirectory
+//	Function name:		SInt16 DecodeTIFFPackBitsData
 //
-//	Software purpose:	The purpose of this routine is to get the value of the 
-//							GTModelTypeGeoKey. Would be nice to get if from GDAL but have
-//							not figured a way to get it yet.
+//	Software purpose:	The purpose of this routine is to decompress a block of TIFF
+//							data that was compressed with the PackBits run length method.
 //
-//	Parameters in:		
+//	Parameters in:		Pointer to the compressed data.
+//							Number of bytes of compressed data.
+//							Pointer to the buffer for the decompressed data.
+//							Size of the buffer for the decompressed data.
 //
-//	Parameters out:	None
+//	Parameters out:	Number of bytes that were decompressed.
 //
-//	Value Returned:	None				
+//	Value Returned:	noErr
 // 
-// Called By:			GetGTModelTypeGeoKey in SGeoTIFF.cpp
-//
-//	Coded By:			Larry L. Biehl			Date: 02/18/2012
-//	Revised By:			Larry L. Biehl			Date: 02/18/2012
+// Called By:			DecodeTIFFBlock in SGeoTIFF.cpp
 
-SInt16 GetGTModelTypeGeoKeyFromGeoDirectory (
-				FileInfoPtr							fileInfoPtr,
-				TIFF_IFD_Ptr						imageFileDirectoryPtr)
+SInt16 DecodeTIFFPackBitsData (
+				HUCharPtr							inputBufferPtr,
+				UInt32								numberInputBytes,
+				HUCharPtr							outputBufferPtr,
+				UInt32								numberOutputBytes,
+				UInt32*								numberBytesDecodedPtr)
 
-{	
-	SInt64								savedPosOff;
-											
-	CMFileStream*						fileStreamPtr;
-	UInt16*								geoKeyRecordPtr;
-				
+{
 	UInt32								count,
-											i,
-											index,
-											recordIndex;
+											inputIndex,
+											outputIndex;
 	
-	UInt16								geoTagInformation[100];
+	SInt32								headerByte;
 	
-	SInt16								errCode,
-											gtModelTypeGeoKey = 0;
-											
-	Boolean								foundFlag = FALSE;
 	
+	inputIndex = 0;
+	outputIndex = 0;
 	
-	if (imageFileDirectoryPtr->type == kTIFFShort && 
-																imageFileDirectoryPtr->count > 0)
-		{																																									
-		fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
+	while (inputIndex < numberInputBytes && outputIndex < numberOutputBytes)
+		{
+		headerByte = (signed char)inputBufferPtr[inputIndex];
+		inputIndex++;
+		
+		if (headerByte >= 0)
+			{
+					// Copy the next headerByte+1 bytes literally.
+					
+			count = (UInt32)headerByte + 1;
+			count = MIN (count, numberInputBytes - inputIndex);
+			count = MIN (count, numberOutputBytes - outputIndex);
 			
-		errCode = MGetMarker (fileStreamPtr, 
-											&savedPosOff,
-											kErrorMessages);
+			memcpy (&outputBufferPtr[outputIndex], &inputBufferPtr[inputIndex], count);
 			
-		if (errCode == noErr)
-			errCode = MSetMarker (fileStreamPtr, 
-												fsFromStart, 
-												imageFileDirectoryPtr->value,
-												kErrorMessages);
-												
-		count = MIN (imageFileDirectoryPtr->count, 100);			
-		count *= 2;
-		if (errCode == noErr)
-			errCode = MReadData (fileStreamPtr, 
-												&count, 
-												(char*)&geoTagInformation,
-												kErrorMessages); 
-												
-		if (errCode == noErr)
-			{
-					// Convert to number of 2 byte integers.
-						
-			count /= 2;
+			inputIndex += (UInt32)headerByte + 1;
+			outputIndex += count;
 			
-					//  Convert to number of geo key records.
+			}	// end "if (headerByte >= 0)"
+			
+		else if (headerByte != -128 && inputIndex < numberInputBytes)
+			{
+					// Repeat the next byte -headerByte+1 times.
 					
-			count /= 4;
+			count = (UInt32)(1 - headerByte);
+			count = MIN (count, numberOutputBytes - outputIndex);
 			
-			index = 0;		
-			for (recordIndex=0; recordIndex<count; recordIndex++)
-				{
-				geoKeyRecordPtr = &geoTagInformation[index];
-				for (i=0; i<4; i++, index++)
-							// Swap the bytes if needed.
-					geoTagInformation[index] = 
-									(UInt16)GetShortIntValue ((char*)&geoTagInformation[index]);
+			memset (&outputBufferPtr[outputIndex], inputBufferPtr[inputIndex], count);
 			
-						// The first geo key record is the version and number of geo keys.
-						// We will skip it.
-					
-				if (recordIndex == 0)
-					geoKeyRecordPtr[0] = 0;
-									
-				switch (geoKeyRecordPtr[0])
-					{
-					case 1024:	// GTModelTypeGeoKey
-						gtModelTypeGeoKey = geoKeyRecordPtr[3];
-						foundFlag = TRUE;
-						break;
-																									
-					}	// end "switch (geoKeyRecordPtr[0])"
-											
-				if (foundFlag)
-					break;
-									
-				}	// end "for (recordIndex=0; recordIndex<count; recordIndex++)"
+			inputIndex++;
+			outputIndex += count;
 			
-			}	// end "if (errCode == noErr)"
-				
-		if (errCode == noErr)
-			errCode = MSetMarker (fileStreamPtr, 
-											fsFromStart, 
-											savedPosOff,
-											kErrorMessages);
+			}	// end "else if (headerByte != -128 && ..."
 			
-		}	// end "if (imageFileDirectoryPtr->type == kTIFFShort && ..."
+		}	// end "while (inputIndex < numberInputBytes && ..."
 		
-	return (gtModelTypeGeoKey);
+	*numberBytesDecodedPtr = outputIndex;
 		
-}	// end "GetGTModelTypeGeoKeyFromGeoDirectory"
+	return (noErr);
+	
+}	// end "DecodeTIFFPackBitsData"
   
 
-#if use_multispec_tiffcode
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Function name:		SInt16 GetGeoDoubleParametersFromGeoTIFF
+//	Function name:		Handle DisposeTIFFOverviewHandle
 //
-//	Software purpose:	The purpose of this routine is to get the array of double 
-//							parameters for the information in the GEOTIFF tag.
+//	Software purpose:	The purpose of this routine is to release the memory for the
+//							hierarchal format structures of the reduced resolution TIFF
+//							images and for the vector of overview structures.
 //
-//	Parameters in:		None
+//	Parameters in:		Handle to the vector of TIFFOverview structures.
 //
 //	Parameters out:	None
 //
-//	Value Returned:	None				
+//	Value Returned:	NULL
 // 
-// Called By:			
+// Called By:			CloseImageFile in SFileInfo.cpp
+//							LoadTIFFOverviewStructures in SGeoTIFF.cpp
+
+Handle DisposeTIFFOverviewHandle (
+				Handle								tiffOverviewHandle)
+
+{
+	TIFFOverviewPtr					tiffOverviewPtr;
+	
+	UInt32								index;
+	
+	
+	tiffOverviewPtr = (TIFFOverviewPtr)GetHandlePointer (tiffOverviewHandle, kLock);
+	
+	if (tiffOverviewPtr != NULL)
+		{
+		for (index=0; index<kMaxNumberTIFFOverviews; index++)
+			tiffOverviewPtr[index].hfaHandle = 
+										UnlockAndDispose (tiffOverviewPtr[index].hfaHandle);
+		
+		}	// end "if (tiffOverviewPtr != NULL)"
+	
+	tiffOverviewHandle = UnlockAndDispose (tiffOverviewHandle);
+	
+	return (tiffOverviewHandle);
+	
+}	// end "DisposeTIFFOverviewHandle"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Coded By:			Larry L. Biehl			Date: 12/05/2000
-//	Revised By:			Larry L. Biehl			Date: 03/04/2004
+//	Function name:		SInt16 EncodeTIFFBlock
+//
+//	Software purpose:	The purpose of this routine is to apply the predictor, if one
+//							is to be used, to one strip of a TIFF file and compress it with
+//							the method in the file information structure. The input data
+//							are to be in the byte order of the file; they are changed by
+//							the predictor. 
+//							This routine may be called from more than one thread at a time
+//							so no memory is allocated and no messages are displayed here.
+//
+//	Parameters in:		File information structure pointer.
+//							Pointer to the data to be compressed.
+//							Number of bytes of data to be compressed.
+//							Pointer to the buffer for the compressed data.
+//							Size of the buffer for the compressed data. It is to be at
+//								least the size returned by GetTIFFEncodeBufferBytes.
+//							Number of bytes in one row of the block.
+//							Pointer to buffer for one row of data. Only used for the
+//								floating point predictor.
+//
+//	Parameters out:	Number of bytes of compressed data.
+//
+//	Value Returned:	noErr if the block was compressed.
+//							-1 if the data could not be compressed.
+// 
+// Called By:			EncodeTIFFStrip in SSaveWrite.cpp
 
-SInt16 GetGeoDoubleParametersFromGeoTIFF (
+SInt16 EncodeTIFFBlock (
 				FileInfoPtr							fileInfoPtr,
-				TIFF_IFD_Ptr						geoDoubleParamsTagPtr,
-				double*								geoParametersPtr)
+				HUCharPtr							inputBufferPtr,
+				UInt32								numberInputBytes,
+				HUCharPtr							outputBufferPtr,
+				UInt32								numberOutputBytes,
+				UInt32								numberRowBytes,
+				HUCharPtr							rowBufferPtr,
+				UInt32*								numberBytesEncodedPtr)
 
 {
-	CMFileStream*						fileStreamPtr;
+	SInt16								returnCode = -1;
 	
-	SInt16								errCode = noErr;
 	
-
-	if (geoDoubleParamsTagPtr->tag == 34736 && 
-				geoDoubleParamsTagPtr->count <= 20 && 
-						geoDoubleParamsTagPtr->type == kTIFFDouble)
+	*numberBytesEncodedPtr = 0;
+	
+	if (fileInfoPtr->predictorCode > 1 && numberRowBytes > 0)
+		ApplyTIFFPredictor (fileInfoPtr,
+									inputBufferPtr,
+									numberInputBytes/numberRowBytes,
+									numberRowBytes,
+									rowBufferPtr);
+	
+	switch (fileInfoPtr->dataCompressionCode)
 		{
-			// Will read data for up to 20 parameters.
-		
-		fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
-										
-		errCode = GetTIFFDoubleParameters (fileStreamPtr,
-														geoDoubleParamsTagPtr, 
-														geoParametersPtr, 
-														(SInt32)geoDoubleParamsTagPtr->count);
-		
-		if (errCode != noErr)
-			geoDoubleParamsTagPtr->tag = 0;
+		case kLZWCompression:
+			returnCode = EncodeTIFFLZWData (inputBufferPtr,
+														numberInputBytes,
+														outputBufferPtr,
+														numberOutputBytes,
+														numberBytesEncodedPtr);
+			break;
 			
-		}	// end "if (geoDoubleParamsTagPtr->tag == 34736 && ..."
+		#if include_zlib_capability
+			case kDeflateCompression:
+				returnCode = EncodeTIFFDeflateData (inputBufferPtr,
+																numberInputBytes,
+																outputBufferPtr,
+																numberOutputBytes,
+																numberBytesEncodedPtr);
+				break;
+		#endif	// include_zlib_capability
+			
+		}	// end "switch (fileInfoPtr->dataCompressionCode)"
 		
-	return (noErr);
+	return (returnCode);
 	
-}	// end "GetGeoDoubleParametersFromGeoTIFF"
+}	// end "EncodeTIFFBlock"
 
 
 
+#if include_zlib_capability
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Function name:		SInt16 GetGeoKeyParameters
+//	Function name:		SInt16 EncodeTIFFDeflateData
 //
-//	Software purpose:	The purpose of this routine is to read the Geo Key Parameters.
+//	Software purpose:	The purpose of this routine is to compress a block of TIFF
+//							data with the Deflate (zlib) method.
 //
-//	Parameters in:		None
+//	Parameters in:		Pointer to the data to be compressed.
+//							Number of bytes of data to be compressed.
+//							Pointer to the buffer for the compressed data.
+//							Size of the buffer for the compressed data.
 //
-//	Parameters out:	None
+//	Parameters out:	Number of bytes of compressed data.
 //
-//	Value Returned:	None				
+//	Value Returned:	noErr if the data were compressed; -1 if not.
 // 
-// Called By:			
-//
-//	Coded By:			Larry L. Biehl			Date: 09/10/2002
-//	Revised By:			Larry L. Biehl			Date: 05/02/2012
+// Called By:			EncodeTIFFBlock in SGeoTIFF.cpp
 
-SInt16 GetGeoKeyParameters (
-				FileInfoPtr							fileInfoPtr,
-				TIFF_IFD_Ptr						imageFileDirectoryPtr,
-				TIFF_IFD_Ptr						geoDoubleParamsPtr,
-				TIFF_IFD_Ptr						geoAsciiStringPtr,
-				UInt16*								rasterTypeGeoKeyPtr)
+SInt16 EncodeTIFFDeflateData (
+				HUCharPtr							inputBufferPtr,
+				UInt32								numberInputBytes,
+				HUCharPtr							outputBufferPtr,
+				UInt32								numberOutputBytes,
+				UInt32*								numberBytesEncodedPtr)
 
-{	
-	double								geoDoubleParameters[20],
-											inverseFlatteningParameter;
+{
+	z_stream								zStream;
 	
-	SInt64								savedPosOff;
-											
-	CMFileStream*						fileStreamPtr;
-	MapProjectionInfoPtr				mapProjectionInfoPtr;
-	UInt16*								geoKeyRecordPtr;
+	int									zlibReturnCode;
 	
-	Handle								mapProjectionHandle;
-				
-	UInt32								count,
-											i,
-											index,
-											recordIndex;
 	
-	UInt16								geoTagInformation[100],
-											projectedCoordTransGeoKey,
-											projectedCSTypeGeoKey,
-											projectionGeoKey;
+	*numberBytesEncodedPtr = 0;
 	
-	SInt16								errCode = -1;
+	memset (&zStream, 0, sizeof (z_stream));
 	
+	if (deflateInit (&zStream, Z_DEFAULT_COMPRESSION) != Z_OK)
+																							return (-1);
 	
-	if (imageFileDirectoryPtr->type == kTIFFShort && 
-																imageFileDirectoryPtr->count > 0)
-		{		
-		mapProjectionHandle = GetFileMapProjectionHandle (fileInfoPtr);
+	zStream.next_in = (Bytef*)inputBufferPtr;
+	zStream.avail_in = numberInputBytes;
+	zStream.next_out = (Bytef*)outputBufferPtr;
+	zStream.avail_out = numberOutputBytes;
+	
+	zlibReturnCode = deflate (&zStream, Z_FINISH);
+	
+	*numberBytesEncodedPtr = numberOutputBytes - zStream.avail_out;
+	
+	deflateEnd (&zStream);
+			
+	if (zlibReturnCode == Z_STREAM_END)
+																							return (noErr);
 		
-		if (mapProjectionHandle != NULL)
-			{ 				
-					// Get double parameter information in case it will be needed later.
-					
-			GetGeoDoubleParametersFromGeoTIFF (fileInfoPtr,
-															geoDoubleParamsPtr,
-															geoDoubleParameters);
-																								
-			mapProjectionInfoPtr = (MapProjectionInfoPtr)
-												GetHandlePointer (mapProjectionHandle,
-																			kLock);
+	return (-1);
+	
+}	// end "EncodeTIFFDeflateData"
+#endif	// include_zlib_capability
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 EncodeTIFFLZWData
+//
+//	Software purpose:	The purpose of this routine is to compress a block of TIFF
+//							data with the LZW method as described in the TIFF 6.0 
+//							specification. The output starts with a clear code and ends
+//							with the end of information code. The code width increases
+//							one code early as is expected by DecodeTIFFLZWData and other
+//							TIFF readers.
+//
+//	Parameters in:		Pointer to the data to be compressed.
+//							Number of bytes of data to be compressed.
+//							Pointer to the buffer for the compressed data.
+//							Size of the buffer for the compressed data.
+//
+//	Parameters out:	Number of bytes of compressed data.
+//
+//	Value Returned:	noErr if the data were compressed; -1 if the buffer for the
+//							compressed data is too small.
+// 
+// Called By:			EncodeTIFFBlock in SGeoTIFF.cpp
+
+SInt16 EncodeTIFFLZWData (
+				HUCharPtr							inputBufferPtr,
+				UInt32								numberInputBytes,
+				HUCharPtr							outputBufferPtr,
+				UInt32								numberOutputBytes,
+				UInt32*								numberBytesEncodedPtr)
+
+{
+			// The code for the string made up of a prefix string and the next 
+			// character is found with a hash of the prefix code and the character.
+			// A key of 0 indicates an unused entry in the hash table.
 			
-			fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
+	UInt32								hashKey[kLZWHashTableSize];
+	
+	UInt16								hashCode[kLZWHashTableSize];
+	
+	UInt32								bitBuffer,
+											character,
+											code,
+											codeWidth,
+											hashIndex,
+											inputIndex,
+											key,
+											nextCode,
+											numberBitsInBuffer,
+											outputIndex;
+	
+	
+	*numberBytesEncodedPtr = 0;
+	
+			// Each code uses at most 12 bits for each input byte. This check makes 
+			// sure that the codes cannot go beyond the end of the output buffer.
 			
-			errCode = MGetMarker (fileStreamPtr, 
-											&savedPosOff,
-											kErrorMessages);
+	if (numberOutputBytes < GetTIFFEncodeBufferBytes (numberInputBytes))
+																							return (-1);
+	
+	memset (hashKey, 0, sizeof (hashKey));
+	
+	bitBuffer = 0;
+	numberBitsInBuffer = 0;
+	outputIndex = 0;
+	
+	codeWidth = 9;
+	nextCode = kLZWFirstCode;
+	
+	PutTIFFLZWCode (kLZWClearCode,
+							codeWidth,
+							&bitBuffer,
+							&numberBitsInBuffer,
+							outputBufferPtr,
+							&outputIndex);
+	
+	if (numberInputBytes > 0)
+		{
+		code = inputBufferPtr[0];
+		
+		for (inputIndex=1; inputIndex<numberInputBytes; inputIndex++)
+			{
+			character = inputBufferPtr[inputIndex];
+			key = ((code << 8) | character) + 1;
 			
-			if (errCode == noErr)
-				errCode = MSetMarker (fileStreamPtr, 
-												fsFromStart, 
-												imageFileDirectoryPtr->value,
-												kErrorMessages);
-												
-			count = MIN (imageFileDirectoryPtr->count, 100);			
-			count *= 2;
-			if (errCode == noErr)
-				errCode = MReadData (fileStreamPtr, 
-												&count, 
-												(char*)&geoTagInformation,
-												kErrorMessages); 
-												
-			if (errCode == noErr)
+			hashIndex = ((character << 12) ^ code) % kLZWHashTableSize;
+			while (hashKey[hashIndex] != 0 && hashKey[hashIndex] != key)
 				{
-						// Convert to number of 2 byte integers.
-						
-				count /= 2;
+				hashIndex++;
+				if (hashIndex == kLZWHashTableSize)
+					hashIndex = 0;
 				
-						//  Convert to number of geo key records.
+				}	// end "while (hashKey[hashIndex] != 0 && ..."
+				
+			if (hashKey[hashIndex] == key)
+				{
+						// The string plus this character is in the table.
 						
-				count /= 4;
+				code = hashCode[hashIndex];
+				continue;
 				
-				index = 0;		
- 				for (recordIndex=0; recordIndex<count; recordIndex++)
-					{
-					geoKeyRecordPtr = &geoTagInformation[index];
-					for (i=0; i<4; i++, index++)
-								// Swap the bytes if needed.
-						geoTagInformation[index] = 
-									(UInt16)GetShortIntValue ((char*)&geoTagInformation[index]);
+				}	// end "if (hashKey[hashIndex] == key)"
 				
-							// The first geo key record is the version and number of geo keys.
-							// We will skip it.
-						
-					if (recordIndex == 0)
-						geoKeyRecordPtr[0] = 0;
-										
-					switch (geoKeyRecordPtr[0])
-						{
-						case 1024:	// GTModelTypeGeoKey
-							if (geoKeyRecordPtr[3] == 2)
-								{
-								mapProjectionInfoPtr->gridCoordinate.referenceSystemCode = kGeographicRSCode;
-								mapProjectionInfoPtr->planarCoordinate.mapUnitsCode = kDecimalDegreesCode;
-								
-								}	// end "if (geoKeyRecordPtr[3] == 2)"
-							break;
-							
-						case 1025:	// GTRasterTypeGeoKey RasterPixelIsArea (=1) or RasterPixelIsPoint (=2)
-							*rasterTypeGeoKeyPtr = geoKeyRecordPtr[3];
-							if (*rasterTypeGeoKeyPtr < 1 || *rasterTypeGeoKeyPtr > 2)
-								*rasterTypeGeoKeyPtr = 1;
-							break;
-							
-						case 1026:	// GTCitationGeoKey
-									// Used when description of image is listed
-							break;
+			PutTIFFLZWCode (code,
+									codeWidth,
+									&bitBuffer,
+									&numberBitsInBuffer,
+									outputBufferPtr,
+									&outputIndex);
+			
+			hashKey[hashIndex] = key;
+			hashCode[hashIndex] = (UInt16)nextCode;
+			nextCode++;
+			
+					// Start a new table when it is full.
+					
+			if (nextCode == kLZWTableSize - 2)
+				{
+				PutTIFFLZWCode (kLZWClearCode,
+										codeWidth,
+										&bitBuffer,
+										&numberBitsInBuffer,
+										outputBufferPtr,
+										&outputIndex);
+				
+				memset (hashKey, 0, sizeof (hashKey));
+				codeWidth = 9;
+				nextCode = kLZWFirstCode;
+				
+				}	// end "if (nextCode == kLZWTableSize - 2)"
+				
+			else if (nextCode > (UInt32)((1 << codeWidth) - 1))
+				codeWidth++;
+				
+			code = character;
+			
+			}	// end "for (inputIndex=1; inputIndex<numberInputBytes; inputIndex++)"
+			
+				// Write the code for the last string. The table count is updated so
+				// that the end of information code has the width that the reader 
+				// expects.
+			
+		PutTIFFLZWCode (code,
+								codeWidth,
+								&bitBuffer,
+								&numberBitsInBuffer,
+								outputBufferPtr,
+								&outputIndex);
+		
+		nextCode++;
+		if (nextCode == kLZWTableSize - 2)
+			{
+			PutTIFFLZWCode (kLZWClearCode,
+									codeWidth,
+									&bitBuffer,
+									&numberBitsInBuffer,
+									outputBufferPtr,
+									&outputIndex);
+			codeWidth = 9;
+			
+			}	// end "if (nextCode == kLZWTableSize - 2)"
+			
+		else if (nextCode > (UInt32)((1 << codeWidth) - 1))
+			codeWidth++;
+		
+		}	// end "if (numberInputBytes > 0)"
+		
+	PutTIFFLZWCode (kLZWEndOfInformationCode,
+							codeWidth,
+							&bitBuffer,
+							&numberBitsInBuffer,
+							outputBufferPtr,
+							&outputIndex);
 							
-						case 2048:	// GeographicTypeGeoKey
-							if (geoKeyRecordPtr[3] == 4035)
-								mapProjectionInfoPtr->geodetic.datumCode = kSphereDatumCode;
+	if (numberBitsInBuffer > 0)
+		{
+		outputBufferPtr[outputIndex] = (UInt8)(bitBuffer << (8 - numberBitsInBuffer));
+		outputIndex++;
+		
+		}	// end "if (numberBitsInBuffer > 0)"
+	
+	*numberBytesEncodedPtr = outputIndex;
+	
+	return (noErr);
+	
+}	// end "EncodeTIFFLZWData"
+  
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 GetBlockSizesVector
+//
+//	Software purpose:	The purpose of this routine is to read the block sizes vector.
+//
+//	Parameters in:		None
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None				
+// 
+// Called By:			
+//
+//	Coded By:			Larry L. Biehl			Date: 02/07/2007
+//	Revised By:			Larry L. Biehl			Date: 06/01/2011
+
+SInt16 GetBlockSizesVector (
+				CMFileStream*						fileStreamPtr,
+				UInt32**								blockSizesPtrPtr,
+				UInt32								numberStripByteCounts,
+				UInt32								stripByteCountType,
+				UInt32								stripByteCountVector)
+
+{	
+	UInt32*								localBlockSizesPtr;
+	
+	SInt32								stripByteCount;
+	
+	UInt32								bytesToRead,
+											count,
+											index;
+	
+	SInt16								errCode,
+											returnCode;
+	
+	
+	errCode = noErr;
+	returnCode = 0;
+
+			// Get memory to store the block (strip) size values in.  If no
+			// memory is available then we cannot continue with this.
+			
+	*blockSizesPtrPtr =
+				(UInt32*)MNewPointer ((SInt64)numberStripByteCounts * sizeof (UInt32));
+	if (*blockSizesPtrPtr == NULL)
+		errCode = -1;
+	
+	if (errCode == noErr)
+		errCode = MSetMarker (fileStreamPtr, 
+										fsFromStart, 
+										stripByteCountVector,
+										kErrorMessages);
 								
-							else if (geoKeyRecordPtr[3] == 4121)
-								mapProjectionInfoPtr->geodetic.datumCode = kGGRS87DatumCode;
+	bytesToRead = 2;
+	if (stripByteCountType == kTIFFLong)	
+		bytesToRead = 4;
+	
+	localBlockSizesPtr = *blockSizesPtrPtr;
+	
+	for (index=0; index<numberStripByteCounts; index++)
+		{
+		count = (UInt32)bytesToRead;
+		stripByteCount = 0;
+		
+		if (errCode == noErr)
+			errCode = MReadData (fileStreamPtr, 
+											&count, 
+											&stripByteCount,
+											kErrorMessages);
+			
+		if (errCode != noErr)
+			break;
+			
+		localBlockSizesPtr[index] = (UInt32)GetLongIntValue ((char*)&stripByteCount);
+		
+		}	// end "for (index=0; index<numberStripByteCounts; index++)"
+		
+	if (errCode != noErr)
+		returnCode = -8;
+		
+	return (returnCode);
+	
+}	// end "GetBlockSizesVector" 	
+#endif	// use_multispec_tiffcode
+  
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 GetGeoASCIIStringFromGeoTIFF
+//
+//	Software purpose:	The purpose of this routine is to get the text information in
+//							the GEOTIFF tag.
+//
+//	Parameters in:		None
+//
+//	Parameters out:	None
+//
+//	Value Returned:	error code
+// 
+// Called By:			
+//
+//	Coded By:			Larry L. Biehl			Date: 02/18/2012
+//	Revised By:			Larry L. Biehl			Date: 02/18/2012
+
+SInt16 GetGeoASCIIStringFromGeoTIFF (
+				FileInfoPtr							fileInfoPtr,
+				char*									geoASCIIStringPtr,
+				UInt32								stringLengthLimit)
+
+{
+	TIFFImageFileDirectory			tiffFileDirectory;
+	
 								
-							else if (geoKeyRecordPtr[3] == 4221)
+	if (GetSpecifiedTIFFKeyDirectory (fileInfoPtr,
+													34737,
+													&tiffFileDirectory))
+		GetGeoASCIIStringFromGeoTIFF (fileInfoPtr,
+													&tiffFileDirectory,
+													geoASCIIStringPtr,
+													stringLengthLimit);
+		
+	return (noErr);
+	
+}	// end "GetGeoASCIIStringFromGeoTIFF"
+  
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 GetGeoASCIIStringFromGeoTIFF
+//
+//	Software purpose:	The purpose of this routine is to get the textinformation in 
+//							the GEOTIFF tag.
+//
+//	Parameters in:		None
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None				
+// 
+// Called By:			
+//
+//	Coded By:			Larry L. Biehl			Date: 07/27/2007
+//	Revised By:			Larry L. Biehl			Date: 07/27/2007
+
+SInt16 GetGeoASCIIStringFromGeoTIFF (
+				FileInfoPtr							fileInfoPtr,
+				TIFF_IFD_Ptr						geoASCIIStringTagPtr,
+				char*									geoASCIIStringPtr,
+				UInt32								stringLengthLimit)
+
+{
+	CMFileStream*						fileStreamPtr;
+	
+	UInt32								count;
+	
+	SInt16								errCode = noErr;
+	
+
+	if (geoASCIIStringTagPtr->tag == 34737 && 
+				geoASCIIStringTagPtr->count > 0 && 
+						geoASCIIStringTagPtr->type == kTIFFASCII)
+		{
+				// Will read a string up to stringLengthLimit.
+		
+		fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
+		
+		count = MIN (geoASCIIStringTagPtr->count, stringLengthLimit);
+										
+		errCode = GetTIFFASCIIParameters (fileStreamPtr,
+														geoASCIIStringTagPtr, 
+														geoASCIIStringPtr, 
+														(SInt32)count);
+		
+		if (errCode != noErr)
+			geoASCIIStringTagPtr->tag = 0;
+			
+		}	// end "if (geoDoubleParamsTagPtr->tag == 34736 && ..."
+		
+	return (noErr);
+	
+}	// end "GetGeoASCIIStringFromGeoTIFF"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 GetGTModelTypeGeoKey
+//
+//	Software purpose:	The purpose of this routine is to get the value of the 
+//							GTModelTypeGeoKey. Would be nice to get if from GDAL but have
+//							not figured a way to get it yet.
+//
+//	Parameters in:					
+//
+//	Parameters out:				
+//
+//	Value Returned:	
+//
+// Called By:			ListDescriptionInformation in SOther.cpp
+//
+//	Coded By:			Larry L. Biehl			Date: 02/18/2012
+//	Revised By:			Larry L. Biehl			Date: 02/18/2012
+
+SInt16 GetGTModelTypeGeoKey (
+				FileInfoPtr 						fileInfoPtr)
+
+{
+	TIFFImageFileDirectory			tiffFileDirectory;
+	
+	SInt16								gtModelTypeGeoKey = 0;
+	
+								
+	if (GetSpecifiedTIFFKeyDirectory (fileInfoPtr, 34735, &tiffFileDirectory))
+		gtModelTypeGeoKey = GetGTModelTypeGeoKeyFromGeoDirectory (
+																			fileInfoPtr,
+																			&tiffFileDirectory);
+		
+	return (gtModelTypeGeoKey);
+	
+}	// end "GetGTModelTypeGeoKey"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 GetGTModelTypeGeoKeyFromGeoDirectory
+//
+//	Software purpose:	The purpose of this routine is to get the value of the 
+//							GTModelTypeGeoKey. Would be nice to get if from GDAL but have
+//							not figured a way to get it yet.
+//
+//	Parameters in:		
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None				
+// 
+// Called By:			GetGTModelTypeGeoKey in SGeoTIFF.cpp
+//
+//	Coded By:			Larry L. Biehl			Date: 02/18/2012
+//	Revised By:			Larry L. Biehl			Date: 02/18/2012
+
+SInt16 GetGTModelTypeGeoKeyFromGeoDirectory (
+				FileInfoPtr							fileInfoPtr,
+				TIFF_IFD_Ptr						imageFileDirectoryPtr)
+
+{	
+	SInt64								savedPosOff;
+											
+	CMFileStream*						fileStreamPtr;
+	UInt16*								geoKeyRecordPtr;
+				
+	UInt32								count,
+											i,
+											index,
+											recordIndex;
+	
+	UInt16								geoTagInformation[100];
+	
+	SInt16								errCode,
+											gtModelTypeGeoKey = 0;
+											
+	Boolean								foundFlag = FALSE;
+	
+	
+	if (imageFileDirectoryPtr->type == kTIFFShort && 
+																imageFileDirectoryPtr->count > 0)
+		{																																									
+		fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
+			
+		errCode = MGetMarker (fileStreamPtr, 
+											&savedPosOff,
+											kErrorMessages);
+			
+		if (errCode == noErr)
+			errCode = MSetMarker (fileStreamPtr, 
+												fsFromStart, 
+												imageFileDirectoryPtr->value,
+												kErrorMessages);
+												
+		count = MIN (imageFileDirectoryPtr->count, 100);			
+		count *= 2;
+		if (errCode == noErr)
+			errCode = MReadData (fileStreamPtr, 
+												&count, 
+												(char*)&geoTagInformation,
+												kErrorMessages); 
+												
+		if (errCode == noErr)
+			{
+					// Convert to number of 2 byte integers.
+						
+			count /= 2;
+			
+					//  Convert to number of geo key records.
+					
+			count /= 4;
+			
+			index = 0;		
+			for (recordIndex=0; recordIndex<count; recordIndex++)
+				{
+				geoKeyRecordPtr = &geoTagInformation[index];
+				for (i=0; i<4; i++, index++)
+							// Swap the bytes if needed.
+					geoTagInformation[index] = 
+									(UInt16)GetShortIntValue ((char*)&geoTagInformation[index]);
+			
+						// The first geo key record is the version and number of geo keys.
+						// We will skip it.
+					
+				if (recordIndex == 0)
+					geoKeyRecordPtr[0] = 0;
+									
+				switch (geoKeyRecordPtr[0])
+					{
+					case 1024:	// GTModelTypeGeoKey
+						gtModelTypeGeoKey = geoKeyRecordPtr[3];
+						foundFlag = TRUE;
+						break;
+																									
+					}	// end "switch (geoKeyRecordPtr[0])"
+											
+				if (foundFlag)
+					break;
+									
+				}	// end "for (recordIndex=0; recordIndex<count; recordIndex++)"
+			
+			}	// end "if (errCode == noErr)"
+				
+		if (errCode == noErr)
+			errCode = MSetMarker (fileStreamPtr, 
+											fsFromStart, 
+											savedPosOff,
+											kErrorMessages);
+			
+		}	// end "if (imageFileDirectoryPtr->type == kTIFFShort && ..."
+		
+	return (gtModelTypeGeoKey);
+		
+}	// end "GetGTModelTypeGeoKeyFromGeoDirectory"
+  
+
+#if use_multispec_tiffcode
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 GetGeoDoubleParametersFromGeoTIFF
+//
+//	Software purpose:	The purpose of this routine is to get the array of double 
+//							parameters for the information in the GEOTIFF tag.
+//
+//	Parameters in:		None
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None				
+// 
+// Called By:			
+//
+//	Coded By:			Larry L. Biehl			Date: 12/05/2000
+//	Revised By:			Larry L. Biehl			Date: 03/04/2004
+
+SInt16 GetGeoDoubleParametersFromGeoTIFF (
+				FileInfoPtr							fileInfoPtr,
+				TIFF_IFD_Ptr						geoDoubleParamsTagPtr,
+				double*								geoParametersPtr)
+
+{
+	CMFileStream*						fileStreamPtr;
+	
+	SInt16								errCode = noErr;
+	
+
+	if (geoDoubleParamsTagPtr->tag == 34736 && 
+				geoDoubleParamsTagPtr->count <= 20 && 
+						geoDoubleParamsTagPtr->type == kTIFFDouble)
+		{
+			// Will read data for up to 20 parameters.
+		
+		fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
+										
+		errCode = GetTIFFDoubleParameters (fileStreamPtr,
+														geoDoubleParamsTagPtr, 
+														geoParametersPtr, 
+														(SInt32)geoDoubleParamsTagPtr->count);
+		
+		if (errCode != noErr)
+			geoDoubleParamsTagPtr->tag = 0;
+			
+		}	// end "if (geoDoubleParamsTagPtr->tag == 34736 && ..."
+		
+	return (noErr);
+	
+}	// end "GetGeoDoubleParametersFromGeoTIFF"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 GetGeoKeyParameters
+//
+//	Software purpose:	The purpose of this routine is to read the Geo Key Parameters.
+//
+//	Parameters in:		None
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None				
+// 
+// Called By:			
+//
+//	Coded By:			Larry L. Biehl			Date: 09/10/2002
+//	Revised By:			Larry L. Biehl			Date: 05/02/2012
+
+SInt16 GetGeoKeyParameters (
+				FileInfoPtr							fileInfoPtr,
+				TIFF_IFD_Ptr						imageFileDirectoryPtr,
+				TIFF_IFD_Ptr						geoDoubleParamsPtr,
+				TIFF_IFD_Ptr						geoAsciiStringPtr,
+				UInt16*								rasterTypeGeoKeyPtr)
+
+{	
+	double								geoDoubleParameters[20],
+											inverseFlatteningParameter;
+	
+	SInt64								savedPosOff;
+											
+	CMFileStream*						fileStreamPtr;
+	MapProjectionInfoPtr				mapProjectionInfoPtr;
+	UInt16*								geoKeyRecordPtr;
+	
+	Handle								mapProjectionHandle;
+				
+	UInt32								count,
+											i,
+											index,
+											recordIndex;
+	
+	UInt16								geoTagInformation[100],
+											projectedCoordTransGeoKey,
+											projectedCSTypeGeoKey,
+											projectionGeoKey;
+	
+	SInt16								errCode = -1;
+	
+	
+	if (imageFileDirectoryPtr->type == kTIFFShort && 
+																imageFileDirectoryPtr->count > 0)
+		{		
+		mapProjectionHandle = GetFileMapProjectionHandle (fileInfoPtr);
+		
+		if (mapProjectionHandle != NULL)
+			{ 				
+					// Get double parameter information in case it will be needed later.
+					
+			GetGeoDoubleParametersFromGeoTIFF (fileInfoPtr,
+															geoDoubleParamsPtr,
+															geoDoubleParameters);
+																								
+			mapProjectionInfoPtr = (MapProjectionInfoPtr)
+												GetHandlePointer (mapProjectionHandle,
+																			kLock);
+			
+			fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
+			
+			errCode = MGetMarker (fileStreamPtr, 
+											&savedPosOff,
+											kErrorMessages);
+			
+			if (errCode == noErr)
+				errCode = MSetMarker (fileStreamPtr, 
+												fsFromStart, 
+												imageFileDirectoryPtr->value,
+												kErrorMessages);
+												
+			count = MIN (imageFileDirectoryPtr->count, 100);			
+			count *= 2;
+			if (errCode == noErr)
+				errCode = MReadData (fileStreamPtr, 
+												&count, 
+												(char*)&geoTagInformation,
+												kErrorMessages); 
+												
+			if (errCode == noErr)
+				{
+						// Convert to number of 2 byte integers.
+						
+				count /= 2;
+				
+						//  Convert to number of geo key records.
+						
+				count /= 4;
+				
+				index = 0;		
+ 				for (recordIndex=0; recordIndex<count; recordIndex++)
+					{
+					geoKeyRecordPtr = &geoTagInformation[index];
+					for (i=0; i<4; i++, index++)
+								// Swap the bytes if needed.
+						geoTagInformation[index] = 
+									(UInt16)GetShortIntValue ((char*)&geoTagInformation[index]);
+				
+							// The first geo key record is the version and number of geo keys.
+							// We will skip it.
+						
+					if (recordIndex == 0)
+						geoKeyRecordPtr[0] = 0;
+										
+					switch (geoKeyRecordPtr[0])
+						{
+						case 1024:	// GTModelTypeGeoKey
+							if (geoKeyRecordPtr[3] == 2)
+								{
+								mapProjectionInfoPtr->gridCoordinate.referenceSystemCode = kGeographicRSCode;
+								mapProjectionInfoPtr->planarCoordinate.mapUnitsCode = kDecimalDegreesCode;
+								
+								}	// end "if (geoKeyRecordPtr[3] == 2)"
+							break;
+							
+						case 1025:	// GTRasterTypeGeoKey RasterPixelIsArea (=1) or RasterPixelIsPoint (=2)
+							*rasterTypeGeoKeyPtr = geoKeyRecordPtr[3];
+							if (*rasterTypeGeoKeyPtr < 1 || *rasterTypeGeoKeyPtr > 2)
+								*rasterTypeGeoKeyPtr = 1;
+							break;
+							
+						case 1026:	// GTCitationGeoKey
+									// Used when description of image is listed
+							break;
+							
+						case 2048:	// GeographicTypeGeoKey
+							if (geoKeyRecordPtr[3] == 4035)
+								mapProjectionInfoPtr->geodetic.datumCode = kSphereDatumCode;
+								
+							else if (geoKeyRecordPtr[3] == 4121)
+								mapProjectionInfoPtr->geodetic.datumCode = kGGRS87DatumCode;
+								
+							else if (geoKeyRecordPtr[3] == 4221)
 								mapProjectionInfoPtr->geodetic.datumCode = kCampoCode;
 								
 							else if (geoKeyRecordPtr[3] == 4267)
@@ -1618,232 +2707,808 @@ SInt16 GetGeoKeyParameters (
 															geoDoubleParameters[geoKeyRecordPtr[3]];
 							break;
 						
-						}	// end "switch (geoKeyRecordPtr[0])"
+						}	// end "switch (geoKeyRecordPtr[0])"
+										
+					}	// end "for (recordIndex=0; recordIndex<count; recordIndex++)"
+				
+				}	// end "if (errCode == noErr)"
+					
+			if (errCode == noErr)
+				errCode = MSetMarker (fileStreamPtr, 
+												fsFromStart, 
+												savedPosOff,
+												kErrorMessages);
+			
+			if (mapProjectionInfoPtr->gridCoordinate.projectionCode == kNotDefinedCode &&
+						mapProjectionInfoPtr->gridCoordinate.referenceSystemCode >=
+																						kGaussKrugerRSCode)
+				mapProjectionInfoPtr->gridCoordinate.projectionCode = 
+							GetProjectionCodeFromReferenceSystemCode (
+										mapProjectionInfoPtr->gridCoordinate.referenceSystemCode,
+										mapProjectionInfoPtr->gridCoordinate.gridZone);
+												
+			CheckAndUnlockHandle (mapProjectionHandle);
+												
+			}	// end "if (mapProjectionHandle != NULL)"
+			
+		}	// end "if (imageFileDirectoryPtr->type == kTIFFShort && ..."
+		
+	return (errCode);
+	
+}	// end "GetGeoKeyParameters"
+#endif		// use_multispec_tiffcode
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 GetSpecifiedTIFFKeyDirectory
+//
+//	Software purpose:	The purpose of this routine is to get the specified TIFF
+//							Key directory.
+//
+//	Parameters in:					
+//
+//	Parameters out:				
+//
+//	Value Returned:	
+//
+// Called By:			ListDescriptionInformation in SOther.cpp
+//
+//	Coded By:			Larry L. Biehl			Date: 02/18/2012
+//	Revised By:			Larry L. Biehl			Date: 05/14/2012
+
+Boolean GetSpecifiedTIFFKeyDirectory (
+				FileInfoPtr 						fileInfoPtr,
+				UInt32								tiffKeyNumber,
+				TIFFImageFileDirectory*			tiffFileDirectoryPtr)
+
+{
+	char									headerRecordPtr[512];
+	
+	CMFileStream*						fileStreamPtr;
+										
+	SInt64								ifdOffset;
+										
+	UInt32								count,
+											ifdOffset32Bit;
+	
+	SInt16								errCode,
+											item,
+											numberEntries;
+											
+	Boolean								foundFlag = FALSE,
+											savedSwapBytesFlag;
+	
+								
+	fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
+	
+			// Set the global swap bytes flag to reflect the data file being read.													
+		
+	savedSwapBytesFlag = gSwapBytesFlag;
+	gSwapBytesFlag = fileInfoPtr->swapHeaderBytesFlag;
+	
+			// Make certain that we are at the beginning of the file.
+	
+	ifdOffset = 4;
+	errCode = MSetMarker (fileStreamPtr, fsFromStart, ifdOffset, kErrorMessages);
+	
+			// Read bytes 4-7 bytes of the data.
+	
+	count = 4;
+	if (errCode == noErr)
+		errCode = MReadData (fileStreamPtr, &count, headerRecordPtr, kNoErrorMessages); 
+				
+	if (errCode == noErr)
+		{
+				// Get first Image File Directory.											
+			
+		BlockMoveData (headerRecordPtr, (char*)&ifdOffset32Bit, 4);
+		ifdOffset = (UInt32)GetLongIntValue ((char*)&ifdOffset32Bit);
+
+				// Initialize some tags that will be saved.
+				
+		tiffFileDirectoryPtr->tag = 0;	
+				
+		errCode = MSetMarker (fileStreamPtr, 
+										fsFromStart, 
+										ifdOffset,
+										kErrorMessages);
+			
+				// Read in the first image file directory.							
+		
+		if (errCode == noErr)
+			{
+			count = 2;
+			errCode = MReadData (fileStreamPtr, 
+											&count, 
+											&numberEntries,
+											kErrorMessages);
+				
+			}	// end "if (errCode == noErr)" 
+			
+		if (errCode == noErr)
+			{
+			numberEntries = GetShortIntValue ((char*)&numberEntries);
+			
+			for (item=1; item<=numberEntries; item++)
+				{
+				errCode = GetTiffEntry (fileStreamPtr,
+													headerRecordPtr,
+													tiffFileDirectoryPtr);
+				
+				if (tiffFileDirectoryPtr->tag >= tiffKeyNumber)
+					{
+					if (tiffFileDirectoryPtr->tag == tiffKeyNumber)
+						foundFlag = TRUE;
+						
+					break;
+					
+					}	// end "if (imageFileDirectoryPtr->tag >= tiffKeyNumber)"
+					
+				if (tiffFileDirectoryPtr->tag == 0 || errCode != noErr)
+					break;
+					
+				}	// end "for (item=1, item<=numberEntries, item++)" 
+																					
+			}	// end "if (errCode == noErr)"
+					
+		}	// end "if (errCode == noErr)"	
+		
+			// Reset the global swap byte flag
+				
+	gSwapBytesFlag = savedSwapBytesFlag;
+		
+	return (foundFlag);
+	
+}	// end "GetSpecifiedTIFFKeyDirectory"
+  
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean GetSwapBytesFlagForTiffFile
+//
+//	Software purpose:	The purpose of this routine is to read the Geo Key Parameters.
+//
+//	Parameters in:		None
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None				
+// 
+// Called By:			
+//
+//	Coded By:			Larry L. Biehl			Date: 02/07/2012
+//	Revised By:			Larry L. Biehl			Date: 02/07/2012
+
+Boolean GetSwapBytesFlagForTiffFile (
+				char*									headerRecordPtr)
+
+{	
+	unsigned char						charKeyCode[4];
+	
+	SInt16								stringCompare;
+	
+	Boolean								swapBytesFlag = FALSE;
+	
+	
+	if (headerRecordPtr != NULL)
+		{	
+		charKeyCode[0] = 0x4d;
+		charKeyCode[1] = 0x4d;
+		charKeyCode[2] = 0x00;
+		charKeyCode[3] = 0x2a;		                                                          
+		stringCompare = (SInt16)strncmp ((char*)headerRecordPtr, (CharPtr)charKeyCode, 4);
+		
+		if (stringCompare == 0)
+			swapBytesFlag = !gBigEndianFlag;
+			
+		else	// stringCompare != 0
+			{              
+			charKeyCode[0] = 0x49;
+			charKeyCode[1] = 0x49;
+			charKeyCode[2] = 0x2a;
+			charKeyCode[3] = 0x00;             
+			stringCompare = (SInt16)strncmp ((char*)headerRecordPtr, (CharPtr)charKeyCode, 4);
 										
-					}	// end "for (recordIndex=0; recordIndex<count; recordIndex++)"
+			if (stringCompare == 0)
+				swapBytesFlag = gBigEndianFlag;
+				
+			}	// end "if (stringCompare != 0)" 
+			
+		}	// end "if (headerRecordPtr != NULL)"
+		
+	return (swapBytesFlag);
+	
+}	// end "GetSwapBytesFlagForTiffFile"
+							
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 GetTiffEntry
+//
+//	Software purpose:	This routine reads a TIFF Image File Directory
+//							and interprets the parameters.
+//
+//	Parameters in:					
+//
+//	Parameters out:				
+//
+//	Value Returned:	
+//
+// Called By:
+//
+//	Coded By:			Larry L. Biehl			Date: 12/16/1994
+//	Revised By:			Larry L. Biehl			Date: 07/07/2005
+
+SInt16 GetTiffEntry (
+				CMFileStream* 				fileStreamPtr,
+				char*							inputBufferPtr,
+				TIFF_IFD_Ptr				imageFileDirectoryPtr)
+
+{
+	UInt32						count,
+									tempLongInt,
+									value;
+	
+	SInt16						errCode,
+									tag,
+									tempInt,
+									type;
+	
+			
+	count = 12;
+	errCode = MReadData (fileStreamPtr, &count, inputBufferPtr, kErrorMessages);
+	
+	if (errCode == noErr)
+		{
+				// Get the tag number.												
+				
+		BlockMoveData ((char*)&inputBufferPtr[0], (char*)&tempInt, 2);
+		
+      tag = GetShortIntValue ((char*)&tempInt);
+			
+				// Get the type code.												
+				
+		BlockMoveData ((char*)&inputBufferPtr[2], (char*)&tempInt, 2);
+		
+      type = GetShortIntValue ((char*)&tempInt);
+			
+				// Get the number of values of the indicated type.			
+				
+		BlockMoveData ((char*)&inputBufferPtr[4], (char*)&tempLongInt, 4);
+		
+		count = (UInt32)GetLongIntValue ((char*)&tempLongInt);
+			
+				// Get the value or the offset.									
+		
+		if (type == kTIFFShort && count == 1)
+			{
+			BlockMoveData ((char*)&inputBufferPtr[8], (char*)&tempInt, 2);
+			
+      	value = (UInt32)((UInt16)GetShortIntValue ((char*)&tempInt));
+				
+			}	// end "if (type == kTIFFShort && count == 1)" 
+			
+		else if (type == kTIFFLong || kTIFFRational || count > 1)
+			{
+			BlockMoveData ((char*)&inputBufferPtr[8], (char*)&tempLongInt, 4);
+			
+			value = (UInt32)GetLongIntValue ((char*)&tempLongInt);
+				
+			}	// end "if (type == kTIFFLong || kTIFFRational || count > 1)" 
+			
+		else	// something else
+			value = 0;
+			
+		imageFileDirectoryPtr->tag = (UInt16)tag;
+		imageFileDirectoryPtr->type = type;
+		imageFileDirectoryPtr->count = count;
+		imageFileDirectoryPtr->value = value;
+			
+		}	// end "if (errCode == noErr)" 
+		
+	else	// errCode != noErr 
+		imageFileDirectoryPtr->tag = 0;
+			
+	return (errCode);
+	
+}	// end "GetTiffEntry"    
+  
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 GetTIFFASCIIParameters
+//
+//	Software purpose:	The purpose of this routine is to read the text string for the
+//							input tag.
+//
+//	Parameters in:		None
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None				
+// 
+// Called By:			
+//
+//	Coded By:			Larry L. Biehl			Date: 12/04/2000
+//	Revised By:			Larry L. Biehl			Date: 12/22/2003
+
+SInt16 GetTIFFASCIIParameters (
+				CMFileStream*						fileStreamPtr,
+				TIFF_IFD_Ptr						imageFileDirectoryPtr,
+				char*									stringPtr,
+				SInt32								numberCharacters)
+
+{	
+	SInt64								savedPosOff;
+											
+	UInt32								count;
+	
+	SInt16								errCode = -1;
+	
+	
+	if (imageFileDirectoryPtr->type == kTIFFASCII && 
+						numberCharacters <= (SInt32)imageFileDirectoryPtr->count)
+		{		
+		errCode = MGetMarker (fileStreamPtr, 
+										&savedPosOff,
+										kErrorMessages);
+		
+		if (errCode == noErr)
+			errCode = MSetMarker (fileStreamPtr, 
+											fsFromStart, 
+											imageFileDirectoryPtr->value,
+											kErrorMessages);
+											
+		count = (UInt32)numberCharacters;			
+		if (errCode == noErr)
+			errCode = MReadData (fileStreamPtr, 
+											&count, 
+											stringPtr,
+											kErrorMessages);
+		
+				// Make sure the string is terminated.
+																
+		if (errCode == noErr)
+			stringPtr[count] = 0;
+											
 				
-				}	// end "if (errCode == noErr)"
-					
-			if (errCode == noErr)
-				errCode = MSetMarker (fileStreamPtr, 
-												fsFromStart, 
-												savedPosOff,
-												kErrorMessages);
-			
-			if (mapProjectionInfoPtr->gridCoordinate.projectionCode == kNotDefinedCode &&
-						mapProjectionInfoPtr->gridCoordinate.referenceSystemCode >=
-																						kGaussKrugerRSCode)
-				mapProjectionInfoPtr->gridCoordinate.projectionCode = 
-							GetProjectionCodeFromReferenceSystemCode (
-										mapProjectionInfoPtr->gridCoordinate.referenceSystemCode,
-										mapProjectionInfoPtr->gridCoordinate.gridZone);
-												
-			CheckAndUnlockHandle (mapProjectionHandle);
-												
-			}	// end "if (mapProjectionHandle != NULL)"
+		if (errCode == noErr)
+			errCode = MSetMarker (fileStreamPtr, 
+											fsFromStart, 
+											savedPosOff,
+											kErrorMessages);
 			
-		}	// end "if (imageFileDirectoryPtr->type == kTIFFShort && ..."
+		}	// end "if (imageFileDirectoryPtr->type == kTIFFASCII && ..."
 		
 	return (errCode);
 	
-}	// end "GetGeoKeyParameters"
-#endif		// use_multispec_tiffcode
-
+}	// end "GetTIFFASCIIParameters"
+  
 
 
+#if use_multispec_tiffcode
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Function name:		SInt16 GetSpecifiedTIFFKeyDirectory
-//
-//	Software purpose:	The purpose of this routine is to get the specified TIFF
-//							Key directory.
+//	Function name:		SInt16 GetTIFFDoubleParameters
 //
-//	Parameters in:					
+//	Software purpose:	The purpose of this routine is to set the pixel size parameters
+//							using the information in the GEOTIFF tag.
 //
-//	Parameters out:				
+//	Parameters in:		None
 //
-//	Value Returned:	
+//	Parameters out:	None
 //
-// Called By:			ListDescriptionInformation in SOther.cpp
+//	Value Returned:	None				
+// 
+// Called By:			
 //
-//	Coded By:			Larry L. Biehl			Date: 02/18/2012
-//	Revised By:			Larry L. Biehl			Date: 05/14/2012
+//	Coded By:			Larry L. Biehl			Date: 12/01/2000
+//	Revised By:			Larry L. Biehl			Date: 12/22/2003
 
-Boolean GetSpecifiedTIFFKeyDirectory (
-				FileInfoPtr 						fileInfoPtr,
-				UInt32								tiffKeyNumber,
-				TIFFImageFileDirectory*			tiffFileDirectoryPtr)
+SInt16 GetTIFFDoubleParameters (
+				CMFileStream*						fileStreamPtr,
+				TIFF_IFD_Ptr						imageFileDirectoryPtr,
+				double*								doubleParameterPtr,
+				SInt32								numberParameters)
 
-{
-	char									headerRecordPtr[512];
+{	
+	UInt8									tempDouble[8];
 	
-	CMFileStream*						fileStreamPtr;
-										
-	SInt64								ifdOffset;
-										
-	UInt32								count,
-											ifdOffset32Bit;
+	SInt64								savedPosOff;
 	
-	SInt16								errCode,
-											item,
-											numberEntries;
+	SInt32								index;
 											
-	Boolean								foundFlag = FALSE,
-											savedSwapBytesFlag;
-	
-								
-	fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
-	
-			// Set the global swap bytes flag to reflect the data file being read.													
-		
-	savedSwapBytesFlag = gSwapBytesFlag;
-	gSwapBytesFlag = fileInfoPtr->swapHeaderBytesFlag;
-	
-			// Make certain that we are at the beginning of the file.
+	UInt32								count;
 	
-	ifdOffset = 4;
-	errCode = MSetMarker (fileStreamPtr, fsFromStart, ifdOffset, kErrorMessages);
+	SInt16								errCode = -1;
 	
-			// Read bytes 4-7 bytes of the data.
 	
-	count = 4;
-	if (errCode == noErr)
-		errCode = MReadData (fileStreamPtr, &count, headerRecordPtr, kNoErrorMessages); 
-				
-	if (errCode == noErr)
-		{
-				// Get first Image File Directory.											
-			
-		BlockMoveData (headerRecordPtr, (char*)&ifdOffset32Bit, 4);
-		ifdOffset = (UInt32)GetLongIntValue ((char*)&ifdOffset32Bit);
-
-				// Initialize some tags that will be saved.
-				
-		tiffFileDirectoryPtr->tag = 0;	
-				
-		errCode = MSetMarker (fileStreamPtr, 
-										fsFromStart, 
-										ifdOffset,
+	if (imageFileDirectoryPtr->type == kTIFFDouble && 
+										numberParameters <= (SInt32)imageFileDirectoryPtr->count)
+		{		
+		errCode = MGetMarker (fileStreamPtr, 
+										&savedPosOff,
 										kErrorMessages);
-			
-				// Read in the first image file directory.							
 		
 		if (errCode == noErr)
-			{
-			count = 2;
-			errCode = MReadData (fileStreamPtr, 
-											&count, 
-											&numberEntries,
+			errCode = MSetMarker (fileStreamPtr, 
+											fsFromStart, 
+											imageFileDirectoryPtr->value,
 											kErrorMessages);
-				
-			}	// end "if (errCode == noErr)" 
-			
-		if (errCode == noErr)
+											
+		for (index=0; index<numberParameters; index++)
 			{
-			numberEntries = GetShortIntValue ((char*)&numberEntries);
+			count = 8;			
+			if (errCode == noErr)
+				errCode = MReadData (fileStreamPtr, 
+												&count, 
+												tempDouble,
+												kErrorMessages);
+					
+			if (errCode != noErr)
+				break;
+												
+			doubleParameterPtr[index] = GetDoubleValue (tempDouble);
 			
-			for (item=1; item<=numberEntries; item++)
-				{
-				errCode = GetTiffEntry (fileStreamPtr,
-													headerRecordPtr,
-													tiffFileDirectoryPtr);
+			}	// end "for (index=0; index<numberParameters; index++)"
 				
-				if (tiffFileDirectoryPtr->tag >= tiffKeyNumber)
-					{
-					if (tiffFileDirectoryPtr->tag == tiffKeyNumber)
-						foundFlag = TRUE;
-						
-					break;
-					
-					}	// end "if (imageFileDirectoryPtr->tag >= tiffKeyNumber)"
-					
-				if (tiffFileDirectoryPtr->tag == 0 || errCode != noErr)
-					break;
-					
-				}	// end "for (item=1, item<=numberEntries, item++)" 
-																					
-			}	// end "if (errCode == noErr)"
-					
-		}	// end "if (errCode == noErr)"	
+		if (errCode == noErr)
+			errCode = MSetMarker (fileStreamPtr, 
+											fsFromStart, 
+											savedPosOff,
+											kErrorMessages);
+			
+		}	// end "if (imageFileDirectoryPtr->type == kTIFFDouble && count <= ..."
 		
-			// Reset the global swap byte flag
-				
-	gSwapBytesFlag = savedSwapBytesFlag;
+	return (errCode);
+	
+}	// end "GetTIFFDoubleParameters"
+#endif		// use_multispec_tiffcode
+  
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		UInt32 GetTIFFEncodeBufferBytes
+//
+//	Software purpose:	The purpose of this routine is to get the number of bytes
+//							needed for the buffer for the compressed data of a TIFF block
+//							for the worst case. This allows for LZW codes of 12 bits for
+//							each input byte and for the Deflate stored block overhead.
+//
+//	Parameters in:		Number of bytes in the uncompressed block.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	Number of bytes for the compressed data buffer.
+// 
+// Called By:			EncodeTIFFLZWData in SGeoTIFF.cpp
+//							CreateTIFFStripWriter in SSaveWrite.cpp
+
+UInt32 GetTIFFEncodeBufferBytes (
+				UInt32								numberInputBytes)
+
+{
+	return (numberInputBytes + numberInputBytes/2 + numberInputBytes/2048 + 64);
+	
+}	// end "GetTIFFEncodeBufferBytes"
+  
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void GetTIFFImageDescription
+//
+//	Software purpose:	The purpose of this routine is to get the text for the "Image
+//							Description Tag (270) in the TIFF/GeoTIFF file.
+//
+//	Parameters in:		None
+//
+//	Parameters out:	Text for the TIFF Image Description tag (270). No text is
+//							returned if there is no 270 tag.
+//
+//	Value Returned:	None				
+// 
+// Called By:			
+//
+//	Coded By:			Larry L. Biehl			Date: 06/28/2018
+//	Revised By:			Larry L. Biehl			Date: 06/28/2018
+
+void GetTIFFImageDescription (
+				FileInfoPtr							fileInfoPtr,
+				char*									imageDescriptionStringPtr,
+				UInt32								stringLengthLimit)
+
+{
+	CMFileStream*						fileStreamPtr;
+	TIFFImageFileDirectory			tiffFileDirectory;
+	
+	
+	imageDescriptionStringPtr[0] = 0;
+	fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
+	if (GetSpecifiedTIFFKeyDirectory (fileInfoPtr,
+													270,
+													&tiffFileDirectory))
+		{
+		stringLengthLimit = (SInt16)MIN (tiffFileDirectory.count, stringLengthLimit);
+		GetTIFFASCIIParameters (fileStreamPtr,
+										&tiffFileDirectory,
+										imageDescriptionStringPtr,
+										stringLengthLimit);
+		
+		}	// end "if (GetSpecifiedTIFFKeyDirectory (fileInfoPtr, ..."
+	
+}	// end "GetTIFFImageDescription"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 GetTIFFNumberHeaderBytes
+//
+//	Software purpose:	The purpose of this routine is to get the number of header
+//							bytes in the TIFF/GeoTIFF file. 0 will be returned if the number
+//							of header bytes cannot be determined or if the data in the file
+//							is compressed, tiled or striped. The data needs to be organized
+//							such that one can calculate where a specific pixel is just based
+//							on the number of header bytes and the number of lines, columns
+//							and bytes per pixel.
+//
+//	Parameters in:					
+//
+//	Parameters out:				
+//
+//	Value Returned:	
+//
+// Called By:			ListDescriptionInformation in SOther.cpp
+//
+//	Coded By:			Larry L. Biehl			Date: 04/16/2013
+//	Revised By:			Larry L. Biehl			Date: 04/16/2013
+
+UInt32 GetTIFFNumberHeaderBytes (
+				FileInfoPtr 						fileInfoPtr)
+
+{
+	TIFFImageFileDirectory			tiffFileDirectory;
+	
+	UInt32								numberHeaderBytes = 0;
+	
+								
+	if (GetSpecifiedTIFFKeyDirectory (fileInfoPtr, 273, &tiffFileDirectory))
+		{
+		if (tiffFileDirectory.count == 1)
+			numberHeaderBytes = tiffFileDirectory.value;
+
+		}	// end "if (GetSpecifiedTIFFKeyDirectory (fileInfoPtr, 273, ..."
 		
-	return (foundFlag);
+	return (numberHeaderBytes);
 	
-}	// end "GetSpecifiedTIFFKeyDirectory"
-  
+}	// end "GetTIFFNumberHeaderBytes"
+
 
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Function name:		Boolean GetSwapBytesFlagForTiffFile
+//	Function name:		Boolean ListGeoTiffTextDescriptionParameters
 //
-//	Software purpose:	The purpose of this routine is to read the Geo Key Parameters.
+//	Software purpose:	The purpose of this routine is to list the information for the
+//							ascii Geo Key Parameters.
 //
-//	Parameters in:		None
+//	Parameters in:		
 //
 //	Parameters out:	None
 //
 //	Value Returned:	None				
 // 
-// Called By:			
+// Called By:			ListTiffTextDescriptionParameters in SGeoTIFF.cpp
 //
-//	Coded By:			Larry L. Biehl			Date: 02/07/2012
-//	Revised By:			Larry L. Biehl			Date: 02/07/2012
+//	Coded By:			Larry L. Biehl			Date: 07/12/2011
+//	Revised By:			Larry L. Biehl			Date: 07/12/2011
 
-Boolean GetSwapBytesFlagForTiffFile (
-				char*									headerRecordPtr)
+Boolean ListGeoTiffTextDescriptionParameters (
+				FileInfoPtr							fileInfoPtr,
+				TIFF_IFD_Ptr						imageFileDirectoryPtr,
+				TIFF_IFD_Ptr						geoAsciiStringPtr,
+				Boolean*								addBlankLineFlagPtr)
 
 {	
-	unsigned char						charKeyCode[4];
+	char									savedChar,
+											textString[1024];
 	
-	SInt16								stringCompare;
+	SInt64								savedPosOff;
+											
+	CMFileStream*						fileStreamPtr;
+	UInt16*								geoKeyRecordPtr;
+				
+	UInt32								count,
+											i,
+											index,
+											recordIndex;
 	
-	Boolean								swapBytesFlag = FALSE;
+	UInt16								geoTagInformation[100];
 	
+	SInt16								errCode,
+											stringLength,
+											textStringLength;
 	
-	if (headerRecordPtr != NULL)
-		{	
-		charKeyCode[0] = 0x4d;
-		charKeyCode[1] = 0x4d;
-		charKeyCode[2] = 0x00;
-		charKeyCode[3] = 0x2a;		                                                          
-		stringCompare = (SInt16)strncmp ((char*)headerRecordPtr, (CharPtr)charKeyCode, 4);
-		
-		if (stringCompare == 0)
-			swapBytesFlag = !gBigEndianFlag;
+	Boolean								continueFlag = TRUE,
+											stringListedFlag;
+	
+	
+	if (imageFileDirectoryPtr->type == kTIFFShort && imageFileDirectoryPtr->count > 0)
+		{																	
+				// Get ascii information in case it will be needed later.
+					
+		GetGeoASCIIStringFromGeoTIFF (fileInfoPtr,
+													geoAsciiStringPtr,
+													textString,
+													1023);
+																								
+		fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
 			
-		else	// stringCompare != 0
-			{              
-			charKeyCode[0] = 0x49;
-			charKeyCode[1] = 0x49;
-			charKeyCode[2] = 0x2a;
-			charKeyCode[3] = 0x00;             
-			stringCompare = (SInt16)strncmp ((char*)headerRecordPtr, (CharPtr)charKeyCode, 4);
-										
-			if (stringCompare == 0)
-				swapBytesFlag = gBigEndianFlag;
+		errCode = MGetMarker (fileStreamPtr, 
+											&savedPosOff,
+											kErrorMessages);
+			
+		if (errCode == noErr)
+			errCode = MSetMarker (fileStreamPtr, 
+												fsFromStart, 
+												imageFileDirectoryPtr->value,
+												kErrorMessages);
+												
+		count = MIN (imageFileDirectoryPtr->count, 100);			
+		count *= 2;
+		if (errCode == noErr)
+			errCode = MReadData (fileStreamPtr, 
+												&count, 
+												(char*)&geoTagInformation,
+												kErrorMessages); 
+												
+		if (errCode == noErr)
+			{
+					// Convert to number of 2 byte integers.
+						
+			count /= 2;
+			
+					//  Convert to number of geo key records.
+					
+			count /= 4;
+			
+			index = 0;		
+			for (recordIndex=0; recordIndex<count; recordIndex++)
+				{
+				geoKeyRecordPtr = &geoTagInformation[index];
+				for (i=0; i<4; i++, index++)
+							// Swap the bytes if needed.
+					geoTagInformation[index] = 
+									(UInt16)GetShortIntValue ((char*)&geoTagInformation[index]);
+			
+						// The first geo key record is the version and number of geo keys.
+						// We will skip it.
+					
+				if (recordIndex == 0)
+					geoKeyRecordPtr[0] = 0;
+					
+				stringListedFlag = FALSE;
+									
+				switch (geoKeyRecordPtr[0])
+					{
+					case 1026:	// GTCitationGeoKey
+						textStringLength = MIN (geoKeyRecordPtr[2], 1023);
+						stringLength = sprintf ((char*)gTextString,
+														"    GeoTIFF GTCitationGeoKey: ");						
+						continueFlag = ListString ((char*)gTextString,  
+															stringLength,
+															gOutputTextH);
+								
+								// Save the character for Windows version, since a terminator
+								// character is put into this location.
+
+						savedChar = textString[geoKeyRecordPtr[3]+textStringLength];
+						
+						continueFlag = ListString (
+												&textString[geoKeyRecordPtr[3]], 
+												textStringLength, 
+												gOutputTextH);
+
+						textString[geoKeyRecordPtr[3]+textStringLength] = savedChar;
+						
+						stringListedFlag = TRUE;
+						break;
+													
+					case 2049:	// GeogCitationGeoKey
+						textStringLength = MIN (geoKeyRecordPtr[2], 1023);
+						stringLength = sprintf ((char*)gTextString,
+														"    GeoTIFF GeogCitationGeoKey: ");						
+						continueFlag = ListString ((char*)gTextString,  
+															stringLength,
+															gOutputTextH);
+								
+								// Save the character for Windows version, since a terminator
+								// character is put into this location.
+
+						savedChar = textString[geoKeyRecordPtr[3]+textStringLength];
+															
+						continueFlag = ListString (
+												&textString[geoKeyRecordPtr[3]], 
+												textStringLength, 
+												gOutputTextH);
+
+						textString[geoKeyRecordPtr[3]+textStringLength] = savedChar;
+						
+						stringListedFlag = TRUE;
+						break;
+													
+					case 3073:	// PCSCitationGeoKey
+						textStringLength = MIN (geoKeyRecordPtr[2], 1023);
+						stringLength = sprintf ((char*)gTextString,
+															"    GeoTIFF PCSCitationGeoKey: ");						
+						continueFlag = ListString ((char*)gTextString,  
+															stringLength,
+															gOutputTextH);
+															
+						continueFlag = ListString (
+												&textString[geoKeyRecordPtr[3]], 
+												textStringLength, 
+												gOutputTextH);
+						
+						stringListedFlag = TRUE;
+						break;
+												
+					}	// end "switch (geoKeyRecordPtr[0])"
+					
+				if (stringListedFlag && continueFlag)
+					{
+					continueFlag = ListString (
+											(char*)gEndOfLine, 
+											gNumberOfEndOfLineCharacters, 
+											gOutputTextH);		
+											
+					*addBlankLineFlagPtr = TRUE;
+					
+					}	// end "if (stringListedFlag && continueFlag)"
+											
+				if (!continueFlag || geoKeyRecordPtr[0] > 3073)
+					break;
+									
+				}	// end "for (recordIndex=0; recordIndex<count; recordIndex++)"
+			
+			}	// end "if (errCode == noErr)"
 				
-			}	// end "if (stringCompare != 0)" 
+		if (errCode == noErr)
+			errCode = MSetMarker (fileStreamPtr, 
+											fsFromStart, 
+											savedPosOff,
+											kErrorMessages);
 			
-		}	// end "if (headerRecordPtr != NULL)"
+		}	// end "if (imageFileDirectoryPtr->type == kTIFFShort && ..."
 		
-	return (swapBytesFlag);
-	
-}	// end "GetSwapBytesFlagForTiffFile"
-							
+	return (continueFlag);
+		
+}	// end "ListGeoTiffTextDescriptionParameters"
+
 
 
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Function name:		SInt16 GetTiffEntry
+//	Function name:		Boolean ListTiffTextDescriptionParameters
 //
-//	Software purpose:	This routine reads a TIFF Image File Directory
-//							and interprets the parameters.
+//	Software purpose:	This procedure lists the text information for those tags
+//							which might contain them. This include tags 270, 1026, 2049 and
+//							3073.
 //
 //	Parameters in:					
 //
@@ -1851,621 +3516,699 @@ Boolean GetSwapBytesFlagForTiffFile (
 //
 //	Value Returned:	
 //
-// Called By:
+// Called By:			ListDescriptionInformation in SOther.cpp
 //
-//	Coded By:			Larry L. Biehl			Date: 12/16/1994
-//	Revised By:			Larry L. Biehl			Date: 07/07/2005
+//	Coded By:			Larry L. Biehl			Date: 07/12/2011
+//	Revised By:			Larry L. Biehl			Date: 08/30/2011
 
-SInt16 GetTiffEntry (
-				CMFileStream* 				fileStreamPtr,
-				char*							inputBufferPtr,
-				TIFF_IFD_Ptr				imageFileDirectoryPtr)
+Boolean ListTiffTextDescriptionParameters (
+				FileInfoPtr 						fileInfoPtr)
 
 {
-	UInt32						count,
-									tempLongInt,
-									value;
+	char									headerRecordPtr[512],
+											textString[1024];
 	
-	SInt16						errCode,
-									tag,
-									tempInt,
-									type;
+	TIFFImageFileDirectory			geoAsciiParamsTag,
+											geoKeyDirectoryTag,
+											imageFileDirectory;
+	
+	CMFileStream*						fileStreamPtr;
+										
+	UInt32								ifdOffset;
+										
+	UInt32								count;
+	
+	SInt16								errCode,
+											item,
+											numberEntries,
+											stringLength,
+											textStringLength;
+											
+	Boolean								addBlankLineFlag = FALSE,
+											continueFlag = TRUE,
+											stringListedFlag;
+	
+								
+	fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
 	
+			// Set the global swap bytes flag to reflect the data file being read.													
 			
-	count = 12;
-	errCode = MReadData (fileStreamPtr, &count, inputBufferPtr, kErrorMessages);
+	gSwapBytesFlag = fileInfoPtr->swapHeaderBytesFlag;
 	
+			// Make certain that we are at the beginning of the file.
+	
+	ifdOffset = 4;
+	errCode = MSetMarker (fileStreamPtr, fsFromStart, ifdOffset, kErrorMessages);
+	
+			// Read bytes 4-7 bytes of the data.
+	
+	count = 4;
 	if (errCode == noErr)
-		{
-				// Get the tag number.												
+		errCode = MReadData (fileStreamPtr, &count, headerRecordPtr, kNoErrorMessages); 
 				
-		BlockMoveData ((char*)&inputBufferPtr[0], (char*)&tempInt, 2);
-		
-      tag = GetShortIntValue ((char*)&tempInt);
+	if (errCode == noErr)
+		{
+				// Get first Image File Directory.											
 			
-				// Get the type code.												
+		BlockMoveData (headerRecordPtr, (char*)&ifdOffset, 4);
+		ifdOffset = (UInt32)GetLongIntValue ((char*)&ifdOffset);
+
+				// Initialize some tags that will be saved.
 				
-		BlockMoveData ((char*)&inputBufferPtr[2], (char*)&tempInt, 2);
-		
-      type = GetShortIntValue ((char*)&tempInt);
-			
-				// Get the number of values of the indicated type.			
+		geoAsciiParamsTag.tag = 0;
+		geoKeyDirectoryTag.tag = 0;	
 				
-		BlockMoveData ((char*)&inputBufferPtr[4], (char*)&tempLongInt, 4);
-		
-		count = (UInt32)GetLongIntValue ((char*)&tempLongInt);
+		errCode = MSetMarker (fileStreamPtr, 
+										fsFromStart, 
+										(SInt64)ifdOffset,
+										kErrorMessages);
 			
-				// Get the value or the offset.									
+				// Read in the first image file directory.							
 		
-		if (type == kTIFFShort && count == 1)
+		if (errCode == noErr)
 			{
-			BlockMoveData ((char*)&inputBufferPtr[8], (char*)&tempInt, 2);
-			
-      	value = (UInt32)((UInt16)GetShortIntValue ((char*)&tempInt));
+			count = 2;
+			errCode = MReadData (fileStreamPtr, 
+											&count, 
+											&numberEntries,
+											kErrorMessages);
 				
-			}	// end "if (type == kTIFFShort && count == 1)" 
+			}	// end "if (errCode == noErr)" 
 			
-		else if (type == kTIFFLong || kTIFFRational || count > 1)
+		if (errCode == noErr)
 			{
-			BlockMoveData ((char*)&inputBufferPtr[8], (char*)&tempLongInt, 4);
-			
-			value = (UInt32)GetLongIntValue ((char*)&tempLongInt);
-				
-			}	// end "if (type == kTIFFLong || kTIFFRational || count > 1)" 
-			
-		else	// something else
-			value = 0;
-			
-		imageFileDirectoryPtr->tag = (UInt16)tag;
-		imageFileDirectoryPtr->type = type;
-		imageFileDirectoryPtr->count = count;
-		imageFileDirectoryPtr->value = value;
-			
-		}	// end "if (errCode == noErr)" 
-		
-	else	// errCode != noErr 
-		imageFileDirectoryPtr->tag = 0;
+			numberEntries = GetShortIntValue ((char*)&numberEntries);
 			
-	return (errCode);
-	
-}	// end "GetTiffEntry"    
-  
-
-
-//------------------------------------------------------------------------------------
-//                   Copyright 1988-2020 Purdue Research Foundation
-//
-//	Function name:		SInt16 GetTIFFASCIIParameters
-//
-//	Software purpose:	The purpose of this routine is to read the text string for the
-//							input tag.
-//
-//	Parameters in:		None
-//
-//	Parameters out:	None
-//
-//	Value Returned:	None				
-// 
-// Called By:			
-//
-//	Coded By:			Larry L. Biehl			Date: 12/04/2000
-//	Revised By:			Larry L. Biehl			Date: 12/22/2003
-
-SInt16 GetTIFFASCIIParameters (
-				CMFileStream*						fileStreamPtr,
-				TIFF_IFD_Ptr						imageFileDirectoryPtr,
-				char*									stringPtr,
-				SInt32								numberCharacters)
-
-{	
-	SInt64								savedPosOff;
-											
-	UInt32								count;
-	
-	SInt16								errCode = -1;
-	
-	
-	if (imageFileDirectoryPtr->type == kTIFFASCII && 
-						numberCharacters <= (SInt32)imageFileDirectoryPtr->count)
-		{		
-		errCode = MGetMarker (fileStreamPtr, 
-										&savedPosOff,
-										kErrorMessages);
+			for (item=1; item<=numberEntries; item++)
+				{
+				errCode = GetTiffEntry (fileStreamPtr,
+													headerRecordPtr,
+													&imageFileDirectory);
+					
+				stringListedFlag = FALSE;
+				switch (imageFileDirectory.tag)
+					{								
+					case 270:	// Image Description
+						textStringLength = (SInt16)MIN (imageFileDirectory.count, 1023);
+						GetTIFFASCIIParameters (fileStreamPtr,
+														&imageFileDirectory,
+														textString,
+														textStringLength);
+														
+						stringLength = sprintf ((char*)gTextString,
+														"    Image Description: ");						
+						continueFlag = ListString ((char*)gTextString,  
+															stringLength,
+															gOutputTextH);
+						
+						continueFlag = ListString (textString,
+																textStringLength,
+																gOutputTextH);
+						
+						stringListedFlag = TRUE;
+						break;
+													
+					case 33432:	// Copyright
+						textStringLength = (SInt16)MIN (imageFileDirectory.count, 1023);
+						GetTIFFASCIIParameters (fileStreamPtr,
+														&imageFileDirectory,
+														textString,
+														textStringLength);
+														
+						stringLength = sprintf ((char*)gTextString,
+														"    Copyright: ");						
+						continueFlag = ListString ((char*)gTextString,  
+															stringLength,
+															gOutputTextH);
+						
+						continueFlag = ListString (textString,
+																textStringLength,
+																gOutputTextH);
+						
+						stringListedFlag = TRUE;
+						break;
+													
+					case 34735:	// Geo Key Directory
+						geoKeyDirectoryTag = imageFileDirectory;
+						break;
+						
+					case 34737:	// Geo ASCII Parameters
+						geoAsciiParamsTag = imageFileDirectory;
+						break;
+						
+					default:
+						errCode = noErr;
+						break;
+						
+					}	// end "switch (imageFileDirectory.tag)" 
+					
+				if (stringListedFlag && continueFlag)
+					{
+					continueFlag = ListString ((char*)gEndOfLine,
+														gNumberOfEndOfLineCharacters,
+														gOutputTextH);		
+					
+					addBlankLineFlag = TRUE;
+					
+					}	// end "if (stringListedFlag && continueFlag)"
+					
+				if (imageFileDirectory.tag == 0 || errCode != noErr || !continueFlag)
+					break;
+					
+				}	// end "for (item=1, item<=numberEntries, item++)" 
+				
+			if (geoKeyDirectoryTag.tag == 34735 && errCode == noErr)
+				continueFlag = ListGeoTiffTextDescriptionParameters (fileInfoPtr,
+																						&geoKeyDirectoryTag,
+																						&geoAsciiParamsTag,
+																						&addBlankLineFlag);
+																					
+			}	// end "if (errCode == noErr)"
+					
+		if (continueFlag && addBlankLineFlag)
+			continueFlag = ListString ((char*)gEndOfLine,
+													gNumberOfEndOfLineCharacters,
+													gOutputTextH);	
 		
-		if (errCode == noErr)
-			errCode = MSetMarker (fileStreamPtr, 
-											fsFromStart, 
-											imageFileDirectoryPtr->value,
-											kErrorMessages);
-											
-		count = (UInt32)numberCharacters;			
-		if (errCode == noErr)
-			errCode = MReadData (fileStreamPtr, 
-											&count, 
-											stringPtr,
-											kErrorMessages);
+		}	// end "if (errCode == noErr)"	
 		
-				// Make sure the string is terminated.
-																
-		if (errCode == noErr)
-			stringPtr[count] = 0;
-											
+			// Reset the global swap byte flag
 				
-		if (errCode == noErr)
-			errCode = MSetMarker (fileStreamPtr, 
-											fsFromStart, 
-											savedPosOff,
-											kErrorMessages);
-			
-		}	// end "if (imageFileDirectoryPtr->type == kTIFFASCII && ..."
+	gSwapBytesFlag = FALSE;
 		
-	return (errCode);
+	return (continueFlag);
 	
-}	// end "GetTIFFASCIIParameters"
-  
+}	// end "ListTiffTextDescriptionParameters"
+
 
 
-#if use_multispec_tiffcode
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Function name:		SInt16 GetTIFFDoubleParameters
-//
-//	Software purpose:	The purpose of this routine is to set the pixel size parameters
-//							using the information in the GEOTIFF tag.
-//
-//	Parameters in:		None
+//	Function name:		SInt16 LoadCompressedTIFFStructure
+//
+//	Software purpose:	The purpose of this routine is to set up the hierarchal file
+//							structure for a TIFF file whose strips or tiles are compressed.
+//							Each strip or tile is treated as a block. The file offset and
+//							compressed size of each block is saved in the block format
+//							structures; the block size and offset in the hfa structures
+//							represent the decompressed block. The strips in a strip
+//							organized file are treated as blocks that are the width of the
+//							image.
+//
+//	Parameters in:		File information structure pointer.
+//							File stream pointer.
+//							Block (tile or strip) width and height.
+//							Number of block offsets, their type and the file position of
+//								the vector of offsets (or the offset if there is only one).
+//							Number of block byte counts, their type and the file position
+//								of the vector of byte counts (or the byte count if there
+//								is only one).
 //
 //	Parameters out:	None
 //
-//	Value Returned:	None				
+//	Value Returned:	noErr if the structure was set up.
+//							-2 if the data cannot be decompressed by MultiSpec.
+//							-8 if there was an inconsistency in the block information.
 // 
-// Called By:			
-//
-//	Coded By:			Larry L. Biehl			Date: 12/01/2000
-//	Revised By:			Larry L. Biehl			Date: 12/22/2003
+// Called By:			ReadTIFFHeader in SGeoTIFF.cpp
 
-SInt16 GetTIFFDoubleParameters (
-				CMFileStream*						fileStreamPtr,
-				TIFF_IFD_Ptr						imageFileDirectoryPtr,
-				double*								doubleParameterPtr,
-				SInt32								numberParameters)
+SInt16 LoadCompressedTIFFStructure (
+				FileInfoPtr 						fileInfoPtr,
+				CMFileStream* 						fileStreamPtr,
+				UInt32								blockWidth,
+				UInt32								blockHeight,
+				UInt32								numberBlockOffsets,
+				UInt32								blockOffsetType,
+				UInt32								blockOffsetVector,
+				UInt32								numberBlockByteCounts,
+				UInt32								blockByteCountType,
+				UInt32								blockByteCountVector)
 
-{	
-	UInt8									tempDouble[8];
+{
+	SInt64								blockBytes,
+											savedPosOff;
 	
-	SInt64								savedPosOff;
+	BlockFormatPtr						blockFormatPtr;
+	HierarchalFileFormatPtr			hfaPtr;
+	Ptr									ptr;
 	
-	SInt32								index;
-											
-	UInt32								count;
+	UInt32								*blockByteCountsPtr,
+											*blockStartsPtr;
 	
-	SInt16								errCode = -1;
+	UInt32								blocksPerChannel,
+											index,
+											numberBlockHeights,
+											numberBlocks,
+											numberBlockWidths,
+											numberPlanes,
+											samplesPerPixel;
 	
+	SInt16								errCode,
+											returnCode;
 	
-	if (imageFileDirectoryPtr->type == kTIFFDouble && 
-										numberParameters <= (SInt32)imageFileDirectoryPtr->count)
-		{		
-		errCode = MGetMarker (fileStreamPtr, 
-										&savedPosOff,
-										kErrorMessages);
-		
-		if (errCode == noErr)
-			errCode = MSetMarker (fileStreamPtr, 
-											fsFromStart, 
-											imageFileDirectoryPtr->value,
-											kErrorMessages);
-											
-		for (index=0; index<numberParameters; index++)
-			{
-			count = 8;			
-			if (errCode == noErr)
-				errCode = MReadData (fileStreamPtr, 
-												&count, 
-												tempDouble,
-												kErrorMessages);
-					
-			if (errCode != noErr)
-				break;
-												
-			doubleParameterPtr[index] = GetDoubleValue (tempDouble);
+	Boolean								planarFlag;
+	
+	
+			// Only data with whole bytes per sample can be decompressed.
 			
-			}	// end "for (index=0; index<numberParameters; index++)"
-				
-		if (errCode == noErr)
-			errCode = MSetMarker (fileStreamPtr, 
-											fsFromStart, 
-											savedPosOff,
-											kErrorMessages);
+	if (fileInfoPtr->numberBits != 8 * fileInfoPtr->numberBytes)
+																							return (-2);
+	
+			// The predictor is only used with LZW and Deflate compression.
 			
-		}	// end "if (imageFileDirectoryPtr->type == kTIFFDouble && count <= ..."
+	if (fileInfoPtr->dataCompressionCode == kPackBitsCompression)
+		fileInfoPtr->predictorCode = 1;
+	
+	if (fileInfoPtr->predictorCode < 1 || fileInfoPtr->predictorCode > 3)
+																							return (-2);
+	
+	if (blockWidth == 0 || blockHeight == 0)
+																							return (-8);
+	
+	planarFlag = (fileInfoPtr->bandInterleave == kBSQ && 
+																fileInfoPtr->numberChannels > 1);
+	
+	numberPlanes = 1;
+	samplesPerPixel = fileInfoPtr->numberChannels;
+	if (planarFlag)
+		{
+		numberPlanes = fileInfoPtr->numberChannels;
+		samplesPerPixel = 1;
 		
-	return (errCode);
+		}	// end "if (planarFlag)"
 	
-}	// end "GetTIFFDoubleParameters"
-#endif		// use_multispec_tiffcode
-  
-
-
-//------------------------------------------------------------------------------------
-//                   Copyright 1988-2020 Purdue Research Foundation
-//
-//	Function name:		void GetTIFFImageDescription
-//
-//	Software purpose:	The purpose of this routine is to get the text for the "Image
-//							Description Tag (270) in the TIFF/GeoTIFF file.
-//
-//	Parameters in:		None
-//
-//	Parameters out:	Text for the TIFF Image Description tag (270). No text is
-//							returned if there is no 270 tag.
-//
-//	Value Returned:	None				
-// 
-// Called By:			
-//
-//	Coded By:			Larry L. Biehl			Date: 06/28/2018
-//	Revised By:			Larry L. Biehl			Date: 06/28/2018
-
-void GetTIFFImageDescription (
-				FileInfoPtr							fileInfoPtr,
-				char*									imageDescriptionStringPtr,
-				UInt32								stringLengthLimit)
-
-{
-	CMFileStream*						fileStreamPtr;
-	TIFFImageFileDirectory			tiffFileDirectory;
+	numberBlockWidths = (fileInfoPtr->numberColumns + blockWidth - 1)/blockWidth;
+	numberBlockHeights = (fileInfoPtr->numberLines + blockHeight - 1)/blockHeight;
+	blocksPerChannel = numberBlockWidths * numberBlockHeights;
+	numberBlocks = blocksPerChannel * numberPlanes;
 	
+	if (numberBlockOffsets != numberBlocks || numberBlockByteCounts != numberBlocks)
+																							return (-8);
 	
-	imageDescriptionStringPtr[0] = 0;
-	fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
-	if (GetSpecifiedTIFFKeyDirectory (fileInfoPtr,
-													270,
-													&tiffFileDirectory))
+	blockBytes = (SInt64)blockWidth * blockHeight * 
+														samplesPerPixel * fileInfoPtr->numberBytes;
+	if (blockBytes > UInt32_MAX)
+																							return (-8);
+	
+			// Get the block offsets and byte counts. If there is only one block, the
+			// tag value is the offset or byte count itself.
+			
+	blockStartsPtr = NULL;
+	blockByteCountsPtr = NULL;
+	returnCode = noErr;
+	
+	errCode = MGetMarker (fileStreamPtr, &savedPosOff, kErrorMessages);
+	
+	if (errCode == noErr)
 		{
-		stringLengthLimit = (SInt16)MIN (tiffFileDirectory.count, stringLengthLimit);
-		GetTIFFASCIIParameters (fileStreamPtr,
-										&tiffFileDirectory,
-										imageDescriptionStringPtr,
-										stringLengthLimit);
+		if (numberBlocks == 1)
+			{
+			blockStartsPtr = (UInt32*)MNewPointer (sizeof (UInt32));
+			blockByteCountsPtr = (UInt32*)MNewPointer (sizeof (UInt32));
+			
+			if (blockStartsPtr != NULL && blockByteCountsPtr != NULL)
+				{
+				blockStartsPtr[0] = blockOffsetVector;
+				blockByteCountsPtr[0] = blockByteCountVector;
+				
+				}	// end "if (blockStartsPtr != NULL && ..."
+				
+			else	// blockStartsPtr == NULL || ...
+				returnCode = -8;
+			
+			}	// end "if (numberBlocks == 1)"
+			
+		else	// numberBlocks > 1
+			{
+			returnCode = GetBlockSizesVector (fileStreamPtr,
+															&blockStartsPtr,
+															numberBlockOffsets,
+															blockOffsetType,
+															blockOffsetVector);
 		
-		}	// end "if (GetSpecifiedTIFFKeyDirectory (fileInfoPtr, ..."
+			if (returnCode == noErr)
+				returnCode = GetBlockSizesVector (fileStreamPtr,
+																&blockByteCountsPtr,
+																numberBlockByteCounts,
+																blockByteCountType,
+																blockByteCountVector);
+			
+			}	// end "else numberBlocks > 1"
+		
+		errCode = MSetMarker (fileStreamPtr, 
+										fsFromStart, 
+										savedPosOff,
+										kErrorMessages);
+			
+		}	// end "if (errCode == noErr)"
 	
-}	// end "GetTIFFImageDescription"
-
-
-
-//------------------------------------------------------------------------------------
-//                   Copyright 1988-2020 Purdue Research Foundation
-//
-//	Function name:		SInt16 GetTIFFNumberHeaderBytes
-//
-//	Software purpose:	The purpose of this routine is to get the number of header
-//							bytes in the TIFF/GeoTIFF file. 0 will be returned if the number
-//							of header bytes cannot be determined or if the data in the file
-//							is compressed, tiled or striped. The data needs to be organized
-//							such that one can calculate where a specific pixel is just based
-//							on the number of header bytes and the number of lines, columns
-//							and bytes per pixel.
-//
-//	Parameters in:					
-//
-//	Parameters out:				
-//
-//	Value Returned:	
-//
-// Called By:			ListDescriptionInformation in SOther.cpp
-//
-//	Coded By:			Larry L. Biehl			Date: 04/16/2013
-//	Revised By:			Larry L. Biehl			Date: 04/16/2013
-
-UInt32 GetTIFFNumberHeaderBytes (
-				FileInfoPtr 						fileInfoPtr)
-
-{
-	TIFFImageFileDirectory			tiffFileDirectory;
+	if (errCode != noErr)
+		returnCode = -8;
+		
+	if (returnCode == noErr)
+		{
+				// Get the storage for the heirarchal information.
+				
+		fileInfoPtr->hfaHandle = InitializeHierarchalFileStructure (NULL,
+																						fileInfoPtr,
+																						numberBlocks);
+		
+		hfaPtr = (HierarchalFileFormatPtr)GetHandlePointer (fileInfoPtr->hfaHandle,
+																				kLock);
+		
+		if (hfaPtr != NULL)
+			{
+			for (index=0; index<fileInfoPtr->numberChannels; index++)
+				{
+				hfaPtr[index].layerOffsetBytes = 0;
+				hfaPtr[index].blockHeight = blockHeight;
+				hfaPtr[index].blockWidth = blockWidth;
+				hfaPtr[index].blocksPerChannel = blocksPerChannel;
+				hfaPtr[index].numberBlockHeights = numberBlockHeights;
+				hfaPtr[index].numberBlockWidths = numberBlockWidths;
+				
+						// The block size and offset are for the decompressed block.
+						
+				hfaPtr[index].blockSize = (UInt32)blockBytes;
+				hfaPtr[index].blockOffset = (UInt32)blockBytes;
+				
+				}	// end "for (index=0; index<fileInfoPtr->numberChannels; index++)"
+			
+			ptr = (Ptr)hfaPtr;
+			blockFormatPtr = (BlockFormatPtr)&ptr[fileInfoPtr->blockFormatIndex];
+			
+			for (index=0; index<numberBlocks; index++)
+				{
+				blockFormatPtr[index].blockOffsetBytes = blockStartsPtr[index];
+				blockFormatPtr[index].blockSize = blockByteCountsPtr[index];
+				
+				}	// end "for (index=0; index<numberBlocks; index++)"
+				
+			fileInfoPtr->blockedFlag = TRUE;
+			fileInfoPtr->numberHeaderBytes = 0;
+			
+			fileInfoPtr->bandInterleave = kBIS;
+			if (planarFlag)
+				fileInfoPtr->bandInterleave = kBNonSQBlocked;
+			
+			CheckAndUnlockHandle (fileInfoPtr->hfaHandle);
+			
+			}	// end "if (hfaPtr != NULL)"
+			
+		else	// hfaPtr == NULL
+			returnCode = 1;
+		
+		fileInfoPtr->hfaPtr = NULL;
+		fileInfoPtr->blockFormatPtr = NULL;
+		
+		}	// end "if (returnCode == noErr)"
+		
+	CheckAndDisposePtr (blockStartsPtr);
+	CheckAndDisposePtr (blockByteCountsPtr);
 	
-	UInt32								numberHeaderBytes = 0;
+	return (returnCode);
 	
-								
-	if (GetSpecifiedTIFFKeyDirectory (fileInfoPtr, 273, &tiffFileDirectory))
-		{
-		if (tiffFileDirectory.count == 1)
-			numberHeaderBytes = tiffFileDirectory.value;
+}	// end "LoadCompressedTIFFStructure"
 
-		}	// end "if (GetSpecifiedTIFFKeyDirectory (fileInfoPtr, 273, ..."
-		
-	return (numberHeaderBytes);
-	
-}	// end "GetTIFFNumberHeaderBytes"
 
 
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Function name:		Boolean ListGeoTiffTextDescriptionParameters
+//	Function name:		SInt16 LoadHierarchalFileStructure
 //
-//	Software purpose:	The purpose of this routine is to list the information for the
-//							ascii Geo Key Parameters.
+//	Software purpose:	This loads the hierarchal file structure based on the input
+//							parameters.
 //
-//	Parameters in:		
+//	Parameters in:					
 //
-//	Parameters out:	None
+//	Parameters out:				
 //
-//	Value Returned:	None				
-// 
-// Called By:			ListTiffTextDescriptionParameters in SGeoTIFF.cpp
+//	Value Returned:	
 //
-//	Coded By:			Larry L. Biehl			Date: 07/12/2011
-//	Revised By:			Larry L. Biehl			Date: 07/12/2011
+// Called By:			ReadGDALHeaderInformation in SGDALInterface.cpp
+//							CheckRowsPerStrip in SGeoTIFF.cpp
+//							
+//	Coded By:			Larry L. Biehl			Date: 01/26/2007
+//	Revised By:			Larry L. Biehl			Date: 02/26/2018
 
-Boolean ListGeoTiffTextDescriptionParameters (
-				FileInfoPtr							fileInfoPtr,
-				TIFF_IFD_Ptr						imageFileDirectoryPtr,
-				TIFF_IFD_Ptr						geoAsciiStringPtr,
-				Boolean*								addBlankLineFlagPtr)
+SInt16 LoadHierarchalFileStructure (
+				FileInfoPtr 						fileInfoPtr,
+				UInt32								numberBlocks,
+				UInt32*								blockStartsPtr,
+				UInt32*								blockByteCountsPtr,
+				UInt32								numberLinesPerStrip,
+				UInt32								bytesPerStrip,
+				UInt32								lastBytesPerStrip,
+				UInt32								bytesPerStripForAllChannels)
 
-{	
-	char									savedChar,
-											textString[1024];
+{
+	BlockFormatPtr						blockFormatPtr;
+	HierarchalFileFormatPtr			hfaPtr;
+	Ptr									ptr;
 	
-	SInt64								savedPosOff;
-											
-	CMFileStream*						fileStreamPtr;
-	UInt16*								geoKeyRecordPtr;
-				
-	UInt32								count,
-											i,
+	UInt32								blocksPerChannel,
 											index,
-											recordIndex;
+											lastChannelBlock,
+											minimumBlockStart;
+											
+	SInt16								returnCode;
 	
-	UInt16								geoTagInformation[100];
+	Boolean								blockStartsOKFlag;
 	
-	SInt16								errCode,
-											stringLength,
-											textStringLength;
 	
-	Boolean								continueFlag = TRUE,
-											stringListedFlag;
+	returnCode = -8;
+	blockStartsOKFlag = TRUE;
+
+			// Get the storage for the heirarchal information.
+			
+	fileInfoPtr->hfaHandle = InitializeHierarchalFileStructure (NULL,
+																					fileInfoPtr,
+																					numberBlocks);
 	
+			// Get pointer to the hfa structure.
+				
+	hfaPtr = (HierarchalFileFormatPtr)GetHandlePointer (fileInfoPtr->hfaHandle);
 	
-	if (imageFileDirectoryPtr->type == kTIFFShort && imageFileDirectoryPtr->count > 0)
-		{																	
-				// Get ascii information in case it will be needed later.
-					
-		GetGeoASCIIStringFromGeoTIFF (fileInfoPtr,
-													geoAsciiStringPtr,
-													textString,
-													1023);
-																								
-		fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
+	if (hfaPtr != NULL)
+		{
 			
-		errCode = MGetMarker (fileStreamPtr, 
-											&savedPosOff,
-											kErrorMessages);
+		fileInfoPtr->blockedFlag = TRUE;
+		fileInfoPtr->nonContiguousStripsFlag = TRUE;
+		
+		blocksPerChannel = (fileInfoPtr->numberLines + numberLinesPerStrip - 1)/
+																					numberLinesPerStrip;
+																					
+		lastChannelBlock = blocksPerChannel;
+															
+		for (index=0; index<fileInfoPtr->numberChannels; index++)
+			{				
+			if (fileInfoPtr->bandInterleave != kBSQ)
+				hfaPtr[index].layerOffsetBytes = blockStartsPtr[index];
+																							
+			hfaPtr[index].blockHeight = numberLinesPerStrip;
+			hfaPtr[index].blocksPerChannel = blocksPerChannel;
 			
-		if (errCode == noErr)
-			errCode = MSetMarker (fileStreamPtr, 
-												fsFromStart, 
-												imageFileDirectoryPtr->value,
-												kErrorMessages);
-												
-		count = MIN (imageFileDirectoryPtr->count, 100);			
-		count *= 2;
-		if (errCode == noErr)
-			errCode = MReadData (fileStreamPtr, 
-												&count, 
-												(char*)&geoTagInformation,
-												kErrorMessages); 
-												
-		if (errCode == noErr)
-			{
-					// Convert to number of 2 byte integers.
-						
-			count /= 2;
+					// Block width needs to represent just number of columns in the block.
+			hfaPtr[index].blockWidth = fileInfoPtr->numberColumns;
 			
-					//  Convert to number of geo key records.
-					
-			count /= 4;
+			hfaPtr[index].numberBlockWidths = 1;
 			
-			index = 0;		
-			for (recordIndex=0; recordIndex<count; recordIndex++)
-				{
-				geoKeyRecordPtr = &geoTagInformation[index];
-				for (i=0; i<4; i++, index++)
-							// Swap the bytes if needed.
-					geoTagInformation[index] = 
-									(UInt16)GetShortIntValue ((char*)&geoTagInformation[index]);
+			hfaPtr[index].blockSize = bytesPerStrip;
+																	
+			if (fileInfoPtr->bandInterleave == kBSQ)
+				hfaPtr[index].blockOffset = bytesPerStrip;
 			
-						// The first geo key record is the version and number of geo keys.
-						// We will skip it.
-					
-				if (recordIndex == 0)
-					geoKeyRecordPtr[0] = 0;
-					
-				stringListedFlag = FALSE;
-									
-				switch (geoKeyRecordPtr[0])
-					{
-					case 1026:	// GTCitationGeoKey
-						textStringLength = MIN (geoKeyRecordPtr[2], 1023);
-						stringLength = sprintf ((char*)gTextString,
-														"    GeoTIFF GTCitationGeoKey: ");						
-						continueFlag = ListString ((char*)gTextString,  
-															stringLength,
-															gOutputTextH);
-								
-								// Save the character for Windows version, since a terminator
-								// character is put into this location.
-
-						savedChar = textString[geoKeyRecordPtr[3]+textStringLength];
-						
-						continueFlag = ListString (
-												&textString[geoKeyRecordPtr[3]], 
-												textStringLength, 
-												gOutputTextH);
-
-						textString[geoKeyRecordPtr[3]+textStringLength] = savedChar;
-						
-						stringListedFlag = TRUE;
-						break;
-													
-					case 2049:	// GeogCitationGeoKey
-						textStringLength = MIN (geoKeyRecordPtr[2], 1023);
-						stringLength = sprintf ((char*)gTextString,
-														"    GeoTIFF GeogCitationGeoKey: ");						
-						continueFlag = ListString ((char*)gTextString,  
-															stringLength,
-															gOutputTextH);
-								
-								// Save the character for Windows version, since a terminator
-								// character is put into this location.
-
-						savedChar = textString[geoKeyRecordPtr[3]+textStringLength];
-															
-						continueFlag = ListString (
-												&textString[geoKeyRecordPtr[3]], 
-												textStringLength, 
-												gOutputTextH);
-
-						textString[geoKeyRecordPtr[3]+textStringLength] = savedChar;
-						
-						stringListedFlag = TRUE;
-						break;
-													
-					case 3073:	// PCSCitationGeoKey
-						textStringLength = MIN (geoKeyRecordPtr[2], 1023);
-						stringLength = sprintf ((char*)gTextString,
-															"    GeoTIFF PCSCitationGeoKey: ");						
-						continueFlag = ListString ((char*)gTextString,  
-															stringLength,
-															gOutputTextH);
-															
-						continueFlag = ListString (
-												&textString[geoKeyRecordPtr[3]], 
-												textStringLength, 
-												gOutputTextH);
-						
-						stringListedFlag = TRUE;
-						break;
-												
-					}	// end "switch (geoKeyRecordPtr[0])"
-					
-				if (stringListedFlag && continueFlag)
-					{
-					continueFlag = ListString (
-											(char*)gEndOfLine, 
-											gNumberOfEndOfLineCharacters, 
-											gOutputTextH);		
-											
-					*addBlankLineFlagPtr = TRUE;
-					
-					}	// end "if (stringListedFlag && continueFlag)"
-											
-				if (!continueFlag || geoKeyRecordPtr[0] > 3073)
-					break;
-									
-				}	// end "for (recordIndex=0; recordIndex<count; recordIndex++)"
+			else	// fileInfoPtr->bandInterleave != kBSQ
+				hfaPtr[index].blockOffset = bytesPerStripForAllChannels;
+			
+			}	// end "for (index=0; index<fileInfoPtr->numberChannels; index++)"
+		
+		if (fileInfoPtr->gdalDataSetH != NULL)
+			{
+					// The GDAL interface routines will force the data to be continuous
+					// if not already.
+					
+			fileInfoPtr->nonContiguousStripsFlag = FALSE;
+			minimumBlockStart = 0;
 			
-			}	// end "if (errCode == noErr)"
+			}	// end "if (fileInfoPtr->gdalDataSetH != NULL)"
+						
+		else if (blockStartsPtr != NULL && blockByteCountsPtr != NULL)
+			{				
+			ptr = (Ptr)hfaPtr;
+			blockFormatPtr = (BlockFormatPtr)&ptr[fileInfoPtr->blockFormatIndex];
+		
+			minimumBlockStart = blockStartsPtr[0];
+													
+			for (index=0; index<numberBlocks; index++)
+				{				
+				minimumBlockStart = MIN (minimumBlockStart, blockStartsPtr[index]);
+													
+				blockFormatPtr[index].blockOffsetBytes = blockStartsPtr[index];
+				blockFormatPtr[index].blockSize = blockByteCountsPtr[index];
+					
+				}	// end "for (index=0; index<numberBlocks; index++)"
 				
-		if (errCode == noErr)
-			errCode = MSetMarker (fileStreamPtr, 
-											fsFromStart, 
-											savedPosOff,
-											kErrorMessages);
+			}	// end "else fileInfoPtr->gdalDataSetH == NULL && blockStartsPtr != NULL)"
 			
-		}	// end "if (imageFileDirectoryPtr->type == kTIFFShort && ..."
+		else	// blockStartsPtr == NULL || blockByteCountsPtr == NULL
+			{
+			blockStartsOKFlag = FALSE;
+			minimumBlockStart = 0;
+			
+			}	// end "else blockStartsPtr == NULL || blockByteCountsPtr == NULL"
+			
+				// Set the number of header bytes to the minimum block start. This
+				// will allow for proper calculation of the minimum file size based
+				// on the image file description parameters.
+				// Note that GDAL interface routines will set numberHeaderBytes if needed.
+					
+		fileInfoPtr->numberHeaderBytes = minimumBlockStart;
 		
-	return (continueFlag);
+		CheckAndUnlockHandle (fileInfoPtr->hfaHandle);
+		fileInfoPtr->hfaPtr = NULL;
+		fileInfoPtr->blockFormatPtr = NULL;
 		
-}	// end "ListGeoTiffTextDescriptionParameters"
+		if (blockStartsOKFlag)
+			returnCode = noErr;
+															
+		}	// end "if (hfaPtr != NULL)"
+		
+	return (returnCode);
+	
+}	// end "LoadHierarchalFileStructure"
 
 
 
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Function name:		Boolean ListTiffTextDescriptionParameters
-//
-//	Software purpose:	This procedure lists the text information for those tags
-//							which might contain them. This include tags 270, 1026, 2049 and
-//							3073.
-//
-//	Parameters in:					
+//	Function name:		void LoadTIFFOverviewStructures
 //
-//	Parameters out:				
+//	Software purpose:	The purpose of this routine is to set up the hierarchal file
+//							structures for the reduced resolution images (overviews) that
+//							follow the full resolution image in a compressed TIFF file.
+//							Only reduced resolution images whose size is the full
+//							resolution size divided by an integer factor and which are
+//							stored the same way as the full resolution image are used.
+//							The other image file directories are skipped.
 //
-//	Value Returned:	
+//	Parameters in:		File information structure pointer for the full resolution
+//								image.
+//							File stream pointer.
+//							Buffer for reading the directory entries.
+//							Offset of the image file directory after the full resolution
+//								image.
 //
-// Called By:			ListDescriptionInformation in SOther.cpp
+//	Parameters out:	None
 //
-//	Coded By:			Larry L. Biehl			Date: 07/12/2011
-//	Revised By:			Larry L. Biehl			Date: 08/30/2011
+//	Value Returned:	None
+// 
+// Called By:			ReadTIFFHeader in SGeoTIFF.cpp
 
-Boolean ListTiffTextDescriptionParameters (
-				FileInfoPtr 						fileInfoPtr)
+void LoadTIFFOverviewStructures (
+				FileInfoPtr 						fileInfoPtr,
+				CMFileStream* 						fileStreamPtr,
+				char*									headerRecordPtr,
+				UInt32								ifdOffset)
 
 {
-	char									headerRecordPtr[512],
-											textString[1024];
+	MFileInfo							overviewFileInfo;
+	TIFFImageFileDirectory			imageFileDirectory;
 	
-	TIFFImageFileDirectory			geoAsciiParamsTag,
-											geoKeyDirectoryTag,
-											imageFileDirectory;
+	SInt64								savedPosOff;
 	
-	CMFileStream*						fileStreamPtr;
-										
-	UInt32								ifdOffset;
-										
-	UInt32								count;
+	TIFFOverviewPtr					tiffOverviewPtr;
 	
-	SInt16								errCode,
+	UInt32								blockByteCountType,
+											blockByteCountVector,
+											blockOffsetType,
+											blockOffsetVector,
+											compression,
+											count,
+											factor,
+											newSubfileType,
+											numberBlockByteCounts,
+											numberBlockOffsets,
+											numberColumns,
+											numberIFDs,
+											numberLines,
+											numberTileByteCounts,
+											numberTiles,
+											planarConfiguration,
+											predictorCode,
+											rowsPerStrip,
+											samplesPerPixel,
+											tileByteCountType,
+											tileByteCountVector,
+											tileLength,
+											tileOffsetType,
+											tileOffsetVector,
+											tileWidth;
+	
+	SInt16								dataCompressionCode,
+											errCode,
 											item,
 											numberEntries,
-											stringLength,
-											textStringLength;
-											
-	Boolean								addBlankLineFlag = FALSE,
-											continueFlag = TRUE,
-											stringListedFlag;
+											returnCode;
 	
-								
-	fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
+	UInt16								numberOverviews;
 	
-			// Set the global swap bytes flag to reflect the data file being read.													
-			
-	gSwapBytesFlag = fileInfoPtr->swapHeaderBytesFlag;
+	Boolean								acceptFlag,
+											sizeFlag;
 	
-			// Make certain that we are at the beginning of the file.
 	
-	ifdOffset = 4;
-	errCode = MSetMarker (fileStreamPtr, fsFromStart, ifdOffset, kErrorMessages);
+	fileInfoPtr->tiffOverviewHandle = 
+							DisposeTIFFOverviewHandle (fileInfoPtr->tiffOverviewHandle);
+	fileInfoPtr->numberTIFFOverviews = 0;
 	
-			// Read bytes 4-7 bytes of the data.
+	if (fileInfoPtr->hfaHandle == NULL)
+																								return;
 	
-	count = 4;
-	if (errCode == noErr)
-		errCode = MReadData (fileStreamPtr, &count, headerRecordPtr, kNoErrorMessages); 
-				
-	if (errCode == noErr)
+	tiffOverviewPtr = NULL;
+	numberOverviews = 0;
+	numberIFDs = 0;
+	
+	errCode = MGetMarker (fileStreamPtr, &savedPosOff, kNoErrorMessages);
+	
+	while (errCode == noErr && 
+				ifdOffset != 0 && 
+					numberOverviews < kMaxNumberTIFFOverviews &&
+						numberIFDs < 4 * kMaxNumberTIFFOverviews)
 		{
-				// Get first Image File Directory.											
-			
-		BlockMoveData (headerRecordPtr, (char*)&ifdOffset, 4);
-		ifdOffset = (UInt32)GetLongIntValue ((char*)&ifdOffset);
-
-				// Initialize some tags that will be saved.
-				
-		geoAsciiParamsTag.tag = 0;
-		geoKeyDirectoryTag.tag = 0;	
-				
+		numberIFDs++;
+		
+		newSubfileType = 0;
+		numberColumns = 0;
+		numberLines = 0;
+		compression = 1;
+		samplesPerPixel = 1;
+		planarConfiguration = 1;
+		predictorCode = 1;
+		rowsPerStrip = UInt32_MAX;
+		
+		numberBlockOffsets = 0;
+		blockOffsetType = 0;
+		blockOffsetVector = 0;
+		numberBlockByteCounts = 0;
+		blockByteCountType = 0;
+		blockByteCountVector = 0;
+		
+		tileWidth = 0;
+		tileLength = 0;
+		numberTiles = 0;
+		tileOffsetType = 0;
+		tileOffsetVector = 0;
+		numberTileByteCounts = 0;
+		tileByteCountType = 0;
+		tileByteCountVector = 0;
+		
 		errCode = MSetMarker (fileStreamPtr, 
 										fsFromStart, 
-										(SInt64)ifdOffset,
-										kErrorMessages);
-			
-				// Read in the first image file directory.							
+										ifdOffset,
+										kNoErrorMessages);
 		
 		if (errCode == noErr)
 			{
@@ -2473,9 +4216,9 @@ Boolean ListTiffTextDescriptionParameters (
 			errCode = MReadData (fileStreamPtr, 
 											&count, 
 											&numberEntries,
-											kErrorMessages);
-				
-			}	// end "if (errCode == noErr)" 
+											kNoErrorMessages);
+			
+			}	// end "if (errCode == noErr)"
 			
 		if (errCode == noErr)
 			{
@@ -2484,252 +4227,301 @@ Boolean ListTiffTextDescriptionParameters (
 			for (item=1; item<=numberEntries; item++)
 				{
 				errCode = GetTiffEntry (fileStreamPtr,
-													headerRecordPtr,
-													&imageFileDirectory);
-					
-				stringListedFlag = FALSE;
+												headerRecordPtr,
+												&imageFileDirectory);
+				
+				if (errCode != noErr)
+					break;
+				
 				switch (imageFileDirectory.tag)
-					{								
-					case 270:	// Image Description
-						textStringLength = (SInt16)MIN (imageFileDirectory.count, 1023);
-						GetTIFFASCIIParameters (fileStreamPtr,
-														&imageFileDirectory,
-														textString,
-														textStringLength);
-														
-						stringLength = sprintf ((char*)gTextString,
-														"    Image Description: ");						
-						continueFlag = ListString ((char*)gTextString,  
-															stringLength,
-															gOutputTextH);
+					{
+					case 254:	// NewSubfileType
+						newSubfileType = imageFileDirectory.value;
+						break;
 						
-						continueFlag = ListString (textString,
-																textStringLength,
-																gOutputTextH);
+					case 256:	// ImageWidth
+						numberColumns = imageFileDirectory.value;
+						break;
 						
-						stringListedFlag = TRUE;
+					case 257:	// ImageLength
+						numberLines = imageFileDirectory.value;
 						break;
-													
-					case 33432:	// Copyright
-						textStringLength = (SInt16)MIN (imageFileDirectory.count, 1023);
-						GetTIFFASCIIParameters (fileStreamPtr,
-														&imageFileDirectory,
-														textString,
-														textStringLength);
-														
-						stringLength = sprintf ((char*)gTextString,
-														"    Copyright: ");						
-						continueFlag = ListString ((char*)gTextString,  
-															stringLength,
-															gOutputTextH);
 						
-						continueFlag = ListString (textString,
-																textStringLength,
-																gOutputTextH);
+					case 259:	// Compression
+						compression = imageFileDirectory.value;
+						break;
 						
-						stringListedFlag = TRUE;
+					case 273:	// StripOffsets
+						numberBlockOffsets = imageFileDirectory.count;
+						blockOffsetType = imageFileDirectory.type;
+						blockOffsetVector = imageFileDirectory.value;
 						break;
-													
-					case 34735:	// Geo Key Directory
-						geoKeyDirectoryTag = imageFileDirectory;
+						
+					case 277:	// SamplesPerPixel
+						samplesPerPixel = imageFileDirectory.value;
 						break;
 						
-					case 34737:	// Geo ASCII Parameters
-						geoAsciiParamsTag = imageFileDirectory;
+					case 278:	// RowsPerStrip
+						rowsPerStrip = imageFileDirectory.value;
 						break;
 						
-					default:
-						errCode = noErr;
+					case 279:	// StripByteCounts
+						numberBlockByteCounts = imageFileDirectory.count;
+						blockByteCountType = imageFileDirectory.type;
+						blockByteCountVector = imageFileDirectory.value;
 						break;
 						
-					}	// end "switch (imageFileDirectory.tag)" 
-					
-				if (stringListedFlag && continueFlag)
-					{
-					continueFlag = ListString ((char*)gEndOfLine,
-														gNumberOfEndOfLineCharacters,
-														gOutputTextH);		
-					
-					addBlankLineFlag = TRUE;
-					
-					}	// end "if (stringListedFlag && continueFlag)"
+					case 284:	// PlanarConfiguration
+						planarConfiguration = imageFileDirectory.value;
+						break;
+						
+					case 317:	// Predictor
+						predictorCode = imageFileDirectory.value;
+						break;
+						
+					case 322:	// Tile width
+						tileWidth = imageFileDirectory.value;
+						break;
+						
+					case 323:	// Tile length
+						tileLength = imageFileDirectory.value;
+						break;
+						
+					case 324:	// Tile offsets
+						numberTiles = imageFileDirectory.count;
+						tileOffsetType = imageFileDirectory.type;
+						tileOffsetVector = imageFileDirectory.value;
+						break;
+						
+					case 325:	// Tile byte counts
+						numberTileByteCounts = imageFileDirectory.count;
+						tileByteCountType = imageFileDirectory.type;
+						tileByteCountVector = imageFileDirectory.value;
+						break;
+						
+					}	// end "switch (imageFileDirectory.tag)"
 					
-				if (imageFileDirectory.tag == 0 || errCode != noErr || !continueFlag)
-					break;
+				}	// end "for (item=1; item<=numberEntries; item++)"
+				
+			}	// end "if (errCode == noErr)"
+		
+				// Get the offset to the next image file directory before the
+				// directory that was just read is used.
+				
+		if (errCode == noErr)
+			{
+			count = 4;
+			errCode = MReadData (fileStreamPtr, 
+											&count, 
+											&ifdOffset,
+											kNoErrorMessages);
+			
+			if (errCode == noErr)
+				ifdOffset = (UInt32)GetLongIntValue ((char*)&ifdOffset);
+				
+			}	// end "if (errCode == noErr)"
+			
+		if (errCode != noErr)
+			break;
+		
+				// Only use reduced resolution images that are stored the same way as
+				// the full resolution image and whose size is consistent with an
+				// integer reduction factor.
+		
+		dataCompressionCode = kUnknownCompression;
+		if (compression == 5)
+			dataCompressionCode = kLZWCompression;
+		else if (compression == 8 || compression == 32946)
+			dataCompressionCode = kDeflateCompression;
+		else if (compression == 32773)
+			dataCompressionCode = kPackBitsCompression;
+		
+		if (compression == 32773)
+			predictorCode = 1;
+			
+				// Reduced resolution images are normally reduced by a power of 2.
+				// Find the largest power of 2 that gives the number of columns of the
+				// overview when the number of columns is rounded up. If that does
+				// not give the size of the overview, try the factor for the number
+				// of columns by itself.
+				
+		factor = 1;
+		sizeFlag = FALSE;
+		if (numberColumns > 0 && 
+					numberLines > 0 && 
+							numberColumns < fileInfoPtr->numberColumns)
+			{
+			while (factor < fileInfoPtr->numberColumns &&
+						(fileInfoPtr->numberColumns + 2*factor - 1)/(2*factor) >= 
+																					numberColumns)
+				factor *= 2;
+			
+			sizeFlag = (
+						(fileInfoPtr->numberColumns + factor - 1)/factor == numberColumns &&
+							(fileInfoPtr->numberLines + factor - 1)/factor == numberLines);
+			
+			if (!sizeFlag)
+				{
+				factor = (fileInfoPtr->numberColumns + numberColumns - 1)/numberColumns;
+				
+				sizeFlag = (
+						(fileInfoPtr->numberColumns + factor - 1)/factor == numberColumns &&
+							(fileInfoPtr->numberLines + factor - 1)/factor == numberLines);
+				
+				}	// end "if (!sizeFlag)"
+				
+			}	// end "if (numberColumns > 0 && ..."
+		
+		acceptFlag = ((newSubfileType & 1) &&
+							sizeFlag &&
+							factor > 1 &&
+							dataCompressionCode == fileInfoPtr->dataCompressionCode &&
+							samplesPerPixel == fileInfoPtr->numberChannels &&
+							predictorCode == fileInfoPtr->predictorCode &&
+							(fileInfoPtr->numberChannels == 1 ||
+								(planarConfiguration == 2) == 
+									(fileInfoPtr->bandInterleave == kBNonSQBlocked)));
+		
+		if (acceptFlag && tiffOverviewPtr == NULL)
+			{
+			fileInfoPtr->tiffOverviewHandle = MNewHandleClear (
+									kMaxNumberTIFFOverviews * sizeof (TIFFOverview));
+			
+			tiffOverviewPtr = (TIFFOverviewPtr)GetHandlePointer (
+																fileInfoPtr->tiffOverviewHandle,
+																kLock);
+			
+			if (tiffOverviewPtr == NULL)
+				break;
+			
+			}	// end "if (acceptFlag && tiffOverviewPtr == NULL)"
+			
+		if (acceptFlag)
+			{
+					// Use a copy of the file information structure to set up the
+					// hierarchal structure for the reduced resolution image.
 					
-				}	// end "for (item=1, item<=numberEntries, item++)" 
+			overviewFileInfo = *fileInfoPtr;
+			overviewFileInfo.numberColumns = numberColumns;
+			overviewFileInfo.numberLines = numberLines;
+			overviewFileInfo.hfaHandle = NULL;
+			overviewFileInfo.hfaPtr = NULL;
+			overviewFileInfo.blockFormatPtr = NULL;
+			
+			overviewFileInfo.bandInterleave = kBIS;
+			if (fileInfoPtr->bandInterleave == kBNonSQBlocked)
+				overviewFileInfo.bandInterleave = kBSQ;
+			
+			if (numberTiles > 0)
+				returnCode = LoadCompressedTIFFStructure (&overviewFileInfo,
+																		fileStreamPtr,
+																		tileWidth,
+																		tileLength,
+																		numberTiles,
+																		tileOffsetType,
+																		tileOffsetVector,
+																		numberTileByteCounts,
+																		tileByteCountType,
+																		tileByteCountVector);
 				
-			if (geoKeyDirectoryTag.tag == 34735 && errCode == noErr)
-				continueFlag = ListGeoTiffTextDescriptionParameters (fileInfoPtr,
-																						&geoKeyDirectoryTag,
-																						&geoAsciiParamsTag,
-																						&addBlankLineFlag);
-																					
-			}	// end "if (errCode == noErr)"
+			else	// numberTiles == 0
+				{
+				if (rowsPerStrip > numberLines)
+					rowsPerStrip = numberLines;
 					
-		if (continueFlag && addBlankLineFlag)
-			continueFlag = ListString ((char*)gEndOfLine,
-													gNumberOfEndOfLineCharacters,
-													gOutputTextH);	
+				returnCode = LoadCompressedTIFFStructure (&overviewFileInfo,
+																		fileStreamPtr,
+																		numberColumns,
+																		rowsPerStrip,
+																		numberBlockOffsets,
+																		blockOffsetType,
+																		blockOffsetVector,
+																		numberBlockByteCounts,
+																		blockByteCountType,
+																		blockByteCountVector);
+				
+				}	// end "else numberTiles == 0"
+			
+			if (returnCode == noErr)
+				{
+				tiffOverviewPtr[numberOverviews].hfaHandle = overviewFileInfo.hfaHandle;
+				tiffOverviewPtr[numberOverviews].blockFormatIndex = 
+																overviewFileInfo.blockFormatIndex;
+				tiffOverviewPtr[numberOverviews].factor = factor;
+				tiffOverviewPtr[numberOverviews].numberColumns = numberColumns;
+				tiffOverviewPtr[numberOverviews].numberLines = numberLines;
+				numberOverviews++;
+				
+				}	// end "if (returnCode == noErr)"
+				
+			else	// returnCode != noErr
+				UnlockAndDispose (overviewFileInfo.hfaHandle);
+			
+			}	// end "if (acceptFlag)"
 		
-		}	// end "if (errCode == noErr)"	
+		}	// end "while (errCode == noErr && ..."
 		
-			// Reset the global swap byte flag
-				
-	gSwapBytesFlag = FALSE;
+	if (numberOverviews > 0)
+		{
+		CheckAndUnlockHandle (fileInfoPtr->tiffOverviewHandle);
+		fileInfoPtr->numberTIFFOverviews = numberOverviews;
 		
-	return (continueFlag);
+		}	// end "if (numberOverviews > 0)"
+		
+	else	// numberOverviews == 0
+		fileInfoPtr->tiffOverviewHandle = 
+							DisposeTIFFOverviewHandle (fileInfoPtr->tiffOverviewHandle);
 	
-}	// end "ListTiffTextDescriptionParameters"
+	MSetMarker (fileStreamPtr, fsFromStart, savedPosOff, kNoErrorMessages);
+	
+}	// end "LoadTIFFOverviewStructures"
 
 
 
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Function name:		SInt16 LoadHierarchalFileStructure
-//
-//	Software purpose:	This loads the hierarchal file structure based on the input
-//							parameters.
+//	Function name:		void PutTIFFLZWCode
 //
-//	Parameters in:					
+//	Software purpose:	The purpose of this routine is to add an LZW code to the
+//							compressed data with the most significant bit first. Full bytes
+//							are moved from the bit buffer to the output buffer.
 //
-//	Parameters out:				
+//	Parameters in:		Code to be added.
+//							Number of bits in the code.
+//							Pointer to the bit buffer.
+//							Pointer to the number of bits in the bit buffer.
+//							Pointer to the buffer for the compressed data.
+//							Pointer to the index of the next byte in the output buffer.
 //
-//	Value Returned:	
+//	Parameters out:	Updated bit buffer, number of bits and output index.
 //
-// Called By:			ReadGDALHeaderInformation in SGDALInterface.cpp
-//							CheckRowsPerStrip in SGeoTIFF.cpp
-//							
-//	Coded By:			Larry L. Biehl			Date: 01/26/2007
-//	Revised By:			Larry L. Biehl			Date: 02/26/2018
+//	Value Returned:	None
+// 
+// Called By:			EncodeTIFFLZWData in SGeoTIFF.cpp
 
-SInt16 LoadHierarchalFileStructure (
-				FileInfoPtr 						fileInfoPtr,
-				UInt32								numberBlocks,
-				UInt32*								blockStartsPtr,
-				UInt32*								blockByteCountsPtr,
-				UInt32								numberLinesPerStrip,
-				UInt32								bytesPerStrip,
-				UInt32								lastBytesPerStrip,
-				UInt32								bytesPerStripForAllChannels)
+void PutTIFFLZWCode (
+				UInt32								code,
+				UInt32								codeWidth,
+				UInt32*								bitBufferPtr,
+				UInt32*								numberBitsInBufferPtr,
+				HUCharPtr							outputBufferPtr,
+				UInt32*								outputIndexPtr)
 
 {
-	BlockFormatPtr						blockFormatPtr;
-	HierarchalFileFormatPtr			hfaPtr;
-	Ptr									ptr;
-	
-	UInt32								blocksPerChannel,
-											index,
-											lastChannelBlock,
-											minimumBlockStart;
-											
-	SInt16								returnCode;
-	
-	Boolean								blockStartsOKFlag;
-	
-	
-	returnCode = -8;
-	blockStartsOKFlag = TRUE;
-
-			// Get the storage for the heirarchal information.
-			
-	fileInfoPtr->hfaHandle = InitializeHierarchalFileStructure (NULL,
-																					fileInfoPtr,
-																					numberBlocks);
-	
-			// Get pointer to the hfa structure.
-				
-	hfaPtr = (HierarchalFileFormatPtr)GetHandlePointer (fileInfoPtr->hfaHandle);
+	*bitBufferPtr = (*bitBufferPtr << codeWidth) | code;
+	*numberBitsInBufferPtr += codeWidth;
 	
-	if (hfaPtr != NULL)
+	while (*numberBitsInBufferPtr >= 8)
 		{
-			
-		fileInfoPtr->blockedFlag = TRUE;
-		fileInfoPtr->nonContiguousStripsFlag = TRUE;
-		
-		blocksPerChannel = (fileInfoPtr->numberLines + numberLinesPerStrip - 1)/
-																					numberLinesPerStrip;
-																					
-		lastChannelBlock = blocksPerChannel;
-															
-		for (index=0; index<fileInfoPtr->numberChannels; index++)
-			{				
-			if (fileInfoPtr->bandInterleave != kBSQ)
-				hfaPtr[index].layerOffsetBytes = blockStartsPtr[index];
-																							
-			hfaPtr[index].blockHeight = numberLinesPerStrip;
-			hfaPtr[index].blocksPerChannel = blocksPerChannel;
-			
-					// Block width needs to represent just number of columns in the block.
-			hfaPtr[index].blockWidth = fileInfoPtr->numberColumns;
-			
-			hfaPtr[index].numberBlockWidths = 1;
-			
-			hfaPtr[index].blockSize = bytesPerStrip;
-																	
-			if (fileInfoPtr->bandInterleave == kBSQ)
-				hfaPtr[index].blockOffset = bytesPerStrip;
-			
-			else	// fileInfoPtr->bandInterleave != kBSQ
-				hfaPtr[index].blockOffset = bytesPerStripForAllChannels;
-			
-			}	// end "for (index=0; index<fileInfoPtr->numberChannels; index++)"
-		
-		if (fileInfoPtr->gdalDataSetH != NULL)
-			{
-					// The GDAL interface routines will force the data to be continuous
-					// if not already.
-					
-			fileInfoPtr->nonContiguousStripsFlag = FALSE;
-			minimumBlockStart = 0;
-			
-			}	// end "if (fileInfoPtr->gdalDataSetH != NULL)"
-						
-		else if (blockStartsPtr != NULL && blockByteCountsPtr != NULL)
-			{				
-			ptr = (Ptr)hfaPtr;
-			blockFormatPtr = (BlockFormatPtr)&ptr[fileInfoPtr->blockFormatIndex];
-		
-			minimumBlockStart = blockStartsPtr[0];
-													
-			for (index=0; index<numberBlocks; index++)
-				{				
-				minimumBlockStart = MIN (minimumBlockStart, blockStartsPtr[index]);
-													
-				blockFormatPtr[index].blockOffsetBytes = blockStartsPtr[index];
-				blockFormatPtr[index].blockSize = blockByteCountsPtr[index];
-					
-				}	// end "for (index=0; index<numberBlocks; index++)"
-				
-			}	// end "else fileInfoPtr->gdalDataSetH == NULL && blockStartsPtr != NULL)"
-			
-		else	// blockStartsPtr == NULL || blockByteCountsPtr == NULL
-			{
-			blockStartsOKFlag = FALSE;
-			minimumBlockStart = 0;
-			
-			}	// end "else blockStartsPtr == NULL || blockByteCountsPtr == NULL"
-			
-				// Set the number of header bytes to the minimum block start. This
-				// will allow for proper calculation of the minimum file size based
-				// on the image file description parameters.
-				// Note that GDAL interface routines will set numberHeaderBytes if needed.
-					
-		fileInfoPtr->numberHeaderBytes = minimumBlockStart;
-		
-		CheckAndUnlockHandle (fileInfoPtr->hfaHandle);
-		fileInfoPtr->hfaPtr = NULL;
-		fileInfoPtr->blockFormatPtr = NULL;
-		
-		if (blockStartsOKFlag)
-			returnCode = noErr;
-															
-		}	// end "if (hfaPtr != NULL)"
+		*numberBitsInBufferPtr -= 8;
+		outputBufferPtr[*outputIndexPtr] = 
+									(UInt8)(*bitBufferPtr >> *numberBitsInBufferPtr);
+		(*outputIndexPtr)++;
 		
-	return (returnCode);
+		}	// end "while (*numberBitsInBufferPtr >= 8)"
 	
-}	// end "LoadHierarchalFileStructure"
+}	// end "PutTIFFLZWCode"
 
 
 #if use_multispec_tiffcode
@@ -2742,7 +4534,8 @@ SInt16 LoadHierarchalFileStructure (
 //							a TIFF formatted file.
 //							returnCode errors:
 //								= -1: The number of bits for each TIFF channel was not the same
-//								= -2: TIFF images is in a compressed format.
+//								= -2: TIFF images is in a compressed format that MultiSpec
+//										cannot read.
 //								= -3: MultiSpec cannot open this type of TIFF file.
 //								= -4:	(Used to be error for TIFF images with discontiguous
 //											strips. Not used now)
@@ -2792,6 +4585,7 @@ SInt16 ReadTIFFHeader (
 											ifdOffset,
 											numberBlockWidths,
 											numberStripOffsets,
+											numberTileByteCounts,
 											numberTiles,
 											rowsPerStrip,
 											stripByteCountVector,
@@ -2799,8 +4593,11 @@ SInt16 ReadTIFFHeader (
 											tempOffset,
 											tiffTileByteCount,
 											tileByteCount,
+											tileByteCountType,
 											tileLength,
+											tileOffsetType,
 											tileOffsetVector,
+											tileOffsetVectorStart,
 											tileWidth;
 	
 	SInt16								errCode,
@@ -2839,6 +4636,13 @@ SInt16 ReadTIFFHeader (
 	rowsPerStrip = UInt32_MAX;
 	
 	numberStripByteCounts = 0;
+	stripByteCountType = 0;
+	stripOffsetType = 0;
+	
+	numberTileByteCounts = 0;
+	tileByteCountType = 0;
+	tileOffsetType = 0;
+	tileOffsetVectorStart = 0;
 		
 	if (fileInfoPtr != NULL && fileStreamPtr != NULL)		
 		{
@@ -3060,7 +4864,25 @@ SInt16 ReadTIFFHeader (
 							break;
 								
 						case 259:	// Compression 
-							if (imageFileDirectory.value != 1)
+							if (imageFileDirectory.value == 1)
+								fileInfoPtr->dataCompressionCode = kNoCompression;
+								
+							else if (imageFileDirectory.value == 5)
+								fileInfoPtr->dataCompressionCode = kLZWCompression;
+								
+							else if (imageFileDirectory.value == 8 || 
+															imageFileDirectory.value == 32946)
+								fileInfoPtr->dataCompressionCode = kDeflateCompression;
+								
+							else if (imageFileDirectory.value == 32773)
+								fileInfoPtr->dataCompressionCode = kPackBitsCompression;
+								
+							else	// imageFileDirectory.value is for other compression
+								fileInfoPtr->dataCompressionCode = kUnknownCompression;
+								
+							if (fileInfoPtr->dataCompressionCode != kNoCompression &&
+										!CheckIfTIFFCompressionCanBeRead (
+																fileInfoPtr->dataCompressionCode))
 								returnCode = -2;
 							break;
 							
@@ -3147,6 +4969,10 @@ SInt16 ReadTIFFHeader (
 						case 306:	// Date Time (Not used) 
 							break;
 							
+						case 317:	// Predictor
+							fileInfoPtr->predictorCode = (UInt16)imageFileDirectory.value;
+							break;
+							
 						case 320:	// ColorMap 
 							if (imageFileDirectory.count == 768)
 								{
@@ -3177,6 +5003,19 @@ SInt16 ReadTIFFHeader (
 							
 						case 324:	// Tile offsets
 						
+									// The offsets for compressed tiles are loaded into the
+									// block format structures after all of the tags have
+									// been read.
+									
+							if (fileInfoPtr->dataCompressionCode != kNoCompression)
+								{
+								numberTiles = imageFileDirectory.count;
+								tileOffsetType = imageFileDirectory.type;
+								tileOffsetVectorStart = imageFileDirectory.value;
+								break;
+								
+								}	// end "if (fileInfoPtr->dataCompressionCode != ..."
+						
 									// Tiles will work as long as they are contiguous. To
 									// allow non-contigous tiles to work. Another parameter
 									// will have to be added to the hfa structure to save
@@ -3254,6 +5093,8 @@ SInt16 ReadTIFFHeader (
 							
 						case 325:	// Tile byte counts
 							tiffTileByteCount = imageFileDirectory.value;	
+							numberTileByteCounts = imageFileDirectory.count;
+							tileByteCountType = imageFileDirectory.type;
 							//returnCode = -7;
 							break;
 							
@@ -3451,7 +5292,54 @@ SInt16 ReadTIFFHeader (
 					
 					}	// end "if (returnCode == 0 && ..." 
 					
-				if (returnCode == noErr && errCode == noErr && checkRowsPerStripFlag)
+						// Set up the block structure for compressed strips or tiles.
+						// Each strip or tile will be decompressed when read.
+						
+				if (returnCode == noErr && 
+							errCode == noErr && 
+								fileInfoPtr->dataCompressionCode != kNoCompression)
+					{
+					if (numberTiles > 0)
+						returnCode = LoadCompressedTIFFStructure (fileInfoPtr,
+																				fileStreamPtr,
+																				tileWidth,
+																				tileLength,
+																				numberTiles,
+																				tileOffsetType,
+																				tileOffsetVectorStart,
+																				numberTileByteCounts,
+																				tileByteCountType,
+																				tiffTileByteCount);
+						
+					else	// numberTiles == 0
+						{
+						if (numberStripOffsets == 0)
+							{
+							numberStripOffsets = 1;
+							stripOffsetVector = fileInfoPtr->numberHeaderBytes;
+							
+							}	// end "if (numberStripOffsets == 0)"
+							
+						if (rowsPerStrip > fileInfoPtr->numberLines)
+							rowsPerStrip = fileInfoPtr->numberLines;
+							
+						returnCode = LoadCompressedTIFFStructure (
+																fileInfoPtr,
+																fileStreamPtr,
+																fileInfoPtr->numberColumns,
+																rowsPerStrip,
+																numberStripOffsets,
+																(UInt32)stripOffsetType,
+																stripOffsetVector,
+																(UInt32)numberStripByteCounts,
+																(UInt32)stripByteCountType,
+																stripByteCountVector);
+						
+						}	// end "else numberTiles == 0"
+					
+					}	// end "if (returnCode == noErr && ..."
+				
+				else if (returnCode == noErr && errCode == noErr && checkRowsPerStripFlag)
 					returnCode = CheckRowsPerStrip (fileInfoPtr,
 																fileStreamPtr,
 																numberStripOffsets,
@@ -3477,6 +5365,18 @@ SInt16 ReadTIFFHeader (
 						
 					}	// end "if (returnCode >= 0 && errCode == noErr)" 
 					
+						// The reduced resolution images that follow compressed
+						// data are used to read zoomed out views of the image.
+						
+				if (returnCode == noErr && 
+							errCode == noErr && 
+								ifdOffset != 0 &&
+									fileInfoPtr->dataCompressionCode != kNoCompression)
+					LoadTIFFOverviewStructures (fileInfoPtr,
+															fileStreamPtr,
+															headerRecordPtr,
+															ifdOffset);
+					
 						// For now we will ignore other image data in the file.	
 					
 				notDoneFlag = FALSE;
@@ -3521,7 +5421,7 @@ SInt16 ReadTIFFHeader (
 					// been completed yet. For now tiled TIFF images are not
 					// allowed.
 					
-			if (numberTiles > 0)
+			if (numberTiles > 0 && fileInfoPtr->dataCompressionCode == kNoCompression)
 				{
 						// Get the storage for the heirarchal information.
 						
@@ -4615,6 +6515,148 @@ SInt16 SetPixelScaleParametersFromGeoTIFF (
   
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void UndoTIFFPredictor
+//
+//	Software purpose:	The purpose of this routine is to undo the horizontal 
+//							differencing (predictor 2) or floating point horizontal
+//							differencing (predictor 3) that was applied to the rows of
+//							a TIFF block before it was compressed. The differences are
+//							relative to the same sample of the previous pixel. The 
+//							data are left in the byte order of the file.
+//
+//	Parameters in:		File information structure pointer.
+//							Pointer to the decompressed block.
+//							Number of rows in the block.
+//							Number of bytes in one row.
+//							Pointer to buffer for one row of data. Only used for the
+//								floating point predictor.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None
+// 
+// Called By:			DecodeTIFFBlock in SGeoTIFF.cpp
+
+void UndoTIFFPredictor (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							bufferPtr,
+				UInt32								numberRows,
+				UInt32								numberRowBytes,
+				HUCharPtr							rowBufferPtr)
+
+{
+	HUCharPtr							rowPtr;
+	
+	UInt32								byte,
+											index,
+											numberBytes,
+											numberRowSamples,
+											row,
+											sample,
+											samplesPerPixel;
+	
+	Boolean								bigEndianFileFlag;
+	
+	
+	numberBytes = fileInfoPtr->numberBytes;
+	numberRowSamples = numberRowBytes / numberBytes;
+	
+	samplesPerPixel = 1;
+	if (fileInfoPtr->bandInterleave == kBIS)
+		samplesPerPixel = fileInfoPtr->numberChannels;
+		
+	bigEndianFileFlag = (fileInfoPtr->swapBytesFlag != gBigEndianFlag);
+	
+	for (row=0; row<numberRows; row++)
+		{
+		rowPtr = &bufferPtr[(SInt64)row*numberRowBytes];
+		
+		if (fileInfoPtr->predictorCode == 2)
+			{
+					// The sums are done in the byte order of this computer.
+					
+			if (fileInfoPtr->swapBytesFlag && numberBytes > 1)
+				SwapBytes ((SInt16)numberBytes, (HUInt8Ptr)rowPtr, numberRowSamples);
+			
+			switch (numberBytes)
+				{
+				case 1:
+					for (index=samplesPerPixel; index<numberRowSamples; index++)
+						rowPtr[index] += rowPtr[index-samplesPerPixel];
+					break;
+					
+				case 2:
+					{
+					HUInt16Ptr twoBytePtr = (HUInt16Ptr)rowPtr;
+					for (index=samplesPerPixel; index<numberRowSamples; index++)
+						twoBytePtr[index] += twoBytePtr[index-samplesPerPixel];
+					break;
+					
+					}	// end "case 2"
+					
+				case 4:
+					{
+					HUInt32Ptr fourBytePtr = (HUInt32Ptr)rowPtr;
+					for (index=samplesPerPixel; index<numberRowSamples; index++)
+						fourBytePtr[index] += fourBytePtr[index-samplesPerPixel];
+					break;
+					
+					}	// end "case 4"
+					
+				case 8:
+					{
+					unsigned long long* eightBytePtr = (unsigned long long*)rowPtr;
+					for (index=samplesPerPixel; index<numberRowSamples; index++)
+						eightBytePtr[index] += eightBytePtr[index-samplesPerPixel];
+					break;
+					
+					}	// end "case 8"
+					
+				}	// end "switch (numberBytes)"
+			
+			if (fileInfoPtr->swapBytesFlag && numberBytes > 1)
+				SwapBytes ((SInt16)numberBytes, (HUInt8Ptr)rowPtr, numberRowSamples);
+			
+			}	// end "if (fileInfoPtr->predictorCode == 2)"
+			
+		else	// fileInfoPtr->predictorCode == 3
+			{
+					// The bytes for the row were differenced and then stored with the
+					// most significant bytes for all samples first, followed by the
+					// next most significant bytes and so on.
+					
+			for (index=samplesPerPixel; index<numberRowBytes; index++)
+				rowPtr[index] += rowPtr[index-samplesPerPixel];
+				
+			BlockMoveData (rowPtr, rowBufferPtr, numberRowBytes);
+			
+			for (sample=0; sample<numberRowSamples; sample++)
+				{
+				for (byte=0; byte<numberBytes; byte++)
+					{
+					if (bigEndianFileFlag)
+						rowPtr[sample*numberBytes + byte] = 
+													rowBufferPtr[byte*numberRowSamples + sample];
+						
+					else	// !bigEndianFileFlag
+						rowPtr[sample*numberBytes + numberBytes - 1 - byte] = 
+													rowBufferPtr[byte*numberRowSamples + sample];
+					
+					}	// end "for (byte=0; byte<numberBytes; byte++)"
+					
+				}	// end "for (sample=0; sample<numberRowSamples; sample++)"
+			
+			}	// end "else fileInfoPtr->predictorCode == 3"
+			
+		}	// end "for (row=0; row<numberRows; row++)"
+	
+}	// end "UndoTIFFPredictor"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
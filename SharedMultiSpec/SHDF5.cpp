@@ -38,6 +38,7 @@
 //------------------------------------------------------------------------------------
 
 #include "SMultiSpec.h"
+#include "SFileStream_class.h"
 
 #if defined multispec_wx
 	#include "errno.h"
@@ -46,10 +47,6 @@
 #if defined multispec_mac
 #endif	// defined multispec_mac    
 
-#if defined multispec_win
-	#include "SFileStream_class.h"
-#endif	// defined multispec_win
-
 #if include_gdal_capability
 #if include_hdf5_capability
 
@@ -86,6 +83,10 @@
 #include "gdal_priv.h"
 #include "gh5_convenience.h"
 //#include "gdal_pam.h"
+
+#if include_zlib_capability
+	#include <zlib.h>
+#endif	// include_zlib_capability
  
 
 
@@ -151,6 +152,16 @@ extern hid_t GetHDF5Pointer (
 extern SInt16 GetHDF5CompressionInformation (
 				GDALDatasetH						hDS);
 
+extern Boolean ReadHDF5ChunkedLine (
+				GDALDatasetH						hDS,
+				FileInfoPtr							fileInfoPtr,
+				UInt32								lineNumber,
+				UInt32								columnStart,
+				UInt32								columnEnd,
+				UInt32								numberChannels,
+				int*									channelListPtr,
+				HUCharPtr							outputBufferPtr);
+
 extern SInt32 LoadHdf5DataSetNames (
 				GDALDatasetH						hDS,
 				SInt16								format,
@@ -168,6 +179,61 @@ extern SInt32 LoadHdf5DataSetNames (
 #define	kEqualSignNotUsed		0
 #define	kEqualSignUsed			1
 
+		// Information for reading a compressed, chunked hdf5 data set directly
+		// with the hdf5 library rather than through gdal. The lines covered by
+		// one row of chunks (a chunk row) are read for the requested channels
+		// and columns at one time so that each chunk is decompressed only once.
+		// The chunk row buffer is stored band sequential. When the only filters
+		// are shuffle and deflate, the raw chunks are read with H5Dread_chunk
+		// and decompressed here so that the read and decompression times can be
+		// reported separately; otherwise chunk aligned hyperslabs are read with
+		// H5Dread using a chunk cache sized for one chunk row.
+
+typedef struct Hdf5ChunkedDataSet
+	{
+	GDALDatasetH						hDS;
+	
+	HUCharPtr							chunkBufferPtr;
+	HUCharPtr							chunkRowBufferPtr;
+	HUCharPtr							compressedBufferPtr;
+	int*									channelListPtr;
+	
+	hid_t									dataSet_id;
+	hid_t									dataSpace_id;
+	hid_t									memoryType_id;
+	
+	hsize_t								chunkDims[4];
+	hsize_t								dims[4];
+	
+	SInt64								chunkBufferBytes;
+	SInt64								chunkRowBufferBytes;
+	SInt64								compressedBufferBytes;
+	
+	UInt32								chunkRowColumnEnd;
+	UInt32								chunkRowColumnStart;
+	UInt32								chunkRowFirstLine;
+	UInt32								chunkRowNumberChannels;
+	UInt32								chunkRowNumberLines;
+	UInt32								maxNumberChannels;
+	UInt32								numberBytes;
+	
+	int									bandDimension;
+	int									columnDimension;
+	int									deflateFilterIndex;
+	int									lineDimension;
+	int									numberDimensions;
+	int									shuffleFilterIndex;
+	
+	Boolean								rawChunkFlag;
+	Boolean								useFlag;
+	
+	} Hdf5ChunkedDataSet, *Hdf5ChunkedDataSetPtr;
+
+		// Data sets opened for chunk row reads.
+		
+Hdf5ChunkedDataSet					gHDF5ChunkedDataSets[kMaxHDF5ChunkedDataSets];
+UInt32									gNumberHDF5ChunkedDataSets = 0;
+
 SInt16	CheckIfDataSetStringCompares (
 				hid_t									file_id,
 				char*									dataSetStringPtr,
@@ -178,6 +244,14 @@ herr_t	file_info (
 				const char*							name, 
 				void*									opdata);
 
+Hdf5ChunkedDataSetPtr GetHDF5ChunkedDataSet (
+				GDALDatasetH						hDS,
+				FileInfoPtr							fileInfoPtr);
+
+UInt32	GetHdf5DataSetNamesCheckSum (
+				char**								metadata,
+				SInt32								numberDataSets);
+
 SInt16	GetDataProductCodeFromHDF5File (
 				hid_t									file_id);
 
@@ -293,6 +367,34 @@ SInt16	ReadDataSetString2 (
 				char*									returnStringPtr,
 				UInt32								maxReturnStringLength);
 
+SInt32	ReadHdf5DataSetIndexFile (
+				FileInfoPtr							fileInfoPtr,
+				SInt16								format,
+				SInt32								numberSubDataSets,
+				UInt32								checkSum,
+				HdfDataSets*						hdfDataSetsPtr,
+				SInt32*								firstDataSetIndexPtr);
+
+Boolean	ReadHDF5ChunkRow (
+				Hdf5ChunkedDataSetPtr			chunkedDataSetPtr,
+				UInt32								lineIndex,
+				UInt32								columnStart,
+				UInt32								columnEnd,
+				UInt32								numberChannels,
+				int*									channelListPtr);
+
+void		ReleaseHDF5ChunkedDataSet (
+				GDALDatasetH						hDS);
+
+void		WriteHdf5DataSetIndexFile (
+				FileInfoPtr							fileInfoPtr,
+				SInt16								format,
+				SInt32								numberSubDataSets,
+				UInt32								checkSum,
+				HdfDataSets*						hdfDataSetsPtr,
+				SInt32								numberGroups,
+				SInt32								firstDataSetIndex);
+
 
 
 //------------------------------------------------------------------------------------
@@ -333,6 +435,7 @@ void CloseHDF5DataSetInfo (
 			{
 			if (hdfDataSetsPtr[dataSet].sdid != 0)
 				{
+				ReleaseHDF5ChunkedDataSet ((GDALDatasetH)hdfDataSetsPtr[dataSet].sdid);
 				GDALClose ((GDALDatasetH)hdfDataSetsPtr[dataSet].sdid);
 				
 				if (fileInfoPtr->gdalDataSetH ==
@@ -570,6 +673,279 @@ herr_t file_info (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Hdf5ChunkedDataSetPtr GetHDF5ChunkedDataSet
+//
+//	Software purpose:	This routine returns the structure used to read the chunk rows
+//							of the input compressed hdf5 data set. The data set is opened
+//							directly with the hdf5 library the first time with a chunk
+//							cache that will hold the chunks for one chunk row. The layout
+//							of the data set is checked to be sure that it is chunked and
+//							that the dimensions agree with those gdal uses for the bands,
+//							lines and columns.
+//
+//	Parameters in:		Handle to the gdal data set.
+//							File information structure pointer.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	Pointer to the chunked data set structure. NULL if the data set
+//							cannot be read in chunk rows.
+//
+// Called By:			ReadHDF5ChunkedLine in SHDF5.cpp
+
+Hdf5ChunkedDataSetPtr GetHDF5ChunkedDataSet (
+				GDALDatasetH						hDS,
+				FileInfoPtr							fileInfoPtr)
+				
+{	
+	hsize_t								maxDims[4];
+	
+	char									*descriptionPtr,
+											*pathPtr;
+	
+	Hdf5ChunkedDataSetPtr			chunkedDataSetPtr;
+	
+	hid_t									accessPropertyList_id,
+											createPropertyList_id,
+											file_id,
+											fileType_id;
+	
+	size_t								cacheBytes,
+											chunkBytes,
+											divisor,
+											numberCacheChunks,
+											numberChunks,
+											numberSlots;
+	
+	H5Z_filter_t						filter_id;
+	
+	UInt32								index;
+	
+	int									dimension,
+											filter,
+											numberBands,
+											numberFilters;
+	
+	unsigned int						filterFlags;
+	
+	
+	for (index=0; index<gNumberHDF5ChunkedDataSets; index++)
+		{
+		if (gHDF5ChunkedDataSets[index].hDS == hDS)
+			{
+			if (!gHDF5ChunkedDataSets[index].useFlag)
+																						return (NULL);
+			
+			return (&gHDF5ChunkedDataSets[index]);
+			
+			}	// end "if (gHDF5ChunkedDataSets[index].hDS == hDS)"
+		
+		}	// end "for (index=0; index<gNumberHDF5ChunkedDataSets; index++)"
+	
+	if (gNumberHDF5ChunkedDataSets >= kMaxHDF5ChunkedDataSets)
+																						return (NULL);
+	
+	chunkedDataSetPtr = &gHDF5ChunkedDataSets[gNumberHDF5ChunkedDataSets];
+	gNumberHDF5ChunkedDataSets++;
+	
+	memset (chunkedDataSetPtr, 0, sizeof (Hdf5ChunkedDataSet));
+	chunkedDataSetPtr->hDS = hDS;
+	chunkedDataSetPtr->dataSet_id = -1;
+	chunkedDataSetPtr->dataSpace_id = -1;
+	chunkedDataSetPtr->memoryType_id = -1;
+	chunkedDataSetPtr->deflateFilterIndex = -1;
+	chunkedDataSetPtr->shuffleFilterIndex = -1;
+	chunkedDataSetPtr->useFlag = FALSE;
+	
+			// Get the path for the data set from the gdal subdataset name which is
+			// of the form HDF5:"file name"://path.
+	
+	pathPtr = NULL;
+	descriptionPtr = (char*)GDALGetDescription (hDS);
+	if (descriptionPtr != NULL)
+		pathPtr = strrchr (descriptionPtr, '"');
+		
+	if (pathPtr == NULL || pathPtr[1] != ':')
+																						return (NULL);
+	
+	pathPtr += 2;
+	while (pathPtr[0] == '/' && pathPtr[1] == '/')
+		pathPtr++;
+	
+	file_id = GetHDF5Pointer (hDS);
+	if (file_id <= 0)
+																						return (NULL);
+	
+	chunkedDataSetPtr->dataSet_id = H5Dopen2 (file_id, pathPtr, H5P_DEFAULT);
+	if (chunkedDataSetPtr->dataSet_id < 0)
+																						return (NULL);
+	
+			// The lines and columns are the last two dimensions. The bands are the
+			// first dimension for 3 dimensional data sets and the second for 4
+			// dimensional data sets with the first dimension being 1. This is the
+			// same as the gdal hdf5 image driver.
+	
+	chunkedDataSetPtr->dataSpace_id = H5Dget_space (chunkedDataSetPtr->dataSet_id);
+	chunkedDataSetPtr->numberDimensions = 
+								H5Sget_simple_extent_ndims (chunkedDataSetPtr->dataSpace_id);
+	
+	if (chunkedDataSetPtr->numberDimensions < 2 || 
+												chunkedDataSetPtr->numberDimensions > 4)
+																						return (NULL);
+	
+	H5Sget_simple_extent_dims (chunkedDataSetPtr->dataSpace_id, 
+											chunkedDataSetPtr->dims, 
+											maxDims);
+	
+	chunkedDataSetPtr->lineDimension = chunkedDataSetPtr->numberDimensions - 2;
+	chunkedDataSetPtr->columnDimension = chunkedDataSetPtr->numberDimensions - 1;
+	chunkedDataSetPtr->bandDimension = chunkedDataSetPtr->numberDimensions - 3;
+	
+	numberBands = 1;
+	if (chunkedDataSetPtr->bandDimension >= 0)
+		numberBands = (int)chunkedDataSetPtr->dims[chunkedDataSetPtr->bandDimension];
+	
+	if ((chunkedDataSetPtr->numberDimensions == 4 && chunkedDataSetPtr->dims[0] != 1) ||
+			numberBands != GDALGetRasterCount (hDS) ||
+				chunkedDataSetPtr->dims[chunkedDataSetPtr->lineDimension] != 
+														(hsize_t)GDALGetRasterYSize (hDS) ||
+					chunkedDataSetPtr->dims[chunkedDataSetPtr->columnDimension] != 
+														(hsize_t)GDALGetRasterXSize (hDS))
+																						return (NULL);
+	
+			// Verify that the data set is chunked and get the chunk dimensions and
+			// the filters.
+	
+	createPropertyList_id = H5Dget_create_plist (chunkedDataSetPtr->dataSet_id);
+	if (createPropertyList_id < 0)
+																						return (NULL);
+	
+	if (H5Pget_layout (createPropertyList_id) != H5D_CHUNKED ||
+			H5Pget_chunk (createPropertyList_id, 
+								chunkedDataSetPtr->numberDimensions, 
+								chunkedDataSetPtr->chunkDims) != 
+													chunkedDataSetPtr->numberDimensions)
+		{
+		H5Pclose (createPropertyList_id);
+																						return (NULL);
+																						
+		}	// end "if (H5Pget_layout (createPropertyList_id) != H5D_CHUNKED || ..."
+	
+	chunkedDataSetPtr->rawChunkFlag = TRUE;
+	numberFilters = H5Pget_nfilters (createPropertyList_id);
+	for (filter=0; filter<numberFilters; filter++)
+		{
+		filter_id = H5Pget_filter2 (
+							createPropertyList_id, filter, &filterFlags, NULL, NULL, 0, NULL, NULL);
+		
+		if (filter_id == H5Z_FILTER_SHUFFLE && filter == 0)
+			chunkedDataSetPtr->shuffleFilterIndex = filter;
+			
+		else if (filter_id == H5Z_FILTER_DEFLATE && 
+														chunkedDataSetPtr->deflateFilterIndex < 0)
+			chunkedDataSetPtr->deflateFilterIndex = filter;
+		
+		else	// filter not handled by MultiSpec
+			chunkedDataSetPtr->rawChunkFlag = FALSE;
+		
+		}	// end "for (filter=0; filter<numberFilters; filter++)"
+		
+	H5Pclose (createPropertyList_id);
+	
+			// Get the data type to read the data into. It needs to be the same size
+			// as the data gdal reads. The raw chunks can only be used if the data
+			// are stored in the native byte order.
+	
+	fileType_id = H5Dget_type (chunkedDataSetPtr->dataSet_id);
+	chunkedDataSetPtr->memoryType_id = H5Tget_native_type (fileType_id, H5T_DIR_ASCEND);
+	chunkedDataSetPtr->numberBytes = 
+								(UInt32)H5Tget_size (chunkedDataSetPtr->memoryType_id);
+	
+	if (H5Tget_size (fileType_id) != chunkedDataSetPtr->numberBytes ||
+			H5Tget_order (fileType_id) != H5Tget_order (chunkedDataSetPtr->memoryType_id))
+		chunkedDataSetPtr->rawChunkFlag = FALSE;
+	
+	#if !include_zlib_capability || !H5_VERSION_GE(1,10,2)
+		chunkedDataSetPtr->rawChunkFlag = FALSE;
+	#endif	// !include_zlib_capability || ...
+	
+	if ((H5Tget_class (fileType_id) != H5T_INTEGER && 
+										H5Tget_class (fileType_id) != H5T_FLOAT) ||
+				chunkedDataSetPtr->numberBytes != fileInfoPtr->numberBytes)
+		{
+		H5Tclose (fileType_id);
+																						return (NULL);
+																						
+		}	// end "if ((H5Tget_class (fileType_id) != H5T_INTEGER && ..."
+		
+	H5Tclose (fileType_id);
+	
+			// Reopen the data set with a chunk cache that will hold the chunks for 
+			// one chunk row. The number of hash slots is set to a prime number about
+			// 100 times the number of chunks in the cache as suggested by the hdf
+			// group. A chunk is preempted as soon as it has been fully read.
+	
+	chunkBytes = chunkedDataSetPtr->numberBytes;
+	numberChunks = 1;
+	for (dimension=0; dimension<chunkedDataSetPtr->numberDimensions; dimension++)
+		{
+		chunkBytes *= (size_t)chunkedDataSetPtr->chunkDims[dimension];
+		
+		if (dimension != chunkedDataSetPtr->lineDimension)
+			numberChunks *= (size_t)((chunkedDataSetPtr->dims[dimension] + 
+											chunkedDataSetPtr->chunkDims[dimension] - 1) / 
+														chunkedDataSetPtr->chunkDims[dimension]);
+		
+		}	// end "for (dimension=0; dimension<...; dimension++)"
+	
+	cacheBytes = MIN (numberChunks * chunkBytes, kMaxHDF5ChunkCacheBytes);
+	cacheBytes = MAX (cacheBytes, chunkBytes);
+	numberCacheChunks = cacheBytes / chunkBytes;
+	
+	numberSlots = 100 * numberCacheChunks + 1;
+	for (divisor=3; divisor*divisor<=numberSlots; divisor+=2)
+		{
+		if (numberSlots % divisor == 0)
+			{
+			numberSlots += 2;
+			divisor = 1;
+			
+			}	// end "if (numberSlots % divisor == 0)"
+		
+		}	// end "for (divisor=3; divisor*divisor<=numberSlots; divisor+=2)"
+	
+	accessPropertyList_id = H5Pcreate (H5P_DATASET_ACCESS);
+	if (accessPropertyList_id >= 0)
+		{
+		if (H5Pset_chunk_cache (accessPropertyList_id, 
+											numberSlots, 
+											cacheBytes, 
+											1.0) >= 0)
+			{
+			H5Dclose (chunkedDataSetPtr->dataSet_id);
+			chunkedDataSetPtr->dataSet_id = 
+									H5Dopen2 (file_id, pathPtr, accessPropertyList_id);
+			
+			}	// end "if (H5Pset_chunk_cache (accessPropertyList_id, ..."
+			
+		H5Pclose (accessPropertyList_id);
+		
+		}	// end "if (accessPropertyList_id >= 0)"
+	
+	if (chunkedDataSetPtr->dataSet_id < 0)
+																						return (NULL);
+	
+	chunkedDataSetPtr->useFlag = TRUE;
+	
+	return (chunkedDataSetPtr);
+    
+}	// end "GetHDF5ChunkedDataSet"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -636,6 +1012,64 @@ SInt16 GetHDF5CompressionInformation (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		UInt32 GetHdf5DataSetNamesCheckSum
+//
+//	Software purpose:	This routine computes a check sum of the names of the subdata
+//							sets in the file. It is used to verify that a data set index
+//							file goes with the file being opened.
+//
+//	Parameters in:		The subdata sets metadata for the file.
+//							Number of subdata sets in the file.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	The check sum.
+//
+// Called By:			LoadHdf5DataSetNames in SHDF5.cpp
+
+UInt32 GetHdf5DataSetNamesCheckSum (
+				char**								metadata,
+				SInt32								numberDataSets)
+				
+{
+	char									szKeyName[64];
+	
+	const char*							namePtr;
+	
+	UInt32								checkSum;
+	
+	SInt32								dataSet;
+	
+	
+	checkSum = 0;
+	
+	for (dataSet=1; dataSet<=numberDataSets; dataSet++)
+		{
+		snprintf (szKeyName, sizeof (szKeyName), "SUBDATASET_%d_NAME", (int)dataSet);
+		namePtr = CSLFetchNameValue (metadata, szKeyName);
+		
+		if (namePtr != NULL)
+			{
+			while (*namePtr != 0)
+				{
+				checkSum = 31 * checkSum + (UInt8)*namePtr;
+				namePtr++;
+				
+				}	// end "while (*namePtr != 0)"
+				
+			}	// end "if (namePtr != NULL)"
+		
+		}	// end "for (dataSet=1; dataSet<=numberDataSets; dataSet++)"
+		
+	return (checkSum);
+    
+}	// end "GetHdf5DataSetNamesCheckSum"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -2172,11 +2606,14 @@ SInt32 LoadHdf5DataSetNames (
 		
 	time_t								startDataSetRead,
 											startTime;
+											
+	UInt32								checkSum;
 
    Boolean								noDataValueFlag,
 											signedDataFlag,
    										set0SignedDataFlag,
-											statusDialogCreatedFlag;
+											statusDialogCreatedFlag,
+											writeIndexFileFlag;
    
    										   
    index = 1;
@@ -2189,6 +2626,7 @@ SInt32 LoadHdf5DataSetNames (
 	gdalDataSetH = hDS;
 	statusDialogCreatedFlag = FALSE;
 	hdfDataSetsPtr = NULL;
+	writeIndexFileFlag = FALSE;
 	
 	if (format != kNITFType)
 		H5Eset_auto2 (NULL, NULL, NULL);
@@ -2233,7 +2671,33 @@ SInt32 LoadHdf5DataSetNames (
 
 	if (hdfDataSetsPtr != NULL && numberDataSets > 0)
 		{
-		for (dataSet=1; dataSet<=numberDataSets; dataSet++)
+				// Use the data set index file for files with many data sets if it
+				// exists. The descriptions of the data sets are then loaded from the
+				// index file and the data sets are not opened until they are used.
+				
+		if (gUseHdfDataSetIndexFileFlag &&
+								numberDataSets >= kHdfDataSetIndexMinimumDataSets)
+			{
+			writeIndexFileFlag = TRUE;
+			checkSum = GetHdf5DataSetNamesCheckSum (metadata, numberDataSets);
+			
+			if (ReadHdf5DataSetIndexFile (fileInfoPtr,
+													format,
+													numberDataSets,
+													checkSum,
+													hdfDataSetsPtr,
+													firstDataSetIndexPtr) == numberDataSets)
+				{
+						// Skip the loop below which opens and describes each data set.
+						
+				index = numberDataSets + 1;
+				writeIndexFileFlag = FALSE;
+				
+				}	// end "if (ReadHdf5DataSetIndexFile (..."
+			
+			}	// end "if (gUseHdfDataSetIndexFileFlag && ..."
+			
+		for (dataSet=index; dataSet<=numberDataSets; dataSet++)
 			{
 			if (dataSet == 1)
 				startTime = TickCount ();
@@ -2651,7 +3115,20 @@ SInt32 LoadHdf5DataSetNames (
 					
 				}	// end "if (TickCount () >= gNextTime)"
 			
-			}	// end "for (dataSet=1; dataSet<=numDataSets; dataSet++)"
+			}	// end "for (dataSet=index; dataSet<=numDataSets; dataSet++)"
+			
+				// Save the data set descriptions in the data set index file so that
+				// the data sets do not need to be opened the next time the file is
+				// opened.
+				
+		if (writeIndexFileFlag && index > numberDataSets)
+			WriteHdf5DataSetIndexFile (fileInfoPtr,
+												format,
+												numberDataSets,
+												checkSum,
+												hdfDataSetsPtr,
+												(SInt32)groupNumber,
+												*firstDataSetIndexPtr);
 			
 		*hdfDataSetsHandlePtr = dataSetsHandle;
 		*hdfDataSetsPtrPtr = hdfDataSetsPtr;
@@ -3163,6 +3640,776 @@ SInt16 ReadDataSetString2 (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt32 ReadHdf5DataSetIndexFile
+//
+//	Software purpose:	This routine loads the subdata set descriptions from the data
+//							set index (.hdx) file for the hdf or netCDF file if one exists
+//							and it was written for this version of the file. The subdata
+//							sets are then not opened until they are used. See 
+//							WriteHdf5DataSetIndexFile for the layout of the file.
+//
+//	Parameters in:		File information structure pointer.
+//							Format of the file.
+//							Number of subdata sets in the file.
+//							Check sum of the subdata set names.
+//
+//	Parameters out:	Data sets structure; entry 0 is to already be loaded.
+//							Index of the first valid data set.
+//
+//	Value Returned:	Number of data sets loaded; 0 if the index file could not be used.
+//
+// Called By:			LoadHdf5DataSetNames in SHDF5.cpp
+
+SInt32 ReadHdf5DataSetIndexFile (
+				FileInfoPtr							fileInfoPtr,
+				SInt16								format,
+				SInt32								numberSubDataSets,
+				UInt32								checkSum,
+				HdfDataSets*						hdfDataSetsPtr,
+				SInt32*								firstDataSetIndexPtr)
+				
+{
+	char									headerBuffer[kHdfDataSetIndexHeaderBytes];
+	
+	CMFileStream						indexFileStream;
+	
+	CMFileStream*						fileStreamPtr;
+	FileStringPtr						indexFileNamePtr;
+	HCharPtr								entryBufferPtr,
+											entryPtr;
+	
+	SInt64								fileSize;
+	
+	SInt32								firstDataSetIndex,
+											index,
+											numberEntries,
+											numberGroups;
+	
+	UInt32								count;
+	
+	SInt16								errCode;
+	
+	
+	errCode = GetSizeOfFile (fileInfoPtr, &fileSize);
+	if (errCode != noErr)
+																					return (0);
+	
+			// The index file has the same name as the hdf file with .hdx appended.
+	
+	fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
+	InitializeFileStream (&indexFileStream, fileStreamPtr);
+	indexFileNamePtr = 
+				(FileStringPtr)GetFilePathPPointerFromFileStream (&indexFileStream);
+	ConcatFilenameSuffix (indexFileNamePtr, (StringPtr)"\0.hdx\0");
+			
+	#if defined multispec_mac
+				// Force the uniFileName to be recreated to match the index file name.
+	
+		indexFileStream.uniFileName.length = 0;
+	#endif	// defined multispec_mac
+	
+	errCode = OpenFileReadOnly (&indexFileStream, 
+											kResolveAliasChains, 
+											kNoLockFile, 
+											kVerifyFileStream);
+	if (errCode != noErr)
+																					return (0);
+	
+	entryBufferPtr = NULL;
+	numberEntries = 0;
+	
+	errCode = MSetMarker (&indexFileStream, fsFromStart, 0, kNoErrorMessages);
+	
+	if (errCode == noErr)
+		{
+		count = kHdfDataSetIndexHeaderBytes;
+		errCode = MReadData (&indexFileStream, &count, headerBuffer, kNoErrorMessages);
+		
+		}	// end "if (errCode == noErr)"
+		
+	if (errCode == noErr && 
+							strncmp (headerBuffer, kHdfDataSetIndexIdentifier, 8) == 0)
+		{
+				// The values in the file are in little endian byte order. The index
+				// is only used if it was written for the same version of the file.
+				
+		gSwapBytesFlag = gBigEndianFlag;
+		
+		numberGroups = GetLongIntValue (&headerBuffer[20]);
+		firstDataSetIndex = GetLongIntValue (&headerBuffer[24]);
+		
+		if (GetLongIntValue (&headerBuffer[8]) <= kHdfDataSetIndexVersion &&
+					GetLongIntValue (&headerBuffer[12]) == format &&
+						GetLongIntValue (&headerBuffer[16]) == numberSubDataSets &&
+							(UInt32)GetLongIntValue (&headerBuffer[28]) == checkSum &&
+								GetLongInt64Value (&headerBuffer[32]) == fileSize &&
+									numberGroups >= 0 && 
+										numberGroups <= numberSubDataSets &&
+											firstDataSetIndex >= 0 &&
+												firstDataSetIndex <= numberSubDataSets)
+			numberEntries = numberSubDataSets + numberGroups;
+		
+		}	// end "if (errCode == noErr && strncmp (headerBuffer, ..."
+		
+	if (numberEntries > 0)
+		{
+		entryBufferPtr = (HCharPtr)MNewPointer (
+											(SInt64)numberEntries * kHdfDataSetIndexEntryBytes);
+		
+		count = numberEntries * kHdfDataSetIndexEntryBytes;
+		if (entryBufferPtr != NULL)
+			errCode = MReadData (
+							&indexFileStream, &count, entryBufferPtr, kNoErrorMessages);
+		
+		if (entryBufferPtr == NULL || errCode != noErr)
+			numberEntries = 0;
+		
+		}	// end "if (numberEntries > 0)"
+		
+	CloseFile (&indexFileStream);
+	
+	entryPtr = entryBufferPtr;
+	for (index=1; index<=numberEntries; index++)
+		{
+		BlockMoveData (entryPtr, hdfDataSetsPtr[index].name, 80);
+		
+		hdfDataSetsPtr[index].sdid = 0;
+		hdfDataSetsPtr[index].dataSetOffsetBytes = 
+														(UInt32)GetLongIntValue (&entryPtr[88]);
+		hdfDataSetsPtr[index].dataSet = GetShortIntValue (&entryPtr[80]);
+		hdfDataSetsPtr[index].dataSetType = GetShortIntValue (&entryPtr[82]);
+		hdfDataSetsPtr[index].groupedNumber = GetShortIntValue (&entryPtr[84]);
+		hdfDataSetsPtr[index].instrumentChannelNumber = 
+																GetShortIntValue (&entryPtr[86]);
+		
+		if (index <= numberSubDataSets)
+			{
+			hdfDataSetsPtr[index].vRefNum = hdfDataSetsPtr[0].vRefNum;
+			hdfDataSetsPtr[index].dirID = hdfDataSetsPtr[0].dirID;
+			
+			}	// end "if (index <= numberSubDataSets)"
+			
+		else	// index > numberSubDataSets
+			{
+					// This is the entry for a group of data sets.
+					
+			hdfDataSetsPtr[index].vRefNum = 0;
+			hdfDataSetsPtr[index].dirID = 0;
+			
+			}	// end "else index > numberSubDataSets"
+		
+		entryPtr += kHdfDataSetIndexEntryBytes;
+		
+		}	// end "for (index=1; index<=numberEntries; index++)"
+	
+	CheckAndDisposePtr ((Ptr)entryBufferPtr);
+	
+	if (numberEntries == 0)
+																					return (0);
+	
+	*firstDataSetIndexPtr = firstDataSetIndex;
+		
+	return (numberSubDataSets);
+    
+}	// end "ReadHdf5DataSetIndexFile"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean ReadHDF5ChunkedLine
+//
+//	Software purpose:	This routine reads the requested line for the requested channels
+//							of a compressed, chunked hdf5 data set from the chunk row
+//							buffer. The chunk row that includes the line is read if it
+//							is not already in the buffer. The data for the channels are
+//							stored one after the other in the output buffer, the same as
+//							for a GDALDatasetRasterIO read of the line.
+//
+//	Parameters in:		Handle to the gdal data set.
+//							File information structure pointer.
+//							Line number (1-based) to be read.
+//							First column (0-based) to be read.
+//							Last column (0-based) to be read.
+//							Number of channels to be read.
+//							List of channels (1-based) to be read.
+//
+//	Parameters out:	Buffer with the data for the line.
+//
+//	Value Returned:	TRUE if the line was read.
+//							FALSE if the line could not be read as part of a chunk row; 
+//								gdal will need to be used to read the line.
+//
+// Called By:			GetGDALLineOfData in SFileIO.cpp
+
+Boolean ReadHDF5ChunkedLine (
+				GDALDatasetH						hDS,
+				FileInfoPtr							fileInfoPtr,
+				UInt32								lineNumber,
+				UInt32								columnStart,
+				UInt32								columnEnd,
+				UInt32								numberChannels,
+				int*									channelListPtr,
+				HUCharPtr							outputBufferPtr)
+				
+{	
+	Hdf5ChunkedDataSetPtr			chunkedDataSetPtr;
+	
+	UInt32								channelIndex,
+											lineBytes,
+											lineIndex;
+	
+	Boolean								inBufferFlag;
+	
+	
+	chunkedDataSetPtr = GetHDF5ChunkedDataSet (hDS, fileInfoPtr);
+	if (chunkedDataSetPtr == NULL)
+																						return (FALSE);
+	
+	lineIndex = lineNumber - 1;
+	
+			// Check if the line is already in the chunk row buffer.
+	
+	inBufferFlag = (chunkedDataSetPtr->chunkRowNumberLines > 0 &&
+				lineIndex >= chunkedDataSetPtr->chunkRowFirstLine &&
+					lineIndex < chunkedDataSetPtr->chunkRowFirstLine + 
+													chunkedDataSetPtr->chunkRowNumberLines &&
+						columnStart == chunkedDataSetPtr->chunkRowColumnStart &&
+							columnEnd == chunkedDataSetPtr->chunkRowColumnEnd &&
+								numberChannels == chunkedDataSetPtr->chunkRowNumberChannels);
+	
+	for (channelIndex=0; 
+				channelIndex<numberChannels && inBufferFlag; 
+						channelIndex++)
+		{
+		if (channelListPtr != NULL &&
+					chunkedDataSetPtr->channelListPtr[channelIndex] != 
+																	channelListPtr[channelIndex])
+			inBufferFlag = FALSE;
+		
+		}	// end "for (channelIndex=0; channelIndex<numberChannels && ..."
+	
+	if (!inBufferFlag)
+		{
+		if (!ReadHDF5ChunkRow (chunkedDataSetPtr,
+										lineIndex,
+										columnStart,
+										columnEnd,
+										numberChannels,
+										channelListPtr))
+																						return (FALSE);
+		
+		}	// end "if (!inBufferFlag)"
+	
+			// Copy the line for each channel from the chunk row buffer.
+	
+	lineBytes = (columnEnd - columnStart + 1) * chunkedDataSetPtr->numberBytes;
+	
+	for (channelIndex=0; channelIndex<numberChannels; channelIndex++)
+		BlockMoveData (&chunkedDataSetPtr->chunkRowBufferPtr[
+							((SInt64)channelIndex * chunkedDataSetPtr->chunkRowNumberLines + 
+								lineIndex - chunkedDataSetPtr->chunkRowFirstLine) * lineBytes],
+							&outputBufferPtr[(SInt64)channelIndex * lineBytes],
+							lineBytes);
+	
+	return (TRUE);
+    
+}	// end "ReadHDF5ChunkedLine"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean ReadHDF5ChunkRow
+//
+//	Software purpose:	This routine reads the chunk row that includes the requested
+//							line into the chunk row buffer for the requested channels and
+//							columns. The buffer is stored band sequential. When the only
+//							filters are shuffle and deflate, each raw chunk is read with
+//							H5Dread_chunk, decompressed and the part needed is copied to
+//							the buffer. Otherwise the chunk row is read with one H5Dread
+//							of a chunk aligned hyperslab. The data set is not used for
+//							chunk row reads again if an error occurs.
+//
+//	Parameters in:		Pointer to the chunked data set structure.
+//							Line (0-based) to be read.
+//							First column (0-based) to be read.
+//							Last column (0-based) to be read.
+//							Number of channels to be read.
+//							List of channels (1-based) to be read.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	TRUE if the chunk row was read.
+//							FALSE if not.
+//
+// Called By:			ReadHDF5ChunkedLine in SHDF5.cpp
+
+Boolean ReadHDF5ChunkRow (
+				Hdf5ChunkedDataSetPtr			chunkedDataSetPtr,
+				UInt32								lineIndex,
+				UInt32								columnStart,
+				UInt32								columnEnd,
+				UInt32								numberChannels,
+				int*									channelListPtr)
+				
+{	
+	hsize_t								count[4],
+											offset[4];
+	
+	clock_t								startTime;
+	
+	hid_t									memorySpace_id;
+	
+	hsize_t								numberValues;
+	
+	SInt64								bufferBytes,
+											chunkBytes;
+	
+	UInt32								band,
+											bandChunk,
+											channelIndex,
+											chunkColumnStart,
+											chunkColumnEnd,
+											columnChunk,
+											firstLine,
+											lastChannelIndex,
+											line,
+											numberBytes,
+											numberChunkColumns,
+											numberChunkLines,
+											numberChunkBands,
+											numberColumns,
+											numberLines;
+	
+	int									dimension;
+	
+	Boolean								readFlag = TRUE;
+	
+	
+	numberBytes = chunkedDataSetPtr->numberBytes;
+	numberChunkLines = (UInt32)chunkedDataSetPtr->chunkDims[
+															chunkedDataSetPtr->lineDimension];
+	numberChunkColumns = (UInt32)chunkedDataSetPtr->chunkDims[
+															chunkedDataSetPtr->columnDimension];
+	numberChunkBands = 1;
+	if (chunkedDataSetPtr->bandDimension >= 0)
+		numberChunkBands = (UInt32)chunkedDataSetPtr->chunkDims[
+															chunkedDataSetPtr->bandDimension];
+	
+	firstLine = lineIndex / numberChunkLines * numberChunkLines;
+	numberLines = (UInt32)MIN (numberChunkLines, 
+			chunkedDataSetPtr->dims[chunkedDataSetPtr->lineDimension] - firstLine);
+	numberColumns = columnEnd - columnStart + 1;
+	
+			// Get memory for the chunk row buffer and the channel list if needed.
+	
+	bufferBytes = (SInt64)numberChannels * numberLines * numberColumns * numberBytes;
+	if (bufferBytes > kMaxHDF5ChunkRowBytes)
+																						return (FALSE);
+	
+	if (chunkedDataSetPtr->chunkRowBufferBytes < bufferBytes)
+		{
+		chunkedDataSetPtr->chunkRowBufferPtr = (HUCharPtr)CheckAndDisposePtr (
+														(Ptr)chunkedDataSetPtr->chunkRowBufferPtr);
+		chunkedDataSetPtr->chunkRowBufferBytes = 0;
+		
+		chunkedDataSetPtr->chunkRowBufferPtr = (HUCharPtr)MNewPointer (bufferBytes);
+		if (chunkedDataSetPtr->chunkRowBufferPtr == NULL)
+																						return (FALSE);
+		
+		chunkedDataSetPtr->chunkRowBufferBytes = bufferBytes;
+		
+		}	// end "if (chunkedDataSetPtr->chunkRowBufferBytes < bufferBytes)"
+	
+	if (chunkedDataSetPtr->maxNumberChannels < numberChannels)
+		{
+		chunkedDataSetPtr->channelListPtr = (int*)CheckAndDisposePtr (
+														(Ptr)chunkedDataSetPtr->channelListPtr);
+		chunkedDataSetPtr->maxNumberChannels = 0;
+		
+		chunkedDataSetPtr->channelListPtr = 
+										(int*)MNewPointer (numberChannels * sizeof (int));
+		if (chunkedDataSetPtr->channelListPtr == NULL)
+																						return (FALSE);
+		
+		chunkedDataSetPtr->maxNumberChannels = numberChannels;
+		
+		}	// end "if (chunkedDataSetPtr->maxNumberChannels < numberChannels)"
+	
+			// The channels need to be in increasing order with no duplicates.
+	
+	chunkedDataSetPtr->chunkRowNumberLines = 0;
+	
+	for (channelIndex=0; channelIndex<numberChannels; channelIndex++)
+		{
+		chunkedDataSetPtr->channelListPtr[channelIndex] = channelIndex + 1;
+		if (channelListPtr != NULL)
+			chunkedDataSetPtr->channelListPtr[channelIndex] = channelListPtr[channelIndex];
+			
+		band = chunkedDataSetPtr->channelListPtr[channelIndex];
+		if (band < 1 || 
+				(channelIndex > 0 && 
+						band <= (UInt32)chunkedDataSetPtr->channelListPtr[channelIndex-1]) ||
+					(chunkedDataSetPtr->bandDimension >= 0 && 
+						band > chunkedDataSetPtr->dims[chunkedDataSetPtr->bandDimension]) ||
+						(chunkedDataSetPtr->bandDimension < 0 && band > 1))
+																						return (FALSE);
+		
+		}	// end "for (channelIndex=0; channelIndex<numberChannels; channelIndex++)"
+	
+	for (dimension=0; dimension<chunkedDataSetPtr->numberDimensions; dimension++)
+		{
+		offset[dimension] = 0;
+		count[dimension] = 1;
+		
+		}	// end "for (dimension=0; dimension<...; dimension++)"
+	
+	offset[chunkedDataSetPtr->lineDimension] = firstLine;
+	
+	#if include_zlib_capability && H5_VERSION_GE(1,10,2)
+		if (chunkedDataSetPtr->rawChunkFlag)
+			{
+			hsize_t				storageBytes;
+			uLongf				decompressedBytes;
+			uint32_t				filterMask;
+			HUCharPtr			chunkDataPtr,
+									shuffleBufferPtr;
+			UInt32				bandInChunk,
+									byteIndex,
+									element,
+									index,
+									numberElements;
+			
+					// Get memory for the decompressed chunk and a buffer to undo the
+					// shuffle filter if needed.
+			
+			chunkBytes = numberBytes;
+			for (dimension=0; dimension<chunkedDataSetPtr->numberDimensions; dimension++)
+				chunkBytes *= chunkedDataSetPtr->chunkDims[dimension];
+			
+			if (chunkedDataSetPtr->chunkBufferBytes < 2 * chunkBytes)
+				{
+				chunkedDataSetPtr->chunkBufferPtr = (HUCharPtr)CheckAndDisposePtr (
+														(Ptr)chunkedDataSetPtr->chunkBufferPtr);
+				chunkedDataSetPtr->chunkBufferBytes = 0;
+				
+				chunkedDataSetPtr->chunkBufferPtr = (HUCharPtr)MNewPointer (2 * chunkBytes);
+				if (chunkedDataSetPtr->chunkBufferPtr == NULL)
+																						return (FALSE);
+				
+				chunkedDataSetPtr->chunkBufferBytes = 2 * chunkBytes;
+				
+				}	// end "if (chunkedDataSetPtr->chunkBufferBytes < 2 * chunkBytes)"
+			
+			chunkDataPtr = chunkedDataSetPtr->chunkBufferPtr;
+			shuffleBufferPtr = &chunkedDataSetPtr->chunkBufferPtr[chunkBytes];
+			numberElements = (UInt32)(chunkBytes / numberBytes);
+			
+					// Read each chunk once for the channels in the chunk.
+			
+			channelIndex = 0;
+			while (channelIndex < numberChannels && readFlag)
+				{
+				band = chunkedDataSetPtr->channelListPtr[channelIndex] - 1;
+				bandChunk = band / numberChunkBands;
+				
+				lastChannelIndex = channelIndex;
+				while (lastChannelIndex+1 < numberChannels &&
+							(UInt32)(chunkedDataSetPtr->channelListPtr[lastChannelIndex+1] - 1) /
+																	numberChunkBands == bandChunk)
+					lastChannelIndex++;
+				
+				if (chunkedDataSetPtr->bandDimension >= 0)
+					offset[chunkedDataSetPtr->bandDimension] = 
+																bandChunk * numberChunkBands;
+				
+				for (columnChunk=columnStart/numberChunkColumns; 
+							columnChunk<=columnEnd/numberChunkColumns && readFlag; 
+									columnChunk++)
+					{
+					offset[chunkedDataSetPtr->columnDimension] = 
+																columnChunk * numberChunkColumns;
+					
+							// Read the raw chunk.
+					
+					startTime = clock ();
+					
+					storageBytes = 0;
+					if (H5Dget_chunk_storage_size (chunkedDataSetPtr->dataSet_id,
+																offset,
+																&storageBytes) < 0 ||
+																			storageBytes == 0)
+						readFlag = FALSE;
+					
+					if (readFlag && 
+								chunkedDataSetPtr->compressedBufferBytes < (SInt64)storageBytes)
+						{
+						chunkedDataSetPtr->compressedBufferPtr = 
+											(HUCharPtr)CheckAndDisposePtr (
+												(Ptr)chunkedDataSetPtr->compressedBufferPtr);
+						chunkedDataSetPtr->compressedBufferBytes = 0;
+						
+						chunkedDataSetPtr->compressedBufferPtr = 
+													(HUCharPtr)MNewPointer (storageBytes);
+						if (chunkedDataSetPtr->compressedBufferPtr == NULL)
+							readFlag = FALSE;
+						
+						else	// chunkedDataSetPtr->compressedBufferPtr != NULL
+							chunkedDataSetPtr->compressedBufferBytes = storageBytes;
+						
+						}	// end "if (readFlag && ..."
+					
+					filterMask = 0;
+					if (readFlag && H5Dread_chunk (chunkedDataSetPtr->dataSet_id,
+																H5P_DEFAULT,
+																offset,
+																&filterMask,
+																chunkedDataSetPtr->compressedBufferPtr) < 0)
+						readFlag = FALSE;
+					
+					gHDF5ChunkReadSeconds += 
+									(double)(clock () - startTime) / CLOCKS_PER_SEC;
+					
+					if (!readFlag)
+						break;
+					
+							// Decompress the chunk and undo the shuffle filter.
+					
+					startTime = clock ();
+					
+					if (chunkedDataSetPtr->deflateFilterIndex >= 0 &&
+							!(filterMask & (1 << chunkedDataSetPtr->deflateFilterIndex)))
+						{
+						decompressedBytes = (uLongf)chunkBytes;
+						if (uncompress (chunkDataPtr,
+												&decompressedBytes,
+												chunkedDataSetPtr->compressedBufferPtr,
+												(uLong)storageBytes) != Z_OK ||
+											decompressedBytes != (uLongf)chunkBytes)
+							readFlag = FALSE;
+						
+						}	// end "if (chunkedDataSetPtr->deflateFilterIndex >= 0 && ..."
+						
+					else if (storageBytes == (hsize_t)chunkBytes)
+						BlockMoveData (chunkedDataSetPtr->compressedBufferPtr,
+											chunkDataPtr,
+											chunkBytes);
+					
+					else	// storageBytes != chunkBytes
+						readFlag = FALSE;
+					
+					if (readFlag &&
+							numberBytes > 1 &&
+								chunkedDataSetPtr->shuffleFilterIndex >= 0 &&
+									!(filterMask & (1 << chunkedDataSetPtr->shuffleFilterIndex)))
+						{
+								// The shuffle filter stores the first byte of all elements,
+								// then the second byte of all elements, etc.
+						
+						BlockMoveData (chunkDataPtr, shuffleBufferPtr, chunkBytes);
+						for (element=0; element<numberElements; element++)
+							for (byteIndex=0; byteIndex<numberBytes; byteIndex++)
+								chunkDataPtr[(SInt64)element*numberBytes + byteIndex] = 
+									shuffleBufferPtr[(SInt64)byteIndex*numberElements + element];
+						
+						}	// end "if (readFlag && numberBytes > 1 && ..."
+					
+					gHDF5ChunkDecompressSeconds += 
+									(double)(clock () - startTime) / CLOCKS_PER_SEC;
+					gNumberHDF5ChunksRead++;
+					
+					if (!readFlag)
+						break;
+					
+							// Copy the requested lines and columns for the channels in
+							// this chunk to the chunk row buffer.
+					
+					chunkColumnStart = MAX (columnStart, columnChunk * numberChunkColumns);
+					chunkColumnEnd = MIN (columnEnd, 
+											(columnChunk + 1) * numberChunkColumns - 1);
+					
+					for (index=channelIndex; index<=lastChannelIndex; index++)
+						{
+						bandInChunk = chunkedDataSetPtr->channelListPtr[index] - 1 - 
+																	bandChunk * numberChunkBands;
+						
+						for (line=0; line<numberLines; line++)
+							BlockMoveData (
+									&chunkDataPtr[(((SInt64)bandInChunk * numberChunkLines + line) *
+										numberChunkColumns + 
+											chunkColumnStart - columnChunk * numberChunkColumns) *
+																							numberBytes],
+									&chunkedDataSetPtr->chunkRowBufferPtr[
+										(((SInt64)index * numberLines + line) * numberColumns +
+											chunkColumnStart - columnStart) * numberBytes],
+									(chunkColumnEnd - chunkColumnStart + 1) * numberBytes);
+						
+						}	// end "for (index=channelIndex; index<=lastChannelIndex; ..."
+					
+					}	// end "for (columnChunk=columnStart/numberChunkColumns; ..."
+				
+				channelIndex = lastChannelIndex + 1;
+				
+				}	// end "while (channelIndex < numberChannels && readFlag)"
+			
+			}	// end "if (chunkedDataSetPtr->rawChunkFlag)"
+			
+		else	// !chunkedDataSetPtr->rawChunkFlag
+	#endif	// include_zlib_capability && H5_VERSION_GE(1,10,2)
+			{
+					// Select a hyperslab for each channel. The channels are in 
+					// increasing order so the data are read band sequential.
+			
+			count[chunkedDataSetPtr->lineDimension] = numberLines;
+			offset[chunkedDataSetPtr->columnDimension] = columnStart;
+			count[chunkedDataSetPtr->columnDimension] = numberColumns;
+			
+			for (channelIndex=0; 
+						channelIndex<numberChannels && readFlag; 
+								channelIndex++)
+				{
+				if (chunkedDataSetPtr->bandDimension >= 0)
+					offset[chunkedDataSetPtr->bandDimension] = 
+										chunkedDataSetPtr->channelListPtr[channelIndex] - 1;
+				
+				if (H5Sselect_hyperslab (chunkedDataSetPtr->dataSpace_id,
+													(channelIndex == 0) ? H5S_SELECT_SET : H5S_SELECT_OR,
+													offset,
+													NULL,
+													count,
+													NULL) < 0)
+					readFlag = FALSE;
+				
+				}	// end "for (channelIndex=0; channelIndex<numberChannels && ..."
+			
+			numberValues = (hsize_t)numberChannels * numberLines * numberColumns;
+			if (readFlag && 
+						H5Sget_select_npoints (chunkedDataSetPtr->dataSpace_id) != 
+																			(hssize_t)numberValues)
+				readFlag = FALSE;
+			
+			if (readFlag)
+				{
+				memorySpace_id = H5Screate_simple (1, &numberValues, NULL);
+				
+				startTime = clock ();
+				
+				if (memorySpace_id < 0 ||
+						H5Dread (chunkedDataSetPtr->dataSet_id,
+									chunkedDataSetPtr->memoryType_id,
+									memorySpace_id,
+									chunkedDataSetPtr->dataSpace_id,
+									H5P_DEFAULT,
+									chunkedDataSetPtr->chunkRowBufferPtr) < 0)
+					readFlag = FALSE;
+				
+				gHDF5LibraryReadSeconds += (double)(clock () - startTime) / CLOCKS_PER_SEC;
+				
+				if (memorySpace_id >= 0)
+					H5Sclose (memorySpace_id);
+				
+						// Count the chunks that the chunk row covers.
+				
+				band = numberChannels;
+				if (chunkedDataSetPtr->bandDimension >= 0)
+					band = (chunkedDataSetPtr->channelListPtr[numberChannels-1] - 1) / 
+																	numberChunkBands -
+								(chunkedDataSetPtr->channelListPtr[0] - 1) / 
+																	numberChunkBands + 1;
+				
+				gNumberHDF5ChunksRead += band * (columnEnd/numberChunkColumns - 
+															columnStart/numberChunkColumns + 1);
+				
+				}	// end "if (readFlag)"
+			
+			}	// end "else !chunkedDataSetPtr->rawChunkFlag"
+	
+	if (!readFlag)
+		{
+		chunkedDataSetPtr->useFlag = FALSE;
+																						return (FALSE);
+																						
+		}	// end "if (!readFlag)"
+	
+	chunkedDataSetPtr->chunkRowFirstLine = firstLine;
+	chunkedDataSetPtr->chunkRowNumberLines = numberLines;
+	chunkedDataSetPtr->chunkRowColumnStart = columnStart;
+	chunkedDataSetPtr->chunkRowColumnEnd = columnEnd;
+	chunkedDataSetPtr->chunkRowNumberChannels = numberChannels;
+	
+	return (TRUE);
+    
+}	// end "ReadHDF5ChunkRow"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void ReleaseHDF5ChunkedDataSet
+//
+//	Software purpose:	This routine closes the hdf5 identifiers and releases the
+//							memory used for chunk row reads of the input data set.
+//
+//	Parameters in:		Handle to the gdal data set.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None
+//
+// Called By:			CloseHDF5DataSetInfo in SHDF5.cpp
+
+void ReleaseHDF5ChunkedDataSet (
+				GDALDatasetH						hDS)
+				
+{	
+	Hdf5ChunkedDataSetPtr			chunkedDataSetPtr;
+	
+	UInt32								index;
+	
+	
+	for (index=0; index<gNumberHDF5ChunkedDataSets; index++)
+		{
+		chunkedDataSetPtr = &gHDF5ChunkedDataSets[index];
+		if (chunkedDataSetPtr->hDS == hDS)
+			{
+			if (chunkedDataSetPtr->memoryType_id >= 0)
+				H5Tclose (chunkedDataSetPtr->memoryType_id);
+			
+			if (chunkedDataSetPtr->dataSpace_id >= 0)
+				H5Sclose (chunkedDataSetPtr->dataSpace_id);
+			
+			if (chunkedDataSetPtr->dataSet_id >= 0)
+				H5Dclose (chunkedDataSetPtr->dataSet_id);
+			
+			CheckAndDisposePtr ((Ptr)chunkedDataSetPtr->chunkBufferPtr);
+			CheckAndDisposePtr ((Ptr)chunkedDataSetPtr->chunkRowBufferPtr);
+			CheckAndDisposePtr ((Ptr)chunkedDataSetPtr->compressedBufferPtr);
+			CheckAndDisposePtr ((Ptr)chunkedDataSetPtr->channelListPtr);
+			
+					// Move the last data set into this location in the list.
+			
+			gNumberHDF5ChunkedDataSets--;
+			if (index < gNumberHDF5ChunkedDataSets)
+				gHDF5ChunkedDataSets[index] = 
+										gHDF5ChunkedDataSets[gNumberHDF5ChunkedDataSets];
+			
+			break;
+			
+			}	// end "if (chunkedDataSetPtr->hDS == hDS)"
+		
+		}	// end "for (index=0; index<gNumberHDF5ChunkedDataSets; index++)"
+    
+}	// end "ReleaseHDF5ChunkedDataSet"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -3484,5 +4731,185 @@ SInt16 SetUpHDF5_FileInformation (
 	return (returnCode);
     
 }	// end "SetUpHDF5_FileInformation"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void WriteHdf5DataSetIndexFile
+//
+//	Software purpose:	This routine writes the descriptions of the subdata sets
+//							in the hdf or netCDF file to a data set index (.hdx) file
+//							beside the file so that the next time the file is opened
+//							the subdata sets do not need to be opened and described. The
+//							file is not written if the folder cannot be written to.
+//							Values are stored in little endian byte order.
+//
+//								Bytes  0-  7: 'MSPECHDX'
+//								Bytes  8- 11: version
+//								Bytes 12- 15: file format
+//								Bytes 16- 19: number of subdata sets
+//								Bytes 20- 23: number of data set groups
+//								Bytes 24- 27: index of first valid data set
+//								Bytes 28- 31: check sum of the subdata set names
+//								Bytes 32- 39: size of the hdf file in bytes
+//
+//							For each subdata set and then each group starting at byte 40:
+//								Bytes  0- 79: name as listed in the data set popup menu
+//								Bytes 80- 81: data set number
+//								Bytes 82- 83: data set type
+//								Bytes 84- 85: grouped number
+//								Bytes 86- 87: instrument channel number
+//								Bytes 88- 91: data set offset bytes
+//
+//	Parameters in:		File information structure pointer.
+//							Format of the file.
+//							Number of subdata sets in the file.
+//							Check sum of the subdata set names.
+//							Data sets structure.
+//							Number of data set groups.
+//							Index of the first valid data set.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None
+//
+// Called By:			LoadHdf5DataSetNames in SHDF5.cpp
+
+void WriteHdf5DataSetIndexFile (
+				FileInfoPtr							fileInfoPtr,
+				SInt16								format,
+				SInt32								numberSubDataSets,
+				UInt32								checkSum,
+				HdfDataSets*						hdfDataSetsPtr,
+				SInt32								numberGroups,
+				SInt32								firstDataSetIndex)
+				
+{
+	CMFileStream						indexFileStream;
+	
+	CMFileStream*						fileStreamPtr;
+	FileStringPtr						fileNamePtr,
+											indexFileNamePtr;
+	HCharPtr								bufferPtr,
+											entryPtr;
+	
+	SInt64								fileSize;
+	
+	SInt32								index,
+											numberEntries,
+											tempSInt32;
+	
+	UInt32								count;
+	
+	SInt16								errCode,
+											tempSInt16;
+	
+	
+	errCode = GetSizeOfFile (fileInfoPtr, &fileSize);
+	if (errCode != noErr)
+																							return;
+	
+	numberEntries = numberSubDataSets + numberGroups;
+	count = kHdfDataSetIndexHeaderBytes + numberEntries * kHdfDataSetIndexEntryBytes;
+	
+	bufferPtr = (HCharPtr)MNewPointerClear (count);
+	if (bufferPtr == NULL)
+																							return;
+	
+			// Store the values in little endian byte order.
+			
+	gSwapBytesFlag = gBigEndianFlag;
+			
+	BlockMoveData ((char*)kHdfDataSetIndexIdentifier, bufferPtr, 8);
+	
+	tempSInt32 = kHdfDataSetIndexVersion;
+	tempSInt32 = GetLongIntValue ((char*)&tempSInt32);
+	BlockMoveData ((char*)&tempSInt32, &bufferPtr[8], 4);
+	
+	tempSInt32 = format;
+	tempSInt32 = GetLongIntValue ((char*)&tempSInt32);
+	BlockMoveData ((char*)&tempSInt32, &bufferPtr[12], 4);
+	
+	tempSInt32 = GetLongIntValue ((char*)&numberSubDataSets);
+	BlockMoveData ((char*)&tempSInt32, &bufferPtr[16], 4);
+	
+	tempSInt32 = GetLongIntValue ((char*)&numberGroups);
+	BlockMoveData ((char*)&tempSInt32, &bufferPtr[20], 4);
+	
+	tempSInt32 = GetLongIntValue ((char*)&firstDataSetIndex);
+	BlockMoveData ((char*)&tempSInt32, &bufferPtr[24], 4);
+	
+	tempSInt32 = GetLongIntValue ((char*)&checkSum);
+	BlockMoveData ((char*)&tempSInt32, &bufferPtr[28], 4);
+	
+	fileSize = GetLongInt64Value ((char*)&fileSize);
+	BlockMoveData ((char*)&fileSize, &bufferPtr[32], 8);
+	
+	entryPtr = &bufferPtr[kHdfDataSetIndexHeaderBytes];
+	for (index=1; index<=numberEntries; index++)
+		{
+		BlockMoveData (hdfDataSetsPtr[index].name, entryPtr, 80);
+		
+		tempSInt16 = GetShortIntValue ((char*)&hdfDataSetsPtr[index].dataSet);
+		BlockMoveData ((char*)&tempSInt16, &entryPtr[80], 2);
+		
+		tempSInt16 = GetShortIntValue ((char*)&hdfDataSetsPtr[index].dataSetType);
+		BlockMoveData ((char*)&tempSInt16, &entryPtr[82], 2);
+		
+		tempSInt16 = GetShortIntValue ((char*)&hdfDataSetsPtr[index].groupedNumber);
+		BlockMoveData ((char*)&tempSInt16, &entryPtr[84], 2);
+		
+		tempSInt16 = GetShortIntValue (
+								(char*)&hdfDataSetsPtr[index].instrumentChannelNumber);
+		BlockMoveData ((char*)&tempSInt16, &entryPtr[86], 2);
+		
+		tempSInt32 = GetLongIntValue ((char*)&hdfDataSetsPtr[index].dataSetOffsetBytes);
+		BlockMoveData ((char*)&tempSInt32, &entryPtr[88], 4);
+		
+		entryPtr += kHdfDataSetIndexEntryBytes;
+		
+		}	// end "for (index=1; index<=numberEntries; index++)"
+	
+			// The index file has the same name as the hdf file with .hdx appended.
+			// It is created in the same folder as the hdf file.
+			
+	fileStreamPtr = GetFileStreamPointer (fileInfoPtr);
+	InitializeFileStream (&indexFileStream);
+	
+	fileNamePtr = (FileStringPtr)GetFilePathPPointerFromFileStream (fileStreamPtr);
+	indexFileNamePtr = 
+				(FileStringPtr)GetFilePathPPointerFromFileStream (&indexFileStream);
+	
+	CopyPToP (indexFileNamePtr, fileNamePtr);
+	ConcatFilenameSuffix (indexFileNamePtr, (StringPtr)"\0.hdx\0");
+			
+	#if defined multispec_mac
+				// Force the uniFileName to be recreated to match the index file name.
+	
+		indexFileStream.uniFileName.length = 0;
+	#endif	// defined multispec_mac
+	
+	SetType (&indexFileStream, kBINAFileType);
+	SetVolumeReference (fileStreamPtr, &indexFileStream);
+	
+	errCode = CreateNewFile (&indexFileStream, 
+										GetVolumeReferenceNumber (fileStreamPtr), 
+										gCreator, 
+										kNoErrorMessages, 
+										kReplaceFlag);
+	
+	if (errCode == noErr)
+		{
+		errCode = MWriteData (&indexFileStream, &count, bufferPtr, kNoErrorMessages);
+		
+		CloseFile (&indexFileStream);
+		
+		}	// end "if (errCode == noErr)"
+		
+	CheckAndDisposePtr ((Ptr)bufferPtr);
+    
+}	// end "WriteHdf5DataSetIndexFile"
 #endif	// include_hdf5_capability						
 #endif	// include_gdal_capability
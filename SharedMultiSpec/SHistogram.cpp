@@ -126,9 +126,61 @@
 
 		
 
+		// Information from the header of a MultiSpec binary image statistics 
+		// (.sta) file.
+		
+typedef struct BinarySTAHeader
+	{
+	SInt64							totalPixels;
+	UInt32							maxNumberBins;
+	UInt32							numberChannelBytes;
+	UInt32							numberChannels;
+	
+	} BinarySTAHeader, *BinarySTAHeaderPtr;
+
+		// Structure used to compute the histogram for a block of lines on worker
+		// threads. Each task handles one group of channels for one range of lines
+		// in the block. The tasks for the first line range add directly to the 
+		// histogram array and summary. Those for the other line ranges add to 
+		// their own bins and summaries which are added to the histogram after all
+		// lines for the image file have been read.
+		
+typedef struct HistogramLines
+	{
+	HistogramSummaryPtr				histogramSummaryPtr;
+	HistogramSummaryPtr				rangeSummaryPtr;
+	HUCharPtr							blockBufferPtr;
+	HUInt32Ptr							histogramArrayPtr;
+	HUInt32Ptr							rangeArrayPtr;
+	UInt16*								channelListPtr;
+	
+	UInt32								interval;
+	UInt32								lineBytes;
+	UInt32								maxNumberBins;
+	UInt32								numberChannelGroups;
+	UInt32								numberLineRanges;
+	UInt32								numberLines;
+	UInt32								numberRangeBins;
+	UInt32								numberSamples;
+	
+	SInt16								computeCode;
+	UInt16								numberChannels;
+	
+	Boolean								BISFlag;
+	Boolean								integerFlag;
+	
+	} HistogramLines, *HistogramLinesPtr;
+
+		
+
 			// Prototype descriptions for routines in this file that are only		
 			// called by routines in this file.
 																			
+void	AddHistogramLimitValues (
+				HistogramSummaryPtr				histogramSummaryPtr,
+				double								maxDataValue,
+				double								minDataValue);
+				
 Boolean	CreateSTASupportFile (
 				FileInfoPtr 						fileInfoPtr,
 				HistogramSpecsPtr 				histogramSpecsPtr,
@@ -144,6 +196,10 @@ Boolean	ComputeHistogram (
 				HUInt32Ptr							histogramArrayPtr,
 				SInt16								channelIndex,
 				SInt16								computeCode);
+				
+void	ComputeHistogramLinesTask (
+				void*									taskInfoPtr,
+				UInt32								task);
 							
 UInt32	DetermineBytesForHistogramText (
 				HistogramSpecsPtr					histogramSpecsPtr,
@@ -263,6 +319,26 @@ Boolean	LoadSupportFile (
 				UInt32								channelIndex,
 				Boolean								summaryFlag);
 
+SInt16	ReadBinarySTAData (
+				CMFileStream*						supportFileStreamPtr,
+				SInt64								fileOffset,
+				UInt32								numberBytes,
+				HPtr									bufferPtr,
+				SInt16								messageCode);
+
+Boolean	ReadBinarySTAHeader (
+				CMFileStream*						supportFileStreamPtr,
+				BinarySTAHeaderPtr				binarySTAHeaderPtr);
+
+Boolean	ReadBinarySTASupportFile (
+				HistogramSpecsPtr					histogramSpecsPtr,
+				HUInt32Ptr							histogramArrayPtr,
+				CMFileStream*						supportFileStreamPtr,
+				BinarySTAHeaderPtr				binarySTAHeaderPtr,
+				UInt16*								channelListPtr,
+				SInt16								numberChannels,
+				Boolean								summaryFlag);
+
 void	SetHistogramLineColumnSpecs (
 				HistogramSpecsPtr					histogramSpecsPtr,
 				SInt32								lineStart,
@@ -271,6 +347,10 @@ void	SetHistogramLineColumnSpecs (
 				SInt32								columnEnd,
 				SInt32								numberChannels);
 
+void	SetHistogramSummaryDerivedValues (
+				HistogramSpecsPtr					histogramSpecsPtr,
+				SInt16								channel);
+
 void 	SetNumberOfMaximumDataValuesInArray (
 				HistogramSummaryPtr				histogramSummaryPtr,
 				HUInt32Ptr							histogramArrayPtr,
@@ -285,11 +365,80 @@ void	UpdateSupportFileTypeSetting (
 				WindowInfoPtr						windowInfoPtr,
 				HistogramSpecsPtr					histogramSpecsPtr);
 
+Boolean	WriteBinarySTASupportFile (
+				HistogramSpecsPtr					histogramSpecsPtr,
+				CMFileStream*						supportFileStreamPtr,
+				HUInt32Ptr							medianArrayPtr,
+				SInt16								channelStart,
+				SInt16								channelEnd);
+
 
 ControlRef	sControlRef = NULL;
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void AddHistogramLimitValues
+//
+//	Software purpose:	The purpose of this routine is to update the maximum and
+//							maximum nonsaturated values and the minimum and minimum 
+//							nonsaturated values in the histogram summary for the input
+//							values. The rules are the same as those used for each data 
+//							value in ComputeHistogram so that the limits for a range of
+//							lines can be added in by passing the nonsaturated limits 
+//							and then the limits.
+//
+//	Parameters in:		Pointer to the histogram summary for the channel.
+//							Value to be checked against the maximums.
+//							Value to be checked against the minimums.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None
+//
+// Called By:			ComputeHistogram
+//							ComputeHistogramLinesTask
+
+void AddHistogramLimitValues (
+				HistogramSummaryPtr				histogramSummaryPtr,
+				double								maxDataValue,
+				double								minDataValue)
+
+{
+	if (maxDataValue != histogramSummaryPtr->maxValue)
+		{		
+		if (maxDataValue > histogramSummaryPtr->maxValue)
+			{
+			histogramSummaryPtr->maxNonSatValue = histogramSummaryPtr->maxValue;
+			histogramSummaryPtr->maxValue = maxDataValue;
+		
+			}	// end "if (maxDataValue > histogramSummaryPtr->maxValue)"
+		
+		else if (maxDataValue > histogramSummaryPtr->maxNonSatValue)
+			histogramSummaryPtr->maxNonSatValue = maxDataValue;
+		
+		}	// end "if (maxDataValue != histogramSummaryPtr->maxValue)"
+	
+	if (minDataValue != histogramSummaryPtr->minValue)
+		{
+		if (minDataValue < histogramSummaryPtr->minValue)
+			{
+			histogramSummaryPtr->minNonSatValue = histogramSummaryPtr->minValue;
+			histogramSummaryPtr->minValue = minDataValue;
+			
+			}	// end "if (minDataValue < histogramSummaryPtr->minValue)"
+			
+		else if (minDataValue < histogramSummaryPtr->minNonSatValue)
+			histogramSummaryPtr->minNonSatValue = minDataValue;
+		
+		}	// end "if (minDataValue != histogramSummaryPtr->minValue)"
+	
+}	// end "AddHistogramLimitValues"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -489,13 +638,19 @@ Boolean ComputeHistogram (
 											
 	HDoublePtr							ioDoublePtr;
 	
-	HistogramSummaryPtr				histogramSummaryPtr;
+	HistogramLines						histogramLines;
+	
+	HistogramSummaryPtr				histogramSummaryPtr,
+											rangeSummaryPtr;
 											
 	HSInt32Ptr							ioBuffer4Ptr;
 	
 	HUInt32Ptr							medianArrayChanPtr,
+											rangeArrayPtr,
 											savedHistogramArrayPtr; 
 	
+	UInt32*								numberOutputSamplesPtr;
+	
 	UInt16								*channelListPtr,
 											*localChannelListPtr;
 											    
@@ -504,7 +659,9 @@ Boolean ComputeHistogram (
 											maxBinIndex,
 											signedValueOffset;
 	
-	UInt32								columnEnd,
+	UInt32								blockLineCount,
+											blockLineIndex,
+											columnEnd,
 											columnInterval,
 											columnStart,
 											index,
@@ -512,10 +669,13 @@ Boolean ComputeHistogram (
 											line,
 											lineEnd,
 											lineInterval,
+											lineRange,
 											lineStart,          
 											medianPoint,
 											numberBins,
+											numberBlockLines,
 											numberSamples,
+											numberThreads,
 											sum; 
 	
 	SInt16								binType,
@@ -529,6 +689,7 @@ Boolean ComputeHistogram (
 											fileInfoIndexEnd,
 											fileInfoIndexStart,
 											imageFileNumberChannels,
+											lineNumberChannels,
 											totalNumberChannels; 
 											
 	Boolean								allChannelsAtTimeFlag,
@@ -791,6 +952,128 @@ Boolean ComputeHistogram (
 				}	// end "else localFileInfoPtr->numberBytes > 2"
 				
 			savedHistogramArrayPtr = medianArrayChanPtr;
+			
+					// If more than one thread can be used, read blocks of lines and
+					// compute the histogram for each block on worker threads. The 
+					// channels are divided into groups first; the lines in the block
+					// are divided into ranges only when there are fewer channels than
+					// threads so that the extra memory for the bins is small.
+					
+			histogramLines.blockBufferPtr = NULL;
+			histogramLines.rangeSummaryPtr = NULL;
+			histogramLines.rangeArrayPtr = NULL;
+			histogramLines.numberLineRanges = 1;
+			numberBlockLines = 1;
+			
+			numberThreads = GetNumberWorkerThreads (kMaxNumberThreads);
+			if (numberThreads > 1)
+				{
+				histogramLines.lineBytes = numberSamples * sizeof (double);
+				if (integerFlag)
+					histogramLines.lineBytes = numberSamples * sizeof (SInt32);
+					
+				if (!BISFlag)
+					histogramLines.lineBytes *= imageFileNumberChannels;
+				
+				histogramLines.blockBufferPtr = GetLinesOfDataBuffer (
+											histogramLines.lineBytes,
+											(lineEnd - lineStart + lineInterval)/lineInterval,
+											&numberBlockLines,
+											&numberOutputSamplesPtr);
+				
+				}	// end "if (numberThreads > 1)"
+			
+			if (histogramLines.blockBufferPtr != NULL)
+				{
+						// The bins are shared by all channels when only the first bit
+						// of the compute code is set.
+						
+				histogramLines.numberChannelGroups = 1;
+				histogramLines.numberRangeBins = histogramSpecsPtr->maxNumberBins;
+				if (computeCode & 0x0002 || histogramArrayPtr == NULL)
+					{
+					histogramLines.numberChannelGroups = 
+											MIN (numberThreads, imageFileNumberChannels);
+					histogramLines.numberRangeBins *= imageFileNumberChannels;
+					
+					}	// end "if (computeCode & 0x0002 || histogramArrayPtr == NULL)"
+					
+				histogramLines.numberLineRanges = 
+									numberThreads / histogramLines.numberChannelGroups;
+				histogramLines.numberLineRanges = 
+									MIN (histogramLines.numberLineRanges, numberBlockLines);
+				
+				if (histogramLines.numberLineRanges > 1)
+					{
+					histogramLines.rangeSummaryPtr = (HistogramSummaryPtr)MNewPointer (
+							(SInt64)(histogramLines.numberLineRanges - 1) * 
+								(imageFileNumberChannels * sizeof (HistogramSummary) +
+									histogramLines.numberRangeBins * sizeof (UInt32)));
+					
+					if (histogramLines.rangeSummaryPtr == NULL)
+						histogramLines.numberLineRanges = 1;
+						
+					}	// end "if (histogramLines.numberLineRanges > 1)"
+					
+				if (histogramLines.rangeSummaryPtr != NULL)
+					{
+							// Each line range starts with the summary values that the
+							// histogram for the channel starts with except for the sums.
+							
+					rangeSummaryPtr = histogramLines.rangeSummaryPtr;
+					for (lineRange=1; 
+							lineRange<histogramLines.numberLineRanges; 
+							lineRange++)
+						{
+						for (channel=0; channel<imageFileNumberChannels; channel++)
+							{
+							chanIndex = channelListPtr[channelOffset+channel];
+							*rangeSummaryPtr = histogramSummaryPtr[chanIndex];
+							rangeSummaryPtr->averageValue = 0;
+							rangeSummaryPtr->stdDeviation = 0;
+							rangeSummaryPtr++;
+							
+							}	// end "for (channel=0; channel<..."
+						
+						}	// end "for (lineRange=1; lineRange<..."
+						
+					if (histogramArrayPtr != NULL)
+						{
+						histogramLines.rangeArrayPtr = (HUInt32Ptr)rangeSummaryPtr;
+						numberBins = (histogramLines.numberLineRanges - 1) * 
+																histogramLines.numberRangeBins;
+						for (index=0; index<numberBins; index++)
+							histogramLines.rangeArrayPtr[index] = 0;
+							
+						}	// end "if (histogramArrayPtr != NULL)"
+						
+					}	// end "if (histogramLines.rangeSummaryPtr != NULL)"
+				
+				histogramLines.histogramSummaryPtr = histogramSummaryPtr;
+				histogramLines.histogramArrayPtr = NULL;
+				if (histogramArrayPtr != NULL)
+					histogramLines.histogramArrayPtr = savedHistogramArrayPtr;
+				histogramLines.channelListPtr = &channelListPtr[channelOffset];
+				histogramLines.interval = interval;
+				histogramLines.maxNumberBins = histogramSpecsPtr->maxNumberBins;
+				histogramLines.numberSamples = numberSamples;
+				histogramLines.computeCode = computeCode;
+				histogramLines.numberChannels = imageFileNumberChannels;
+				histogramLines.BISFlag = BISFlag;
+				histogramLines.integerFlag = integerFlag;
+				
+				}	// end "if (histogramLines.blockBufferPtr != NULL)"
+			
+			blockLineCount = 0;
+			blockLineIndex = 0;
+			
+					// The channels for each line are counted in the loop below only
+					// when the histograms are not being computed for blocks of lines
+					// on worker threads.
+					
+			lineNumberChannels = imageFileNumberChannels;
+			if (histogramLines.blockBufferPtr != NULL)
+				lineNumberChannels = 0;
 
 					// Read line of image as specified by HistogramSpecs.				
   	
@@ -798,17 +1081,61 @@ Boolean ComputeHistogram (
 				{
 						// Get all channels for the line of image data.  Return 		
 						// if there is a file IO error.										
+						
+						// When using worker threads, the histogram for the next block 
+						// of lines is computed when all lines in the current block 
+						// have been counted.
 					 
-				errCode = GetLineOfData (fileIOInstructionsPtr,
-													line, 
-													columnStart,
-													columnEnd,
-													columnInterval,
-													gInputBufferPtr,
-													gOutputBufferPtr);
+				if (histogramLines.blockBufferPtr != NULL)
+					{
+					if (blockLineIndex >= blockLineCount)
+						{
+						blockLineCount = (lineEnd - line)/lineInterval + 1;
+						blockLineCount = MIN (blockLineCount, numberBlockLines);
+						
+						errCode = GetLinesOfData (fileIOInstructionsPtr,
+															line,
+															blockLineCount,
+															lineInterval,
+															columnStart,
+															columnEnd,
+															columnInterval,
+															gInputBufferPtr,
+															histogramLines.blockBufferPtr,
+															histogramLines.lineBytes,
+															numberOutputSamplesPtr);
+						
+						if (errCode == noErr)
+							{
+							histogramLines.numberLines = blockLineCount;
+							RunTasksInParallel (histogramLines.numberLineRanges * 
+																histogramLines.numberChannelGroups,
+														ComputeHistogramLinesTask,
+														&histogramLines);
+							
+							}	// end "if (errCode == noErr)"
+						
+						blockLineIndex = 0;
+						
+						}	// end "if (blockLineIndex >= blockLineCount)"
+						
+					blockLineIndex++;
+					
+					}	// end "if (histogramLines.blockBufferPtr != NULL)"
+					
+				else	// histogramLines.blockBufferPtr == NULL
+					errCode = GetLineOfData (fileIOInstructionsPtr,
+														line, 
+														columnStart,
+														columnEnd,
+														columnInterval,
+														gInputBufferPtr,
+														gOutputBufferPtr);
 
 				if (errCode != noErr)
 					{			
+					CheckAndDisposePtr ((Ptr)histogramLines.rangeSummaryPtr);
+					CheckAndDisposePtr ((Ptr)histogramLines.blockBufferPtr);
 					gConvertSignedDataFlag = FALSE;	
 					histogramSpecsPtr->loadedFlag = FALSE;					
 																							return (FALSE);
@@ -822,7 +1149,7 @@ Boolean ComputeHistogram (
 				medianArrayChanPtr = savedHistogramArrayPtr;
 						
 				for (channel=0; 
-						channel<imageFileNumberChannels; 
+						channel<lineNumberChannels; 
 						channel++)
 					{
 					chanIndex = channelListPtr[channelOffset+channel];
@@ -1038,6 +1365,8 @@ Boolean ComputeHistogram (
 					{
 					if (!CheckSomeEvents (osMask+keyDownMask+updateMask+mDownMask+mUpMask))
 						{
+						CheckAndDisposePtr ((Ptr)histogramLines.rangeSummaryPtr);
+						CheckAndDisposePtr ((Ptr)histogramLines.blockBufferPtr);
 						histogramSpecsPtr->loadedFlag = FALSE;			
 						gConvertSignedDataFlag = FALSE;	
 																						return (FALSE);
@@ -1081,6 +1410,59 @@ Boolean ComputeHistogram (
 				gStatusGraphicsRight += gStatusBoxIncrement;
 
 				}	// end "line=lineStart; ..."
+				
+			if (histogramLines.rangeSummaryPtr != NULL)
+				{
+						// Add the bins and summary values for the other line ranges to
+						// those for the histogram in line range order.
+						
+				rangeSummaryPtr = histogramLines.rangeSummaryPtr;
+				rangeArrayPtr = histogramLines.rangeArrayPtr;
+				for (lineRange=1; 
+						lineRange<histogramLines.numberLineRanges; 
+						lineRange++)
+					{
+					if (computeCode & 0x0001)
+						{
+						for (channel=0; channel<imageFileNumberChannels; channel++)
+							{
+							chanIndex = channelListPtr[channelOffset+channel];
+							
+							AddHistogramLimitValues (&histogramSummaryPtr[chanIndex],
+																rangeSummaryPtr->maxNonSatValue,
+																rangeSummaryPtr->minNonSatValue);
+							
+							AddHistogramLimitValues (&histogramSummaryPtr[chanIndex],
+																rangeSummaryPtr->maxValue,
+																rangeSummaryPtr->minValue);
+																
+							histogramSummaryPtr[chanIndex].averageValue += 
+																	rangeSummaryPtr->averageValue;
+							histogramSummaryPtr[chanIndex].stdDeviation += 
+																	rangeSummaryPtr->stdDeviation;
+							
+							rangeSummaryPtr++;
+							
+							}	// end "for (channel=0; channel<..."
+						
+						}	// end "if (computeCode & 0x0001)"
+						
+					if (rangeArrayPtr != NULL)
+						{
+						for (index=0; index<histogramLines.numberRangeBins; index++)
+							savedHistogramArrayPtr[index] += rangeArrayPtr[index];
+							
+						rangeArrayPtr += histogramLines.numberRangeBins;
+						
+						}	// end "if (rangeArrayPtr != NULL)"
+					
+					}	// end "for (lineRange=1; lineRange<..."
+				
+				CheckAndDisposePtr ((Ptr)histogramLines.rangeSummaryPtr);
+				
+				}	// end "if (histogramLines.rangeSummaryPtr != NULL)"
+				
+			CheckAndDisposePtr ((Ptr)histogramLines.blockBufferPtr);
 	
 			CloseUpFileIOInstructions (fileIOInstructionsPtr, NULL);	
 				
@@ -1342,6 +1724,219 @@ Boolean ComputeHistogram (
 
 }	// end "ComputeHistogram" 
 
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void ComputeHistogramLinesTask
+//
+//	Software purpose:	The purpose of this routine is to compute the histogram
+//							statistics for the channels in one channel group for one
+//							range of lines in the block of lines that has been read. The 
+//							values are counted in the same way as in ComputeHistogram.
+//							It may run in a worker thread; only the bins and summaries
+//							for the channels in the group and the line range are changed.
+//
+//	Parameters in:		Pointer to the histogram lines structure.
+//							Index of the task.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None
+//
+// Called By:			RunTasksInParallel in SThreads.cpp
+
+void ComputeHistogramLinesTask (
+				void*									taskInfoPtr,
+				UInt32								task)
+
+{
+	double								binFactor,
+											doubleDataValue,
+											maxNonSatValue,
+											minNonSatValue;
+	
+	HistogramLinesPtr					histogramLinesPtr;
+	HistogramSummaryPtr				histogramSummaryPtr;
+	HDoublePtr							ioDoublePtr;
+	HSInt32Ptr							ioBuffer4Ptr;
+	HUCharPtr							bufferPtr;
+	HUInt32Ptr							medianArrayChanPtr;
+	
+	SInt32								binIndex,
+											dataValue,
+											maxBinIndex;
+	
+	UInt32								channel,
+											channelGroup,
+											firstLineIndex,
+											index,
+											lastLineIndex,
+											lineIndex,
+											lineRange,
+											numberSamples;
+	
+	SInt16								binType,
+											chanIndex,
+											computeCode;
+	
+	
+	histogramLinesPtr = (HistogramLinesPtr)taskInfoPtr;
+	
+	channelGroup = task % histogramLinesPtr->numberChannelGroups;
+	lineRange = task / histogramLinesPtr->numberChannelGroups;
+	
+	computeCode = histogramLinesPtr->computeCode;
+	numberSamples = histogramLinesPtr->numberSamples;
+	
+			// Get the range of lines in the block for this task.
+			
+	firstLineIndex = (UInt32)((UInt64)histogramLinesPtr->numberLines * lineRange / 
+															histogramLinesPtr->numberLineRanges);
+	lastLineIndex = (UInt32)((UInt64)histogramLinesPtr->numberLines * (lineRange+1) / 
+															histogramLinesPtr->numberLineRanges);
+	
+	for (channel=channelGroup; 
+			channel<histogramLinesPtr->numberChannels; 
+			channel+=histogramLinesPtr->numberChannelGroups)
+		{
+		chanIndex = histogramLinesPtr->channelListPtr[channel];
+		
+		if (lineRange == 0)
+			{
+			histogramSummaryPtr = &histogramLinesPtr->histogramSummaryPtr[chanIndex];
+			medianArrayChanPtr = histogramLinesPtr->histogramArrayPtr;
+			
+			}	// end "if (lineRange == 0)"
+			
+		else	// lineRange > 0
+			{
+			histogramSummaryPtr = &histogramLinesPtr->rangeSummaryPtr[
+								(lineRange-1) * histogramLinesPtr->numberChannels + channel];
+								
+			medianArrayChanPtr = histogramLinesPtr->rangeArrayPtr;
+			if (medianArrayChanPtr != NULL)
+				medianArrayChanPtr = &medianArrayChanPtr[
+										(lineRange-1) * histogramLinesPtr->numberRangeBins];
+			
+			}	// end "else lineRange > 0"
+		
+		if (medianArrayChanPtr != NULL && (computeCode & 0x0002))
+			medianArrayChanPtr = &medianArrayChanPtr[
+												channel * histogramLinesPtr->maxNumberBins];
+		
+		binFactor = histogramSummaryPtr->binFactor;
+		binType = histogramSummaryPtr->binType;
+		minNonSatValue = histogramSummaryPtr->minNonSatValue;
+		maxNonSatValue = histogramSummaryPtr->maxNonSatValue;
+		maxBinIndex = histogramSummaryPtr->numberBins - 1;
+		
+		for (lineIndex=firstLineIndex; lineIndex<lastLineIndex; lineIndex++)
+			{
+			bufferPtr = &histogramLinesPtr->blockBufferPtr[
+														lineIndex * histogramLinesPtr->lineBytes];
+			
+			if (histogramLinesPtr->integerFlag)
+				{
+				ioBuffer4Ptr = (HSInt32Ptr)bufferPtr;
+				
+				if (histogramLinesPtr->BISFlag)
+					ioBuffer4Ptr = &ioBuffer4Ptr[chanIndex];
+			
+				else	// !histogramLinesPtr->BISFlag
+					ioBuffer4Ptr = &ioBuffer4Ptr[channel*numberSamples];
+			
+				for (index=0; index<numberSamples; index+=histogramLinesPtr->interval)
+					{
+					dataValue = ioBuffer4Ptr[index];
+					
+					if (computeCode & 0x0001)
+						{
+						AddHistogramLimitValues (histogramSummaryPtr, dataValue, dataValue);
+						
+						histogramSummaryPtr->averageValue += (double)dataValue;
+						histogramSummaryPtr->stdDeviation += 
+															(double)dataValue * (double)dataValue;
+						
+						if (medianArrayChanPtr != NULL)	
+							medianArrayChanPtr[dataValue]++;
+						
+						}	// end "if (computeCode & 0x0001)"
+						
+					else if (computeCode & 0x0002)
+						{
+						if (binType == kDataValueIsBinIndex)
+							binIndex = dataValue;
+							
+						else if (dataValue < minNonSatValue)
+							binIndex = 0;
+							
+						else if (dataValue > maxNonSatValue)
+							binIndex = maxBinIndex;
+						
+						else if (binType == kBinWidthOfOne)
+							binIndex = (SInt32)(dataValue - minNonSatValue + 1);
+						
+						else	// binType == kBinWidthNotOne
+							binIndex = (SInt32)((dataValue - minNonSatValue)*binFactor + 1);
+							
+						binIndex = MAX (0, binIndex);
+						binIndex = MIN (binIndex, maxBinIndex);
+							
+						medianArrayChanPtr[binIndex]++;
+						
+						}	// end "else if (computeCode & 0x0002)"
+					
+					}	// end "for (index=0; index<numberSamples; ..."
+				
+				}	// end "if (histogramLinesPtr->integerFlag)"
+				
+			else if (computeCode & 0x0002)
+				{
+				ioDoublePtr = (HDoublePtr)bufferPtr;
+				
+				if (histogramLinesPtr->BISFlag)
+					ioDoublePtr = &ioDoublePtr[chanIndex];
+			
+				else	// !histogramLinesPtr->BISFlag
+					ioDoublePtr = &ioDoublePtr[channel*numberSamples];
+			
+				for (index=0; index<numberSamples; index+=histogramLinesPtr->interval)
+					{
+					doubleDataValue = ioDoublePtr[index];
+					
+					if (binType == kDataValueIsBinIndex)
+						binIndex = (UInt32)doubleDataValue;
+						
+					else if (doubleDataValue < minNonSatValue)
+						binIndex = 0;
+						
+					else if (doubleDataValue > maxNonSatValue)
+						binIndex = maxBinIndex;
+					
+					else if (binType == kBinWidthOfOne)
+						binIndex = (SInt32)(doubleDataValue - minNonSatValue + 1);
+					
+					else	// binType == kBinWidthNotOne
+						binIndex = (SInt32)(
+										(doubleDataValue - minNonSatValue)*binFactor + 1);
+						
+					binIndex = MAX (0, binIndex);
+					binIndex = MIN (binIndex, maxBinIndex);
+						
+					medianArrayChanPtr[binIndex]++;
+					
+					}	// end "for (index=0; index<numberSamples; ..."
+				
+				}	// end "else if (computeCode & 0x0002)"
+			
+			}	// end "for (lineIndex=firstLineIndex; ..."
+		
+		}	// end "for (channel=channelGroup; ..."
+	
+}	// end "ComputeHistogramLinesTask"
+
 	
 	
 //------------------------------------------------------------------------------------
@@ -1407,8 +2002,10 @@ UInt32 CountTotalNumberHistogramPixels (
 //
 //	Function name:		Boolean CreateSTASupportFile
 //
-//	Software purpose:	This routine creates an ERDAS statistics file.
-//							Some of the fields in the .STA file are specific for MultiSpec
+//	Software purpose:	This routine creates an ERDAS statistics file or a MultiSpec
+//							binary statistics file if gWriteBinarySTAFileFlag is set (see
+//							WriteBinarySTASupportFile). The ERDAS histograms are compacted
+//							to 256 bins. Some of the fields in the .STA file are specific for MultiSpec
 // 						so that the .STA file can handle the statistics for image files
 //							with more than 8 bits per data value. ERDAS Imagine will not 
 //							read these files correctly. The new fields are (0-based):
@@ -1665,6 +2262,17 @@ Boolean CreateSTASupportFile (
 		if (!histogramSpecsPtr->allChannelsAtOnceFlag)
 			channelEnd = channelIndex + 1;
 			
+		if (gWriteBinarySTAFileFlag)
+			{
+			continueFlag = WriteBinarySTASupportFile (histogramSpecsPtr,
+																	supportFileStreamPtr,
+																	medianArrayPtr,
+																	channelIndex,
+																	channelEnd);
+																				return (continueFlag);
+																				
+			}	// end "if (gWriteBinarySTAFileFlag)"
+			
 				// Set up swap bytes flag depending upon the system architecture.
 				
 		gSwapBytesFlag = gBigEndianFlag;
@@ -2517,64 +3125,7 @@ Boolean DecodeSTASupportFile (
 															
 				}	// end "else if (versionCode == 3)"
 					
-					// Make sure that the number of bins make sense relative to the data
-					// itself.  We want to catch case when .sta file is for another image
-					// which may have more data bins than the image that the .sta file is
-					// being loaded for.
-					
-			histogramSummaryPtr[channel].numberBins = 
-											MIN (histogramSpecsPtr->maxNumberBins, 
-													histogramSummaryPtr[channel].numberBins);
-		
-					// Update summary data if it is of the older format.				
-					
-			if (histogramSummaryPtr[channel].maxNonSatValue == SInt32_MAX)
-				histogramSummaryPtr[channel].maxNonSatValue = 
-														histogramSummaryPtr[channel].maxValue;
-			
-			double  minLimitValue = (double)(0 - 2147483647); // SInt32_MIN;
-			if (histogramSummaryPtr[channel].minNonSatValue == minLimitValue)
-				histogramSummaryPtr[channel].minNonSatValue = 
-														histogramSummaryPtr[channel].minValue;
-														
-					// Get the bin width factor.
-					// Bin width is 1 for kDataValueIsBinIndex and kDataValueIsBinIndex
-			
-			histogramSummaryPtr[channel].binFactor = 1; 
-			if (histogramSummaryPtr[channel].binType == kBinWidthNotOne &&
-						(histogramSummaryPtr[channel].maxNonSatValue - 
-												histogramSummaryPtr[channel].minNonSatValue) > 0)
-				histogramSummaryPtr[channel].binFactor = 
-						(double)(histogramSummaryPtr[channel].numberBins-3)/
-					 			(histogramSummaryPtr[channel].maxNonSatValue - 
-					 								histogramSummaryPtr[channel].minNonSatValue);
-																											
-					// Get the number of decimal digits to use when listing data
-					// values.
-			
-			GetNumberDecimalDigits (gImageFileInfoPtr->dataTypeCode,
-											histogramSummaryPtr[channel].minValue,
-											histogramSummaryPtr[channel].maxValue,
-											1/histogramSummaryPtr[channel].binFactor,
-											&histogramSummaryPtr[channel].numberEDecimalDigits,
-											&histogramSummaryPtr[channel].numberFDecimalDigits);
-				
-			gImageFileInfoPtr->maxNumberEDecimalDigits = 
-										MAX (gImageFileInfoPtr->maxNumberEDecimalDigits,
-												histogramSummaryPtr[channel].numberEDecimalDigits);
-				
-			gImageFileInfoPtr->maxNumberFDecimalDigits = 
-										MAX (gImageFileInfoPtr->maxNumberFDecimalDigits,
-												histogramSummaryPtr[channel].numberFDecimalDigits);
-					 								
-			gImageFileInfoPtr->maxDataValue = 
-										MAX (gImageFileInfoPtr->maxDataValue,
-													histogramSummaryPtr[channel].maxValue);
-			gImageFileInfoPtr->minDataValue = 
-								MIN (gImageFileInfoPtr->minDataValue,
-										histogramSummaryPtr[channel].minValue);
-											
-			histogramSummaryPtr[channel].availableFlag = TRUE;
+			SetHistogramSummaryDerivedValues (histogramSpecsPtr, channel);
 				
 			}	// end "if (summaryFlag)" 
 				
@@ -4278,6 +4829,8 @@ Boolean GetHistogramVectorForChannel (
 				SInt16								numberChannels)
 
 {
+	BinarySTAHeader					binarySTAHeader;
+	
 	CMFileStream						*supportFileStreamPtr;
 											
 	UInt32								currentLayerChannel;
@@ -4316,22 +4869,37 @@ Boolean GetHistogramVectorForChannel (
 	else	// windowInfoPtr->numberImageFiles != 1 || ...
 		{
 		supportFileStreamPtr = GetActiveSupportFileStreamPointer (&handleStatus);
-	
-		continueFlag = ReadSTASupportFile (histogramSpecsPtr->statBufferPtr,
-														supportFileStreamPtr,
-														channelListPtr, 
-														numberChannels, 
-														FALSE);
 		
-				// Decode the statistics file histogram values for the channel.				
-	
-		if (continueFlag)	
-			continueFlag = DecodeSTASupportFile (histogramSpecsPtr,
-																histogramSpecsPtr->histogramArrayPtr,
-																supportFileStreamPtr,
-																channelListPtr, 
-																numberChannels,
-																FALSE);
+		if (ReadBinarySTAHeader (supportFileStreamPtr, &binarySTAHeader))
+			continueFlag = ReadBinarySTASupportFile (
+															histogramSpecsPtr,
+															histogramSpecsPtr->histogramArrayPtr,
+															supportFileStreamPtr,
+															&binarySTAHeader,
+															channelListPtr, 
+															numberChannels,
+															FALSE);
+		
+		else	// !ReadBinarySTAHeader (...
+			{
+			continueFlag = ReadSTASupportFile (histogramSpecsPtr->statBufferPtr,
+															supportFileStreamPtr,
+															channelListPtr, 
+															numberChannels, 
+															FALSE);
+			
+					// Decode the statistics file histogram values for the channel.				
+		
+			if (continueFlag)	
+				continueFlag = DecodeSTASupportFile (
+															histogramSpecsPtr,
+															histogramSpecsPtr->histogramArrayPtr,
+															supportFileStreamPtr,
+															channelListPtr, 
+															numberChannels,
+															FALSE);
+																
+			}	// end "else !ReadBinarySTAHeader (..."
 		
 		}	// end "else windowInfoPtr->numberImageFiles != 1 || ..."
 						
@@ -4347,7 +4915,7 @@ Boolean GetHistogramVectorForChannel (
 //	Function name:		Boolean GetSTASupportFile
 //
 //	Software purpose:	This routine allows the user to select the ERDAS 
-//							statistics file.
+//							or MultiSpec binary statistics file.
 //
 //	Parameters in:					
 //
@@ -4364,6 +4932,8 @@ Boolean GetSTASupportFile (
 				FileInfoPtr							fileInfoPtr)
 
 {
+	BinarySTAHeader					binarySTAHeader;
+	
 	CMFileStream						savedSupportFileStream;
 	
 	SInt64								fileSize;
@@ -4380,7 +4950,8 @@ Boolean GetSTASupportFile (
 											numberFileTypes,
 											stringCompare;
 											
-	Boolean								continueFlag;
+	Boolean								binarySTAFileFlag,
+											continueFlag;
 	
 	SignedByte							supportHandleStatus;
 	
@@ -4458,6 +5029,21 @@ Boolean GetSTASupportFile (
 						
 					}	// end "if (continueFlag)" 
 					
+						// The file may also be a MultiSpec binary statistics file. It
+						// needs to have the information for all of the channels.
+				
+				binarySTAFileFlag = FALSE;
+				if (continueFlag && stringCompare != 0 &&
+								ReadBinarySTAHeader (supportFileStreamPtr, &binarySTAHeader))
+					{
+					binarySTAFileFlag = TRUE;
+					stringCompare = 0;
+					if (binarySTAHeader.numberChannels < 
+										(UInt32)gImageWindowInfoPtr->totalNumberChannels)
+						stringCompare = -1;
+					
+					}	// end "if (continueFlag && stringCompare != 0 && ..."
+					
 				if (stringCompare != 0 && fileInfoPtr->format == kImagineType)
 					{
 							// The selected file may still be okay if the image file type is Imagine
@@ -4471,7 +5057,7 @@ Boolean GetSTASupportFile (
 					
 					}	// end "if (stringCompare != 0 && fileInfoPtr->format == ..."
 					
-				if (stringCompare == 0)
+				if (stringCompare == 0 && !binarySTAFileFlag)
 					{
 							// Make certain that the file is of the correct size.		
 					
@@ -4481,7 +5067,7 @@ Boolean GetSTASupportFile (
 										(UInt32)gImageWindowInfoPtr->totalNumberChannels*9*128)
 						stringCompare = -1;
 					
-					}	// end "if (stringCompare == 0)" 
+					}	// end "if (stringCompare == 0 && !binarySTAFileFlag)" 
 							
 						// Beep to alert user that file is not an image 				
 						// statistics file that matches the image parameters.			
@@ -8494,6 +9080,8 @@ Boolean LoadSTASupportFile (
 				Boolean								summaryFlag)
 
 {
+	BinarySTAHeader					binarySTAHeader;
+	
 	HCharPtr								statBufferPtr;
 	HistogramSummaryPtr				histogramSummaryPtr;
 	
@@ -8596,37 +9184,61 @@ Boolean LoadSTASupportFile (
 			}	// end "else !...->histogramSpecs.allChannelsAtOnceFlag" 
 			
 		histogramSummaryPtr = histogramSpecsPtr->histogramSummaryPtr;
-			
-		for (channel=channelIndex; 
-				channel<numberChannelLoops; 
-				channel++)
+		
+				// The information for the channels in a MultiSpec binary statistics
+				// file can be read directly.
+		
+		if (ReadBinarySTAHeader (supportFileStreamPtr, &binarySTAHeader))
 			{
-			lChannelListPtr = &channelListPtr[channel];
-			
-			continueFlag = ReadSTASupportFile (statBufferPtr, 
-															supportFileStreamPtr,
-															lChannelListPtr, 
-															(SInt16)numberChannels, 
-															readAllChannelsAtOneTimeFlag);
-			
-			localHistoArrayPtr = histogramArrayPtr;
-			if (histogramArrayPtr)
-				localHistoArrayPtr = &histogramArrayPtr[channelOffsetCount];
-			
-			if (continueFlag)
-				continueFlag = DecodeSTASupportFile (histogramSpecsPtr,
-																	localHistoArrayPtr, 
+			numberChannels = 1;
+			if (histogramSpecsPtr->allChannelsAtOnceFlag)
+				numberChannels = histogramSpecsPtr->numberChannels - channelIndex;
+				
+			continueFlag = ReadBinarySTASupportFile (histogramSpecsPtr,
+																	histogramArrayPtr,
 																	supportFileStreamPtr,
-																	lChannelListPtr, 
+																	&binarySTAHeader,
+																	&channelListPtr[channelIndex], 
 																	(SInt16)numberChannels,
 																	summaryFlag);
 			
-			if (!continueFlag)
-				break;
+			}	// end "if (ReadBinarySTAHeader (..."
+			
+		else	// !ReadBinarySTAHeader (...
+			{
+			for (channel=channelIndex; 
+					channel<numberChannelLoops; 
+					channel++)
+				{
+				lChannelListPtr = &channelListPtr[channel];
 				
-			channelOffsetCount += histogramSpecsPtr->maxNumberBins;
+				continueFlag = ReadSTASupportFile (statBufferPtr, 
+																supportFileStreamPtr,
+																lChannelListPtr, 
+																(SInt16)numberChannels, 
+																readAllChannelsAtOneTimeFlag);
+				
+				localHistoArrayPtr = histogramArrayPtr;
+				if (histogramArrayPtr)
+					localHistoArrayPtr = &histogramArrayPtr[channelOffsetCount];
+				
+				if (continueFlag)
+					continueFlag = DecodeSTASupportFile (histogramSpecsPtr,
+																		localHistoArrayPtr, 
+																		supportFileStreamPtr,
+																		lChannelListPtr, 
+																		(SInt16)numberChannels,
+																		summaryFlag);
+				
+				if (!continueFlag)
+					break;
+					
+				channelOffsetCount += histogramSpecsPtr->maxNumberBins;
+					
+				}	// end "for (channel=0; ..." 
 				
-			}	// end "for (channel=0; ..." 
+			}	// end "else !ReadBinarySTAHeader (..."
+
 			
 		if (channelIndex == 0)
 			{
@@ -8755,6 +9367,321 @@ CMFileStream* OpenSupportFile (void)
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 ReadBinarySTAData
+//
+//	Software purpose:	This routine copies the requested bytes from a MultiSpec 
+//							binary statistics (.sta) file. The bytes are copied from the
+//							memory mapping of the file if it has been mapped; otherwise
+//							they are read from the file.
+//
+//	Parameters in:		File stream pointer for the statistics file.
+//							Offset of the bytes in the file.
+//							Number of bytes to be copied.
+//
+//	Parameters out:	Buffer the bytes are copied to.
+//
+//	Value Returned:	noErr if the bytes were copied. An error code if not.
+//
+// Called By:			ReadBinarySTAHeader in SHistogram.cpp
+//							ReadBinarySTASupportFile in SHistogram.cpp
+
+SInt16 ReadBinarySTAData (
+				CMFileStream*						supportFileStreamPtr, 
+				SInt64								fileOffset, 
+				UInt32								numberBytes,
+				HPtr									bufferPtr,
+				SInt16								messageCode)
+
+{
+	UInt32								count;
+	
+	SInt16								errCode;
+	
+	
+	#if defined multispec_wx
+		HUCharPtr							mappedDataPtr;
+		
+		
+		mappedDataPtr = supportFileStreamPtr->GetMappedDataPointer (fileOffset, 
+																						numberBytes);
+		if (mappedDataPtr != NULL)
+			{
+			BlockMoveData (mappedDataPtr, bufferPtr, numberBytes);
+																					return (noErr);
+																					
+			}	// end "if (mappedDataPtr != NULL)"
+	#endif	// defined multispec_wx
+	
+	errCode = MSetMarker (supportFileStreamPtr, fsFromStart, fileOffset, messageCode);
+	
+	if (errCode == noErr)
+		{
+		count = numberBytes;
+		errCode = MReadData (supportFileStreamPtr, &count, bufferPtr, messageCode);
+		
+		}	// end "if (errCode == noErr)"
+		
+	return (errCode);
+	
+}	// end "ReadBinarySTAData"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean ReadBinarySTAHeader
+//
+//	Software purpose:	This routine determines whether the statistics (.sta) file is
+//							in the MultiSpec binary format and if so reads the header
+//							information. The file is then memory mapped if possible so
+//							that only the information for the channels that are requested
+//							is brought into memory.
+//
+//	Parameters in:		File stream pointer for the statistics file.
+//
+//	Parameters out:	Header information for the file.
+//
+//	Value Returned:	TRUE if the file is a MultiSpec binary statistics file.
+//							FALSE if not; the file is then expected to be in the ERDAS 74 
+//								format.
+//
+// Called By:			GetHistogramVectorForChannel in SHistogram.cpp
+//							GetSTASupportFile in SHistogram.cpp
+//							LoadSTASupportFile in SHistogram.cpp
+
+Boolean ReadBinarySTAHeader (
+				CMFileStream*						supportFileStreamPtr,
+				BinarySTAHeaderPtr				binarySTAHeaderPtr)
+
+{
+	char									headerBuffer[kBinarySTAHeaderBytes];
+	
+	SInt64								fileSize;
+	
+	SInt16								errCode;
+	
+	
+	if (supportFileStreamPtr == NULL)
+																					return (FALSE);
+	
+	errCode = ReadBinarySTAData (supportFileStreamPtr, 
+											0, 
+											kBinarySTAHeaderBytes, 
+											headerBuffer,
+											kNoErrorMessages);
+	
+	if (errCode != noErr || 
+							strncmp (headerBuffer, kBinarySTAIdentifier, 8) != 0)
+																					return (FALSE);
+	
+			// The values in the file are in little endian byte order.
+			
+	gSwapBytesFlag = gBigEndianFlag;
+	
+	if (GetLongIntValue (&headerBuffer[8]) > kBinarySTAVersion)
+																					return (FALSE);
+																					
+	binarySTAHeaderPtr->numberChannels = (UInt32)GetLongIntValue (&headerBuffer[12]);
+	binarySTAHeaderPtr->maxNumberBins = (UInt32)GetLongIntValue (&headerBuffer[16]);
+	binarySTAHeaderPtr->numberChannelBytes = 
+												(UInt32)GetLongIntValue (&headerBuffer[20]);
+	binarySTAHeaderPtr->totalPixels = GetLongInt64Value (&headerBuffer[24]);
+	
+	if (binarySTAHeaderPtr->numberChannelBytes !=
+						kBinarySTAChannelHeaderBytes + 4 * binarySTAHeaderPtr->maxNumberBins)
+																					return (FALSE);
+	
+			// Make certain that the file has the information for all of the
+			// channels.
+			
+	errCode = GetSizeOfFile (supportFileStreamPtr, &fileSize);
+	if (errCode != noErr || fileSize < kBinarySTAHeaderBytes + 
+						(SInt64)binarySTAHeaderPtr->numberChannels * 
+												binarySTAHeaderPtr->numberChannelBytes)
+																					return (FALSE);
+	
+	#if defined multispec_wx
+		if (gUseMemoryMappedIOFlag)
+			supportFileStreamPtr->MMapFile ();
+	#endif	// defined multispec_wx
+		
+	return (TRUE);
+		
+}	// end "ReadBinarySTAHeader"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean ReadBinarySTASupportFile
+//
+//	Software purpose:	This routine loads the summary information and the histogram
+//							for the requested channels from a MultiSpec binary statistics
+//							(.sta) file. The information for each channel is at a fixed
+//							location in the file so only the channels requested are read.
+//							The full histogram is stored so no decompaction is needed.
+//
+//	Parameters in:		Pointer to the histogram specifications structure.
+//							File stream pointer for the statistics file.
+//							Header information for the statistics file.
+//							List of channels to be loaded.
+//							Number of channels in the list.
+//							Flag indicating whether the summary information is to be
+//								loaded.
+//
+//	Parameters out:	Histogram array for the channels. If NULL, only the summary
+//								information is loaded.
+//
+//	Value Returned:	TRUE if the information was loaded. FALSE if not.
+//
+// Called By:			GetHistogramVectorForChannel in SHistogram.cpp
+//							LoadSTASupportFile in SHistogram.cpp
+
+Boolean ReadBinarySTASupportFile (
+				HistogramSpecsPtr					histogramSpecsPtr, 
+				HUInt32Ptr							histogramArrayPtr, 
+				CMFileStream*						supportFileStreamPtr,
+				BinarySTAHeaderPtr				binarySTAHeaderPtr,
+				UInt16*								channelListPtr, 
+				SInt16								numberChannels, 
+				Boolean								summaryFlag)
+
+{
+	char									channelHeaderBuffer[kBinarySTAChannelHeaderBytes];
+	
+	HistogramSummaryPtr				histogramSummaryPtr;
+	
+	SInt64								channelOffset;
+	
+	SInt32								signedValueOffset;
+	
+	UInt32								binIndex,
+											numberBins;
+	
+	SInt16								channel,
+											errCode,
+											index;
+	
+	
+	if (supportFileStreamPtr == NULL ||
+				histogramSpecsPtr == NULL ||
+						channelListPtr == NULL)
+																					return (FALSE);
+																					
+	if (!summaryFlag && histogramArrayPtr == NULL)
+																					return (FALSE);
+	
+	signedValueOffset = gImageFileInfoPtr->signedValueOffset;
+	histogramSummaryPtr = histogramSpecsPtr->histogramSummaryPtr;
+	
+	if (summaryFlag)
+		{
+		gImageFileInfoPtr->maxNumberEDecimalDigits = 0;
+		gImageFileInfoPtr->maxNumberFDecimalDigits = 0;
+		gImageFileInfoPtr->maxDataValue = -DBL_MAX;
+		gImageFileInfoPtr->minDataValue = DBL_MAX;
+		
+		if (histogramSpecsPtr->totalPixels == 0)
+			histogramSpecsPtr->totalPixels = binarySTAHeaderPtr->totalPixels;
+		
+		}	// end "if (summaryFlag)"
+			
+			// The values in the file are in little endian byte order.
+			
+	gSwapBytesFlag = gBigEndianFlag;
+	
+	for (index=0; index<numberChannels; index++)
+		{
+		channel = channelListPtr[index];
+		if ((UInt32)channel >= binarySTAHeaderPtr->numberChannels)
+																					return (FALSE);
+		
+		channelOffset = kBinarySTAHeaderBytes + 
+								(SInt64)channel * binarySTAHeaderPtr->numberChannelBytes;
+		
+		errCode = ReadBinarySTAData (supportFileStreamPtr, 
+												channelOffset, 
+												kBinarySTAChannelHeaderBytes, 
+												channelHeaderBuffer,
+												kErrorMessages);
+		if (errCode != noErr)
+																					return (FALSE);
+		
+		numberBins = (UInt32)GetLongIntValue (&channelHeaderBuffer[0]);
+		numberBins = MIN (numberBins, binarySTAHeaderPtr->maxNumberBins);
+		
+				// The file may have been created with more bins than are allowed
+				// for the histogram array of the current image.
+				
+		numberBins = MIN (numberBins, histogramSpecsPtr->maxNumberBins);
+		
+		if (summaryFlag)
+			{
+			histogramSummaryPtr[channel].numberBins = numberBins;
+			histogramSummaryPtr[channel].binType = 
+												GetShortIntValue (&channelHeaderBuffer[4]);
+			histogramSummaryPtr[channel].badValues = 
+												GetLongIntValue (&channelHeaderBuffer[8]);
+			
+			histogramSummaryPtr[channel].maxValue = GetDoubleValue (
+						(UCharPtr)&channelHeaderBuffer[16]) - signedValueOffset;
+			histogramSummaryPtr[channel].maxNonSatValue = GetDoubleValue (
+						(UCharPtr)&channelHeaderBuffer[24]) - signedValueOffset;
+			histogramSummaryPtr[channel].minValue = GetDoubleValue (
+						(UCharPtr)&channelHeaderBuffer[32]) - signedValueOffset;
+			histogramSummaryPtr[channel].minNonSatValue = GetDoubleValue (
+						(UCharPtr)&channelHeaderBuffer[40]) - signedValueOffset;
+			histogramSummaryPtr[channel].averageValue = GetDoubleValue (
+						(UCharPtr)&channelHeaderBuffer[48]) - signedValueOffset;
+			histogramSummaryPtr[channel].medianValue = GetDoubleValue (
+						(UCharPtr)&channelHeaderBuffer[56]) - signedValueOffset;
+			histogramSummaryPtr[channel].stdDeviation = GetDoubleValue (
+						(UCharPtr)&channelHeaderBuffer[64]);
+						
+			SetHistogramSummaryDerivedValues (histogramSpecsPtr, channel);
+				
+			}	// end "if (summaryFlag)" 
+			
+				// Copy the histogram for the channel.
+		
+		if (histogramArrayPtr != NULL)
+			{
+			numberBins = MIN (numberBins, histogramSummaryPtr[channel].numberBins);
+			
+			errCode = ReadBinarySTAData (
+										supportFileStreamPtr, 
+										channelOffset + kBinarySTAChannelHeaderBytes, 
+										4 * numberBins, 
+										(HPtr)histogramArrayPtr,
+										kErrorMessages);
+			if (errCode != noErr)
+																					return (FALSE);
+			
+			if (gSwapBytesFlag)
+				SwapBytes (4, (HUInt8Ptr)histogramArrayPtr, numberBins);
+				
+			for (binIndex=numberBins; 
+					binIndex<histogramSummaryPtr[channel].numberBins; 
+					binIndex++)
+				histogramArrayPtr[binIndex] = 0;
+				
+			histogramArrayPtr += histogramSpecsPtr->maxNumberBins;
+				
+			}	// end "if (histogramArrayPtr != NULL)" 
+		
+		}	// end "for (index=0; index<numberChannels; index++)" 
+		
+	return (TRUE);
+			
+}	// end "ReadBinarySTASupportFile"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -8959,6 +9886,102 @@ void SetHistogramLineColumnSpecs (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void SetHistogramSummaryDerivedValues
+//
+//	Software purpose:	The purpose of this routine is to set the values in the 
+//							histogram summary structure for the input channel that are
+//							derived from those read from an image statistics file and to
+//							update the data value limits for the image file.
+//
+//	Parameters in:		Pointer to the histogram specifications structure.
+//							Channel to be updated.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None	
+//
+// Called By:			DecodeSTASupportFile in SHistogram.cpp
+//							ReadBinarySTASupportFile in SHistogram.cpp
+
+void SetHistogramSummaryDerivedValues (
+				HistogramSpecsPtr					histogramSpecsPtr, 
+				SInt16								channel)
+
+{
+	double								minLimitValue;
+	
+	HistogramSummaryPtr				histogramSummaryPtr;
+	
+	
+	histogramSummaryPtr = histogramSpecsPtr->histogramSummaryPtr;
+	
+			// Make sure that the number of bins make sense relative to the data
+			// itself.  We want to catch case when .sta file is for another image
+			// which may have more data bins than the image that the .sta file is
+			// being loaded for.
+			
+	histogramSummaryPtr[channel].numberBins = 
+									MIN (histogramSpecsPtr->maxNumberBins, 
+											histogramSummaryPtr[channel].numberBins);
+
+			// Update summary data if it is of the older format.				
+			
+	if (histogramSummaryPtr[channel].maxNonSatValue == SInt32_MAX)
+		histogramSummaryPtr[channel].maxNonSatValue = 
+												histogramSummaryPtr[channel].maxValue;
+	
+	minLimitValue = (double)(0 - 2147483647); // SInt32_MIN;
+	if (histogramSummaryPtr[channel].minNonSatValue == minLimitValue)
+		histogramSummaryPtr[channel].minNonSatValue = 
+												histogramSummaryPtr[channel].minValue;
+												
+			// Get the bin width factor.
+			// Bin width is 1 for kDataValueIsBinIndex and kDataValueIsBinIndex
+	
+	histogramSummaryPtr[channel].binFactor = 1; 
+	if (histogramSummaryPtr[channel].binType == kBinWidthNotOne &&
+				(histogramSummaryPtr[channel].maxNonSatValue - 
+										histogramSummaryPtr[channel].minNonSatValue) > 0)
+		histogramSummaryPtr[channel].binFactor = 
+				(double)(histogramSummaryPtr[channel].numberBins-3)/
+			 			(histogramSummaryPtr[channel].maxNonSatValue - 
+			 								histogramSummaryPtr[channel].minNonSatValue);
+																									
+			// Get the number of decimal digits to use when listing data
+			// values.
+	
+	GetNumberDecimalDigits (gImageFileInfoPtr->dataTypeCode,
+									histogramSummaryPtr[channel].minValue,
+									histogramSummaryPtr[channel].maxValue,
+									1/histogramSummaryPtr[channel].binFactor,
+									&histogramSummaryPtr[channel].numberEDecimalDigits,
+									&histogramSummaryPtr[channel].numberFDecimalDigits);
+		
+	gImageFileInfoPtr->maxNumberEDecimalDigits = 
+								MAX (gImageFileInfoPtr->maxNumberEDecimalDigits,
+										histogramSummaryPtr[channel].numberEDecimalDigits);
+		
+	gImageFileInfoPtr->maxNumberFDecimalDigits = 
+								MAX (gImageFileInfoPtr->maxNumberFDecimalDigits,
+										histogramSummaryPtr[channel].numberFDecimalDigits);
+			 								
+	gImageFileInfoPtr->maxDataValue = 
+								MAX (gImageFileInfoPtr->maxDataValue,
+											histogramSummaryPtr[channel].maxValue);
+	gImageFileInfoPtr->minDataValue = 
+						MIN (gImageFileInfoPtr->minDataValue,
+								histogramSummaryPtr[channel].minValue);
+									
+	histogramSummaryPtr[channel].availableFlag = TRUE;
+
+	
+}	// end "SetHistogramSummaryDerivedValues"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -9263,3 +10286,226 @@ void UpdateSupportFileTypeSetting (
 		}	// end "if (FileExists (windowInfoPtr->supportFileStreamPtr))"
 		
 }	// end "UpdateSupportFileTypeSetting"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean WriteBinarySTASupportFile
+//
+//	Software purpose:	This routine writes the summary information and the full
+//							histogram for the requested channels to a MultiSpec binary
+//							statistics (.sta) file. The file header is written when the 
+//							first channel is written. The information for each channel is
+//							stored at a fixed location so that any channel can be read
+//							without reading the others. Values are stored in little endian
+//							byte order.
+//
+//								Bytes  0-  7: 'MSPECSTA'
+//								Bytes  8- 11: version
+//								Bytes 12- 15: number of channels
+//								Bytes 16- 19: number of bins stored for each channel
+//								Bytes 20- 23: number of bytes for each channel
+//								Bytes 24- 31: total number of values in the histogram
+//
+//							For each channel starting at byte 64:
+//								Bytes  0-  3: number of bins in original histogram
+//								Bytes  4-  5: bin type
+//								Bytes  8- 11: number of bad values
+//								Bytes 16- 23: maximum value (8-byte real)
+//								Bytes 24- 31: maximum non-saturated (8-byte real)
+//								Bytes 32- 39: minimum value (8-byte real)
+//								Bytes 40- 47: minimum non-saturated (8-byte real)
+//								Bytes 48- 55: average value (8-byte real)
+//								Bytes 56- 63: median value (8-byte real)
+//								Bytes 64- 71: standard deviation value (8-byte real)
+//								Bytes 96-   : histogram (4-byte integers)
+//
+//	Parameters in:		Pointer to the histogram specifications structure.
+//							File stream pointer for the statistics file.
+//							Histogram array for the channels. If NULL, the histograms are
+//								written as zeros.
+//							First channel to be written.
+//							Last channel to be written plus 1.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	TRUE if the information was written. FALSE if not.
+//
+// Called By:			CreateSTASupportFile in SHistogram.cpp
+
+Boolean WriteBinarySTASupportFile (
+				HistogramSpecsPtr					histogramSpecsPtr, 
+				CMFileStream*						supportFileStreamPtr,
+				HUInt32Ptr							medianArrayPtr, 
+				SInt16								channelStart,
+				SInt16								channelEnd)
+
+{
+	char									headerBuffer[kBinarySTAHeaderBytes];
+	
+	double								tempDoubleValue;
+	
+	HistogramSummaryPtr				histogramSummaryPtr;
+	HCharPtr								channelBufferPtr;
+	
+	SInt64								tempSInt64;
+	
+	SInt32								signedValueOffset,
+											tempSInt32;
+	
+	UInt32								count,
+											index,
+											maxNumberBins,
+											numberBins,
+											numberChannelBytes;
+	
+	SInt16								channel,
+											errCode = noErr,
+											tempSInt16;
+	
+	
+	histogramSummaryPtr = histogramSpecsPtr->histogramSummaryPtr;
+	signedValueOffset = gImageFileInfoPtr->signedValueOffset;
+	maxNumberBins = histogramSpecsPtr->maxNumberBins;
+	numberChannelBytes = kBinarySTAChannelHeaderBytes + 4 * maxNumberBins;
+	
+	channelBufferPtr = (HCharPtr)MNewPointerClear (numberChannelBytes);
+	if (channelBufferPtr == NULL)
+																					return (FALSE);
+	
+			// Store the values in little endian byte order.
+			
+	gSwapBytesFlag = gBigEndianFlag;
+	
+	if (channelStart == 0)
+		{
+		for (index=0; index<kBinarySTAHeaderBytes; index++)
+			headerBuffer[index] = 0;
+			
+		BlockMoveData ((char*)kBinarySTAIdentifier, headerBuffer, 8);
+		
+		tempSInt32 = kBinarySTAVersion;
+		tempSInt32 = GetLongIntValue ((char*)&tempSInt32);
+		BlockMoveData ((char*)&tempSInt32, &headerBuffer[8], 4);
+		
+		tempSInt32 = gImageWindowInfoPtr->totalNumberChannels;
+		tempSInt32 = GetLongIntValue ((char*)&tempSInt32);
+		BlockMoveData ((char*)&tempSInt32, &headerBuffer[12], 4);
+		
+		tempSInt32 = (SInt32)maxNumberBins;
+		tempSInt32 = GetLongIntValue ((char*)&tempSInt32);
+		BlockMoveData ((char*)&tempSInt32, &headerBuffer[16], 4);
+		
+		tempSInt32 = (SInt32)numberChannelBytes;
+		tempSInt32 = GetLongIntValue ((char*)&tempSInt32);
+		BlockMoveData ((char*)&tempSInt32, &headerBuffer[20], 4);
+		
+		tempSInt64 = GetLongInt64Value ((char*)&histogramSpecsPtr->totalPixels);
+		BlockMoveData ((char*)&tempSInt64, &headerBuffer[24], 8);
+		
+		errCode = MSetMarker (supportFileStreamPtr, fsFromStart, 0, kErrorMessages);
+		
+		if (errCode == noErr)
+			{
+			count = kBinarySTAHeaderBytes;
+			errCode = MWriteData (
+							supportFileStreamPtr, &count, headerBuffer, kErrorMessages);
+			
+			}	// end "if (errCode == noErr)"
+		
+		}	// end "if (channelStart == 0)"
+	
+	for (channel=channelStart; channel<channelEnd; channel++)
+		{
+		if (errCode != noErr)
+			break;
+			
+		numberBins = MIN (histogramSummaryPtr[channel].numberBins, maxNumberBins);
+		
+		tempSInt32 = (SInt32)numberBins;
+		tempSInt32 = GetLongIntValue ((char*)&tempSInt32);
+		BlockMoveData ((char*)&tempSInt32, &channelBufferPtr[0], 4);
+		
+		tempSInt16 = histogramSummaryPtr[channel].binType;
+		tempSInt16 = GetShortIntValue ((char*)&tempSInt16);
+		BlockMoveData ((char*)&tempSInt16, &channelBufferPtr[4], 2);
+		
+		tempSInt32 = GetLongIntValue ((char*)&histogramSummaryPtr[channel].badValues);
+		BlockMoveData ((char*)&tempSInt32, &channelBufferPtr[8], 4);
+		
+		tempDoubleValue = histogramSummaryPtr[channel].maxValue + signedValueOffset;
+		tempDoubleValue = GetDoubleValue ((UCharPtr)&tempDoubleValue);
+		BlockMoveData ((char*)&tempDoubleValue, &channelBufferPtr[16], 8);
+		
+		tempDoubleValue = 
+						histogramSummaryPtr[channel].maxNonSatValue + signedValueOffset;
+		tempDoubleValue = GetDoubleValue ((UCharPtr)&tempDoubleValue);
+		BlockMoveData ((char*)&tempDoubleValue, &channelBufferPtr[24], 8);
+		
+		tempDoubleValue = histogramSummaryPtr[channel].minValue + signedValueOffset;
+		tempDoubleValue = GetDoubleValue ((UCharPtr)&tempDoubleValue);
+		BlockMoveData ((char*)&tempDoubleValue, &channelBufferPtr[32], 8);
+		
+		tempDoubleValue = 
+						histogramSummaryPtr[channel].minNonSatValue + signedValueOffset;
+		tempDoubleValue = GetDoubleValue ((UCharPtr)&tempDoubleValue);
+		BlockMoveData ((char*)&tempDoubleValue, &channelBufferPtr[40], 8);
+		
+		tempDoubleValue = 
+						histogramSummaryPtr[channel].averageValue + signedValueOffset;
+		tempDoubleValue = GetDoubleValue ((UCharPtr)&tempDoubleValue);
+		BlockMoveData ((char*)&tempDoubleValue, &channelBufferPtr[48], 8);
+		
+		tempDoubleValue = 
+						histogramSummaryPtr[channel].medianValue + signedValueOffset;
+		tempDoubleValue = GetDoubleValue ((UCharPtr)&tempDoubleValue);
+		BlockMoveData ((char*)&tempDoubleValue, &channelBufferPtr[56], 8);
+		
+		tempDoubleValue = histogramSummaryPtr[channel].stdDeviation;
+		tempDoubleValue = GetDoubleValue ((UCharPtr)&tempDoubleValue);
+		BlockMoveData ((char*)&tempDoubleValue, &channelBufferPtr[64], 8);
+		
+				// Load the histogram for the channel. The bins that are not used
+				// are left as zero.
+		
+		if (medianArrayPtr != NULL)
+			{
+			BlockMoveData (medianArrayPtr, 
+								&channelBufferPtr[kBinarySTAChannelHeaderBytes], 
+								4 * numberBins);
+								
+			if (gSwapBytesFlag)
+				SwapBytes (4, 
+								(HUInt8Ptr)&channelBufferPtr[kBinarySTAChannelHeaderBytes], 
+								numberBins);
+			
+			for (index=numberBins; index<maxNumberBins; index++)
+				((HUInt32Ptr)&channelBufferPtr[kBinarySTAChannelHeaderBytes])[index] = 0;
+			
+			medianArrayPtr += maxNumberBins;
+			
+			}	// end "if (medianArrayPtr != NULL)"
+			
+		errCode = MSetMarker (supportFileStreamPtr, 
+										fsFromStart, 
+										kBinarySTAHeaderBytes + 
+												(SInt64)channel * numberChannelBytes, 
+										kErrorMessages);
+		
+		if (errCode == noErr)
+			{
+			count = numberChannelBytes;
+			errCode = MWriteData (
+						supportFileStreamPtr, &count, channelBufferPtr, kErrorMessages);
+			
+			}	// end "if (errCode == noErr)"
+		
+		}	// end "for (channel=channelStart; channel<channelEnd; channel++)"
+		
+	CheckAndDisposePtr ((Ptr)channelBufferPtr);
+		
+	return (errCode == noErr);
+	
+}	// end "WriteBinarySTASupportFile"
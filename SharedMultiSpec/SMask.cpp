@@ -56,6 +56,17 @@ Boolean CheckMaskFileInfo (
 				Handle								fileInfoHandle,
 				SInt16*								errCodePtr);
 
+UInt32 GetNumberMaskRunPixels (
+				MaskRunPtr							maskRunPtr,
+				UInt32								numberRuns,
+				UInt32								maskValueRequest,
+				UInt32								columnStart,
+				UInt32								columnEnd,
+				UInt32								columnInterval);
+
+Boolean LoadMaskRunIndex (
+				MaskInfoPtr							maskInfoPtr);
+
 Boolean LoadNewMaskFields (
 				SInt16								maskSetCode,
 				MaskInfoPtr							maskInfoPtr,
@@ -426,6 +437,8 @@ void CloseMaskStructure (
 			
 		UnlockAndDispose (maskInfoPtr->maskHandle);
 		UnlockAndDispose (maskInfoPtr->maskValueToFieldHandle); 
+		UnlockAndDispose (maskInfoPtr->maskLineRunIndexHandle);
+		UnlockAndDispose (maskInfoPtr->maskRunsHandle);
 									
 		InitializeMaskStructure (maskInfoPtr);
 		
@@ -439,21 +452,25 @@ void CloseMaskStructure (
 //
 //	Function name:		Boolean DetermineIfMaskDataInLine
 //
-//	Software purpose:	The purpose of this routine is to reduce the input line of data
-//							to just that requested by the mask information.
+//	Software purpose:	The purpose of this routine is to determine whether the
+//							requested mask value exists in the requested columns of the
+//							line. The runs for the line are used if the run index for the
+//							mask is available so that each sample does not need to be
+//							checked.
 //
 //	Parameters in:				
 //
-//	Parameters out:	Number of mask samples included in the buffer
+//	Parameters out:	None
 //
-//	Value Returned:	Error code for file operations. 
+//	Value Returned:	TRUE if the requested mask value exists in the line. 
 //
-// Called By:		
+// Called By:			GetLineOfData in SFileIO.cpp
 //
 //	Coded By:			Larry L. Biehl			Date: 12/21/1998
 //	Revised By:			Larry L. Biehl			Date: 12/21/1998
 
 Boolean DetermineIfMaskDataInLine (
+				MaskInfoPtr							maskInfoPtr,
 				UInt16*								maskBufferPtr,
 				UInt32								maskColumnStart,
 				UInt32								numberSamples,
@@ -461,7 +478,10 @@ Boolean DetermineIfMaskDataInLine (
 				UInt32								maskValueRequest)
 
 { 
-	UInt32								sample;
+	MaskRunPtr							maskRunPtr;
+	
+	UInt32								numberRuns,
+											sample;
 	
 	
 			// Return if no mask data in line. Don't have to check every pixel.
@@ -471,6 +491,21 @@ Boolean DetermineIfMaskDataInLine (
 																							
 			// At least one mask value exists in this line. Determine if any
 			// of the requested mask values exist.
+			
+	if (maskInfoPtr != NULL && maskInfoPtr->maskRunsHandle != NULL)
+		{
+		numberRuns = GetMaskLineRuns (maskInfoPtr,
+												GetMaskLine (maskInfoPtr, maskBufferPtr),
+												&maskRunPtr);
+		
+		return (GetNumberMaskRunPixels (maskRunPtr,
+													numberRuns,
+													maskValueRequest,
+													maskColumnStart,
+													maskColumnStart + numberSamples - 1,
+													columnInterval) > 0);
+		
+		}	// end "if (maskInfoPtr != NULL && maskInfoPtr->maskRunsHandle != NULL)"
 	
 	maskBufferPtr += maskColumnStart;
 	
@@ -610,6 +645,26 @@ UInt32 GetFirstMaskLine (
 	if (lineInterval <= 0 || columnInterval <= 0)
 																							return (0);
 	
+	if (maskInfoPtr->maskRunsHandle != NULL && maskValueRequest != 0)
+		{
+				// Use the run index for the mask to find the first line.
+				
+		line = GetNextMaskLine (maskInfoPtr,
+										maskValueRequest,
+										maskLineStart,
+										maskLineStart + (lineEnd - lineStart),
+										lineInterval,
+										maskColumnStart,
+										maskColumnStart + columnEnd - columnStart,
+										columnInterval);
+		
+		if (line == 0)
+																							return (0);
+		
+		return (lineStart + line - maskLineStart);
+		
+		}	// end "if (maskInfoPtr->maskRunsHandle != NULL && ..."
+	
 			// Initialize local variables.
 			
 	maskExistsInLine = 0;
@@ -1091,6 +1146,298 @@ MaskInfoPtr GetMaskInfoPointer (
 
 	
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		UInt32 GetMaskLine
+//
+//	Software purpose:	The purpose of this routine is to get the mask line (1-based)
+//							that the input pointer into the mask buffer represents.
+//
+//	Parameters in:		Pointer to the mask information structure.
+//							Pointer to the start of a line in the mask buffer.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	The mask line.
+//
+// Called By:			DetermineIfMaskDataInLine in SMask.cpp
+//							GetAreaRunsLineOfData in SFileIO.cpp
+//							PackMaskData in SFileIO.cpp
+
+UInt32 GetMaskLine (
+				MaskInfoPtr							maskInfoPtr,
+				HUInt16Ptr							maskBufferPtr)
+
+{
+	HUInt16Ptr							maskStartPtr;
+	
+	
+	maskStartPtr = (HUInt16Ptr)GetHandlePointer (maskInfoPtr->maskHandle);
+	
+	if (maskStartPtr == NULL || maskBufferPtr < maskStartPtr)
+																							return (0);
+	
+	return ((UInt32)((maskBufferPtr - maskStartPtr) / 
+													(maskInfoPtr->numberColumns + 1)) + 1);
+	
+}	// end "GetMaskLine"
+
+	
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		UInt32 GetMaskLineRuns
+//
+//	Software purpose:	The purpose of this routine is to get the runs of non-zero
+//							mask values for the requested mask line from the run index
+//							for the mask. The runs are in column order.
+//
+//	Parameters in:		Pointer to the mask information structure.
+//							Mask line (1-based).
+//
+//	Parameters out:	Pointer to the first run for the line.
+//
+//	Value Returned:	Number of runs in the line. 0 if there are no runs or the run
+//								index is not available.
+//
+// Called By:			DetermineIfMaskDataInLine in SMask.cpp
+//							GetNextMaskLine in SMask.cpp
+//							GetNumberPixelsInMaskArea in SMask.cpp
+//							GetAreaRunsLineOfData in SFileIO.cpp
+//							PackMaskData in SFileIO.cpp
+//							SetUpAreaColumnRuns in SFileIO.cpp
+
+UInt32 GetMaskLineRuns (
+				MaskInfoPtr							maskInfoPtr,
+				UInt32								maskLine,
+				MaskRunPtr*							maskRunPtrPtr)
+
+{
+	HUInt32Ptr							lineRunIndexPtr;
+	MaskRunPtr							maskRunPtr;
+	
+	
+	*maskRunPtrPtr = NULL;
+	
+	if (maskLine == 0 || maskLine > maskInfoPtr->numberLines)
+																							return (0);
+	
+	lineRunIndexPtr = (HUInt32Ptr)GetHandlePointer (
+															maskInfoPtr->maskLineRunIndexHandle);
+	maskRunPtr = (MaskRunPtr)GetHandlePointer (maskInfoPtr->maskRunsHandle);
+	
+	if (lineRunIndexPtr == NULL || maskRunPtr == NULL)
+																							return (0);
+	
+	*maskRunPtrPtr = &maskRunPtr[lineRunIndexPtr[maskLine-1]];
+	
+	return (lineRunIndexPtr[maskLine] - lineRunIndexPtr[maskLine-1]);
+	
+}	// end "GetMaskLineRuns"
+
+	
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		UInt32 GetMaskRunColumns
+//
+//	Software purpose:	The purpose of this routine is to get the first and last
+//							columns of the input mask run that are within the requested
+//							columns and which fall on the column interval.
+//
+//	Parameters in:		Pointer to the mask run.
+//							First, last column and column interval that are being used.
+//
+//	Parameters out:	First and last column of the run to be used.
+//
+//	Value Returned:	Number of columns in the run to be used.
+//
+// Called By:			GetNumberMaskRunPixels in SMask.cpp
+//							GetAreaRunsLineOfData in SFileIO.cpp
+//							PackMaskData in SFileIO.cpp
+//							SetUpAreaColumnRuns in SFileIO.cpp
+
+UInt32 GetMaskRunColumns (
+				MaskRunPtr							maskRunPtr,
+				UInt32								columnStart,
+				UInt32								columnEnd,
+				UInt32								columnInterval,
+				UInt32*								firstColumnPtr,
+				UInt32*								lastColumnPtr)
+
+{
+	UInt32								firstColumn,
+											lastColumn;
+	
+	
+	firstColumn = MAX (maskRunPtr->columnStart, columnStart);
+	lastColumn = MIN (maskRunPtr->columnEnd, columnEnd);
+	
+	if (firstColumn > lastColumn)
+																							return (0);
+	
+			// Move the first column up to the next column on the column interval.
+			
+	firstColumn = columnStart + 
+				(firstColumn - columnStart + columnInterval - 1) / columnInterval * 
+																					columnInterval;
+																				
+	if (firstColumn > lastColumn)
+																							return (0);
+	
+	lastColumn = firstColumn + 
+								(lastColumn - firstColumn) / columnInterval * columnInterval;
+	
+	*firstColumnPtr = firstColumn;
+	*lastColumnPtr = lastColumn;
+	
+	return ((lastColumn - firstColumn) / columnInterval + 1);
+	
+}	// end "GetMaskRunColumns"
+
+	
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		UInt32 GetNextMaskLine
+//
+//	Software purpose:	The purpose of this routine is to find the next mask line 
+//							starting with the input mask line that contains the requested 
+//							mask value within the requested columns. The run index for 
+//							the mask is used so that the mask buffer does not need to be 
+//							scanned.
+//
+//	Parameters in:		Pointer to the mask information structure.
+//							Requested mask value; 0 indicates any non-zero mask value.
+//							Mask line to start with and last mask line to check.
+//							Line interval.
+//							First and last mask column to check and the column interval.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	The mask line. 0 if no line contains the requested mask value.
+//
+// Called By:			GetFirstMaskLine in SMask.cpp
+
+UInt32 GetNextMaskLine (
+				MaskInfoPtr							maskInfoPtr,
+				UInt32								maskValueRequest,
+				UInt32								maskLine,
+				UInt32								maskLineEnd,
+				UInt32								lineInterval,
+				UInt32								maskColumnStart,
+				UInt32								maskColumnEnd,
+				UInt32								columnInterval)
+
+{
+	HUInt32Ptr							lineRunIndexPtr;
+	MaskRunPtr							maskRunPtr;
+	
+	UInt32								numberRuns;
+	
+	
+	if (maskInfoPtr == NULL || lineInterval == 0 || columnInterval == 0)
+																							return (0);
+																							
+	lineRunIndexPtr = (HUInt32Ptr)GetHandlePointer (
+															maskInfoPtr->maskLineRunIndexHandle);
+	
+	if (lineRunIndexPtr == NULL)
+																							return (0);
+	
+	maskLineEnd = MIN (maskLineEnd, maskInfoPtr->numberLines);
+	
+	for (; maskLine<=maskLineEnd; maskLine+=lineInterval)
+		{
+				// Skip the lines without any runs without getting the runs.
+				
+		if (lineRunIndexPtr[maskLine] == lineRunIndexPtr[maskLine-1])
+			continue;
+			
+		numberRuns = GetMaskLineRuns (maskInfoPtr, maskLine, &maskRunPtr);
+		
+		if (GetNumberMaskRunPixels (maskRunPtr,
+												numberRuns,
+												maskValueRequest,
+												maskColumnStart,
+												maskColumnEnd,
+												columnInterval) > 0)
+																					return (maskLine);
+		
+		}	// end "for (; maskLine<=maskLineEnd; maskLine+=lineInterval)"
+		
+	return (0);
+	
+}	// end "GetNextMaskLine"
+
+	
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		UInt32 GetNumberMaskRunPixels
+//
+//	Software purpose:	The purpose of this routine is to count the pixels in the
+//							input runs with the requested mask value which are within
+//							the requested columns and which fall on the column interval.
+//
+//	Parameters in:		Pointer to the first run.
+//							Number of runs.
+//							Requested mask value; 0 indicates any non-zero mask value.
+//							First, last column and column interval that are being used.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	Number of pixels.
+//
+// Called By:			DetermineIfMaskDataInLine in SMask.cpp
+//							GetNextMaskLine in SMask.cpp
+//							GetNumberPixelsInMaskArea in SMask.cpp
+
+UInt32 GetNumberMaskRunPixels (
+				MaskRunPtr							maskRunPtr,
+				UInt32								numberRuns,
+				UInt32								maskValueRequest,
+				UInt32								columnStart,
+				UInt32								columnEnd,
+				UInt32								columnInterval)
+
+{
+	UInt32								firstColumn,
+											lastColumn,
+											pixelCount,
+											run;
+	
+	
+	pixelCount = 0;
+	
+	for (run=0; run<numberRuns; run++)
+		{
+		if (maskRunPtr->columnStart > columnEnd)
+			break;
+			
+		if (maskValueRequest == 0 || maskRunPtr->maskValue == maskValueRequest)
+			pixelCount += GetMaskRunColumns (maskRunPtr,
+															columnStart,
+															columnEnd,
+															columnInterval,
+															&firstColumn,
+															&lastColumn);
+		
+		maskRunPtr++;
+		
+		}	// end "for (run=0; run<numberRuns; run++)"
+		
+	return (pixelCount);
+	
+}	// end "GetNumberMaskRunPixels"
+
+	
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -1130,6 +1477,7 @@ SInt64 GetNumberPixelsInMaskArea (
 	SInt64								pixelCount;
 	
 	HUInt16Ptr							maskBufferPtr;
+	MaskRunPtr							maskRunPtr;
 	
 	UInt32								column,
 											firstColumnSkip,
@@ -1137,10 +1485,12 @@ SInt64 GetNumberPixelsInMaskArea (
 											localColumnInterval,
 											localColumnStart,
 											localLineInterval,
-											numberMaskColumns;
+											numberMaskColumns,
+											numberRuns;
 	
 	Boolean								continueFlag,
-											singlePassClusterFlag;
+											singlePassClusterFlag,
+											useRunsFlag;
 	
 	
 	if (maskInfoPtr == NULL)
@@ -1191,19 +1541,43 @@ SInt64 GetNumberPixelsInMaskArea (
 			}	// end "if (algorithmCode & kSPClusterCase)"
 			
 		firstColumnSkip = 0;
+		
+				// Count the pixels from the runs for each line if the run index for
+				// the mask is available.
+				
+		useRunsFlag = (maskInfoPtr->maskRunsHandle != NULL && maskValueRequest != 0);
 									
 		for (line=lineStart; line<=(UInt32)lineEnd; line+=localLineInterval)
 			{
 			localColumnStart = columnStart + firstColumnSkip;
+			
+			if (useRunsFlag)
+				{
+				numberRuns = GetMaskLineRuns (maskInfoPtr,
+														maskLineStart + line - lineStart,
+														&maskRunPtr);
+				
+				pixelCount += GetNumberMaskRunPixels (maskRunPtr,
+																	numberRuns,
+																	maskValueRequest,
+																	localColumnStart,
+																	columnEnd,
+																	localColumnInterval);
+				
+				}	// end "if (useRunsFlag)"
 				
-			for (column=localColumnStart;
-						column<=(UInt32)columnEnd;
-								column+=localColumnInterval)
+			else	// !useRunsFlag
 				{
-				if (maskBufferPtr[column] == maskValueRequest)
-					pixelCount++;
+				for (column=localColumnStart;
+							column<=(UInt32)columnEnd;
+									column+=localColumnInterval)
+					{
+					if (maskBufferPtr[column] == maskValueRequest)
+						pixelCount++;
+						
+					}	// end "for (column=localColumnStart; column<=columnEnd; ..."
 					
-				}	// end "for (column=localColumnStart; column<=columnEnd; ..."
+				}	// end "else !useRunsFlag"
   				
 			maskBufferPtr += numberMaskColumns;
 				
@@ -1415,12 +1789,15 @@ void InitializeMaskStructure (
 		maskInfoPtr->fileStreamHandle = NULL;
 		maskInfoPtr->maskHandle = NULL;
 		maskInfoPtr->maskValueToFieldHandle = NULL;
+		maskInfoPtr->maskLineRunIndexHandle = NULL;
+		maskInfoPtr->maskRunsHandle = NULL;
 		
 		maskInfoPtr->fileLayer = 0;
 		maskInfoPtr->maxMaskValue = 0;
 		maskInfoPtr->numberColumns = 0;
 		maskInfoPtr->numberLines = 0;
 		maskInfoPtr->numberLayers = 0;
+		maskInfoPtr->numberMaskRuns = 0;
 		maskInfoPtr->startColumn = 0;
 		maskInfoPtr->startLine = 0;
 		
@@ -1835,6 +2212,8 @@ SInt16 LoadMask (
 				
 		UnlockAndDispose (maskInfoPtr->maskHandle);
 		UnlockAndDispose (maskInfoPtr->maskValueToFieldHandle);
+		UnlockAndDispose (maskInfoPtr->maskLineRunIndexHandle);
+		UnlockAndDispose (maskInfoPtr->maskRunsHandle);
 		
 				// Close the current mask file.
 				
@@ -1866,6 +2245,13 @@ SInt16 LoadMask (
 		maskInfoPtr->startLine = 
 								maskFileInfoPtr->startLine + maskLineStart - 1;
 		
+				// Get the run length encoded version of the mask. The mask buffer
+				// will be scanned if it is not available.
+								
+		maskInfoPtr->maskLineRunIndexHandle = NULL;
+		maskInfoPtr->maskRunsHandle = NULL;
+		LoadMaskRunIndex (maskInfoPtr);
+		
 		}	// end "if (continueFlag)"
 	
 	else	// !continueFlag
@@ -1969,6 +2355,161 @@ Handle LoadMaskFileInfo (
 
 	
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean LoadMaskRunIndex
+//
+//	Software purpose:	The purpose of this routine is to create the run length 
+//							encoded version of the mask from the mask buffer. Each run
+//							is a set of adjacent columns in a line with the same non-zero
+//							mask value. The index of the first run for each line is also
+//							saved so that the runs for any line can be found directly.
+//							The run index is not kept if it would take more memory than
+//							the mask buffer itself.
+//
+//	Parameters in:		Pointer to the mask information structure.
+//
+//	Parameters out:	Run index handles in the mask information structure.
+//
+//	Value Returned:	TRUE if the run index was created.
+//
+// Called By:			LoadMask in SMask.cpp
+
+Boolean LoadMaskRunIndex (
+				MaskInfoPtr							maskInfoPtr)
+
+{
+	HUInt16Ptr							maskPointer;
+	HUInt32Ptr							lineRunIndexPtr;
+	MaskRunPtr							maskRunPtr;
+	
+	Handle								lineRunIndexHandle,
+											maskRunsHandle;
+	
+	UInt32								column,
+											line,
+											maskValue,
+											numberMaskColumns,
+											numberRuns,
+											pass,
+											previousMaskValue;
+	
+	
+	maskInfoPtr->numberMaskRuns = 0;
+	
+	maskPointer = (HUInt16Ptr)GetHandlePointer (maskInfoPtr->maskHandle);
+	if (maskPointer == NULL)
+																						return (FALSE);
+	
+	numberMaskColumns = maskInfoPtr->numberColumns;
+	lineRunIndexHandle = NULL;
+	maskRunsHandle = NULL;
+	lineRunIndexPtr = NULL;
+	maskRunPtr = NULL;
+	numberRuns = 0;
+	
+			// The runs are counted in the first pass and loaded in the second pass.
+			
+	for (pass=1; pass<=2; pass++)
+		{
+		if (pass == 2)
+			{
+			if ((SInt64)numberRuns * sizeof (MaskRun) + 
+							(SInt64)(maskInfoPtr->numberLines+1) * sizeof (UInt32) >
+								(SInt64)maskInfoPtr->numberLines * 
+												(numberMaskColumns+1) * sizeof (UInt16))
+																						return (FALSE);
+			
+			lineRunIndexHandle = MNewHandle (
+							(SInt64)(maskInfoPtr->numberLines+1) * sizeof (UInt32));
+			maskRunsHandle = MNewHandle ((SInt64)MAX (numberRuns, 1) * sizeof (MaskRun));
+			
+			lineRunIndexPtr = (HUInt32Ptr)GetHandlePointer (lineRunIndexHandle);
+			maskRunPtr = (MaskRunPtr)GetHandlePointer (maskRunsHandle);
+			
+			if (lineRunIndexPtr == NULL || maskRunPtr == NULL)
+				{
+				UnlockAndDispose (lineRunIndexHandle);
+				UnlockAndDispose (maskRunsHandle);
+																						return (FALSE);
+																						
+				}	// end "if (lineRunIndexPtr == NULL || maskRunPtr == NULL)"
+				
+			maskPointer = (HUInt16Ptr)GetHandlePointer (maskInfoPtr->maskHandle);
+			numberRuns = 0;
+			
+			}	// end "if (pass == 2)"
+			
+		for (line=0; line<maskInfoPtr->numberLines; line++)
+			{
+			if (pass == 2)
+				lineRunIndexPtr[line] = numberRuns;
+			
+					// The first value in the line indicates whether any mask values
+					// exist in the line.
+					
+			if (maskPointer[0] > 0)
+				{
+				previousMaskValue = 0;
+				
+				for (column=1; column<=numberMaskColumns; column++)
+					{
+					maskValue = maskPointer[column];
+					
+					if (maskValue != previousMaskValue)
+						{
+								// End the current run and start a new one if the mask
+								// value is not 0.
+								
+						if (pass == 2 && previousMaskValue != 0)
+							maskRunPtr[numberRuns-1].columnEnd = column - 1;
+							
+						if (maskValue != 0)
+							{
+							if (pass == 2)
+								{
+								maskRunPtr[numberRuns].columnStart = column;
+								maskRunPtr[numberRuns].maskValue = maskValue;
+								
+								}	// end "if (pass == 2)"
+								
+							numberRuns++;
+							
+							}	// end "if (maskValue != 0)"
+						
+						previousMaskValue = maskValue;
+						
+						}	// end "if (maskValue != previousMaskValue)"
+					
+					}	// end "for (column=1; column<=numberMaskColumns; column++)"
+					
+				if (pass == 2 && previousMaskValue != 0)
+					maskRunPtr[numberRuns-1].columnEnd = numberMaskColumns;
+				
+				}	// end "if (maskPointer[0] > 0)"
+				
+			maskPointer += numberMaskColumns + 1;
+			
+			}	// end "for (line=0; line<maskInfoPtr->numberLines; line++)"
+			
+		}	// end "for (pass=1; pass<=2; pass++)"
+		
+	lineRunIndexPtr[maskInfoPtr->numberLines] = numberRuns;
+	
+	CheckAndUnlockHandle (lineRunIndexHandle);
+	CheckAndUnlockHandle (maskRunsHandle);
+		
+	maskInfoPtr->maskLineRunIndexHandle = lineRunIndexHandle;
+	maskInfoPtr->maskRunsHandle = maskRunsHandle;
+	maskInfoPtr->numberMaskRuns = numberRuns;
+	
+	return (TRUE);
+	
+}	// end "LoadMaskRunIndex"
+
+	
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -46,7 +46,57 @@
 
 #include 	"errno.h"
 
+		// Structures used to accumulate the statistics for the lines in a block of
+		// lines on worker threads. Each slot has its own channel statistics and 
+		// sums of squares for its range of lines in the block. The slot 
+		// statistics are added to those for the area in slot order after each
+		// block.
 
+typedef struct AreaStatsSlot
+	{
+	HChannelStatisticsPtr		chanPtr;
+	HSumSquaresStatisticsPtr	sumSquaresPtr;
+	
+	SInt64							numberPixels;
+	
+	} AreaStatsSlot, *AreaStatsSlotPtr;
+
+typedef struct AreaStatsLines
+	{
+	double							maxDataValue;
+	double							minDataValue;
+	
+	AreaStatsSlotPtr				slotPtr;
+	HDoublePtr						maxThresholdValuesPtr;
+	HDoublePtr						minThresholdValuesPtr;
+	HUCharPtr						blockBufferPtr;
+	RgnHandle						rgnHandle;
+	UInt32*							numberSamplesPtr;
+	
+	UInt32							columnInterval;
+	UInt32							columnStart;
+	UInt32							line;
+	UInt32							lineBytes;
+	UInt32							lineInterval;
+	UInt32							numberLines;
+	UInt32							numberSlots;
+	UInt32							numberSumSquares;
+	
+	SInt16							statCode;
+	UInt16							numberChannels;
+	
+	Boolean							checkForBadDataFlag;
+	Boolean							checkForNoDataFlag;
+	Boolean							checkForThresholdDataFlag;
+	Boolean							polygonFieldFlag;
+	
+	} AreaStatsLines, *AreaStatsLinesPtr;
+
+
+
+void GetAreaStatsLinesTask (
+				void*									taskInfoPtr,
+				UInt32								task);
 
 void ReduceMatrix1 (
 				HDoublePtr							inputMatrixPtr,
@@ -2047,17 +2097,17 @@ SInt16 GetAreaStats (
 				HDoublePtr							maxThresholdValuesPtr)
 
 {
-	knnType 								knnSamp;
-	
 	double								dValue,
 											maxDataValue,
 											minDataValue,
 											noDataValue;
 	
-	SInt64								numberPixels;
+	AreaStatsLines						areaStatsLines;
 	
-	double*								knnDataValuesPtr;
-													
+	SInt64								numberPixels,
+											numberSlotBytes;
+	
+	AreaStatsSlotPtr					slotPtr;
 	HChannelStatisticsPtr			lAreaChanPtr;
 	
 	HDoublePtr							bufferPtr,
@@ -2066,24 +2116,37 @@ SInt16 GetAreaStats (
 											
 	HSumSquaresStatisticsPtr		lAreaSumSquaresPtr;
 	
-	HUCharPtr							inputBufferPtr,
+	HUCharPtr							blockBufferPtr,
+											dataBufferPtr,
+											inputBufferPtr,
 											outputBufferPtr;
 	
 	Point									point;
 	RgnHandle							rgnHandle;
 	
-	UInt32								channel,
+	UInt32*								numberOutputSamplesPtr;
+	
+	UInt32								blockLineCount,
+											blockLineIndex,
+											channel,
 											columnEnd,
 											columnInterval,
 											columnPtr,
 											columnStart,
 											covChan,
+											index,
 											line,
+											lineBytes,
 											lineCount,
 											lineEnd,
 											lineInterval,
 											lineStart,
-											numberSamples;
+											numberBlockLines,
+											numberLines,
+											numberSamples,
+											numberSlots,
+											singleLineNumberSamples,
+											slot;
 	
 	SInt16								classNumber,
 											errCode,
@@ -2233,15 +2296,6 @@ SInt16 GetAreaStats (
 		
 		}	// end "if (classNumber == 0)"
 	
-	if (statCode == kPixelValuesOnly)
-		{
-		//knnDataValuesPtr = gProjectInfoPtr->knnDataValuesPtr.data ();
-		knnDataValuesPtr =
-			&gProjectInfoPtr->knnDataValuesPtr [
-													numberChannels * gProjectInfoPtr->knnCounter];
-		
-		}	// end "if (statCode == kPixelValuesOnly)"
-			
 			// Load some of the File IO Instructions structure that pertain
 			// to the specific area being used.
 			
@@ -2250,6 +2304,95 @@ SInt16 GetAreaStats (
 													numberChannels,
 													channelsPtr,
 													kDetermineSpecialBILFlag);
+													
+			// Only read the columns within the mask or polygon for each line.
+			
+	SetUpAreaColumnRuns (fileIOInstructionsPtr, &gAreaDescription);
+	
+			// Get a buffer to read a block of lines into at one time. If memory
+			// is not available for this, just read one line at a time into the
+			// output buffer.
+			
+	numberLines = 1;
+	if (lineEnd >= lineStart)
+		numberLines = (lineEnd - lineStart + lineInterval)/lineInterval;
+	
+	lineBytes = numberSamples * numberChannels * sizeof (double);
+	blockBufferPtr = GetLinesOfDataBuffer (lineBytes,
+														numberLines,
+														&numberBlockLines,
+														&numberOutputSamplesPtr);
+	
+	dataBufferPtr = blockBufferPtr;
+	if (blockBufferPtr == NULL)
+		{
+		dataBufferPtr = outputBufferPtr;
+		numberBlockLines = 1;
+		numberOutputSamplesPtr = &singleLineNumberSamples;
+		
+		}	// end "if (blockBufferPtr == NULL)"
+		
+			// If more than one thread can be used, the statistics for the lines in 
+			// each block are accumulated on worker threads. This is not done when
+			// only the pixel values are requested since they are added to the 
+			// training pixels in line order by this thread.
+	
+	areaStatsLines.slotPtr = NULL;
+	numberSlots = 1;
+	if (blockBufferPtr != NULL && statCode != kPixelValuesOnly)
+		numberSlots = GetNumberWorkerThreads (numberBlockLines);
+		
+	if (numberSlots > 1)
+		{
+		areaStatsLines.numberSumSquares = numberChannels;
+		if (statCode == kMeanCovariance)
+			areaStatsLines.numberSumSquares = 
+											(UInt32)numberChannels * (numberChannels+1) / 2;
+		
+		numberSlotBytes = numberChannels * sizeof (ChannelStatistics) +
+							areaStatsLines.numberSumSquares * sizeof (SumSquaresStatistics);
+		
+		areaStatsLines.slotPtr = (AreaStatsSlotPtr)MNewPointer (
+					numberSlots * (sizeof (AreaStatsSlot) + numberSlotBytes));
+		
+		}	// end "if (numberSlots > 1)"
+	
+	if (areaStatsLines.slotPtr != NULL)
+		{
+		for (slot=0; slot<numberSlots; slot++)
+			{
+			slotPtr = &areaStatsLines.slotPtr[slot];
+			slotPtr->chanPtr = (HChannelStatisticsPtr)
+						&((HUCharPtr)&areaStatsLines.slotPtr[numberSlots])[
+																			slot*numberSlotBytes];
+			slotPtr->sumSquaresPtr = 
+						(HSumSquaresStatisticsPtr)&slotPtr->chanPtr[numberChannels];
+			
+			}	// end "for (slot=0; slot<numberSlots; slot++)"
+		
+		areaStatsLines.maxDataValue = maxDataValue;
+		areaStatsLines.minDataValue = minDataValue;
+		areaStatsLines.maxThresholdValuesPtr = maxThresholdValuesPtr;
+		areaStatsLines.minThresholdValuesPtr = minThresholdValuesPtr;
+		areaStatsLines.blockBufferPtr = blockBufferPtr;
+		areaStatsLines.rgnHandle = rgnHandle;
+		areaStatsLines.numberSamplesPtr = numberOutputSamplesPtr;
+		areaStatsLines.columnInterval = columnInterval;
+		areaStatsLines.columnStart = columnStart;
+		areaStatsLines.lineBytes = lineBytes;
+		areaStatsLines.lineInterval = lineInterval;
+		areaStatsLines.numberSlots = numberSlots;
+		areaStatsLines.statCode = statCode;
+		areaStatsLines.numberChannels = numberChannels;
+		areaStatsLines.checkForBadDataFlag = checkForBadDataFlag;
+		areaStatsLines.checkForNoDataFlag = checkForNoDataFlag;
+		areaStatsLines.checkForThresholdDataFlag = checkForThresholdDataFlag;
+		areaStatsLines.polygonFieldFlag = polygonFieldFlag;
+		
+		}	// end "if (areaStatsLines.slotPtr != NULL)"
+	
+	blockLineCount = 0;
+	blockLineIndex = 0;
 	
 			// Loop through the lines for the field.										
 			
@@ -2269,29 +2412,94 @@ SInt16 GetAreaStats (
 		point.v = (SInt16)line;
 		point.h = (SInt16)columnStart;
 			
-				// Get all channels for the line of image data.  Return if			
-				// there is a file IO error.													
+				// Get all channels for the next block of lines of image data if 
+				// all lines in the current block have been used.  Return if			
+				// there is a file IO error.
+		
+		if (blockLineIndex >= blockLineCount)
+			{
+			blockLineCount = (lineEnd - line)/lineInterval + 1;
+			blockLineCount = MIN (blockLineCount, numberBlockLines);
+			
+			errCode = GetLinesOfData (fileIOInstructionsPtr,
+												line,
+												blockLineCount,
+												lineInterval,
+												columnStart,
+												columnEnd,
+												columnInterval,
+												(HUCharPtr)inputBufferPtr,
+												dataBufferPtr,
+												lineBytes,
+												numberOutputSamplesPtr);
+					
+			if (errCode < noErr)
+				{
+				CheckAndDisposePtr ((Ptr)areaStatsLines.slotPtr);
+				CheckAndDisposePtr ((Ptr)blockBufferPtr);
+				CloseUpFileIOInstructions (fileIOInstructionsPtr, &gAreaDescription);										
+																							return (0);
+				
+				}	// end "if (errCode < noErr)"
+				
+			blockLineIndex = 0;
 			
-		errCode = GetLineOfData (fileIOInstructionsPtr,
-											line,
-											columnStart,
-											columnEnd,
-											columnInterval,
-											(HUCharPtr)inputBufferPtr,
-											(HUCharPtr)outputBufferPtr);
+			if (areaStatsLines.slotPtr != NULL)
+				{
+						// Accumulate the statistics for the lines in the block on the
+						// worker threads and then add those for each slot to the area
+						// statistics.
+						
+				areaStatsLines.line = line;
+				areaStatsLines.numberLines = blockLineCount;
+				
+				RunTasksInParallel (numberSlots, GetAreaStatsLinesTask, &areaStatsLines);
+				
+				for (slot=0; slot<numberSlots; slot++)
+					{
+					slotPtr = &areaStatsLines.slotPtr[slot];
 					
-		if (errCode < noErr)
+					for (channel=0; channel<numberChannels; channel++)
+						{
+						areaChanPtr[channel].minimum = MIN (areaChanPtr[channel].minimum, 
+																		slotPtr->chanPtr[channel].minimum);
+						areaChanPtr[channel].maximum = MAX (areaChanPtr[channel].maximum, 
+																		slotPtr->chanPtr[channel].maximum);
+						areaChanPtr[channel].sum += slotPtr->chanPtr[channel].sum;
+						
+						}	// end "for (channel=0; channel<numberChannels; channel++)"
+					
+					for (index=0; index<areaStatsLines.numberSumSquares; index++)
+						areaSumSquaresPtr[index] += slotPtr->sumSquaresPtr[index];
+					
+					numberPixels += slotPtr->numberPixels;
+					
+					}	// end "for (slot=0; slot<numberSlots; slot++)"
+				
+				}	// end "if (areaStatsLines.slotPtr != NULL)"
+			
+			}	// end "if (blockLineIndex >= blockLineCount)"
+			
+		outputBufferPtr = &dataBufferPtr[blockLineIndex*lineBytes];
+		numberSamples = numberOutputSamplesPtr[blockLineIndex];
+		blockLineIndex++;
+				
+				// A line with 0 samples was skipped because there are no requested
+				// mask values in it.
+				
+		if (areaStatsLines.slotPtr != NULL)
 			{
-			CloseUpFileIOInstructions (fileIOInstructionsPtr, &gAreaDescription);										
-																							return (0);
+					// The statistics for this line have already been added. Just
+					// check whether the user wants to stop.
+					
+			if (TickCount () >= gNextTime && !CheckSomeEvents (eventCode))
+				returnCode = -1;
 			
-			}	// end "if (errCode < noErr)"
+			}	// end "if (areaStatsLines.slotPtr != NULL)"
 				
-		if (errCode != kSkipLine)
+		else if (numberSamples > 0)
 			{
 		   tOutputBufferPtr = (HDoublePtr)outputBufferPtr;
-			   
-			numberSamples = fileIOInstructionsPtr->numberOutputBufferSamples;
 		   
 			for (columnPtr=0; columnPtr<numberSamples; columnPtr++)
 				{
@@ -2374,35 +2582,10 @@ SInt16 GetAreaStats (
 							//samp.set_size (gClassifySpecsPtr->numberChannels);
 							//int sampleCount = 0;
 							
-									// KNN training samples
+									// KNN training sample and label. The values are kept in
+									// memory or in the training pixel store file.
 
-							for (channel=0; channel<numberChannels; channel++)
-								{
-										// Move sample data of each channel to dlib variable
-										// for SVM training
-								
-								//samp (channel) = *bufferPtr;
-								
-										// KNN sample data in the training
-								
-								//gProjectInfoPtr->knnDataValuesPtr.push_back (*bufferPtr);
-								*knnDataValuesPtr = *bufferPtr;
-
-				      		bufferPtr++;
-				      		knnDataValuesPtr++;
-								
-								}	// end "for (channel=1; channel<numberChannels..."
-							
-									// KNN labelling in the training phase
-							
-							knnSamp.distance = 0;
-							knnSamp.index = 0;
-
-							gProjectInfoPtr->knnDistancesPtr[gProjectInfoPtr->knnCounter] =
-																									knnSamp;
-							gProjectInfoPtr->knnLabelsPtr[gProjectInfoPtr->knnCounter] =
-																								classNumber;
-							gProjectInfoPtr->knnCounter++;
+							AddTrainingPixelSample (bufferPtr, classNumber);
 							
 							}	// end "if (statCode == kPixelValuesOnly)"
 						
@@ -2473,7 +2656,7 @@ SInt16 GetAreaStats (
 						
 				} 	// end "for (columnPtr=0; columnPtr<..."
 				
-			}	// end "if (errCode != kSkipLine)"
+			}	// end "if (numberSamples > 0)"
 			
 		if (returnCode < 0)
 			break;
@@ -2483,6 +2666,9 @@ SInt16 GetAreaStats (
 												fileIOInstructionsPtr->numberMaskColumnsPerLine;
 	      
 		}	// end "for (line=lineStart; line<=lineEnd; line++)" 
+	
+	CheckAndDisposePtr ((Ptr)areaStatsLines.slotPtr);
+	CheckAndDisposePtr ((Ptr)blockBufferPtr);
 		
 	if (returnCode > 0)
 		LoadDItemValue (gStatusDialogPtr, IDC_Status18, (SInt32)lineCount);
@@ -2505,6 +2691,203 @@ SInt16 GetAreaStats (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void GetAreaStatsLinesTask
+//
+//	Software purpose:	The purpose of this routine is to accumulate the statistics
+//							for the range of lines in the block of lines that belongs to
+//							the input slot. The data values are checked in the same way 
+//							as in GetAreaStats. It may run in a worker thread; only the 
+//							statistics for the slot are changed.
+//
+//	Parameters in:		Pointer to the area statistics lines structure.
+//							Index of the slot.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+// 
+// Called By:			RunTasksInParallel in SThreads.cpp
+
+void GetAreaStatsLinesTask (
+				void*									taskInfoPtr,
+				UInt32								task)
+
+{
+	double								dValue;
+	
+	AreaStatsLinesPtr					areaStatsLinesPtr;
+	AreaStatsSlotPtr					slotPtr;
+	
+	HChannelStatisticsPtr			lAreaChanPtr;
+	
+	HDoublePtr							bufferPtr,
+											bufferPtr2,
+											tOutputBufferPtr;
+	
+	HSumSquaresStatisticsPtr		lAreaSumSquaresPtr;
+	
+	Point									point;
+	
+	UInt32								channel,
+											covChan,
+											index,
+											lastLineIndex,
+											lineIndex,
+											numberChannels,
+											numberSamples,
+											sample;
+	
+	Boolean								dataOkayFlag;
+	
+	
+	areaStatsLinesPtr = (AreaStatsLinesPtr)taskInfoPtr;
+	slotPtr = &areaStatsLinesPtr->slotPtr[task];
+	numberChannels = areaStatsLinesPtr->numberChannels;
+	
+	for (channel=0; channel<numberChannels; channel++)
+		{
+		slotPtr->chanPtr[channel].sum = 0;
+		slotPtr->chanPtr[channel].minimum = DBL_MAX;
+		slotPtr->chanPtr[channel].maximum = -DBL_MAX;
+		
+		}	// end "for (channel=0; channel<numberChannels; channel++)"
+		
+	for (index=0; index<areaStatsLinesPtr->numberSumSquares; index++)
+		slotPtr->sumSquaresPtr[index] = 0;
+		
+	slotPtr->numberPixels = 0;
+	
+			// Get the range of lines in the block for this slot.
+			
+	lineIndex = (UInt32)((UInt64)areaStatsLinesPtr->numberLines * task / 
+																	areaStatsLinesPtr->numberSlots);
+	lastLineIndex = (UInt32)((UInt64)areaStatsLinesPtr->numberLines * (task+1) / 
+																	areaStatsLinesPtr->numberSlots);
+	
+	for (; lineIndex<lastLineIndex; lineIndex++)
+		{
+		numberSamples = areaStatsLinesPtr->numberSamplesPtr[lineIndex];
+		tOutputBufferPtr = (HDoublePtr)&areaStatsLinesPtr->blockBufferPtr[
+															lineIndex*areaStatsLinesPtr->lineBytes];
+		
+		point.v = (SInt16)(areaStatsLinesPtr->line + 
+												lineIndex * areaStatsLinesPtr->lineInterval);
+		point.h = (SInt16)areaStatsLinesPtr->columnStart;
+		
+		for (sample=0; sample<numberSamples; sample++)
+			{
+			if (!areaStatsLinesPtr->polygonFieldFlag || 
+												PtInRgn (point, areaStatsLinesPtr->rgnHandle))
+				{
+				dataOkayFlag = TRUE;
+				bufferPtr = tOutputBufferPtr;
+				
+				if (areaStatsLinesPtr->checkForThresholdDataFlag)
+					{
+					for (channel=0; channel<numberChannels; channel++)
+						{
+						if (bufferPtr[channel] < 
+											areaStatsLinesPtr->minThresholdValuesPtr[channel] || 
+								bufferPtr[channel] > 
+											areaStatsLinesPtr->maxThresholdValuesPtr[channel])
+							{
+							dataOkayFlag = FALSE;
+							break;
+							
+							}	// end "if (bufferPtr[channel] < ..."
+						
+						}	// end "for (channel=0; channel<numberChannels; ..."
+					
+					}	// end "if (areaStatsLinesPtr->checkForThresholdDataFlag)"
+				
+				else if (areaStatsLinesPtr->checkForBadDataFlag)
+					{
+					for (channel=0; channel<numberChannels; channel++)
+						{
+						if (bufferPtr[channel] < areaStatsLinesPtr->minDataValue || 
+										bufferPtr[channel] > areaStatsLinesPtr->maxDataValue)
+							{
+							dataOkayFlag = FALSE;
+							break;
+							
+							}	// end "if (bufferPtr[channel] < ..."
+						
+						}	// end "for (channel=0; channel<numberChannels; ..."
+					
+					}	// end "else if (areaStatsLinesPtr->checkForBadDataFlag)"
+				
+				else if (areaStatsLinesPtr->checkForNoDataFlag)
+					{
+					for (channel=0; channel<numberChannels; channel++)
+						{
+						if (bufferPtr[channel] > areaStatsLinesPtr->minDataValue && 
+										bufferPtr[channel] < areaStatsLinesPtr->maxDataValue)
+							{
+							dataOkayFlag = FALSE;
+							break;
+							
+							}	// end "if (bufferPtr[channel] > ..."
+						
+						}	// end "for (channel=0; channel<numberChannels; ..."
+					
+					}	// end "else if (areaStatsLinesPtr->checkForNoDataFlag)"
+				
+				if (dataOkayFlag)
+					{
+					lAreaChanPtr = slotPtr->chanPtr;
+					lAreaSumSquaresPtr = slotPtr->sumSquaresPtr;
+					
+					for (channel=0; channel<numberChannels; channel++)
+						{
+						dValue = *bufferPtr;
+						
+						lAreaChanPtr->minimum = MIN (lAreaChanPtr->minimum, dValue);
+						lAreaChanPtr->maximum = MAX (lAreaChanPtr->maximum, dValue);
+						lAreaChanPtr->sum += dValue;
+						
+						lAreaChanPtr++;
+						
+						if (areaStatsLinesPtr->statCode == kMeanCovariance)
+							{
+							bufferPtr2 = tOutputBufferPtr;
+							
+							for (covChan=0; covChan<channel; covChan++)
+								{
+								*lAreaSumSquaresPtr += dValue * *bufferPtr2;
+								bufferPtr2++;
+								lAreaSumSquaresPtr++;
+								
+								}	// end "for (covChan=0; covChan<channel; covChan++)"
+							
+							}	// end "if (areaStatsLinesPtr->statCode == kMeanCovariance)"
+						
+						*lAreaSumSquaresPtr += dValue * dValue;
+						lAreaSumSquaresPtr++;
+						
+						bufferPtr++;
+						
+						}	// end "for (channel=0; channel<numberChannels; channel++)"
+					
+					slotPtr->numberPixels++;
+					
+					}	// end "if (dataOkayFlag)"
+				
+				}	// end "if (!areaStatsLinesPtr->polygonFieldFlag || ..."
+			
+			tOutputBufferPtr += numberChannels;
+			point.h += (SInt16)areaStatsLinesPtr->columnInterval;
+			
+			}	// end "for (sample=0; sample<numberSamples; sample++)"
+		
+		}	// end "for (; lineIndex<lastLineIndex; lineIndex++)"
+	
+}	// end "GetAreaStatsLinesTask"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -107,6 +107,23 @@
 
 #define use_mlte_for_text_window  0
 
+		// SIMD (SSE4.1 and AVX2) versions of the routines which pack and convert
+		// lines of data. The version used is selected at run time.
+#if defined __x86_64__ || defined __i386__ || defined _M_X64 || defined _M_IX86
+	#define include_simd_capability 1
+#else
+	#define include_simd_capability 0
+#endif
+
+		// zlib is used to decompress Deflate compressed TIFF files. It is only
+		// included in the Linux wx version which links with it (-lz in
+		// Linux_build/Makefile). The other versions read those files with gdal.
+#if defined multispec_wxlin && include_hdf_capability
+	#define include_zlib_capability 1
+#else
+	#define include_zlib_capability 0
+#endif
+
 #include "SConstants.h"
 #include "SDefines.h" 
 #include "SGraphic.h"
@@ -1623,7 +1623,9 @@ SInt16 CheckImageHeader (
             if (formatOnlyCode == kLoadHeader &&
                     (fileInfoPtr->format == kTIFFType ||
 													fileInfoPtr->format == kGeoTIFFType) &&
-                    					fileInfoPtr->dataCompressionCode == kNoCompression)
+                    		(fileInfoPtr->dataCompressionCode == kNoCompression ||
+										CheckIfTIFFCompressionCanBeRead (
+													fileInfoPtr->dataCompressionCode)))
 					{
 					SInt64 fileSize;
 					GetSizeOfFile (fileStreamPtr, &fileSize);
@@ -1637,7 +1639,8 @@ SInt16 CheckImageHeader (
 										gOutputForce1Code,
 										true);
 					*/
-					if (fileInfoPtr->blockHeight * fileInfoPtr->blockWidth * fileInfoPtr->numberBytes > 16000000 || // 16000000
+					if (fileInfoPtr->dataCompressionCode != kNoCompression ||
+							fileInfoPtr->blockHeight * fileInfoPtr->blockWidth * fileInfoPtr->numberBytes > 16000000 || // 16000000
 								fileSize > UInt32_MAX)
 								//fileInfoPtr->numberLines == fileInfoPtr->blockHeight &&
 								//fileInfoPtr->numberColumns == fileInfoPtr->blockWidth &&
@@ -1654,6 +1657,10 @@ SInt16 CheckImageHeader (
 								// to an offset beyond UInt32_MAX. gdal will not ... at least
 								// it will not for band sequential files that have been tried.
 								//
+								// MultiSpec also handles the LZW, Deflate and PackBits
+								// compressed tiff files since the blocks can then be
+								// decompressed in parallel and kept in the tile cache.
+								//
 								// We need to indicate that gdal is not being used for
 								// processing here. If there is an error in using
 								// ReadTIFFHeader then gdal will be used.
@@ -524,7 +524,8 @@ void EvaluateCovariancesControl (void)
 												ipvotPtr, 
 												&determinant,
 												&logDeterminant,
-												kReturnMatrixInverse);
+												kReturnMatrixInverse,
+												kCheckEvents);
 									
 				if (gOperationCanceledFlag)
 					break;
@@ -697,7 +698,8 @@ void EvaluateCovariancesControl (void)
 														ipvotPtr, 
 														&determinant,
 														&logDeterminant,
-														kReturnMatrixInverse);
+														kReturnMatrixInverse,
+														kCheckEvents);
 											
 								// Get the end time for the inversion						
 					
@@ -1029,7 +1031,8 @@ void EvaluateCovariancesControl (void)
 				{
 				determinant = InvertSymmetricMatrix (utilityCovPtr, 
 									numberUtilityChannels, pivotPtr, indexRowPtr, 
-																	indexColPtr, ipvotPtr);
+																	indexColPtr, ipvotPtr,
+																	kCheckEvents);
 									
 				if (gOperationCanceledFlag)
 					break;
@@ -1390,6 +1390,16 @@ SInt16 CopyFileInfoHandles (
 
 		}	// end "if (errCode == noErr && ..."
 		
+			// The reduced resolution TIFF images are only used by the image window
+			// file information structure.
+			
+	if (outputFileInfoPtr->tiffOverviewHandle == inputFileInfoPtr->tiffOverviewHandle)
+		{
+		outputFileInfoPtr->tiffOverviewHandle = NULL;
+		outputFileInfoPtr->numberTIFFOverviews = 0;
+		
+		}	// end "if (outputFileInfoPtr->tiffOverviewHandle == ..."
+		
 			// Make sure that all output file handles are null if there is an error and
 			// the output handle is the same as the input handle. We do not want an 
 			// output handle to be released that is being used by the input file
@@ -2648,6 +2658,12 @@ void GetProjectStatisticsPointers (
 		{
 		if (gProjectInfoPtr->keepClassStatsOnlyFlag)
 			storageIndex = 0;
+		
+				// Make certain that the statistics for the field have been loaded if
+				// they are in the binary block of the project file.
+				
+		if (gProjectInfoPtr->fieldStatsBinaryOffsetsPtr != NULL)
+			LoadBinaryFieldStatistics (storageIndex);
 			
 		if (gProjectInfoPtr->fieldChanStatsPtr && chanStatsPtrPtr)
 			*chanStatsPtrPtr = &gProjectInfoPtr->fieldChanStatsPtr[
@@ -3281,6 +3297,26 @@ void InitializeProjectStructure (
 		gProjectInfoPtr->knnLabelsPtr = NULL;
 		gProjectInfoPtr->knnDataValuesPtr = NULL;
 		gProjectInfoPtr->knnCounter = 0;
+
+				// used for the training pixel store file
+
+		gProjectInfoPtr->trainingStoreFileStreamPtr = NULL;
+		gProjectInfoPtr->trainingStoreBufferPtr = NULL;
+		gProjectInfoPtr->trainingStoreValuesPtr = NULL;
+		gProjectInfoPtr->trainingStoreBufferSamples = 0;
+		gProjectInfoPtr->trainingStoreErrCode = noErr;
+		gProjectInfoPtr->trainingStoreValueBytes = 0;
+		gProjectInfoPtr->trainingStoreFieldsPtr = NULL;
+		gProjectInfoPtr->previousStoreFieldsPtr = NULL;
+		gProjectInfoPtr->previousStoreFileStreamPtr = NULL;
+		gProjectInfoPtr->previousStoreBufferPtr = NULL;
+		gProjectInfoPtr->previousStoreValuesPtr = NULL;
+		gProjectInfoPtr->numberPreviousStoreFields = 0;
+
+				// used to load field statistics from the project file as needed
+
+		gProjectInfoPtr->fieldStatsBinaryOffsetsPtr = NULL;
+		gProjectInfoPtr->numberFieldStatsBinaryOffsets = 0;
 			
 		gProjectInfoPtr->startLine = 1;
 		gProjectInfoPtr->startColumn = 1;
@@ -4289,6 +4325,8 @@ void ReleaseProjectHandles (
 		
 		gProjectInfoPtr->knnDataValuesPtr =
 										CheckAndDisposePtr (gProjectInfoPtr->knnDataValuesPtr);
+		
+		CloseTrainingStore (inputProjectInfoPtr);
 
 		}	// end "if (inputProjectInfoPtr != NULL)" 
 		
@@ -4349,6 +4387,14 @@ void ReleaseStatisticsHandles (
 					UnlockAndDispose (inputProjectInfoPtr->fieldSumSquaresStatsHandle);
 			inputProjectInfoPtr->fieldSumSquaresStatsPtr = NULL;
 			
+					// Dispose of offsets for field statistics not loaded yet from
+					// the project file.
+					
+			inputProjectInfoPtr->fieldStatsBinaryOffsetsPtr = 
+						(SInt64*)CheckAndDisposePtr (
+										(Ptr)inputProjectInfoPtr->fieldStatsBinaryOffsetsPtr);
+			inputProjectInfoPtr->numberFieldStatsBinaryOffsets = 0;
+			
 			}	// end "if (statsCode & kOriginalStats)"
 			
 		if (statsCode & kLeaveOneOutStats)
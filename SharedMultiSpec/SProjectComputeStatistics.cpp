@@ -251,6 +251,91 @@ void AddToClassChannelStatistics (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void AddTrainingPixelSample
+//
+//	Software purpose:	The purpose of this routine is to add the values for a
+//							training pixel and its class label to the training pixel
+//							data used by the nearest neighbor and svm classifiers. The
+//							values are stored in memory or in the buffer for the training
+//							pixel store (.knn) file if it is being used.
+//
+//	Parameters in:		Pointer to the values for the project channels.
+//							Class label for the pixel.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+// 
+// Called By:			GetAreaStats in SMatrixUtilities.cpp
+//							UpdateProjectMaskStats in SProjectComputeStatistics.cpp
+
+void AddTrainingPixelSample (
+				HDoublePtr							valuesPtr,
+				UInt16								label)
+
+{
+	HDoublePtr							doubleValuesPtr;
+	float*								floatValuesPtr;
+	
+	UInt32								channel,
+											numberChannels;
+	
+	
+	numberChannels = gProjectInfoPtr->numberStatisticsChannels;
+	floatValuesPtr = NULL;
+	
+	if (gProjectInfoPtr->trainingStoreValueBytes == 0)
+		doubleValuesPtr = &gProjectInfoPtr->knnDataValuesPtr[
+										(SInt64)numberChannels * gProjectInfoPtr->knnCounter];
+	
+	else	// gProjectInfoPtr->trainingStoreValueBytes > 0
+		{
+		if (gProjectInfoPtr->trainingStoreBufferSamples >= kTrainingStoreBufferSamples)
+			WriteTrainingStoreBuffer ();
+		
+		doubleValuesPtr = (HDoublePtr)gProjectInfoPtr->trainingStoreBufferPtr;
+		floatValuesPtr = (float*)gProjectInfoPtr->trainingStoreBufferPtr;
+		
+		if (gProjectInfoPtr->trainingStoreValueBytes == 4)
+			floatValuesPtr += gProjectInfoPtr->trainingStoreBufferSamples * numberChannels;
+		
+		else	// gProjectInfoPtr->trainingStoreValueBytes == 8
+			{
+			doubleValuesPtr += gProjectInfoPtr->trainingStoreBufferSamples * numberChannels;
+			floatValuesPtr = NULL;
+			
+			}	// end "else gProjectInfoPtr->trainingStoreValueBytes == 8"
+		
+		gProjectInfoPtr->trainingStoreBufferSamples++;
+		
+		}	// end "else gProjectInfoPtr->trainingStoreValueBytes > 0"
+	
+	if (floatValuesPtr != NULL)
+		{
+		for (channel=0; channel<numberChannels; channel++)
+			floatValuesPtr[channel] = (float)valuesPtr[channel];
+			
+		}	// end "if (floatValuesPtr != NULL)"
+	
+	else	// floatValuesPtr == NULL
+		{
+		for (channel=0; channel<numberChannels; channel++)
+			doubleValuesPtr[channel] = valuesPtr[channel];
+			
+		}	// end "else floatValuesPtr == NULL"
+	
+	gProjectInfoPtr->knnDistancesPtr[gProjectInfoPtr->knnCounter].distance = 0;
+	gProjectInfoPtr->knnDistancesPtr[gProjectInfoPtr->knnCounter].index = 0;
+	gProjectInfoPtr->knnLabelsPtr[gProjectInfoPtr->knnCounter] = label;
+	gProjectInfoPtr->knnCounter++;
+	
+}	// end "AddTrainingPixelSample"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -866,8 +951,12 @@ void CombineFieldChannelStatistics (
 						// Get pointers to the memory for the first order field 	
 						// statistics.															
 	    		
-				fieldChanPtr =  &gProjectInfoPtr->fieldChanStatsPtr[
-															fieldStatsNumber*numberInputChannels];
+				GetProjectStatisticsPointers (kFieldStatsOnly, 
+														fieldStatsNumber, 
+														&fieldChanPtr, 
+														NULL,
+														NULL,
+														NULL);
 						
 				AddToClassChannelStatistics (numberOutputChannels, 
 														classChannelStatsPtr,
@@ -3805,12 +3894,17 @@ Boolean SetupPixelMemory (void)
 			gProjectInfoPtr->knnLabelsPtr =
 						(UInt16*)MNewPointer (numberOfTrainPixelsInProject*sizeof (UInt16));
 		
-		if (gProjectInfoPtr->knnLabelsPtr != NULL)
+				// The pixel values are written to the training pixel store file
+				// instead of being kept in memory if there are a large number of them.
+		
+		if (gProjectInfoPtr->knnLabelsPtr != NULL &&
+								!CreateTrainingStore (numberOfTrainPixelsInProject))
 			gProjectInfoPtr->knnDataValuesPtr =
 						(double*)MNewPointer (
 								numberOfTrainPixelsInProject*numberChannels*sizeof (double));
 		
-		continueFlag = (gProjectInfoPtr->knnDataValuesPtr != NULL);
+		continueFlag = (gProjectInfoPtr->knnDataValuesPtr != NULL ||
+										gProjectInfoPtr->trainingStoreValueBytes > 0);
 		/*
 				// This needs more thought and work.
 	  	numberStorageSets = gProjectInfoPtr->numberStorageStatFields;
@@ -4269,6 +4363,8 @@ SInt16 UpdateFieldAreaStats (
 	
 	HPFieldIdentifiersPtr			fieldIdentPtr;
 	
+	SInt64								firstSample;
+	
 	UInt32								fieldStatsIndex;
 	UInt16								numberChannels;
 	SInt16								returnCode;
@@ -4326,21 +4422,38 @@ SInt16 UpdateFieldAreaStats (
 			// field.																				
 	
 	GetFieldBoundary (gProjectInfoPtr, &gAreaDescription, fieldNumber);
-															
-	returnCode = GetAreaStats (fileIOInstructionsPtr, 
-										fieldChanPtr, 
-										fieldSumSquaresPtr, 
-										(UInt16*)gProjectInfoPtr->channelsPtr, 
-										numberChannels, 
-										fileIOInstructionsPtr->fileInfoPtr->noDataValueFlag, 
-										gProjectInfoPtr->statisticsCode,
-										NULL,
-										NULL);
+	
+			// The training pixel values for the field are copied from the previous
+			// training pixel store if the field has not changed. Otherwise they
+			// are read from the image file.
+	
+	firstSample = gProjectInfoPtr->knnCounter;
+	if (loadPixelDataFlag && LoadTrainingStoreFieldSamples (
+										fieldNumber, (UInt16)gAreaDescription.classNumber))
+		{
+		gAreaDescription.numSamplesPerChan = gProjectInfoPtr->knnCounter - firstSample;
+		returnCode = 1;
+		
+		}	// end "if (loadPixelDataFlag && LoadTrainingStoreFieldSamples (..."
+	
+	else	// !loadPixelDataFlag || !LoadTrainingStoreFieldSamples (...
+		returnCode = GetAreaStats (fileIOInstructionsPtr, 
+											fieldChanPtr, 
+											fieldSumSquaresPtr, 
+											(UInt16*)gProjectInfoPtr->channelsPtr, 
+											numberChannels, 
+											fileIOInstructionsPtr->fileInfoPtr->noDataValueFlag, 
+											gProjectInfoPtr->statisticsCode,
+											NULL,
+											NULL);
 	
 	if (returnCode	== 1)
 		{
 		fieldIdentPtr->numberPixelsUsedForStats = gAreaDescription.numSamplesPerChan;
 		
+		if (loadPixelDataFlag)
+			SetTrainingStoreField (fieldNumber, firstSample);
+		
 		if (!loadPixelDataFlag)
 			{
 					// Compute the first order statistics.
@@ -4495,15 +4608,11 @@ SInt16 UpdateProjectMaskStats (
 				SInt16								statCode)
 
 {
-	knnType 								knnSamp;
-	
 	double								dValue,
 											maxDataValue,
 											minDataValue,
 											noDataValue;
 	
-	double*								knnDataValuesPtr;
-	
 	HDoublePtr							bufferPtr,
 											bufferPtr2,
 											tOutputBufferPtr;
@@ -4610,9 +4719,6 @@ SInt16 UpdateProjectMaskStats (
 	maxDataValue = gImageWindowInfoPtr->maxUsableDataValue;
 	lastMaskValue = 0;
 	
-	knnSamp.distance = 0;
-	knnSamp.index = 0;
-	
 	fieldClassStatsCode = kFieldStatsOnly;
 	if (gProjectInfoPtr->keepClassStatsOnlyFlag)
 		fieldClassStatsCode = kClassStatsOnly;
@@ -4730,13 +4836,6 @@ SInt16 UpdateProjectMaskStats (
 			
 			}	// end "if (checkForBadDataFlag)"
 	
-		if (statCode == kPixelValuesOnly)
-			{
-			knnDataValuesPtr = &gProjectInfoPtr->knnDataValuesPtr [
-													numberChannels * gProjectInfoPtr->knnCounter];
-			
-			}	// end "if (statCode == kPixelValuesOnly)"
-	
 				// Loop through the lines for the project image.										
 		
 		updateNumberLinesFlag = TRUE;
@@ -4884,26 +4983,10 @@ SInt16 UpdateProjectMaskStats (
 						
 							if (statCode == kPixelValuesOnly)
 								{
-										// KNN training samples
+										// KNN training sample and SVM label. The values are
+										// kept in memory or in the training pixel store file.
 
-								for (channel=0; channel<numberChannels; channel++)
-									{
-											// KNN sample data in the training
-									
-									*knnDataValuesPtr = *bufferPtr;
-
-									bufferPtr++;
-									knnDataValuesPtr++;
-									
-									}	// end "for (channel=1; channel<numberChannels..."
-							
-										// SVM labelling in the training phase
-								
-								gProjectInfoPtr->knnDistancesPtr[
-												gProjectInfoPtr->knnCounter] = knnSamp;
-								gProjectInfoPtr->knnLabelsPtr[
-												gProjectInfoPtr->knnCounter] = classNumber + 1;
-								gProjectInfoPtr->knnCounter++;
+								AddTrainingPixelSample (bufferPtr, classNumber + 1);
 								
 								}	// end "if (statCode == kPixelValuesOnly)"
 							
@@ -5365,6 +5448,22 @@ SInt16 UpdateStatsControl (
 							break;
 							
 						}	// end "switch (statsWindowMode)"
+					
+							// Complete the training pixel store file if it is being used
+							// for the pixel values. The file is not completed if the
+							// loading of the values was not finished.
+					
+					if (loadPixelDataFlag && gProjectInfoPtr->trainingStoreValueBytes > 0)
+						{
+						if (returnCode != 1 || !FinishTrainingStore ())
+							{
+							ClearPixelDataMemory (kDisposePointers);
+							if (returnCode == 1)
+								returnCode = 0;
+							
+							}	// end "if (returnCode != 1 || !FinishTrainingStore ())"
+						
+						}	// end "if (loadPixelDataFlag && ...->trainingStoreValueBytes > 0)"
 						
 							// Update any leave one out covariance parameters if needed.
 					
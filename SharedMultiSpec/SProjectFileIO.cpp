@@ -63,6 +63,9 @@ Template for debugging
 			// Prototypes for routines in this file that are only called by		
 			// other routines in this file.													
 
+void ClosePreviousTrainingStore (
+				ProjectInfoPtr						projectInfoPtr);
+
 void ComputeSumSquaresMatrix (
 				UInt32								numberChannels,
 				HChannelStatisticsPtr			channelStatsPtr, 
@@ -94,6 +97,30 @@ UInt16 GetLengthOfMaxSumOfSquares (
 Boolean GetProjectFileName (
 				SInt16								saveCode);
 
+UInt32 GetTrainingStoreCheckSum (
+				SInt64*								imageFileSizePtr,
+				UInt32*								channelCheckSumPtr);
+
+UInt32 GetTrainingStoreFieldKey (
+				SInt16								fieldNumber);
+
+UInt32 GetTrainingStoreImageCheckSum (
+				CMFileStream*						fileStreamPtr,
+				SInt64								fileSize);
+
+CMFileStream* GetTrainingStoreFileStream (void);
+
+HUCharPtr MapTrainingStoreValues (
+				CMFileStream*						storeFileStreamPtr,
+				SInt64								numberValueBytes,
+				HUCharPtr*							bufferPtrPtr);
+
+Boolean OpenPreviousTrainingStore (
+				SInt16								valueBytes);
+
+void ReadBinaryFieldStatsIndex (
+				CMFileStream*						fileStreamPtr);
+
 SInt16 ReadChannelInformation (
 				HChannelStatisticsPtr			chanStatsPtr,
 				UCharPtr* 							inputStringPtrPtr,
@@ -148,6 +175,12 @@ UCharPtr ReadStringFromFile (
 				SInt16								numberSkipTabs,
 				SInt16								maxStringLength);
 
+SInt16 SetupBinaryFieldStatistics (
+				HPClassNamesPtr					classNamesPtr,
+				SInt16								storageIndex,
+				SInt16								binaryStatsCode,
+				Boolean*								statsLoadedFlagPtr);
+
 SInt16 SetupForStatisticsRead (
 				ParmBlkPtr							paramBlockPtr,
 				UCharPtr								inputStringPtr,
@@ -171,6 +204,11 @@ void UpdateGraphicStatusBox (
 void VerifyClassAndFieldParameters (
 				Boolean								differentFileSourceFlag);
 
+Boolean WriteBinaryFieldStatsBlock (
+				CMFileStream*						fileStreamPtr,
+				SInt16*								fieldListPtr,
+				UInt32								numberFields);
+
 Boolean WriteChannelInformation (
 				HChannelStatisticsPtr			chanStatsPtr,
 				CMFileStream* 						fileStreamPtr,
@@ -249,6 +287,100 @@ void CloseFile (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void ClosePreviousTrainingStore
+//
+//	Software purpose:	The purpose of this routine is to close the previous training
+//							pixel store which was opened to copy the values for fields
+//							which have not changed and release the memory used for it.
+//
+//	Parameters in:		Project information structure pointer.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			CloseTrainingStore in SProjectFileIO.cpp
+//							FinishTrainingStore in SProjectFileIO.cpp
+//							OpenPreviousTrainingStore in SProjectFileIO.cpp
+
+void ClosePreviousTrainingStore (
+				ProjectInfoPtr						projectInfoPtr)
+
+{
+	if (projectInfoPtr != NULL)
+		{
+		projectInfoPtr->previousStoreFileStreamPtr = 
+						DisposeCMFileStream (projectInfoPtr->previousStoreFileStreamPtr);
+		
+		projectInfoPtr->previousStoreBufferPtr = (HUCharPtr)CheckAndDisposePtr (
+												(Ptr)projectInfoPtr->previousStoreBufferPtr);
+		
+		projectInfoPtr->previousStoreFieldsPtr = (TrainingStoreFieldPtr)
+							CheckAndDisposePtr ((Ptr)projectInfoPtr->previousStoreFieldsPtr);
+		
+		projectInfoPtr->previousStoreValuesPtr = NULL;
+		projectInfoPtr->numberPreviousStoreFields = 0;
+		
+		}	// end "if (projectInfoPtr != NULL)"
+	
+}	// end "ClosePreviousTrainingStore"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void CloseTrainingStore
+//
+//	Software purpose:	The purpose of this routine is to close the training pixel
+//							store (.knn) file for the project and release the memory
+//							used for it. The file itself is left beside the project file
+//							so that it can be used again.
+//
+//	Parameters in:		Project information structure pointer.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			ClearPixelDataMemory in SEditStatistics.cpp
+//							ReleaseProjectHandles in SProject.cpp
+//							CreateTrainingStore in SProjectFileIO.cpp
+//							FinishTrainingStore in SProjectFileIO.cpp
+
+void CloseTrainingStore (
+				ProjectInfoPtr						projectInfoPtr)
+
+{
+	if (projectInfoPtr != NULL)
+		{
+				// Closing the file also removes any memory mapping of the file.
+				
+		projectInfoPtr->trainingStoreFileStreamPtr = 
+						DisposeCMFileStream (projectInfoPtr->trainingStoreFileStreamPtr);
+		
+		projectInfoPtr->trainingStoreBufferPtr = (HUCharPtr)CheckAndDisposePtr (
+												(Ptr)projectInfoPtr->trainingStoreBufferPtr);
+		
+		projectInfoPtr->trainingStoreValuesPtr = NULL;
+		projectInfoPtr->trainingStoreBufferSamples = 0;
+		projectInfoPtr->trainingStoreErrCode = noErr;
+		projectInfoPtr->trainingStoreValueBytes = 0;
+		
+		projectInfoPtr->trainingStoreFieldsPtr = (TrainingStoreFieldPtr)
+							CheckAndDisposePtr ((Ptr)projectInfoPtr->trainingStoreFieldsPtr);
+		
+		ClosePreviousTrainingStore (projectInfoPtr);
+		
+		}	// end "if (projectInfoPtr != NULL)"
+	
+}	// end "CloseTrainingStore"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -395,6 +527,365 @@ void ComputeSumVector (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean CreateTrainingStore
+//
+//	Software purpose:	The purpose of this routine is to create the training pixel
+//							store (.knn) file beside the project file for the training
+//							pixel values when they are too large to keep in memory. The
+//							values are written to the file by AddTrainingPixelSample as
+//							they are loaded and the file is completed by
+//							FinishTrainingStore. The store is not used if the project has
+//							not been saved to a file yet, if the values would take less
+//							than kTrainingStoreMinimumBytes or if the file cannot be
+//							created. The store is only used on little endian systems so
+//							that the values can be used directly from the file.
+//							The existing store file is opened first as the previous store
+//							so that the values for fields which have not changed can be
+//							copied from it.
+//
+//	Parameters in:		Number of training pixels in the project.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	TRUE if the training pixel store is being used.
+//							FALSE if the values are to be kept in memory.
+//
+// Called By:			SetupPixelMemory in SProjectComputeStatistics.cpp
+
+Boolean CreateTrainingStore (
+				SInt64								numberTrainPixels)
+
+{
+	char									headerBuffer[kTrainingStoreHeaderBytes];
+	
+	CMFileStream*						storeFileStreamPtr;
+	
+	UInt32								count,
+											index,
+											numberChannels;
+	
+	SInt16								errCode,
+											valueBytes;
+	
+	
+	if (!gUseTrainingStoreFlag || gBigEndianFlag)
+																					return (FALSE);
+	
+	numberChannels = gProjectInfoPtr->numberStatisticsChannels;
+	valueBytes = 8;
+	if (gTrainingStoreFloatFlag)
+		valueBytes = 4;
+	
+	if (numberTrainPixels * numberChannels * valueBytes < kTrainingStoreMinimumBytes)
+																					return (FALSE);
+	
+	storeFileStreamPtr = GetTrainingStoreFileStream ();
+	if (storeFileStreamPtr == NULL)
+																					return (FALSE);
+	
+			// Get the index and values of the existing store file before it is
+			// replaced. The existing file is deleted instead of being overwritten
+			// so that a memory mapping of it stays valid while the new file is
+			// being written.
+	
+	if (OpenPreviousTrainingStore (valueBytes))
+		MDeleteFile (storeFileStreamPtr, kNoErrorMessages);
+	
+	errCode = CreateNewFile (storeFileStreamPtr, 
+						GetVolumeReferenceNumber (GetFileStreamPointer (gProjectInfoPtr)), 
+						gCreator, 
+						kNoErrorMessages, 
+						kReplaceFlag);
+	
+			// Write a cleared header. It is not a valid header until the file is
+			// completed by FinishTrainingStore.
+	
+	if (errCode == noErr)
+		{
+		memset (headerBuffer, 0, kTrainingStoreHeaderBytes);
+		count = kTrainingStoreHeaderBytes;
+		errCode = MWriteData (storeFileStreamPtr, &count, headerBuffer, kNoErrorMessages);
+		
+		}	// end "if (errCode == noErr)"
+	
+	gProjectInfoPtr->trainingStoreFileStreamPtr = storeFileStreamPtr;
+	
+	if (errCode == noErr)
+		{
+		gProjectInfoPtr->trainingStoreBufferPtr = (HUCharPtr)MNewPointer (
+							(SInt64)kTrainingStoreBufferSamples * numberChannels * valueBytes);
+		
+		gProjectInfoPtr->trainingStoreFieldsPtr = (TrainingStoreFieldPtr)MNewPointer (
+							gProjectInfoPtr->numberStorageFields * sizeof (TrainingStoreField));
+		
+		if (gProjectInfoPtr->trainingStoreBufferPtr == NULL || 
+											gProjectInfoPtr->trainingStoreFieldsPtr == NULL)
+			errCode = -1;
+			
+		}	// end "if (errCode == noErr)"
+	
+			// Indicate that the samples for none of the fields are in the store yet.
+	
+	if (errCode == noErr)
+		{
+		for (index=0; index<(UInt32)gProjectInfoPtr->numberStorageFields; index++)
+			gProjectInfoPtr->trainingStoreFieldsPtr[index].numberSamples = -1;
+		
+		}	// end "if (errCode == noErr)"
+	
+	if (errCode != noErr)
+		{
+		CloseTrainingStore (gProjectInfoPtr);
+																					return (FALSE);
+		
+		}	// end "if (errCode != noErr)"
+	
+	gProjectInfoPtr->trainingStoreBufferSamples = 0;
+	gProjectInfoPtr->trainingStoreErrCode = noErr;
+	gProjectInfoPtr->trainingStoreValueBytes = valueBytes;
+	
+	return (TRUE);
+	
+}	// end "CreateTrainingStore"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean FinishTrainingStore
+//
+//	Software purpose:	The purpose of this routine is to complete the training pixel
+//							store (.knn) file after all of the training pixel values
+//							have been loaded and then map the values in the file into
+//							memory for the classifiers. The values in the header are 
+//							stored in little endian byte order.
+//
+//								Bytes  0-  7: 'MSPECKNN'
+//								Bytes  8- 11: version
+//								Bytes 12- 15: bytes per value; 4 (float) or 8 (double)
+//								Bytes 16- 19: number of channels per sample
+//								Bytes 20- 23: check sum of the training fields and channels
+//								Bytes 24- 31: number of samples
+//								Bytes 32- 39: file offset of the labels
+//								Bytes 40- 47: size of the project image file in bytes
+//								Bytes 48- 55: file offset of the field index
+//								Bytes 56- 59: number of field index entries
+//								Bytes 60- 63: check sum of the image files and channels
+//
+//							The values for each sample, channel by channel, start at
+//							byte 64. A 2-byte class label for each sample follows the
+//							values. The field index follows the labels. Each 24-byte
+//							entry is the key for the field (4 bytes), 4 reserved bytes,
+//							the first sample for the field (8 bytes) and the number of
+//							samples for the field (8 bytes).
+//
+//	Parameters in:		None
+//
+//	Parameters out:	None
+//
+//	Value Returned:	TRUE if the training pixel store is ready to be used or if
+//								it is not being used.
+//							FALSE if the file could not be completed.
+//
+// Called By:			UpdateStatsControl in SProjectComputeStatistics.cpp
+
+Boolean FinishTrainingStore (void)
+
+{
+	char									headerBuffer[kTrainingStoreHeaderBytes];
+	
+	CMFileStream*						storeFileStreamPtr;
+	char*									fieldIndexPtr;
+	TrainingStoreFieldPtr			storeFieldsPtr;
+	
+	SInt64								fieldIndexOffset,
+											imageFileSize,
+											labelsOffset,
+											numberSamples,
+											tempSInt64;
+	
+	SInt32								tempSInt32;
+	
+	UInt32								channelCheckSum,
+											checkSum,
+											count,
+											index,
+											numberFieldEntries;
+	
+	SInt16								errCode;
+	
+	
+	if (gProjectInfoPtr->trainingStoreValueBytes == 0)
+																					return (TRUE);
+	
+			// The previous store is not needed any more.
+	
+	ClosePreviousTrainingStore (gProjectInfoPtr);
+	
+	storeFileStreamPtr = gProjectInfoPtr->trainingStoreFileStreamPtr;
+	
+			// Write the rest of the values and then the labels.
+	
+	WriteTrainingStoreBuffer ();
+	errCode = gProjectInfoPtr->trainingStoreErrCode;
+	
+	numberSamples = gProjectInfoPtr->knnCounter;
+	labelsOffset = kTrainingStoreHeaderBytes + numberSamples *
+							gProjectInfoPtr->numberStatisticsChannels *
+											gProjectInfoPtr->trainingStoreValueBytes;
+	
+	if (errCode == noErr && numberSamples > 0)
+		{
+		count = (UInt32)(numberSamples * sizeof (UInt16));
+		errCode = MWriteData (storeFileStreamPtr, 
+										&count, 
+										gProjectInfoPtr->knnLabelsPtr, 
+										kNoErrorMessages);
+		
+		}	// end "if (errCode == noErr && numberSamples > 0)"
+	
+			// Write the index of the samples for each field which was loaded
+			// separately.
+	
+	gSwapBytesFlag = gBigEndianFlag;
+	storeFieldsPtr = gProjectInfoPtr->trainingStoreFieldsPtr;
+	fieldIndexOffset = labelsOffset + numberSamples * sizeof (UInt16);
+	numberFieldEntries = 0;
+	
+	if (errCode == noErr)
+		{
+		fieldIndexPtr = (char*)MNewPointer ((SInt64)
+					gProjectInfoPtr->numberStorageFields * kTrainingStoreFieldEntryBytes);
+		
+		if (fieldIndexPtr != NULL)
+			{
+			memset (fieldIndexPtr, 
+						0, 
+						gProjectInfoPtr->numberStorageFields * kTrainingStoreFieldEntryBytes);
+			
+			count = 0;
+			for (index=0; index<(UInt32)gProjectInfoPtr->numberStorageFields; index++)
+				{
+				if (storeFieldsPtr[index].numberSamples >= 0)
+					{
+					tempSInt32 = GetLongIntValue ((char*)&storeFieldsPtr[index].key);
+					BlockMoveData ((char*)&tempSInt32, &fieldIndexPtr[count], 4);
+					
+					tempSInt64 = GetLongInt64Value (
+											(char*)&storeFieldsPtr[index].firstSample);
+					BlockMoveData ((char*)&tempSInt64, &fieldIndexPtr[count+8], 8);
+					
+					tempSInt64 = GetLongInt64Value (
+											(char*)&storeFieldsPtr[index].numberSamples);
+					BlockMoveData ((char*)&tempSInt64, &fieldIndexPtr[count+16], 8);
+					
+					count += kTrainingStoreFieldEntryBytes;
+					numberFieldEntries++;
+					
+					}	// end "if (storeFieldsPtr[index].numberSamples >= 0)"
+				
+				}	// end "for (index=0; index<...->numberStorageFields; index++)"
+			
+			if (count > 0)
+				errCode = MWriteData (
+								storeFileStreamPtr, &count, fieldIndexPtr, kNoErrorMessages);
+			
+			CheckAndDisposePtr (fieldIndexPtr);
+			
+			}	// end "if (fieldIndexPtr != NULL)"
+		
+		}	// end "if (errCode == noErr)"
+		
+			// Now write the header to indicate that the file is complete.
+			
+	if (errCode == noErr)
+		{
+		gSwapBytesFlag = gBigEndianFlag;
+		
+		memset (headerBuffer, 0, kTrainingStoreHeaderBytes);
+		BlockMoveData ((char*)kTrainingStoreIdentifier, headerBuffer, 8);
+		
+		tempSInt32 = kTrainingStoreVersion;
+		tempSInt32 = GetLongIntValue ((char*)&tempSInt32);
+		BlockMoveData ((char*)&tempSInt32, &headerBuffer[8], 4);
+		
+		tempSInt32 = gProjectInfoPtr->trainingStoreValueBytes;
+		tempSInt32 = GetLongIntValue ((char*)&tempSInt32);
+		BlockMoveData ((char*)&tempSInt32, &headerBuffer[12], 4);
+		
+		tempSInt32 = gProjectInfoPtr->numberStatisticsChannels;
+		tempSInt32 = GetLongIntValue ((char*)&tempSInt32);
+		BlockMoveData ((char*)&tempSInt32, &headerBuffer[16], 4);
+		
+		checkSum = GetTrainingStoreCheckSum (&imageFileSize, &channelCheckSum);
+		tempSInt32 = GetLongIntValue ((char*)&checkSum);
+		BlockMoveData ((char*)&tempSInt32, &headerBuffer[20], 4);
+		
+		tempSInt64 = GetLongInt64Value ((char*)&numberSamples);
+		BlockMoveData ((char*)&tempSInt64, &headerBuffer[24], 8);
+		
+		tempSInt64 = GetLongInt64Value ((char*)&labelsOffset);
+		BlockMoveData ((char*)&tempSInt64, &headerBuffer[32], 8);
+		
+		tempSInt64 = GetLongInt64Value ((char*)&imageFileSize);
+		BlockMoveData ((char*)&tempSInt64, &headerBuffer[40], 8);
+		
+		if (numberFieldEntries > 0)
+			{
+			tempSInt64 = GetLongInt64Value ((char*)&fieldIndexOffset);
+			BlockMoveData ((char*)&tempSInt64, &headerBuffer[48], 8);
+			
+			tempSInt32 = GetLongIntValue ((char*)&numberFieldEntries);
+			BlockMoveData ((char*)&tempSInt32, &headerBuffer[56], 4);
+			
+			}	// end "if (numberFieldEntries > 0)"
+		
+		tempSInt32 = GetLongIntValue ((char*)&channelCheckSum);
+		BlockMoveData ((char*)&tempSInt32, &headerBuffer[60], 4);
+		
+		errCode = MSetMarker (storeFileStreamPtr, fsFromStart, 0, kNoErrorMessages);
+		
+		count = kTrainingStoreHeaderBytes;
+		if (errCode == noErr)
+			errCode = MWriteData (
+							storeFileStreamPtr, &count, headerBuffer, kNoErrorMessages);
+		
+		}	// end "if (errCode == noErr)"
+		
+	CloseFile (storeFileStreamPtr);
+	
+	gProjectInfoPtr->trainingStoreBufferPtr = (HUCharPtr)CheckAndDisposePtr (
+												(Ptr)gProjectInfoPtr->trainingStoreBufferPtr);
+	
+	gProjectInfoPtr->trainingStoreFieldsPtr = (TrainingStoreFieldPtr)
+							CheckAndDisposePtr ((Ptr)gProjectInfoPtr->trainingStoreFieldsPtr);
+	
+	if (errCode == noErr && numberSamples > 0)
+		{
+		gProjectInfoPtr->trainingStoreValuesPtr = MapTrainingStoreValues (
+												storeFileStreamPtr,
+												labelsOffset - kTrainingStoreHeaderBytes,
+												&gProjectInfoPtr->trainingStoreBufferPtr);
+		
+		if (gProjectInfoPtr->trainingStoreValuesPtr != NULL)
+																					return (TRUE);
+		
+		errCode = -1;
+		
+		}	// end "if (errCode == noErr && numberSamples > 0)"
+	
+	CloseTrainingStore (gProjectInfoPtr);
+	
+	return (errCode == noErr);
+	
+}	// end "FinishTrainingStore"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -1019,71 +1510,397 @@ Boolean GetProjectFileName (
 }	// end "GetProjectFileName"
 
 
-                   
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
-//	Function name:		SInt32 GetSizeOfProjectFile
+//	Function name:		UInt32 GetTrainingStoreCheckSum
 //
-//	Software purpose:	The purpose of this routine is to compute a
-//							reasonable estimate of the size of the project file.
+//	Software purpose:	The purpose of this routine is to compute a check sum of the
+//							project image file name, the start and end of the data in
+//							each of the project image files, the project channels and
+//							the class and coordinates of each training field. It is used
+//							to verify that a training pixel store (.knn) file goes with
+//							the current image data and training fields.
 //
 //	Parameters in:		None
 //
-//	Parameters out:	None
+//	Parameters out:	Size of the project image file in bytes; 0 if not known.
+//							Check sum of only the image files and project channels.
 //
-// Value Returned:	None	
-// 
-// Called By:	
+//	Value Returned:	The check sum.
 //
-//	Coded By:			Larry L. Biehl			Date: 01/06/199
-//	Revised By:			Larry L. Biehl			Date: 06/04/1996	
+// Called By:			FinishTrainingStore in SProjectFileIO.cpp
+//							OpenPreviousTrainingStore in SProjectFileIO.cpp
+//							OpenTrainingStore in SProjectFileIO.cpp
 
-SInt32 GetSizeOfProjectFile (void)
+UInt32 GetTrainingStoreCheckSum (
+				SInt64*								imageFileSizePtr,
+				UInt32*								channelCheckSumPtr)
 
 {
-	WindowInfoPtr						projectWindowInfoPtr;
+	FileInfoPtr							fileInfoPtr;
+	HPClassNamesPtr					classNamesPtr;
+	HPFieldIdentifiersPtr			fieldIdentPtr;
 	
-	UInt32								fileSize,
-											numberChannels,
-											numberCovarianceEntries;
-											
-	UInt16								maxLengthOfValue,
-											maxSizeOfSumOfSquares,
-											maxSizeOfSum;
+	SInt64								fileSize;
 	
-	SignedByte							handleStatus;
+	UInt32								checkSum,
+											classIndex,
+											classStorage,
+											fileIndex,
+											index,
+											numberImageFiles;
 	
+	SInt16								fieldNumber;
 	
-			// Get the project window pointer.												
-			
-	projectWindowInfoPtr = (WindowInfoPtr)GetHandleStatusAndPointer (
-											gProjectInfoPtr->windowInfoHandle, &handleStatus);
 	
-			// Initialize local variables														
+	classNamesPtr = gProjectInfoPtr->classNamesPtr;
+	fieldIdentPtr = gProjectInfoPtr->fieldIdentPtr;
+	checkSum = 0;
 	
-	maxLengthOfValue = 14;
-	numberChannels = gProjectInfoPtr->numberStatisticsChannels;
-	numberCovarianceEntries = gProjectInfoPtr->numberCovarianceEntries;
-	maxSizeOfSumOfSquares = GetLengthOfMaxSumOfSquares (projectWindowInfoPtr) + 1;
-	maxSizeOfSum = GetLengthOfMaxSum (projectWindowInfoPtr) + 1;
+	for (index=1; index<=gProjectInfoPtr->imageFileName[0]; index++)
+		checkSum = 31 * checkSum + gProjectInfoPtr->imageFileName[index];
 	
-	MHSetState (gProjectInfoPtr->windowInfoHandle, handleStatus);
+	for (index=0; index<gProjectInfoPtr->numberStatisticsChannels; index++)
+		checkSum = 31 * checkSum + gProjectInfoPtr->channelsPtr[index];
 	
-			// Size of 'P' lines.																
+			// The size of the project image file and the data at the start and end
+			// of each of the image files are used to help verify that the image data
+			// have not changed. The file name and size are not enough since an image
+			// file can be rewritten with new data of the same size.
+	
+	*imageFileSizePtr = 0;
+	fileInfoPtr = (FileInfoPtr)GetHandlePointer (
+								GetFileInfoHandle (gProjectInfoPtr->windowInfoHandle));
+	
+	if (fileInfoPtr != NULL)
+		{
+		numberImageFiles = GetNumberImageFiles (gProjectInfoPtr->windowInfoHandle);
+		for (fileIndex=0; fileIndex<numberImageFiles; fileIndex++)
+			{
+			fileSize = 0;
+			GetSizeOfFile (&fileInfoPtr[fileIndex], &fileSize);
 			
-	fileSize = 	32 + 
-						281 + gProjectInfoPtr->imageFileName[0] +
-							100 +
-								4 + 4 * numberChannels;
+			if (fileIndex == 0)
+				*imageFileSizePtr = fileSize;
+			
+			checkSum = 31 * checkSum + GetTrainingStoreImageCheckSum (
+									GetFileStreamPointer (&fileInfoPtr[fileIndex]), fileSize);
+			
+			}	// end "for (fileIndex=0; fileIndex<numberImageFiles; fileIndex++)"
+		
+		}	// end "if (fileInfoPtr != NULL)"
 	
-			// Size of 'Training Statistics' line.											
-					
-	fileSize +=	20;
+	*channelCheckSumPtr = checkSum;
 	
-			// Size of 'C1' lines.																
-					
-	fileSize +=	61 * gProjectInfoPtr->numberStatisticsClasses;
+			// Include the training fields in the order that they are loaded.
+	
+	for (classIndex=0; 
+			classIndex<gProjectInfoPtr->numberStatisticsClasses; 
+			classIndex++)
+		{
+		classStorage = gProjectInfoPtr->storageClass[classIndex];
+		checkSum = 31 * checkSum + (UInt16)classNamesPtr[classStorage].classNumber;
+		
+		fieldNumber = classNamesPtr[classStorage].firstFieldNumber;
+		while (fieldNumber != -1)
+			{
+			if (fieldIdentPtr[fieldNumber].fieldType == kTrainingType)
+				checkSum = 31 * checkSum + GetTrainingStoreFieldKey (fieldNumber);
+				
+			fieldNumber = fieldIdentPtr[fieldNumber].nextField;
+			
+			}	// end "while (fieldNumber != -1)"
+		
+		}	// end "for (classIndex=0; classIndex<..."
+		
+	return (checkSum);
+	
+}	// end "GetTrainingStoreCheckSum"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		UInt32 GetTrainingStoreFieldKey
+//
+//	Software purpose:	The purpose of this routine is to compute the key for the
+//							training pixel values of a field in the training pixel store
+//							(.knn) file from the type and coordinates of the field. The key
+//							changes when the field is edited so the values for the field
+//							in the store will then not be used.
+//
+//	Parameters in:		Field storage number.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	The key.
+//
+// Called By:			GetTrainingStoreCheckSum in SProjectFileIO.cpp
+//							LoadTrainingStoreFieldSamples in SProjectFileIO.cpp
+//							SetTrainingStoreField in SProjectFileIO.cpp
+
+UInt32 GetTrainingStoreFieldKey (
+				SInt16								fieldNumber)
+
+{
+	HPFieldIdentifiersPtr			fieldIdentPtr;
+	HPFieldPointsPtr					fieldPointsPtr;
+	
+	UInt32								index,
+											key,
+											numberPoints,
+											pointIndex;
+	
+	
+	fieldIdentPtr = &gProjectInfoPtr->fieldIdentPtr[fieldNumber];
+	fieldPointsPtr = gProjectInfoPtr->fieldPointsPtr;
+	
+	key = (UInt16)fieldIdentPtr->pointType;
+	key = 31 * key + fieldIdentPtr->maskValue;
+	key = 31 * key + (UInt32)fieldIdentPtr->numberPixels;
+	
+	numberPoints = 0;
+	if (fieldIdentPtr->pointType == kRectangleType)
+		numberPoints = 2;
+		
+	else if (fieldIdentPtr->pointType == kPolygonType)
+				// Allow for the bounding rectangle at the start of the list.
+		numberPoints = fieldIdentPtr->numberOfPolygonPoints + 2;
+	
+	pointIndex = fieldIdentPtr->firstPolygonPoint;
+	for (index=0; index<numberPoints; index++)
+		{
+		key = 31 * key + (UInt32)fieldPointsPtr[pointIndex].line;
+		key = 31 * key + (UInt32)fieldPointsPtr[pointIndex].col;
+		pointIndex++;
+		
+		}	// end "for (index=0; index<numberPoints; index++)"
+	
+	return (key);
+	
+}	// end "GetTrainingStoreFieldKey"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		UInt32 GetTrainingStoreImageCheckSum
+//
+//	Software purpose:	The purpose of this routine is to compute a check sum of the
+//							first and last kTrainingStoreImageCheckBytes bytes in the
+//							specified image file. It is included in the training pixel
+//							store check sums so that a store is not used after the image
+//							file has been rewritten with different data.
+//
+//	Parameters in:		File stream for the image file.
+//							Size of the image file in bytes.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	The check sum; 0 if the file could not be read.
+//
+// Called By:			GetTrainingStoreCheckSum in SProjectFileIO.cpp
+
+UInt32 GetTrainingStoreImageCheckSum (
+				CMFileStream*						fileStreamPtr,
+				SInt64								fileSize)
+
+{
+	UInt8									buffer[kTrainingStoreImageCheckBytes];
+	
+	SInt64								offset;
+	
+	UInt32								checkSum,
+											count,
+											index,
+											part;
+	
+	SInt16								errCode;
+	
+	Boolean								closeFileFlag;
+	
+	
+	if (fileStreamPtr == NULL || fileSize <= 0)
+																					return (0);
+	
+	errCode = noErr;
+	closeFileFlag = FALSE;
+	checkSum = 0;
+	
+	if (!FileOpen (fileStreamPtr))
+		{
+		errCode = OpenFileReadOnly (fileStreamPtr,
+											kDontResolveAliasChains,
+											kNoLockFile,
+											kDoNotVerifyFileStream);
+		
+		closeFileFlag = TRUE;
+		
+		}	// end "if (!FileOpen (fileStreamPtr))"
+	
+			// Read the bytes at the start of the file and then those at the end.
+	
+	count = (UInt32)MIN (fileSize, kTrainingStoreImageCheckBytes);
+	for (part=0; part<2 && errCode==noErr; part++)
+		{
+		offset = 0;
+		if (part == 1)
+			offset = fileSize - count;
+		
+		errCode = MSetMarker (fileStreamPtr, fsFromStart, offset, kNoErrorMessages);
+		
+		if (errCode == noErr)
+			errCode = MReadData (fileStreamPtr, &count, buffer, kNoErrorMessages);
+		
+		if (errCode == noErr)
+			{
+			for (index=0; index<count; index++)
+				checkSum = 31 * checkSum + buffer[index];
+			
+			}	// end "if (errCode == noErr)"
+		
+		}	// end "for (part=0; part<2 && errCode==noErr; part++)"
+	
+	if (closeFileFlag)
+		CloseFile (fileStreamPtr);
+	
+	if (errCode != noErr)
+		checkSum = 0;
+	
+	return (checkSum);
+	
+}	// end "GetTrainingStoreImageCheckSum"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		CMFileStream* GetTrainingStoreFileStream
+//
+//	Software purpose:	The purpose of this routine is to get a file stream for the
+//							training pixel store (.knn) file for the project. The file
+//							has the same name as the project file with .knn appended
+//							and is in the same folder as the project file.
+//
+//	Parameters in:		None
+//
+//	Parameters out:	None
+//
+//	Value Returned:	The file stream; NULL if the project has not been saved to a
+//								file or memory is not available.
+//
+// Called By:			CreateTrainingStore in SProjectFileIO.cpp
+//							OpenPreviousTrainingStore in SProjectFileIO.cpp
+//							OpenTrainingStore in SProjectFileIO.cpp
+
+CMFileStream* GetTrainingStoreFileStream (void)
+
+{
+	CMFileStream*						projectFileStreamPtr;
+	CMFileStream*						storeFileStreamPtr;
+	FileStringPtr						storeFileNamePtr;
+	
+	
+	projectFileStreamPtr = GetFileStreamPointer (gProjectInfoPtr);
+	if (!FileExists (projectFileStreamPtr))
+																					return (NULL);
+	
+	storeFileStreamPtr = InitializeFileStream ((CMFileStream*)NULL);
+	
+	if (storeFileStreamPtr != NULL)
+		{
+		InitializeFileStream (storeFileStreamPtr, projectFileStreamPtr);
+		
+		storeFileNamePtr = 
+				(FileStringPtr)GetFilePathPPointerFromFileStream (storeFileStreamPtr);
+		ConcatFilenameSuffix (storeFileNamePtr, (StringPtr)"\0.knn\0");
+			
+		#if defined multispec_mac
+					// Force the uniFileName to be recreated to match the store file name.
+		
+			storeFileStreamPtr->uniFileName.length = 0;
+		#endif	// defined multispec_mac
+		
+		SetType (storeFileStreamPtr, kBINAFileType);
+		
+		}	// end "if (storeFileStreamPtr != NULL)"
+	
+	return (storeFileStreamPtr);
+	
+}	// end "GetTrainingStoreFileStream"
+
+
+
+                   
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt32 GetSizeOfProjectFile
+//
+//	Software purpose:	The purpose of this routine is to compute a
+//							reasonable estimate of the size of the project file.
+//
+//	Parameters in:		None
+//
+//	Parameters out:	None
+//
+// Value Returned:	None	
+// 
+// Called By:	
+//
+//	Coded By:			Larry L. Biehl			Date: 01/06/199
+//	Revised By:			Larry L. Biehl			Date: 06/04/1996	
+
+SInt32 GetSizeOfProjectFile (void)
+
+{
+	WindowInfoPtr						projectWindowInfoPtr;
+	
+	UInt32								fileSize,
+											numberChannels,
+											numberCovarianceEntries;
+											
+	UInt16								maxLengthOfValue,
+											maxSizeOfSumOfSquares,
+											maxSizeOfSum;
+	
+	SignedByte							handleStatus;
+	
+	
+			// Get the project window pointer.												
+			
+	projectWindowInfoPtr = (WindowInfoPtr)GetHandleStatusAndPointer (
+											gProjectInfoPtr->windowInfoHandle, &handleStatus);
+	
+			// Initialize local variables														
+	
+	maxLengthOfValue = 14;
+	numberChannels = gProjectInfoPtr->numberStatisticsChannels;
+	numberCovarianceEntries = gProjectInfoPtr->numberCovarianceEntries;
+	maxSizeOfSumOfSquares = GetLengthOfMaxSumOfSquares (projectWindowInfoPtr) + 1;
+	maxSizeOfSum = GetLengthOfMaxSum (projectWindowInfoPtr) + 1;
+	
+	MHSetState (gProjectInfoPtr->windowInfoHandle, handleStatus);
+	
+			// Size of 'P' lines.																
+			
+	fileSize = 	32 + 
+						281 + gProjectInfoPtr->imageFileName[0] +
+							100 +
+								4 + 4 * numberChannels;
+	
+			// Size of 'Training Statistics' line.											
+					
+	fileSize +=	20;
+	
+			// Size of 'C1' lines.																
+					
+	fileSize +=	61 * gProjectInfoPtr->numberStatisticsClasses;
 	
 			// Size of 'F1' lines.																
 					
@@ -1126,57 +1943,1016 @@ SInt32 GetSizeOfProjectFile (void)
 			fileSize += gProjectInfoPtr->numberStatTrainClasses * 
 																	2 * (3 + 6 * numberChannels);
 		
-		if (gProjectInfoPtr->saveFieldMeansCovFlag)
+		if (gProjectInfoPtr->saveFieldMeansCovFlag)
+			{
+					// Size of 'FM' line.														
+				
+			fileSize += gProjectInfoPtr->numberStatTrainFields * 
+														(3 + maxLengthOfValue * numberChannels);
+					
+					// Size of 'FV' lines.														
+					
+			fileSize += gProjectInfoPtr->numberStatTrainFields * 
+						(3 * numberChannels + maxLengthOfValue * numberCovarianceEntries);
+					
+			}	// end "if (gProjectInfoPtr->saveFieldMeansCovFlag)" 
+		
+		if (gProjectInfoPtr->saveFieldSumsSquaresFlag)
+			{
+					// Size of 'FS' lines.														
+					
+			fileSize += gProjectInfoPtr->numberStatTrainFields *
+																(3 + maxSizeOfSum * numberChannels);
+					
+					// Size of 'FSS' lines.														
+					
+			fileSize += gProjectInfoPtr->numberStatTrainFields * 
+				(4 * numberChannels + maxSizeOfSumOfSquares * numberCovarianceEntries);
+					
+			}	// end "if (gProjectInfoPtr->saveFieldSumsSquaresFlag)" 
+			
+				// Size of 'FN', 'FX' lines.													
+			
+		if (gProjectInfoPtr->saveFieldMeansCovFlag || 
+													gProjectInfoPtr->saveFieldSumsSquaresFlag)
+			fileSize += gProjectInfoPtr->numberStatTrainFields * 
+																		2 * (3 + 6 * numberChannels);
+																	
+		}	// end "if (gProjectInfoPtr->fieldSumSquaresStatsPtr)" 
+		
+			// Size of 'V1' lines.																
+		
+	fileSize += 15 * gProjectInfoPtr->numberTotalPoints;
+	
+			// Size of 'Test Fields' line.													
+					
+	fileSize +=	12;
+					
+	return (fileSize);
+
+}	// end "GetSizeOfProjectFile" 
+
+
+                   
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean LoadBinaryFieldStatistics
+//
+//	Software purpose:	The purpose of this routine is to load the statistics for the
+//							input field statistics storage index from the binary block at
+//							the end of the project file if they have not been loaded yet.
+//							If the input storage index is less than 0, the statistics for
+//							all fields that have not been loaded yet are loaded and the
+//							vector of file offsets is released.
+//
+//	Parameters in:		Field statistics storage index. -1 for all fields.
+//
+//	Parameters out:	None
+//
+// Value Returned:	TRUE if the statistics were loaded or nothing needed to be
+//								loaded.
+//							FALSE if the statistics could not be loaded.
+// 
+// Called By:			GetProjectStatisticsPointers in SProject.cpp
+//							SaveProjectFile in SProjectFileIO.cpp
+//							CreateStatisticsImages in SStatisticsImage.cpp
+
+Boolean LoadBinaryFieldStatistics (
+				SInt32								storageIndex)
+
+{
+	SInt64								numberPixels,
+											offset,
+											savedMarker;
+	
+	CMFileStream*						projectFileStreamPtr;
+	HChannelStatisticsPtr			chanStatsPtr;
+	HDoublePtr							recordBufferPtr;
+	HPFieldIdentifiersPtr			fieldIdentPtr;
+	HSumSquaresStatisticsPtr		sumSquaresStatsPtr;
+	
+	SInt32								firstIndex,
+											index,
+											lastIndex;
+	
+	UInt32								channel,
+											count,
+											numberChannels,
+											numberCovarianceEntries,
+											numberRecordBytes;
+	
+	SInt16								errCode,
+											field;
+	
+	Boolean								closeFileFlag,
+											continueFlag,
+											fileOpenFlag,
+											restoreMarkerFlag;
+	
+	
+	if (gProjectInfoPtr == NULL || 
+								gProjectInfoPtr->fieldStatsBinaryOffsetsPtr == NULL)
+																							return (TRUE);
+	
+	if (storageIndex >= 0)
+		{
+		if (storageIndex >= gProjectInfoPtr->numberFieldStatsBinaryOffsets ||
+					gProjectInfoPtr->fieldStatsBinaryOffsetsPtr[storageIndex] == 0)
+																							return (TRUE);
+																							
+		firstIndex = lastIndex = storageIndex;
+		
+		}	// end "if (storageIndex >= 0)"
+		
+	else	// storageIndex < 0
+		{
+		firstIndex = 0;
+		lastIndex = gProjectInfoPtr->numberFieldStatsBinaryOffsets - 1;
+		
+		}	// end "else storageIndex < 0"
+	
+	numberChannels = gProjectInfoPtr->numberStatisticsChannels;
+	numberCovarianceEntries = gProjectInfoPtr->numberCovarianceEntries;
+	numberRecordBytes = 8 + 8 * (3 * numberChannels + numberCovarianceEntries);
+	
+	recordBufferPtr = NULL;
+	if (gProjectInfoPtr->fieldChanStatsPtr != NULL && 
+										gProjectInfoPtr->fieldSumSquaresStatsPtr != NULL)
+		recordBufferPtr = (HDoublePtr)MNewPointer (numberRecordBytes);
+		
+			// If only one field was requested, leave it to be loaded later. If all
+			// fields were requested, the statistics that cannot be loaded will be
+			// recomputed.
+			
+	if (recordBufferPtr == NULL && storageIndex >= 0)
+																							return (FALSE);
+	
+			// Open the project file if needed. If the file is already open, save the
+			// current position in the file so that it can be restored.
+	
+	projectFileStreamPtr = GetFileStreamPointer (gProjectInfoPtr);
+	fileOpenFlag = FileOpen (projectFileStreamPtr);
+	savedMarker = 0;
+	errCode = -1;
+	
+	if (recordBufferPtr != NULL)
+		{
+		if (fileOpenFlag)
+			errCode = MGetMarker (projectFileStreamPtr, &savedMarker, kNoErrorMessages);
+			
+		else	// !fileOpenFlag
+			errCode = OpenFileReadOnly (projectFileStreamPtr, 
+													kResolveAliasChains, 
+													kNoLockFile, 
+													kDoNotVerifyFileStream);
+													
+		}	// end "if (recordBufferPtr != NULL)"
+	
+	continueFlag = (errCode == noErr);
+	closeFileFlag = (continueFlag && !fileOpenFlag);
+	restoreMarkerFlag = (continueFlag && fileOpenFlag);
+	
+	for (index=firstIndex; index<=lastIndex; index++)
+		{
+		offset = gProjectInfoPtr->fieldStatsBinaryOffsetsPtr[index];
+		if (offset == 0)
+			continue;
+			
+		gProjectInfoPtr->fieldStatsBinaryOffsetsPtr[index] = 0;
+		
+		if (continueFlag)
+			{
+			errCode = MSetMarker (projectFileStreamPtr, 
+											fsFromStart, 
+											offset, 
+											kNoErrorMessages);
+			
+			if (errCode == noErr)
+				{
+				count = numberRecordBytes;
+				errCode = MReadData (projectFileStreamPtr, 
+											&count, 
+											recordBufferPtr, 
+											kNoErrorMessages);
+				
+				}	// end "if (errCode == noErr)"
+				
+			}	// end "if (continueFlag)"
+			
+		if (continueFlag && errCode == noErr)
+			{
+					// The values are stored in little endian byte order.
+					
+			if (gBigEndianFlag)
+				SwapBytes (8, 
+								(HUInt8Ptr)recordBufferPtr, 
+								1 + 3 * numberChannels + numberCovarianceEntries);
+			
+			BlockMoveData (recordBufferPtr, &numberPixels, 8);
+			
+			chanStatsPtr = &gProjectInfoPtr->fieldChanStatsPtr[index * numberChannels];
+			sumSquaresStatsPtr = &gProjectInfoPtr->fieldSumSquaresStatsPtr[
+																	index * numberCovarianceEntries];
+			
+			for (channel=0; channel<numberChannels; channel++)
+				{
+				chanStatsPtr[channel].sum = recordBufferPtr[1 + channel];
+				chanStatsPtr[channel].minimum = 
+												recordBufferPtr[1 + numberChannels + channel];
+				chanStatsPtr[channel].maximum = 
+											recordBufferPtr[1 + 2 * numberChannels + channel];
+				
+				}	// end "for (channel=0; channel<numberChannels; channel++)"
+				
+			BlockMoveData (&recordBufferPtr[1 + 3 * numberChannels], 
+								sumSquaresStatsPtr, 
+								8 * numberCovarianceEntries);
+			
+			ComputeMeanStdDevVector (chanStatsPtr, 
+												sumSquaresStatsPtr,
+												(UInt16)numberChannels, 
+												numberPixels,
+												gProjectInfoPtr->statisticsCode,
+												kTriangleInputMatrix);
+			
+			}	// end "if (continueFlag && errCode == noErr)"
+			
+		else	// !continueFlag || errCode != noErr
+			{
+					// The statistics could not be read. Force the statistics for the
+					// field to be recomputed.
+					
+			fieldIdentPtr = gProjectInfoPtr->fieldIdentPtr;
+			for (field=0; field<gProjectInfoPtr->numberStorageFields; field++)
+				{
+				if (fieldIdentPtr[field].trainingStatsNumber == index)
+					{
+					fieldIdentPtr[field].statsUpToDate = FALSE;
+					fieldIdentPtr[field].loadedIntoClassStats = FALSE;
+					gProjectInfoPtr->classNamesPtr[
+								fieldIdentPtr[field].classStorage].statsUpToDate = FALSE;
+					gProjectInfoPtr->statsUpToDate = FALSE;
+					
+					}	// end "if (fieldIdentPtr[field].trainingStatsNumber == index)"
+					
+				}	// end "for (field=0; field<...->numberStorageFields; field++)"
+			
+			if (storageIndex >= 0)
+				continueFlag = FALSE;
+			
+			}	// end "else !continueFlag || errCode != noErr"
+			
+		}	// end "for (index=firstIndex; index<=lastIndex; index++)"
+	
+	if (restoreMarkerFlag)
+		MSetMarker (projectFileStreamPtr, fsFromStart, savedMarker, kNoErrorMessages);
+		
+	else if (closeFileFlag)
+		CloseFile (projectFileStreamPtr);
+		
+	CheckAndDisposePtr ((Ptr)recordBufferPtr);
+	
+	if (storageIndex < 0)
+		{
+		gProjectInfoPtr->fieldStatsBinaryOffsetsPtr = (SInt64*)CheckAndDisposePtr (
+										(Ptr)gProjectInfoPtr->fieldStatsBinaryOffsetsPtr);
+		gProjectInfoPtr->numberFieldStatsBinaryOffsets = 0;
+		
+		}	// end "if (storageIndex < 0)"
+	
+	return (continueFlag);
+	
+}	// end "LoadBinaryFieldStatistics"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean LoadTrainingStoreFieldSamples
+//
+//	Software purpose:	The purpose of this routine is to copy the training pixel
+//							values for the specified field from the previous training
+//							pixel store to the store being written if the field has not
+//							changed since the previous store was written. The image file
+//							then does not need to be read for the field.
+//
+//	Parameters in:		Field storage number.
+//							Class label for the training pixels.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	TRUE if the values for the field were copied.
+//							FALSE if the values need to be read from the image file.
+//
+// Called By:			UpdateFieldAreaStats in SProjectComputeStatistics.cpp
+
+Boolean LoadTrainingStoreFieldSamples (
+				UInt16								fieldNumber,
+				UInt16								label)
+
+{
+	HDoublePtr							doubleValuesPtr,
+											workVectorPtr;
+	
+	float*								floatValuesPtr;
+	TrainingStoreFieldPtr			previousFieldPtr;
+	
+	SInt64								lastSample,
+											sample;
+	
+	UInt32								channel,
+											index,
+											key,
+											numberChannels;
+	
+	
+	if (gProjectInfoPtr->previousStoreValuesPtr == NULL ||
+											gProjectInfoPtr->trainingStoreFieldsPtr == NULL)
+																					return (FALSE);
+	
+			// Find the field in the index of the previous store.
+	
+	key = GetTrainingStoreFieldKey (fieldNumber);
+	previousFieldPtr = NULL;
+	for (index=0; index<gProjectInfoPtr->numberPreviousStoreFields; index++)
+		{
+		if (gProjectInfoPtr->previousStoreFieldsPtr[index].key == key)
+			{
+			previousFieldPtr = &gProjectInfoPtr->previousStoreFieldsPtr[index];
+			break;
+			
+			}	// end "if (...->previousStoreFieldsPtr[index].key == key)"
+		
+		}	// end "for (index=0; index<...->numberPreviousStoreFields; index++)"
+	
+	if (previousFieldPtr == NULL || previousFieldPtr->numberSamples >
+							gProjectInfoPtr->fieldIdentPtr[fieldNumber].numberPixels)
+																					return (FALSE);
+	
+	numberChannels = gProjectInfoPtr->numberStatisticsChannels;
+	workVectorPtr = (HDoublePtr)MNewPointer (numberChannels * sizeof (double));
+	if (workVectorPtr == NULL)
+																					return (FALSE);
+	
+	doubleValuesPtr = (HDoublePtr)gProjectInfoPtr->previousStoreValuesPtr;
+	floatValuesPtr = (float*)gProjectInfoPtr->previousStoreValuesPtr;
+	
+	lastSample = previousFieldPtr->firstSample + previousFieldPtr->numberSamples;
+	for (sample=previousFieldPtr->firstSample; sample<lastSample; sample++)
+		{
+		if (gProjectInfoPtr->trainingStoreValueBytes == 4)
+			{
+			for (channel=0; channel<numberChannels; channel++)
+				workVectorPtr[channel] = floatValuesPtr[sample * numberChannels + channel];
+			
+			}	// end "if (gProjectInfoPtr->trainingStoreValueBytes == 4)"
+		
+		else	// gProjectInfoPtr->trainingStoreValueBytes == 8
+			{
+			for (channel=0; channel<numberChannels; channel++)
+				workVectorPtr[channel] = doubleValuesPtr[sample * numberChannels + channel];
+			
+			}	// end "else gProjectInfoPtr->trainingStoreValueBytes == 8"
+		
+		AddTrainingPixelSample (workVectorPtr, label);
+		
+		}	// end "for (sample=previousFieldPtr->firstSample; ..."
+	
+	CheckAndDisposePtr ((Ptr)workVectorPtr);
+	
+	if (previousFieldPtr->numberSamples > 0)
+		gProjectInfoPtr->pixelDataLoadedFlag = TRUE;
+	
+	return (TRUE);
+	
+}	// end "LoadTrainingStoreFieldSamples"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		HUCharPtr MapTrainingStoreValues
+//
+//	Software purpose:	The purpose of this routine is to map the training pixel
+//							values in the training pixel store (.knn) file into memory
+//							read only so that the classifiers use them directly from the
+//							file. If the file cannot be mapped, a copy of the values is
+//							read into memory.
+//
+//	Parameters in:		File stream for the training pixel store.
+//							Number of bytes of training pixel values in the file.
+//
+//	Parameters out:	Memory for the copy of the values if one was read.
+//
+//	Value Returned:	Pointer to the values; NULL if they are not available.
+//
+// Called By:			FinishTrainingStore in SProjectFileIO.cpp
+//							OpenPreviousTrainingStore in SProjectFileIO.cpp
+//							OpenTrainingStore in SProjectFileIO.cpp
+
+HUCharPtr MapTrainingStoreValues (
+				CMFileStream*						storeFileStreamPtr,
+				SInt64								numberValueBytes,
+				HUCharPtr*							bufferPtrPtr)
+
+{
+	HUCharPtr							bufferPtr,
+											valuesPtr;
+	
+	SInt64								bytesToRead;
+	
+	UInt32								count;
+	
+	SInt16								errCode;
+	
+	
+	valuesPtr = NULL;
+	
+	errCode = OpenFileReadOnly (storeFileStreamPtr, 
+											kResolveAliasChains, 
+											kNoLockFile, 
+											kVerifyFileStream);
+	if (errCode != noErr)
+																					return (NULL);
+	
+	#if defined multispec_wx
+				// The size of the file has already been verified to be large enough
+				// for all of the values.
+				
+		if (storeFileStreamPtr->MMapFile () == noErr)
+			valuesPtr = storeFileStreamPtr->GetMappedDataPointer (
+										kTrainingStoreHeaderBytes,
+										(UInt32)MIN (numberValueBytes, UInt32_MAX));
+	#endif	// defined multispec_wx
+	
+	if (valuesPtr == NULL)
+		{
+				// Read the values into memory in pieces of no more than 1 gigabyte.
+				
+		*bufferPtrPtr = (HUCharPtr)MNewPointer (numberValueBytes);
+		bufferPtr = *bufferPtrPtr;
+		
+		errCode = -1;
+		if (bufferPtr != NULL)
+			errCode = MSetMarker (storeFileStreamPtr, 
+											fsFromStart, 
+											kTrainingStoreHeaderBytes, 
+											kNoErrorMessages);
+		
+		bytesToRead = numberValueBytes;
+		while (errCode == noErr && bytesToRead > 0)
+			{
+			count = (UInt32)MIN (bytesToRead, 1073741824);
+			errCode = MReadData (storeFileStreamPtr, &count, bufferPtr, kNoErrorMessages);
+			
+			bufferPtr += count;
+			bytesToRead -= count;
+			
+			}	// end "while (errCode == noErr && bytesToRead > 0)"
+		
+		CloseFile (storeFileStreamPtr);
+		
+		if (errCode == noErr)
+			valuesPtr = *bufferPtrPtr;
+		
+		}	// end "if (valuesPtr == NULL)"
+	
+	return (valuesPtr);
+	
+}	// end "MapTrainingStoreValues"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean OpenPreviousTrainingStore
+//
+//	Software purpose:	The purpose of this routine is to open the existing training
+//							pixel store (.knn) file beside the project file as the previous
+//							store before a new store is written. The index of the samples
+//							for each field is read and the values are mapped into memory
+//							so that the values for fields which have not changed can be
+//							copied by LoadTrainingStoreFieldSamples. The previous store is
+//							only used if it was written for the same image data and
+//							channels with the same size of values.
+//
+//	Parameters in:		Bytes per value for the new store.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	TRUE if the previous store is ready to be used.
+//
+// Called By:			CreateTrainingStore in SProjectFileIO.cpp
+
+Boolean OpenPreviousTrainingStore (
+				SInt16								valueBytes)
+
+{
+	char									headerBuffer[kTrainingStoreHeaderBytes];
+	
+	CMFileStream*						storeFileStreamPtr;
+	char*									fieldIndexPtr;
+	TrainingStoreFieldPtr			previousFieldsPtr;
+	
+	SInt64								fieldIndexOffset,
+											fileSize,
+											imageFileSize,
+											labelsOffset,
+											numberSamples;
+	
+	UInt32								channelCheckSum,
+											count,
+											index,
+											numberChannels,
+											numberFieldEntries;
+	
+	SInt16								errCode;
+	
+	Boolean								validFlag;
+	
+	
+	ClosePreviousTrainingStore (gProjectInfoPtr);
+	
+	storeFileStreamPtr = GetTrainingStoreFileStream ();
+	if (storeFileStreamPtr == NULL)
+																					return (FALSE);
+	
+	validFlag = FALSE;
+	fieldIndexPtr = NULL;
+	numberChannels = gProjectInfoPtr->numberStatisticsChannels;
+	numberFieldEntries = 0;
+	fieldIndexOffset = 0;
+	labelsOffset = 0;
+	
+	errCode = OpenFileReadOnly (storeFileStreamPtr, 
+											kResolveAliasChains, 
+											kNoLockFile, 
+											kVerifyFileStream);
+	
+	if (errCode == noErr)
+		{
+		count = kTrainingStoreHeaderBytes;
+		errCode = MReadData (storeFileStreamPtr, &count, headerBuffer, kNoErrorMessages);
+		
+		}	// end "if (errCode == noErr)"
+	
+	if (errCode == noErr && 
+						strncmp (headerBuffer, kTrainingStoreIdentifier, 8) == 0)
+		{
+		gSwapBytesFlag = gBigEndianFlag;
+		
+		numberSamples = GetLongInt64Value (&headerBuffer[24]);
+		labelsOffset = GetLongInt64Value (&headerBuffer[32]);
+		fieldIndexOffset = GetLongInt64Value (&headerBuffer[48]);
+		numberFieldEntries = (UInt32)GetLongIntValue (&headerBuffer[56]);
+		
+		GetTrainingStoreCheckSum (&imageFileSize, &channelCheckSum);
+		errCode = GetSizeOfFile (storeFileStreamPtr, &fileSize);
+		
+		if (errCode == noErr &&
+				GetLongIntValue (&headerBuffer[8]) == kTrainingStoreVersion &&
+					GetLongIntValue (&headerBuffer[12]) == valueBytes &&
+						(UInt32)GetLongIntValue (&headerBuffer[16]) == numberChannels &&
+							(UInt32)GetLongIntValue (&headerBuffer[60]) == channelCheckSum &&
+								GetLongInt64Value (&headerBuffer[40]) == imageFileSize &&
+									numberSamples > 0 &&
+										numberFieldEntries > 0 &&
+											labelsOffset == kTrainingStoreHeaderBytes + 
+													numberSamples * numberChannels * valueBytes &&
+												fieldIndexOffset == labelsOffset +
+													numberSamples * (SInt64)sizeof (UInt16) &&
+													fileSize >= fieldIndexOffset + 
+														(SInt64)numberFieldEntries *
+																	kTrainingStoreFieldEntryBytes)
+			validFlag = TRUE;
+		
+		}	// end "if (errCode == noErr && strncmp (headerBuffer, ..."
+	
+			// Read the index of the samples for each field.
+	
+	if (validFlag)
+		{
+		fieldIndexPtr = (char*)MNewPointer (
+								(SInt64)numberFieldEntries * kTrainingStoreFieldEntryBytes);
+		
+		gProjectInfoPtr->previousStoreFieldsPtr = (TrainingStoreFieldPtr)MNewPointer (
+								(SInt64)numberFieldEntries * sizeof (TrainingStoreField));
+		
+		errCode = -1;
+		if (fieldIndexPtr != NULL && gProjectInfoPtr->previousStoreFieldsPtr != NULL)
+			errCode = MSetMarker (
+						storeFileStreamPtr, fsFromStart, fieldIndexOffset, kNoErrorMessages);
+		
+		count = numberFieldEntries * kTrainingStoreFieldEntryBytes;
+		if (errCode == noErr)
+			errCode = MReadData (
+							storeFileStreamPtr, &count, fieldIndexPtr, kNoErrorMessages);
+		
+		validFlag = (errCode == noErr);
+		
+		}	// end "if (validFlag)"
+	
+	if (validFlag)
+		{
+		previousFieldsPtr = gProjectInfoPtr->previousStoreFieldsPtr;
+		for (index=0; index<numberFieldEntries; index++)
+			{
+			count = index * kTrainingStoreFieldEntryBytes;
+			previousFieldsPtr[index].key = 
+										(UInt32)GetLongIntValue (&fieldIndexPtr[count]);
+			previousFieldsPtr[index].firstSample = 
+										GetLongInt64Value (&fieldIndexPtr[count+8]);
+			previousFieldsPtr[index].numberSamples = 
+										GetLongInt64Value (&fieldIndexPtr[count+16]);
+			
+			if (previousFieldsPtr[index].firstSample < 0 ||
+					previousFieldsPtr[index].numberSamples < 0 ||
+						previousFieldsPtr[index].firstSample + 
+									previousFieldsPtr[index].numberSamples > numberSamples)
+				validFlag = FALSE;
+			
+			}	// end "for (index=0; index<numberFieldEntries; index++)"
+		
+		}	// end "if (validFlag)"
+	
+	CheckAndDisposePtr (fieldIndexPtr);
+	CloseFile (storeFileStreamPtr);
+	
+	if (validFlag)
+		{
+		gProjectInfoPtr->previousStoreFileStreamPtr = storeFileStreamPtr;
+		gProjectInfoPtr->numberPreviousStoreFields = numberFieldEntries;
+		storeFileStreamPtr = NULL;
+		
+		gProjectInfoPtr->previousStoreValuesPtr = MapTrainingStoreValues (
+												gProjectInfoPtr->previousStoreFileStreamPtr,
+												labelsOffset - kTrainingStoreHeaderBytes,
+												&gProjectInfoPtr->previousStoreBufferPtr);
+		
+		validFlag = (gProjectInfoPtr->previousStoreValuesPtr != NULL);
+		
+		}	// end "if (validFlag)"
+	
+	storeFileStreamPtr = DisposeCMFileStream (storeFileStreamPtr);
+	
+	if (!validFlag)
+		ClosePreviousTrainingStore (gProjectInfoPtr);
+	
+	return (validFlag);
+	
+}	// end "OpenPreviousTrainingStore"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean OpenTrainingStore
+//
+//	Software purpose:	The purpose of this routine is to load the training pixel
+//							values from the training pixel store (.knn) file beside the
+//							project file if it exists and was written for the current
+//							training fields, project channels and project image file. The
+//							values are then used from the file and the image file does
+//							not need to be read. See FinishTrainingStore for the layout of
+//							the file.
+//
+//	Parameters in:		None
+//
+//	Parameters out:	None
+//
+//	Value Returned:	TRUE if the training pixel values were loaded from the file.
+//
+// Called By:			FeatureExtraction in SFeatureExtraction.cpp
+//							VerifyProjectTrainingPixelsLoaded in SProjectUtilities.cpp
+
+Boolean OpenTrainingStore (void)
+
+{
+	char									headerBuffer[kTrainingStoreHeaderBytes];
+	
+	CMFileStream*						storeFileStreamPtr;
+	
+	SInt64								fileSize,
+											imageFileSize,
+											labelsOffset,
+											numberSamples;
+	
+	UInt32								channelCheckSum,
+											checkSum,
+											count,
+											numberChannels;
+	
+	SInt16								errCode,
+											valueBytes;
+	
+	Boolean								validFlag;
+	
+	
+	if (!gUseTrainingStoreFlag || gBigEndianFlag)
+																					return (FALSE);
+	
+			// The counts of the training pixels used for each field come from the
+			// statistics. The file is not used if they are not current.
+	
+	if (!gProjectInfoPtr->statsUpToDate)
+																					return (FALSE);
+	
+	storeFileStreamPtr = GetTrainingStoreFileStream ();
+	if (storeFileStreamPtr == NULL)
+																					return (FALSE);
+	
+	validFlag = FALSE;
+	numberChannels = gProjectInfoPtr->numberStatisticsChannels;
+	
+	errCode = OpenFileReadOnly (storeFileStreamPtr, 
+											kResolveAliasChains, 
+											kNoLockFile, 
+											kVerifyFileStream);
+	
+	if (errCode == noErr)
+		{
+		count = kTrainingStoreHeaderBytes;
+		errCode = MReadData (storeFileStreamPtr, &count, headerBuffer, kNoErrorMessages);
+		
+		}	// end "if (errCode == noErr)"
+	
+	if (errCode == noErr && 
+						strncmp (headerBuffer, kTrainingStoreIdentifier, 8) == 0)
+		{
+		gSwapBytesFlag = gBigEndianFlag;
+		
+		valueBytes = (SInt16)GetLongIntValue (&headerBuffer[12]);
+		numberSamples = GetLongInt64Value (&headerBuffer[24]);
+		labelsOffset = GetLongInt64Value (&headerBuffer[32]);
+		
+		checkSum = GetTrainingStoreCheckSum (&imageFileSize, &channelCheckSum);
+		errCode = GetSizeOfFile (storeFileStreamPtr, &fileSize);
+		
+		if (errCode == noErr &&
+				GetLongIntValue (&headerBuffer[8]) == kTrainingStoreVersion &&
+					(valueBytes == 4 || valueBytes == 8) &&
+						(UInt32)GetLongIntValue (&headerBuffer[16]) == numberChannels &&
+							(UInt32)GetLongIntValue (&headerBuffer[20]) == checkSum &&
+								GetLongInt64Value (&headerBuffer[40]) == imageFileSize &&
+									numberSamples * numberChannels * valueBytes >=
+																kTrainingStoreMinimumBytes &&
+										numberSamples <= SInt32_MAX &&
+											labelsOffset == kTrainingStoreHeaderBytes + 
+														numberSamples * numberChannels * valueBytes &&
+												fileSize >= labelsOffset + 
+														numberSamples * (SInt64)sizeof (UInt16))
+			validFlag = TRUE;
+		
+		}	// end "if (errCode == noErr && strncmp (headerBuffer, ..."
+	
+	if (validFlag)
+		{
+				// Release any training pixel values in memory and get memory for the
+				// labels and distances.
+				
+		ClearPixelDataMemory (kDisposePointers);
+		
+		gProjectInfoPtr->knnDistancesPtr =
+								(knnType*)MNewPointer (numberSamples * sizeof (knnType));
+		
+		if (gProjectInfoPtr->knnDistancesPtr != NULL)
+			gProjectInfoPtr->knnLabelsPtr =
+								(UInt16*)MNewPointer (numberSamples * sizeof (UInt16));
+		
+		errCode = -1;
+		if (gProjectInfoPtr->knnLabelsPtr != NULL)
+			errCode = MSetMarker (
+							storeFileStreamPtr, fsFromStart, labelsOffset, kNoErrorMessages);
+		
+		count = (UInt32)(numberSamples * sizeof (UInt16));
+		if (errCode == noErr)
+			errCode = MReadData (storeFileStreamPtr, 
+											&count, 
+											gProjectInfoPtr->knnLabelsPtr, 
+											kNoErrorMessages);
+		
+		validFlag = (errCode == noErr);
+		
+		}	// end "if (validFlag)"
+	
+	CloseFile (storeFileStreamPtr);
+	
+	if (validFlag)
+		{
+		gProjectInfoPtr->trainingStoreFileStreamPtr = storeFileStreamPtr;
+		gProjectInfoPtr->trainingStoreValueBytes = valueBytes;
+		storeFileStreamPtr = NULL;
+		
+		gProjectInfoPtr->trainingStoreValuesPtr = MapTrainingStoreValues (
+												gProjectInfoPtr->trainingStoreFileStreamPtr,
+												labelsOffset - kTrainingStoreHeaderBytes,
+												&gProjectInfoPtr->trainingStoreBufferPtr);
+		
+		if (gProjectInfoPtr->trainingStoreValuesPtr != NULL)
+			{
+			gProjectInfoPtr->knnCounter = (int)numberSamples;
+			gProjectInfoPtr->pixelDataLoadedFlag = TRUE;
+			
+			}	// end "if (gProjectInfoPtr->trainingStoreValuesPtr != NULL)"
+		
+		else	// gProjectInfoPtr->trainingStoreValuesPtr == NULL
+			validFlag = FALSE;
+		
+		}	// end "if (validFlag)"
+	
+	storeFileStreamPtr = DisposeCMFileStream (storeFileStreamPtr);
+	
+	if (!validFlag && gProjectInfoPtr->knnDistancesPtr != NULL)
+		ClearPixelDataMemory (kDisposePointers);
+	
+	return (validFlag);
+	
+}	// end "OpenTrainingStore"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void ReadBinaryFieldStatsIndex
+//
+//	Software purpose:	The purpose of this routine is to read the index of file
+//							offsets for the field statistics in the binary block at the end
+//							of the project file if one exists. The statistics themselves are
+//							not read until they are needed. See WriteBinaryFieldStatsBlock
+//							for the layout of the block.
+//
+//	Parameters in:		File stream pointer for the project file.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+// 
+// Called By:			ReadProjectFile in SProjectFileIO.cpp
+
+void ReadBinaryFieldStatsIndex (
+				CMFileStream*						fileStreamPtr)
+
+{
+	char									headerBuffer[kBinaryProjectStatsHeaderBytes],
+											trailerBuffer[kBinaryProjectStatsTrailerBytes];
+	
+	SInt64								blockStart,
+											fileSize,
+											savedMarker;
+											
+	SInt64*								offsetsPtr;
+	
+	SInt32								headerValues[5];
+	
+	UInt32								count,
+											index,
+											numberEntries,
+											numberOffsets,
+											numberRecordBytes;
+	
+	SInt16								errCode;
+	
+	
+	gProjectInfoPtr->fieldStatsBinaryOffsetsPtr = (SInt64*)CheckAndDisposePtr (
+										(Ptr)gProjectInfoPtr->fieldStatsBinaryOffsetsPtr);
+	gProjectInfoPtr->numberFieldStatsBinaryOffsets = 0;
+	
+	errCode = GetSizeOfFile (fileStreamPtr, &fileSize);
+	if (errCode != noErr || fileSize < 
+						kBinaryProjectStatsHeaderBytes + kBinaryProjectStatsTrailerBytes)
+																								return;
+	
+	errCode = MGetMarker (fileStreamPtr, &savedMarker, kNoErrorMessages);
+	if (errCode != noErr)
+																								return;
+	
+	offsetsPtr = NULL;
+	
+			// Read the trailer at the end of the file which contains the start of
+			// the binary block.
+	
+	errCode = MSetMarker (fileStreamPtr, 
+									fsFromStart, 
+									fileSize - kBinaryProjectStatsTrailerBytes, 
+									kNoErrorMessages);
+	
+	if (errCode == noErr)
+		{
+		count = kBinaryProjectStatsTrailerBytes;
+		errCode = MReadData (fileStreamPtr, &count, trailerBuffer, kNoErrorMessages);
+		
+		}	// end "if (errCode == noErr)"
+		
+	if (errCode == noErr && 
+					strncmp (&trailerBuffer[8], kBinaryProjectStatsIdentifier, 8) != 0)
+		errCode = -1;
+		
+	if (errCode == noErr)
+		{
+		BlockMoveData (trailerBuffer, &blockStart, 8);
+		if (gBigEndianFlag)
+			SwapBytes (8, (HUInt8Ptr)&blockStart, 1);
+			
+		if (blockStart <= 0 || blockStart > fileSize - 
+						kBinaryProjectStatsHeaderBytes - kBinaryProjectStatsTrailerBytes)
+			errCode = -1;
+		
+		}	// end "if (errCode == noErr)"
+		
+	if (errCode == noErr)
+		errCode = MSetMarker (fileStreamPtr, fsFromStart, blockStart, kNoErrorMessages);
+	
+	if (errCode == noErr)
+		{
+		count = kBinaryProjectStatsHeaderBytes;
+		errCode = MReadData (fileStreamPtr, &count, headerBuffer, kNoErrorMessages);
+		
+		}	// end "if (errCode == noErr)"
+		
+	if (errCode == noErr)
+		{
+				// Verify that the block agrees with the statistics for the project.
+				
+		BlockMoveData (&headerBuffer[8], headerValues, 20);
+		if (gBigEndianFlag)
+			SwapBytes (4, (HUInt8Ptr)headerValues, 5);
+			
+		numberEntries = (UInt32)headerValues[3];
+		numberRecordBytes = 8 + 8 * (3 * gProjectInfoPtr->numberStatisticsChannels + 
+														gProjectInfoPtr->numberCovarianceEntries);
+			
+		if (strncmp (headerBuffer, kBinaryProjectStatsIdentifier, 8) != 0 ||
+				headerValues[0] > kBinaryProjectStatsVersion ||
+				headerValues[1] != gProjectInfoPtr->numberStatisticsChannels ||
+				headerValues[2] != (SInt32)gProjectInfoPtr->numberCovarianceEntries ||
+				headerValues[4] != (SInt32)numberRecordBytes ||
+				numberEntries == 0 ||
+				blockStart + kBinaryProjectStatsHeaderBytes + 8 * (SInt64)numberEntries >
+														fileSize - kBinaryProjectStatsTrailerBytes)
+			errCode = -1;
+		
+		}	// end "if (errCode == noErr)"
+		
+	if (errCode == noErr)
+		{
+				// The index is ordered by the training fields in the project file which
+				// is the same as the order of the field statistics storage.
+				
+		numberOffsets = MAX (numberEntries, 
+									(UInt32)gProjectInfoPtr->numberStorageStatFields);
+		offsetsPtr = (SInt64*)MNewPointerClear (numberOffsets * sizeof (SInt64));
+		if (offsetsPtr == NULL)
+			errCode = -1;
+			
+		}	// end "if (errCode == noErr)"
+		
+	if (errCode == noErr)
+		{
+		count = 8 * numberEntries;
+		errCode = MReadData (fileStreamPtr, &count, offsetsPtr, kNoErrorMessages);
+		
+		}	// end "if (errCode == noErr)"
+		
+	if (errCode == noErr)
+		{
+		if (gBigEndianFlag)
+			SwapBytes (8, (HUInt8Ptr)offsetsPtr, numberEntries);
+			
+				// Ignore any offset that does not point to a complete record within 
+				// the block.
+				
+		for (index=0; index<numberEntries; index++)
 			{
-					// Size of 'FM' line.														
+			if (offsetsPtr[index] < blockStart + kBinaryProjectStatsHeaderBytes ||
+					offsetsPtr[index] + numberRecordBytes > 
+														fileSize - kBinaryProjectStatsTrailerBytes)
+				offsetsPtr[index] = 0;
 				
-			fileSize += gProjectInfoPtr->numberStatTrainFields * 
-														(3 + maxLengthOfValue * numberChannels);
-					
-					// Size of 'FV' lines.														
-					
-			fileSize += gProjectInfoPtr->numberStatTrainFields * 
-						(3 * numberChannels + maxLengthOfValue * numberCovarianceEntries);
-					
-			}	// end "if (gProjectInfoPtr->saveFieldMeansCovFlag)" 
+			}	// end "for (index=0; index<numberEntries; index++)"
 		
-		if (gProjectInfoPtr->saveFieldSumsSquaresFlag)
-			{
-					// Size of 'FS' lines.														
-					
-			fileSize += gProjectInfoPtr->numberStatTrainFields *
-																(3 + maxSizeOfSum * numberChannels);
-					
-					// Size of 'FSS' lines.														
-					
-			fileSize += gProjectInfoPtr->numberStatTrainFields * 
-				(4 * numberChannels + maxSizeOfSumOfSquares * numberCovarianceEntries);
-					
-			}	// end "if (gProjectInfoPtr->saveFieldSumsSquaresFlag)" 
-			
-				// Size of 'FN', 'FX' lines.													
-			
-		if (gProjectInfoPtr->saveFieldMeansCovFlag || 
-													gProjectInfoPtr->saveFieldSumsSquaresFlag)
-			fileSize += gProjectInfoPtr->numberStatTrainFields * 
-																		2 * (3 + 6 * numberChannels);
-																	
-		}	// end "if (gProjectInfoPtr->fieldSumSquaresStatsPtr)" 
+		gProjectInfoPtr->fieldStatsBinaryOffsetsPtr = offsetsPtr;
+		gProjectInfoPtr->numberFieldStatsBinaryOffsets = (SInt32)numberOffsets;
 		
-			// Size of 'V1' lines.																
+		}	// end "if (errCode == noErr)"
 		
-	fileSize += 15 * gProjectInfoPtr->numberTotalPoints;
+	else	// errCode != noErr
+		CheckAndDisposePtr ((Ptr)offsetsPtr);
+		
+			// Return to the position in the file where the text records are being
+			// read.
 	
-			// Size of 'Test Fields' line.													
-					
-	fileSize +=	12;
-					
-	return (fileSize);
+	MSetMarker (fileStreamPtr, fsFromStart, savedMarker, kNoErrorMessages);
+	
+}	// end "ReadBinaryFieldStatsIndex"
 
-}	// end "GetSizeOfProjectFile" 
 
 
-                   
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -1984,7 +3760,8 @@ SInt16 ReadProjectFile (void)
 											bufferBytes,
 											numberEndOfLineBytes;
 	
-	SInt16								channel,   
+	SInt16								binaryStatsCode,
+											channel,   
 											endOfLineCode,
 											field,
 											fieldIndex,
@@ -2524,6 +4301,12 @@ SInt16 ReadProjectFile (void)
 		binaryListingCode = 0;	
 		if (projectWindowInfoPtr->numberBytes >= 4)
 			binaryListingCode = 10;													
+		
+				// Get the index for the field statistics which may be stored in a
+				// binary block at the end of the file.
+				
+		if (!gProjectInfoPtr->keepClassStatsOnlyFlag)
+			ReadBinaryFieldStatsIndex (projectFileStreamPtr);
 	
 				// Read Class information for training statistics from disk file.	
 				
@@ -2764,14 +4547,15 @@ SInt16 ReadProjectFile (void)
 						
 				fieldIdentPtr->maskValue = 0;
 				fieldIdentPtr->numberPixelsUsedForStats = 0;
+				binaryStatsCode = 0;
 			
             sscanfReturnCode = sscanf (
             			(char*)inputStringPtr,
 							#if defined multispec_mac || defined multispec_win || defined multispec_mac_swift
-								"\t%hd\t%hd\t%hd\t%hd\t%lld\t%hd\t%hd\t%hd\t%lld\r",
+								"\t%hd\t%hd\t%hd\t%hd\t%lld\t%hd\t%hd\t%hd\t%lld\t%hd\r",
 							#endif
 							#if defined multispec_wx
-								"\t%hd\t%hd\t%hd\t%hd\t%lld\t%hd\t%hd\t%hd\t%lld\r",
+								"\t%hd\t%hd\t%hd\t%hd\t%lld\t%hd\t%hd\t%hd\t%lld\t%hd\r",
 							#endif
 							&fieldIdentPtr->numberOfPolygonPoints,
 							&fieldIdentPtr->classStorage,
@@ -2781,7 +4565,8 @@ SInt16 ReadProjectFile (void)
 							&intTemp,
 							&intTemp2,
 							&fieldIdentPtr->maskValue,
-							&fieldIdentPtr->numberPixelsUsedForStats);	// Added for 20130424 version);
+							&fieldIdentPtr->numberPixelsUsedForStats,	// Added for 20130424 version
+							&binaryStatsCode);	// Optional; binary statistics block
 				
 				if (gProjectInfoPtr->version < 990107 && sscanfReturnCode != 7)
 																							return (31);
@@ -2790,7 +4575,7 @@ SInt16 ReadProjectFile (void)
 							gProjectInfoPtr->version <= 20110722 && sscanfReturnCode != 8)
 																							return (31);
 																					
-				if (gProjectInfoPtr->version >= 20130424 && sscanfReturnCode != 9)
+				if (gProjectInfoPtr->version >= 20130424 && sscanfReturnCode < 9)
 																							return (31);
 																					
 				fieldIdentPtr->classStorage--;
@@ -2831,6 +4616,25 @@ SInt16 ReadProjectFile (void)
 								*stringPtr == 'S');
 				
 					}	// end "if (gProjectInfoPtr->keepClassStatsOnlyFlag)" 
+					
+				else if (binaryStatsCode > 0)
+					{
+							// The field statistics are in the binary block at the end
+							// of the file. They will be loaded when they are needed.
+							
+					returnCode = SetupBinaryFieldStatistics (classNamesPtr,
+																			fieldIndex,
+																			binaryStatsCode,
+																			&statsLoadedFlag);
+													
+					if (returnCode != 0)									
+																					return (returnCode);
+																					
+					returnCode = GetNextLine ((ParmBlkPtr)&paramBlock, &inputStringPtr);
+					if (returnCode != noErr)									
+																							return (32);
+					
+					}	// end "else if (binaryStatsCode > 0)"
 			
 				else	// !gProjectInfoPtr->keepClassStatsOnlyFlag 
 					{
@@ -4034,6 +5838,11 @@ SInt16 SaveProjectFile (
 		{		
 		returnCode = -1;
 		
+				// Load any field statistics which are still in the binary block of
+				// the current project file before the file is rewritten.
+				
+		LoadBinaryFieldStatistics (-1);
+		
 				// Make certain that we have the file name for the project.			
 				
 		if (GetProjectFileName (saveCode))
@@ -4101,6 +5910,133 @@ SInt16 SaveProjectFile (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void SetTrainingStoreField
+//
+//	Software purpose:	The purpose of this routine is to add the entry for the
+//							specified field to the index of the samples for each field in
+//							the training pixel store being written. The samples for the
+//							field are those loaded since the specified first sample.
+//
+//	Parameters in:		Field storage number.
+//							First sample for the field.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None
+//
+// Called By:			UpdateFieldAreaStats in SProjectComputeStatistics.cpp
+
+void SetTrainingStoreField (
+				UInt16								fieldNumber,
+				SInt64								firstSample)
+
+{
+	TrainingStoreFieldPtr			storeFieldPtr;
+	
+	
+	if (gProjectInfoPtr->trainingStoreFieldsPtr != NULL &&
+								fieldNumber < (UInt16)gProjectInfoPtr->numberStorageFields)
+		{
+		storeFieldPtr = &gProjectInfoPtr->trainingStoreFieldsPtr[fieldNumber];
+		
+		storeFieldPtr->key = GetTrainingStoreFieldKey (fieldNumber);
+		storeFieldPtr->firstSample = firstSample;
+		storeFieldPtr->numberSamples = gProjectInfoPtr->knnCounter - firstSample;
+		
+		}	// end "if (gProjectInfoPtr->trainingStoreFieldsPtr != NULL && ..."
+	
+}	// end "SetTrainingStoreField"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 SetupBinaryFieldStatistics
+//
+//	Software purpose:	The purpose of this routine is to set up the statistics for a
+//							field whose statistics are stored in the binary block at the end
+//							of the project file. The statistics memory is allocated and
+//							initialized; the statistics themselves are loaded by
+//							LoadBinaryFieldStatistics when they are needed.
+//
+//	Parameters in:		Pointer to the class information for the field.
+//							Field statistics storage index.
+//							Code from the 'F1' record indicating which statistics were
+//								saved; bit 1 for sums of squares and bit 2 for means and
+//								covariances.
+//
+//	Parameters out:	Flag indicating whether the statistics are available.
+//
+// Value Returned:	0 if okay.
+//							-2 if memory for the statistics could not be allocated.
+// 
+// Called By:			ReadProjectFile in SProjectFileIO.cpp
+
+SInt16 SetupBinaryFieldStatistics (
+				HPClassNamesPtr					classNamesPtr, 
+				SInt16								storageIndex, 
+				SInt16								binaryStatsCode,
+				Boolean*								statsLoadedFlagPtr)
+
+{
+	HPFieldIdentifiersPtr			fieldIdentPtr;
+	
+	
+	*statsLoadedFlagPtr = FALSE;
+	fieldIdentPtr = &gProjectInfoPtr->fieldIdentPtr[storageIndex];
+	
+	if (gProjectInfoPtr->fieldStatsBinaryOffsetsPtr == NULL ||
+			storageIndex >= gProjectInfoPtr->numberFieldStatsBinaryOffsets ||
+				gProjectInfoPtr->fieldStatsBinaryOffsetsPtr[storageIndex] == 0 ||
+					fieldIdentPtr->numberPixels <= 0)
+		{
+				// The statistics are not available. Force them to be recomputed.
+				
+		if (gProjectInfoPtr->fieldStatsBinaryOffsetsPtr != NULL &&
+					storageIndex < gProjectInfoPtr->numberFieldStatsBinaryOffsets)
+			gProjectInfoPtr->fieldStatsBinaryOffsetsPtr[storageIndex] = 0;
+			
+		fieldIdentPtr->statsUpToDate = FALSE;
+		gProjectInfoPtr->statsUpToDate = FALSE;
+		classNamesPtr->statsUpToDate = FALSE;
+																							return (0);
+		
+		}	// end "if (...->fieldStatsBinaryOffsetsPtr == NULL || ..."
+		
+	if (gProjectInfoPtr->fieldChanStatsPtr == NULL)
+		{
+		if (!SetupStatsMemory ())
+																							return (-2);
+		
+		}	// end "if (gProjectInfoPtr->fieldChanStatsPtr == NULL)"
+		
+	ZeroStatisticsMemory (
+			&gProjectInfoPtr->fieldChanStatsPtr[
+								storageIndex * gProjectInfoPtr->numberStatisticsChannels], 
+			&gProjectInfoPtr->fieldSumSquaresStatsPtr[
+								storageIndex * gProjectInfoPtr->numberCovarianceEntries], 
+			gProjectInfoPtr->numberStatisticsChannels,
+			gProjectInfoPtr->statisticsCode,
+			kTriangleOutputMatrix);
+	
+	if (binaryStatsCode & 0x0001)
+		gProjectInfoPtr->saveFieldSumsSquaresFlag = TRUE;
+	
+	if (binaryStatsCode & 0x0002)
+		gProjectInfoPtr->saveFieldMeansCovFlag = TRUE;
+	
+	*statsLoadedFlagPtr = TRUE;
+	
+	return (0);
+	
+}	// end "SetupBinaryFieldStatistics"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -4540,6 +6476,214 @@ void VerifyClassAndFieldParameters (
 
 
                   
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		Boolean WriteBinaryFieldStatsBlock
+//
+//	Software purpose:	The purpose of this routine is to write the statistics for the
+//							training fields to a binary block at the end of the project file.
+//							This avoids the loss of precision and the time needed to format
+//							and parse the text records for projects with many channels. All
+//							values are stored in little endian byte order.
+//
+//							Header (32 bytes):
+//								Bytes  0-  7: 'MSPECPST'
+//								Bytes  8- 11: version
+//								Bytes 12- 15: number of channels
+//								Bytes 16- 19: number of sum of squares entries per field
+//								Bytes 20- 23: number of entries in the index
+//								Bytes 24- 27: number of bytes for each field record
+//
+//							Index: 8-byte file offset of the record for each training field
+//								in the order that the fields are written in the file; 0 if
+//								no statistics are stored for the field.
+//
+//							Field record:
+//								8-byte number of pixels used for the statistics followed by
+//								the channel sums, the channel minimums, the channel maximums
+//								and the lower triangular sum of squares matrix as 8-byte
+//								reals.
+//
+//							Trailer (last 16 bytes of the file):
+//								Bytes  0-  7: file offset of the header
+//								Bytes  8- 15: 'MSPECPST'
+//
+//	Parameters in:		File stream pointer for the project file.
+//							List of field numbers for each training field in the order
+//								written; -1 if no statistics are to be stored for the field.
+//							Number of training fields in the list.
+//
+//	Parameters out:	None
+//
+// Value Returned:	TRUE if the block was written. FALSE if not.
+// 
+// Called By:			WriteProjectFile in SProjectFileIO.cpp
+
+Boolean WriteBinaryFieldStatsBlock (
+				CMFileStream*						fileStreamPtr,
+				SInt16*								fieldListPtr,
+				UInt32								numberFields)
+
+{
+	char									headerBuffer[kBinaryProjectStatsHeaderBytes],
+											trailerBuffer[kBinaryProjectStatsTrailerBytes];
+	
+	SInt64								blockStart,
+											recordOffset;
+	
+	HChannelStatisticsPtr			chanStatsPtr;
+	HDoublePtr							recordBufferPtr;
+	HPFieldIdentifiersPtr			fieldIdentPtr;
+	HSumSquaresStatisticsPtr		sumSquaresStatsPtr;
+	
+	SInt64*								offsetsPtr;
+	
+	SInt32								headerValues[5];
+	
+	UInt32								channel,
+											count,
+											index,
+											numberChannels,
+											numberCovarianceEntries,
+											numberRecordBytes;
+	
+	SInt16								errCode,
+											field,
+											fieldStatsNumber;
+	
+	
+	fieldIdentPtr = gProjectInfoPtr->fieldIdentPtr;
+	numberChannels = gProjectInfoPtr->numberStatisticsChannels;
+	numberCovarianceEntries = gProjectInfoPtr->numberCovarianceEntries;
+	numberRecordBytes = 8 + 8 * (3 * numberChannels + numberCovarianceEntries);
+	
+	recordBufferPtr = (HDoublePtr)MNewPointer (numberRecordBytes);
+	offsetsPtr = (SInt64*)MNewPointer (numberFields * sizeof (SInt64));
+	
+	errCode = -1;
+	if (recordBufferPtr != NULL && offsetsPtr != NULL)
+		errCode = MGetMarker (fileStreamPtr, &blockStart, kErrorMessages);
+	
+	if (errCode == noErr)
+		{
+				// Write the header and the index of file offsets for the field records.
+			
+		recordOffset = blockStart + kBinaryProjectStatsHeaderBytes + 
+																		8 * (SInt64)numberFields;
+		
+		for (index=0; index<numberFields; index++)
+			{
+			offsetsPtr[index] = 0;
+			if (fieldListPtr[index] >= 0)
+				{
+				offsetsPtr[index] = recordOffset;
+				recordOffset += numberRecordBytes;
+				
+				}	// end "if (fieldListPtr[index] >= 0)"
+			
+			}	// end "for (index=0; index<numberFields; index++)"
+			
+		for (index=0; index<kBinaryProjectStatsHeaderBytes; index++)
+			headerBuffer[index] = 0;
+			
+		BlockMoveData ((char*)kBinaryProjectStatsIdentifier, headerBuffer, 8);
+		
+		headerValues[0] = kBinaryProjectStatsVersion;
+		headerValues[1] = numberChannels;
+		headerValues[2] = numberCovarianceEntries;
+		headerValues[3] = numberFields;
+		headerValues[4] = numberRecordBytes;
+		
+		if (gBigEndianFlag)
+			{
+			SwapBytes (4, (HUInt8Ptr)headerValues, 5);
+			SwapBytes (8, (HUInt8Ptr)offsetsPtr, numberFields);
+			
+			}	// end "if (gBigEndianFlag)"
+			
+		BlockMoveData (headerValues, &headerBuffer[8], 20);
+		
+		count = kBinaryProjectStatsHeaderBytes;
+		errCode = MWriteData (fileStreamPtr, &count, headerBuffer, kErrorMessages);
+		
+		if (errCode == noErr)
+			{
+			count = 8 * numberFields;
+			errCode = MWriteData (fileStreamPtr, &count, offsetsPtr, kErrorMessages);
+			
+			}	// end "if (errCode == noErr)"
+		
+		}	// end "if (errCode == noErr)"
+	
+	for (index=0; index<numberFields; index++)
+		{
+		if (errCode != noErr)
+			break;
+			
+		field = fieldListPtr[index];
+		if (field < 0)
+			continue;
+			
+		fieldStatsNumber = fieldIdentPtr[field].trainingStatsNumber;
+		chanStatsPtr = 
+				&gProjectInfoPtr->fieldChanStatsPtr[fieldStatsNumber * numberChannels];
+		sumSquaresStatsPtr = &gProjectInfoPtr->fieldSumSquaresStatsPtr[
+													fieldStatsNumber * numberCovarianceEntries];
+		
+		BlockMoveData (&fieldIdentPtr[field].numberPixelsUsedForStats, 
+							recordBufferPtr, 
+							8);
+		
+		for (channel=0; channel<numberChannels; channel++)
+			{
+			recordBufferPtr[1 + channel] = chanStatsPtr[channel].sum;
+			recordBufferPtr[1 + numberChannels + channel] = 
+																	chanStatsPtr[channel].minimum;
+			recordBufferPtr[1 + 2 * numberChannels + channel] = 
+																	chanStatsPtr[channel].maximum;
+			
+			}	// end "for (channel=0; channel<numberChannels; channel++)"
+			
+		BlockMoveData (sumSquaresStatsPtr, 
+							&recordBufferPtr[1 + 3 * numberChannels], 
+							8 * numberCovarianceEntries);
+		
+		if (gBigEndianFlag)
+			SwapBytes (8, 
+							(HUInt8Ptr)recordBufferPtr, 
+							1 + 3 * numberChannels + numberCovarianceEntries);
+		
+		count = numberRecordBytes;
+		errCode = MWriteData (fileStreamPtr, &count, recordBufferPtr, kErrorMessages);
+		
+		}	// end "for (index=0; index<numberFields; index++)"
+		
+	if (errCode == noErr)
+		{
+				// Write the trailer which allows the block to be found when the file
+				// is read.
+				
+		if (gBigEndianFlag)
+			SwapBytes (8, (HUInt8Ptr)&blockStart, 1);
+			
+		BlockMoveData (&blockStart, trailerBuffer, 8);
+		BlockMoveData ((char*)kBinaryProjectStatsIdentifier, &trailerBuffer[8], 8);
+		
+		count = kBinaryProjectStatsTrailerBytes;
+		errCode = MWriteData (fileStreamPtr, &count, trailerBuffer, kErrorMessages);
+		
+		}	// end "if (errCode == noErr)"
+		
+	CheckAndDisposePtr ((Ptr)recordBufferPtr);
+	CheckAndDisposePtr ((Ptr)offsetsPtr);
+	
+	return (errCode == noErr);
+	
+}	// end "WriteBinaryFieldStatsBlock"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -5297,12 +7441,16 @@ SInt16 WriteProjectFile (
 	HPFieldIdentifiersPtr			fieldIdentPtr;
 	WindowInfoPtr						projectWindowInfoPtr;
 	
+	SInt16*								binaryStatsFieldPtr;
+	
 	SInt32								numberChannels,
 											numberCovarianceEntries;
 											
-	UInt32								binaryListingCode;
+	UInt32								binaryListingCode,
+											numberBinaryStatsFields;
 	
-	SInt16								channel,
+	SInt16								binaryStatsCode,
+											channel,
 											classStorage,
 											field,
 											fieldCount,
@@ -5333,6 +7481,8 @@ SInt16 WriteProjectFile (
 	gOutputCode = kAsciiFormatCode;
 	gOutputForce1Code = (gOutputCode | 0x0001);
 	continueFlag = TRUE;
+	binaryStatsFieldPtr = NULL;
+	numberBinaryStatsFields = 0;
 	  
 	#if defined multispec_mac
 		formatArchitectureCode = kMacintoshIntel;
@@ -5607,6 +7757,18 @@ SInt16 WriteProjectFile (
 		binaryListingCode = 0;	
 		if (projectWindowInfoPtr->numberBytes >= 4)
 			binaryListingCode = 10;													
+		
+				// The field statistics will be written to a binary block at the end of
+				// the file if requested. The list will contain the field number for
+				// each training field whose statistics are written to the block.
+		
+		if (gWriteBinaryProjectStatsFlag &&
+				!gProjectInfoPtr->keepClassStatsOnlyFlag &&
+					(gProjectInfoPtr->saveFieldMeansCovFlag || 
+										gProjectInfoPtr->saveFieldSumsSquaresFlag) &&
+						gProjectInfoPtr->numberStatTrainFields > 0)
+			binaryStatsFieldPtr = (SInt16*)MNewPointer (
+							gProjectInfoPtr->numberStatTrainFields * sizeof (SInt16));
 				
 		sprintf ((char*)gTextString,
 						"Training Statistics%s",
@@ -5789,6 +7951,31 @@ SInt16 WriteProjectFile (
 							outTemp2 = 0;
 						
 						}	// end "if (...->keepClassStatsOnlyFlag)" 
+						
+							// Determine whether the statistics for the field are to
+							// be written to the binary block.
+						
+					binaryStatsCode = 0;
+					if (binaryStatsFieldPtr != NULL && numberBinaryStatsFields < 
+										(UInt32)gProjectInfoPtr->numberStatTrainFields)
+						{
+						binaryStatsFieldPtr[numberBinaryStatsFields] = -1;
+						
+						if (fieldIdentPtr[field].statsUpToDate)
+							{
+							binaryStatsFieldPtr[numberBinaryStatsFields] = field;
+							
+							if (gProjectInfoPtr->saveFieldSumsSquaresFlag)
+								binaryStatsCode |= 0x0001;
+							
+							if (gProjectInfoPtr->saveFieldMeansCovFlag)
+								binaryStatsCode |= 0x0002;
+							
+							}	// end "if (fieldIdentPtr[field].statsUpToDate)"
+							
+						numberBinaryStatsFields++;
+						
+						}	// end "if (binaryStatsFieldPtr != NULL && ..."
 										
 							// Write "F1" record.  "Field summary."						
 							
@@ -5797,7 +7984,7 @@ SInt16 WriteProjectFile (
 								&strLength);
 							
 					sprintf ((char*)gTextString, 
-								"F1\t%d\t%s\t%hd\t%d\t%hd\t%hd\t%lld\t%hd\t%hd\t%hd\t%lld%s",
+								"F1\t%d\t%s\t%hd\t%d\t%hd\t%hd\t%lld\t%hd\t%hd\t%hd\t%lld\t%hd%s",
 								(int)fieldIdentPtr[field].name[0],
 								gTextString2,
 								fieldIdentPtr[field].numberOfPolygonPoints,
@@ -5809,6 +7996,7 @@ SInt16 WriteProjectFile (
 								outTemp2,		// statsUpToDate
 								fieldIdentPtr[field].maskValue,
 								fieldIdentPtr[field].numberPixelsUsedForStats,	// Added for version 20130424
+								binaryStatsCode,
 								gEndOfLine); 
 						
 					continueFlag = OutputString (projectFileStreamPtr,
@@ -5817,7 +8005,7 @@ SInt16 WriteProjectFile (
 															gOutputCode, 
 															continueFlag);
 		
-					if (fieldIdentPtr[field].statsUpToDate)	
+					if (fieldIdentPtr[field].statsUpToDate && binaryStatsCode == 0)	
 						{
 						if (returnCode > 0)
 							returnCode = WriteStatistics (
@@ -5973,6 +8161,14 @@ SInt16 WriteProjectFile (
 				break;
 					
 			}	// end "for (classIndex=1; gProjectInfoPtr->..." 
+			
+				// Write the binary block with the field statistics at the end of the
+				// file.
+		
+		if (continueFlag && returnCode > 0 && numberBinaryStatsFields > 0)
+			continueFlag = WriteBinaryFieldStatsBlock (projectFileStreamPtr,
+																		binaryStatsFieldPtr,
+																		numberBinaryStatsFields);
 		
 		if (gStatusDialogPtr != NULL)
 			{
@@ -6004,6 +8200,8 @@ SInt16 WriteProjectFile (
 	else	// !FileOpen (projectFileStreamPtr) 
 		returnCode = 1;
 		
+	CheckAndDisposePtr ((Ptr)binaryStatsFieldPtr);
+		
 	MInitCursor ();
 		
 	return (returnCode);
@@ -6149,3 +8347,46 @@ SInt16 WriteStatistics (
 	return (continueFlag);
 							
 }	// end "WriteStatistics" 
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void WriteTrainingStoreBuffer
+//
+//	Software purpose:	The purpose of this routine is to write the training pixel
+//							values in the training pixel store buffer to the training
+//							pixel store (.knn) file. Any error is saved to be handled
+//							when the file is completed.
+//
+//	Parameters in:		None
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			AddTrainingPixelSample in SProjectComputeStatistics.cpp
+//							FinishTrainingStore in SProjectFileIO.cpp
+
+void WriteTrainingStoreBuffer (void)
+
+{
+	UInt32								count;
+	
+	
+	count = gProjectInfoPtr->trainingStoreBufferSamples *
+							gProjectInfoPtr->numberStatisticsChannels *
+										gProjectInfoPtr->trainingStoreValueBytes;
+	
+	if (count > 0 && gProjectInfoPtr->trainingStoreErrCode == noErr)
+		gProjectInfoPtr->trainingStoreErrCode = 
+						MWriteData (gProjectInfoPtr->trainingStoreFileStreamPtr,
+										&count, 
+										gProjectInfoPtr->trainingStoreBufferPtr, 
+										kNoErrorMessages);
+	
+	gProjectInfoPtr->trainingStoreBufferSamples = 0;
+	
+}	// end "WriteTrainingStoreBuffer"
+
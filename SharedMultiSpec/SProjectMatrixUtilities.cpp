@@ -48,6 +48,15 @@ double FindMaxDiagonalValueInSquareMatrix (
 				HDoublePtr 							squareMatrixPtr, 
 				UInt32								matrixSize);
 
+SInt64 GetClassStoreDataValues (
+				SInt16								classNumber, 
+				UInt16*								channelsPtr,
+				SInt16								numberChannels, 
+				HDoublePtr							doubleDataValuePtr,
+				HDoublePtr							transformMatrixPtr,
+				HDoublePtr							transformFeatureMeansPtr,
+				UInt16								numberFeatures);
+
 
 
 //------------------------------------------------------------------------------------
@@ -223,6 +232,10 @@ UInt32 FindMinValueInVector (
 //							vector with the data values for the specified class stored in 
 //							BIS format.
 //
+//							If kUseTrainingStore is included in the options code, the
+//							data values are taken from the training pixel store if it is
+//							being used for the project instead of from the image file.
+//
 //	Parameters in:		None
 //
 //	Parameters out:	None
@@ -309,6 +322,33 @@ SInt64 GetClassDataValues (
 			gAreaDescription.lineInterval = 1;
 													
 			}	// end "if (gFeatureExtractionSpecsPtr != NULL)"
+		
+				// Use the values in the training pixel store if requested and
+				// available. The store contains every pixel in the training fields so
+				// it can only be used when every pixel would be read from the image
+				// file. The image file is read if the store cannot be used for this
+				// class.
+		
+		if ((optionsCode & kUseTrainingStore) &&
+					gProjectInfoPtr->trainingStoreValuesPtr != NULL &&
+						gAreaDescription.columnInterval == 1 &&
+							gAreaDescription.lineInterval == 1)
+			{
+			totalNumberPixels = GetClassStoreDataValues (
+																classNumber,
+																channelsPtr,
+																numberChannels,
+																doubleDataValuePtr,
+																transformMatrixPtr,
+																transformFeatureMeansPtr,
+																numberFeatures);
+			
+			if (totalNumberPixels >= 0)
+																		return (totalNumberPixels);
+			
+			totalNumberPixels = 0;
+			
+			}	// end "if ((optionsCode & kUseTrainingStore) && ..."
 												
 		fieldNumber = classNamesPtr[classStorage].firstFieldNumber;
 		
@@ -374,6 +414,177 @@ SInt64 GetClassDataValues (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt64 GetClassStoreDataValues
+//
+//	Software purpose:	The purpose of this routine is to load the input floating point 
+//							vector with the data values for the specified class from the
+//							training pixel store instead of the image file. The store is
+//							only used when it contains double values so that the values
+//							are the same as those read from the image file.
+//
+//	Parameters in:		None
+//
+//	Parameters out:	None
+//
+// Value Returned:	Number of pixels loaded.
+//							-1 if the store cannot be used for the class.
+// 
+// Called By:			GetClassDataValues in SProjectMatrixUtilities.cpp
+
+SInt64 GetClassStoreDataValues (
+				SInt16								classNumber, 
+				UInt16*								channelsPtr,
+				SInt16								numberChannels, 
+				HDoublePtr							doubleDataValuePtr,
+				HDoublePtr							transformMatrixPtr,
+				HDoublePtr							transformFeatureMeansPtr,
+				UInt16								numberFeatures)
+
+{
+	HDoublePtr							vectorPtr,
+											workVectorPtr;
+	
+	double*								doubleValuesPtr;
+	
+	HPClassNamesPtr					classNamesPtr;
+	HPFieldIdentifiersPtr			fieldIdentPtr;
+	
+	SInt16*								storeChannelsPtr;
+	
+	SInt64								baseIndex,
+											maximumNumberPixels,
+											sample,
+											totalNumberPixels;
+	
+	UInt32								channel,
+											index,
+											numberProjectChannels;
+	
+	SInt16								classStorage,
+											fieldNumber;
+	
+	UInt16								label;
+	
+	Boolean								continueFlag,
+											transformDataFlag;
+	
+	
+	classNamesPtr = gProjectInfoPtr->classNamesPtr;
+	fieldIdentPtr = gProjectInfoPtr->fieldIdentPtr;
+	classStorage = gProjectInfoPtr->storageClass[classNumber];
+	numberProjectChannels = gProjectInfoPtr->numberStatisticsChannels;
+	
+			// Values stored as float would not match those read from the image
+			// file for all data types.
+	
+	if (gProjectInfoPtr->trainingStoreValueBytes != 8)
+																						return (-1);
+	
+			// The store only contains the training fields which were included in the
+			// statistics. Do not use it if any of the fields for the class were not.
+	
+	fieldNumber = classNamesPtr[classStorage].firstFieldNumber;
+	while (fieldNumber != -1)
+		{
+		if (fieldIdentPtr[fieldNumber].fieldType == kTrainingType &&
+						fieldIdentPtr[fieldNumber].pointType != kClusterType &&
+											!fieldIdentPtr[fieldNumber].loadedIntoClassStats)
+																						return (-1);
+			
+		fieldNumber = fieldIdentPtr[fieldNumber].nextField;
+		
+		}	// end "while (fieldNumber != -1)"
+	
+			// Get the index in the project channels for each of the requested
+			// channels.
+	
+	workVectorPtr = (HDoublePtr)MNewPointer (
+								(SInt64)numberChannels * (sizeof (double) + sizeof (SInt16)));
+	if (workVectorPtr == NULL)
+																						return (-1);
+	
+	storeChannelsPtr = (SInt16*)&workVectorPtr[numberChannels];
+	continueFlag = TRUE;
+	
+	for (channel=0; channel<(UInt32)numberChannels; channel++)
+		{
+		index = 0;
+		while (index < numberProjectChannels &&
+						(UInt16)gProjectInfoPtr->channelsPtr[index] != channelsPtr[channel])
+			index++;
+		
+		if (index < numberProjectChannels)
+			storeChannelsPtr[channel] = (SInt16)index;
+		
+		else	// index >= numberProjectChannels
+			continueFlag = FALSE;
+		
+		}	// end "for (channel=0; channel<numberChannels; channel++)"
+	
+	totalNumberPixels = -1;
+	if (continueFlag)
+		{
+		doubleValuesPtr = (double*)gProjectInfoPtr->trainingStoreValuesPtr;
+		
+		transformDataFlag = (transformMatrixPtr != NULL && numberFeatures > 0);
+		label = (UInt16)classNamesPtr[classStorage].classNumber;
+		maximumNumberPixels = classNamesPtr[classStorage].numberStatisticsPixels;
+		
+		totalNumberPixels = 0;
+		baseIndex = 0;
+		for (sample=0; sample<gProjectInfoPtr->knnCounter; sample++)
+			{
+			if (gProjectInfoPtr->knnLabelsPtr[sample] == label)
+				{
+				if (totalNumberPixels < maximumNumberPixels)
+					{
+					vectorPtr = doubleDataValuePtr;
+					if (transformDataFlag)
+						vectorPtr = workVectorPtr;
+					
+					for (channel=0; channel<(UInt32)numberChannels; channel++)
+						vectorPtr[channel] =
+										doubleValuesPtr[baseIndex + storeChannelsPtr[channel]];
+					
+					if (transformDataFlag)
+						{
+						TransformDataVector (workVectorPtr,
+													transformMatrixPtr,
+													transformFeatureMeansPtr,
+													doubleDataValuePtr,
+													numberChannels,
+													numberFeatures);
+						
+						doubleDataValuePtr += numberFeatures;
+						
+						}	// end "if (transformDataFlag)"
+					
+					else	// !transformDataFlag
+						doubleDataValuePtr += numberChannels;
+					
+					totalNumberPixels++;
+					
+					}	// end "if (totalNumberPixels < maximumNumberPixels)"
+				
+				}	// end "if (gProjectInfoPtr->knnLabelsPtr[sample] == label)"
+			
+			baseIndex += numberProjectChannels;
+			
+			}	// end "for (sample=0; sample<...->knnCounter; sample++)"
+		
+		}	// end "if (continueFlag)"
+	
+	CheckAndDisposePtr ((Ptr)workVectorPtr);
+	
+	return (totalNumberPixels);
+	
+}	// end "GetClassStoreDataValues"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -683,7 +894,8 @@ Boolean InvertLowerTriangularMatrix (
 																	gInverseMatrixMemory.ipvotPtr,
 																	determinantPtr, 
 																	logDeterminantPtr,
-																	inverseRequestedFlag);
+																	inverseRequestedFlag,
+																	kCheckEvents);
 		
 		if (outputTriangularMatrixPtr != NULL &&
 					inverseRequestedFlag &&
@@ -717,7 +929,9 @@ Boolean InvertLowerTriangularMatrix (
 //							determinant of a symmetric matrix and the inverse 
 //							of the symmetric matrix.
 //
-//	Parameters in:					
+//	Parameters in:		checkEventsFlag: TRUE if user events are to be checked so
+//								that the user can cancel the operation. This must be
+//								FALSE when called on a worker thread.
 //
 //	Parameters out:	The pivot values are returned in pivot.
 //							The inverse of the matrix is returned in matrixPtr.
@@ -746,7 +960,8 @@ Boolean InvertSymmetricMatrix (
 				SInt16* 								ipvot, 		// Work array 
 				double*								determinantPtr, // Determinant of input matrix
 				double*								logDeterminantPtr, // Log Determinant of input matrix
-				Boolean								inverseRequestedFlag)  // Request for inverse matrix
+				Boolean								inverseRequestedFlag,  // Request for inverse matrix
+				Boolean								checkEventsFlag)  // Check for user events
 
 {
 	double								determinant,  // Determinant of input matrix 
@@ -938,7 +1153,7 @@ Boolean InvertSymmetricMatrix (
 			
 				// Exit routine if user has "command period" down					
 		
-		if (TickCount () >= gNextTime)
+		if (checkEventsFlag && TickCount () >= gNextTime)
 			{
 			if (!CheckSomeEvents (osMask+keyDownMask+updateMask+mDownMask+mUpMask))
 				{
@@ -947,7 +1162,7 @@ Boolean InvertSymmetricMatrix (
 					
 				}	// end "if (!CheckSomeEvents (..."
 			
-			}	// end "if (TickCount () >= gNextTime)"
+			}	// end "if (checkEventsFlag && TickCount () >= gNextTime)"
 			
 		if (stopFlag) 
 			break;
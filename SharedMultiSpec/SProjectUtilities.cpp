@@ -580,6 +580,8 @@ double Bhattacharyya (
 																				//	class 2 covariance matrix
 				HDoublePtr							meanDifPtr, // vector storage of class 1 and
 																				// class 2 mean difference.
+				InverseMatrixMemoryPtr			inverseMatrixMemoryPtr, // work memory
+																				// for the matrix inversion.
 				SInt16								numberFeatures) // number of features (channels)
 																				// represented in the mean vector
 																				// and covariance and inverse  	
@@ -606,7 +608,7 @@ double Bhattacharyya (
 			// by 4 instead of 8 and in the covariance part by subtracting the
 			// constant 'numberFeature * ln (2)'.						
 
-   tInversePtr = gInverseMatrixMemory.inversePtr;
+   tInversePtr = inverseMatrixMemoryPtr->inversePtr;
    temp1Ptr = cov1Ptr;
    temp2Ptr = cov2Ptr;
 
@@ -636,13 +638,14 @@ double Bhattacharyya (
 
    InvertSymmetricMatrix (tInversePtr,
 									numberFeatures,
-									gInverseMatrixMemory.pivotPtr,
-									gInverseMatrixMemory.indexRowPtr,
-									gInverseMatrixMemory.indexColPtr,
-									gInverseMatrixMemory.ipvotPtr,
+									inverseMatrixMemoryPtr->pivotPtr,
+									inverseMatrixMemoryPtr->indexRowPtr,
+									inverseMatrixMemoryPtr->indexColPtr,
+									inverseMatrixMemoryPtr->ipvotPtr,
 									NULL,
 									&logDeterminant,
-									kReturnMatrixInverse);
+									kReturnMatrixInverse,
+									!inverseMatrixMemoryPtr->workerThreadFlag);
 
    if (gOperationCanceledFlag)
 																								return (0);
@@ -667,7 +670,7 @@ double Bhattacharyya (
 			// Get the i=j component items of the mean part of the Bhattacharyya
 			// distance.
 
-   tInversePtr = gInverseMatrixMemory.inversePtr;
+   tInversePtr = inverseMatrixMemoryPtr->inversePtr;
    temp1Ptr = meanDifPtr;
    bhattacharyya1 = 0;
    tmpIndex2 = numberFeatures + 1;
@@ -688,7 +691,7 @@ double Bhattacharyya (
 			// bhattacharyya2. This is taken care of by dividing by 2 instead of 4 at
 			// the end of the computation.
 
-   tInversePtr = &gInverseMatrixMemory.inversePtr[numberFeatures];
+   tInversePtr = &inverseMatrixMemoryPtr->inversePtr[numberFeatures];
    temp1Ptr = meanDifPtr + 1;
    bhattacharyya2 = 0;
    tmpIndex2 = numberFeatures - 1;
@@ -4259,6 +4262,9 @@ void GetFieldBoundary (
 				// represent the bounding rectangle.
 
       pointIndex += 2;
+		
+      areaDescriptionPtr->polygonPointsPtr = &fieldPointsPtr[pointIndex];
+      areaDescriptionPtr->numberPolygonPoints = fieldIdentPtr->numberOfPolygonPoints;
 
       CreateFieldRgn (fieldIdentPtr->numberOfPolygonPoints,
 								&fieldPointsPtr[pointIndex],
@@ -4306,6 +4312,8 @@ void GetFieldBoundary (
 		{
       areaDescriptionPtr->polygonFieldFlag = FALSE;
       areaDescriptionPtr->rgnHandle = NULL;
+      areaDescriptionPtr->polygonPointsPtr = NULL;
+      areaDescriptionPtr->numberPolygonPoints = 0;
 
       if (fieldIdentPtr->pointType == kRectangleType) 
 			{
@@ -5395,6 +5403,279 @@ void GetBoundingRegionRectangle (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		UInt32 GetPolygonColumnRuns
+//
+//	Software purpose:	The purpose of this routine is to get the runs of columns
+//							in the input line that may be within the polygon described
+//							by the input points. The runs include all columns for which
+//							the polygon comes within one line and one column of the 
+//							pixel so that they include all pixels that PtInRgn will
+//							find to be within the region for the polygon no matter how
+//							the region is defined for the platform. The nonzero winding
+//							rule is used so that the runs also include the pixels for
+//							the even-odd rule. PtInRgn still needs to be used to 
+//							determine whether a pixel in a run is in the polygon.
+//
+//	Parameters in:		Pointer to the polygon points.
+//							Number of polygon points.
+//							Column and line offset to apply to the points.
+//							Line to get the runs for.
+//							First and last column of the area.
+//							Work buffer for 6*numberPoints double values.
+//
+//	Parameters out:	Runs of columns in column order. The mask value for the runs
+//							is 1. If maskRunPtr is NULL, only the number of runs is
+//							returned. The buffer needs to allow for 2*numberPoints runs.
+//
+//	Value Returned:	Number of runs.
+//
+// Called By:			SetUpAreaColumnRuns in SFileIO.cpp
+
+UInt32 GetPolygonColumnRuns (
+				HPFieldPointsPtr					fieldPointsPtr,
+				UInt32								numberPoints,
+				SInt32								columnOffset,
+				SInt32								lineOffset,
+				SInt32								line,
+				SInt32								columnStart,
+				SInt32								columnEnd,
+				double*								workPtr,
+				MaskRunPtr							maskRunPtr)
+
+{
+	double								*crossingPtr,
+											*intervalPtr;
+	
+	double								direction,
+											lineValue,
+											savedX,
+											savedValue,
+											x1,
+											x2,
+											xHigh,
+											xLow,
+											y1,
+											y2,
+											yHigh,
+											yLow;
+	
+	SInt32								lastColumnEnd,
+											previousWinding,
+											runColumnEnd,
+											runColumnStart,
+											winding;
+	
+	UInt32								index,
+											index2,
+											numberCrossings,
+											numberIntervals,
+											numberRuns,
+											pass,
+											pointIndex,
+											previousPointIndex;
+	
+	
+	if (fieldPointsPtr == NULL || numberPoints < 3 || workPtr == NULL)
+																							return (0);
+	
+	intervalPtr = workPtr;
+	crossingPtr = &workPtr[4*numberPoints];
+	numberIntervals = 0;
+	
+	yLow = line - 1;
+	yHigh = line + 1;
+	
+			// Get the range of columns for the part of each edge that is within
+			// the band of lines.
+	
+	previousPointIndex = numberPoints - 1;
+	for (pointIndex=0; pointIndex<numberPoints; pointIndex++)
+		{
+		x1 = fieldPointsPtr[previousPointIndex].col + columnOffset;
+		y1 = fieldPointsPtr[previousPointIndex].line + lineOffset;
+		x2 = fieldPointsPtr[pointIndex].col + columnOffset;
+		y2 = fieldPointsPtr[pointIndex].line + lineOffset;
+		previousPointIndex = pointIndex;
+		
+		if (MAX (y1, y2) < yLow || MIN (y1, y2) > yHigh)
+			continue;
+		
+		if (y1 == y2)
+			{
+			xLow = MIN (x1, x2);
+			xHigh = MAX (x1, x2);
+			
+			}	// end "if (y1 == y2)"
+			
+		else	// y1 != y2
+			{
+			lineValue = MAX (MIN (y1, y2), yLow);
+			xLow = x1 + (lineValue - y1) * (x2 - x1) / (y2 - y1);
+			
+			lineValue = MIN (MAX (y1, y2), yHigh);
+			xHigh = x1 + (lineValue - y1) * (x2 - x1) / (y2 - y1);
+			
+			if (xLow > xHigh)
+				{
+				savedX = xLow;
+				xLow = xHigh;
+				xHigh = savedX;
+				
+				}	// end "if (xLow > xHigh)"
+			
+			}	// end "else y1 != y2"
+		
+		intervalPtr[2*numberIntervals] = xLow;
+		intervalPtr[2*numberIntervals+1] = xHigh;
+		numberIntervals++;
+		
+		}	// end "for (pointIndex=0; pointIndex<numberPoints; pointIndex++)"
+		
+			// Get the spans within the polygon along the top and bottom of the 
+			// band of lines. Any part of the polygon within the band that is not 
+			// covered by these spans is covered by the edge ranges above.
+	
+	for (pass=1; pass<=2; pass++)
+		{
+		lineValue = (pass == 1) ? yLow : yHigh;
+		numberCrossings = 0;
+		
+		previousPointIndex = numberPoints - 1;
+		for (pointIndex=0; pointIndex<numberPoints; pointIndex++)
+			{
+			x1 = fieldPointsPtr[previousPointIndex].col + columnOffset;
+			y1 = fieldPointsPtr[previousPointIndex].line + lineOffset;
+			x2 = fieldPointsPtr[pointIndex].col + columnOffset;
+			y2 = fieldPointsPtr[pointIndex].line + lineOffset;
+			previousPointIndex = pointIndex;
+			
+			if ((y1 <= lineValue && lineValue < y2) || 
+														(y2 <= lineValue && lineValue < y1))
+				{
+				crossingPtr[2*numberCrossings] = 
+											x1 + (lineValue - y1) * (x2 - x1) / (y2 - y1);
+				crossingPtr[2*numberCrossings+1] = (y2 > y1) ? 1 : -1;
+				numberCrossings++;
+				
+				}	// end "if ((y1 <= lineValue && lineValue < y2) || ..."
+			
+			}	// end "for (pointIndex=0; pointIndex<numberPoints; pointIndex++)"
+			
+				// Sort the crossings by column.
+		
+		for (index=1; index<numberCrossings; index++)
+			{
+			savedX = crossingPtr[2*index];
+			direction = crossingPtr[2*index+1];
+			
+			index2 = index;
+			while (index2 > 0 && crossingPtr[2*index2-2] > savedX)
+				{
+				crossingPtr[2*index2] = crossingPtr[2*index2-2];
+				crossingPtr[2*index2+1] = crossingPtr[2*index2-1];
+				index2--;
+				
+				}	// end "while (index2 > 0 && ..."
+				
+			crossingPtr[2*index2] = savedX;
+			crossingPtr[2*index2+1] = direction;
+			
+			}	// end "for (index=1; index<numberCrossings; index++)"
+			
+		winding = 0;
+		xLow = 0;
+		for (index=0; index<numberCrossings; index++)
+			{
+			previousWinding = winding;
+			winding += (SInt32)crossingPtr[2*index+1];
+			
+			if (previousWinding == 0 && winding != 0)
+				xLow = crossingPtr[2*index];
+				
+			else if (previousWinding != 0 && winding == 0)
+				{
+				intervalPtr[2*numberIntervals] = xLow;
+				intervalPtr[2*numberIntervals+1] = crossingPtr[2*index];
+				numberIntervals++;
+				
+				}	// end "else if (previousWinding != 0 && winding == 0)"
+			
+			}	// end "for (index=0; index<numberCrossings; index++)"
+		
+		}	// end "for (pass=1; pass<=2; pass++)"
+		
+			// Sort the ranges by the first column.
+	
+	for (index=1; index<numberIntervals; index++)
+		{
+		savedX = intervalPtr[2*index];
+		savedValue = intervalPtr[2*index+1];
+		
+		index2 = index;
+		while (index2 > 0 && intervalPtr[2*index2-2] > savedX)
+			{
+			intervalPtr[2*index2] = intervalPtr[2*index2-2];
+			intervalPtr[2*index2+1] = intervalPtr[2*index2-1];
+			index2--;
+			
+			}	// end "while (index2 > 0 && ..."
+			
+		intervalPtr[2*index2] = savedX;
+		intervalPtr[2*index2+1] = savedValue;
+		
+		}	// end "for (index=1; index<numberIntervals; index++)"
+		
+			// Convert the ranges to runs of columns allowing for one column on each
+			// side and merge those that overlap or touch.
+	
+	numberRuns = 0;
+	lastColumnEnd = 0;
+	for (index=0; index<numberIntervals; index++)
+		{
+		runColumnStart = (SInt32)floor (intervalPtr[2*index]) - 1;
+		runColumnStart = MAX (runColumnStart, columnStart);
+		
+		runColumnEnd = (SInt32)ceil (intervalPtr[2*index+1]) + 1;
+		runColumnEnd = MIN (runColumnEnd, columnEnd);
+		
+		if (runColumnStart > runColumnEnd)
+			continue;
+		
+		if (numberRuns > 0 && runColumnStart <= lastColumnEnd + 1)
+			{
+			lastColumnEnd = MAX (lastColumnEnd, runColumnEnd);
+			
+			if (maskRunPtr != NULL)
+				maskRunPtr[numberRuns-1].columnEnd = lastColumnEnd;
+			
+			}	// end "if (numberRuns > 0 && runColumnStart <= lastColumnEnd + 1)"
+			
+		else	// numberRuns == 0 || runColumnStart > lastColumnEnd + 1
+			{
+			if (maskRunPtr != NULL)
+				{
+				maskRunPtr[numberRuns].columnStart = runColumnStart;
+				maskRunPtr[numberRuns].columnEnd = runColumnEnd;
+				maskRunPtr[numberRuns].maskValue = 1;
+				
+				}	// end "if (maskRunPtr != NULL)"
+			
+			lastColumnEnd = runColumnEnd;
+			numberRuns++;
+			
+			}	// end "else numberRuns == 0 || runColumnStart > lastColumnEnd + 1"
+		
+		}	// end "for (index=0; index<numberIntervals; index++)"
+	
+	return (numberRuns);
+	
+}	// end "GetPolygonColumnRuns"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -9958,7 +10239,12 @@ Boolean VerifyProjectTrainingPixelsLoaded (
 	//if (loadPixelDataFlag)
 	if (!gProjectInfoPtr->pixelDataLoadedFlag)
 		{
-		returnCode = UpdateStatsControl (kUpdateProject, FALSE, TRUE);
+				// Use the training pixel values in the training pixel store file
+				// beside the project file if it is current. Otherwise read them
+				// from the image file.
+		
+		if (!OpenTrainingStore ())
+			returnCode = UpdateStatsControl (kUpdateProject, FALSE, TRUE);
 
 				// Now get the project image file information pointers again. They
 				// may have been released in the call to 'UpdateStatsControl'.
@@ -952,7 +952,8 @@ Boolean First_stage_matrix (
 																gInverseMatrixMemory.ipvotPtr, 
 																NULL,
 																&logDeterminant,
-																kGetDeterminantOnly);
+																kGetDeterminantOnly,
+																kCheckEvents);
 							
 						if (determinantOKFlag)
 							{
@@ -1015,7 +1016,8 @@ Boolean First_stage_matrix (
 																	gInverseMatrixMemory.ipvotPtr,
 																	NULL, 
 																	&logDeterminant,
-																	kGetDeterminantOnly);
+																	kGetDeterminantOnly,
+																	kCheckEvents);
 								
 									if (determinantOKFlag)
 										{
@@ -1064,7 +1066,8 @@ Boolean First_stage_matrix (
 																gInverseMatrixMemory.ipvotPtr, 
 																NULL,
 																&logDeterminant,
-																kGetDeterminantOnly);
+																kGetDeterminantOnly,
+																kCheckEvents);
 									
 								if (gOperationCanceledFlag)
 									break;
@@ -2951,6 +2954,7 @@ Boolean minBhatt (
 																gClassInfoPtr[i].logDeterminant, 
 																gClassInfoPtr[j].logDeterminant,
 																gInverseMatrixMemory.pivotPtr, 
+																&gInverseMatrixMemory,
 																(SInt16)final_num_features);
 			
 				if (gOperationCanceledFlag)
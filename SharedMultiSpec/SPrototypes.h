@@ -2377,6 +2377,8 @@ extern SInt16 WriteClassificationResults (
 				AreaDescriptionPtr				areaDescriptionPtr,
 				CMFileStream*						resultsFileStreamPtr,
 				CMFileStream*						clProbabilityFileStreamPtr,
+				OutputWriterPtr					resultsWriterPtr,
+				OutputWriterPtr					probabilityWriterPtr,
 				HSInt64Ptr							countVectorPtr,
 				SInt32								lineCount);
 
@@ -4602,6 +4604,25 @@ extern SInt16 GetLineOfData (
 				HUCharPtr							fileIOBufferPtr,
 				HUCharPtr							dataBufferPtr);
 
+extern SInt16 GetLinesOfData (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				UInt32								lineStart,
+				UInt32								lineCount,
+				UInt32								lineInterval,
+				UInt32								columnStart,
+				UInt32								columnEnd,
+				UInt32								columnInterval,
+				HUCharPtr							fileIOBufferPtr,
+				HUCharPtr							dataBufferPtr,
+				UInt32								dataBufferLineBytes,
+				UInt32*								numberOutputSamplesPtr);
+
+extern HUCharPtr GetLinesOfDataBuffer (
+				UInt32								dataBufferLineBytes,
+				UInt32								numberLines,
+				UInt32*								numberBufferLinesPtr,
+				UInt32**								numberOutputSamplesPtrPtr);
+
 extern SInt32 GetNumberGAIALineSegments (
 				SInt32								numberColumns);
 
@@ -4628,6 +4649,9 @@ extern SInt16 GetSizeOfFile (
 extern SInt64 GetSizeOfImage (
 				FileInfoPtr							fileInfoPtr);
 
+extern Boolean GetThreadedIOFlag (
+				FileIOInstructionsPtr			fileIOInstructionsPtr);
+
 extern SInt16 GetVolumeFreeSpace (
 				CMFileStream*						fileStreamPtr,
 				SInt16								vRefNum,
@@ -4728,6 +4752,9 @@ extern SInt16 PutFile (
 				SInt16								promptStringIndex,
 				SInt32								creator);
 
+extern void ReleaseTileCacheEntries (
+				CMFileStream*						fileStreamPtr);
+
 extern void ResetOutputDirectory (void);
 
 extern SInt16 ResolveAnyAliases (
@@ -4771,6 +4798,10 @@ extern void SetType (
 				CMFileStream*						fileStreamPtr,
 				SInt32								type);
 
+extern void SetUpAreaColumnRuns (
+				FileIOInstructionsPtr			fileIOInstructionsPtr,
+				AreaDescriptionPtr				areaDescriptionPtr);
+
 extern SInt16 SetUpFileIOInstructions (
 				FileIOInstructionsPtr			fileIOInstructionsPtr,
 				AreaDescription*					areaDescriptionPtr,
@@ -4969,6 +5000,31 @@ extern Boolean ReadPRJFileInformation (
 
 		// Routines in SGeoTIFF.cpp
 
+extern Boolean CheckIfTIFFCompressionCanBeRead (
+				UInt16								dataCompressionCode);
+
+extern SInt16 DecodeTIFFBlock (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							inputBufferPtr,
+				UInt32								numberInputBytes,
+				HUCharPtr							outputBufferPtr,
+				UInt32								numberOutputBytes,
+				UInt32								numberRowBytes,
+				HUCharPtr							rowBufferPtr);
+
+extern Handle DisposeTIFFOverviewHandle (
+				Handle								tiffOverviewHandle);
+
+extern SInt16 EncodeTIFFBlock (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							inputBufferPtr,
+				UInt32								numberInputBytes,
+				HUCharPtr							outputBufferPtr,
+				UInt32								numberOutputBytes,
+				UInt32								numberRowBytes,
+				HUCharPtr							rowBufferPtr,
+				UInt32*								numberBytesEncodedPtr);
+
 extern SInt16 GetGTModelTypeGeoKey (
 				FileInfoPtr							fileInfoPtr);
 
@@ -4986,6 +5042,9 @@ extern SInt16 GetTIFFASCIIParameters (
 				char*									stringPtr,
 				SInt32								numberCharacters);
 
+extern UInt32 GetTIFFEncodeBufferBytes (
+				UInt32								numberInputBytes);
+
 extern void GetTIFFImageDescription (
 				FileInfoPtr							fileInfoPtr,
 				char*									imageDescriptionStringPtr,
@@ -6447,6 +6506,7 @@ extern void CloseMaskStructure (
 				MaskInfoPtr							maskInfoPtr);
 
 extern Boolean DetermineIfMaskDataInLine (
+				MaskInfoPtr							maskInfoPtr,
 				UInt16*								maskBufferPtr,
 				UInt32								maskColumnStart,
 				UInt32								numberSamples,
@@ -6498,6 +6558,33 @@ extern MaskInfoPtr GetMaskInfoPointer (
 				ProjectInfoPtr						projectInfoPtr,
 				WindowInfoPtr						windowInfoPtr);
 
+extern UInt32 GetMaskLine (
+				MaskInfoPtr							maskInfoPtr,
+				HUInt16Ptr							maskBufferPtr);
+
+extern UInt32 GetMaskLineRuns (
+				MaskInfoPtr							maskInfoPtr,
+				UInt32								maskLine,
+				MaskRunPtr*							maskRunPtrPtr);
+
+extern UInt32 GetMaskRunColumns (
+				MaskRunPtr							maskRunPtr,
+				UInt32								columnStart,
+				UInt32								columnEnd,
+				UInt32								columnInterval,
+				UInt32*								firstColumnPtr,
+				UInt32*								lastColumnPtr);
+
+extern UInt32 GetNextMaskLine (
+				MaskInfoPtr							maskInfoPtr,
+				UInt32								maskValueRequest,
+				UInt32								maskLine,
+				UInt32								maskLineEnd,
+				UInt32								lineInterval,
+				UInt32								maskColumnStart,
+				UInt32								maskColumnEnd,
+				UInt32								columnInterval);
+
 extern SInt64 GetNumberPixelsInMaskArea (
 				MaskInfoPtr							maskInfoPtr,
 				UInt16								maskValueRequest,
@@ -7915,6 +8002,10 @@ extern void UpdateProjectMapProjectionHandle (
 
 		// Routines in SProjectComputeStatistics.cpp
 
+extern void AddTrainingPixelSample (
+				HDoublePtr							valuesPtr,
+				UInt16								label);
+
 extern Boolean CheckMatrix (
 				HDoublePtr							covariancePtr,
 				Boolean								squareOutputMatrixFlag,
@@ -8161,6 +8252,14 @@ extern void InitializeChannelMinimums (
 extern void CloseFile (
 				ProjectInfoPtr						projectInfoPtr);
 
+extern void CloseTrainingStore (
+				ProjectInfoPtr						projectInfoPtr);
+
+extern Boolean CreateTrainingStore (
+				SInt64								numberTrainPixels);
+
+extern Boolean FinishTrainingStore (void);
+
 extern void GetCopyOfPFileNameFromProjectInfo (
 				ProjectInfoPtr						projectInfoPtr,
 				FileStringPtr						outputPtr);
@@ -8175,6 +8274,21 @@ extern Boolean GetProjectFile (
 
 extern SInt32 GetSizeOfProjectFile (void);
 
+extern Boolean LoadBinaryFieldStatistics (
+				SInt32								storageIndex);
+
+extern Boolean LoadTrainingStoreFieldSamples (
+				UInt16								fieldNumber,
+				UInt16								label);
+
+extern Boolean OpenTrainingStore (void);
+
+extern void SetTrainingStoreField (
+				UInt16								fieldNumber,
+				SInt64								firstSample);
+
+extern void WriteTrainingStoreBuffer (void);
+
 		// end SProjectFileIO.cpp 
 
 
@@ -8363,7 +8477,8 @@ extern Boolean InvertSymmetricMatrix (
 				SInt16*								ipvot,
 				double*								determinantPtr,
 				double*								logDeterminantPtr,
-				Boolean								inverseRequestedFlag);
+				Boolean								inverseRequestedFlag,
+				Boolean								checkEventsFlag);
 
 extern void ReleaseMatrixInversionMemory (void);
 
@@ -8411,6 +8526,7 @@ extern double Bhattacharyya (
 				double								logDeterminant1,
 				double								logDeterminant2,
 				HDoublePtr							meanDifPtr,
+				InverseMatrixMemoryPtr			inverseMatrixMemoryPtr,
 				SInt16								numberFeatures);
 
 extern void ChangeProjectAssociatedImageItem (
@@ -8661,6 +8777,17 @@ extern SInt16 GetProjectFieldsBoundingArea (
 				SInt32								areaColumnEnd,
 				LongRect*							longRectPtr);
 
+extern UInt32 GetPolygonColumnRuns (
+				HPFieldPointsPtr					fieldPointsPtr,
+				UInt32								numberPoints,
+				SInt32								columnOffset,
+				SInt32								lineOffset,
+				SInt32								line,
+				SInt32								columnStart,
+				SInt32								columnEnd,
+				double*								workPtr,
+				MaskRunPtr							maskRunPtr);
+
 extern float* GetTempClassWeightsPtr (void);
 
 extern SInt64 GetTotalNumberPixelsInField (
@@ -9143,6 +9270,12 @@ extern void ChangeImageFormatDialogUpdateTIFFHeader (
 				SInt16*								bandInterleaveSelectionPtr,
 				MenuHandle							popUpOutputFileMenu);
 
+extern void ChangeImageFormatDialogUpdateTIFFOptions (
+				DialogPtr							dialogPtr,
+				SInt16								headerOptionsSelection,
+				SInt16								bandInterleaveSelection,
+				SInt16								tiffCompressionListSelection);
+
 extern void ChangeImageFormatDialogVerifyHeaderSetting (
 				DialogPtr							dialogPtr,
 				FileInfoPtr							fileInfoPtr,
@@ -9314,6 +9447,14 @@ extern SInt16 TransformCoordinatePoint (
 
 		// Routines in SSaveWrite.cpp	
 
+extern SInt16 CloseTIFFStripWriter (
+				TIFFStripWriterPtr				tiffStripWriterPtr,
+				Boolean								finishFlag);
+
+extern TIFFStripWriterPtr CreateTIFFStripWriter (
+				FileInfoPtr							fileInfoPtr,
+				CMFileStream*						fileStreamPtr);
+
 extern SInt16 FindEndOfLineCode (
 				ParmBlkPtr							paramBlockPtr,
 				CMFileStream*						fileStreamPtr,
@@ -9393,6 +9534,12 @@ extern Boolean WriteTIFFImageFile (
 				UInt32								startMapColumn,
 				UInt32								startMapLine);
 
+extern SInt16 WriteTIFFStripData (
+				TIFFStripWriterPtr				tiffStripWriterPtr,
+				SInt64								imageDataOffset,
+				HUCharPtr							dataPtr,
+				UInt32								numberBytes);
+
 extern void WriteTransformationFile (void);
 
 		// end SSaveWrite.cpp
@@ -10760,8 +10907,14 @@ extern void UpdateThematicLegendControls (
 
 		// Routines in SThreads.cpp
 
+extern SInt16 CloseOutputWriter (
+				OutputWriterPtr					outputWriterPtr);
+
 extern OSErr CreateFileIOThreadPool (void);
 
+extern OutputWriterPtr CreateOutputWriter (
+				CMFileStream*						fileStreamPtr);
+
 extern void EndFileIOThread (
 				FileIOInstructionsPtr			fileIOInstructionsPtr);
 
@@ -10775,12 +10928,25 @@ extern SInt16 GetLineFileIOThread (
 				UInt32*								numberSamplesPtr,
 				HUCharPtr*							fileIOBufferPtrPtr);
 
+extern UInt32 GetNumberWorkerThreads (
+				UInt32								numberTasks);
+
+extern void RunTasksInParallel (
+				UInt32								numberTasks,
+				void									(*taskRoutine) (void*, UInt32),
+				void*									taskInfoPtr);
+
 extern SInt16 SetupFileIOThread (
 				FileIOInstructionsPtr			fileIOInstructionsPtr);
 
 extern SInt16 StartFileIOThread (
 				FileIOInstructionsPtr			fileIOInstructionsPtr);
 
+extern SInt16 WriteToOutputWriter (
+				OutputWriterPtr					outputWriterPtr,
+				void*									inBufferPtr,
+				UInt32								numberBytes);
+
 		// end SThreads.cpp
 
 
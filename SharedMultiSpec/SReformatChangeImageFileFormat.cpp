@@ -722,6 +722,35 @@ Boolean ChangeFormatToBILorBISorBSQ (
 																																	
 		}	// end "if (reformatOptionsPtr->transformDataCode == kCreatePCImage)" 
 	
+			// Compress the data if a new TIFF file is being created and compressed
+			// TIFF files have been requested. The strip offsets are limited to 32 
+			// bits so the data are not compressed for very large images.
+			
+	if ((outFileInfoPtr->format == kTIFFType || 
+								outFileInfoPtr->format == kGeoTIFFType) &&
+			reformatOptionsPtr->outputFileCode == kNewFileMenuItem &&
+				(outFileInfoPtr->bandInterleave == kBIS ||
+									outFileInfoPtr->bandInterleave == kBSQ) &&
+					gTIFFOutputCompressionCode != kNoCompression &&
+						(SInt64)outFileInfoPtr->bytesPer1line1chan * 
+							outFileInfoPtr->numberLines * outFileInfoPtr->numberChannels <=
+																						UInt32_MAX)
+		{
+		outFileInfoPtr->dataCompressionCode = kLZWCompression;
+		#if include_zlib_capability
+			if (gTIFFOutputCompressionCode == kDeflateCompression)
+				outFileInfoPtr->dataCompressionCode = kDeflateCompression;
+		#endif	// include_zlib_capability
+		
+		outFileInfoPtr->predictorCode = 2;
+		if (outFileInfoPtr->dataTypeCode == kRealType)
+			outFileInfoPtr->predictorCode = 3;
+		
+		else if (outFileInfoPtr->thematicType)
+			outFileInfoPtr->predictorCode = 1;
+		
+		}	// end "if ((outFileInfoPtr->format == kTIFFType || ..."
+	
 			// Write a header if requested.													
 			
 	continueFlag = WriteNewImageHeader (fileInfoPtr,
@@ -738,8 +767,10 @@ Boolean ChangeFormatToBILorBISorBSQ (
 			// If the header was created okay and the output interleave is to be BSQ,
 			// set the end of the file to the size of the file. This is done because
 			// the data will not be written to the file in sequential order.
+			// Compressed TIFF strips are written in sequential order.
 			
-	if (continueFlag && outFileInfoPtr->bandInterleave == kBSQ)
+	if (continueFlag && outFileInfoPtr->bandInterleave == kBSQ &&
+								outFileInfoPtr->dataCompressionCode == kNoCompression)
 		{
 		SInt64 numberBytes = (SInt64)outFileInfoPtr->bytesPer1line1chan *
 		outFileInfoPtr->numberLines * outFileInfoPtr->numberChannels +
@@ -762,6 +793,18 @@ Boolean ChangeFormatToBILorBISorBSQ (
 			continueFlag = FALSE;
 		
 		}	// end "if (errCode == noErr && ...->bandInterleave == kBSQ && ..."
+		
+			// Get the writer for the strips if the TIFF file is to be compressed.
+			
+	if (continueFlag && outFileInfoPtr->dataCompressionCode != kNoCompression)
+		{
+		reformatOptionsPtr->tiffStripWriterPtr = 
+								CreateTIFFStripWriter (outFileInfoPtr, outFileStreamPtr);
+								
+		if (reformatOptionsPtr->tiffStripWriterPtr == NULL)
+			continueFlag = FALSE;
+		
+		}	// end "if (continueFlag && ...->dataCompressionCode != kNoCompression)"
 					
 			// Return if there was an IO error									
 			
@@ -935,7 +978,9 @@ Boolean ChangeFormatToBILorBISorBSQ (
 					CleanUpChangeFormat (newPaletteIndexPtr, 
 													symbolToOutputBinPtr, 
 													tempBufferPtr);	
-					CloseUpFileIOInstructions (fileIOInstructionsPtr, NULL);					
+					CloseUpFileIOInstructions (fileIOInstructionsPtr, NULL);
+					CloseTIFFStripWriter (reformatOptionsPtr->tiffStripWriterPtr, FALSE);
+					reformatOptionsPtr->tiffStripWriterPtr = NULL;
 																					return (FALSE);
 					
 					}	// end "if (errCode != noErr)"
@@ -998,7 +1043,9 @@ Boolean ChangeFormatToBILorBISorBSQ (
 						CleanUpChangeFormat (newPaletteIndexPtr, 
 														symbolToOutputBinPtr, 
 														tempBufferPtr);	
-						CloseUpFileIOInstructions (fileIOInstructionsPtr, NULL);					
+						CloseUpFileIOInstructions (fileIOInstructionsPtr, NULL);
+						CloseTIFFStripWriter (reformatOptionsPtr->tiffStripWriterPtr, FALSE);
+						reformatOptionsPtr->tiffStripWriterPtr = NULL;
 																						return (FALSE);
 						
 						}	// end "if (errCode != noErr)"
@@ -1600,13 +1647,32 @@ Boolean ChangeFormatToBILorBISorBSQ (
 															numberOutsideLoops);
 															
 			}	// end "if (errCode == noErr && totalIOOutBytes > 0)" 
+			
+				// Write the strips that are left and the strip offsets and byte
+				// counts for compressed TIFF files.
+				
+		if (reformatOptionsPtr->tiffStripWriterPtr != NULL)
+			{
+			if (errCode == noErr && continueFlag)
+				errCode = CloseTIFFStripWriter (reformatOptionsPtr->tiffStripWriterPtr,
+															TRUE);
+				
+			else	// errCode != noErr || !continueFlag
+				CloseTIFFStripWriter (reformatOptionsPtr->tiffStripWriterPtr, FALSE);
+				
+			reformatOptionsPtr->tiffStripWriterPtr = NULL;
+			
+			}	// end "if (reformatOptionsPtr->tiffStripWriterPtr != NULL)"
 															
 		if (errCode != noErr)
 			continueFlag = FALSE;
 		
 				// Write channel discriptions at the end of the file if needed.	
+				// They are not written for compressed TIFF files since the end of
+				// the image data is not at the location expected for them.
 		
-		if (continueFlag && reformatOptionsPtr->channelDescriptions)	
+		if (continueFlag && reformatOptionsPtr->channelDescriptions &&
+								outFileInfoPtr->dataCompressionCode == kNoCompression)	
 			WriteChannelDescriptionsAndValues (
 										outFileInfoPtr,
 										(SInt16*)fileWavelengthOrderPtr,
@@ -4272,6 +4338,59 @@ void ChangeImageFormatDialogUpdateTIFFHeader (
 
 
                        
+#if defined multispec_win || defined multispec_wx
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void ChangeImageFormatDialogUpdateTIFFOptions
+//
+//	Software purpose:	The purpose of this routine is to show the TIFF compression
+//							options only when they can be used, i.e. when a TIFF/GeoTIFF
+//							file is to be written in BSQ or BIS band format. The overview
+//							option is only available when the file is compressed.
+//
+//	Parameters in:		Pointer to the dialog
+//							Header options selection
+//							Band interleave selection
+//							TIFF compression list selection; 0 is "None"
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			OnInitDialog, OnSelendokBandInterleave, OnSelendokDataValueType,
+//							OnSelendokHeader and OnSelendokTIFFCompression in
+//							xReformatChangeDialog.cpp and WReformatChangeDialog.cpp
+
+void ChangeImageFormatDialogUpdateTIFFOptions (
+				DialogPtr							dialogPtr,
+				SInt16								headerOptionsSelection,
+				SInt16								bandInterleaveSelection,
+				SInt16								tiffCompressionListSelection)
+
+{
+	Boolean								showFlag;
+	
+	
+	showFlag = (headerOptionsSelection == kTIFFGeoTIFFMenuItem &&
+						(bandInterleaveSelection == kBSQMenuItem ||
+											bandInterleaveSelection == kBISMenuItem));
+	
+	ShowHideDialogItem (dialogPtr, IDC_TIFFCompressionPrompt, showFlag);
+	ShowHideDialogItem (dialogPtr, IDC_TIFFCompression, showFlag);
+	ShowHideDialogItem (dialogPtr, IDC_TIFFOverviews, showFlag);
+	
+	if (tiffCompressionListSelection > 0)
+		SetDLogControlHilite (dialogPtr, IDC_TIFFOverviews, 0);
+		
+	else	// tiffCompressionListSelection <= 0
+		SetDLogControlHilite (dialogPtr, IDC_TIFFOverviews, 255);
+	
+}	// end "ChangeImageFormatDialogUpdateTIFFOptions"
+#endif	// defined multispec_win || defined multispec_wx
+
+
+                       
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -8496,6 +8615,7 @@ void InitializeReformatStructure (
 		reformatOptionsPtr->pcChannelHandle = NULL;
 		reformatOptionsPtr->rightBottomMosaicWindowInfoHandle = NULL;
 		reformatOptionsPtr->rectifyImageOptionsPtr = NULL;
+		reformatOptionsPtr->tiffStripWriterPtr = NULL;
 		reformatOptionsPtr->ioOutAdjustBufferPtr = NULL;
 		reformatOptionsPtr->ioOutBufferPtr = NULL;
 		reformatOptionsPtr->fileInfoListPtr = NULL;
@@ -3896,6 +3896,45 @@ SInt16 WriteOutputDataToFile (
 		
 	outputBufferOffset = 0;
 	
+	if (reformatOptionsPtr->tiffStripWriterPtr != NULL)
+		{
+				// The data for compressed TIFF files are loaded into the TIFF strip
+				// writer. The data are in file order if the interleave is BIS or
+				// all lines for a channel are done before the next channel.
+				
+		if (outFileInfoPtr->bandInterleave == kBIS || numberOutsideLoops > 1)
+			errCode = WriteTIFFStripData (reformatOptionsPtr->tiffStripWriterPtr,
+														-1,
+														ioOutBufferPtr,
+														totalIOOutBytes);
+		
+		else	// outFileInfoPtr->bandInterleave == kBSQ && numberOutsideLoops == 1
+			{
+			positionOffset = 
+						(SInt64)lastOutputWrittenLine * numberBytesPerLineAndChannel;
+			numberBytesPerChannel = totalIOOutBytes/numberOutChannels;
+			fileBSQOffsetIncrement =
+								(SInt64)numberOutputLines * numberBytesPerLineAndChannel;
+						
+			for (channelCount=1; channelCount<=numberOutChannels; channelCount++)
+				{
+				errCode = WriteTIFFStripData (reformatOptionsPtr->tiffStripWriterPtr,
+															positionOffset,
+															&ioOutBufferPtr[outputBufferOffset],
+															numberBytesPerChannel);
+				if (errCode != noErr)
+					break;
+				
+				positionOffset += fileBSQOffsetIncrement;
+				outputBufferOffset += outBSQOffsetIncrement;
+				
+				}	// end "for (channelCount=1; ..."
+			
+			}	// end "else ...->bandInterleave == kBSQ && numberOutsideLoops == 1"
+																						return (errCode);
+		
+		}	// end "if (reformatOptionsPtr->tiffStripWriterPtr != NULL)"
+	
 	if (outFileInfoPtr->bandInterleave == kBSQ ||
 												outFileInfoPtr->bandInterleave == kBNonSQ)
 		{
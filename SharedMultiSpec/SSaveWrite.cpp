@@ -82,21 +82,115 @@
 #define	kDoNotIncludeUTM						0
 #define	kIncludeUTM								1
 
+		// Offsets of the StripOffsets (273) and StripByteCounts (279) entries in the
+		// image file directory written by WriteTIFFImageFile. The values for these
+		// entries are set by CloseTIFFStripWriter after the strips of a compressed
+		// TIFF file have been written.
+#define	kTIFFStripOffsetsEntryOffset		94
+#define	kTIFFStripByteCountsEntryOffset	130
+
+
+		// Structure used to compress the strips of a TIFF file with several threads
+		// and write them to the file in the order that they were compressed. The
+		// data for each plane (all channels for BIS, each channel for BSQ) are loaded
+		// in the plane's strip buffer. A full strip is moved to a slot; the strips
+		// in the slots are compressed at the same time when all slots are used.
+		// The rows of a strip that is moved to a slot are also reduced to the rows
+		// of the next reduced resolution image (overview) which has its own writer.
+
+typedef struct TIFFStripWriter
+	{
+			// Offset in the file for the next strip to be written.
+	SInt64							nextStripOffset;
+	
+			// Number of bytes of uncompressed data in each plane.
+	SInt64							numberPlaneBytes;
+	
+			// Offset in the uncompressed image data just after the last data loaded.
+	SInt64							streamOffset;
+	
+	CMFileStream*					fileStreamPtr;
+	FileInfoPtr						fileInfoPtr;
+	
+			// Writer for the next smaller overview and the full resolution writer
+			// whose next strip offset is shared by all of the overview writers. The
+			// file information structure for an overview writer is a copy of the
+			// full resolution one with the size of the overview.
+	TIFFStripWriterPtr			overviewWriterPtr;
+	TIFFStripWriterPtr			mainWriterPtr;
+	FileInfoPtr						overviewFileInfoPtr;
+	
+			// Two rows of this image for each plane and one row of the next overview
+			// used to reduce the rows to the overview and the number of rows of each
+			// plane that have been given to the overview.
+	HUCharPtr						overviewRowsBufferPtr;
+	HUCharPtr						overviewOutputRowPtr;
+	UInt32*							overviewRowsLoadedPtr;
+	
+			// Strip buffer for each plane, the uncompressed and compressed strips for
+			// each slot and one row of data for each slot for the floating point 
+			// predictor.
+	HUCharPtr						planeBufferPtr;
+	HUCharPtr						rawStripBufferPtr;
+	HUCharPtr						encodedStripBufferPtr;
+	HUCharPtr						rowBufferPtr;
+	
+			// Number of bytes loaded for each plane.
+	SInt64*							planeBytesLoadedPtr;
+	
+			// Offset and number of bytes in the file for each strip.
+	UInt32*							stripOffsetsPtr;
+	UInt32*							stripByteCountsPtr;
+	
+			// Strip index, number of uncompressed bytes, number of compressed bytes
+			// and return code for the strip in each slot.
+	UInt32*							slotStripIndexPtr;
+	UInt32*							slotNumberBytesPtr;
+	UInt32*							slotEncodedBytesPtr;
+	SInt16*							slotErrCodePtr;
+	
+	UInt32							encodedStripBytes;
+	UInt32							numberPlanes;
+	UInt32							numberRowBytes;
+	UInt32							numberSlots;
+	UInt32							numberSlotsUsed;
+	UInt32							numberStrips;
+	UInt32							numberStripsPerPlane;
+	UInt32							stripBytes;
+	
+	} TIFFStripWriter;
+
 
                
 			// Prototypes for routines in this file that are only called by		
 			// other routines in this file.	
 							
+SInt16	AddTIFFOverviewRow (
+				TIFFStripWriterPtr				tiffStripWriterPtr,
+				UInt32								plane,
+				HUCharPtr							rowPtr);
+
+void		CreateTIFFOverviewWriter (
+				TIFFStripWriterPtr				tiffStripWriterPtr);
+
 Boolean 	GetGroupInfoFile (
 				Handle								inputFileInfoHandle,
 				FileInfoPtr							outputFileInfoPtr);
 
+void		EncodeTIFFStrip (
+				void*									taskInfoPtr,
+				UInt32								task);
+
+SInt16	FlushTIFFStripWriter (
+				TIFFStripWriterPtr				tiffStripWriterPtr);
+
 UInt32	GetNumberStripsToUse (
 				SInt16								planarConfiguration,
 				UInt32								numberColumns,
 				UInt32								numberLines,
 				UInt32								numberChannels,
 				UInt32								numberBytes,
+				Boolean								compressedFlag,
 				UInt32*								numberStripsPtr,
 				UInt32*								numberStripsPerChannelsPtr,
 				UInt32*								numberBytesPerStripPtr,
@@ -105,6 +199,11 @@ UInt32	GetNumberStripsToUse (
 Boolean 	GetThematicSupportFile (
 				FileInfoPtr							fileInfoPtr);
 
+double	GetTIFFOverviewSample (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							rowPtr,
+				UInt32								sampleIndex);
+
 UInt32 	LoadGeoDoubleValue (
 				char*									geoTiffInfoBufferPtr,
 				UInt32								index,
@@ -210,6 +309,18 @@ void		ReadTransformationGetFileSizes (
 				UInt32*								computedFileSize2Ptr,
 				UInt32*								computedFileSize3Ptr);
 
+void		ReduceTIFFOverviewRows (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							row1Ptr,
+				HUCharPtr							row2Ptr,
+				HUCharPtr							outputRowPtr);
+
+void		SetTIFFOverviewSample (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							rowPtr,
+				UInt32								sampleIndex,
+				double								value);
+
 Boolean 	WriteArcViewWorldFile (
 				FileInfoPtr 						fileInfoPtr);
 
@@ -248,6 +359,14 @@ SInt16	 WriteTIFFImageData (
 				Rect*									areaRectanglePtr,
 				UInt16								paletteOffset);
 
+SInt16	WriteTIFFOverviewDirectories (
+				TIFFStripWriterPtr				tiffStripWriterPtr);
+
+SInt16	WriteTIFFStripTables (
+				TIFFStripWriterPtr				tiffStripWriterPtr,
+				UInt32*								stripOffsetsValuePtr,
+				UInt32*								stripByteCountsValuePtr);
+
 Boolean 	WriteTextOutputFile (
 				SInt16     							refNum, 
 				Str255*								fileNamePtr,
@@ -262,6 +381,574 @@ Boolean 	WriteTextOutputFile (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 AddTIFFOverviewRow
+//
+//	Software purpose:	The purpose of this routine is to give one row of a plane of
+//							the image being written by a TIFF strip writer to the next
+//							reduced resolution image (overview). Every two rows are reduced
+//							to one row of the overview which is then loaded into the
+//							overview's strip writer. The last row of an image with an odd
+//							number of lines is reduced by itself.
+//
+//	Parameters in:		Pointer to the TIFF strip writer for the image.
+//							Plane that the row is for.
+//							Pointer to the row in the byte order of this computer.
+//
+//	Parameters out:	None
+//
+// Value Returned:	noErr if the row was used. An error code if not.
+//
+// Called By:			WriteTIFFStripData in SSaveWrite.cpp
+
+SInt16 AddTIFFOverviewRow (
+				TIFFStripWriterPtr				tiffStripWriterPtr,
+				UInt32								plane,
+				HUCharPtr							rowPtr)
+
+{
+	HUCharPtr							planeRowsPtr,
+											row2Ptr;
+	
+	TIFFStripWriterPtr				overviewWriterPtr;
+	
+	UInt32								numberRowBytes,
+											rowIndex;
+	
+	
+	overviewWriterPtr = tiffStripWriterPtr->overviewWriterPtr;
+	numberRowBytes = tiffStripWriterPtr->numberRowBytes;
+	
+	planeRowsPtr = &tiffStripWriterPtr->overviewRowsBufferPtr[
+																(SInt64)plane*2*numberRowBytes];
+	
+	rowIndex = tiffStripWriterPtr->overviewRowsLoadedPtr[plane];
+	BlockMoveData (rowPtr, &planeRowsPtr[(rowIndex%2)*numberRowBytes], numberRowBytes);
+	rowIndex++;
+	tiffStripWriterPtr->overviewRowsLoadedPtr[plane] = rowIndex;
+	
+	if (rowIndex%2 == 1 && rowIndex < tiffStripWriterPtr->fileInfoPtr->numberLines)
+																					return (noErr);
+	
+	row2Ptr = &planeRowsPtr[numberRowBytes];
+	if (rowIndex%2 == 1)
+		row2Ptr = planeRowsPtr;
+	
+	ReduceTIFFOverviewRows (tiffStripWriterPtr->fileInfoPtr,
+									planeRowsPtr,
+									row2Ptr,
+									tiffStripWriterPtr->overviewOutputRowPtr);
+	
+	return (WriteTIFFStripData (
+						overviewWriterPtr,
+						plane * overviewWriterPtr->numberPlaneBytes +
+									(SInt64)((rowIndex-1)/2) * overviewWriterPtr->numberRowBytes,
+						tiffStripWriterPtr->overviewOutputRowPtr,
+						overviewWriterPtr->numberRowBytes));
+	
+}	// end "AddTIFFOverviewRow"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 CloseTIFFStripWriter
+//
+//	Software purpose:	The purpose of this routine is to compress and write any
+//							strips that are left in the TIFF strip writer and its overview
+//							writers, write the strip offsets and byte counts after the 
+//							image data and set the StripOffsets and StripByteCounts entries
+//							in the image file directory to them. The image file directories
+//							for the overviews are then written. The memory for the writers
+//							is then released.
+//
+//	Parameters in:		Pointer to the TIFF strip writer.
+//							Flag indicating whether the file is to be finished. If FALSE,
+//								the memory is released without anything being written.
+//
+//	Parameters out:	None
+//
+// Value Returned:	noErr if the file was finished. An error code if not.
+//
+// Called By:			ChangeFormatToBILorBISorBSQ in SReformatChangeImageFileFormat.cpp
+//							CloseTIFFStripWriter in SSaveWrite.cpp
+//							CreateTIFFOverviewWriter in SSaveWrite.cpp
+//							CreateTIFFStripWriter in SSaveWrite.cpp
+
+SInt16 CloseTIFFStripWriter (
+				TIFFStripWriterPtr				tiffStripWriterPtr,
+				Boolean								finishFlag)
+
+{
+	CMFileStream*						fileStreamPtr;
+	
+	TIFFStripWriterPtr				overviewWriterPtr;
+	
+	UInt32								count,
+											plane,
+											stripByteCountsValue,
+											stripOffsetsValue;
+	
+	SInt16								errCode = noErr;
+	
+	
+	if (tiffStripWriterPtr == NULL)
+																					return (noErr);
+																					
+	if (finishFlag)
+		{
+		fileStreamPtr = tiffStripWriterPtr->fileStreamPtr;
+		
+		errCode = FlushTIFFStripWriter (tiffStripWriterPtr);
+		
+		overviewWriterPtr = tiffStripWriterPtr->overviewWriterPtr;
+		while (overviewWriterPtr != NULL && errCode == noErr)
+			{
+			errCode = FlushTIFFStripWriter (overviewWriterPtr);
+			overviewWriterPtr = overviewWriterPtr->overviewWriterPtr;
+			
+			}	// end "while (overviewWriterPtr != NULL && errCode == noErr)"
+		
+				// Make sure that all of the data for the image and the overviews
+				// have been written.
+		
+		overviewWriterPtr = tiffStripWriterPtr;
+		while (overviewWriterPtr != NULL)
+			{
+			for (plane=0; plane<overviewWriterPtr->numberPlanes; plane++)
+				{
+				if (overviewWriterPtr->planeBytesLoadedPtr[plane] != 
+															overviewWriterPtr->numberPlaneBytes)
+					errCode = -1;
+					
+				}	// end "for (plane=0; plane<...->numberPlanes; plane++)"
+				
+			overviewWriterPtr = overviewWriterPtr->overviewWriterPtr;
+			
+			}	// end "while (overviewWriterPtr != NULL)"
+		
+		if (errCode == noErr)
+			errCode = WriteTIFFStripTables (tiffStripWriterPtr,
+														&stripOffsetsValue,
+														&stripByteCountsValue);
+		
+		if (errCode == noErr)
+			{
+			if (tiffStripWriterPtr->fileInfoPtr->swapBytesFlag)
+				{
+				SwapBytes (4, (HUInt8Ptr)&stripOffsetsValue, 1);
+				SwapBytes (4, (HUInt8Ptr)&stripByteCountsValue, 1);
+				
+				}	// end "if (tiffStripWriterPtr->fileInfoPtr->swapBytesFlag)"
+				
+					// Now set the values for the StripOffsets and StripByteCounts
+					// entries in the image file directory.
+					
+			errCode = MSetMarker (fileStreamPtr, 
+											fsFromStart, 
+											kTIFFStripOffsetsEntryOffset + 8,
+											kErrorMessages);
+				
+			if (errCode == noErr)
+				{
+				count = 4;
+				errCode = MWriteData (fileStreamPtr, 
+												&count, 
+												&stripOffsetsValue, 
+												kErrorMessages);
+				
+				}	// end "if (errCode == noErr)"
+				
+			if (errCode == noErr)
+				errCode = MSetMarker (fileStreamPtr, 
+												fsFromStart, 
+												kTIFFStripByteCountsEntryOffset + 8,
+												kErrorMessages);
+				
+			if (errCode == noErr)
+				{
+				count = 4;
+				errCode = MWriteData (fileStreamPtr, 
+												&count, 
+												&stripByteCountsValue, 
+												kErrorMessages);
+				
+				}	// end "if (errCode == noErr)"
+			
+			}	// end "if (errCode == noErr)"
+			
+		if (errCode == noErr && tiffStripWriterPtr->overviewWriterPtr != NULL)
+			errCode = WriteTIFFOverviewDirectories (tiffStripWriterPtr);
+		
+		}	// end "if (finishFlag)"
+		
+	CloseTIFFStripWriter (tiffStripWriterPtr->overviewWriterPtr, FALSE);
+	
+	CheckAndDisposePtr ((Ptr)tiffStripWriterPtr->overviewFileInfoPtr);
+	CheckAndDisposePtr ((Ptr)tiffStripWriterPtr->overviewRowsBufferPtr);
+	CheckAndDisposePtr ((Ptr)tiffStripWriterPtr->overviewOutputRowPtr);
+	CheckAndDisposePtr ((Ptr)tiffStripWriterPtr->overviewRowsLoadedPtr);
+	CheckAndDisposePtr ((Ptr)tiffStripWriterPtr->planeBufferPtr);
+	CheckAndDisposePtr ((Ptr)tiffStripWriterPtr->rawStripBufferPtr);
+	CheckAndDisposePtr ((Ptr)tiffStripWriterPtr->encodedStripBufferPtr);
+	CheckAndDisposePtr ((Ptr)tiffStripWriterPtr->rowBufferPtr);
+	CheckAndDisposePtr ((Ptr)tiffStripWriterPtr->planeBytesLoadedPtr);
+	CheckAndDisposePtr ((Ptr)tiffStripWriterPtr->stripOffsetsPtr);
+	CheckAndDisposePtr ((Ptr)tiffStripWriterPtr->stripByteCountsPtr);
+	CheckAndDisposePtr ((Ptr)tiffStripWriterPtr->slotStripIndexPtr);
+	CheckAndDisposePtr ((Ptr)tiffStripWriterPtr->slotNumberBytesPtr);
+	CheckAndDisposePtr ((Ptr)tiffStripWriterPtr->slotEncodedBytesPtr);
+	CheckAndDisposePtr ((Ptr)tiffStripWriterPtr->slotErrCodePtr);
+	CheckAndDisposePtr ((Ptr)tiffStripWriterPtr);
+	
+	return (errCode);
+	
+}	// end "CloseTIFFStripWriter"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void CreateTIFFOverviewWriter
+//
+//	Software purpose:	The purpose of this routine is to create the strip writer for
+//							the reduced resolution image (overview) that is one half the 
+//							size of the image for the input TIFF strip writer. The rows of
+//							the input image will be averaged for continuous data and the
+//							most common value will be used for thematic data. Overviews
+//							are created until both the number of columns and lines are no
+//							more than kTIFFOverviewMinimumSize. If the memory for an
+//							overview cannot be obtained, the file is written without it.
+//
+//	Parameters in:		Pointer to the TIFF strip writer for the larger image.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			CreateTIFFStripWriter in SSaveWrite.cpp
+
+void CreateTIFFOverviewWriter (
+				TIFFStripWriterPtr				tiffStripWriterPtr)
+
+{
+	FileInfoPtr							fileInfoPtr,
+											overviewFileInfoPtr;
+	
+	TIFFStripWriterPtr				overviewWriterPtr;
+	
+	UInt32								plane;
+	
+	
+	fileInfoPtr = tiffStripWriterPtr->fileInfoPtr;
+	
+	if (fileInfoPtr->numberColumns <= kTIFFOverviewMinimumSize &&
+								fileInfoPtr->numberLines <= kTIFFOverviewMinimumSize)
+																						return;
+	
+	if (fileInfoPtr->tiffOverviewIndex >= kMaxNumberTIFFOverviews)
+																						return;
+	
+	overviewFileInfoPtr = (FileInfoPtr)MNewPointer (sizeof (MFileInfo));
+	if (overviewFileInfoPtr == NULL)
+																						return;
+	
+	*overviewFileInfoPtr = *fileInfoPtr;
+	overviewFileInfoPtr->numberColumns = (fileInfoPtr->numberColumns + 1)/2;
+	overviewFileInfoPtr->numberLines = (fileInfoPtr->numberLines + 1)/2;
+	overviewFileInfoPtr->tiffOverviewIndex = fileInfoPtr->tiffOverviewIndex + 1;
+	
+			// This will also create the writers for the smaller overviews.
+			
+	overviewWriterPtr = CreateTIFFStripWriter (overviewFileInfoPtr,
+																tiffStripWriterPtr->fileStreamPtr);
+	
+	if (overviewWriterPtr == NULL)
+		{
+		CheckAndDisposePtr ((Ptr)overviewFileInfoPtr);
+																						return;
+																						
+		}	// end "if (overviewWriterPtr == NULL)"
+	
+	overviewWriterPtr->overviewFileInfoPtr = overviewFileInfoPtr;
+	
+	tiffStripWriterPtr->overviewRowsBufferPtr = (HUCharPtr)MNewPointer (
+			(SInt64)tiffStripWriterPtr->numberPlanes * 2 * 
+															tiffStripWriterPtr->numberRowBytes);
+	tiffStripWriterPtr->overviewOutputRowPtr = 
+							(HUCharPtr)MNewPointer (overviewWriterPtr->numberRowBytes);
+	tiffStripWriterPtr->overviewRowsLoadedPtr = (UInt32*)MNewPointer (
+								tiffStripWriterPtr->numberPlanes * sizeof (UInt32));
+	
+	if (tiffStripWriterPtr->overviewRowsBufferPtr == NULL ||
+			tiffStripWriterPtr->overviewOutputRowPtr == NULL ||
+				tiffStripWriterPtr->overviewRowsLoadedPtr == NULL)
+		{
+		tiffStripWriterPtr->overviewRowsBufferPtr = (HUCharPtr)CheckAndDisposePtr (
+											(Ptr)tiffStripWriterPtr->overviewRowsBufferPtr);
+		tiffStripWriterPtr->overviewOutputRowPtr = (HUCharPtr)CheckAndDisposePtr (
+											(Ptr)tiffStripWriterPtr->overviewOutputRowPtr);
+		tiffStripWriterPtr->overviewRowsLoadedPtr = (UInt32*)CheckAndDisposePtr (
+											(Ptr)tiffStripWriterPtr->overviewRowsLoadedPtr);
+		
+		CloseTIFFStripWriter (overviewWriterPtr, FALSE);
+																						return;
+																						
+		}	// end "if (tiffStripWriterPtr->overviewRowsBufferPtr == NULL || ..."
+		
+	for (plane=0; plane<tiffStripWriterPtr->numberPlanes; plane++)
+		tiffStripWriterPtr->overviewRowsLoadedPtr[plane] = 0;
+	
+	tiffStripWriterPtr->overviewWriterPtr = overviewWriterPtr;
+	
+}	// end "CreateTIFFOverviewWriter"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		TIFFStripWriterPtr CreateTIFFStripWriter
+//
+//	Software purpose:	The purpose of this routine is to create the writer for the
+//							strips of a compressed TIFF file whose header has been written
+//							by WriteTIFFImageFile. The strips are the same as those 
+//							described in the header. The file marker is set to the start
+//							of the image data. The writers for the reduced resolution
+//							images (overviews) are also created if requested.
+//
+//	Parameters in:		File information structure pointer for the output file.
+//							File stream pointer for the output file.
+//
+//	Parameters out:	None
+//
+// Value Returned:	Pointer to the TIFF strip writer. NULL if the memory for the
+//							writer could not be obtained or the marker could not be set.
+//
+// Called By:			ChangeFormatToBILorBISorBSQ in SReformatChangeImageFileFormat.cpp
+//							CreateTIFFOverviewWriter in SSaveWrite.cpp
+
+TIFFStripWriterPtr CreateTIFFStripWriter (
+				FileInfoPtr							fileInfoPtr,
+				CMFileStream*						fileStreamPtr)
+
+{
+	TIFFStripWriterPtr				overviewWriterPtr,
+											tiffStripWriterPtr;
+	
+	UInt32								bytesInLastStrip,
+											bytesPerStrip,
+											numberSlots,
+											numberStrips,
+											numberStripsPerChannel,
+											plane,
+											rowsPerStrip;
+	
+	SInt16								errCode,
+											planarConfiguration;
+	
+	
+	if (fileInfoPtr == NULL || fileStreamPtr == NULL)
+																					return (NULL);
+																					
+	tiffStripWriterPtr = (TIFFStripWriterPtr)MNewPointerClear (sizeof (TIFFStripWriter));
+	if (tiffStripWriterPtr == NULL)
+																					return (NULL);
+	
+	planarConfiguration = 2;
+	tiffStripWriterPtr->numberPlanes = fileInfoPtr->numberChannels;
+	tiffStripWriterPtr->numberRowBytes = 
+								fileInfoPtr->numberColumns * fileInfoPtr->numberBytes;
+	if (fileInfoPtr->bandInterleave == kBIS)
+		{
+		planarConfiguration = 1;
+		tiffStripWriterPtr->numberPlanes = 1;
+		tiffStripWriterPtr->numberRowBytes *= fileInfoPtr->numberChannels;
+		
+		}	// end "if (fileInfoPtr->bandInterleave == kBIS)"
+	
+	rowsPerStrip = GetNumberStripsToUse (planarConfiguration,
+														fileInfoPtr->numberColumns,
+														fileInfoPtr->numberLines,
+														fileInfoPtr->numberChannels,
+														fileInfoPtr->numberBytes,
+														TRUE,
+														&numberStrips,
+														&numberStripsPerChannel,
+														&bytesPerStrip,
+														&bytesInLastStrip);
+	
+	tiffStripWriterPtr->fileInfoPtr = fileInfoPtr;
+	tiffStripWriterPtr->fileStreamPtr = fileStreamPtr;
+	tiffStripWriterPtr->nextStripOffset = fileInfoPtr->numberHeaderBytes;
+	tiffStripWriterPtr->numberPlaneBytes = 
+			(SInt64)tiffStripWriterPtr->numberRowBytes * fileInfoPtr->numberLines;
+	tiffStripWriterPtr->numberStrips = numberStrips;
+	tiffStripWriterPtr->numberStripsPerPlane = numberStripsPerChannel;
+	tiffStripWriterPtr->stripBytes = rowsPerStrip * tiffStripWriterPtr->numberRowBytes;
+	tiffStripWriterPtr->encodedStripBytes = 
+							GetTIFFEncodeBufferBytes (tiffStripWriterPtr->stripBytes);
+	
+			// Use one slot for each thread that can be used to compress the strips
+			// but keep the memory for the slots within the strip buffer limit.
+			
+	numberSlots = GetNumberWorkerThreads (numberStrips);
+	numberSlots = MIN (numberSlots, 
+							kTIFFStripBufferBytes/tiffStripWriterPtr->encodedStripBytes);
+	numberSlots = MAX (numberSlots, 1);
+	tiffStripWriterPtr->numberSlots = numberSlots;
+	
+	tiffStripWriterPtr->planeBufferPtr = (HUCharPtr)MNewPointer (
+			(SInt64)tiffStripWriterPtr->numberPlanes * tiffStripWriterPtr->stripBytes);
+	tiffStripWriterPtr->rawStripBufferPtr = (HUCharPtr)MNewPointer (
+								(SInt64)numberSlots * tiffStripWriterPtr->stripBytes);
+	tiffStripWriterPtr->encodedStripBufferPtr = (HUCharPtr)MNewPointer (
+						(SInt64)numberSlots * tiffStripWriterPtr->encodedStripBytes);
+	tiffStripWriterPtr->rowBufferPtr = (HUCharPtr)MNewPointer (
+							(SInt64)numberSlots * tiffStripWriterPtr->numberRowBytes);
+	tiffStripWriterPtr->planeBytesLoadedPtr = (SInt64*)MNewPointer (
+								tiffStripWriterPtr->numberPlanes * sizeof (SInt64));
+	tiffStripWriterPtr->stripOffsetsPtr = 
+									(UInt32*)MNewPointer (numberStrips * sizeof (UInt32));
+	tiffStripWriterPtr->stripByteCountsPtr = 
+									(UInt32*)MNewPointer (numberStrips * sizeof (UInt32));
+	tiffStripWriterPtr->slotStripIndexPtr = 
+									(UInt32*)MNewPointer (numberSlots * sizeof (UInt32));
+	tiffStripWriterPtr->slotNumberBytesPtr = 
+									(UInt32*)MNewPointer (numberSlots * sizeof (UInt32));
+	tiffStripWriterPtr->slotEncodedBytesPtr = 
+									(UInt32*)MNewPointer (numberSlots * sizeof (UInt32));
+	tiffStripWriterPtr->slotErrCodePtr = 
+									(SInt16*)MNewPointer (numberSlots * sizeof (SInt16));
+	
+	errCode = noErr;
+	if (tiffStripWriterPtr->planeBufferPtr == NULL ||
+			tiffStripWriterPtr->rawStripBufferPtr == NULL ||
+				tiffStripWriterPtr->encodedStripBufferPtr == NULL ||
+					tiffStripWriterPtr->rowBufferPtr == NULL ||
+						tiffStripWriterPtr->planeBytesLoadedPtr == NULL ||
+							tiffStripWriterPtr->stripOffsetsPtr == NULL ||
+								tiffStripWriterPtr->stripByteCountsPtr == NULL ||
+									tiffStripWriterPtr->slotStripIndexPtr == NULL ||
+										tiffStripWriterPtr->slotNumberBytesPtr == NULL ||
+											tiffStripWriterPtr->slotEncodedBytesPtr == NULL ||
+												tiffStripWriterPtr->slotErrCodePtr == NULL)
+		errCode = -1;
+		
+	if (errCode == noErr)
+		{
+		for (plane=0; plane<tiffStripWriterPtr->numberPlanes; plane++)
+			tiffStripWriterPtr->planeBytesLoadedPtr[plane] = 0;
+			
+		errCode = MSetMarker (fileStreamPtr, 
+										fsFromStart, 
+										fileInfoPtr->numberHeaderBytes,
+										kErrorMessages);
+		
+		}	// end "if (errCode == noErr)"
+		
+	if (errCode != noErr)
+		{
+		CloseTIFFStripWriter (tiffStripWriterPtr, FALSE);
+		tiffStripWriterPtr = NULL;
+		
+		}	// end "if (errCode != noErr)"
+		
+	if (tiffStripWriterPtr != NULL && gTIFFOutputOverviewsFlag)
+		{
+		CreateTIFFOverviewWriter (tiffStripWriterPtr);
+		
+				// The overview strips are written after the image data as they
+				// become available so all of the writers share the offset for the 
+				// next strip of the full resolution writer.
+				
+		if (fileInfoPtr->tiffOverviewIndex == 0)
+			{
+			overviewWriterPtr = tiffStripWriterPtr->overviewWriterPtr;
+			while (overviewWriterPtr != NULL)
+				{
+				overviewWriterPtr->mainWriterPtr = tiffStripWriterPtr;
+				overviewWriterPtr = overviewWriterPtr->overviewWriterPtr;
+				
+				}	// end "while (overviewWriterPtr != NULL)"
+				
+			}	// end "if (fileInfoPtr->tiffOverviewIndex == 0)"
+		
+		}	// end "if (tiffStripWriterPtr != NULL && gTIFFOutputOverviewsFlag)"
+	
+	return (tiffStripWriterPtr);
+	
+}	// end "CreateTIFFStripWriter"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void EncodeTIFFStrip
+//
+//	Software purpose:	The purpose of this routine is to compress the strip in one
+//							slot of the TIFF strip writer. The data are changed to the byte
+//							order of the file before they are compressed.
+//							This routine may be called from more than one thread at a time
+//							so no memory is allocated and no messages are displayed here.
+//
+//	Parameters in:		Pointer to the TIFF strip writer.
+//							Slot to be compressed.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			RunTasksInParallel in SThreads.cpp
+
+void EncodeTIFFStrip (
+				void*									taskInfoPtr,
+				UInt32								task)
+
+{
+	FileInfoPtr							fileInfoPtr;
+	
+	HUCharPtr							rawStripPtr;
+	
+	TIFFStripWriterPtr				tiffStripWriterPtr;
+	
+	UInt32								numberBytes;
+	
+	
+	tiffStripWriterPtr = (TIFFStripWriterPtr)taskInfoPtr;
+	fileInfoPtr = tiffStripWriterPtr->fileInfoPtr;
+	
+	rawStripPtr = 
+			&tiffStripWriterPtr->rawStripBufferPtr[
+													(SInt64)task*tiffStripWriterPtr->stripBytes];
+	numberBytes = tiffStripWriterPtr->slotNumberBytesPtr[task];
+	
+	if (fileInfoPtr->swapBytesFlag && fileInfoPtr->numberBytes >= 2)
+		SwapBytes (fileInfoPtr->numberBytes,
+						rawStripPtr,
+						numberBytes/fileInfoPtr->numberBytes);
+	
+	tiffStripWriterPtr->slotErrCodePtr[task] = EncodeTIFFBlock (
+			fileInfoPtr,
+			rawStripPtr,
+			numberBytes,
+			&tiffStripWriterPtr->encodedStripBufferPtr[
+										(SInt64)task*tiffStripWriterPtr->encodedStripBytes],
+			tiffStripWriterPtr->encodedStripBytes,
+			tiffStripWriterPtr->numberRowBytes,
+			&tiffStripWriterPtr->rowBufferPtr[
+											(SInt64)task*tiffStripWriterPtr->numberRowBytes],
+			&tiffStripWriterPtr->slotEncodedBytesPtr[task]);
+	
+}	// end "EncodeTIFFStrip"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1992-2020 Purdue Research Foundation
 //
@@ -431,6 +1118,94 @@ SInt16 FindEndOfLineCode (
 }	// end "FindEndOfLineCode" 
 
 
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 FlushTIFFStripWriter
+//
+//	Software purpose:	The purpose of this routine is to compress the strips in the
+//							slots of the TIFF strip writer in parallel and then write them
+//							to the file in slot order. The offset and number of bytes for
+//							each strip are saved for the strip offsets and byte counts
+//							tags.
+//
+//	Parameters in:		Pointer to the TIFF strip writer.
+//
+//	Parameters out:	None
+//
+// Value Returned:	noErr if the strips were written. An error code if not.
+//
+// Called By:			CloseTIFFStripWriter in SSaveWrite.cpp
+//							WriteTIFFStripData in SSaveWrite.cpp
+
+SInt16 FlushTIFFStripWriter (
+				TIFFStripWriterPtr				tiffStripWriterPtr)
+
+{
+	UInt32								count,
+											slot,
+											stripIndex;
+	
+	SInt16								errCode = noErr;
+	
+	
+	if (tiffStripWriterPtr->numberSlotsUsed == 0)
+																					return (noErr);
+	
+	if (tiffStripWriterPtr->mainWriterPtr != NULL)
+		tiffStripWriterPtr->nextStripOffset = 
+										tiffStripWriterPtr->mainWriterPtr->nextStripOffset;
+																					
+	RunTasksInParallel (tiffStripWriterPtr->numberSlotsUsed, 
+								EncodeTIFFStrip, 
+								tiffStripWriterPtr);
+	
+	for (slot=0; slot<tiffStripWriterPtr->numberSlotsUsed; slot++)
+		{
+		errCode = tiffStripWriterPtr->slotErrCodePtr[slot];
+		if (errCode != noErr)
+			break;
+			
+		count = tiffStripWriterPtr->slotEncodedBytesPtr[slot];
+		
+				// The strip offsets are limited to 32 bits.
+				
+		if (tiffStripWriterPtr->nextStripOffset + count > UInt32_MAX)
+			{
+			errCode = -1;
+			break;
+			
+			}	// end "if (tiffStripWriterPtr->nextStripOffset + count > UInt32_MAX)"
+		
+		stripIndex = tiffStripWriterPtr->slotStripIndexPtr[slot];
+		tiffStripWriterPtr->stripOffsetsPtr[stripIndex] = 
+												(UInt32)tiffStripWriterPtr->nextStripOffset;
+		tiffStripWriterPtr->stripByteCountsPtr[stripIndex] = count;
+		
+		errCode = MWriteData (tiffStripWriterPtr->fileStreamPtr, 
+										&count, 
+										&tiffStripWriterPtr->encodedStripBufferPtr[
+									(SInt64)slot*tiffStripWriterPtr->encodedStripBytes], 
+										kErrorMessages);
+		if (errCode != noErr)
+			break;
+			
+		tiffStripWriterPtr->nextStripOffset += count;
+			
+		}	// end "for (slot=0; slot<...->numberSlotsUsed; slot++)"
+		
+	tiffStripWriterPtr->numberSlotsUsed = 0;
+	
+	if (tiffStripWriterPtr->mainWriterPtr != NULL)
+		tiffStripWriterPtr->mainWriterPtr->nextStripOffset = 
+													tiffStripWriterPtr->nextStripOffset;
+	
+	return (errCode);
+	
+}	// end "FlushTIFFStripWriter"
+
+
                    
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
@@ -808,7 +1583,10 @@ SInt16 GetNextLine (
 //	Function name:		void GetNumberStripsToUse
 //
 //	Software purpose:	The purpose of this routine is to determine the number of strips
-//							to use to write out the tiff/geotiff data. 
+//							to use to write out the tiff/geotiff data. Smaller strips are
+//							used for compressed files so that the strips can be compressed
+//							in parallel and the strips for all channels can be kept in
+//							memory until they are full.
 //
 //	Parameters in:		None
 //
@@ -816,8 +1594,8 @@ SInt16 GetNextLine (
 //
 // Value Returned:	None
 //
-// Called By:			
-//							
+// Called By:			CreateTIFFStripWriter in SSaveWrite.cpp
+//							WriteTIFFImageFile in SSaveWrite.cpp
 //
 //	Coded By:			Larry L. Biehl			Date: 05/21/2012
 //	Revised By:			Larry L. Biehl			Date: 07/16/2012
@@ -828,6 +1606,7 @@ UInt32 GetNumberStripsToUse (
 				UInt32								numberLines,
 				UInt32								numberChannels,
 				UInt32								numberBytes,
+				Boolean								compressedFlag,
 				UInt32*								numberStripsPtr,
 				UInt32*								numberStripsPerChannelPtr,
 				UInt32*								numberBytesPerStripPtr,
@@ -849,6 +1628,15 @@ UInt32 GetNumberStripsToUse (
 	totalNumberBytes = numberBytesPerChannel * numberChannels;
 	numberLinesPerStrip = numberLines;
 	
+	if (compressedFlag)
+		{
+		numberBytesLimitPerStrip = kTIFFCompressedStripBytes;
+		if (planarConfiguration == 2)
+			numberBytesLimitPerStrip = MIN (numberBytesLimitPerStrip,
+														kTIFFStripBufferBytes/numberChannels);
+		
+		}	// end "if (compressedFlag)"
+	
 	if (totalNumberBytes <= UInt32_MAX)
 		{
 		numberBytesPerStrip = (UInt32)totalNumberBytes;
@@ -1122,6 +1910,75 @@ Boolean GetThematicSupportFile (
 							
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		double GetTIFFOverviewSample
+//
+//	Software purpose:	The purpose of this routine is to get the value of a sample in
+//							a row of data for the image described by the input file
+//							information structure.
+//
+//	Parameters in:		File information structure pointer.
+//							Pointer to the row of data in the byte order of this computer.
+//							Index of the sample in the row.
+//
+//	Parameters out:	None
+//
+// Value Returned:	The value of the sample.
+//
+// Called By:			ReduceTIFFOverviewRows in SSaveWrite.cpp
+
+double GetTIFFOverviewSample (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							rowPtr,
+				UInt32								sampleIndex)
+
+{
+	double								value;
+	
+	
+	switch (fileInfoPtr->numberBytes)
+		{
+		case 1:
+			if (fileInfoPtr->signedDataFlag)
+				value = ((HSInt8Ptr)rowPtr)[sampleIndex];
+			else	// !fileInfoPtr->signedDataFlag
+				value = rowPtr[sampleIndex];
+			break;
+			
+		case 2:
+			if (fileInfoPtr->signedDataFlag)
+				value = ((HSInt16Ptr)rowPtr)[sampleIndex];
+			else	// !fileInfoPtr->signedDataFlag
+				value = ((HUInt16Ptr)rowPtr)[sampleIndex];
+			break;
+			
+		case 4:
+			if (fileInfoPtr->dataTypeCode == kRealType)
+				value = ((HFloatPtr)rowPtr)[sampleIndex];
+			else if (fileInfoPtr->signedDataFlag)
+				value = ((HSInt32Ptr)rowPtr)[sampleIndex];
+			else	// !fileInfoPtr->signedDataFlag
+				value = ((HUInt32Ptr)rowPtr)[sampleIndex];
+			break;
+			
+		case 8:
+			value = ((HDoublePtr)rowPtr)[sampleIndex];
+			break;
+			
+		default:
+			value = 0;
+			break;
+			
+		}	// end "switch (fileInfoPtr->numberBytes)"
+		
+	return (value);
+	
+}	// end "GetTIFFOverviewSample"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -4832,6 +5689,113 @@ void ReadTransformationGetFileSizes (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void ReduceTIFFOverviewRows
+//
+//	Software purpose:	The purpose of this routine is to reduce two rows of an image
+//							to one row of the overview that is one half the size of the
+//							image. Each output sample is computed from the 2 by 2 block of
+//							input samples. The average is used for continuous data and 
+//							the most common value is used for thematic data so that no
+//							new class values are created. The last column of an image with
+//							an odd number of columns is reduced by itself.
+//
+//	Parameters in:		File information structure pointer for the input rows.
+//							Pointers to the first and second input rows.
+//
+//	Parameters out:	Pointer to the output row.
+//
+// Value Returned:	None
+//
+// Called By:			AddTIFFOverviewRow in SSaveWrite.cpp
+
+void ReduceTIFFOverviewRows (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							row1Ptr,
+				HUCharPtr							row2Ptr,
+				HUCharPtr							outputRowPtr)
+
+{
+	double								values[4],
+											value;
+	
+	UInt32								column,
+											column2,
+											count,
+											index,
+											index2,
+											maxCount,
+											numberOutputColumns,
+											numberSamplesPerPixel,
+											sample;
+	
+	
+	numberSamplesPerPixel = 1;
+	if (fileInfoPtr->bandInterleave == kBIS)
+		numberSamplesPerPixel = fileInfoPtr->numberChannels;
+		
+	numberOutputColumns = (fileInfoPtr->numberColumns + 1)/2;
+	
+	for (column=0; column<numberOutputColumns; column++)
+		{
+		column2 = MIN (2*column+1, fileInfoPtr->numberColumns-1);
+		
+		for (sample=0; sample<numberSamplesPerPixel; sample++)
+			{
+			values[0] = GetTIFFOverviewSample (
+							fileInfoPtr, row1Ptr, 2*column*numberSamplesPerPixel + sample);
+			values[1] = GetTIFFOverviewSample (
+							fileInfoPtr, row1Ptr, column2*numberSamplesPerPixel + sample);
+			values[2] = GetTIFFOverviewSample (
+							fileInfoPtr, row2Ptr, 2*column*numberSamplesPerPixel + sample);
+			values[3] = GetTIFFOverviewSample (
+							fileInfoPtr, row2Ptr, column2*numberSamplesPerPixel + sample);
+			
+			if (fileInfoPtr->thematicType)
+				{
+						// Use the most common value. Ties go to the first one found.
+						
+				value = values[0];
+				maxCount = 0;
+				for (index=0; index<4; index++)
+					{
+					count = 0;
+					for (index2=0; index2<4; index2++)
+						{
+						if (values[index2] == values[index])
+							count++;
+							
+						}	// end "for (index2=0; index2<4; index2++)"
+						
+					if (count > maxCount)
+						{
+						maxCount = count;
+						value = values[index];
+						
+						}	// end "if (count > maxCount)"
+						
+					}	// end "for (index=0; index<4; index++)"
+				
+				}	// end "if (fileInfoPtr->thematicType)"
+				
+			else	// !fileInfoPtr->thematicType
+				value = (values[0] + values[1] + values[2] + values[3])/4;
+			
+			SetTIFFOverviewSample (fileInfoPtr,
+											outputRowPtr,
+											column*numberSamplesPerPixel + sample,
+											value);
+			
+			}	// end "for (sample=0; sample<numberSamplesPerPixel; sample++)"
+			
+		}	// end "for (column=0; column<numberOutputColumns; column++)"
+	
+}	// end "ReduceTIFFOverviewRows"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -5204,6 +6168,78 @@ Boolean SaveTextOutputAs (void)
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void SetTIFFOverviewSample
+//
+//	Software purpose:	The purpose of this routine is to set the value of a sample in
+//							a row of data for the image described by the input file
+//							information structure. Values for integer data are rounded to
+//							the nearest integer.
+//
+//	Parameters in:		File information structure pointer.
+//							Pointer to the row of data in the byte order of this computer.
+//							Index of the sample in the row.
+//							Value of the sample.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+//
+// Called By:			ReduceTIFFOverviewRows in SSaveWrite.cpp
+
+void SetTIFFOverviewSample (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							rowPtr,
+				UInt32								sampleIndex,
+				double								value)
+
+{
+	if (fileInfoPtr->dataTypeCode != kRealType)
+		{
+		if (value >= 0)
+			value += 0.5;
+		else	// value < 0
+			value -= 0.5;
+			
+		}	// end "if (fileInfoPtr->dataTypeCode != kRealType)"
+		
+	switch (fileInfoPtr->numberBytes)
+		{
+		case 1:
+			if (fileInfoPtr->signedDataFlag)
+				((HSInt8Ptr)rowPtr)[sampleIndex] = (SInt8)value;
+			else	// !fileInfoPtr->signedDataFlag
+				rowPtr[sampleIndex] = (UInt8)value;
+			break;
+			
+		case 2:
+			if (fileInfoPtr->signedDataFlag)
+				((HSInt16Ptr)rowPtr)[sampleIndex] = (SInt16)value;
+			else	// !fileInfoPtr->signedDataFlag
+				((HUInt16Ptr)rowPtr)[sampleIndex] = (UInt16)value;
+			break;
+			
+		case 4:
+			if (fileInfoPtr->dataTypeCode == kRealType)
+				((HFloatPtr)rowPtr)[sampleIndex] = (float)value;
+			else if (fileInfoPtr->signedDataFlag)
+				((HSInt32Ptr)rowPtr)[sampleIndex] = (SInt32)value;
+			else	// !fileInfoPtr->signedDataFlag
+				((HUInt32Ptr)rowPtr)[sampleIndex] = (UInt32)value;
+			break;
+			
+		case 8:
+			((HDoublePtr)rowPtr)[sampleIndex] = value;
+			break;
+			
+		}	// end "switch (fileInfoPtr->numberBytes)"
+	
+}	// end "SetTIFFOverviewSample"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -8559,16 +9595,35 @@ Boolean WriteTIFFImageFile (
 											sampleFormatCode,
 											tempShortInt;
 											
-	UInt16								numberEntries,
+	UInt16								compressionCode,
+											numberEntries,
 											paletteOffset;
 											
-	Boolean								saved_gSwapBytesFlag;
+	Boolean								compressedFlag,
+											saved_gSwapBytesFlag;
 		                                 
 		
 	if (fileStreamPtr != NULL)
 		{
 		saved_gSwapBytesFlag = gSwapBytesFlag;
 		
+				// The image data for compressed files are written by the TIFF strip
+				// writer. Only files created by reformatting may be compressed.
+				
+		compressedFlag = (tiffSourceCode == kFromReformat &&
+									fileInfoPtr->dataCompressionCode != kNoCompression);
+									
+		compressionCode = 1;
+		if (compressedFlag)
+			{
+			if (fileInfoPtr->dataCompressionCode == kLZWCompression)
+				compressionCode = 5;
+				
+			else	// fileInfoPtr->dataCompressionCode == kDeflateCompression
+				compressionCode = 8;
+			
+			}	// end "if (compressedFlag)"
+		
 		if (tiffSourceCode == kFromImageWindow)
 			{
 			numberLines = areaRectanglePtr->bottom - areaRectanglePtr->top;
@@ -8677,6 +9732,7 @@ Boolean WriteTIFFImageFile (
 															numberLines,
 															numberTIFFChannels,
 															numberBytes,
+															compressedFlag,
 															&numberStrips,
 															&numberStripsPerChannel,
 															&bytesPerStrip,
@@ -8692,6 +9748,8 @@ Boolean WriteTIFFImageFile (
 		if (photoInterpret == 3)
 			numberEntries += 1;
 		if (planarConfiguration == 1 && numberTIFFChannels > 3)
+			numberEntries += 1;
+		if (compressedFlag)
 			numberEntries += 1;
 			
 				// Get entries for Geo information.
@@ -8760,7 +9818,10 @@ Boolean WriteTIFFImageFile (
 		else	// numberStrips > 1
 			{
 		*/
-		if (numberStrips > 1)
+				// The strip offsets and byte counts for compressed files are written
+				// after the image data.
+				
+		if (numberStrips > 1 && !compressedFlag)
 			imageDataOffset += 2 * 4 * numberStrips;
 				
 				// for "282: XResolution & 283: YResolution"
@@ -8902,7 +9963,7 @@ Boolean WriteTIFFImageFile (
 							259,
 							kTIFFShort,
 							1,
-							1);				 
+							compressionCode);				 
 		BlockMoveData (&imageFileDirectory, &bufferPtr[index], 12);
 		index += 12;
 		
@@ -8929,7 +9990,8 @@ Boolean WriteTIFFImageFile (
 		BlockMoveData (textString, &bufferPtr[otherValueOffset], textStringBufferLength);
 		otherValueOffset += textStringBufferLength;
 		
-				// 273: StripOffsets.															
+				// 273: StripOffsets.
+				// Note that the position of this entry is kTIFFStripOffsetsEntryOffset.
 		
 		if (numberStrips == 1)
 			{
@@ -8961,6 +10023,15 @@ Boolean WriteTIFFImageFile (
 				
 			}	// end "if (numberStrips == 1)"
 			
+		else if (compressedFlag)
+			{
+					// The offsets will be set when the strips have been written.
+					
+			imageFileDirectory.count = numberStrips;
+			imageFileDirectory.value = 0;
+			
+			}	// end "else if (compressedFlag)"
+			
 		else	// numberStrips > 1
 			{
 			imageFileDirectory.count = numberStrips;
@@ -9019,7 +10090,9 @@ Boolean WriteTIFFImageFile (
 		BlockMoveData (&imageFileDirectory, &bufferPtr[index], 12);
 		index += 12;
 		
-				// 279: StripByteCounts.																
+				// 279: StripByteCounts.
+				// Note that the position of this entry is 
+				// kTIFFStripByteCountsEntryOffset.
 		
 		if (numberStrips == 1)
 			{	
@@ -9052,6 +10125,15 @@ Boolean WriteTIFFImageFile (
 				
 			}	// end "if (numberStrips == 1)"
 			
+		else if (compressedFlag)
+			{
+					// The byte counts will be set when the strips have been written.
+					
+			imageFileDirectory.count = numberStrips;
+			imageFileDirectory.value = 0;
+			
+			}	// end "else if (compressedFlag)"
+			
 		else	// numberStrips > 1
 			{
 			imageFileDirectory.count = numberStrips;
@@ -9134,6 +10216,20 @@ Boolean WriteTIFFImageFile (
 		BlockMoveData (&imageFileDirectory, &bufferPtr[index], 12);
 		index += 12;
 		
+				// 317: Predictor.
+		
+		if (compressedFlag)
+			{	
+			LoadTiffEntry (&imageFileDirectory,
+								317,
+								kTIFFShort,
+								1,
+								fileInfoPtr->predictorCode);	
+			BlockMoveData (&imageFileDirectory, &bufferPtr[index], 12);
+			index += 12;
+			
+			}	// end "if (compressedFlag)"
+		
 				// 320: ColorMap.	
 		
 		if (photoInterpret == 3)
@@ -9329,7 +10425,550 @@ Boolean WriteTIFFImageFile (
 }	// end "WriteTIFFImageFile"
 
 
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 WriteTIFFOverviewDirectories
+//
+//	Software purpose:	The purpose of this routine is to write the strip offsets and
+//							byte counts and the image file directory for each of the
+//							reduced resolution images (overviews) after the image data.
+//							The image file directories are copies of the one for the full
+//							resolution image with the new subfile type, size and strip
+//							entries. The GeoTIFF entries are not included since they 
+//							describe the full resolution image. The directories are
+//							chained to the full resolution one.
+//
+//	Parameters in:		Pointer to the TIFF strip writer for the full resolution
+//								image.
+//
+//	Parameters out:	None
+//
+// Value Returned:	noErr if the directories were written. An error code if not.
+//
+// Called By:			CloseTIFFStripWriter in SSaveWrite.cpp
+
+SInt16 WriteTIFFOverviewDirectories (
+				TIFFStripWriterPtr				tiffStripWriterPtr)
+
+{
+	TIFFImageFileDirectory			imageFileDirectory;
+	
+	SInt64								directoryOffset;
+	
+	CMFileStream*						fileStreamPtr;
+	FileInfoPtr							fileInfoPtr;
+	UCharPtr								directoryBufferPtr,
+											entriesBufferPtr;
+	
+	TIFFStripWriterPtr				overviewWriterPtr;
+	
+	UInt32								count,
+											directoryBytes,
+											entry,
+											index,
+											nextDirectoryOffset,
+											numberOverviews,
+											stripByteCountsValue[kMaxNumberTIFFOverviews],
+											stripOffsetsValue[kMaxNumberTIFFOverviews];
+	
+	SInt16								errCode = noErr;
+	
+	UInt16								numberEntries,
+											numberEntriesKept,
+											overview,
+											shortValue,
+											tag;
+	
+	Boolean								saved_gSwapBytesFlag;
+	
+	
+	fileStreamPtr = tiffStripWriterPtr->fileStreamPtr;
+	
+	saved_gSwapBytesFlag = gSwapBytesFlag;
+	gSwapBytesFlag = tiffStripWriterPtr->fileInfoPtr->swapBytesFlag;
+	
+			// Write the strip offsets and byte counts for each overview.
+	
+	numberOverviews = 0;
+	overviewWriterPtr = tiffStripWriterPtr->overviewWriterPtr;
+	while (overviewWriterPtr != NULL && errCode == noErr)
+		{
+		errCode = WriteTIFFStripTables (overviewWriterPtr,
+													&stripOffsetsValue[numberOverviews],
+													&stripByteCountsValue[numberOverviews]);
+		numberOverviews++;
+		overviewWriterPtr = overviewWriterPtr->overviewWriterPtr;
+		
+		}	// end "while (overviewWriterPtr != NULL && errCode == noErr)"
+		
+			// Get the entries of the image file directory for the full resolution
+			// image.
+			
+	entriesBufferPtr = NULL;
+	directoryBufferPtr = NULL;
+	numberEntries = 0;
+	
+	if (errCode == noErr)
+		errCode = MSetMarker (fileStreamPtr, fsFromStart, 8, kErrorMessages);
+		
+	if (errCode == noErr)
+		{
+		count = 2;
+		errCode = MReadData (fileStreamPtr, &count, &numberEntries, kErrorMessages);
+		numberEntries = GetShortIntValue ((char*)&numberEntries);
+		
+		}	// end "if (errCode == noErr)"
+		
+	if (errCode == noErr)
+		{
+		entriesBufferPtr = (UCharPtr)MNewPointer (12 * (SInt64)numberEntries);
+		if (entriesBufferPtr == NULL)
+			errCode = -1;
+			
+		}	// end "if (errCode == noErr)"
+		
+	if (errCode == noErr)
+		{
+		count = 12 * (UInt32)numberEntries;
+		errCode = MReadData (fileStreamPtr, &count, entriesBufferPtr, kErrorMessages);
+		
+		}	// end "if (errCode == noErr)"
+		
+			// Count the entries that are kept for the overviews. The GeoTIFF and
+			// model transformation entries are left out.
+			
+	numberEntriesKept = 0;
+	if (errCode == noErr)
+		{
+		for (entry=0; entry<numberEntries; entry++)
+			{
+			tag = GetShortIntValue ((char*)&entriesBufferPtr[12*entry]);
+			if (tag != 33550 && tag != 33922 && tag != 34264 && 
+												tag != 34735 && tag != 34736 && tag != 34737)
+				numberEntriesKept++;
+			
+			}	// end "for (entry=0; entry<numberEntries; entry++)"
+		
+		}	// end "if (errCode == noErr)"
+	
+			// Directories need to start on a word boundary.
+	
+	directoryBytes = 2 + 12 * (UInt32)numberEntriesKept + 4;
+	directoryOffset = tiffStripWriterPtr->nextStripOffset;
+	if (directoryOffset % 2 == 1)
+		directoryOffset++;
+		
+	if (errCode == noErr &&
+			directoryOffset + (SInt64)numberOverviews * directoryBytes > UInt32_MAX)
+		errCode = -1;
+		
+	if (errCode == noErr)
+		{
+		directoryBufferPtr = (UCharPtr)MNewPointerClear (
+													numberOverviews * directoryBytes + 1);
+		if (directoryBufferPtr == NULL)
+			errCode = -1;
+			
+		}	// end "if (errCode == noErr)"
+		
+	if (errCode == noErr)
+		{
+				// Load the image file directory for each overview after the pad
+				// byte if it is needed.
+				
+		index = (UInt32)(directoryOffset - tiffStripWriterPtr->nextStripOffset);
+		overview = 0;
+		overviewWriterPtr = tiffStripWriterPtr->overviewWriterPtr;
+		while (overviewWriterPtr != NULL)
+			{
+			fileInfoPtr = overviewWriterPtr->fileInfoPtr;
+			
+			shortValue = GetShortIntValue ((char*)&numberEntriesKept);
+			BlockMoveData ((char*)&shortValue, &directoryBufferPtr[index], 2);
+			index += 2;
+			
+			for (entry=0; entry<numberEntries; entry++)
+				{
+				BlockMoveData (&entriesBufferPtr[12*entry], &imageFileDirectory, 12);
+				tag = GetShortIntValue ((char*)&imageFileDirectory.tag);
+				
+				switch (tag)
+					{
+					case 254:	// Sub File Type: reduced resolution image.
+						LoadTiffEntry (&imageFileDirectory, 254, kTIFFLong, 1, 1);
+						break;
+						
+					case 256:	// Image Width.
+						LoadTiffEntry (&imageFileDirectory,
+											256,
+											kTIFFLong,
+											1,
+											fileInfoPtr->numberColumns);
+						break;
+						
+					case 257:	// Image Length.
+						LoadTiffEntry (&imageFileDirectory,
+											257,
+											kTIFFLong,
+											1,
+											fileInfoPtr->numberLines);
+						break;
+						
+					case 273:	// Strip Offsets.
+						LoadTiffEntry (&imageFileDirectory,
+											273,
+											kTIFFLong,
+											overviewWriterPtr->numberStrips,
+											stripOffsetsValue[overview]);
+						break;
+						
+					case 278:	// Rows Per Strip.
+						LoadTiffEntry (&imageFileDirectory,
+											278,
+											kTIFFLong,
+											1,
+											overviewWriterPtr->stripBytes/
+															overviewWriterPtr->numberRowBytes);
+						break;
+						
+					case 279:	// Strip Byte Counts.
+						LoadTiffEntry (&imageFileDirectory,
+											279,
+											kTIFFLong,
+											overviewWriterPtr->numberStrips,
+											stripByteCountsValue[overview]);
+						break;
+						
+					case 33550:
+					case 33922:
+					case 34264:
+					case 34735:
+					case 34736:
+					case 34737:
+								// GeoTIFF entries are not used for the overviews.
+						continue;
+						
+					}	// end "switch (tag)"
+					
+				BlockMoveData (&imageFileDirectory, &directoryBufferPtr[index], 12);
+				index += 12;
+				
+				}	// end "for (entry=0; entry<numberEntries; entry++)"
+				
+					// Offset to the next image file directory.
+					
+			nextDirectoryOffset = 0;
+			if (overviewWriterPtr->overviewWriterPtr != NULL)
+				nextDirectoryOffset = (UInt32)directoryOffset + 
+															(overview+1) * directoryBytes;
+			nextDirectoryOffset = (UInt32)GetLongIntValue ((char*)&nextDirectoryOffset);
+			BlockMoveData ((char*)&nextDirectoryOffset, &directoryBufferPtr[index], 4);
+			index += 4;
+				
+			overview++;
+			overviewWriterPtr = overviewWriterPtr->overviewWriterPtr;
+			
+			}	// end "while (overviewWriterPtr != NULL)"
+			
+		errCode = MSetMarker (fileStreamPtr, 
+										fsFromStart, 
+										tiffStripWriterPtr->nextStripOffset,
+										kErrorMessages);
+		
+		if (errCode == noErr)
+			{
+			count = index;
+			errCode = MWriteData (fileStreamPtr, 
+											&count, 
+											directoryBufferPtr, 
+											kErrorMessages);
+			
+			}	// end "if (errCode == noErr)"
+			
+		if (errCode == noErr)
+			{
+			tiffStripWriterPtr->nextStripOffset += index;
+			
+					// Now chain the first overview to the full resolution image file
+					// directory.
+					
+			errCode = MSetMarker (fileStreamPtr, 
+											fsFromStart, 
+											8 + 2 + 12 * (SInt64)numberEntries,
+											kErrorMessages);
+			
+			}	// end "if (errCode == noErr)"
+			
+		if (errCode == noErr)
+			{
+			nextDirectoryOffset = (UInt32)directoryOffset;
+			nextDirectoryOffset = (UInt32)GetLongIntValue ((char*)&nextDirectoryOffset);
+			count = 4;
+			errCode = MWriteData (fileStreamPtr, 
+											&count, 
+											&nextDirectoryOffset, 
+											kErrorMessages);
+			
+			}	// end "if (errCode == noErr)"
+		
+		}	// end "if (errCode == noErr)"
+		
+	CheckAndDisposePtr ((Ptr)entriesBufferPtr);
+	CheckAndDisposePtr ((Ptr)directoryBufferPtr);
+	
+	gSwapBytesFlag = saved_gSwapBytesFlag;
+	
+	return (errCode);
+	
+}	// end "WriteTIFFOverviewDirectories"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 WriteTIFFStripData
+//
+//	Software purpose:	The purpose of this routine is to load data for a compressed
+//							TIFF file into the TIFF strip writer. The data for each plane
+//							are to be loaded in order. Data that go beyond the end of a 
+//							plane continue with the next plane. Strips that are full are 
+//							compressed and written when all of the slots of the writer 
+//							have been used. The rows of each full strip are also given to
+//							the writer for the next overview if there is one.
+//
+//	Parameters in:		Pointer to the TIFF strip writer.
+//							Offset of the data within the uncompressed image data. -1 
+//								indicates that the data follow those that were loaded last.
+//							Pointer to the data in the byte order of this computer.
+//							Number of bytes of data.
+//
+//	Parameters out:	None
+//
+// Value Returned:	noErr if the data were loaded. An error code if not.
+//
+// Called By:			AddTIFFOverviewRow in SSaveWrite.cpp
+//							WriteOutputDataToFile in SReformatUtilities.cpp
+
+SInt16 WriteTIFFStripData (
+				TIFFStripWriterPtr				tiffStripWriterPtr,
+				SInt64								imageDataOffset,
+				HUCharPtr							dataPtr,
+				UInt32								numberBytes)
+
+{
+	SInt64								planeOffset;
+	
+	UInt32								count,
+											plane,
+											row,
+											slot,
+											stripOffset;
+	
+	SInt16								errCode = noErr;
+	
+	
+	if (imageDataOffset < 0)
+		imageDataOffset = tiffStripWriterPtr->streamOffset;
+	
+	while (numberBytes > 0)
+		{
+		plane = (UInt32)(imageDataOffset / tiffStripWriterPtr->numberPlaneBytes);
+		planeOffset = imageDataOffset - plane * tiffStripWriterPtr->numberPlaneBytes;
+		
+		if (plane >= tiffStripWriterPtr->numberPlanes ||
+						planeOffset != tiffStripWriterPtr->planeBytesLoadedPtr[plane])
+																						return (-1);
+		
+		stripOffset = (UInt32)(planeOffset % tiffStripWriterPtr->stripBytes);
+		count = tiffStripWriterPtr->stripBytes - stripOffset;
+		count = (UInt32)MIN (count, tiffStripWriterPtr->numberPlaneBytes - planeOffset);
+		count = MIN (count, numberBytes);
+		
+		BlockMoveData (dataPtr,
+							&tiffStripWriterPtr->planeBufferPtr[
+								(SInt64)plane*tiffStripWriterPtr->stripBytes + stripOffset],
+							count);
+							
+		tiffStripWriterPtr->planeBytesLoadedPtr[plane] += count;
+		dataPtr += count;
+		numberBytes -= count;
+		imageDataOffset += count;
+		
+				// Move the strip to a slot if it is full or is the last one for the
+				// plane.
+				
+		if (stripOffset + count == tiffStripWriterPtr->stripBytes ||
+				tiffStripWriterPtr->planeBytesLoadedPtr[plane] == 
+														tiffStripWriterPtr->numberPlaneBytes)
+			{
+			slot = tiffStripWriterPtr->numberSlotsUsed;
+			
+			BlockMoveData (&tiffStripWriterPtr->planeBufferPtr[
+											(SInt64)plane*tiffStripWriterPtr->stripBytes],
+								&tiffStripWriterPtr->rawStripBufferPtr[
+											(SInt64)slot*tiffStripWriterPtr->stripBytes],
+								stripOffset + count);
+								
+			tiffStripWriterPtr->slotStripIndexPtr[slot] = 
+					plane * tiffStripWriterPtr->numberStripsPerPlane +
+							(UInt32)(planeOffset / tiffStripWriterPtr->stripBytes);
+			tiffStripWriterPtr->slotNumberBytesPtr[slot] = stripOffset + count;
+			tiffStripWriterPtr->numberSlotsUsed++;
+			
+			if (tiffStripWriterPtr->overviewWriterPtr != NULL)
+				{
+				for (row=0; 
+						row<(stripOffset+count)/tiffStripWriterPtr->numberRowBytes; 
+							row++)
+					{
+					errCode = AddTIFFOverviewRow (
+									tiffStripWriterPtr,
+									plane,
+									&tiffStripWriterPtr->planeBufferPtr[
+											(SInt64)plane*tiffStripWriterPtr->stripBytes +
+												(SInt64)row*tiffStripWriterPtr->numberRowBytes]);
+					if (errCode != noErr)
+						break;
+						
+					}	// end "for (row=0; row<...; row++)"
+					
+				if (errCode != noErr)
+					break;
+				
+				}	// end "if (tiffStripWriterPtr->overviewWriterPtr != NULL)"
+			
+			if (tiffStripWriterPtr->numberSlotsUsed == tiffStripWriterPtr->numberSlots)
+				{
+				errCode = FlushTIFFStripWriter (tiffStripWriterPtr);
+				if (errCode != noErr)
+					break;
+				
+				}	// end "if (...->numberSlotsUsed == ...->numberSlots)"
+			
+			}	// end "if (stripOffset + count == ...->stripBytes || ..."
+		
+		}	// end "while (numberBytes > 0)"
+		
+	tiffStripWriterPtr->streamOffset = imageDataOffset;
+		
+	return (errCode);
+	
+}	// end "WriteTIFFStripData"
+
+
                    
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 WriteTIFFStripTables
+//
+//	Software purpose:	The purpose of this routine is to write the strip offsets and
+//							byte counts for the TIFF strip writer after the data that have
+//							been written to the file. Nothing is written if there is only
+//							one strip since the values then fit in the image file 
+//							directory entries. Note that the tables are left in the byte
+//							order of the file.
+//
+//	Parameters in:		Pointer to the TIFF strip writer.
+//
+//	Parameters out:	Value for the StripOffsets entry.
+//							Value for the StripByteCounts entry.
+//
+// Value Returned:	noErr if the tables were written. An error code if not.
+//
+// Called By:			CloseTIFFStripWriter in SSaveWrite.cpp
+//							WriteTIFFOverviewDirectories in SSaveWrite.cpp
+
+SInt16 WriteTIFFStripTables (
+				TIFFStripWriterPtr				tiffStripWriterPtr,
+				UInt32*								stripOffsetsValuePtr,
+				UInt32*								stripByteCountsValuePtr)
+
+{
+	SInt64								stripTablesOffset;
+	
+	CMFileStream*						fileStreamPtr;
+	
+	UInt32								count;
+	
+	SInt16								errCode = noErr;
+	
+	
+	fileStreamPtr = tiffStripWriterPtr->fileStreamPtr;
+	
+	if (tiffStripWriterPtr->mainWriterPtr != NULL)
+		tiffStripWriterPtr->nextStripOffset = 
+										tiffStripWriterPtr->mainWriterPtr->nextStripOffset;
+	
+	*stripOffsetsValuePtr = tiffStripWriterPtr->stripOffsetsPtr[0];
+	*stripByteCountsValuePtr = tiffStripWriterPtr->stripByteCountsPtr[0];
+	
+	if (tiffStripWriterPtr->numberStrips > 1)
+		{
+		stripTablesOffset = tiffStripWriterPtr->nextStripOffset;
+		if (stripTablesOffset + 8 * (SInt64)tiffStripWriterPtr->numberStrips >
+																						UInt32_MAX)
+			errCode = -1;
+			
+		if (errCode == noErr)
+			errCode = MSetMarker (fileStreamPtr, 
+											fsFromStart, 
+											stripTablesOffset,
+											kErrorMessages);
+			
+		if (errCode == noErr && tiffStripWriterPtr->fileInfoPtr->swapBytesFlag)
+			{
+			SwapBytes (4, 
+							(HUInt8Ptr)tiffStripWriterPtr->stripOffsetsPtr,
+							tiffStripWriterPtr->numberStrips);
+			SwapBytes (4, 
+							(HUInt8Ptr)tiffStripWriterPtr->stripByteCountsPtr,
+							tiffStripWriterPtr->numberStrips);
+			
+			}	// end "if (errCode == noErr && ...->swapBytesFlag)"
+			
+		if (errCode == noErr)
+			{
+			count = 4 * tiffStripWriterPtr->numberStrips;
+			errCode = MWriteData (fileStreamPtr, 
+											&count, 
+											tiffStripWriterPtr->stripOffsetsPtr, 
+											kErrorMessages);
+			
+			}	// end "if (errCode == noErr)"
+			
+		if (errCode == noErr)
+			{
+			count = 4 * tiffStripWriterPtr->numberStrips;
+			errCode = MWriteData (fileStreamPtr, 
+											&count, 
+											tiffStripWriterPtr->stripByteCountsPtr, 
+											kErrorMessages);
+			
+			}	// end "if (errCode == noErr)"
+			
+		*stripOffsetsValuePtr = (UInt32)stripTablesOffset;
+		*stripByteCountsValuePtr = 
+					(UInt32)stripTablesOffset + 4 * tiffStripWriterPtr->numberStrips;
+		
+		if (errCode == noErr)
+			tiffStripWriterPtr->nextStripOffset += 8 * tiffStripWriterPtr->numberStrips;
+		
+		}	// end "if (tiffStripWriterPtr->numberStrips > 1)"
+	
+	if (tiffStripWriterPtr->mainWriterPtr != NULL)
+		tiffStripWriterPtr->mainWriterPtr->nextStripOffset = 
+													tiffStripWriterPtr->nextStripOffset;
+	
+	return (errCode);
+	
+}	// end "WriteTIFFStripTables"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
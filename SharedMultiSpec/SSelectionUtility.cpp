@@ -4340,6 +4340,12 @@ void GetSelectionBoundary (
 
 		areaDescriptionPtr->pointType = kPolygonType;
 		areaDescriptionPtr->polygonFieldFlag = TRUE;
+		
+				// The selection points are not kept locked so they are not made 
+				// available for getting the columns within the polygon.
+				
+		areaDescriptionPtr->polygonPointsPtr = NULL;
+		areaDescriptionPtr->numberPolygonPoints = 0;
 
 		selectionPointsPtr = (HPFieldPointsPtr)GetHandleStatusAndPointer (
 														 selectionInfoPtr->polygonCoordinatesHandle,
@@ -4373,6 +4379,8 @@ void GetSelectionBoundary (
 		areaDescriptionPtr->pointType = kRectangleType;
 		areaDescriptionPtr->polygonFieldFlag = FALSE;
 		areaDescriptionPtr->rgnHandle = NULL;
+		areaDescriptionPtr->polygonPointsPtr = NULL;
+		areaDescriptionPtr->numberPolygonPoints = 0;
 
 		}	// end "else the field is not polygonal type" 
 
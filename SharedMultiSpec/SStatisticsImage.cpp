@@ -553,6 +553,11 @@ Boolean CreateStatisticsImages (void)
 									
 								statCovStart =
 										fieldNumber * gProjectInfoPtr->numberCovarianceEntries;
+								
+										// Make certain that the field statistics have been
+										// loaded from the project file.
+										
+								LoadBinaryFieldStatistics (fieldNumber);
                       
 								LoadStatImageInformationStructure (
 										tempCovarianceStatisticsPtr,
@@ -3795,7 +3795,34 @@ Boolean ListCPUTimeInformation (
 					(char*)gTextString, 
 					0, 
 					gOutputForce1Code, 
-					localContinueFlag);	
+					localContinueFlag);
+	
+			// List the times used to read and decompress the chunks of compressed
+			// hdf5 data sets if any were read.
+	
+	if (gNumberHDF5ChunksRead > 0)
+		{
+		sprintf ((char*)gTextString,
+					"  %u hdf5 data chunks: %.2f CPU seconds reading, %.2f CPU seconds "
+					"decompressing and %.2f CPU seconds in hdf5 library reads.%s",
+					(unsigned int)gNumberHDF5ChunksRead,
+					gHDF5ChunkReadSeconds,
+					gHDF5ChunkDecompressSeconds,
+					gHDF5LibraryReadSeconds,
+					gEndOfLine);
+		
+		continueFlag = OutputString (resultsFileStreamPtr, 
+												(char*)gTextString, 
+												0, 
+												gOutputForce1Code, 
+												continueFlag);
+		
+		gNumberHDF5ChunksRead = 0;
+		gHDF5ChunkReadSeconds = 0.;
+		gHDF5ChunkDecompressSeconds = 0.;
+		gHDF5LibraryReadSeconds = 0.;
+		
+		}	// end "if (gNumberHDF5ChunksRead > 0)"
 	/*					
 			// Add a carriage return.
 			
@@ -25,15 +25,32 @@
 //	System:					Linux, Macintosh, and Windows Operating Systems
 //
 //	Brief description:	The routines in this file handle the creation and use of
-//								threads for reading data in the Mac version. It was never 
+//								threads for reading data. The Mac version was never 
 //								implemented. More work is needed for this. And what is here
-//								now is very out of date.
+//								now is very out of date. The wx versions use a read-ahead
+//								thread which reads the next lines of data into a ring of
+//								buffers while the current line is being processed. 
+//								Independent tasks such as decompressing the blocks in a 
+//								block row of a TIFF file can also be shared among threads.
+//								Lines of results can be written to a file by an output
+//								writer thread while the next lines are being processed.
 //
 //------------------------------------------------------------------------------------
 
 #include "SMultiSpec.h"
 
 #if defined multispec_wx
+	#include "SFileStream_class.h"
+	
+	#include <atomic>
+	#include <condition_variable>
+	#include <mutex>
+	#include <new>
+	#include <system_error>
+	#include <thread>
+	
+	#include <errno.h>
+	#include <unistd.h>
 #endif
 
 #if defined multispec_win
@@ -98,6 +115,164 @@ pascal void	WakeUpThread (
 
 
 
+#if defined multispec_wx
+		// Structure used for the read-ahead pipeline. The IO thread reads lines
+		// into the next free slot in the ring of buffers; GetLineFileIOThread
+		// copies the lines out in order. numberSlotsFilled and numberSlotsUsed
+		// are running counts; the slot for a count is the count modulo depth.
+		
+struct FileIOPrefetch
+	{
+	std::condition_variable			slotFilledCondition;
+	std::condition_variable			slotFreedCondition;
+	std::mutex							mutex;
+	std::thread							ioThread;
+	
+	FileInfoPtr							fileInfoPtr;
+	FileIOInstructionsPtr			fileIOInstructionsPtr;
+	HUCharPtr							bufferPtr;
+	
+	UInt32								bufferBytes;
+	UInt32								columnEnd;
+	UInt32								columnStart;
+	UInt32								count;
+	UInt32								depth;
+	UInt32								lineEnd;
+	UInt32								lineInterval;
+	UInt32								lineStart;
+	UInt32								nextLineToRead;
+	UInt32								numberSlotsFilled;
+	UInt32								numberSlotsUsed;
+	
+	int									fileDescriptor;
+	
+	SInt16								channelNumber;
+	SInt16								slotErrCode[kMaxPrefetchDepth];
+	
+	Boolean								ioThreadDoneFlag;
+	Boolean								runningFlag;
+	Boolean								stopFlag;
+	
+	};
+	
+		// Structure shared by the threads carrying out a set of independent tasks.
+		// Each thread takes the next task index that has not been started.
+		
+typedef struct ParallelTasks
+	{
+	std::atomic<UInt32>				nextTask;
+	
+	void									(*taskRoutine) (void*, UInt32);
+	void*									taskInfoPtr;
+	
+	UInt32								numberTasks;
+	
+	} ParallelTasks, *ParallelTasksPtr;
+	
+		// Structure used for the double buffered output writer. Lines are copied
+		// into the buffer being loaded while the other buffer is written to the 
+		// file on the writer thread. errCode is the error from the last write
+		// done on the writer thread; it is only checked, and any error message
+		// displayed, after the thread is joined.
+		
+struct OutputWriter
+	{
+	std::thread							writeThread;
+	
+	CMFileStream*						fileStreamPtr;
+	HUCharPtr							bufferPtrs[2];
+	HUCharPtr							writeBufferPtr;
+	
+	UInt32								bufferBytes;
+	UInt32								bufferIndex;
+	UInt32								numberBytes;
+	UInt32								writeNumberBytes;
+	
+	SInt16								errCode;
+	
+	Boolean								writeThreadRunningFlag;
+	
+	};
+
+
+		// Routine prototypes.
+		
+void 		FileIOPrefetchThread (
+				FileIOPrefetchPtr					prefetchPtr);
+
+SInt16 	FlushOutputWriterBuffer (
+				OutputWriterPtr					outputWriterPtr);
+
+void 		OutputWriterThread (
+				OutputWriterPtr					outputWriterPtr);
+
+void 		ParallelTasksThread (
+				ParallelTasksPtr					parallelTasksPtr);
+
+SInt16 	StartFileIOPrefetch (
+				FileIOPrefetchPtr					prefetchPtr,
+				UInt32								lineNumber, 
+				SInt16								channelNumber, 
+				UInt32								columnStart, 
+				UInt32								columnEnd,
+				UInt32								count);
+
+void 		StopFileIOPrefetch (
+				FileIOPrefetchPtr					prefetchPtr);
+
+SInt16 	WaitForOutputWriterThread (
+				OutputWriterPtr					outputWriterPtr);
+#endif	// defined multispec_wx
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 CloseOutputWriter
+//
+//	Software purpose:	The purpose of this routine is to write any lines left in the
+//							output writer buffer to the file, wait for the writer thread 
+//							to finish and then release the output writer.
+//
+//	Parameters in:		Pointer to the output writer. It may be NULL.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	Error code for the writes to the file.
+//
+// Called By:			ClassifyPerPointArea in SClassify.cpp
+
+SInt16 CloseOutputWriter (
+				OutputWriterPtr					outputWriterPtr)
+
+{ 
+	SInt16								errCode = noErr;
+	
+	
+	#if defined multispec_wx
+		if (outputWriterPtr != NULL)
+			{
+			errCode = FlushOutputWriterBuffer (outputWriterPtr);
+			
+			if (errCode == noErr)
+				errCode = WaitForOutputWriterThread (outputWriterPtr);
+			
+			else	// errCode != noErr
+				WaitForOutputWriterThread (outputWriterPtr);
+			
+			CheckAndDisposePtr ((Ptr)outputWriterPtr->bufferPtrs[0]);
+			delete outputWriterPtr;
+			
+			}	// end "if (outputWriterPtr != NULL)"
+	#endif	// defined multispec_wx
+	
+	return (errCode); 
+	
+}	// end "CloseOutputWriter"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -142,6 +317,71 @@ OSErr CreateFileIOThreadPool (void)
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		OutputWriterPtr CreateOutputWriter
+//
+//	Software purpose:	The purpose of this routine is to create a double buffered
+//							writer for the input file. The lines given to 
+//							WriteToOutputWriter are collected into large buffers which
+//							are written to the file on a separate thread while the next
+//							lines are being processed. Only the wx versions use the 
+//							output writer; NULL is returned for the other versions and
+//							when memory is not available. The caller should then write
+//							the lines directly to the file.
+//
+//	Parameters in:		Pointer to the file stream to be written to.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	Pointer to the output writer or NULL.
+//
+// Called By:			ClassifyPerPointArea in SClassify.cpp
+
+OutputWriterPtr CreateOutputWriter (
+				CMFileStream*						fileStreamPtr)
+
+{ 
+	OutputWriterPtr					outputWriterPtr = NULL;
+	
+	
+	#if defined multispec_wx
+		if (fileStreamPtr == NULL)
+																						return (NULL);
+		
+		outputWriterPtr = new (std::nothrow) OutputWriter;
+		if (outputWriterPtr == NULL)
+																						return (NULL);
+																						
+		outputWriterPtr->bufferPtrs[0] = 
+						(HUCharPtr)MNewPointer (2 * (SInt64)kOutputWriterBufferBytes);
+		if (outputWriterPtr->bufferPtrs[0] == NULL)
+			{
+			delete outputWriterPtr;
+																						return (NULL);
+			
+			}	// end "if (outputWriterPtr->bufferPtrs[0] == NULL)"
+		
+		outputWriterPtr->bufferPtrs[1] = 
+								&outputWriterPtr->bufferPtrs[0][kOutputWriterBufferBytes];
+		outputWriterPtr->writeBufferPtr = NULL;
+		
+		outputWriterPtr->fileStreamPtr = fileStreamPtr;
+		outputWriterPtr->bufferBytes = kOutputWriterBufferBytes;
+		outputWriterPtr->bufferIndex = 0;
+		outputWriterPtr->numberBytes = 0;
+		outputWriterPtr->writeNumberBytes = 0;
+		outputWriterPtr->errCode = noErr;
+		outputWriterPtr->writeThreadRunningFlag = FALSE;
+	#endif	// defined multispec_wx
+	
+	return (outputWriterPtr); 
+	
+}	// end "CreateOutputWriter"
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -196,6 +436,25 @@ void EndFileIOThread (
 				
 		InitializeFileIOInstructions (fileIOInstructionsPtr);
 	#endif	// defined multispec_mac
+	
+	#if defined multispec_wx
+		FileIOPrefetchPtr 			prefetchPtr;
+		
+		
+		prefetchPtr = fileIOInstructionsPtr->prefetchPtr;
+		if (prefetchPtr != NULL)
+			{
+			StopFileIOPrefetch (prefetchPtr);
+			
+			CheckAndDisposePtr ((Ptr)prefetchPtr->bufferPtr);
+			delete prefetchPtr;
+			
+			fileIOInstructionsPtr->prefetchPtr = NULL;
+			
+			}	// end "if (prefetchPtr != NULL)"
+			
+		InitializeFileIOInstructions (fileIOInstructionsPtr);
+	#endif	// defined multispec_wx
 
 	fileIOInstructionsPtr->fileStreamPtr = NULL;
 	
@@ -442,6 +701,194 @@ pascal void FileIOThread (void)
 
 
 
+#if defined multispec_wx
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void FileIOPrefetchThread
+//
+//	Software purpose: This routine contains the code for the read-ahead thread. It
+//							reads the lines starting at nextLineToRead into the free slots
+//							of the ring of buffers until the last line is read, an error
+//							occurs or it is told to stop. The reads are done with pread
+//							so that the file marker used by the main thread is not
+//							changed.
+//
+//	Parameters in:		Pointer to the read-ahead structure.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None
+//
+// Called By:			StartFileIOPrefetch
+
+void FileIOPrefetchThread (
+				FileIOPrefetchPtr					prefetchPtr)
+
+{
+	SInt64								posOff;
+	
+	HUCharPtr							slotBufferPtr;
+	
+	ssize_t								bytesRead;
+	
+	UInt32								bytesLeft,
+											count,
+											lineNumber,
+											numberSamples,
+											slot;
+	
+	SInt16								errCode;
+	
+	Boolean								endHalfByte;
+	
+	
+	std::unique_lock<std::mutex> lock (prefetchPtr->mutex);
+	
+	while (!prefetchPtr->stopFlag && 
+								prefetchPtr->nextLineToRead <= prefetchPtr->lineEnd)
+		{
+				// Wait until there is a free slot in the ring.
+				
+		while (!prefetchPtr->stopFlag &&
+					prefetchPtr->numberSlotsFilled - prefetchPtr->numberSlotsUsed >= 
+																				prefetchPtr->depth)
+			prefetchPtr->slotFreedCondition.wait (lock);
+			
+		if (prefetchPtr->stopFlag)
+			break;
+			
+		slot = prefetchPtr->numberSlotsFilled % prefetchPtr->depth;
+		lineNumber = prefetchPtr->nextLineToRead;
+		
+		lock.unlock ();
+		
+		posOff = GetFilePositionOffset (prefetchPtr->fileIOInstructionsPtr,
+													prefetchPtr->fileInfoPtr,
+													lineNumber, 
+													prefetchPtr->channelNumber, 
+													prefetchPtr->columnStart, 
+													prefetchPtr->columnEnd,
+													&numberSamples,
+													&count,
+													&endHalfByte);
+		
+		errCode = noErr;
+		if (count != prefetchPtr->count)
+			errCode = -1;
+		
+		slotBufferPtr = &prefetchPtr->bufferPtr[slot * prefetchPtr->bufferBytes];
+		bytesLeft = count;
+		while (errCode == noErr && bytesLeft > 0)
+			{
+			bytesRead = pread (prefetchPtr->fileDescriptor, 
+										slotBufferPtr, 
+										(size_t)bytesLeft, 
+										(off_t)posOff);
+			
+			if (bytesRead > 0)
+				{
+				slotBufferPtr += bytesRead;
+				posOff += bytesRead;
+				bytesLeft -= (UInt32)bytesRead;
+				
+				}	// end "if (bytesRead > 0)"
+				
+			else if (bytesRead == 0)
+				errCode = eofErr;
+				
+			else if (errno != EINTR)
+				errCode = ioErr;
+			
+			}	// end "while (errCode == noErr && bytesLeft > 0)"
+		
+		lock.lock ();
+		
+		prefetchPtr->slotErrCode[slot] = errCode;
+		prefetchPtr->numberSlotsFilled++;
+		prefetchPtr->nextLineToRead += prefetchPtr->lineInterval;
+		
+		prefetchPtr->slotFilledCondition.notify_one ();
+		
+		if (errCode != noErr)
+			break;
+		
+		}	// end "while (!prefetchPtr->stopFlag && ..."
+		
+	prefetchPtr->ioThreadDoneFlag = TRUE;
+	prefetchPtr->slotFilledCondition.notify_one ();
+	
+}	// end "FileIOPrefetchThread"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 FlushOutputWriterBuffer
+//
+//	Software purpose:	The purpose of this routine is to start writing the lines in
+//							the buffer being loaded to the file. The routine waits for
+//							any previous write to finish, starts the writer thread for
+//							the loaded buffer and switches to the other buffer for the 
+//							next lines. If the thread cannot be created, the buffer is 
+//							written by the calling thread.
+//
+//	Parameters in:		Pointer to the output writer.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	Error code for the previous write.
+//
+// Called By:			CloseOutputWriter
+//							WriteToOutputWriter
+
+SInt16 FlushOutputWriterBuffer (
+				OutputWriterPtr					outputWriterPtr)
+
+{ 
+	UInt32								count;
+	
+	SInt16								errCode;
+	
+	
+	errCode = WaitForOutputWriterThread (outputWriterPtr);
+	
+	if (errCode != noErr || outputWriterPtr->numberBytes == 0)
+																						return (errCode);
+	
+	outputWriterPtr->writeBufferPtr = 
+								outputWriterPtr->bufferPtrs[outputWriterPtr->bufferIndex];
+	outputWriterPtr->writeNumberBytes = outputWriterPtr->numberBytes;
+	
+	outputWriterPtr->bufferIndex = 1 - outputWriterPtr->bufferIndex;
+	outputWriterPtr->numberBytes = 0;
+	
+	try
+		{
+		outputWriterPtr->writeThread = std::thread (OutputWriterThread, outputWriterPtr);
+		outputWriterPtr->writeThreadRunningFlag = TRUE;
+		
+		}
+		
+	catch (const std::system_error&)
+		{
+		count = outputWriterPtr->writeNumberBytes;
+		errCode = MWriteData (outputWriterPtr->fileStreamPtr,
+										&count,
+										outputWriterPtr->writeBufferPtr,
+										kErrorMessages);
+		outputWriterPtr->errCode = errCode;
+		
+		}
+	
+	return (errCode); 
+	
+}	// end "FlushOutputWriterBuffer"
+#endif	// defined multispec_wx
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -481,6 +928,99 @@ SInt16 GetLineFileIOThread (
 	Boolean								endHalfByte;
 	
 	
+	#if defined multispec_wx
+		FileIOPrefetchPtr					prefetchPtr;
+		
+		UInt32								expectedLineNumber,
+												slot;
+		
+		Boolean								restartFlag;
+		
+		
+				// GetLine only calls this routine when the read-ahead pipeline
+				// exists for these instructions (see GetThreadedIOFlag). Lines for
+				// other instructions are read with the normal code in GetLine.
+		
+		GetFilePositionOffset (fileIOInstructionsPtr,
+										fileInfoPtr,
+										lineNumber, 
+										channelNumber, 
+										columnStart, 
+										columnEnd,
+										numberSamplesPtr,
+										&count,
+										&endHalfByte);
+		
+		fileIOInstructionsPtr->count = count;
+		
+		prefetchPtr = fileIOInstructionsPtr->prefetchPtr;
+		
+				// Restart the read-ahead pipeline if this is not the line expected
+				// next, for example when the lines are not read sequentially.
+		
+		expectedLineNumber = prefetchPtr->lineStart + 
+								prefetchPtr->numberSlotsUsed * prefetchPtr->lineInterval;
+		
+		restartFlag = (!prefetchPtr->runningFlag ||
+								lineNumber != expectedLineNumber ||
+									channelNumber != prefetchPtr->channelNumber ||
+										columnStart != prefetchPtr->columnStart ||
+											columnEnd != prefetchPtr->columnEnd ||
+												count != prefetchPtr->count);
+		
+		do
+			{
+			if (restartFlag)
+				{
+				StopFileIOPrefetch (prefetchPtr);
+				errCode = StartFileIOPrefetch (prefetchPtr,
+															lineNumber, 
+															channelNumber, 
+															columnStart, 
+															columnEnd,
+															count);
+				if (errCode != noErr)
+																					return (errCode);
+				
+				}	// end "if (restartFlag)"
+				
+			std::unique_lock<std::mutex> lock (prefetchPtr->mutex);
+			
+			while (prefetchPtr->numberSlotsFilled == prefetchPtr->numberSlotsUsed &&
+																	!prefetchPtr->ioThreadDoneFlag)
+				prefetchPtr->slotFilledCondition.wait (lock);
+				
+					// If the read-ahead thread finished without reading this line,
+					// the line is past the end of the requested area. Start again at
+					// this line.
+					
+			restartFlag = 
+						(prefetchPtr->numberSlotsFilled == prefetchPtr->numberSlotsUsed);
+			
+			}	while (restartFlag);
+			
+		slot = prefetchPtr->numberSlotsUsed % prefetchPtr->depth;
+		errCode = prefetchPtr->slotErrCode[slot];
+		
+		if (errCode == noErr)
+			BlockMoveData (&prefetchPtr->bufferPtr[slot * prefetchPtr->bufferBytes],
+									*fileIOBufferPtrPtr,
+									count);
+		
+				// Release the slot to the read-ahead thread.
+		
+		prefetchPtr->mutex.lock ();
+		prefetchPtr->numberSlotsUsed++;
+		prefetchPtr->mutex.unlock ();
+		
+		prefetchPtr->slotFreedCondition.notify_one ();
+		
+		if (errCode != noErr)
+			StopFileIOPrefetch (prefetchPtr);
+			
+																					return (errCode);
+	#endif	// defined multispec_wx
+	
 	if (!fileIOInstructionsPtr->bufferReadyFlag)
 		{
 		if (!fileIOInstructionsPtr->fileIOThreadStartedFlag)
@@ -588,6 +1128,294 @@ SInt16 GetLineFileIOThread (
 
 
 
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		UInt32 GetNumberWorkerThreads
+//
+//	Software purpose:	The purpose of this routine is to get the number of threads
+//							to be used to carry out the requested number of independent
+//							tasks. The number is limited by gMaximumNumberThreads (or the
+//							number of processors if it is 0), kMaxNumberThreads and the 
+//							number of tasks. Only one thread is used for the Mac and 
+//							Windows versions.
+//
+//	Parameters in:		Number of tasks to be done.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	Number of threads to use including the calling thread.
+//
+// Called By:			RunTasksInParallel in SThreads.cpp
+
+UInt32 GetNumberWorkerThreads (
+				UInt32								numberTasks)
+
+{
+	UInt32								numberThreads = 1;
+	
+	
+	#if defined multispec_wx
+		numberThreads = gMaximumNumberThreads;
+		if (numberThreads == 0)
+			numberThreads = std::thread::hardware_concurrency ();
+			
+		numberThreads = MIN (numberThreads, kMaxNumberThreads);
+		numberThreads = MIN (numberThreads, numberTasks);
+		numberThreads = MAX (numberThreads, 1);
+	#endif	// defined multispec_wx
+	
+	return (numberThreads);
+	
+}	// end "GetNumberWorkerThreads"
+
+
+
+#if defined multispec_wx
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void OutputWriterThread
+//
+//	Software purpose: This routine contains the code for the output writer thread. 
+//							It writes the buffer that was loaded to the file. Messages 
+//							cannot be displayed from this thread; the error code is 
+//							returned to the main thread in the output writer structure.
+//
+//	Parameters in:		Pointer to the output writer.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None
+//
+// Called By:			FlushOutputWriterBuffer
+
+void OutputWriterThread (
+				OutputWriterPtr					outputWriterPtr)
+
+{
+	UInt32								count;
+	
+	
+	count = outputWriterPtr->writeNumberBytes;
+	outputWriterPtr->errCode = MWriteData (outputWriterPtr->fileStreamPtr,
+															&count,
+															outputWriterPtr->writeBufferPtr,
+															kNoErrorMessages);
+	
+}	// end "OutputWriterThread"
+#endif	// defined multispec_wx
+
+
+
+#if defined multispec_wx
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void ParallelTasksThread
+//
+//	Software purpose: This routine contains the code for the threads which carry out
+//							a set of independent tasks. The next task that has not been
+//							started is taken until all tasks have been started.
+//
+//	Parameters in:		Pointer to the parallel tasks structure.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None
+//
+// Called By:			RunTasksInParallel
+
+void ParallelTasksThread (
+				ParallelTasksPtr					parallelTasksPtr)
+
+{
+	UInt32								task;
+	
+	
+	while ((task = parallelTasksPtr->nextTask++) < parallelTasksPtr->numberTasks)
+		parallelTasksPtr->taskRoutine (parallelTasksPtr->taskInfoPtr, task);
+	
+}	// end "ParallelTasksThread"
+#endif	// defined multispec_wx
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void RunTasksInParallel
+//
+//	Software purpose:	The purpose of this routine is to call the task routine for
+//							each of the task indices from 0 to numberTasks-1. For the wx
+//							versions the tasks are shared among worker threads and the
+//							calling thread. The routine returns after all tasks have been
+//							completed. A task routine should only change the data for its
+//							own task index. If the worker threads cannot be created, the 
+//							tasks are done by the calling thread.
+//
+//	Parameters in:		Number of tasks.
+//							Address of the routine which carries out one task.
+//							Pointer to the information used by the tasks.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None
+//
+// Called By:			ReadCompressedBlocks in SFileIO.cpp
+
+void RunTasksInParallel (
+				UInt32								numberTasks,
+				void									(*taskRoutine) (void*, UInt32),
+				void*									taskInfoPtr)
+
+{
+	UInt32								numberThreads,
+											task;
+	
+	
+	numberThreads = GetNumberWorkerThreads (numberTasks);
+	
+	#if defined multispec_wx
+		if (numberThreads > 1)
+			{
+			ParallelTasks					parallelTasks;
+			std::thread						workerThreads[kMaxNumberThreads];
+			
+			UInt32							numberWorkerThreads,
+												thread;
+			
+			
+			parallelTasks.nextTask = 0;
+			parallelTasks.taskRoutine = taskRoutine;
+			parallelTasks.taskInfoPtr = taskInfoPtr;
+			parallelTasks.numberTasks = numberTasks;
+			
+			numberWorkerThreads = 0;
+			for (thread=1; thread<numberThreads; thread++)
+				{
+				try
+					{
+					workerThreads[numberWorkerThreads] = 
+										std::thread (ParallelTasksThread, &parallelTasks);
+					numberWorkerThreads++;
+					
+					}
+					
+				catch (const std::system_error&)
+					{
+					break;
+					
+					}
+				
+				}	// end "for (thread=1; thread<numberThreads; thread++)"
+			
+					// The calling thread also carries out tasks.
+				
+			ParallelTasksThread (&parallelTasks);
+			
+			for (thread=0; thread<numberWorkerThreads; thread++)
+				workerThreads[thread].join ();
+																						return;
+			
+			}	// end "if (numberThreads > 1)"
+	#endif	// defined multispec_wx
+	
+	for (task=0; task<numberTasks; task++)
+		taskRoutine (taskInfoPtr, task);
+	
+}	// end "RunTasksInParallel"
+
+
+
+#if defined multispec_wx
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 StartFileIOPrefetch
+//
+//	Software purpose:	The purpose of this routine is to start the read-ahead
+//							thread at the requested line. The ring of buffers is 
+//							allocated (or enlarged) here since the number of bytes per 
+//							line is not known until the first line is requested.
+//
+//	Parameters in:		Pointer to the read-ahead structure.
+//							First line to be read.
+//							Channel, column start and column end for the reads.
+//							Number of bytes to be read per line.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	Error code.
+//
+// Called By:			GetLineFileIOThread
+
+SInt16 StartFileIOPrefetch (
+				FileIOPrefetchPtr					prefetchPtr,
+				UInt32								lineNumber, 
+				SInt16								channelNumber, 
+				UInt32								columnStart, 
+				UInt32								columnEnd,
+				UInt32								count)
+
+{ 
+	FileIOInstructionsPtr			fileIOInstructionsPtr;
+	
+	
+	fileIOInstructionsPtr = prefetchPtr->fileIOInstructionsPtr;
+	
+	if (prefetchPtr->bufferBytes < count)
+		{
+		prefetchPtr->bufferPtr = 
+								(HUCharPtr)CheckAndDisposePtr ((Ptr)prefetchPtr->bufferPtr);
+		prefetchPtr->bufferBytes = 0;
+		
+		prefetchPtr->bufferPtr = 
+						(HUCharPtr)MNewPointer ((SInt64)prefetchPtr->depth * count);
+		if (prefetchPtr->bufferPtr == NULL)
+																						return (-1);
+		
+		prefetchPtr->bufferBytes = count;
+		
+		}	// end "if (prefetchPtr->bufferBytes < count)"
+	
+	prefetchPtr->channelNumber = channelNumber;
+	prefetchPtr->columnStart = columnStart;
+	prefetchPtr->columnEnd = columnEnd;
+	prefetchPtr->count = count;
+	
+	prefetchPtr->lineStart = lineNumber;
+	prefetchPtr->lineInterval = MAX (fileIOInstructionsPtr->lineInterval, 1);
+	prefetchPtr->lineEnd = MAX ((UInt32)fileIOInstructionsPtr->lineEnd, lineNumber);
+	prefetchPtr->nextLineToRead = lineNumber;
+	
+	prefetchPtr->numberSlotsFilled = 0;
+	prefetchPtr->numberSlotsUsed = 0;
+	
+	prefetchPtr->ioThreadDoneFlag = FALSE;
+	prefetchPtr->stopFlag = FALSE;
+	
+	try
+		{
+		prefetchPtr->ioThread = std::thread (FileIOPrefetchThread, prefetchPtr);
+		
+		}
+		
+	catch (const std::system_error&)
+		{
+																						return (-1);
+		
+		}
+		
+	prefetchPtr->runningFlag = TRUE;
+	
+	return (noErr); 
+	
+}	// end "StartFileIOPrefetch"
+#endif	// defined multispec_wx
+
+
+
 //------------------------------------------------------------------------------------
 //                   Copyright 1988-2020 Purdue Research Foundation
 //
@@ -712,11 +1540,143 @@ SInt16 SetupFileIOThread (
 			}	// end "if (gUseThreadedIOFlag)" 
 	#endif	// defined multispec_mac
 	
+	#if defined multispec_wx
+		FileIOPrefetchPtr					prefetchPtr;
+		
+		
+				// Release the read-ahead pipeline from a previous use of these 
+				// instructions if it was not closed up.
+				
+		EndFileIOThread (fileIOInstructionsPtr);
+		
+		fileIOInstructionsPtr->fileStreamPtr = GetFileStreamPointer (
+																fileIOInstructionsPtr->fileInfoPtr);
+		
+		if (gUseThreadedIOFlag)
+			{
+					// The read-ahead thread is not started until the first line is
+					// requested. If the structure cannot be created, the lines will
+					// just be read on the calling thread.
+					
+			prefetchPtr = NULL;
+			if (fileIOInstructionsPtr->fileStreamPtr != NULL &&
+									fileIOInstructionsPtr->fileStreamPtr->IsOpened ())
+				prefetchPtr = new (std::nothrow) FileIOPrefetch;
+			
+			if (prefetchPtr != NULL)
+				{
+				prefetchPtr->fileInfoPtr = fileIOInstructionsPtr->fileInfoPtr;
+				prefetchPtr->fileIOInstructionsPtr = fileIOInstructionsPtr;
+				prefetchPtr->fileDescriptor = fileIOInstructionsPtr->fileStreamPtr->fd ();
+				
+				prefetchPtr->bufferPtr = NULL;
+				prefetchPtr->bufferBytes = 0;
+				prefetchPtr->depth = MIN (gThreadedIOPrefetchDepth, kMaxPrefetchDepth);
+				
+				prefetchPtr->numberSlotsFilled = 0;
+				prefetchPtr->numberSlotsUsed = 0;
+				
+				prefetchPtr->ioThreadDoneFlag = FALSE;
+				prefetchPtr->runningFlag = FALSE;
+				prefetchPtr->stopFlag = FALSE;
+				
+				}	// end "if (prefetchPtr != NULL)"
+				
+			fileIOInstructionsPtr->prefetchPtr = prefetchPtr;
+			
+			}	// end "if (gUseThreadedIOFlag)" 
+	#endif	// defined multispec_wx
+	
 	return (errCode);
 	
 }	// end "SetupFileIOThread"
 
 
+
+#if defined multispec_wx
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		void StopFileIOPrefetch
+//
+//	Software purpose:	The purpose of this routine is to stop the read-ahead thread
+//							and wait for it to finish. Any lines already read into the 
+//							ring of buffers are discarded.
+//
+//	Parameters in:		Pointer to the read-ahead structure.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	None
+//
+// Called By:			EndFileIOThread
+//							GetLineFileIOThread
+
+void StopFileIOPrefetch (
+				FileIOPrefetchPtr					prefetchPtr)
+
+{ 
+	if (prefetchPtr->runningFlag)
+		{
+		prefetchPtr->mutex.lock ();
+		prefetchPtr->stopFlag = TRUE;
+		prefetchPtr->mutex.unlock ();
+		
+		prefetchPtr->slotFreedCondition.notify_one ();
+		
+		if (prefetchPtr->ioThread.joinable ())
+			prefetchPtr->ioThread.join ();
+		
+		prefetchPtr->runningFlag = FALSE;
+		
+		}	// end "if (prefetchPtr->runningFlag)"
+	
+}	// end "StopFileIOPrefetch"
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 WaitForOutputWriterThread
+//
+//	Software purpose:	The purpose of this routine is to wait for the output writer
+//							thread to finish writing the last buffer given to it. If that
+//							write failed, the error message is displayed here on the
+//							calling thread since it cannot be displayed from the writer
+//							thread.
+//
+//	Parameters in:		Pointer to the output writer.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	Error code for the writes done on the writer thread.
+//
+// Called By:			CloseOutputWriter
+//							FlushOutputWriterBuffer
+
+SInt16 WaitForOutputWriterThread (
+				OutputWriterPtr					outputWriterPtr)
+
+{ 
+	if (outputWriterPtr->writeThreadRunningFlag)
+		{
+		if (outputWriterPtr->writeThread.joinable ())
+			outputWriterPtr->writeThread.join ();
+		
+		outputWriterPtr->writeThreadRunningFlag = FALSE;
+		
+		if (outputWriterPtr->errCode != noErr)
+			IOCheck (outputWriterPtr->errCode, outputWriterPtr->fileStreamPtr);
+		
+		}	// end "if (outputWriterPtr->writeThreadRunningFlag)"
+	
+	return (outputWriterPtr->errCode);
+	
+}	// end "WaitForOutputWriterThread"
+#endif	// defined multispec_wx
+
+
            
 #if defined multispec_mac 
 //------------------------------------------------------------------------------------
@@ -789,3 +1749,68 @@ pascal void WakeUpThread (
 	*/			
 }	// end "WakeUpThread" 
 #endif	// defined multispec_mac
+
+
+
+//------------------------------------------------------------------------------------
+//                   Copyright 1988-2020 Purdue Research Foundation
+//
+//	Function name:		SInt16 WriteToOutputWriter
+//
+//	Software purpose:	The purpose of this routine is to copy the input bytes to the
+//							output writer buffer. A buffer is handed to the writer thread
+//							when it becomes full. Errors from the writes done on the writer
+//							thread are returned by the next call after the thread has 
+//							finished so that the caller can handle them as if the write 
+//							had been done directly.
+//
+//	Parameters in:		Pointer to the output writer.
+//							Pointer to the bytes to be written.
+//							Number of bytes to be written.
+//
+//	Parameters out:	None
+//
+//	Value Returned:	Error code for the writes to the file.
+//
+// Called By:			WriteClassificationResults in SClassify.cpp
+
+SInt16 WriteToOutputWriter (
+				OutputWriterPtr					outputWriterPtr,
+				void*									inBufferPtr,
+				UInt32								numberBytes)
+
+{ 
+	SInt16								errCode = noErr;
+	
+	
+	#if defined multispec_wx
+		HUCharPtr							inputPtr;
+		
+		UInt32								count;
+		
+		
+		inputPtr = (HUCharPtr)inBufferPtr;
+		
+		while (numberBytes > 0 && errCode == noErr)
+			{
+			count = MIN (numberBytes, 
+								outputWriterPtr->bufferBytes - outputWriterPtr->numberBytes);
+			
+			BlockMoveData (inputPtr,
+								&outputWriterPtr->bufferPtrs[outputWriterPtr->bufferIndex][
+																		outputWriterPtr->numberBytes],
+								count);
+			
+			outputWriterPtr->numberBytes += count;
+			inputPtr += count;
+			numberBytes -= count;
+			
+			if (outputWriterPtr->numberBytes >= outputWriterPtr->bufferBytes)
+				errCode = FlushOutputWriterBuffer (outputWriterPtr);
+			
+			}	// end "while (numberBytes > 0 && errCode == noErr)"
+	#endif	// defined multispec_wx
+	
+	return (errCode); 
+	
+}	// end "WriteToOutputWriter"
@@ -388,6 +388,7 @@ void CloseUpAreaDescription (
 			DisposeRgn (areaDescriptionPtr->rgnHandle);
 			
 		areaDescriptionPtr->rgnHandle = NULL;
+		areaDescriptionPtr->polygonPointsPtr = NULL;
 		areaDescriptionPtr->polygonFieldFlag = FALSE;
 		
 		areaDescriptionPtr->pointType = kRectangleType; 
@@ -5874,6 +5875,7 @@ void InitializeAreaDescription (
 		{
 		areaDescriptionPtr->maskInfoPtr = NULL;
 		areaDescriptionPtr->rgnHandle = NULL;
+		areaDescriptionPtr->polygonPointsPtr = NULL;
 		
 		areaDescriptionPtr->line = 0;
 		
@@ -5910,6 +5912,7 @@ void InitializeAreaDescription (
 		
 		areaDescriptionPtr->classNumber = 0;
 		areaDescriptionPtr->fieldNumber = 0;
+		areaDescriptionPtr->numberPolygonPoints = 0;
 		areaDescriptionPtr->diskFileFormat = diskFileFormat; 
 		areaDescriptionPtr->pointType = kRectangleType; 
 		
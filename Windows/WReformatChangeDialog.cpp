@@ -57,6 +57,7 @@ BEGIN_MESSAGE_MAP (CMChangeFormatDlg, CMDialog)
 	ON_CBN_SELENDOK (IDC_BandInterleave, OnSelendokBandInterleave)
 	ON_CBN_SELENDOK (IDC_ChangeHeader, OnSelendokHeader)
 	ON_CBN_SELENDOK (IDC_DataValueType, OnSelendokDataValueType)
+	ON_CBN_SELENDOK (IDC_TIFFCompression, OnSelendokTIFFCompression)
 	ON_CBN_SELENDOK (IDC_ChannelCombo, OnSelendokOutChannels)
 
 	ON_EN_CHANGE (IDC_ColumnEnd, CheckColumnEnd)
@@ -82,6 +83,8 @@ CMChangeFormatDlg::CMChangeFormatDlg (
 	m_dataValueListSelection = -1;
 	m_outputFileSelection = -1;
 	m_bandInterleaveSelection = -1;
+	m_tiffCompressionListSelection = 0;
+	m_tiffOverviewsFlag = FALSE;
 	m_invertBottomToTopFlag = FALSE;
 	m_writeChanDescriptionFlag = FALSE;
 	m_invertLeftToRightFlag = FALSE;
@@ -124,6 +127,8 @@ void CMChangeFormatDlg::DoDataExchange (
 	DDX_CBIndex (pDX, IDC_DataValueType, m_dataValueListSelection);
 	DDX_CBIndex (pDX, IDC_OutputFileSelection, m_outputFileSelection);
 	DDX_CBIndex (pDX, IDC_BandInterleave, m_bandInterleaveSelection);
+	DDX_CBIndex (pDX, IDC_TIFFCompression, m_tiffCompressionListSelection);
+	DDX_Check (pDX, IDC_TIFFOverviews, m_tiffOverviewsFlag);
 	DDX_Check (pDX, IDC_InvertBottomToTop, m_invertBottomToTopFlag);
 	DDX_Check (pDX, IDC_WriteChanDescriptions, m_writeChanDescriptionFlag);
 	DDX_Check (pDX, IDC_OutputInWavelengthOrder, m_outputInWavelengthOrderFlag);
@@ -198,6 +203,13 @@ Boolean CMChangeFormatDlg::DoDialog (
 		m_dialogSelectArea.columnEnd = m_ColumnEnd;
 		m_dialogSelectArea.columnInterval = m_ColumnInterval;
 
+				// Compression to use for new TIFF/GeoTIFF files.
+
+		CComboBox* comboBoxPtr = (CComboBox*)GetDlgItem (IDC_TIFFCompression);
+		gTIFFOutputCompressionCode =
+						(UInt16)comboBoxPtr->GetItemData (m_tiffCompressionListSelection);
+		gTIFFOutputOverviewsFlag = m_tiffOverviewsFlag;
+
 		OKFlag = ChangeImageFormatDialogOK (this,
 														gImageWindowInfoPtr,
 														gImageLayerInfoPtr,
@@ -326,7 +338,28 @@ BOOL CMChangeFormatDlg::OnInitDialog (void)
 	
 	m_headerListSelection = GetComboListSelection (IDC_ChangeHeader,
 																	m_headerOptionsSelection);
-																	
+
+	comboBoxPtr = (CComboBox*)(GetDlgItem (IDC_TIFFCompression));
+	comboBoxPtr->AddString ((LPCTSTR)_T("None"));
+	comboBoxPtr->SetItemData (0, kNoCompression);
+	comboBoxPtr->AddString ((LPCTSTR)_T("LZW"));
+	comboBoxPtr->SetItemData (1, kLZWCompression);
+	#if include_zlib_capability
+		comboBoxPtr->AddString ((LPCTSTR)_T("Deflate"));
+		comboBoxPtr->SetItemData (2, kDeflateCompression);
+	#endif	// include_zlib_capability
+
+	m_tiffCompressionListSelection = GetComboListSelection (IDC_TIFFCompression,
+																			gTIFFOutputCompressionCode);
+	if (m_tiffCompressionListSelection < 0)
+		m_tiffCompressionListSelection = 0;
+	m_tiffOverviewsFlag = gTIFFOutputOverviewsFlag;
+
+	ChangeImageFormatDialogUpdateTIFFOptions (this,
+															m_headerOptionsSelection,
+															m_bandInterleaveSelection,
+															m_tiffCompressionListSelection);
+
 	if (UpdateData (FALSE))
 		PositionDialogWindow (); 
 		
@@ -534,6 +567,11 @@ void CMChangeFormatDlg::OnSelendokBandInterleave (void)
 	
 	if (changedFlag)
 		OnSelendokHeader (); 
+
+	ChangeImageFormatDialogUpdateTIFFOptions (this,
+															m_headerOptionsSelection,
+															m_bandInterleaveSelection,
+															m_tiffCompressionListSelection);
 	
 }	// end "OnSelendokBandInterleave"
 
@@ -556,6 +594,20 @@ void CMChangeFormatDlg::OnSelendokOutChannels (void)
 
 
 
+void CMChangeFormatDlg::OnSelendokTIFFCompression (void)
+
+{
+	DDX_CBIndex (m_dialogFromPtr, IDC_TIFFCompression, m_tiffCompressionListSelection);
+
+	ChangeImageFormatDialogUpdateTIFFOptions (this,
+															m_headerOptionsSelection,
+															m_bandInterleaveSelection,
+															m_tiffCompressionListSelection);
+
+}	// end "OnSelendokTIFFCompression"
+
+
+
 void CMChangeFormatDlg::OnSelendokHeader (void)
 
 {
@@ -606,6 +658,11 @@ void CMChangeFormatDlg::OnSelendokHeader (void)
 	DDX_CBIndex (m_dialogToPtr, IDC_BandInterleave, m_bandInterleaveSelection);
 	DDX_CBIndex (m_dialogToPtr, IDC_OutputFileSelection, m_outputFileSelection);
 	DDX_CBIndex (m_dialogToPtr, IDC_DataValueType, m_dataValueListSelection);
+
+	ChangeImageFormatDialogUpdateTIFFOptions (this,
+															m_headerOptionsSelection,
+															m_bandInterleaveSelection,
+															m_tiffCompressionListSelection);
 	
 }	// end "OnSelendokHeader" 
 
@@ -713,4 +770,9 @@ void CMChangeFormatDlg::OnSelendokDataValueType ()
 
 		}	// end "if (m_dataValueListSelection >= 0)"
 
+	ChangeImageFormatDialogUpdateTIFFOptions (this,
+															m_headerOptionsSelection,
+															m_bandInterleaveSelection,
+															m_tiffCompressionListSelection);
+
 }	// end "OnSelendokDataValueType"
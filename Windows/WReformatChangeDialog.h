@@ -54,12 +54,14 @@ class CMChangeFormatDlg : public CMDialog
 												m_channelSelection,
 												m_dataValueListSelection,
 												m_headerListSelection,
-												m_outputFileSelection;
+												m_outputFileSelection,
+												m_tiffCompressionListSelection;
 	
 		BOOL									m_invertBottomToTopFlag,
 												m_invertLeftToRightFlag,
 												m_outputInWavelengthOrderFlag,
 												m_swapBytesFlag,
+												m_tiffOverviewsFlag,
 												m_transformDataFlag,
 												m_writeChanDescriptionFlag;
 		//}}AFX_DATA
@@ -86,6 +88,8 @@ class CMChangeFormatDlg : public CMDialog
 		afx_msg void OnSelendokHeader ();
 	
 		afx_msg void OnSelendokOutChannels ();
+	
+		afx_msg void OnSelendokTIFFCompression ();
 	
 		afx_msg void OnTransformData ();
 	
@@ -1701,6 +1701,9 @@
 #define IDC_SVM_P_INFO                  1919
 #define IDC_SVM_PROBABILITY             1920
 #define IDC_SVM_PROBABILITY_INFO        1921
+#define IDC_TIFFCompressionPrompt       1923
+#define IDC_TIFFCompression             1924
+#define IDC_TIFFOverviews               1925
 #define IDS_ListData1                   2001
 #define IDS_ListData2                   2002
 #define IDS_ListData3                   2003
@@ -2412,7 +2415,7 @@
 #ifndef APSTUDIO_READONLY_SYMBOLS
 #define _APS_NEXT_RESOURCE_VALUE        271
 #define _APS_NEXT_COMMAND_VALUE         32931
-#define _APS_NEXT_CONTROL_VALUE         1923
+#define _APS_NEXT_CONTROL_VALUE         1926
 #define _APS_NEXT_SYMED_VALUE           111
 #endif
 #endif
@@ -0,0 +1,271 @@
+//	 									MultiSpec
+//
+//					Copyright 1988-2020 Purdue Research Foundation
+//
+//	File:						AdjustReadDataCheck.cpp
+//
+//	Revision date:			10/17/2026
+//
+//	Language:				C++
+//
+//	System:					Linux and MacOS Operating Systems (x86 processors)
+//
+//	Brief description:	This program checks that AdjustReadData in SFileIO.cpp gives
+//								the same bytes as the sequence GetLine used before it for
+//								every post read code: SwapBytes, AdjustSignedData and then
+//								the 4-bit unpack loop. Both the scalar (gSIMDLevel set to
+//								kSIMDNone) and the SSE4.1 versions are checked. The file
+//								information is changed in place between the cases, as
+//								happens when the swap bytes flag is set while a header is
+//								being read, so that any saved code would show up as an error.
+//								The routines are copied from SFileIO.cpp by the Makefile.
+//
+//								The program returns 1 if any output differs.
+//
+//------------------------------------------------------------------------------------
+
+#include "SIMDConversionTest.h"
+
+Boolean							gConvertSignedDataFlag = FALSE;
+SInt16							gSIMDLevel = -1;
+
+#include "SFileIOAdjustRoutines.inc"
+
+		// Number of random lines checked for each combination of settings.
+#define	kNumberTrials							500
+
+		// Maximum number of samples in a line.
+#define	kMaximumSamples						300
+
+
+
+//------------------------------------------------------------------------------------
+//
+//	Function name:		void AdjustReadDataPrevious
+//
+//	Software purpose:	The purpose of this routine is to do the operations on a line
+//							of data after it is read the way GetLine did before
+//							AdjustReadData was added.
+//
+//	Parameters in:		File information pointer.
+//							Pointer to the line of data.
+//							Number of samples in the line.
+//							Number of bytes read (only used for 4-bit data).
+//							Flag indicating whether the last sample is in the lower half of
+//								the last byte (only used for 4-bit data).
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+
+void AdjustReadDataPrevious (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							fileIOBufferPtr,
+				UInt32								numberSamples,
+				UInt32								count,
+				Boolean								endHalfByte)
+
+{
+	if (fileInfoPtr->swapBytesFlag && fileInfoPtr->numberBytes >= 2)
+		SwapBytes (fileInfoPtr->numberBytes,
+						fileIOBufferPtr,
+						numberSamples);
+
+	if (gConvertSignedDataFlag &&
+				fileInfoPtr->signedDataFlag &&
+						fileInfoPtr->gdalDataSetH == NULL)
+		AdjustSignedData (fileInfoPtr, fileIOBufferPtr, numberSamples);
+
+	if (fileInfoPtr->numberBits == 4)
+		{
+		HPtr						byte1Ptr;
+		HPtr						byte2Ptr;
+
+		UInt32					samplesLeft;
+
+		samplesLeft = numberSamples;
+		byte1Ptr = (HPtr)&fileIOBufferPtr[samplesLeft-1];
+		byte2Ptr = (HPtr)&fileIOBufferPtr[count-1];
+		if (endHalfByte)
+			{
+			*byte1Ptr = *byte2Ptr & 0x0f;
+
+			samplesLeft--;
+			byte1Ptr--;
+			byte2Ptr--;
+
+			}	// end "if (endHalfByte)"
+
+		while (samplesLeft >= 2)
+			{
+			*byte1Ptr = (*byte2Ptr & 0xf0)>>4;
+
+			samplesLeft--;
+			byte1Ptr--;
+
+			*byte1Ptr = *byte2Ptr & 0x0f;
+
+			samplesLeft--;
+			byte1Ptr--;
+			byte2Ptr--;
+
+			}	// end "while (samplesLeft >= 2)"
+
+		if (samplesLeft)
+			*byte1Ptr = (*byte2Ptr & 0xf0)>>4;
+
+		}	// end "if (fileInfoPtr->numberBits == 4)"
+
+}	// end "AdjustReadDataPrevious"
+
+
+
+//------------------------------------------------------------------------------------
+//
+//	Function name:		UInt32 CheckPostReadSettings
+//
+//	Software purpose:	The purpose of this routine is to compare AdjustReadData with
+//							AdjustReadDataPrevious for random lines using the current
+//							settings in the file information structure.
+//
+//	Parameters in:		File information pointer.
+//
+//	Parameters out:	None
+//
+// Value Returned:	Number of lines that did not match.
+
+UInt32 CheckPostReadSettings (
+				FileInfoPtr							fileInfoPtr)
+
+{
+	UInt8									newBuffer[kMaximumSamples*8+32],
+											previousBuffer[kMaximumSamples*8+32];
+
+	UInt32								count,
+											index,
+											numberFailures,
+											numberSamples,
+											trial;
+
+	Boolean								endHalfByte,
+											startHighHalfByte;
+
+
+	numberFailures = 0;
+	for (trial=0; trial<kNumberTrials; trial++)
+		{
+		numberSamples = 1 + rand () % kMaximumSamples;
+		count = numberSamples * fileInfoPtr->numberBytes;
+		endHalfByte = FALSE;
+
+		if (fileInfoPtr->numberBits == 4)
+			{
+					// The line may start in either half of the first byte.
+
+			startHighHalfByte = rand () % 2;
+			count = (numberSamples + 1) / 2;
+			endHalfByte = startHighHalfByte ? !(numberSamples & 1) : (numberSamples & 1);
+			if (startHighHalfByte && endHalfByte)
+				count++;
+
+			}	// end "if (fileInfoPtr->numberBits == 4)"
+
+		for (index=0; index<sizeof (newBuffer); index++)
+			newBuffer[index] = (UInt8)rand ();
+		memcpy (previousBuffer, newBuffer, sizeof (newBuffer));
+
+		AdjustReadData (fileInfoPtr, newBuffer, numberSamples, count, endHalfByte);
+		AdjustReadDataPrevious (
+								fileInfoPtr, previousBuffer, numberSamples, count, endHalfByte);
+
+		if (memcmp (newBuffer, previousBuffer, sizeof (newBuffer)) != 0)
+			numberFailures++;
+
+		}	// end "for (trial=0; trial<kNumberTrials; trial++)"
+
+	return (numberFailures);
+
+}	// end "CheckPostReadSettings"
+
+
+
+int main (void)
+
+{
+	FileInfo								fileInfo;
+
+	UInt32								failures,
+											numberCases,
+											numberFailures;
+
+	SInt16								bits,
+											bytesIndex,
+											convertSigned,
+											maximumSIMDLevel,
+											signedData,
+											simdLevel,
+											swapBytes;
+
+	static const UInt16				sNumberBytes[] = {1, 1, 2, 2, 4, 8};
+	static const UInt16				sNumberBits[] = {4, 8, 12, 16, 32, 64};
+
+
+	srand (3);
+
+	maximumSIMDLevel = GetSIMDLevel ();
+	if (maximumSIMDLevel > kSIMDSSE41)
+		maximumSIMDLevel = kSIMDSSE41;
+
+	memset (&fileInfo, 0, sizeof (fileInfo));
+
+	numberCases = 0;
+	numberFailures = 0;
+	for (simdLevel=kSIMDNone; simdLevel<=maximumSIMDLevel; simdLevel++)
+		{
+		gSIMDLevel = simdLevel;
+
+		for (bytesIndex=0; bytesIndex<6; bytesIndex++)
+			for (swapBytes=0; swapBytes<=1; swapBytes++)
+				for (signedData=0; signedData<=1; signedData++)
+					for (convertSigned=0; convertSigned<=1; convertSigned++)
+						{
+						fileInfo.numberBytes = sNumberBytes[bytesIndex];
+						fileInfo.numberBits = sNumberBits[bytesIndex];
+						fileInfo.swapBytesFlag = swapBytes;
+						fileInfo.signedDataFlag = signedData;
+						gConvertSignedDataFlag = convertSigned;
+
+						bits = MIN (fileInfo.numberBits, 16);
+						if (fileInfo.numberBits == 4)
+							bits = 8;
+						fileInfo.signedBitMask = (UInt16)(1 << (bits - 1));
+						fileInfo.signedValueMask = (UInt16)((1 << bits) - 1);
+
+						failures = CheckPostReadSettings (&fileInfo);
+						numberCases++;
+
+						if (failures > 0)
+							printf ("Differs: level %d bytes %d bits %d swap %d signed %d "
+											"convert %d post read code %04x (%u lines)\n",
+										simdLevel,
+										fileInfo.numberBytes,
+										fileInfo.numberBits,
+										swapBytes,
+										signedData,
+										convertSigned,
+										GetPostReadCode (&fileInfo),
+										failures);
+
+						numberFailures += failures;
+
+						}	// end "for (convertSigned=0; convertSigned<=1; ..."
+
+		}	// end "for (simdLevel=kSIMDNone; simdLevel<=maximumSIMDLevel; ..."
+
+	printf ("Bit-exact check: %u of %u lines differ from the previous GetLine code\n",
+				numberFailures,
+				numberCases * kNumberTrials);
+
+	return (numberFailures > 0);
+
+}	// end "main"
@@ -0,0 +1,60 @@
+# Copies the routines named in the "routines" variable (separated by spaces) from
+# a MultiSpec source file to the standard output. A routine starts with the
+# comment line before its "Function name:" line and ends with its
+# "}	// end "Name"" line.
+#
+#	awk -v routines="GetSIMDLevel PackBISData" -f ExtractRoutines.awk SFileIO.cpp
+
+BEGIN {
+	numberRoutines = split (routines, names, " ")
+	for (index1=1; index1<=numberRoutines; index1++)
+		wanted[names[index1]] = 1
+	copying = 0
+	}
+
+/^\/\/-----/ {
+	if (!copying)
+		{
+		header = $0 "\n"
+		inHeader = 1
+		next
+		}
+	}
+
+{
+	if (copying)
+		{
+		print
+		if ($0 ~ "^}[ \t]*// end \"" currentName "\"")
+			{
+			copying = 0
+			print ""
+			}
+		next
+		}
+	
+	if (inHeader)
+		{
+		header = header $0 "\n"
+		if ($0 ~ /Function name:/)
+			{
+			currentName = $NF
+			inHeader = 0
+			if (currentName in wanted)
+				{
+				copying = 1
+				found[currentName] = 1
+				printf "%s", header
+				}
+			}
+		}
+	}
+
+END {
+	for (name in wanted)
+		if (!(name in found))
+			{
+			print "ExtractRoutines.awk: " name " not found" > "/dev/stderr"
+			exit 1
+			}
+	}
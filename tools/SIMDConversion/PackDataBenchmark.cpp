@@ -0,0 +1,559 @@
+//	 									MultiSpec
+//
+//					Copyright 1988-2020 Purdue Research Foundation
+//
+//	File:						PackDataBenchmark.cpp
+//
+//	Revision date:			10/17/2026
+//
+//	Language:				C++
+//
+//	System:					Linux and MacOS Operating Systems (x86 processors)
+//
+//	Brief description:	This program checks that the SSE4.1 and AVX2 versions of
+//								PackNonBISData and PackBISData in SFileIO.cpp give the same
+//								bytes as the scalar code for every data conversion code that
+//								has a SIMD kernel and then lists the MB/s for each version.
+//								The scalar code is used by setting gSIMDLevel to kSIMDNone.
+//								The routines are copied from SFileIO.cpp by the Makefile.
+//
+//								The program returns 1 if any output differs.
+//
+//------------------------------------------------------------------------------------
+
+#include "SIMDConversionTest.h"
+
+#include <chrono>
+
+SInt16							gSIMDLevel = -1;
+
+#include "SFileIOPackRoutines.inc"
+
+		// Number of random cases checked for each conversion code and SIMD level.
+#define	kNumberTrials							200
+
+		// Size of the line used for timing.
+#define	kBenchmarkColumns						2000
+#define	kBenchmarkChannels					200
+#define	kBenchmarkRepeats						20
+#define	kBenchmarkRuns							5
+
+		// Value used to fill the output buffers so that bytes written past the end
+		// of the output are found.
+#define	kGuardByte								0xAB
+
+static UInt32 sConversionCodes[] =
+	{
+	k8BitTo8Bit,
+	k8BitIntSignedTo16BitIntSigned,
+	k8BitIntUnsignedTo16BitIntUnsigned,
+	k8BitIntUnsignedTo16BitIntSigned,
+	k8BitIntSignedTo32BitIntSigned,
+	k8BitIntUnsignedTo32BitIntUnsigned,
+	k8BitIntUnsignedTo32BitIntSigned,
+	k8BitIntSignedTo32BitReal,
+	k8BitIntUnsignedTo32BitReal,
+	k8BitIntSignedTo64BitReal,
+	k8BitIntUnsignedTo64BitReal,
+	k16BitTo16Bit,
+	k16BitIntSignedTo32BitIntSigned,
+	k16BitIntUnsignedTo32BitIntUnsigned,
+	k16BitIntUnsignedTo32BitIntSigned,
+	k16BitIntSignedTo32BitReal,
+	k16BitIntUnsignedTo32BitReal,
+	k16BitIntSignedTo64BitReal,
+	k16BitIntUnsignedTo64BitReal,
+	k32BitTo32Bit,
+	k32BitIntSignedTo32BitReal,
+	k32BitIntUnsignedTo32BitReal,
+	k32BitIntSignedTo64BitReal,
+	k32BitIntUnsignedTo64BitReal,
+	k32BitRealTo64BitReal,
+	k64BitTo64Bit,
+	k64BitRealTo32BitReal
+	};
+
+#define	kNumberConversionCodes \
+					(sizeof (sConversionCodes) / sizeof (sConversionCodes[0]))
+
+		// Channels (the second half) used to time PackBISData.
+static UInt16 sChannelList[kBenchmarkChannels/2];
+
+
+
+//------------------------------------------------------------------------------------
+//
+//	Function name:		void FillInputBuffer
+//
+//	Software purpose:	The purpose of this routine is to fill the input buffer with
+//							random values. Real input data is set to finite values so that
+//							the results do not depend on how NaN values are converted.
+//
+//	Parameters in:		Data conversion code.
+//							Pointer to the buffer.
+//							Number of bytes in the buffer.
+//
+//	Parameters out:	None
+//
+// Value Returned:	None
+
+void FillInputBuffer (
+				UInt32								dataConversionCode,
+				HUCharPtr							bufferPtr,
+				UInt32								numberBytes)
+
+{
+	double								doubleValue;
+	float									floatValue;
+
+	UInt32								index,
+											inputCode;
+
+
+	inputCode = (dataConversionCode >> 16) & 0x0000ffff;
+
+	if (inputCode == 0x00000203)
+		{
+		for (index=0; index+4<=numberBytes; index+=4)
+			{
+			floatValue = (float)(rand () - RAND_MAX/2) / 7.0f;
+			memcpy (&bufferPtr[index], &floatValue, 4);
+
+			}	// end "for (index=0; index+4<=numberBytes; index+=4)"
+
+		}	// end "if (inputCode == 0x00000203)"
+
+	else if (inputCode == 0x00000403 || dataConversionCode == k64BitTo64Bit)
+		{
+		for (index=0; index+8<=numberBytes; index+=8)
+			{
+			doubleValue = (double)(rand () - RAND_MAX/2) / 7.0;
+			memcpy (&bufferPtr[index], &doubleValue, 8);
+
+			}	// end "for (index=0; index+8<=numberBytes; index+=8)"
+
+		}	// end "else if (inputCode == 0x00000403 || ..."
+
+	else	// integer input
+		{
+		for (index=0; index<numberBytes; index++)
+			bufferPtr[index] = (UInt8)rand ();
+
+		}	// end "else integer input"
+
+			// Fill any bytes left over after the last real value.
+
+	while (index < numberBytes)
+		{
+		bufferPtr[index] = (UInt8)rand ();
+		index++;
+
+		}	// end "while (index < numberBytes)"
+
+}	// end "FillInputBuffer"
+
+
+
+//------------------------------------------------------------------------------------
+//
+//	Function name:		UInt32 CheckConversionCode
+//
+//	Software purpose:	The purpose of this routine is to compare the output of
+//							PackNonBISData (non-BIS input to BIS or non-BIS output) and
+//							PackBISData for the requested SIMD level with that of the
+//							scalar code for random line sizes, offsets and channel lists.
+//
+//	Parameters in:		Data conversion code.
+//							SIMD level to be compared with the scalar code.
+//
+//	Parameters out:	None
+//
+// Value Returned:	Number of cases that did not match.
+
+UInt32 CheckConversionCode (
+				UInt32								dataConversionCode,
+				SInt16								simdLevel)
+
+{
+	HUCharPtr							inputPtr,
+											scalarOutputPtr,
+											simdOutputPtr;
+
+	UInt16								channelList[32];
+
+	UInt32								bisChannels,
+											channel,
+											columnOffset,
+											fileChannels,
+											inputBytes,
+											numberBufferChannels,
+											numberChannels,
+											numberColumns,
+											numberFailures,
+											numberInputBytes,
+											numberOutputBytes,
+											numberSamples,
+											outputBytes,
+											trial;
+
+	UInt16								firstChannel,
+											listChannel;
+
+	Boolean								consecutiveFlag,
+											toBISFormatFlag,
+											useListFlag;
+
+
+	GetSIMDConversionBytes (dataConversionCode, &inputBytes, &outputBytes);
+
+	numberFailures = 0;
+	for (trial=0; trial<kNumberTrials; trial++)
+		{
+				// Non-BIS input.
+
+		numberColumns = 1 + rand () % 150;
+		numberBufferChannels = 1 + rand () % 12;
+		numberChannels = numberBufferChannels + rand () % 3;
+		numberSamples = 1 + rand () % numberColumns;
+		columnOffset = rand () % 5;
+		if (columnOffset + numberSamples > numberColumns)
+			columnOffset = numberColumns - numberSamples;
+		toBISFormatFlag = rand () % 2;
+		useListFlag = rand () % 2;
+
+		listChannel = rand () % 2;
+		for (channel=0; channel<numberBufferChannels; channel++)
+			{
+			channelList[channel] = listChannel;
+			listChannel += 1 + (useListFlag ? rand () % 2 : 0);
+
+			}	// end "for (channel=0; channel<numberBufferChannels; channel++)"
+
+		if (!toBISFormatFlag)
+			numberChannels = numberBufferChannels;
+
+		numberInputBytes = numberColumns * (listChannel + 2) * inputBytes + 64;
+		numberOutputBytes = numberSamples * (numberChannels + 1) * outputBytes + 64;
+
+		inputPtr = (HUCharPtr)malloc (numberInputBytes);
+		scalarOutputPtr = (HUCharPtr)malloc (numberOutputBytes);
+		simdOutputPtr = (HUCharPtr)malloc (numberOutputBytes);
+
+		FillInputBuffer (dataConversionCode, inputPtr, numberInputBytes);
+		memset (scalarOutputPtr, kGuardByte, numberOutputBytes);
+		memset (simdOutputPtr, kGuardByte, numberOutputBytes);
+
+		gSIMDLevel = simdLevel;
+		PackNonBISData (columnOffset,
+								1,
+								numberColumns,
+								numberBufferChannels,
+								numberChannels,
+								useListFlag ? channelList : NULL,
+								numberSamples,
+								dataConversionCode,
+								inputPtr,
+								simdOutputPtr,
+								toBISFormatFlag);
+
+		gSIMDLevel = kSIMDNone;
+		PackNonBISData (columnOffset,
+								1,
+								numberColumns,
+								numberBufferChannels,
+								numberChannels,
+								useListFlag ? channelList : NULL,
+								numberSamples,
+								dataConversionCode,
+								inputPtr,
+								scalarOutputPtr,
+								toBISFormatFlag);
+
+		if (memcmp (scalarOutputPtr, simdOutputPtr, numberOutputBytes) != 0)
+			{
+			numberFailures++;
+			printf ("PackNonBISData differs: code %08x level %d toBIS %d samples %u "
+						"channels %u\n",
+						dataConversionCode,
+						simdLevel,
+						toBISFormatFlag,
+						numberSamples,
+						numberBufferChannels);
+
+			}	// end "if (memcmp (scalarOutputPtr, ..."
+
+		free (inputPtr);
+		free (scalarOutputPtr);
+		free (simdOutputPtr);
+
+				// BIS input.
+
+		fileChannels = numberBufferChannels + (useListFlag ? rand () % 4 : 0);
+		bisChannels = 1 + rand () % numberBufferChannels;
+		firstChannel = rand () % (fileChannels - bisChannels + 1);
+		consecutiveFlag = (rand () % 3 != 0);
+		for (channel=0; channel<bisChannels; channel++)
+			{
+			listChannel = firstChannel + channel;
+			if (!consecutiveFlag && channel > 0)
+				listChannel += rand () % 2;
+			channelList[channel] = MIN (listChannel, fileChannels-1);
+
+			}	// end "for (channel=0; channel<bisChannels; channel++)"
+
+		useListFlag = (rand () % 3 != 0);
+		if (!useListFlag)
+			bisChannels = fileChannels;
+
+		numberInputBytes = numberSamples * fileChannels * inputBytes + 64;
+		numberOutputBytes = numberSamples * bisChannels * outputBytes + 64;
+
+		inputPtr = (HUCharPtr)malloc (numberInputBytes);
+		scalarOutputPtr = (HUCharPtr)malloc (numberOutputBytes);
+		simdOutputPtr = (HUCharPtr)malloc (numberOutputBytes);
+
+		FillInputBuffer (dataConversionCode, inputPtr, numberInputBytes);
+		memset (scalarOutputPtr, kGuardByte, numberOutputBytes);
+		memset (simdOutputPtr, kGuardByte, numberOutputBytes);
+
+		gSIMDLevel = simdLevel;
+		PackBISData (1,
+							fileChannels,
+							bisChannels,
+							numberSamples,
+							dataConversionCode,
+							inputPtr,
+							simdOutputPtr,
+							useListFlag ? channelList : NULL);
+
+		gSIMDLevel = kSIMDNone;
+		PackBISData (1,
+							fileChannels,
+							bisChannels,
+							numberSamples,
+							dataConversionCode,
+							inputPtr,
+							scalarOutputPtr,
+							useListFlag ? channelList : NULL);
+
+		if (memcmp (scalarOutputPtr, simdOutputPtr, numberOutputBytes) != 0)
+			{
+			numberFailures++;
+			printf ("PackBISData differs: code %08x level %d samples %u "
+						"file channels %u channels %u\n",
+						dataConversionCode,
+						simdLevel,
+						numberSamples,
+						fileChannels,
+						bisChannels);
+
+			}	// end "if (memcmp (scalarOutputPtr, ..."
+
+		free (inputPtr);
+		free (scalarOutputPtr);
+		free (simdOutputPtr);
+
+		}	// end "for (trial=0; trial<kNumberTrials; trial++)"
+
+	return (numberFailures);
+
+}	// end "CheckConversionCode"
+
+
+
+//------------------------------------------------------------------------------------
+//
+//	Function name:		double TimePackRoutine
+//
+//	Software purpose:	The purpose of this routine is to get the MB/s of input data
+//							for converting a BIL line to BIS format with PackNonBISData or
+//							a BIS line with half of the channels with PackBISData using
+//							the requested SIMD level. The fastest of kBenchmarkRuns runs
+//							is used.
+//
+//	Parameters in:		Data conversion code.
+//							SIMD level to be used.
+//							Flag indicating whether PackBISData is to be timed.
+//							Pointer to the input buffer.
+//							Pointer to the output buffer.
+//
+//	Parameters out:	None
+//
+// Value Returned:	MB/s of input data.
+
+double TimePackRoutine (
+				UInt32								dataConversionCode,
+				SInt16								simdLevel,
+				Boolean								bisInputFlag,
+				HUCharPtr							inputPtr,
+				HUCharPtr							outputPtr)
+
+{
+	double								bestSeconds,
+											seconds;
+
+	UInt32								inputBytes,
+											outputBytes,
+											repeat,
+											run;
+
+
+	GetSIMDConversionBytes (dataConversionCode, &inputBytes, &outputBytes);
+	gSIMDLevel = simdLevel;
+
+	bestSeconds = 0;
+	for (run=0; run<kBenchmarkRuns; run++)
+		{
+		std::chrono::steady_clock::time_point startTime =
+															std::chrono::steady_clock::now ();
+
+		for (repeat=0; repeat<kBenchmarkRepeats; repeat++)
+			{
+			if (bisInputFlag)
+				PackBISData (1,
+									kBenchmarkChannels,
+									kBenchmarkChannels/2,
+									kBenchmarkColumns,
+									dataConversionCode,
+									inputPtr,
+									outputPtr,
+									sChannelList);
+
+			else	// !bisInputFlag
+				PackNonBISData (0,
+										1,
+										kBenchmarkColumns,
+										kBenchmarkChannels,
+										kBenchmarkChannels,
+										NULL,
+										kBenchmarkColumns,
+										dataConversionCode,
+										inputPtr,
+										outputPtr,
+										TRUE);
+
+			}	// end "for (repeat=0; repeat<kBenchmarkRepeats; repeat++)"
+
+		seconds = std::chrono::duration<double> (
+								std::chrono::steady_clock::now () - startTime).count ();
+
+		if (run == 0 || seconds < bestSeconds)
+			bestSeconds = seconds;
+
+		}	// end "for (run=0; run<kBenchmarkRuns; run++)"
+
+	return ((double)kBenchmarkRepeats * kBenchmarkColumns * kBenchmarkChannels *
+																inputBytes / bestSeconds / 1.0e6);
+
+}	// end "TimePackRoutine"
+
+
+
+int main (void)
+
+{
+	double								megabytesPerSecond[3];
+
+	HUCharPtr							inputPtr,
+											outputPtr;
+
+	UInt32								channel,
+											code,
+											dataConversionCode,
+											inputBytes,
+											numberFailures,
+											numberSamples,
+											outputBytes;
+
+	SInt16								bisInputFlag,
+											maximumSIMDLevel,
+											simdLevel;
+
+
+	srand (1);
+
+	maximumSIMDLevel = GetSIMDLevel ();
+	if (maximumSIMDLevel == kSIMDNone)
+		{
+		printf ("This processor does not support SSE4.1; there is nothing to compare.\n");
+																							return (0);
+
+		}	// end "if (maximumSIMDLevel == kSIMDNone)"
+
+			// Check that the outputs are the same.
+
+	numberFailures = 0;
+	for (simdLevel=kSIMDSSE41; simdLevel<=maximumSIMDLevel; simdLevel++)
+		for (code=0; code<kNumberConversionCodes; code++)
+			numberFailures += CheckConversionCode (sConversionCodes[code], simdLevel);
+
+	printf ("Bit-exact check: %u of %u cases differ from the scalar code\n\n",
+				numberFailures,
+				(UInt32)(2 * kNumberTrials * kNumberConversionCodes * maximumSIMDLevel));
+
+			// List the speed of each version. PackNonBISData does not handle some
+			// of the conversions; these are listed as 0.
+
+	for (channel=0; channel<kBenchmarkChannels/2; channel++)
+		sChannelList[channel] = kBenchmarkChannels/2 + channel;
+
+	for (bisInputFlag=FALSE; bisInputFlag<=TRUE; bisInputFlag++)
+		{
+		if (bisInputFlag)
+			printf ("\nPackBISData, BIS line of %d columns, %d of %d channels "
+							"(MB/s of input)\n",
+						kBenchmarkColumns,
+						kBenchmarkChannels/2,
+						kBenchmarkChannels);
+
+		else	// !bisInputFlag
+			printf ("PackNonBISData, BIL line of %d columns by %d channels to BIS "
+							"(MB/s of input)\n",
+						kBenchmarkColumns,
+						kBenchmarkChannels);
+
+		printf ("%-10s %10s %10s %10s\n", "code", "scalar", "SSE4.1", "AVX2");
+
+		for (code=0; code<kNumberConversionCodes; code++)
+			{
+			dataConversionCode = sConversionCodes[code];
+			GetSIMDConversionBytes (dataConversionCode, &inputBytes, &outputBytes);
+
+			numberSamples = kBenchmarkColumns * kBenchmarkChannels;
+			inputPtr = (HUCharPtr)malloc ((size_t)numberSamples * inputBytes);
+			outputPtr = (HUCharPtr)malloc ((size_t)numberSamples * outputBytes);
+			FillInputBuffer (dataConversionCode, inputPtr, numberSamples * inputBytes);
+
+			for (simdLevel=kSIMDNone; simdLevel<=kSIMDAVX2; simdLevel++)
+				{
+				megabytesPerSecond[simdLevel] = 0;
+				if (simdLevel <= maximumSIMDLevel &&
+						(bisInputFlag ||
+							(dataConversionCode != k8BitIntUnsignedTo16BitIntSigned &&
+								dataConversionCode != k8BitIntUnsignedTo32BitIntSigned &&
+								dataConversionCode != k16BitIntUnsignedTo32BitIntSigned &&
+								dataConversionCode != k64BitRealTo32BitReal)))
+					megabytesPerSecond[simdLevel] = TimePackRoutine (dataConversionCode,
+																					simdLevel,
+																					bisInputFlag,
+																					inputPtr,
+																					outputPtr);
+
+				}	// end "for (simdLevel=kSIMDNone; simdLevel<=kSIMDAVX2; ..."
+
+			printf ("%08x   %10.0f %10.0f %10.0f\n",
+						dataConversionCode,
+						megabytesPerSecond[kSIMDNone],
+						megabytesPerSecond[kSIMDSSE41],
+						megabytesPerSecond[kSIMDAVX2]);
+
+			free (inputPtr);
+			free (outputPtr);
+
+			}	// end "for (code=0; code<kNumberConversionCodes; code++)"
+
+		}	// end "for (bisInputFlag=FALSE; bisInputFlag<=TRUE; bisInputFlag++)"
+
+	return (numberFailures > 0);
+
+}	// end "main"
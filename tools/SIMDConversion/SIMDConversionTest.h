@@ -0,0 +1,217 @@
+//	 									MultiSpec
+//
+//					Copyright 1988-2020 Purdue Research Foundation
+//
+//	File:						SIMDConversionTest.h
+//
+//	Revision date:			10/17/2026
+//
+//	Language:				C++
+//
+//	System:					Linux and MacOS Operating Systems (x86 processors)
+//
+//	Brief description:	This file contains the definitions needed to compile the
+//								routines that are copied from SharedMultiSpec/SFileIO.cpp
+//								(see ExtractRoutines.awk) outside of MultiSpec so that the
+//								SIMD and scalar versions can be compared and timed. Only
+//								the FileInfo fields used by those routines are included.
+//
+//------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <immintrin.h>
+
+typedef unsigned char				UInt8,
+											UChar;
+typedef signed char					SInt8;
+typedef uint16_t						UInt16;
+typedef int16_t						SInt16;
+typedef uint32_t						UInt32;
+typedef int32_t						SInt32;
+typedef int64_t						SInt64;
+typedef uint64_t						UInt64;
+
+typedef SInt16							Boolean;
+
+typedef char*							HPtr;
+typedef UInt8*							HUCharPtr;
+typedef UInt8*							HUInt8Ptr;
+typedef SInt8*							HSInt8Ptr;
+typedef UInt16*						HUInt16Ptr;
+typedef SInt16*						HSInt16Ptr;
+typedef UInt32*						HUInt32Ptr;
+typedef SInt32*						HSInt32Ptr;
+typedef SInt64*						HSInt64Ptr;
+typedef float*							HFloatPtr;
+typedef float*							FloatPtr;
+typedef double*						HDoublePtr;
+typedef double*						DoublePtr;
+
+#define	TRUE									1
+#define	FALSE									0
+
+#define	include_simd_capability			1
+#define	SIMD_TARGET_SSE41					__attribute__ ((target ("sse4.1")))
+#define	SIMD_TARGET_AVX2					__attribute__ ((target ("avx2")))
+
+#include "SConstants.h"
+
+typedef struct FileInfo
+	{
+	void*									gdalDataSetH;
+	UInt16								numberBits;
+	UInt16								numberBytes;
+	UInt16								signedBitMask;
+	UInt16								signedValueMask;
+	Boolean								signedDataFlag;
+	Boolean								swapBytesFlag;
+	
+	} FileInfo, *FileInfoPtr;
+
+extern Boolean							gConvertSignedDataFlag;
+extern SInt16							gSIMDLevel;
+
+inline void BlockMoveData (
+				const void*							inputPtr,
+				void*									outputPtr,
+				size_t								numberBytes)
+{
+	memmove (outputPtr, inputPtr, numberBytes);
+
+}	// end "BlockMoveData"
+
+
+		// Routines copied from SFileIO.cpp.
+
+void		AdjustReadData (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							fileIOBufferPtr,
+				UInt32								numberSamples,
+				UInt32								count,
+				Boolean								endHalfByte);
+
+SIMD_TARGET_SSE41
+void		AdjustReadDataSSE41 (
+				UInt32								postReadCode,
+				UInt16								signedBitMask,
+				UInt16								signedValueMask,
+				HUCharPtr							fileIOBufferPtr,
+				UInt32								numberBytes);
+
+void		AdjustSignedData (
+				FileInfoPtr							fileInfoPtr,
+				HUCharPtr							fileIOBufferPtr,
+				UInt32								numberSamples);
+
+Boolean	ConvertDataSamples (
+				UInt32								dataConversionCode,
+				HUCharPtr							inputPtr,
+				HUCharPtr							outputPtr,
+				UInt32								numberSamples);
+
+SIMD_TARGET_AVX2
+void		ConvertDataSamplesAVX2 (
+				UInt32								dataConversionCode,
+				HUCharPtr							inputPtr,
+				HUCharPtr							outputPtr,
+				UInt32								numberSamples);
+
+SIMD_TARGET_SSE41
+void		ConvertDataSamplesSSE41 (
+				UInt32								dataConversionCode,
+				HUCharPtr							inputPtr,
+				HUCharPtr							outputPtr,
+				UInt32								numberSamples);
+
+Boolean	GetSIMDConversionBytes (
+				UInt32								dataConversionCode,
+				UInt32*								inputBytesPtr,
+				UInt32*								outputBytesPtr);
+
+UInt32	GetPostReadCode (
+				FileInfoPtr							fileInfoPtr);
+
+SInt16	GetSIMDLevel (void);
+
+SIMD_TARGET_AVX2
+inline __m256i LoadInt32ValuesAVX2 (
+				UInt32								inputCode,
+				HUCharPtr							inputPtr);
+
+SIMD_TARGET_SSE41
+inline void	LoadInt32ValuesSSE41 (
+				UInt32								inputCode,
+				HUCharPtr							inputPtr,
+				__m128i*								lowValuesPtr,
+				__m128i*								highValuesPtr);
+
+void 		PackBISData (
+				UInt32								columnInterval,
+				UInt32								numberBufferChannels,
+				UInt32								numberChannels,
+				UInt32								numberSamples,
+				UInt32								dataConversionCode,
+				HUCharPtr 							ioCharBufferPtr,
+				HUCharPtr 							dataCharBufferPtr,
+				UInt16*								channelListPtr);
+
+void		PackNonBISData (
+				UInt32								columnOffset,
+				UInt32								columnInterval,
+				UInt32								numberColumnsPerChannel,
+				UInt32								numberBufferChannels,
+				UInt32								numberChannels,
+				HUInt16Ptr							channelListPtr,
+				UInt32								numberSamples,
+				UInt32								dataConversionCode,
+				HUCharPtr							ioCharBufferPtr,
+				HUCharPtr							dataCharBufferPtr,
+				Boolean								toBISFormat);
+
+Boolean	PackNonBISDataUsingSIMD (
+				UInt32								columnOffset,
+				UInt32								numberColumnsPerChannel,
+				UInt32								numberBufferChannels,
+				UInt32								numberChannels,
+				HUInt16Ptr							channelListPtr,
+				UInt32								numberSamples,
+				UInt32								dataConversionCode,
+				HUCharPtr							ioCharBufferPtr,
+				HUCharPtr							dataCharBufferPtr,
+				Boolean								toBISFormat);
+
+void		Swap2Bytes (
+				HUInt16Ptr							twoBytePtr,
+				UInt32								numberSamples);
+
+void		Swap4Bytes (
+				HUInt32Ptr							fourBytePtr,
+				UInt32								numberSamples);
+
+void		Swap8Bytes (
+				DoublePtr							eightBytePtr,
+				UInt32								numberSamples);
+
+void		SwapBytes (
+				SInt16								numberBytes,
+				HUInt8Ptr							fileIOBufferPtr,
+				UInt32								numberSamples);
+
+void		Unpack4BitData (
+				HUCharPtr							fileIOBufferPtr,
+				UInt32								numberSamples,
+				UInt32								count,
+				Boolean								endHalfByte);
+
+SIMD_TARGET_SSE41
+UInt32	Unpack4BitDataSSE41 (
+				HUCharPtr							byte1Ptr,
+				HUCharPtr							byte2Ptr,
+				UInt32								samplesLeft,
+				HUCharPtr							fileIOBufferPtr);
@@ -48,6 +48,7 @@ BEGIN_EVENT_TABLE (CMChangeFormatDlg, CMDialog)
 	EVT_CHOICE (IDC_BandInterleave, CMChangeFormatDlg::OnSelendokBandInterleave)
 	EVT_CHOICE (IDC_ChangeHeader, CMChangeFormatDlg::OnSelendokHeader)
 	EVT_CHOICE (IDC_DataValueType, CMChangeFormatDlg::OnSelendokDataValueType)
+	EVT_CHOICE (IDC_TIFFCompression, CMChangeFormatDlg::OnSelendokTIFFCompression)
 
 	#if defined multispec_wxlin
 		EVT_COMBOBOX (IDC_ChannelCombo, CMChangeFormatDlg::OnSelendokOutChannels)
@@ -93,6 +94,8 @@ CMChangeFormatDlg::CMChangeFormatDlg (
    m_dataValueListSelection = -1;
    m_outputFileSelection = -1;
    m_bandInterleaveSelection = -1;
+   m_tiffCompressionListSelection = 0;
+   m_tiffOverviewsFlag = FALSE;
    m_invertBottomToTopFlag = FALSE;
    m_writeChanDescriptionFlag = FALSE;
    m_invertLeftToRightFlag = FALSE;
@@ -403,6 +406,45 @@ void CMChangeFormatDlg::CreateControls ()
 
    sbSizer22->Add (bSizer131, wxSizerFlags(1).Expand().Border(wxALL, 5));
 
+   wxBoxSizer* bSizer134;
+   bSizer134 = new wxBoxSizer (wxHORIZONTAL);
+
+   m_staticText167 = new wxStaticText (sbSizer22->GetStaticBox (),
+													IDC_TIFFCompressionPrompt,
+													wxT("TIFF compression"),
+													wxDefaultPosition,
+													wxDefaultSize,
+													0);
+   m_staticText167->Wrap (-1);
+   bSizer134->Add (m_staticText167,
+							wxSizerFlags(0).Align(wxALIGN_CENTER_VERTICAL).
+													ReserveSpaceEvenIfHidden().Border(wxALL, 5));
+
+   m_tiffCompressionCtrl = new wxChoice (sbSizer22->GetStaticBox (),
+														IDC_TIFFCompression,
+														wxDefaultPosition,
+														wxDefaultSize);
+   m_tiffCompressionCtrl->Append (wxT("None"), (void*)(SInt64)kNoCompression);
+   m_tiffCompressionCtrl->Append (wxT("LZW"), (void*)(SInt64)kLZWCompression);
+	#if include_zlib_capability
+		m_tiffCompressionCtrl->Append (wxT("Deflate"),
+													(void*)(SInt64)kDeflateCompression);
+	#endif	// include_zlib_capability
+   bSizer134->Add (m_tiffCompressionCtrl,
+							wxSizerFlags(0).Align(wxALIGN_CENTER_VERTICAL).
+													ReserveSpaceEvenIfHidden().Border(wxALL, 5));
+
+   sbSizer22->Add (bSizer134, wxSizerFlags(0).Border(wxLEFT|wxRIGHT, 5));
+
+   m_checkBox47 = new wxCheckBox (sbSizer22->GetStaticBox (),
+												IDC_TIFFOverviews,
+												wxT("Add overviews"),
+												wxDefaultPosition,
+												wxDefaultSize,
+												0);
+   sbSizer22->Add (m_checkBox47,
+   						wxSizerFlags(0).ReserveSpaceEvenIfHidden().Border(wxALL, 5));
+
    gbSizer2->Add (sbSizer22,
 						wxGBPosition (1, 1),
 						wxGBSpan (5, 1),
@@ -558,6 +600,12 @@ Boolean CMChangeFormatDlg::DoDialog (
       m_dialogSelectArea.columnEnd = m_ColumnEnd;
       m_dialogSelectArea.columnInterval = m_ColumnInterval;
 
+				// Compression to use for new TIFF/GeoTIFF files.
+
+      gTIFFOutputCompressionCode = (UInt16)(SInt64)
+					m_tiffCompressionCtrl->GetClientData (m_tiffCompressionListSelection);
+      gTIFFOutputOverviewsFlag = m_tiffOverviewsFlag;
+
       OKFlag = ChangeImageFormatDialogOK (this,
 														  gImageWindowInfoPtr,
 														  gImageLayerInfoPtr,
@@ -677,6 +725,17 @@ void CMChangeFormatDlg::OnInitDialog (
    m_headerListSelection = GetComboListSelection (IDC_ChangeHeader,
            														m_headerOptionsSelection);
 
+   m_tiffCompressionListSelection = GetComboListSelection (IDC_TIFFCompression,
+           															gTIFFOutputCompressionCode);
+   if (m_tiffCompressionListSelection < 0)
+      m_tiffCompressionListSelection = 0;
+   m_tiffOverviewsFlag = gTIFFOutputOverviewsFlag;
+
+   ChangeImageFormatDialogUpdateTIFFOptions (this,
+															m_headerOptionsSelection,
+															m_bandInterleaveSelection,
+															m_tiffCompressionListSelection);
+
    TransferDataToWindow ();
       
    		// Set default text selection to first edit text item
@@ -736,6 +795,11 @@ void CMChangeFormatDlg::OnSelendokBandInterleave (
    if (changedFlag)
       OnSelendokHeader (event);
 
+   ChangeImageFormatDialogUpdateTIFFOptions (this,
+															m_headerOptionsSelection,
+															m_bandInterleaveSelection,
+															m_tiffCompressionListSelection);
+
 }	// end "OnSelendokBandInterleave"
 
 
@@ -795,6 +859,11 @@ void CMChangeFormatDlg::OnSelendokDataValueType (
 
    m_sessionUserSetDataValueTypeSelectionFlag = TRUE;
 
+   ChangeImageFormatDialogUpdateTIFFOptions (this,
+															m_headerOptionsSelection,
+															m_bandInterleaveSelection,
+															m_tiffCompressionListSelection);
+
 }	// end "OnSelendokDataValueType"
 
 
@@ -850,6 +919,11 @@ void CMChangeFormatDlg::OnSelendokHeader (
    m_outputFileCtrl->SetSelection (m_outputFileSelection);
 
    m_dataValueTypeCtrl->SetSelection (m_dataValueListSelection);
+
+   ChangeImageFormatDialogUpdateTIFFOptions (this,
+															m_headerOptionsSelection,
+															m_bandInterleaveSelection,
+															m_tiffCompressionListSelection);
   
 }	// end "OnSelendokHeader"
 
@@ -873,6 +947,21 @@ void CMChangeFormatDlg::OnSelendokOutChannels (
 
 
 
+void CMChangeFormatDlg::OnSelendokTIFFCompression (
+				wxCommandEvent& 					event)
+
+{
+   m_tiffCompressionListSelection = m_tiffCompressionCtrl->GetSelection ();
+
+   ChangeImageFormatDialogUpdateTIFFOptions (this,
+															m_headerOptionsSelection,
+															m_bandInterleaveSelection,
+															m_tiffCompressionListSelection);
+
+}	// end "OnSelendokTIFFCompression"
+
+
+
 void CMChangeFormatDlg::OnTransformData (
 				wxCommandEvent& 					event)
 
@@ -1116,6 +1205,11 @@ bool CMChangeFormatDlg::TransferDataFromWindow ()
 	
    m_bandInterleaveSelection = m_bandInterleaveCtrl->GetSelection ();
 	
+   m_tiffCompressionListSelection = m_tiffCompressionCtrl->GetSelection ();
+	
+   wxCheckBox* overviews = (wxCheckBox*)FindWindow (IDC_TIFFOverviews);
+   m_tiffOverviewsFlag = overviews->GetValue ();
+	
 	TransferLinesColumnsFromWindow ();
 	
 	returnCode = VerifyLineColumnValues (IDC_LineStart,
@@ -1160,6 +1254,11 @@ bool CMChangeFormatDlg::TransferDataToWindow ()
    m_channelsCtrl->SetSelection (m_channelSelection);
    
    m_fileFormatCtrl->SetSelection (m_headerListSelection);
+	
+   m_tiffCompressionCtrl->SetSelection (m_tiffCompressionListSelection);
+	
+   wxCheckBox* overviews = (wxCheckBox*)FindWindow (IDC_TIFFOverviews);
+   overviews->SetValue (m_tiffOverviewsFlag);
 
    return true;
 	
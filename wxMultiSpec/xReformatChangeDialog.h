@@ -71,6 +71,9 @@ class CMChangeFormatDlg : public CMDialog
 		void OnSelendokHeader (
 				wxCommandEvent& 					event);
 	
+		void OnSelendokTIFFCompression (
+				wxCommandEvent& 					event);
+	
 		void OnWriteChanDescriptions (
 				wxCommandEvent& 					event);
 	
@@ -101,14 +104,16 @@ class CMChangeFormatDlg : public CMDialog
 		wxChoice								*m_bandInterleaveCtrl,
 												*m_dataValueTypeCtrl,
 												*m_fileFormatCtrl,
-												*m_outputFileCtrl;
+												*m_outputFileCtrl,
+												*m_tiffCompressionCtrl;
 
 		wxCheckBox							*m_checkBox41,
 												*m_checkBox42,
 												*m_checkBox43,
 												*m_checkBox44,
 												*m_checkBox45,
-												*m_checkBox46;
+												*m_checkBox46,
+												*m_checkBox47;
 
 		wxStaticText						*m_staticText136,
 												*m_staticText137,
@@ -128,14 +133,16 @@ class CMChangeFormatDlg : public CMDialog
 												*m_staticText163,
 												*m_staticText164,
 												*m_staticText165,
-												*m_staticText166;
+												*m_staticText166,
+												*m_staticText167;
 	
 		int 									m_bandInterleaveSelection,
 												m_channelSelection,
 												m_dataValueListSelection,
 												m_headerListSelection,
 												m_outputFileSelection,
-												m_headerOptionsSelection;
+												m_headerOptionsSelection,
+												m_tiffCompressionListSelection;
 
 		SInt16 								m_dataValueTypeSelection,
 												m_eightBitsPerDataSelection,
@@ -144,6 +151,7 @@ class CMChangeFormatDlg : public CMDialog
 		bool 									m_invertBottomToTopFlag,
 			 									m_invertLeftToRightFlag,
 			 									m_swapBytesFlag,
+			 									m_tiffOverviewsFlag,
 			 									m_transformDataFlag,
 			 									m_writeChanDescriptionFlag;
 
@@ -1664,6 +1664,9 @@
 #define IDC_DATA_LIST       				1918
 
 #define IDC_ChannelsSubset					1921
+#define IDC_TIFFCompressionPrompt		1923
+#define IDC_TIFFCompression					1924
+#define IDC_TIFFOverviews					1925
         
 #define IDS_ListData1                   2001
 #define IDS_ListData2                   2002